@@ -4,1340 +4,5164 @@
 #include <assert.h>
 #include <math.h>
 
+/*
+ * Exact-match scans over elements of 2, 4, or 8 bytes compare a whole vector
+ * register's worth of elements at a time where the CPU allows it. On x86-64,
+ * SSE2 is always available, and AVX2 is used instead when the CPU running the
+ * code turns out to support it. On 64-bit ARM, NEON is always available.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define VEC_SIMD_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define VEC_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 #include "Vec.h"
 
+#if defined(VEC_STATS)
+#include <stdatomic.h>
+#endif
+
+/**
+ * @struct
+ * A slot of a vector's hash index
+ */
+typedef struct
+{
+    size_t position; // The element's index plus the index's base (0 if empty)
+    uint64_t hash; // The hash of the element's key
+} IndexSlot;
+
+/**
+ * @struct
+ * A vector's hash index: an open-addressing (linear probing) hash table that
+ * maps the hash of each element's key to the element's index
+ *
+ * The index is enabled while the key size isn't 0. An enabled index whose
+ * slots couldn't be allocated has no slots, and is simply not used until it's
+ * rebuilt.
+ *
+ * Slots hold elements' indices offset by a base, so when every element before
+ * (or after) some index moves one up or down, either their slots change, or
+ * the base does (and the slots of the elements on the other side change
+ * instead), whichever's fewer. Taking from or adding to the front just moves
+ * the base.
+ */
+typedef struct
+{
+    IndexSlot* slots; // The table (or a null pointer, if it has none)
+    size_t slot_count; // The table's size (a power of 2)
+    size_t base; // What's added to an element's index to get its position
+    size_t key_offset; // The byte offset of the key in each element
+    size_t key_size; // The byte size of the key (or 0, if not enabled)
+} VecIndex;
+
+/**
+ * @struct
+ * The parts of a vector that most operations never touch
+ *
+ * These are kept out of the vector struct, behind a pointer, so the struct
+ * (and `VEC_HEADER_SIZE`) stays small. A heap vector's cold state is allocated
+ * along with it, in the same block (see `HeapVec`). An inline vector with the
+ * default options shares `default_cold` until it needs state of its own (for
+ * an index or hash), which is then allocated separately.
+ */
+typedef struct
+{
+    VecOptions options; // How the vector was configured at creation
+    VecAllocator allocator; // Where the vector's memory comes from
+    VecIndex index; // The optional hash index of the elements' keys
+    bool hashing; // Whether `hash_sum` is kept up to date
+    uint64_t hash_sum; // The elements' hashes, added up (see `Vec_hash()`)
+} VecCold;
+
 typedef struct Vec Vec;
+
+#if defined(VEC_STATS)
+/**
+ * @struct
+ * A vector's counters (see `VecStats`), and its place in the registry of live
+ * vectors
+ *
+ * This is kept out of the vector struct, which has to fit in
+ * `VEC_HEADER_SIZE` bytes. The counters are atomic since searches (which the
+ * counters count) can run on one vector from several threads at once.
+ */
+typedef struct StatsRecord
+{
+    Vec const* v; // The vector the counters are for
+    char const* name; // The vector's name (or a null pointer)
+    struct StatsRecord* prev; // The previous record in the registry
+    struct StatsRecord* next; // The next record in the registry
+    atomic_size_t expansions;
+    atomic_size_t resizes;
+    atomic_size_t bytes_reallocated;
+    atomic_size_t bytes_moved;
+    atomic_size_t peak_capacity;
+    atomic_size_t predicate_calls;
+    atomic_size_t searches;
+    atomic_size_t elements_searched;
+    atomic_size_t indexed_searches;
+} StatsRecord;
+#endif
+
 struct Vec
 {
-    uint8_t* data; // Vector data (`uint8_t` for bytewise pointer arithmetic)
-    size_t element_size; // Size of the vector's element type in bytes
-    size_t capacity; // Number of elements the vector can store before resizing
+    /*
+     * Data, element size, capacity, and element counts (see `Vec.h`)
+     *
+     * This must stay the first member so that a vector pointer is also a
+     * pointer to it, which is what the header's inline functions rely on.
+     */
+    VecHot hot;
     size_t capacity_bytes; // Capacity in bytes
-    size_t count; // Current number of elements stored in the vector
-    size_t count_bytes; // Current element count in bytes
+    size_t head_bytes; // Room freed at the front of the block, before `data`
+    VecCold* cold; // Options, allocator, index, and hash (never null)
+    bool zeroing; // Whether the bytes of removed elements are zeroed out
+    bool data_inline; // Whether `data` is the caller's inline storage
+    bool header_inline; // Whether the vector struct is in the caller's storage
+#if defined(VEC_STATS)
+    StatsRecord* stats; // The vector's counters (or null, if they're not kept)
+#endif
 };
 
-Vec* Vec_new(size_t const least_capacity,
-             size_t const element_size)
+// The caller's inline storage sets aside `VEC_HEADER_SIZE` bytes for this.
+_Static_assert(sizeof(Vec) <= VEC_HEADER_SIZE,
+               "The vector struct must fit in VEC_HEADER_SIZE bytes");
+_Static_assert(VEC_HEADER_SIZE % _Alignof(max_align_t) == 0,
+               "Inline elements must stay aligned after the vector struct");
+
+/**
+ * @struct
+ * The block a heap vector's struct is allocated in, with its cold state
+ */
+typedef struct
 {
-    assert(least_capacity != 0);
-    assert(element_size != 0);
-    if (least_capacity == 0 ||
-        element_size == 0)
+    Vec v;
+    VecCold cold;
+} HeapVec;
+
+/**
+ * @brief The default allocator's allocation function, wrapping `malloc()`
+ * @param context Unused
+ * @param size The byte size of the block to allocate
+ * @return The allocated block, or a null pointer on failure
+ */
+static void* default_allocate(void* context, size_t size)
+{
+    (void) context;
+
+    return malloc(size);
+}
+
+/**
+ * @brief The default allocator's reallocation function, wrapping `realloc()`
+ * @param context Unused
+ * @param block The block to resize
+ * @param old_size Unused (`realloc()` knows the block's size already)
+ * @param new_size The byte size to resize the block to
+ * @return The resized block, or a null pointer on failure
+ */
+static void* default_reallocate(void* context,
+                                void* block,
+                                size_t old_size,
+                                size_t new_size)
+{
+    (void) context;
+    (void) old_size;
+
+    return realloc(block, new_size);
+}
+
+/**
+ * @brief The default allocator's deallocation function, wrapping `free()`
+ * @param context Unused
+ * @param block The block to free
+ * @param size Unused (`free()` knows the block's size already)
+ */
+static void default_deallocate(void* context, void* block, size_t size)
+{
+    (void) context;
+    (void) size;
+
+    free(block);
+}
+
+/**
+ * @brief The allocator that vectors use when none is given
+ */
+static VecAllocator const default_allocator =
+{
+    .allocate = default_allocate,
+    .reallocate = default_reallocate,
+    .deallocate = default_deallocate,
+    .context = NULL
+};
+
+/**
+ * @brief The cold state of inline vectors with the default options, and no
+ * index or hash (which is never written to, so sharing it is safe)
+ */
+static VecCold default_cold =
+{
+    .allocator =
     {
-        return NULL;
+        .allocate = default_allocate,
+        .reallocate = default_reallocate,
+        .deallocate = default_deallocate,
+        .context = NULL
     }
+};
 
-    /*
-     * Fail if total number of bytes requested overflows.
-     *
-     * (If okay with requiring C23, this should just be a `ckd_mul()`.)
-     */
-    bool const total_byte_overflow = least_capacity > (SIZE_MAX / element_size);
+#if defined(VEC_STATS)
+/**
+ * @brief The registry of live vectors' counters (a doubly-linked list), and
+ * the spinlock guarding it
+ */
+static StatsRecord* stats_registry = NULL;
+static atomic_flag stats_registry_lock = ATOMIC_FLAG_INIT;
 
-    assert(!total_byte_overflow);
-    if (total_byte_overflow)
+static void stats_lock(void)
+{
+    while (atomic_flag_test_and_set_explicit(&stats_registry_lock,
+                                             memory_order_acquire))
     {
-        return NULL;
+        // Spin; the lock is only ever held for a moment (or a dump).
     }
+}
+
+static void stats_unlock(void)
+{
+    atomic_flag_clear_explicit(&stats_registry_lock, memory_order_release);
+}
 
-    // Allocate the vector.
-    Vec* v = malloc(sizeof(Vec));
-    bool const vector_allocation_succeeded = (v != NULL);
+/**
+ * @brief Adds to one of the given vector's counters (if it has them)
+ */
+#define STAT_ADD(v, counter, amount) \
+    do \
+    { \
+        if ((v)->stats != NULL) \
+        { \
+            atomic_fetch_add_explicit(&(v)->stats->counter, \
+                                      (amount), \
+                                      memory_order_relaxed); \
+        } \
+    } while (0)
 
-    assert(vector_allocation_succeeded);
-    if (!vector_allocation_succeeded)
+/**
+ * @brief Gives the given (newly initialized) vector counters, and adds them
+ * to the registry
+ *
+ * Only the vectors using the default allocator get counters. The others'
+ * memory may be freed without their being destroyed (like by an arena's
+ * reset), which would leave the registry pointing at them, and an allocator
+ * chosen for how it allocates shouldn't have to allocate counters too.
+ *
+ * If the counters can't be allocated, the vector just goes without them.
+ */
+static void stats_register(Vec* v)
+{
+    v->stats = NULL;
+    if (v->cold->allocator.allocate != default_allocate)
     {
-        return NULL;
+        return;
     }
 
-    // Initialize vector members
-    v->data = NULL;
-    v->element_size = element_size;
-    v->count = 0;
-    v->count_bytes = 0;
+    StatsRecord* record = malloc(sizeof(StatsRecord));
 
-    v->capacity_bytes = least_capacity * element_size;
-    v->capacity = v->capacity_bytes / element_size;
+    v->stats = record;
+    if (record == NULL)
+    {
+        return;
+    }
 
-    // Allocate the vector's element block.
-    v->data = malloc(v->capacity_bytes);
-    bool const element_allocation_succeeded = (v->data != NULL);
+    record->v = v;
+    record->name = NULL;
+    record->prev = NULL;
+    atomic_init(&record->expansions, 0);
+    atomic_init(&record->resizes, 0);
+    atomic_init(&record->bytes_reallocated, 0);
+    atomic_init(&record->bytes_moved, 0);
+    atomic_init(&record->peak_capacity, 0);
+    atomic_init(&record->predicate_calls, 0);
+    atomic_init(&record->searches, 0);
+    atomic_init(&record->elements_searched, 0);
+    atomic_init(&record->indexed_searches, 0);
+
+    stats_lock();
+    record->next = stats_registry;
+    if (stats_registry != NULL)
+    {
+        stats_registry->prev = record;
+    }
+    stats_registry = record;
+    stats_unlock();
+}
 
-    assert(element_allocation_succeeded);
-    if (!element_allocation_succeeded)
+/**
+ * @brief Takes the given vector's counters out of the registry, and frees
+ * them
+ */
+static void stats_unregister(Vec* v)
+{
+    StatsRecord* record = v->stats;
+
+    if (record == NULL)
     {
-        free(v);
-        return NULL;
+        return;
     }
 
-    return v;
+    stats_lock();
+    if (record->prev != NULL)
+    {
+        record->prev->next = record->next;
+    }
+    else
+    {
+        stats_registry = record->next;
+    }
+    if (record->next != NULL)
+    {
+        record->next->prev = record->prev;
+    }
+    stats_unlock();
+
+    free(record);
+    v->stats = NULL;
 }
 
-void Vec_destroy(Vec** v)
+/**
+ * @brief Raises the given vector's peak capacity to its capacity, if it's
+ * higher
+ *
+ * (Capacities only change while the vector's modified, which only one thread
+ * does at a time, so this needn't be a compare-and-swap loop.)
+ */
+static void stats_note_capacity(Vec const* v)
 {
-    if (v == NULL ||
-        (*v) == NULL)
+    if (v->stats != NULL &&
+        v->hot.capacity > atomic_load_explicit(&v->stats->peak_capacity,
+                                               memory_order_relaxed))
     {
-        return;
+        atomic_store_explicit(&v->stats->peak_capacity,
+                              v->hot.capacity,
+                              memory_order_relaxed);
     }
+}
 
-    free((*v)->data);
-    free(*v);
-    *v = NULL;
+/**
+ * @brief Counts a search of the given vector that looked at the elements up to
+ * (and including) the one at the given internal index, or at all of them if
+ * the index is the vector's count in bytes
+ */
+static void note_search(Vec const* v, size_t const found)
+{
+    STAT_ADD(v, searches, 1);
+    STAT_ADD(v,
+             elements_searched,
+             (found < v->hot.count_bytes) ? found / v->hot.element_size + 1
+                                          : v->hot.count);
 }
+#else
+#define STAT_ADD(v, counter, amount) ((void) (v))
+#define stats_register(v) ((void) 0)
+#define stats_unregister(v) ((void) 0)
+#define stats_note_capacity(v) ((void) 0)
+#define note_search(v, found) ((void) 0)
+#endif
 
-size_t Vec_capacity(Vec const* v)
+/**
+ * @brief Moves the given bytes within the given vector's data block (counting
+ * them, if the vector keeps counters)
+ */
+static void move_bytes(Vec* v,
+                       void* destination,
+                       void const* source,
+                       size_t const bytes)
 {
-    assert(v != NULL);
-    if (v == NULL)
+    memmove(destination, source, bytes);
+    STAT_ADD(v, bytes_moved, bytes);
+}
+
+/**
+ * @brief Determines whether the given vector options make sense
+ * @param options The options to check
+ * @return Whether the options are valid
+ */
+static bool options_valid(VecOptions const* options)
+{
+    switch (options->growth)
     {
-        return 0;
+        case VEC_GROWTH_DOUBLE:
+        case VEC_GROWTH_ONE_AND_A_HALF:
+            break;
+        case VEC_GROWTH_CHUNK:
+            // Growing by chunks of nothing would never grow at all.
+            if (options->growth_chunk == 0)
+            {
+                return false;
+            }
+            break;
+        default:
+            return false;
     }
 
-    return v->capacity;
+    VecAllocator const* allocator = options->allocator;
+
+    return allocator == NULL ||
+           (allocator->allocate != NULL &&
+            allocator->reallocate != NULL &&
+            allocator->deallocate != NULL);
 }
 
-size_t Vec_count(Vec const* v)
+Vec* Vec_new(size_t const least_capacity,
+             size_t const element_size)
 {
-    assert(v != NULL);
-    if (v == NULL)
+    return Vec_new_with(least_capacity, element_size, NULL);
+}
+
+/**
+ * @brief Initializes the members of the given vector, except for its data
+ * block and capacity
+ * @param v The vector to initialize
+ * @param element_size The byte size of each element in the vector
+ * @param options The (valid) options to configure the vector with
+ * @param allocator The allocator the vector gets its memory from
+ * @param cold Where the vector's cold state goes (or `default_cold`, if the
+ * options are the defaults)
+ */
+static void init(Vec* v,
+                 size_t const element_size,
+                 VecOptions const* options,
+                 VecAllocator const allocator,
+                 VecCold* cold)
+{
+    v->hot.data = NULL;
+    v->hot.element_size = element_size;
+    v->hot.capacity = 0;
+    v->capacity_bytes = 0;
+    v->hot.count = 0;
+    v->hot.count_bytes = 0;
+    v->zeroing = true;
+    v->cold = cold;
+    if (cold != &default_cold)
     {
-        return 0;
+        // (This also leaves the index disabled, and the hash not kept.)
+        *cold = (VecCold) { .options = *options, .allocator = allocator };
+        cold->options.allocator = NULL; // Not kept; the vector has its own copy
+    }
+    v->data_inline = false;
+    v->header_inline = false;
+    v->hot.slow_append = (options->max_count != 0);
+    v->head_bytes = 0;
+    stats_register(v);
+}
+
+/**
+ * @def
+ * The fewest slots a vector's hash index has
+ */
+#define INDEX_MIN_SLOTS ((size_t) 16)
+
+/**
+ * @def
+ * The base a vector's hash index starts with (see `VecIndex`), halfway through
+ * the range of `size_t`, so it can move either way as far as any program could
+ * move it before the index is next rebuilt
+ */
+#define INDEX_BASE (SIZE_MAX / 2)
+
+/**
+ * @brief Hashes the given bytes
+ *
+ * The bytes are mixed in 8 at a time, and the result goes through the
+ * SplitMix64 finalizer, so keys that differ in a single bit still end up in
+ * unrelated slots.
+ *
+ * @param bytes The bytes to hash
+ * @param size How many bytes to hash
+ * @return The hash
+ */
+static uint64_t hash_bytes(uint8_t const* bytes, size_t size)
+{
+    uint64_t hash = UINT64_C(0x9E3779B97F4A7C15) ^ (uint64_t) size;
+
+    while (size > 0)
+    {
+        uint64_t word = 0;
+        size_t const chunk = (size < sizeof(word)) ? size : sizeof(word);
+
+        memcpy(&word, bytes, chunk);
+        hash = (hash ^ word) * UINT64_C(0xBF58476D1CE4E5B9);
+        hash ^= hash >> 31;
+        bytes += chunk;
+        size -= chunk;
     }
 
-    return v->count;
+    hash ^= hash >> 30;
+    hash *= UINT64_C(0x94D049BB133111EB);
+    hash ^= hash >> 31;
+
+    return hash;
 }
 
-size_t Vec_count_bytes(Vec const* v)
+/**
+ * @brief Hashes the key of the given element of the given (indexed) vector
+ * @param v The vector
+ * @param element The element
+ * @return The hash of the element's key
+ */
+static uint64_t key_hash(Vec const* v, uint8_t const* element)
 {
-    assert(v != NULL);
-    if (v == NULL)
+    VecIndex const* index = &v->cold->index;
+
+    return hash_bytes(element + index->key_offset, index->key_size);
+}
+
+/**
+ * @brief Adds up the hashes of the given number of elements of the given
+ * vector, starting at the given index
+ *
+ * Each element is hashed on its own, so the hashes don't wait on each other
+ * (and the CPU can work on several at once).
+ *
+ * @param v The vector
+ * @param first The index of the first element to hash
+ * @param n How many elements to hash
+ * @return The sum of the elements' hashes
+ */
+static uint64_t sum_hashes(Vec const* v, size_t const first, size_t const n)
+{
+    size_t const element_size = v->hot.element_size;
+    uint8_t const* element = v->hot.data + first * element_size;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < n; ++i)
     {
-        return 0;
+        sum += hash_bytes(element, element_size);
+        element += element_size;
     }
 
-    return v->count_bytes;
+    return sum;
 }
 
-size_t Vec_element_size(Vec const* v)
+/**
+ * @brief Adds the given elements of the given vector to its kept hash (if it
+ * keeps one), after they were added to the vector
+ * @param v The vector
+ * @param first The index of the first added element
+ * @param n How many elements were added
+ */
+static void hash_added(Vec* v, size_t const first, size_t const n)
 {
-    assert(v != NULL);
-    if (v == NULL)
+    if (v->cold->hashing)
     {
-        return 0;
+        v->cold->hash_sum += sum_hashes(v, first, n);
     }
+}
 
-    return v->element_size;
+/**
+ * @brief Takes the element at the given index of the given vector out of its
+ * kept hash (if it keeps one), before it's removed
+ * @param v The vector
+ * @param removing The index of the element being removed
+ */
+static void hash_removing(Vec* v, size_t const removing)
+{
+    if (v->cold->hashing)
+    {
+        v->cold->hash_sum -= sum_hashes(v, removing, 1);
+    }
 }
 
-bool Vec_equal(Vec const* v_a,
-               Vec const* v_b,
-               int (*cmp)(void const*, void const*))
+/**
+ * @brief Recomputes the given vector's kept hash (if it keeps one) from all of
+ * its elements, after many of them changed
+ * @param v The vector
+ */
+static void hash_rebuild(Vec* v)
 {
-    assert(v_a != NULL);
-    assert(v_b != NULL);
-    assert(v_a->data != NULL);
-    assert(v_b->data != NULL);
-    if (v_a == NULL ||
-        v_b == NULL ||
-        v_a->data == NULL ||
-        v_b->data == NULL)
+    if (v->cold->hashing)
     {
-        return false;
+        v->cold->hash_sum = sum_hashes(v, 0, v->hot.count);
     }
+}
 
-    /*
-     * Note that a tempting optimization here is to compare the vector pointers
-     * to each other to see if they simply point to the same vector since, in
-     * that case, we don't need to bother comparing their elements -- we know
-     * they're all the same!
-     *
-     * There seems to be disagreement about whether comparing pointers to
-     * different, unrelated, and non-adjacent objects is always well-defined or
-     * consistent in GCC:
-     *     - https://stackoverflow.com/q/8225501
-     *     - https://stackoverflow.com/q/36035782
-     *     - https://stackoverflow.com/q/45966762
-     *
-     * Also, glibc's and musl's `memcmp()` implementations don't seem to take
-     * advantage of this optimization the last time I looked, although neither
-     * had comments explaining why.
-     *
-     * To err on the side of safety/portability, the pointers are assumed to be
-     * pointing to different vectors, so we do not compare the pointers to each
-     * other.
-     */
+/**
+ * @brief Determines whether appending to the given vector must go through the
+ * slow path (to update its index or kept hash, or keep it within its bound),
+ * and notes it in the vector
+ * @param v The vector
+ */
+static void update_slow_append(Vec* v)
+{
+    v->hot.slow_append = v->cold->options.max_count != 0 ||
+                         v->cold->index.key_size != 0 ||
+                         v->cold->hashing;
+}
 
-    // Do the vectors differ in metadata?
-    if (v_a->count != v_b->count ||
-        v_a->element_size != v_b->element_size)
+/**
+ * @brief Puts the given element's position into the first free slot of the
+ * given vector's index, starting from the hash's home slot
+ *
+ * The index must have a free slot.
+ *
+ * @param v The vector
+ * @param i The element's index
+ * @param hash The hash of the element's key
+ */
+static void index_put(Vec* v, size_t const i, uint64_t const hash)
+{
+    size_t const mask = v->cold->index.slot_count - 1;
+    size_t s = (size_t) hash & mask;
+
+    while (v->cold->index.slots[s].position != 0)
+    {
+        s = (s + 1) & mask;
+    }
+
+    v->cold->index.slots[s].position = i + v->cold->index.base;
+    v->cold->index.slots[s].hash = hash;
+}
+
+/**
+ * @brief Finds the slot of the given vector's index that holds the given
+ * position, which must be in the index
+ * @param v The vector
+ * @param position The position to find
+ * @param hash The hash of the key of the position's element
+ * @return The slot's index
+ */
+static size_t index_slot(Vec const* v,
+                         size_t const position,
+                         uint64_t const hash)
+{
+    size_t const mask = v->cold->index.slot_count - 1;
+    size_t s = (size_t) hash & mask;
+
+    while (v->cold->index.slots[s].position != position)
+    {
+        s = (s + 1) & mask;
+    }
+
+    return s;
+}
+
+/**
+ * @brief Frees the slots of the given vector's index, if it has any (leaving
+ * the index enabled, if it is)
+ * @param v The vector
+ */
+static void index_drop_slots(Vec* v)
+{
+    VecIndex* index = &v->cold->index;
+
+    // (Without slots, the index may be the shared default one, so leave it.)
+    if (index->slots != NULL)
+    {
+        v->cold->allocator.deallocate(v->cold->allocator.context,
+                                      index->slots,
+                                      index->slot_count * sizeof(IndexSlot));
+        index->slots = NULL;
+        index->slot_count = 0;
+    }
+}
+
+/**
+ * @brief Rebuilds the given vector's index from scratch, if it's enabled, with
+ * room for (at least) twice as many slots as elements
+ *
+ * If the slots can't be allocated, the index is left without any (so searches
+ * fall back to scanning the elements) until it's next rebuilt.
+ *
+ * @param v The vector
+ * @return Whether the index (if enabled) was rebuilt
+ */
+static bool index_rebuild(Vec* v)
+{
+    if (v->cold->index.key_size == 0)
+    {
+        return true;
+    }
+
+    index_drop_slots(v);
+
+    // Keep the table at most half full, so probes stay short.
+    size_t slot_count = INDEX_MIN_SLOTS;
+    size_t const max_slot_count = SIZE_MAX / sizeof(IndexSlot);
+
+    while (slot_count / 2 < v->hot.count)
+    {
+        if (slot_count > max_slot_count / 2)
+        {
+            return false;
+        }
+        slot_count *= 2;
+    }
+
+    VecAllocator const* allocator = &v->cold->allocator;
+    IndexSlot* slots = allocator->allocate(allocator->context,
+                                           slot_count * sizeof(IndexSlot));
+
+    if (slots == NULL)
+    {
+        return false;
+    }
+    memset(slots, 0, slot_count * sizeof(IndexSlot));
+    v->cold->index.slots = slots;
+    v->cold->index.slot_count = slot_count;
+    v->cold->index.base = INDEX_BASE;
+
+    for (size_t i = 0; i < v->hot.count; ++i)
+    {
+        uint8_t const* element = v->hot.data + i * v->hot.element_size;
+
+        index_put(v, i, key_hash(v, element));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Adds the elements from the given index up to the end of the given
+ * vector to the vector's index (if it has one), after they were appended
+ * @param v The vector
+ * @param first The index of the first appended element
+ */
+static void index_appended(Vec* v, size_t const first)
+{
+    if (v->cold->index.slots == NULL)
+    {
+        return;
+    }
+
+    if (v->cold->index.slot_count / 2 < v->hot.count)
+    {
+        // Outgrown; rebuilding a bigger table adds the new elements, too.
+        index_rebuild(v);
+        return;
+    }
+
+    for (size_t i = first; i < v->hot.count; ++i)
+    {
+        uint8_t const* element = v->hot.data + i * v->hot.element_size;
+
+        index_put(v, i, key_hash(v, element));
+    }
+}
+
+/**
+ * @brief Moves the positions of the given range of elements in the given
+ * vector's index one element up or down
+ *
+ * The elements' slots are found through their keys, so this takes time in
+ * proportion to the number of elements in the range (not the vector). The
+ * positions are moved in the order that never makes two slots hold the same
+ * one.
+ *
+ * @param v The vector
+ * @param first The (index's) index of the first element in the range
+ * @param end The (index's) index just past the last element in the range
+ * @param up Whether the positions move up, as opposed to down
+ * @param moved How many elements up from its index each element in the range
+ * already is in the data block (0 or 1)
+ */
+static void index_shift(Vec* v,
+                        size_t const first,
+                        size_t const end,
+                        bool const up,
+                        size_t const moved)
+{
+    for (size_t n = 0; n < end - first; ++n)
+    {
+        size_t const i = up ? end - 1 - n : first + n;
+        size_t const position = i + v->cold->index.base;
+        uint8_t const* element =
+            v->hot.data + (i + moved) * v->hot.element_size;
+        size_t const s = index_slot(v, position, key_hash(v, element));
+
+        v->cold->index.slots[s].position = up ? position + 1 : position - 1;
+    }
+}
+
+/**
+ * @brief Adds the element at the given index of the given vector to the
+ * vector's index (if it has one), after it was inserted there
+ *
+ * Since the elements after it shifted up one, so do their positions, or else
+ * the base shifts down along with the positions of the elements before it.
+ *
+ * @param v The vector
+ * @param inserted The index of the inserted element
+ */
+static void index_inserted(Vec* v, size_t const inserted)
+{
+    if (v->cold->index.slots == NULL)
+    {
+        return;
+    }
+
+    if (inserted + 1 == v->hot.count ||
+        v->cold->index.slot_count / 2 < v->hot.count)
+    {
+        index_appended(v, inserted);
+        return;
+    }
+
+    size_t const after = v->hot.count - 1 - inserted;
+
+    if (inserted < after &&
+        v->cold->index.base > 1)
+    {
+        index_shift(v, 0, inserted, false, 0);
+        v->cold->index.base -= 1;
+    }
+    else
+    {
+        index_shift(v, inserted, v->hot.count - 1, true, 1);
+    }
+    index_put(v, inserted, key_hash(v, v->hot.data +
+                                       inserted * v->hot.element_size));
+}
+
+/**
+ * @brief Takes the element at the given index of the given vector out of the
+ * vector's index (if it has one), before it's removed
+ *
+ * The slot is emptied by shifting later slots of the same probe sequence back
+ * into it (so no "deleted" markers are needed), and the positions of the
+ * elements after it shift down one, like the elements are about to (or else
+ * the base shifts up, and the positions of the elements before it shift up
+ * against it). So, removing the first or last element takes constant time.
+ *
+ * @param v The vector
+ * @param removing The index of the element being removed
+ */
+static void index_removing(Vec* v, size_t const removing)
+{
+    if (v->cold->index.slots == NULL)
+    {
+        return;
+    }
+
+    size_t const mask = v->cold->index.slot_count - 1;
+    uint8_t const* element = v->hot.data + removing * v->hot.element_size;
+    size_t hole = index_slot(v,
+                             removing + v->cold->index.base,
+                             key_hash(v, element));
+
+    for (size_t s = (hole + 1) & mask;
+         v->cold->index.slots[s].position != 0;
+         s = (s + 1) & mask)
+    {
+        size_t const home = (size_t) v->cold->index.slots[s].hash & mask;
+
+        // Only a slot whose home isn't between the hole and it can move back.
+        if (((s - home) & mask) >= ((s - hole) & mask))
+        {
+            v->cold->index.slots[hole] = v->cold->index.slots[s];
+            hole = s;
+        }
+    }
+    v->cold->index.slots[hole].position = 0;
+
+    size_t const after = v->hot.count - 1 - removing;
+
+    if (removing < after &&
+        v->cold->index.base < SIZE_MAX - v->hot.count)
+    {
+        index_shift(v, 0, removing, true, 0);
+        v->cold->index.base += 1;
+    }
+    else
+    {
+        index_shift(v, removing + 1, v->hot.count, false, 0);
+    }
+}
+
+/**
+ * @brief Looks up the first (lowest indexed) element of the given vector with
+ * the given key in the vector's index, which must have slots
+ *
+ * If an item is given, the element must also match the item bytewise (which
+ * is what `Vec_where()` looks for).
+ *
+ * @param v The vector
+ * @param key The key to look up (with the index's key size)
+ * @param item An optional item to match (with the vector's element size)
+ * @return The index of the element (or, if none has the key, the number of
+ * elements)
+ */
+static size_t index_find(Vec const* v, void const* key, void const* item)
+{
+    size_t const mask = v->cold->index.slot_count - 1;
+    uint64_t const hash = hash_bytes(key, v->cold->index.key_size);
+    size_t found = v->hot.count;
+
+    for (size_t s = (size_t) hash & mask;
+         v->cold->index.slots[s].position != 0;
+         s = (s + 1) & mask)
+    {
+        IndexSlot const slot = v->cold->index.slots[s];
+        size_t const i = slot.position - v->cold->index.base;
+
+        if (slot.hash != hash ||
+            i >= found)
+        {
+            continue;
+        }
+
+        uint8_t const* element = v->hot.data + i * v->hot.element_size;
+        bool const matches =
+            (item != NULL)
+            ? memcmp(element, item, v->hot.element_size) == 0
+            : memcmp(element + v->cold->index.key_offset,
+                     key,
+                     v->cold->index.key_size) == 0;
+
+        if (matches)
+        {
+            found = i;
+        }
+    }
+
+    return found;
+}
+
+Vec* Vec_new_with(size_t const least_capacity,
+                  size_t const element_size,
+                  VecOptions const* options)
+{
+    assert(least_capacity != 0);
+    assert(element_size != 0);
+    if (least_capacity == 0 ||
+        element_size == 0)
+    {
+        return NULL;
+    }
+
+    // Without any options given, use the defaults.
+    VecOptions const defaults = {0};
+
+    if (options == NULL)
+    {
+        options = &defaults;
+    }
+
+    bool const valid_options = options_valid(options);
+
+    assert(valid_options);
+    if (!valid_options)
+    {
+        return NULL;
+    }
+
+    /*
+     * Fail if total number of bytes requested overflows.
+     *
+     * (If okay with requiring C23, this should just be a `ckd_mul()`.)
+     */
+    bool const total_byte_overflow = least_capacity > (SIZE_MAX / element_size);
+
+    assert(!total_byte_overflow);
+    if (total_byte_overflow)
+    {
+        return NULL;
+    }
+
+    VecAllocator const allocator =
+        options->allocator != NULL ? *options->allocator : default_allocator;
+
+    // Allocate the vector (along with its cold state).
+    HeapVec* heap = allocator.allocate(allocator.context, sizeof(HeapVec));
+    bool const vector_allocation_succeeded = (heap != NULL);
+
+    assert(vector_allocation_succeeded);
+    if (!vector_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    // Initialize vector members
+    Vec* v = &heap->v;
+
+    init(v, element_size, options, allocator, &heap->cold);
+    v->capacity_bytes = least_capacity * element_size;
+    v->hot.capacity = v->capacity_bytes / element_size;
+    stats_note_capacity(v);
+
+    // Allocate the vector's element block.
+    v->hot.data = allocator.allocate(allocator.context, v->capacity_bytes);
+    bool const element_allocation_succeeded = (v->hot.data != NULL);
+
+    assert(element_allocation_succeeded);
+    if (!element_allocation_succeeded)
+    {
+        stats_unregister(v);
+        allocator.deallocate(allocator.context, heap, sizeof(HeapVec));
+        return NULL;
+    }
+
+    return v;
+}
+
+Vec* Vec_new_inline(void* storage,
+                    size_t const storage_size,
+                    size_t const element_size,
+                    VecOptions const* options)
+{
+    assert(storage != NULL);
+    assert(element_size != 0);
+    if (storage == NULL ||
+        element_size == 0)
+    {
+        return NULL;
+    }
+
+    bool const storage_aligned =
+        ((uintptr_t) storage % _Alignof(max_align_t)) == 0;
+
+    assert(storage_aligned);
+    if (!storage_aligned)
+    {
+        return NULL;
+    }
+
+    // The storage has to fit the vector struct and at least one element.
+    bool const storage_too_small =
+        storage_size < VEC_HEADER_SIZE ||
+        (storage_size - VEC_HEADER_SIZE) < element_size;
+
+    assert(!storage_too_small);
+    if (storage_too_small)
+    {
+        return NULL;
+    }
+
+    // Without any options given, use the defaults.
+    VecOptions const defaults = {0};
+
+    if (options == NULL)
+    {
+        options = &defaults;
+    }
+
+    bool const valid_options = options_valid(options);
+
+    assert(valid_options);
+    if (!valid_options)
+    {
+        return NULL;
+    }
+
+    VecAllocator const allocator =
+        options->allocator != NULL ? *options->allocator : default_allocator;
+
+    // With any options but the defaults, the cold state needs a block of its
+    // own, since it doesn't fit in the storage's header.
+    bool const default_options =
+        options->growth == VEC_GROWTH_DOUBLE &&
+        options->growth_chunk == 0 &&
+        options->growth_max_step == 0 &&
+        options->max_count == 0 &&
+        options->allocator == NULL;
+    VecCold* cold = &default_cold;
+
+    if (!default_options)
+    {
+        cold = allocator.allocate(allocator.context, sizeof(VecCold));
+
+        bool const cold_allocation_succeeded = (cold != NULL);
+
+        assert(cold_allocation_succeeded);
+        if (!cold_allocation_succeeded)
+        {
+            return NULL;
+        }
+    }
+
+    // The vector struct goes at the start of the storage...
+    Vec* v = (Vec*) storage;
+
+    init(v, element_size, options, allocator, cold);
+    v->header_inline = true;
+
+    // ...and the elements go right after it.
+    v->hot.data = (uint8_t*) storage + VEC_HEADER_SIZE;
+    v->data_inline = true;
+    v->hot.capacity = (storage_size - VEC_HEADER_SIZE) / element_size;
+    v->capacity_bytes = v->hot.capacity * element_size;
+    stats_note_capacity(v);
+
+    return v;
+}
+
+Vec* Vec_adopt(void* block,
+               size_t const count,
+               size_t const capacity,
+               size_t const element_size,
+               VecAllocator const* allocator)
+{
+    assert(block != NULL);
+    assert(capacity != 0);
+    assert(element_size != 0);
+    assert(count <= capacity);
+    if (block == NULL ||
+        capacity == 0 ||
+        element_size == 0 ||
+        count > capacity)
+    {
+        return NULL;
+    }
+
+    // (If okay with requiring C23, this should just be a `ckd_mul()`.)
+    bool const total_byte_overflow = capacity > (SIZE_MAX / element_size);
+
+    assert(!total_byte_overflow);
+    if (total_byte_overflow)
+    {
+        return NULL;
+    }
+
+    VecOptions const options = { .allocator = allocator };
+    bool const valid_options = options_valid(&options);
+
+    assert(valid_options);
+    if (!valid_options)
+    {
+        return NULL;
+    }
+
+    VecAllocator const adopted_allocator =
+        allocator != NULL ? *allocator : default_allocator;
+    HeapVec* heap = adopted_allocator.allocate(adopted_allocator.context,
+                                               sizeof(HeapVec));
+    bool const vector_allocation_succeeded = (heap != NULL);
+
+    assert(vector_allocation_succeeded);
+    if (!vector_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    Vec* v = &heap->v;
+
+    init(v, element_size, &options, adopted_allocator, &heap->cold);
+    v->hot.data = (uint8_t*) block;
+    v->hot.capacity = capacity;
+    v->capacity_bytes = capacity * element_size;
+    v->hot.count = count;
+    v->hot.count_bytes = count * element_size;
+    stats_note_capacity(v);
+
+    return v;
+}
+
+/**
+ * @brief Zeroes out the bytes of removed elements in the given vector's data
+ * block, unless the vector has had zeroing turned off
+ *
+ * (If okay with requiring C23, `memset_explicit()` should be used here instead,
+ * which prevents the compiler from optimizing it away, unlike `memset()`.)
+ *
+ * @param v The vector that elements were removed from
+ * @param internal_index The internal index of the first removed byte
+ * @param bytes How many bytes to zero out
+ */
+static void zero_removed(Vec* v,
+                         size_t const internal_index,
+                         size_t const bytes)
+{
+    if (v->zeroing &&
+        bytes > 0)
+    {
+        memset((v->hot.data + internal_index),
+               0,
+               bytes);
+    }
+}
+
+/**
+ * @brief Moves the given vector's elements back to the start of its data
+ * block, so that the room freed at the front (by `Vec_pop_front()`) is at the
+ * end again, where appends can use it
+ *
+ * This moves every element, so it's only done when the room freed at the front
+ * is at least as much as the elements take up (making it amortized constant,
+ * like an expansion), when the vector's empty (and there's nothing to move), or
+ * before the block is resized or handed over (which need it to start with the
+ * elements).
+ *
+ * @param v The vector whose elements to move
+ */
+static void reclaim_front(Vec* v)
+{
+    if (v->head_bytes == 0)
+    {
+        return;
+    }
+
+    size_t const head_bytes = v->head_bytes;
+
+    v->hot.data -= head_bytes;
+    if (v->hot.count_bytes > 0)
+    {
+        move_bytes(v, v->hot.data, v->hot.data + head_bytes,
+                   v->hot.count_bytes);
+    }
+    v->head_bytes = 0;
+    v->capacity_bytes += head_bytes;
+    v->hot.capacity = v->capacity_bytes / v->hot.element_size;
+
+    // Whatever of the elements' old bytes wasn't overwritten is left behind.
+    bool const overlapped = (head_bytes < v->hot.count_bytes);
+
+    zero_removed(v,
+                 overlapped ? v->hot.count_bytes : head_bytes,
+                 overlapped ? head_bytes : v->hot.count_bytes);
+}
+
+void Vec_destroy(Vec** v)
+{
+    if (v == NULL ||
+        (*v) == NULL)
+    {
+        return;
+    }
+
+    index_drop_slots(*v);
+    stats_unregister(*v);
+
+    // Copy the allocator out, since it lives in the vector being freed.
+    VecAllocator const allocator = (*v)->cold->allocator;
+
+    // Memory in the caller's inline storage isn't ours to give back.
+    if (!(*v)->data_inline)
+    {
+        allocator.deallocate(allocator.context,
+                             (*v)->hot.data - (*v)->head_bytes,
+                             (*v)->head_bytes + (*v)->capacity_bytes);
+    }
+    if (!(*v)->header_inline)
+    {
+        allocator.deallocate(allocator.context, *v, sizeof(HeapVec));
+    }
+    else if ((*v)->cold != &default_cold)
+    {
+        allocator.deallocate(allocator.context, (*v)->cold, sizeof(VecCold));
+    }
+    *v = NULL;
+}
+
+void* Vec_release(Vec** v, size_t* count)
+{
+    assert(v != NULL);
+    assert(v == NULL || (*v) != NULL);
+    if (v == NULL ||
+        (*v) == NULL)
+    {
+        return NULL;
+    }
+
+    VecAllocator const allocator = (*v)->cold->allocator;
+
+    // The caller gets the elements at the start of the block.
+    reclaim_front(*v);
+
+    uint8_t* block = (*v)->hot.data;
+
+    // The caller's inline storage isn't ours to hand over, so copy out of it.
+    if ((*v)->data_inline)
+    {
+        block = allocator.allocate(allocator.context, (*v)->capacity_bytes);
+
+        bool const block_allocation_succeeded = (block != NULL);
+
+        assert(block_allocation_succeeded);
+        if (!block_allocation_succeeded)
+        {
+            return NULL;
+        }
+        memcpy(block, (*v)->hot.data, (*v)->hot.count_bytes);
+    }
+
+    if (count != NULL)
+    {
+        *count = (*v)->hot.count;
+    }
+
+    index_drop_slots(*v);
+    stats_unregister(*v);
+    if (!(*v)->header_inline)
+    {
+        allocator.deallocate(allocator.context, *v, sizeof(HeapVec));
+    }
+    else if ((*v)->cold != &default_cold)
+    {
+        allocator.deallocate(allocator.context, (*v)->cold, sizeof(VecCold));
+    }
+    *v = NULL;
+
+    return block;
+}
+
+Vec* Vec_clone(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return NULL;
+    }
+
+    VecOptions options = v->cold->options;
+
+    options.allocator = &v->cold->allocator;
+
+    Vec* clone = Vec_new_with(v->hot.capacity, v->hot.element_size, &options);
+    bool const clone_allocation_succeeded = (clone != NULL);
+
+    assert(clone_allocation_succeeded);
+    if (!clone_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    memcpy(clone->hot.data, v->hot.data, v->hot.count_bytes);
+    clone->hot.count = v->hot.count;
+    clone->hot.count_bytes = v->hot.count_bytes;
+    clone->zeroing = v->zeroing;
+
+    if (v->cold->index.key_size != 0)
+    {
+        clone->cold->index.key_offset = v->cold->index.key_offset;
+        clone->cold->index.key_size = v->cold->index.key_size;
+
+        // (Failing just leaves the index without slots until it's rebuilt.)
+        (void) index_rebuild(clone);
+    }
+    clone->cold->hashing = v->cold->hashing;
+    clone->cold->hash_sum = v->cold->hash_sum;
+    update_slow_append(clone);
+
+    return clone;
+}
+
+size_t Vec_capacity(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return v->hot.capacity;
+}
+
+size_t Vec_count(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return v->hot.count;
+}
+
+size_t Vec_count_bytes(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return v->hot.count_bytes;
+}
+
+size_t Vec_element_size(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return v->hot.element_size;
+}
+
+VecAllocator Vec_allocator(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return (VecAllocator) {0};
+    }
+
+    return v->cold->allocator;
+}
+
+VecAllocator Vec_default_allocator(void)
+{
+    return default_allocator;
+}
+
+bool Vec_set_zeroing(Vec* v, bool const zeroing)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    v->zeroing = zeroing;
+
+    return true;
+}
+
+/**
+ * @brief Gives the given vector cold state of its own, if it's sharing
+ * `default_cold` (so it can be written to)
+ * @param v The vector
+ * @return Whether the vector has cold state of its own
+ */
+static bool own_cold(Vec* v)
+{
+    if (v->cold != &default_cold)
+    {
+        return true;
+    }
+
+    VecCold* cold = default_allocate(NULL, sizeof(VecCold));
+
+    if (cold == NULL)
+    {
+        return false;
+    }
+    *cold = default_cold;
+    v->cold = cold;
+
+    return true;
+}
+
+bool Vec_enable_index(Vec* v,
+                      size_t const key_offset,
+                      size_t const key_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return false;
+    }
+
+    bool const key_valid =
+        key_size != 0 &&
+        key_offset <= v->hot.element_size &&
+        key_size <= v->hot.element_size - key_offset;
+
+    assert(key_valid);
+    if (!key_valid)
+    {
+        return false;
+    }
+
+    bool const cold_allocation_succeeded = own_cold(v);
+
+    assert(cold_allocation_succeeded);
+    if (!cold_allocation_succeeded)
+    {
+        return false;
+    }
+
+    VecIndex const previous = v->cold->index;
+
+    v->cold->index.slots = NULL;
+    v->cold->index.slot_count = 0;
+    v->cold->index.key_offset = key_offset;
+    v->cold->index.key_size = key_size;
+
+    bool const index_allocation_succeeded = index_rebuild(v);
+
+    assert(index_allocation_succeeded);
+    if (!index_allocation_succeeded)
+    {
+        // Leave the vector as it was (even if it had a different index).
+        v->cold->index = previous;
+        return false;
+    }
+
+    if (previous.slots != NULL)
+    {
+        v->cold->allocator.deallocate(v->cold->allocator.context,
+                                      previous.slots,
+                                      previous.slot_count * sizeof(IndexSlot));
+    }
+    update_slow_append(v);
+
+    return true;
+}
+
+bool Vec_disable_index(Vec* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    index_drop_slots(v);
+    if (v->cold->index.key_size != 0)
+    {
+        v->cold->index.key_offset = 0;
+        v->cold->index.key_size = 0;
+    }
+    update_slow_append(v);
+
+    return true;
+}
+
+bool Vec_indexed(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    return v->cold->index.key_size != 0;
+}
+
+bool Vec_reindex(Vec* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    bool const index_allocation_succeeded = index_rebuild(v);
+
+    assert(index_allocation_succeeded);
+    hash_rebuild(v);
+
+    return index_allocation_succeeded;
+}
+
+bool Vec_enable_hash(Vec* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    bool const cold_allocation_succeeded = own_cold(v);
+
+    assert(cold_allocation_succeeded);
+    if (!cold_allocation_succeeded)
+    {
+        return false;
+    }
+
+    v->cold->hashing = true;
+    v->cold->hash_sum = sum_hashes(v, 0, v->hot.count);
+    update_slow_append(v);
+
+    return true;
+}
+
+bool Vec_disable_hash(Vec* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    if (v->cold->hashing)
+    {
+        v->cold->hashing = false;
+        v->cold->hash_sum = 0;
+    }
+    update_slow_append(v);
+
+    return true;
+}
+
+uint64_t Vec_hash(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    uint64_t const sum = v->cold->hashing ? v->cold->hash_sum
+                                    : sum_hashes(v, 0, v->hot.count);
+    uint64_t const words[3] =
+    {
+        sum,
+        (uint64_t) v->hot.count,
+        (uint64_t) v->hot.element_size
+    };
+
+    return hash_bytes((uint8_t const*) words, sizeof(words));
+}
+
+bool Vec_equal(Vec const* v_a,
+               Vec const* v_b,
+               int (*cmp)(void const*, void const*))
+{
+    assert(v_a != NULL);
+    assert(v_b != NULL);
+    assert(v_a->hot.data != NULL);
+    assert(v_b->hot.data != NULL);
+    if (v_a == NULL ||
+        v_b == NULL ||
+        v_a->hot.data == NULL ||
+        v_b->hot.data == NULL)
+    {
+        return false;
+    }
+
+    /*
+     * Note that a tempting optimization here is to compare the vector pointers
+     * to each other to see if they simply point to the same vector since, in
+     * that case, we don't need to bother comparing their elements -- we know
+     * they're all the same!
+     *
+     * There seems to be disagreement about whether comparing pointers to
+     * different, unrelated, and non-adjacent objects is always well-defined or
+     * consistent in GCC:
+     *     - https://stackoverflow.com/q/8225501
+     *     - https://stackoverflow.com/q/36035782
+     *     - https://stackoverflow.com/q/45966762
+     *
+     * Also, glibc's and musl's `memcmp()` implementations don't seem to take
+     * advantage of this optimization the last time I looked, although neither
+     * had comments explaining why.
+     *
+     * To err on the side of safety/portability, the pointers are assumed to be
+     * pointing to different vectors, so we do not compare the pointers to each
+     * other.
+     */
+
+    // Do the vectors differ in metadata?
+    if (v_a->hot.count != v_b->hot.count ||
+        v_a->hot.element_size != v_b->hot.element_size)
+    {
+        return false;
+    }
+
+    // Vectors with different kept hashes can't have the same bytes.
+    if (cmp == NULL &&
+        v_a->cold->hashing &&
+        v_b->cold->hashing &&
+        v_a->cold->hash_sum != v_b->cold->hash_sum)
+    {
+        return false;
+    }
+
+    // Two empty vectors that expect the same element size are considered equal.
+    if (v_a->hot.count == 0 &&
+        v_b->hot.count == 0 &&
+        v_a->hot.element_size == v_b->hot.element_size)
+    {
+        return true;
+    }
+
+    /*
+     * Compare the vectors' contents.
+     *
+     * Note that vectors' empty regions should NOT be scanned -- not just for
+     * efficiency but also for correctness. Since a vector's empty bytes are
+     * unmanaged, they can be random garbage. That means two vectors with
+     * identical elements could report a false difference because their empty
+     * bytes differ.
+     */
+    if (cmp != NULL)
+    {
+        /*
+         * If an element comparator function was given, use it to compare the
+         * vectors' elements one by one.
+         */
+        for (size_t i = 0; i < v_a->hot.count_bytes; i += v_a->hot.element_size)
+        {
+            if (0 != cmp(&(v_a->hot.data[i]), &(v_b->hot.data[i])))
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        // With no element comparator, just compare all element bytes.
+        if (memcmp(v_a->hot.data, v_b->hot.data, v_a->hot.count_bytes) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Converts the given element index between an "internal" byte-wise form
+ * and an "external" element-wise form
+ *
+ * An "internal" index corresponds to the internal byte array of this vector
+ * implementation. An "external" index is a conceptual, more user-friendly index
+ * corresponding to where a caller, from the outside, might expect elements to
+ * exist in a vector.
+ *
+ * For example, consider an vector that holds 3 elements, where the elements'
+ * type takes 2 bytes to store, and the vector's capacity is 4 elements. From
+ * the outside, the vector conceptually looks like this:
+ *
+ * ```
+ * [a][b][c][ ]
+ *  0  1  2  3
+ * ```
+ *
+ * A caller expects element `c` to be at index 2. This is the "external" index
+ * of `c`.
+ *
+ * Internally, however, the implementation has a byte array that really looks
+ * like this:
+ *
+ * ```
+ * [a][a][b][b][c][c][ ][ ]
+ *  0     1     2     3     External indices
+ *  0  1  2  3  4  5  6  7  Internal indices
+ * ```
+ *
+ * In the byte array, element `c` actually starts at index 4. This is the
+ * "internal" index of `c`.
+ *
+ * Each element (`a`, `b`, and `c`) takes 2 bytes, hence indices 0 and 1 both
+ * containing `a`, 2 and 3 both containing `b`, and so on.
+ *
+ * To convert the internal index (4) to the external index (2), the internal
+ * index is divided by the element size (2). To convert the other way, an
+ * external index is multiplied by the element size.
+ *
+ * This fails, and returns 0 (or, if assertions are enabled, causes an assert
+ * crash), if the vector pointer is null.
+ *
+ * @param v The vector whose index is being converted
+ * @param index The index to convert
+ * @param to_external Whether to convert the given (internal) index to an
+ * external index (otherwise, it's assumed the given index is an external index
+ * and is converted to an internal index)
+ * @return The converted index
+ */
+static size_t convert_index(Vec const* v,
+                                   size_t const index,
+                                   bool const to_external)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    if (to_external)
+    {
+        return index / v->hot.element_size;
+    }
+    else
+    {
+        /*
+         * We should assume there's no overflow since we verified that the index
+         * is within bounds of the vector's elements and the other vector
+         * functions already safeguard against this overflow.
+         */
+        return index * v->hot.element_size;
+    }
+}
+
+/**
+ * @brief A convenience wrapper around the index conversion function
+ *
+ * This fails, and returns 0 (or, if assertions are enabled, causes an assert
+ * crash), if the vector pointer is null.
+ *
+ * @param v The vector whose index is being converted
+ * @param index The index to convert
+ * @return The converted internal index
+ */
+static size_t to_internal_index(Vec const* v,
+                                size_t const index)
+{
+    return convert_index(v, index, false);
+}
+
+/**
+ * @brief A convenience wrapper around the index conversion function
+ *
+ * This fails, and returns 0 (or, if assertions are enabled, causes an assert
+ * crash), if the vector pointer is null.
+ *
+ * @param v The vector whose index is being converted
+ * @param index The index to convert
+ * @return The converted external index
+ */
+static size_t to_external_index(Vec const* v,
+                                size_t const index)
+{
+    return convert_index(v, index, true);
+}
+
+/**
+ * @struct
+ * The item that the built-in `memcmp()` removal test compares elements to
+ */
+typedef struct
+{
+    void const* item;
+} ItemContext;
+
+/**
+ * @brief A built-in removal test that compares, bytewise via `memcmp()`, the
+ * given element to the item in the given context
+ *
+ * Some functions take an item pointer and check whether an element in the
+ * vector matches that item. There can also be "sibling" functions that, for
+ * added flexibility, take a predicate and check whether an element in the
+ * vector satisfies that predicate.
+ *
+ * "Does this element match this item" is an example of such a predicate. The
+ * removal functions that take an item pointer reuse the compaction engine of
+ * their "sibling" functions by calling it with this function, passing the item
+ * in through the context pointer. (Since the item travels with the call rather
+ * than through, say, a global variable, concurrent calls on different vectors
+ * can't trample each other's items.)
+ *
+ * When an element matches, the context's item pointer is also pointed at the
+ * matching element. If the caller passed in an item pointer to memory inside
+ * the vector, the compaction engine might be about to move other elements on
+ * top of the bytes behind that pointer! That'd cause this function to compare
+ * subsequent elements against totally different bytes than those of the target
+ * element. The compaction engine only ever writes to bytes before the element
+ * it's currently examining, though, so the matching element's bytes stay intact
+ * at least until the next match (at which point the pointer moves along again).
+ * Assuming the caller heeded the warning in the docs to not use bytewise
+ * comparisons for element types whose bytes may vary for otherwise equivalent
+ * elements (such as structs), the matching element has bytes that match the
+ * target element's, so we can confidently use it as the target even if it's a
+ * different instance.
+ *
+ * @param element The element to compare to the context's item
+ * @param element_size The element's size in bytes
+ * @param context An `ItemContext`
+ * @return Whether the given element's bytes match the context's item's
+ */
+static bool item_matches(void const* element,
+                         size_t const element_size,
+                         void* context)
+{
+    ItemContext* target = (ItemContext*) context;
+
+    /*
+     * Note that a tempting optimization here is to compare the item pointer to
+     * the element pointer, to see if both point to the same memory address in
+     * the vector.
+     *
+     * If both pointers are pointing to the same memory, we don't have to bother
+     * comparing the bytes. If elements are large, that's a lot of work saved!
+     *
+     * But, given the uncertainty surrounding the safety/portability of pointer
+     * comparison, this optimization is NOT done. Item pointers are always
+     * assumed to be pointing to memory outside the vector.
+     */
+    if (memcmp(target->item, element, element_size) == 0)
+    {
+        target->item = element;
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/**
+ * @brief Finds the first element whose bytes match the given item's in the
+ * given run of elements, one element at a time
+ *
+ * This is the portable fallback of the exact-match scan.
+ *
+ * @param data The first byte of the elements
+ * @param bytes How many bytes worth of elements there are
+ * @param item The item to search for
+ * @param width The size of the item and of each element in bytes
+ * @return The byte offset of the first matching element (or, if no element
+ * matched, the given number of bytes)
+ */
+static size_t find_scalar(uint8_t const* data,
+                          size_t const bytes,
+                          void const* item,
+                          size_t const width)
+{
+    for (size_t i = 0; i < bytes; i += width)
+    {
+        if (memcmp(item, &(data[i]), width) == 0)
+        {
+            return i;
+        }
+    }
+
+    return bytes;
+}
+
+#if defined(VEC_SIMD_X86)
+/**
+ * @brief Finds the first element whose bytes match the given item's in the
+ * given run of 2, 4, or 8 byte elements, 16 bytes at a time (using SSE2)
+ *
+ * Each comparison checks every lane of a 128-bit register against the item at
+ * once, and the lanes line up with element boundaries, so a match can never
+ * straddle two elements.
+ *
+ * @param data The first byte of the elements
+ * @param bytes How many bytes worth of elements there are
+ * @param item The item to search for
+ * @param width The size of the item and of each element in bytes (2, 4, or 8)
+ * @return The byte offset of the first matching element (or, if no element
+ * matched, the given number of bytes)
+ */
+static size_t find_sse2(uint8_t const* data,
+                        size_t const bytes,
+                        void const* item,
+                        size_t const width)
+{
+    __m128i key;
+
+    if (width == 2)
+    {
+        uint16_t k = 0;
+
+        memcpy(&k, item, sizeof(k));
+        key = _mm_set1_epi16((short) k);
+    }
+    else if (width == 4)
+    {
+        uint32_t k = 0;
+
+        memcpy(&k, item, sizeof(k));
+        key = _mm_set1_epi32((int) k);
+    }
+    else
+    {
+        uint64_t k = 0;
+
+        memcpy(&k, item, sizeof(k));
+        key = _mm_set1_epi64x((long long) k);
+    }
+
+    size_t i = 0;
+
+    for (; i + sizeof(__m128i) <= bytes; i += sizeof(__m128i))
+    {
+        __m128i const block = _mm_loadu_si128((__m128i const*) (data + i));
+        __m128i equal;
+
+        if (width == 2)
+        {
+            equal = _mm_cmpeq_epi16(block, key);
+        }
+        else if (width == 4)
+        {
+            equal = _mm_cmpeq_epi32(block, key);
+        }
+        else
+        {
+            /*
+             * SSE2 has no 64-bit comparison, so compare 32-bit halves and then
+             * require both halves of a lane to have matched.
+             */
+            __m128i const halves = _mm_cmpeq_epi32(block, key);
+
+            equal = _mm_and_si128(halves,
+                                  _mm_shuffle_epi32(halves,
+                                                    _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+
+        unsigned const mask = (unsigned) _mm_movemask_epi8(equal);
+
+        if (mask != 0)
+        {
+            // The lowest set bit is the first byte of the first matching lane.
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_scalar(data + i, bytes - i, item, width);
+}
+
+/**
+ * @brief Finds the first element whose bytes match the given item's in the
+ * given run of 2, 4, or 8 byte elements, 32 bytes at a time (using AVX2)
+ *
+ * This must only be called when the CPU supports AVX2.
+ *
+ * @param data The first byte of the elements
+ * @param bytes How many bytes worth of elements there are
+ * @param item The item to search for
+ * @param width The size of the item and of each element in bytes (2, 4, or 8)
+ * @return The byte offset of the first matching element (or, if no element
+ * matched, the given number of bytes)
+ */
+__attribute__((target("avx2")))
+static size_t find_avx2(uint8_t const* data,
+                        size_t const bytes,
+                        void const* item,
+                        size_t const width)
+{
+    __m256i key;
+
+    if (width == 2)
+    {
+        uint16_t k = 0;
+
+        memcpy(&k, item, sizeof(k));
+        key = _mm256_set1_epi16((short) k);
+    }
+    else if (width == 4)
+    {
+        uint32_t k = 0;
+
+        memcpy(&k, item, sizeof(k));
+        key = _mm256_set1_epi32((int) k);
+    }
+    else
+    {
+        uint64_t k = 0;
+
+        memcpy(&k, item, sizeof(k));
+        key = _mm256_set1_epi64x((long long) k);
+    }
+
+    size_t i = 0;
+
+    for (; i + sizeof(__m256i) <= bytes; i += sizeof(__m256i))
+    {
+        __m256i const block = _mm256_loadu_si256((__m256i const*) (data + i));
+        __m256i equal;
+
+        if (width == 2)
+        {
+            equal = _mm256_cmpeq_epi16(block, key);
+        }
+        else if (width == 4)
+        {
+            equal = _mm256_cmpeq_epi32(block, key);
+        }
+        else
+        {
+            equal = _mm256_cmpeq_epi64(block, key);
+        }
+
+        unsigned const mask = (unsigned) _mm256_movemask_epi8(equal);
+
+        if (mask != 0)
+        {
+            // The lowest set bit is the first byte of the first matching lane.
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_scalar(data + i, bytes - i, item, width);
+}
+#endif
+
+#if defined(VEC_SIMD_NEON)
+/**
+ * @brief Finds the first element whose bytes match the given item's in the
+ * given run of 2, 4, or 8 byte elements, 16 bytes at a time (using NEON)
+ *
+ * When any lane of a block matches, the block is rescanned one element at a
+ * time to pin down which lane it was.
+ *
+ * @param data The first byte of the elements
+ * @param bytes How many bytes worth of elements there are
+ * @param item The item to search for
+ * @param width The size of the item and of each element in bytes (2, 4, or 8)
+ * @return The byte offset of the first matching element (or, if no element
+ * matched, the given number of bytes)
+ */
+static size_t find_neon(uint8_t const* data,
+                        size_t const bytes,
+                        void const* item,
+                        size_t const width)
+{
+    uint64_t k = 0;
+
+    memcpy(&k, item, width);
+
+    size_t i = 0;
+
+    for (; i + 16 <= bytes; i += 16)
+    {
+        uint8x16_t const block = vld1q_u8(data + i);
+        uint32x4_t equal;
+
+        if (width == 2)
+        {
+            uint16x8_t const lanes = vreinterpretq_u16_u8(block);
+
+            equal = vreinterpretq_u32_u16(vceqq_u16(lanes,
+                                                    vdupq_n_u16((uint16_t) k)));
+        }
+        else if (width == 4)
+        {
+            uint32x4_t const lanes = vreinterpretq_u32_u8(block);
+
+            equal = vceqq_u32(lanes, vdupq_n_u32((uint32_t) k));
+        }
+        else
+        {
+            uint64x2_t const lanes = vreinterpretq_u64_u8(block);
+
+            equal = vreinterpretq_u32_u64(vceqq_u64(lanes, vdupq_n_u64(k)));
+        }
+
+        if (vmaxvq_u32(equal) != 0)
+        {
+            return i + find_scalar(data + i, 16, item, width);
+        }
+    }
+
+    return i + find_scalar(data + i, bytes - i, item, width);
+}
+#endif
+
+/**
+ * @brief Scans the given vector for the first element whose bytes match the
+ * given item's (see `find_item()`)
+ */
+static size_t scan_for_item(Vec const* v, void const* item)
+{
+    size_t const width = v->hot.element_size;
+
+    if (width == 1)
+    {
+        uint8_t const* found = memchr(v->hot.data,
+                                      *((uint8_t const*) item),
+                                      v->hot.count_bytes);
+
+        return (found != NULL) ? (size_t) (found - v->hot.data)
+                               : v->hot.count_bytes;
+    }
+
+    if (width == 2 ||
+        width == 4 ||
+        width == 8)
+    {
+#if defined(VEC_SIMD_X86)
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return find_avx2(v->hot.data, v->hot.count_bytes, item, width);
+        }
+
+        return find_sse2(v->hot.data, v->hot.count_bytes, item, width);
+#elif defined(VEC_SIMD_NEON)
+        return find_neon(v->hot.data, v->hot.count_bytes, item, width);
+#endif
+    }
+
+    return find_scalar(v->hot.data, v->hot.count_bytes, item, width);
+}
+
+/**
+ * @brief Finds the first (lowest indexed) element in the given vector whose
+ * bytes match the given item's
+ *
+ * This is the direct exact-match scan behind the functions that search for an
+ * item. Rather than calling through a predicate for every element, it compares
+ * the item's bytes with the elements' bytes right here.
+ *
+ * Elements of 1, 2, 4, or 8 bytes (i.e., the usual integer types) are compared
+ * many at a time: single bytes by the C library's `memchr()`, and the others by
+ * the widest SIMD instructions the CPU supports (chosen at runtime). Elements
+ * of any other size, or on other CPUs, are compared one by one.
+ *
+ * If the vector has a hash index, though, only the elements with the same key
+ * as the item are compared at all.
+ *
+ * @param v The vector to search
+ * @param item The item to search for (with the vector's element size)
+ * @return The internal index of the first matching element (or, if no element
+ * matched, the vector's count in bytes)
+ */
+static size_t find_item(Vec const* v, void const* item)
+{
+    if (v->cold->index.slots != NULL)
+    {
+        // The index narrows the search down to the elements with the same key.
+        uint8_t const* key = (uint8_t const*) item + v->cold->index.key_offset;
+
+        STAT_ADD(v, indexed_searches, 1);
+
+        return to_internal_index(v, index_find(v, key, item));
+    }
+
+    size_t const found = scan_for_item(v, item);
+
+    note_search(v, found);
+
+    return found;
+}
+
+/**
+ * @struct
+ * A caller's single-argument predicate, wrapped up so that it can be passed
+ * through functions which expect a predicate that takes a context pointer
+ *
+ * (Wrapping the function pointer in a struct is what lets it travel through a
+ * `void*`, since function pointers can't portably be converted to one.)
+ */
+typedef struct
+{
+    bool (*predicate)(void const*, size_t const);
+} PredicateContext;
+
+/**
+ * @brief Calls the predicate wrapped in the given context on the given element
+ * @param element An element
+ * @param element_size The element's size in bytes
+ * @param context A `PredicateContext`
+ * @return Whether the element satisfies the wrapped predicate
+ */
+static bool call_predicate(void const* element,
+                           size_t const element_size,
+                           void* context)
+{
+    PredicateContext const* wrapped = (PredicateContext const*) context;
+
+    return wrapped->predicate(element, element_size);
+}
+
+/**
+ * @def
+ * The smallest element size for which scans prefetch elements ahead of the one
+ * they're at (smaller elements come many to a cache line, and the CPU's own
+ * prefetcher keeps up with them)
+ */
+#define PREFETCH_MIN_ELEMENT_SIZE ((size_t) 64)
+
+/**
+ * @def
+ * How many bytes ahead scans prefetch (at least `PREFETCH_AHEAD_ELEMENTS`
+ * elements' worth), which gives a fetch from memory about the time it takes to
+ * get there
+ */
+#define PREFETCH_DISTANCE ((size_t) 1024)
+
+/**
+ * @def
+ * The fewest elements ahead that scans prefetch
+ */
+#define PREFETCH_AHEAD_ELEMENTS ((size_t) 4)
+
+/**
+ * @brief Determines how many bytes ahead a scan over the given vector should
+ * prefetch, if at all
+ *
+ * The CPU's prefetcher only follows a scan within a page, and elements of a
+ * kilobyte or more cross pages every few steps, so those (and, after them, the
+ * pages they're on) are fetched ahead here instead.
+ *
+ * @param v The vector
+ * @return The distance in bytes (or 0, if the elements are too small to need
+ * it)
+ */
+static size_t prefetch_distance(Vec const* v)
+{
+    size_t const element_size = v->hot.element_size;
+
+    if (element_size < PREFETCH_MIN_ELEMENT_SIZE)
+    {
+        return 0;
+    }
+    if (element_size > SIZE_MAX / PREFETCH_AHEAD_ELEMENTS)
+    {
+        return element_size;
+    }
+
+    size_t const elements = element_size * PREFETCH_AHEAD_ELEMENTS;
+
+    return (elements > PREFETCH_DISTANCE) ? elements : PREFETCH_DISTANCE;
+}
+
+/**
+ * @brief Prefetches the given vector's element bytes the given distance past
+ * the given internal index, if there are any
+ */
+static void prefetch_ahead(Vec const* v,
+                           size_t const i,
+                           size_t const distance)
+{
+#if defined(__GNUC__)
+    if (distance != 0 &&
+        distance < v->hot.count_bytes - i)
+    {
+        __builtin_prefetch(v->hot.data + i + distance);
+    }
+#else
+    (void) v;
+    (void) i;
+    (void) distance;
+#endif
+}
+
+size_t Vec_where_if(Vec const* v,
+                    bool (*predicate)(void const*, size_t const))
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return 0;
+    }
+
+    assert(predicate != NULL);
+    if (predicate == NULL ||
+        v->hot.count == 0)
+    {
+        return v->hot.count;
+    }
+
+    size_t const ahead = prefetch_distance(v);
+
+    for (size_t i = 0; i < v->hot.count_bytes; i += v->hot.element_size)
+    {
+        prefetch_ahead(v, i, ahead);
+        if (predicate(&(v->hot.data[i]), v->hot.element_size))
+        {
+            STAT_ADD(v, predicate_calls, i / v->hot.element_size + 1);
+            note_search(v, i);
+
+            return to_external_index(v, i);
+        }
+    }
+    STAT_ADD(v, predicate_calls, v->hot.count);
+    note_search(v, v->hot.count_bytes);
+
+    return v->hot.count;
+}
+
+size_t Vec_where_if_ctx(Vec const* v,
+                        bool (*predicate)(void const*, size_t const, void*),
+                        void* context)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return 0;
+    }
+
+    assert(predicate != NULL);
+    if (predicate == NULL ||
+        v->hot.count == 0)
+    {
+        return v->hot.count;
+    }
+
+    size_t const ahead = prefetch_distance(v);
+
+    for (size_t i = 0; i < v->hot.count_bytes; i += v->hot.element_size)
+    {
+        prefetch_ahead(v, i, ahead);
+        if (predicate(&(v->hot.data[i]), v->hot.element_size, context))
+        {
+            STAT_ADD(v, predicate_calls, i / v->hot.element_size + 1);
+            note_search(v, i);
+
+            return to_external_index(v, i);
+        }
+    }
+    STAT_ADD(v, predicate_calls, v->hot.count);
+    note_search(v, v->hot.count_bytes);
+
+    return v->hot.count;
+}
+
+/**
+ * @brief Gets the index of the lowest set bit of the given (non-0) word
+ */
+static size_t lowest_set_bit(uint64_t const word)
+{
+#if defined(__GNUC__)
+    return (size_t) __builtin_ctzll(word);
+#else
+    size_t i = 0;
+
+    while (((word >> i) & 1) == 0)
+    {
+        i += 1;
+    }
+
+    return i;
+#endif
+}
+
+/**
+ * @brief Gets the given word of the given mask of the given number of bits,
+ * with the bits past the end of the mask (in the last word) cleared
+ */
+static uint64_t mask_word(uint64_t const* mask,
+                          size_t const w,
+                          size_t const mask_count)
+{
+    size_t const last_bits = mask_count % 64;
+
+    if (w == mask_count / 64 &&
+        last_bits != 0)
+    {
+        return mask[w] & (((uint64_t) 1 << last_bits) - 1);
+    }
+
+    return mask[w];
+}
+
+/**
+ * @brief Checks the arguments the mask-driven functions have in common
+ */
+static bool mask_valid(Vec const* v,
+                       uint64_t const* mask,
+                       size_t const mask_count)
+{
+    return v != NULL &&
+           v->hot.data != NULL &&
+           mask != NULL &&
+           mask_count == v->hot.count;
+}
+
+size_t Vec_where_masked(Vec const* v,
+                        uint64_t const* mask,
+                        size_t const mask_count)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    bool const valid = mask_valid(v, mask, mask_count);
+
+    assert(valid);
+    if (!valid)
+    {
+        return v->hot.count;
+    }
+
+    size_t const words = (mask_count + 63) / 64;
+
+    for (size_t w = 0; w < words; ++w)
+    {
+        uint64_t const bits = mask_word(mask, w, mask_count);
+
+        if (bits != 0)
+        {
+            return w * 64 + lowest_set_bit(bits);
+        }
+    }
+
+    return v->hot.count;
+}
+
+size_t Vec_where(Vec const* v,
+                 void const* item,
+                 size_t const item_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return 0;
+    }
+
+    assert(item != NULL);
+    assert(item_size == v->hot.element_size);
+    if (item == NULL ||
+        item_size != v->hot.element_size ||
+        v->hot.count == 0)
+    {
+        return v->hot.count;
+    }
+
+    // Compare the given item's bytes with those of each element.
+    return to_external_index(v, find_item(v, item));
+}
+
+bool Vec_has(Vec const* v,
+             void const* item,
+             size_t const item_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(item != NULL);
+    assert(item_size == v->hot.element_size);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        item == NULL ||
+        item_size != v->hot.element_size ||
+        v->hot.count == 0)
+    {
+        return false;
+    }
+
+    if (v->hot.count_bytes != find_item(v, item))
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool Vec_has_if(Vec const* v,
+                bool (*predicate)(void const*, size_t const))
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(predicate != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        predicate == NULL ||
+        v->hot.count == 0)
+    {
+        return false;
+    }
+
+    if (v->hot.count != Vec_where_if(v, predicate))
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool Vec_has_if_ctx(Vec const* v,
+                    bool (*predicate)(void const*, size_t const, void*),
+                    void* context)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(predicate != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        predicate == NULL ||
+        v->hot.count == 0)
+    {
+        return false;
+    }
+
+    if (v->hot.count != Vec_where_if_ctx(v, predicate, context))
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+size_t Vec_where_key(Vec const* v,
+                     void const* key,
+                     size_t const key_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return 0;
+    }
+
+    assert(key != NULL);
+    assert(key_size != 0);
+    assert(key_size == v->cold->index.key_size);
+    if (key == NULL ||
+        key_size == 0 ||
+        key_size != v->cold->index.key_size ||
+        v->hot.count == 0)
+    {
+        return v->hot.count;
+    }
+
+    if (v->cold->index.slots != NULL)
+    {
+        STAT_ADD(v, indexed_searches, 1);
+
+        return index_find(v, key, NULL);
+    }
+
+    // Without the index's slots, compare the key with each element's.
+    size_t const key_offset = v->cold->index.key_offset;
+
+    for (size_t i = 0; i < v->hot.count_bytes; i += v->hot.element_size)
+    {
+        if (memcmp(v->hot.data + i + key_offset, key, key_size) == 0)
+        {
+            note_search(v, i);
+
+            return to_external_index(v, i);
+        }
+    }
+    note_search(v, v->hot.count_bytes);
+
+    return v->hot.count;
+}
+
+bool Vec_has_key(Vec const* v,
+                 void const* key,
+                 size_t const key_size)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    size_t const where = Vec_where_key(v, key, key_size);
+
+    return where != v->hot.count;
+}
+
+void* Vec_get(Vec const* v, size_t const external_index)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return NULL;
+    }
+
+    bool const index_out_of_bounds = external_index >= v->hot.count;
+
+    assert(!index_out_of_bounds);
+    if (index_out_of_bounds)
+    {
+        return NULL;
+    }
+
+    return v->hot.data + to_internal_index(v, external_index);
+}
+
+void* Vec_data(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return NULL;
+    }
+
+    return v->hot.data;
+}
+
+bool Vec_span(Vec const* v, void** begin, void** end)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(begin != NULL);
+    assert(end != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        begin == NULL ||
+        end == NULL)
+    {
+        if (begin != NULL)
+        {
+            *begin = NULL;
+        }
+        if (end != NULL)
+        {
+            *end = NULL;
+        }
+
+        return false;
+    }
+
+    *begin = v->hot.data;
+    *end = v->hot.data + v->hot.count_bytes;
+
+    return true;
+}
+
+/**
+ * @brief Resizes the given vector to exactly the given capacity
+ *
+ * WARNING: This may invalidate stored pointers or indices! After a vector's
+ * data block is resized, the data block may reside in a totally different
+ * region of memory than the one still being pointed to by outside pointers!
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The new capacity is zero, the same as the vector's current capacity, or
+ *       less than the vector's number of elements (which would truncate them)
+ *     - The total byte size (type size * capacity) of the vector will be too
+ *       huge to be numerically represented in the vector without overflow
+ *     - Reallocating the memory failed, internally
+ *     - The given vector pointer is null
+ *
+ * @param v The vector to resize
+ * @param new_capacity The new capacity
+ * @return Whether the vector was successfully resized
+ */
+static bool Vec_resize(Vec* v, size_t const new_capacity)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(new_capacity != 0);
+    assert(new_capacity != v->hot.capacity);
+    assert(new_capacity >= v->hot.count);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        new_capacity == 0 ||
+        new_capacity == v->hot.capacity ||
+        new_capacity < v->hot.count)
+    {
+        return false;
+    }
+
+    // (If okay with requiring C23, this should just be a `ckd_mul()`.)
+    size_t const max_elements = SIZE_MAX / v->hot.element_size;
+    bool const total_byte_size_overflowed = new_capacity > max_elements;
+
+    assert(!total_byte_size_overflowed);
+    if (total_byte_size_overflowed)
+    {
+        return false;
+    }
+
+    // The block can only be resized with the elements at its start.
+    if (v->head_bytes != 0)
+    {
+        bool const growing = (new_capacity > v->hot.capacity);
+
+        reclaim_front(v);
+        if (growing ? (new_capacity <= v->hot.capacity)
+                    : (new_capacity == v->hot.capacity))
+        {
+            // The room freed at the front was all the room needed.
+            return true;
+        }
+    }
+
+    size_t const new_capacity_bytes = v->hot.element_size * new_capacity;
+    uint8_t* success = NULL;
+
+    if (v->data_inline)
+    {
+        // The inline storage can't be resized, so move out of it to the heap.
+        success = v->cold->allocator.allocate(v->cold->allocator.context,
+                                              new_capacity_bytes);
+        if (success != NULL)
+        {
+            memcpy(success, v->hot.data, v->hot.count_bytes);
+        }
+    }
+    else
+    {
+        success = v->cold->allocator.reallocate(v->cold->allocator.context,
+                                                v->hot.data,
+                                                v->capacity_bytes,
+                                                new_capacity_bytes);
+    }
+
+    bool const vector_realloc_succeeded = (success != NULL);
+
+    assert(vector_realloc_succeeded);
+    if (!vector_realloc_succeeded)
+    {
+        return false;
+    }
+
+    v->hot.data = success;
+    v->data_inline = false;
+    v->hot.capacity = new_capacity;
+    v->capacity_bytes = new_capacity_bytes;
+    STAT_ADD(v, resizes, 1);
+    STAT_ADD(v, bytes_reallocated, new_capacity_bytes);
+    stats_note_capacity(v);
+
+    return true;
+}
+
+/**
+ * @brief Determines the capacity that the given vector should expand to next,
+ * according to its growth policy
+ *
+ * The growth step is:
+ *     - The vector's capacity, with `VEC_GROWTH_DOUBLE`
+ *     - Half the vector's capacity (but at least 1), with
+ *       `VEC_GROWTH_ONE_AND_A_HALF`
+ *     - The vector's growth chunk, with `VEC_GROWTH_CHUNK`
+ *
+ * The step is then capped at the vector's maximum growth step, if it has one.
+ *
+ * This fails, and returns false, if the expanded capacity would become so huge
+ * that it can no longer be represented without overflow.
+ *
+ * @param v The vector about to expand
+ * @param expanded_capacity Set to the capacity to expand to
+ * @return Whether there is a capacity to expand to
+ */
+static bool grown_capacity(Vec const* v, size_t* expanded_capacity)
+{
+    size_t step = 0;
+
+    switch (v->cold->options.growth)
+    {
+        case VEC_GROWTH_ONE_AND_A_HALF:
+            step = (v->hot.capacity > 1) ? (v->hot.capacity / 2) : 1;
+            break;
+        case VEC_GROWTH_CHUNK:
+            step = v->cold->options.growth_chunk;
+            break;
+        case VEC_GROWTH_DOUBLE:
+        default:
+            step = v->hot.capacity;
+            break;
+    }
+
+    if (v->cold->options.growth_max_step > 0 &&
+        step > v->cold->options.growth_max_step)
+    {
+        step = v->cold->options.growth_max_step;
+    }
+
+    /*
+     * Do nothing if the capacity overflows when the step is added to it.
+     *
+     * (If okay with requiring C23, this should just be a `ckd_add()` on the new
+     * capacity.)
+     */
+    if (step > (SIZE_MAX - v->hot.capacity))
+    {
+        return false;
+    }
+
+    *expanded_capacity = v->hot.capacity + step;
+
+    return true;
+}
+
+/**
+ * @brief Handles expansion of the given vector when it's run out of room for
+ * new elements
+ *
+ * If enough room was freed at the front of the vector's data block, the
+ * elements are moved back into it instead (see `reclaim_front()`).
+ *
+ * WARNING: This may invalidate stored pointers or indices! After a vector's
+ * data block is resized, the data block may reside in a totally different
+ * region of memory than the one still being pointed to by outside pointers!
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The vector's not full (i.e., its capacity is not actually exhausted)
+ *     - When expanded, the vector's capacity would become so huge that it can
+ *       no longer be represented by the vector's internal data without overflow
+ *     - The vector pointer is null
+ *
+ * @param v The vector to expand
+ * @return Whether the vector was successfully expanded
+ */
+static bool handle_capacity_exhaustion(Vec* v)
+{
+    assert(v != NULL);
+    assert(v->hot.count == v->hot.capacity);
+    if (v == NULL ||
+        v->hot.count != v->hot.capacity)
+    {
+        return false;
+    }
+
+    /*
+     * If at least as much room was freed at the front as the elements take up,
+     * moving them back into it takes no more time than expanding would have
+     * (and makes at least as much room per element moved).
+     */
+    if (v->head_bytes != 0 &&
+        v->head_bytes >= v->hot.count_bytes)
+    {
+        reclaim_front(v);
+        return true;
+    }
+
+    size_t expanded_capacity = 0;
+    bool const expanded_capacity_overflowed =
+        !grown_capacity(v, &expanded_capacity);
+
+    assert(!expanded_capacity_overflowed);
+    if (expanded_capacity_overflowed)
+    {
+        return false;
+    }
+
+    bool const expanded = Vec_resize(v, expanded_capacity);
+
+    if (expanded)
+    {
+        STAT_ADD(v, expansions, 1);
+    }
+
+    return expanded;
+}
+
+/**
+ * @def
+ * The size, in bytes, of the stack buffer that `insert_at()` stages items in
+ *
+ * Items larger than this are staged in a temporary dynamic allocation instead.
+ */
+#define ITEM_STAGING_BYTES 256
+
+/**
+ * @brief Copies the given item aside, before the given vector's elements are
+ * moved or resized out from under it (in case it points into the vector)
+ *
+ * See `insert_at()` for why the item is copied, and for where.
+ *
+ * @param v The vector the item is going into
+ * @param item The item to copy
+ * @param buffer A stack buffer of `ITEM_STAGING_BYTES` bytes
+ * @return The copy (in the buffer, or in a temporary allocation that
+ * `unstage_item()` frees), or a null pointer if allocating one failed
+ */
+static uint8_t* stage_item(Vec* v, void const* item, uint8_t* buffer)
+{
+    uint8_t* staged = buffer;
+
+    if (v->hot.element_size > ITEM_STAGING_BYTES)
+    {
+        staged = v->cold->allocator.allocate(v->cold->allocator.context,
+                                             v->hot.element_size);
+
+        assert(staged != NULL);
+        if (staged == NULL)
+        {
+            return NULL;
+        }
+    }
+    memcpy(staged, item, v->hot.element_size);
+
+    return staged;
+}
+
+/**
+ * @brief Frees the given item copy made by `stage_item()`, if it isn't in the
+ * stack buffer it was given
+ */
+static void unstage_item(Vec* v, uint8_t* staged, uint8_t const* buffer)
+{
+    if (staged != buffer)
+    {
+        v->cold->allocator.deallocate(v->cold->allocator.context,
+                                      staged,
+                                      v->hot.element_size);
+    }
+}
+
+/**
+ * @brief Drops the first element of the given (non-empty) vector, by starting
+ * its data one element later in its block
+ *
+ * If that empties the vector, the room freed at the front is given back.
+ *
+ * @param v The vector to drop the first element of
+ */
+static void drop_front(Vec* v)
+{
+    size_t const element_size = v->hot.element_size;
+
+    index_removing(v, 0);
+    hash_removing(v, 0);
+    zero_removed(v, 0, element_size);
+    v->hot.data += element_size;
+    v->head_bytes += element_size;
+    v->capacity_bytes -= element_size;
+    v->hot.capacity -= 1;
+    v->hot.count -= 1;
+    v->hot.count_bytes -= element_size;
+
+    if (v->hot.count == 0)
+    {
+        reclaim_front(v);
+    }
+}
+
+/**
+ * @brief Gets the room (in elements) that the given bounded vector's block
+ * keeps once the vector's full: twice its limit, or just its limit if twice as
+ * many elements' bytes couldn't be represented
+ * @param v The bounded vector
+ * @return The room the block keeps
+ */
+static size_t bounded_room(Vec const* v)
+{
+    size_t const max_count = v->cold->options.max_count;
+    bool const doubled_room_overflowed =
+        max_count > (SIZE_MAX / 2) / v->hot.element_size;
+
+    return doubled_room_overflowed ? max_count : 2 * max_count;
+}
+
+/**
+ * @brief Gives the given full bounded vector's block its room for twice its
+ * limit (see `bounded_room()`), if it doesn't have it yet
+ *
+ * With that room, the elements are only moved from one end of the block to the
+ * other once per limit's worth of dropped elements, so overwriting stays
+ * amortized constant. This happens once, the first time the full vector needs
+ * room, except for a vector in the caller's inline storage (which it isn't
+ * moved out of just for this), or if growing the block fails (in which case the
+ * vector just keeps the room it has, and moves its elements more often).
+ *
+ * @param v The full bounded vector
+ */
+static void make_bounded_room(Vec* v)
+{
+    size_t const room = v->hot.capacity + v->head_bytes / v->hot.element_size;
+    size_t const wanted_room = bounded_room(v);
+
+    if (room < wanted_room &&
+        !v->data_inline)
+    {
+        (void) Vec_resize(v, wanted_room);
+    }
+}
+
+/**
+ * @brief Appends the given item to the given vector, which has an index, a
+ * kept hash, or a bound, keeping them up to date
+ *
+ * A full bounded vector drops its first element for the item: if there's no
+ * room left at the end of its block, the block is given room for twice the
+ * limit (see `make_bounded_room()`), or, if it has that already, the elements
+ * are moved back into the room freed at its front (see `reclaim_front()`).
+ *
+ * @param v The vector to append to
+ * @param item The item to append
+ * @return Whether the item was appended
+ */
+static bool append_slow(Vec* v, void const* item)
+{
+    bool const overwriting = v->cold->options.max_count != 0 &&
+                             v->hot.count >= v->cold->options.max_count;
+    uint8_t staging_buffer[ITEM_STAGING_BYTES];
+    uint8_t* staged = NULL;
+
+    if (overwriting &&
+        v->hot.count == v->hot.capacity)
+    {
+        // Dropping and moving the elements may move the item, too.
+        staged = stage_item(v, item, staging_buffer);
+        if (staged == NULL)
+        {
+            return false;
+        }
+        item = staged;
+        drop_front(v);
+        make_bounded_room(v);
+        if (v->hot.count == v->hot.capacity)
+        {
+            reclaim_front(v);
+        }
+    }
+    else if (v->hot.count == v->hot.capacity &&
+             !handle_capacity_exhaustion(v))
+    {
+        // Do nothing if expansion failed.
+        return false;
+    }
+
+    memcpy((v->hot.data + v->hot.count_bytes), item, v->hot.element_size);
+    v->hot.count += 1;
+    v->hot.count_bytes += v->hot.element_size;
+    index_appended(v, v->hot.count - 1);
+    hash_added(v, v->hot.count - 1, 1);
+
+    if (staged != NULL)
+    {
+        unstage_item(v, staged, staging_buffer);
+    }
+    else if (overwriting)
+    {
+        // (The item was appended into spare room, so drop after it's copied.)
+        drop_front(v);
+    }
+
+    return true;
+}
+
+bool Vec_append(Vec* v, void const* item, size_t const item_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(item != NULL);
+    assert(item_size == v->hot.element_size);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        item == NULL ||
+        item_size != v->hot.element_size)
+    {
+        return false;
+    }
+
+    /*
+     * Do nothing if size will overflow after addition.
+     *
+     * (If okay with requiring C23, this should just be a `ckd_add()` on the
+     * new size.)
+     */
+    bool const element_count_overflowed = ((v->hot.count + 1) < v->hot.count);
+
+    assert(!element_count_overflowed);
+    if (element_count_overflowed)
+    {
+        return false;
+    }
+
+    // Only vectors with an index, kept hash, or bound have more to do.
+    if (v->hot.slow_append)
+    {
+        return append_slow(v, item);
+    }
+
+    // If at capacity, try to expand the vector first.
+    if (v->hot.count == v->hot.capacity)
+    {
+        if (!handle_capacity_exhaustion(v))
+        {
+            // Do nothing if expansion failed.
+            return false;
+        }
+
+        // We're assured we expanded.
+        assert(v->hot.count < v->hot.capacity);
+
+        // Check that we expanded such that we have room for one more element.
+        assert(v->capacity_bytes - v->hot.count_bytes >= v->hot.element_size);
+    }
+
+    // Append the item.
+    memcpy((v->hot.data + (v->hot.count * v->hot.element_size)),
+           item,
+           item_size);
+    v->hot.count += 1;
+    v->hot.count_bytes += v->hot.element_size;
+
+    return true;
+}
+
+/**
+ * @brief Makes sure the given vector has room for (at least) the given number
+ * of elements, resizing it at most once if it doesn't, the way
+ * `reserve_room()` does (without the checks)
+ *
+ * @param v The vector to make room in
+ * @param required_capacity How many elements the vector should have room for
+ * @return Whether the vector has room for that many elements
+ */
+static bool expand_to_fit(Vec* v, size_t const required_capacity)
+{
+    if (required_capacity <= v->hot.capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = required_capacity;
+    size_t expanded_capacity = 0;
+
+    /*
+     * (If the vector can't expand by its usual step without overflowing, the
+     * required capacity may still be representable, so that's not a failure.)
+     */
+    if (grown_capacity(v, &expanded_capacity) &&
+        expanded_capacity > new_capacity)
+    {
+        new_capacity = expanded_capacity;
+    }
+
+    return Vec_resize(v, new_capacity);
+}
+
+/**
+ * @brief Makes sure the given vector has room for the given number of
+ * additional elements, resizing it at most once if it doesn't
+ *
+ * When the vector needs to grow, it grows straight to whichever is larger: the
+ * capacity needed for the additional elements, or the capacity the vector would
+ * have expanded to anyway had it run out of room. The former means that a big
+ * batch of elements never causes a cascade of expansions; the latter means that
+ * lots of small batches still get the amortized constant cost of expansion.
+ *
+ * WARNING: This may invalidate stored pointers! If the vector is resized, its
+ * data block may reside in a totally different region of memory than the one
+ * still being pointed to by outside pointers!
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The number of elements in the vector would become so huge that it can
+ *       no longer be represented by the vector's internal data without overflow
+ *     - The vector is bounded, and would hold more elements than it may
+ *     - Expanding the vector (if it needed to be resized) failed
+ *
+ * @param v The vector to make room in
+ * @param additional How many more elements the vector should have room for
+ * @return Whether the vector has room for the additional elements
+ */
+static bool reserve_room(Vec* v, size_t const additional)
+{
+    /*
+     * (If okay with requiring C23, this should just be a `ckd_add()` on the
+     * new size.)
+     */
+    bool const element_count_overflowed =
+        (additional > (SIZE_MAX - v->hot.count));
+
+    assert(!element_count_overflowed);
+    if (element_count_overflowed)
+    {
+        return false;
+    }
+
+    size_t const required_capacity = v->hot.count + additional;
+    bool const bound_exceeded = v->cold->options.max_count != 0 &&
+                                required_capacity > v->cold->options.max_count;
+
+    assert(!bound_exceeded);
+    if (bound_exceeded)
+    {
+        return false;
+    }
+
+    return expand_to_fit(v, required_capacity);
+}
+
+bool Vec_reserve(Vec* v, size_t const least_capacity)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return false;
+    }
+
+    if (least_capacity <= v->hot.capacity)
+    {
+        // There's already enough room.
+        return true;
+    }
+
+    return Vec_resize(v, least_capacity);
+}
+
+bool Vec_shrink_to_fit(Vec* v)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL)
+    {
+        return false;
+    }
+
+    // Room freed at the front is excess room, too.
+    reclaim_front(v);
+
+    // Like a new vector, even an empty vector keeps room for one element.
+    size_t fitted_capacity = (v->hot.count > 0) ? v->hot.count : 1;
+
+    // A full bounded vector keeps the room that overwriting relies on.
+    if (v->cold->options.max_count != 0 &&
+        v->hot.count >= v->cold->options.max_count)
+    {
+        size_t const kept_room = bounded_room(v);
+
+        fitted_capacity = (v->hot.capacity < kept_room) ? v->hot.capacity
+                                                        : kept_room;
+    }
+
+    if (fitted_capacity == v->hot.capacity ||
+        v->data_inline)
+    {
+        /*
+         * There's no excess room to give back (or, at least, none that
+         * moving out of the caller's inline storage would give back).
+         */
+        return true;
+    }
+
+    return Vec_resize(v, fitted_capacity);
+}
+
+bool Vec_append_n(Vec* v,
+                  void const* items,
+                  size_t const n,
+                  size_t const item_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(items != NULL);
+    assert(item_size == v->hot.element_size);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        items == NULL ||
+        item_size != v->hot.element_size)
+    {
+        return false;
+    }
+
+    if (n == 0)
+    {
+        return true;
+    }
+
+    // Do nothing if the items' total byte size overflows.
+    bool const total_byte_overflow = n > (SIZE_MAX / v->hot.element_size);
+
+    assert(!total_byte_overflow);
+    if (total_byte_overflow ||
+        !reserve_room(v, n))
+    {
+        return false;
+    }
+
+    // Append all the items at once.
+    size_t const bytes = n * v->hot.element_size;
+
+    memcpy(v->hot.data + v->hot.count_bytes, items, bytes);
+    v->hot.count += n;
+    v->hot.count_bytes += bytes;
+    index_appended(v, v->hot.count - n);
+    hash_added(v, v->hot.count - n, n);
+
+    return true;
+}
+
+bool Vec_extend(Vec* dst, Vec const* src)
+{
+    assert(dst != NULL);
+    assert(dst->hot.data != NULL);
+    assert(src != NULL);
+    assert(src->hot.data != NULL);
+    if (dst == NULL ||
+        dst->hot.data == NULL ||
+        src == NULL ||
+        src->hot.data == NULL)
+    {
+        return false;
+    }
+
+    assert(dst->hot.element_size == src->hot.element_size);
+    if (dst->hot.element_size != src->hot.element_size)
+    {
+        return false;
+    }
+
+    /*
+     * Note the source's size before making room, since the source may be the
+     * destination itself (in which case making room changes its capacity, but
+     * not its elements).
+     */
+    size_t const n = src->hot.count;
+    size_t const bytes = src->hot.count_bytes;
+
+    if (n == 0)
+    {
+        return true;
+    }
+
+    if (!reserve_room(dst, n))
+    {
+        return false;
+    }
+
+    /*
+     * Even if the source is the destination, the source's elements and the
+     * room made for them don't overlap, so they can be `memcpy()`d.
+     */
+    memcpy(dst->hot.data + dst->hot.count_bytes, src->hot.data, bytes);
+    dst->hot.count += n;
+    dst->hot.count_bytes += bytes;
+    index_appended(dst, dst->hot.count - n);
+    hash_added(dst, dst->hot.count - n, n);
+
+    return true;
+}
+
+/**
+ * @brief Inserts the given item at the given internal index of the given
+ * vector, expanding the vector first if it's full
+ *
+ * This is the shift-and-copy engine behind insertion: the elements at and after
+ * the insertion site are shifted right by one element as a single block (via
+ * `memmove()`), and the item is then copied into the gap.
+ *
+ * Before anything is moved, the item is staged in a temporary copy. This way,
+ * if the item pointer is pointing to an item that's already inside the vector,
+ * we won't lose the item when it shifts out from under the pointer or when the
+ * pointer gets invalidated after expanding the vector.
+ *
+ * Note that an alternative is searching the vector to get the index where the
+ * item is (if the item, or an exact copy, is in the vector), tracking the index
+ * across any shifts, and using the index to re-acquire the item after vector
+ * expansion and element shifting before insertion. This would require no
+ * temporary copy. However, since the item may be a struct, which means it has
+ * random ("uninitialized") padding bytes, and since we don't have a
+ * caller-supplied comparator, we'll have to use bytewise comparison of the
+ * elements when searching the vector. Since we're searching the vector for the
+ * same exact item, or an exact copy, bytewise comparison would still work
+ * despite the item's random padding bytes. Valgrind can't know this, though,
+ * and will issue "Conditional jump or move depends on uninitialised value(s)"
+ * errors for every struct insertion because we're comparing random bytes (even
+ * if it's against themselves). So, just to keep Valgrind output clean, the item
+ * is copied instead.
+ *
+ * Items of up to `ITEM_STAGING_BYTES` bytes are staged on the stack, so the
+ * copy costs no more than a few loads and stores. Only larger items need a
+ * temporary dynamic allocation.
+ *
+ * WARNING: This may invalidate stored pointers or indices! To make room for the
+ * insertion (if it's anywhere else than the end of the elements), the vector's
+ * elements are automatically shifted to make room. As a result, pre-existing
+ * pointers or indices may no longer correspond to the elements they did before
+ * insertion! Also, if the vector is full, it undergoes automatic expansion to
+ * fit the new element, so the vector's data block is resized. Resizing may
+ * relocate the data block to a totally different region of memory than the one
+ * still being pointed to by outside pointers!
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The vector is bounded, and already holds as many elements as it may
+ *     - A temporary copy of a large item can't be allocated
+ *     - The vector is full and can't be expanded
+ *
+ * @param v The vector to insert to
+ * @param insertion_index_i The internal index to insert at
+ * @param item The item to insert
+ * @return Whether the item was inserted
+ */
+static bool insert_at(Vec* v,
+                      size_t const insertion_index_i,
+                      void const* item)
+{
+    // A full bounded vector has nothing to drop for an element in the middle.
+    bool const bound_exceeded = v->cold->options.max_count != 0 &&
+                                v->hot.count >= v->cold->options.max_count;
+
+    assert(!bound_exceeded);
+    if (bound_exceeded)
+    {
+        return false;
+    }
+
+    uint8_t staging_buffer[ITEM_STAGING_BYTES];
+    uint8_t* staged = stage_item(v, item, staging_buffer);
+
+    if (staged == NULL)
+    {
+        return false;
+    }
+
+    bool inserted = true;
+
+    if (v->hot.count == v->hot.capacity)
+    {
+        // Since the vector's full, expand it before insertion.
+        inserted = handle_capacity_exhaustion(v);
+        assert(inserted);
+    }
+
+    if (inserted)
+    {
+        /*
+         * Shift the elements at and after the insertion site to the right by
+         * one element's size in bytes to make room for insertion. (When
+         * inserting at the end, there's nothing to shift.)
+         */
+        size_t const bytes_to_shift = v->hot.count_bytes - insertion_index_i;
+
+        if (bytes_to_shift > 0)
+        {
+            move_bytes(v,
+                       v->hot.data + insertion_index_i + v->hot.element_size,
+                       v->hot.data + insertion_index_i,
+                       bytes_to_shift);
+        }
+
+        // Insert the item.
+        memcpy(v->hot.data + insertion_index_i,
+               staged,
+               v->hot.element_size);
+        v->hot.count += 1;
+        v->hot.count_bytes += v->hot.element_size;
+        index_inserted(v, to_external_index(v, insertion_index_i));
+        hash_added(v, to_external_index(v, insertion_index_i), 1);
+    }
+
+    unstage_item(v, staged, staging_buffer);
+
+    return inserted;
+}
+
+bool Vec_insert(Vec* v,
+                size_t const insertion_index_e,
+                void const* item,
+                size_t const item_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(item != NULL);
+    assert(item_size == v->hot.element_size);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        item == NULL ||
+        item_size != v->hot.element_size)
+    {
+        return false;
+    }
+
+    /*
+     * Do nothing if size will overflow after addition.
+     *
+     * (If okay with requiring C23, this should just be a `ckd_add()` on the
+     * new size.)
+     */
+    bool const element_count_overflowed = ((v->hot.count + 1) < v->hot.count);
+    bool const index_out_of_bounds = (insertion_index_e > v->hot.count);
+
+    assert(!element_count_overflowed);
+    assert(!index_out_of_bounds);
+    if (element_count_overflowed ||
+        index_out_of_bounds)
+    {
+        return false;
+    }
+
+    size_t const insertion_index_i = to_internal_index(v, insertion_index_e);
+
+    /*
+     * Note that the given item pointer may be pointing to an item that's
+     * already inside the vector. In such a case, the item will move out from
+     * under the pointer if it needs to shift along with the other elements to
+     * make room at the insertion site. If the vector is full and needs to be
+     * resized, the item might move out from under the pointer in an additional
+     * way: the vector's elements may be allocated to a totally different block
+     * of memory than the one where the item pointer would still be pointing. In
+     * other words, the item pointer will be invalidated before we get to insert
+     * the item.
+     *
+     * There's no way to know if the item pointer is pointing inside the vector,
+     * at least not without pointer address comparison (which is avoided for
+     * safety/portability and totally not superstition surrounding rumored GCC
+     * bugs in that StackOverflow article linked elsewhere in this file), so the
+     * insertion engine always stages a copy of the item before shifting
+     * anything. Whether or not the vector's full, the shift itself is then a
+     * single block move.
+     */
+    return insert_at(v, insertion_index_i, item);
+}
+
+bool Vec_insert_many(Vec* v,
+                     size_t const* indices,
+                     void const* items,
+                     size_t const k,
+                     size_t const item_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(indices != NULL);
+    assert(items != NULL);
+    assert(item_size == v->hot.element_size);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        indices == NULL ||
+        items == NULL ||
+        item_size != v->hot.element_size)
+    {
+        return false;
+    }
+
+    if (k == 0)
+    {
+        return true;
+    }
+
+    // Do nothing if the items' total byte size overflows.
+    bool const total_byte_overflow = k > (SIZE_MAX / v->hot.element_size);
+
+    assert(!total_byte_overflow);
+    if (total_byte_overflow)
+    {
+        return false;
+    }
+
+    for (size_t j = 0; j < k; ++j)
+    {
+        bool const index_out_of_bounds = (indices[j] > v->hot.count);
+        bool const indices_unsorted = (j > 0 && indices[j - 1] > indices[j]);
+
+        assert(!index_out_of_bounds);
+        assert(!indices_unsorted);
+        if (index_out_of_bounds ||
+            indices_unsorted)
+        {
+            return false;
+        }
+    }
+
+    if (!reserve_room(v, k))
+    {
+        return false;
+    }
+
+    /*
+     * Work from the back: the elements after the last insertion site move up
+     * by all k items, the ones between it and the site before it move up by
+     * k - 1, and so on. Every run lands in room that's either new or was
+     * already moved out of, so nothing is overwritten before it's moved.
+     */
+    size_t const element_size = v->hot.element_size;
+    uint8_t const* item_bytes = (uint8_t const*) items;
+    size_t run_end = v->hot.count;
+
+    for (size_t j = k; j > 0; --j)
+    {
+        size_t const site = indices[j - 1];
+
+        if (run_end > site)
+        {
+            move_bytes(v,
+                       v->hot.data + (site + j) * element_size,
+                       v->hot.data + site * element_size,
+                       (run_end - site) * element_size);
+        }
+        memcpy(v->hot.data + (site + j - 1) * element_size,
+               item_bytes + (j - 1) * element_size,
+               element_size);
+        run_end = site;
+    }
+
+    v->hot.count += k;
+    v->hot.count_bytes += k * element_size;
+    index_rebuild(v);
+    hash_rebuild(v);
+
+    return true;
+}
+
+/**
+ * @brief Finishes compacting the given vector by dropping the elements past the
+ * given byte offset (which the kept elements have all been moved below)
+ *
+ * @param v The vector being compacted
+ * @param e The end of the kept elements, in bytes
+ * @return How many elements were removed
+ */
+static size_t truncate_compacted(Vec* v, size_t const e)
+{
+    /*
+     * Just like when removing a single element, "removing" the elements now
+     * past `e` only takes updating the vector's metadata and zeroing out their
+     * memory.
+     */
+    size_t const elements_removed = (v->hot.count - to_external_index(v, e));
+
+    zero_removed(v, e, v->hot.count_bytes - e);
+    v->hot.count -= elements_removed;
+    v->hot.count_bytes = e;
+    if (elements_removed > 0)
+    {
+        index_rebuild(v); // Nearly every element may have moved.
+        hash_rebuild(v);
+    }
+
+    return elements_removed;
+}
+
+/**
+ * @brief Removes all elements of the given vector for which the given removal
+ * test returns true, in a single pass, keeping the surviving elements in order
+ *
+ * This is the compaction engine behind the functions that remove multiple
+ * elements at once.
+ *
+ * The most obvious way to remove multiple elements would be to iterate through
+ * the vector and, for every element to be removed, call the regular remove
+ * function with that element's index.
+ *
+ * However, for every removed element `x`, the remove function would shift all
+ * the elements after `x` to the left to keep the vector contiguous. Since we're
+ * potentially removing some of those shifted elements as well, those shifts are
+ * a waste! Each shift can be thought of as a linear traversal of the vector's
+ * byte array, so that's `r` traversals where `r` is the number of elements
+ * removed. That's on top of the traversal we were doing to find elements to
+ * remove, so it's a total of `r + 1` traversals.
+ *
+ * We can actually do it in just 1 traversal if we only ever move the elements
+ * that we know we're NOT removing, moving each one exactly once, straight to
+ * its final position!
+ *
+ * We iterate through the vector while keeping an "end of the elements we're
+ * NOT removing" index, `e`, and the start of the current "run" of consecutive
+ * elements we're NOT removing, `r`. When we hit an element we ARE removing, the
+ * run that just ended is moved down to `e` as a single block, `e` grows by the
+ * run's length, and a new run starts after the removed element. Let the
+ * elements to be removed be `x` and suppose the vector initially looks like
+ * this:
+ *
+ * ```
+ * [a][b][x][c][d][x][x][e]
+ *  0  1  2  3  4  5  6  7
+ * ```
+ *
+ * The run `[a][b]` is already where it belongs, so it isn't moved at all. The
+ * run `[c][d]` is moved down to index 2 with one `memmove()`, and the run `[e]`
+ * is moved down to index 4 with another:
+ *
+ * ```
+ * [a][b][c][d][e][ ][ ][ ]
+ *  0  1  2  3  4  5  6  7
+ *                 ^
+ *                 e ends up here
+ * ```
+ *
+ * Then the removed elements can be dropped all at once by "cutting off" the
+ * tail end of the vector at index `e`.
+ *
+ * That's all elements removed with only 1 traversal and one block move per run
+ * of kept elements, however long the run is. (This is the "erase-remove idiom"
+ * from C++, with contiguous kept elements merged into single copies.)
+ *
+ * Note that every write made here lands before the element currently being
+ * examined, so elements that haven't been examined yet are never disturbed.
+ *
+ * @param v The vector to remove from
+ * @param removing A function that takes an element pointer, an element size,
+ * and the given context pointer and returns true if the element should be
+ * removed
+ * @param context A pointer passed through to the removal test
+ * @return How many elements were removed
+ */
+static size_t compact(Vec* v,
+                      bool (*removing)(void const* element,
+                                       size_t const element_size,
+                                       void* context),
+                      void* context)
+{
+    size_t e = 0; // The end of the elements that we're NOT removing
+    size_t r = 0; // The start of the current run of elements we're NOT removing
+
+    for (size_t i = 0; i < v->hot.count_bytes; i += v->hot.element_size)
+    {
+        if (removing(v->hot.data + i, v->hot.element_size, context))
+        {
+            // Move the run that just ended (if any) down to `e`.
+            if (i > r)
+            {
+                if (e != r)
+                {
+                    move_bytes(v, v->hot.data + e, v->hot.data + r, i - r);
+                }
+                e += i - r;
+            }
+            r = i + v->hot.element_size;
+        }
+    }
+
+    // Move the final run (if any) down to `e`.
+    if (v->hot.count_bytes > r)
+    {
+        if (e != r)
+        {
+            move_bytes(v, v->hot.data + e, v->hot.data + r,
+                       v->hot.count_bytes - r);
+        }
+        e += v->hot.count_bytes - r;
+    }
+
+    return truncate_compacted(v, e);
+}
+
+size_t Vec_remove(Vec* v, size_t const external_index)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(v->hot.count > 0);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        v->hot.count == 0)
+    {
+        return 0;
+    }
+
+    bool const index_out_of_bounds = (external_index >= v->hot.count);
+
+    assert(!index_out_of_bounds);
+    if (index_out_of_bounds)
+    {
+        return v->hot.count;
+    }
+
+    size_t const internal_index = to_internal_index(v, external_index);
+
+    index_removing(v, external_index);
+    hash_removing(v, external_index);
+
+    /*
+     * "Removing" the element from the vector's data block primarily means
+     * changing the vector's metadata to let it reuse the element's bytes in the
+     * block as if there were no element there anymore.
+     */
+    v->hot.count -= 1;
+    v->hot.count_bytes -= v->hot.element_size;
+
+    /*
+     * To maintain contiguity of the block data, though (and we assume it
+     * was contiguous prior to removing the element), we have to shift the
+     * vector's elements leftward.
+     *
+     * E.g., if removing the element at index 2 and the vector looks like
+     * this
+     *
+     * ```
+     * [a][b][ ][d][e][ ]
+     *  0  1  2  3  4  5
+     * ```
+     *
+     * the data is no longer contiguous, and we have to shift the elements
+     * so it looks like this
+     *
+     * ```
+     * [a][b][d][e][ ][ ]
+     *  0  1  2  3  4  5
+     * ```
+     *
+     * so the data is contiguous again.
+     */
+    size_t const bytes_to_shift = v->hot.count_bytes - internal_index;
+
+    if (bytes_to_shift > 0)
+    {
+        // Shift the elements leftward, as a single block, to fill the gap.
+        move_bytes(v,
+                   v->hot.data + internal_index,
+                   v->hot.data + internal_index + v->hot.element_size,
+                   bytes_to_shift);
+    }
+
+    /*
+     * Next, whether or not any elements were shifted, there now exists a "ghost
+     * element" at the end of the vector:
+     *
+     * ```
+     * [a][b][d][e][-][ ]
+     *  0  1  2  3  4  5
+     * ```
+     *
+     * The "ghost element" is `-`.
+     *
+     * If we shifted elements (after removing an element `c` near the beginning
+     * of the vector), `-` contains the memory of the element `e`, which used to
+     * occupy the bytes at index 4 in the data block but has been shifted left
+     * to index 3.
+     *
+     * If we didn't shift elements, `-` contains the memory of the element that
+     * was removed, which was the final element in the vector.
+     *
+     * While the vector is free to reuse and overwrite that segment of the data
+     * block, the "ghost data" in that segment might still be read (accidentally
+     * or otherwise) by a user of the vector.
+     *
+     * The caller should reasonably expect the data of removed elements to be
+     * completely "gone", but nothing prevents a later caller from obtaining the
+     * `void*` to the element at index 3, casting it to a pointer type they can
+     * do pointer arithmetic with, and incrementing it by one in order to read
+     * the memory at index 4, recovering `-`'s ghost data. Since this data might
+     * be sensitive and this might pose a security concern, we zero out the
+     * "ghost element", setting its bytes to `0`:
+     *
+     * ```
+     * [a][b][d][e][0][ ]
+     *  0  1  2  3  4  5
+     * ```
+     *
+     * This zeroing can be turned off with `Vec_set_zeroing()` for vectors
+     * whose data isn't sensitive, sparing removals the extra write.
+     */
+    zero_removed(v, v->hot.count_bytes, v->hot.element_size);
+
+    /*
+     * Finally, return the index of the next element.
+     *
+     * Since the elements are contiguous and we shifted them down by one, the
+     * element after the one we removed is at the same index as the element we
+     * removed.
+     *
+     * If the element we removed was the final one, we return the index of the
+     * "one-past the last element". Since the elements are contiguous, that's
+     * also just the index of the element we removed.
+     */
+    return external_index;
+}
+
+/**
+ * @brief Moves the given vector's elements up in its data block by the given
+ * number of elements, so that there's that much room at the front
+ * @param v The vector (with no room already at the front, and at least the
+ * given room at the end) to make room in
+ * @param room How many elements of room to make
+ */
+static void shift_into_front_room(Vec* v, size_t const room)
+{
+    size_t const room_bytes = to_internal_index(v, room);
+
+    if (v->hot.count_bytes > 0)
+    {
+        move_bytes(v, v->hot.data + room_bytes, v->hot.data,
+                   v->hot.count_bytes);
+    }
+
+    // Whatever of the elements' old bytes wasn't overwritten is left behind.
+    zero_removed(v,
+                 0,
+                 (room_bytes < v->hot.count_bytes) ? room_bytes
+                                                   : v->hot.count_bytes);
+    v->hot.data += room_bytes;
+    v->head_bytes = room_bytes;
+    v->capacity_bytes -= room_bytes;
+    v->hot.capacity -= room;
+}
+
+/**
+ * @brief Moves the given vector's elements up in its data block, leaving as
+ * much room at the front as they take up (or room for one element, if there
+ * are none), so that pushes onto the front have room
+ *
+ * The vector is expanded first if it doesn't have the room at the end. Like an
+ * expansion, this moves every element once per doubling of the room, so pushes
+ * onto the front stay amortized constant.
+ *
+ * @param v The vector (with no room already at the front) to make room in
+ * @return Whether the room was made
+ */
+static bool make_front_room(Vec* v)
+{
+    size_t const room = (v->hot.count > 0) ? v->hot.count : 1;
+
+    // (If okay with requiring C23, this should just be a `ckd_add()`.)
+    bool const element_count_overflowed = (room > SIZE_MAX - v->hot.count);
+
+    assert(!element_count_overflowed);
+    if (element_count_overflowed ||
+        !expand_to_fit(v, v->hot.count + room))
+    {
+        return false;
+    }
+
+    // (Expanding may have moved the elements back to the start of the block.)
+    assert(v->head_bytes == 0);
+    shift_into_front_room(v, room);
+
+    return true;
+}
+
+bool Vec_push_front(Vec* v, void const* item, size_t const item_size)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(item != NULL);
+    assert(item_size == v->hot.element_size);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        item == NULL ||
+        item_size != v->hot.element_size)
     {
         return false;
     }
 
-    // Two empty vectors that expect the same element size are considered equal.
-    if (v_a->count == 0 &&
-        v_b->count == 0 &&
-        v_a->element_size == v_b->element_size)
+    /*
+     * (If okay with requiring C23, this should just be a `ckd_add()` on the
+     * new size.)
+     */
+    bool const element_count_overflowed = ((v->hot.count + 1) < v->hot.count);
+
+    assert(!element_count_overflowed);
+    if (element_count_overflowed)
     {
-        return true;
+        return false;
     }
 
-    /*
-     * Compare the vectors' contents.
-     *
-     * Note that vectors' empty regions should NOT be scanned -- not just for
-     * efficiency but also for correctness. Since a vector's empty bytes are
-     * unmanaged, they can be random garbage. That means two vectors with
-     * identical elements could report a false difference because their empty
-     * bytes differ.
-     */
-    if (cmp != NULL)
+    uint8_t staging_buffer[ITEM_STAGING_BYTES];
+    uint8_t* staged = NULL;
+    bool const overwriting = v->cold->options.max_count != 0 &&
+                             v->hot.count >= v->cold->options.max_count;
+
+    if (v->head_bytes == 0)
     {
-        /*
-         * If an element comparator function was given, use it to compare the
-         * vectors' elements one by one.
-         */
-        for (size_t i = 0; i < v_a->count_bytes; i += v_a->element_size)
+        // Making room moves the elements, so the item may move, too.
+        staged = stage_item(v, item, staging_buffer);
+
+        bool room_made = (staged != NULL);
+
+        if (room_made &&
+            overwriting)
         {
-            if (0 != cmp(&(v_a->data[i]), &(v_b->data[i])))
+            /*
+             * A full bounded vector drops its last element for the item, and
+             * moves the rest up into the room at the end of its block (which
+             * is given room for twice the limit first, if it doesn't have it
+             * yet), rather than growing it any further.
+             */
+            Vec_remove(v, v->hot.count - 1);
+            make_bounded_room(v);
+            if (v->head_bytes == 0)
             {
-                return false;
+                shift_into_front_room(v, v->hot.capacity - v->hot.count);
             }
         }
-    }
-    else
-    {
-        // With no element comparator, just compare all element bytes.
-        if (memcmp(v_a->data, v_b->data, v_a->count_bytes) != 0)
+        else if (room_made)
+        {
+            room_made = make_front_room(v);
+        }
+
+        assert(room_made);
+        if (!room_made)
         {
+            if (staged != NULL)
+            {
+                unstage_item(v, staged, staging_buffer);
+            }
             return false;
         }
+        item = staged;
+    }
+
+    // Step the data back into the room at the front, and put the item there.
+    v->hot.data -= v->hot.element_size;
+    v->head_bytes -= v->hot.element_size;
+    v->capacity_bytes += v->hot.element_size;
+    v->hot.capacity += 1;
+    memcpy(v->hot.data, item, v->hot.element_size);
+    v->hot.count += 1;
+    v->hot.count_bytes += v->hot.element_size;
+    index_inserted(v, 0);
+    hash_added(v, 0, 1);
+
+    if (staged != NULL)
+    {
+        unstage_item(v, staged, staging_buffer);
+    }
+
+    // A bounded vector that was full drops its last element for the item.
+    if (overwriting &&
+        staged == NULL)
+    {
+        Vec_remove(v, v->hot.count - 1);
     }
 
     return true;
 }
 
 /**
- * @brief Converts the given element index between an "internal" byte-wise form
- * and an "external" element-wise form
- *
- * An "internal" index corresponds to the internal byte array of this vector
- * implementation. An "external" index is a conceptual, more user-friendly index
- * corresponding to where a caller, from the outside, might expect elements to
- * exist in a vector.
- *
- * For example, consider an vector that holds 3 elements, where the elements'
- * type takes 2 bytes to store, and the vector's capacity is 4 elements. From
- * the outside, the vector conceptually looks like this:
- *
- * ```
- * [a][b][c][ ]
- *  0  1  2  3
- * ```
- *
- * A caller expects element `c` to be at index 2. This is the "external" index
- * of `c`.
- *
- * Internally, however, the implementation has a byte array that really looks
- * like this:
- *
- * ```
- * [a][a][b][b][c][c][ ][ ]
- *  0     1     2     3     External indices
- *  0  1  2  3  4  5  6  7  Internal indices
- * ```
- *
- * In the byte array, element `c` actually starts at index 4. This is the
- * "internal" index of `c`.
- *
- * Each element (`a`, `b`, and `c`) takes 2 bytes, hence indices 0 and 1 both
- * containing `a`, 2 and 3 both containing `b`, and so on.
- *
- * To convert the internal index (4) to the external index (2), the internal
- * index is divided by the element size (2). To convert the other way, an
- * external index is multiplied by the element size.
- *
- * This fails, and returns 0 (or, if assertions are enabled, causes an assert
- * crash), if the vector pointer is null.
- *
- * @param v The vector whose index is being converted
- * @param index The index to convert
- * @param to_external Whether to convert the given (internal) index to an
- * external index (otherwise, it's assumed the given index is an external index
- * and is converted to an internal index)
- * @return The converted index
+ * @brief Checks the arguments of `Vec_pop_front()` and `Vec_pop_back()`
  */
-static size_t convert_index(Vec const* v,
-                                   size_t const index,
-                                   bool const to_external)
+static bool pop_valid(Vec const* v, void const* item, size_t const item_size)
 {
-    assert(v != NULL);
-    if (v == NULL)
+    return v != NULL &&
+           v->hot.data != NULL &&
+           v->hot.count > 0 &&
+           (item == NULL || item_size == v->hot.element_size);
+}
+
+bool Vec_pop_front(Vec* v, void* item, size_t const item_size)
+{
+    bool const valid = pop_valid(v, item, item_size);
+
+    assert(valid);
+    if (!valid)
     {
-        return 0;
+        return false;
     }
 
-    if (to_external)
+    if (item != NULL)
     {
-        return index / v->element_size;
+        memcpy(item, v->hot.data, v->hot.element_size);
     }
-    else
+    drop_front(v);
+
+    return true;
+}
+
+bool Vec_pop_back(Vec* v, void* item, size_t const item_size)
+{
+    bool const valid = pop_valid(v, item, item_size);
+
+    assert(valid);
+    if (!valid)
     {
-        /*
-         * We should assume there's no overflow since we verified that the index
-         * is within bounds of the vector's elements and the other vector
-         * functions already safeguard against this overflow.
-         */
-        return index * v->element_size;
+        return false;
+    }
+
+    if (item != NULL)
+    {
+        memcpy(item,
+               v->hot.data + v->hot.count_bytes - v->hot.element_size,
+               v->hot.element_size);
     }
+    Vec_remove(v, v->hot.count - 1);
+
+    return true;
 }
 
 /**
- * @brief A convenience wrapper around the index conversion function
- *
- * This fails, and returns 0 (or, if assertions are enabled, causes an assert
- * crash), if the vector pointer is null.
- *
- * @param v The vector whose index is being converted
- * @param index The index to convert
- * @return The converted internal index
+ * @struct
+ * The removal test for `Vec_remove_indices()`: where the vector's elements
+ * start, and the sorted indices of the ones to remove
  */
-static size_t to_internal_index(Vec const* v,
-                                size_t const index)
+typedef struct
 {
-    return convert_index(v, index, false);
-}
+    uint8_t const* data;
+    size_t element_size;
+    size_t const* indices;
+    size_t k; // How many indices there are
+    size_t next; // The first index that hasn't been reached yet
+} IndicesContext;
 
 /**
- * @brief A convenience wrapper around the index conversion function
+ * @brief A removal test that's true for the elements at the indices in the
+ * given context
  *
- * This fails, and returns 0 (or, if assertions are enabled, causes an assert
- * crash), if the vector pointer is null.
+ * Since `compact()` tests the elements in order, the indices are walked along
+ * with it, so each test takes (amortized) constant time.
  *
- * @param v The vector whose index is being converted
- * @param index The index to convert
- * @return The converted external index
+ * @param element An element
+ * @param element_size The element's size in bytes
+ * @param context An `IndicesContext`
+ * @return Whether the element is at one of the indices
  */
-static size_t to_external_index(Vec const* v,
-                                size_t const index)
+static bool at_indices(void const* element,
+                       size_t const element_size,
+                       void* context)
 {
-    return convert_index(v, index, true);
-}
+    IndicesContext* removal = (IndicesContext*) context;
+    size_t const i = (size_t) ((uint8_t const*) element - removal->data)
+                     / element_size;
+    bool removing = false;
+
+    // (Indices given more than once are all passed at once.)
+    while (removal->next < removal->k &&
+           removal->indices[removal->next] == i)
+    {
+        removal->next += 1;
+        removing = true;
+    }
 
-/**
- * @var
- * The item pointer passed in to functions which use the built-in `memcmp()`
- * predicate
- *
- * This pointer is set aside as a global variable so that the `memcmp()`
- * predicate can compare elements to the item pointer without requiring an extra
- * parameter (allowing it to have the same signature as normal, caller-provided
- * predicates).
- */
-static void const* item_for_memcmp_predicate = NULL;
+    return removing;
+}
 
-/**
- * @brief A built-in predicate that compares, bytewise via `memcmp()`, the given
- * element to a global item
- *
- * Some functions take an item pointer and check whether an element in the
- * vector matches that item. There can also be "sibling" functions that, for
- * added flexibility, take a predicate and check whether an element in the
- * vector satisfies that predicate.
- *
- * "Does this element match this item" is an example of such a predicate. The
- * functions that take an item pointer can just reuse the code of the "sibling"
- * functions that take a predicate by calling them with that predicate.
- *
- * This function is that predicate.
- *
- * However, because the expected predicates only take one element argument,
- * there's nowhere for the "item" in "Does this element match this item" to be
- * passed in. As a workaround, the functions that take an item pointer store the
- * item pointer in a global variable, which this function accesses to compare
- * its element argument to.
- *
- * This fails, and returns false (or, if assertions are enabled, causes an
- * assert crash), if either the element pointer or global item pointer are null
- * or the element size is 0.
- *
- * @param element The element to compare to a global item
- * @return Whether the given element's bytes match a global item's
- */
-static bool memcmp_predicate(void const* element, size_t const element_size)
+size_t Vec_remove_indices(Vec* v,
+                          size_t const* sorted_indices,
+                          size_t const k)
 {
-    assert(element != NULL);
-    assert(item_for_memcmp_predicate != NULL);
-    assert(element_size > 0);
-    if (element == NULL ||
-        item_for_memcmp_predicate == NULL ||
-        element_size == 0)
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(sorted_indices != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        sorted_indices == NULL ||
+        k == 0)
     {
-        return false;
+        return 0;
     }
 
-    /*
-     * Note that a tempting optimization here is to compare the global item
-     * pointer to the element pointer, to see if both point to the same memory
-     * address in the vector.
-     *
-     * If both pointers are pointing to the same memory, we don't have to bother
-     * comparing the bytes. If elements are large, that's a lot of work saved!
-     *
-     * But, given the uncertainty surrounding the safety/portability of pointer
-     * comparison, this optimization is NOT done. Item pointers are always
-     * assumed to be pointing to memory outside the vector.
-     */
-    if (memcmp(item_for_memcmp_predicate, element, element_size) == 0)
+    for (size_t j = 0; j < k; ++j)
     {
-        return true;
+        bool const index_out_of_bounds = (sorted_indices[j] >= v->hot.count);
+        bool const indices_unsorted =
+            (j > 0 && sorted_indices[j - 1] > sorted_indices[j]);
+
+        assert(!index_out_of_bounds);
+        assert(!indices_unsorted);
+        if (index_out_of_bounds ||
+            indices_unsorted)
+        {
+            return 0;
+        }
     }
-    else
+
+    IndicesContext removal =
     {
-        return false;
-    }
+        .data = v->hot.data,
+        .element_size = v->hot.element_size,
+        .indices = sorted_indices,
+        .k = k,
+        .next = 0
+    };
+
+    return compact(v, at_indices, &removal);
 }
 
-size_t Vec_where_if(Vec const* v,
-                    bool (*predicate)(void const*, size_t const))
+size_t Vec_remove_all_if(Vec* v,
+                         bool (*predicate)(void const*, size_t const))
 {
     assert(v != NULL);
-    assert(v->data != NULL);
+    assert(v->hot.data != NULL);
+    assert(predicate != NULL);
     if (v == NULL ||
-        v->data == NULL)
+        v->hot.data == NULL ||
+        predicate == NULL ||
+        v->hot.count == 0)
     {
         return 0;
     }
 
+    PredicateContext wrapped = { .predicate = predicate };
+
+    STAT_ADD(v, predicate_calls, v->hot.count);
+
+    return compact(v, call_predicate, &wrapped);
+}
+
+size_t Vec_remove_all_if_ctx(Vec* v,
+                             bool (*predicate)(void const*,
+                                               size_t const,
+                                               void*),
+                             void* context)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
     assert(predicate != NULL);
-    if (predicate == NULL ||
-        v->count == 0)
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        predicate == NULL ||
+        v->hot.count == 0)
+    {
+        return 0;
+    }
+
+    STAT_ADD(v, predicate_calls, v->hot.count);
+
+    return compact(v, predicate, context);
+}
+
+size_t Vec_remove_all_masked(Vec* v,
+                             uint64_t const* mask,
+                             size_t const mask_count)
+{
+    bool const valid = mask_valid(v, mask, mask_count);
+
+    assert(valid);
+    if (!valid ||
+        v->hot.count == 0)
     {
-        return v->count;
+        return 0;
     }
 
-    for (size_t i = 0; i < v->count_bytes; i += v->element_size)
+    size_t const words = (mask_count + 63) / 64;
+    size_t const element_size = v->hot.element_size;
+    size_t e = 0; // The end of the elements that we're NOT removing
+    size_t r = 0; // The start of the current run of elements we're NOT removing
+
+    // Like `compact()`, but only stopping at the elements to remove.
+    for (size_t w = 0; w < words; ++w)
     {
-        if (predicate(&(v->data[i]), v->element_size))
+        uint64_t bits = mask_word(mask, w, mask_count);
+
+        while (bits != 0)
         {
-            return to_external_index(v, i);
+            size_t const i = (w * 64 + lowest_set_bit(bits)) * element_size;
+
+            bits &= bits - 1; // Clear the lowest set bit.
+
+            // Move the run that just ended (if any) down to `e`.
+            if (i > r)
+            {
+                if (e != r)
+                {
+                    move_bytes(v, v->hot.data + e, v->hot.data + r, i - r);
+                }
+                e += i - r;
+            }
+            r = i + element_size;
+        }
+    }
+
+    // Move the final run (if any) down to `e`.
+    if (v->hot.count_bytes > r)
+    {
+        if (e != r)
+        {
+            move_bytes(v, v->hot.data + e, v->hot.data + r,
+                       v->hot.count_bytes - r);
         }
+        e += v->hot.count_bytes - r;
     }
 
-    return v->count;
+    return truncate_compacted(v, e);
 }
 
-size_t Vec_where(Vec const* v,
-                 void const* item,
-                 size_t const item_size)
+size_t Vec_remove_all(Vec* v,
+                      void const* item,
+                      size_t const item_size)
 {
     assert(v != NULL);
-    assert(v->data != NULL);
+    assert(v->hot.data != NULL);
+    assert(item != NULL);
+    assert(item_size == v->hot.element_size);
     if (v == NULL ||
-        v->data == NULL)
+        v->hot.data == NULL ||
+        item == NULL ||
+        item_size != v->hot.element_size ||
+        v->hot.count == 0)
     {
         return 0;
     }
 
-    assert(item != NULL);
-    assert(item_size == v->element_size);
-    if (item == NULL ||
-        item_size != v->element_size ||
-        v->count == 0)
-    {
-        return v->count;
-    }
+    // Remove all elements whose bytes match the given item's.
+    ItemContext target = { .item = item };
 
-    /*
-     * Compare the given item's bytes with those of each element.
-     *
-     * First, store the given item pointer globally, allowing us to re-use the
-     * predicate form of this function with the `memcmp()` predicate.
-     */
-    item_for_memcmp_predicate = item;
+    return compact(v, item_matches, &target);
+}
+
+/**
+ * @struct
+ * The state of `Vec_unique()`'s removal test: the element before the one being
+ * tested, and how to compare them
+ */
+typedef struct
+{
+    uint8_t const* previous; // The element before (or null, before the first)
+    int (*cmp)(void const*, void const*); // The comparator (or null, bytewise)
+} UniqueState;
+
+/**
+ * @brief The removal test for `Vec_unique()`: whether the given element is
+ * equivalent to the one before it
+ *
+ * `compact()` never writes over the element before the one it's testing (its
+ * writes all land before that), so the element before is still where it was.
+ *
+ * @param element An element
+ * @param element_size The element's size in bytes
+ * @param context A `UniqueState`
+ * @return Whether the element is a duplicate of the one before it
+ */
+static bool repeats_previous(void const* element,
+                             size_t const element_size,
+                             void* context)
+{
+    UniqueState* state = (UniqueState*) context;
+    bool const repeats =
+        state->previous != NULL &&
+        ((state->cmp != NULL)
+         ? state->cmp(state->previous, element) == 0
+         : memcmp(state->previous, element, element_size) == 0);
 
-    return Vec_where_if(v, memcmp_predicate);
+    state->previous = (uint8_t const*) element;
+
+    return repeats;
 }
 
-bool Vec_has(Vec const* v,
-             void const* item,
-             size_t const item_size)
+size_t Vec_unique(Vec* v,
+                  int (*cmp)(void const*, void const*))
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(item != NULL);
-    assert(item_size == v->element_size);
+    assert(v->hot.data != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        item == NULL ||
-        item_size != v->element_size ||
-        v->count == 0)
+        v->hot.data == NULL ||
+        v->hot.count < 2)
     {
-        return false;
+        return 0;
     }
 
-    if (v->count != Vec_where(v, item, item_size))
+    UniqueState state =
     {
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+        .previous = NULL,
+        .cmp = cmp
+    };
+
+    return compact(v, repeats_previous, &state);
 }
 
-bool Vec_has_if(Vec const* v,
-                bool (*predicate)(void const*, size_t const))
+size_t Vec_dedup_hashed(Vec* v)
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(predicate != NULL);
+    assert(v->hot.data != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        predicate == NULL ||
-        v->count == 0)
+        v->hot.data == NULL ||
+        v->hot.count < 2)
     {
-        return false;
+        return 0;
     }
 
-    if (v->count != Vec_where_if(v, predicate))
-    {
-        return true;
-    }
-    else
-    {
-        return false;
-    }
-}
+    // Keep the table at most half full, so probes stay short.
+    size_t slot_count = INDEX_MIN_SLOTS;
+    size_t const max_slot_count = SIZE_MAX / sizeof(IndexSlot);
+    bool table_too_big = false;
 
-void* Vec_get(Vec const* v, size_t const external_index)
-{
-    assert(v != NULL);
-    assert(v->data != NULL);
-    if (v == NULL ||
-        v->data == NULL)
+    while (!table_too_big &&
+           slot_count / 2 < v->hot.count)
     {
-        return NULL;
+        table_too_big = (slot_count > max_slot_count / 2);
+        slot_count *= 2;
     }
 
-    bool const index_out_of_bounds = external_index >= v->count;
+    VecAllocator const* allocator = &v->cold->allocator;
+    IndexSlot* slots = table_too_big
+                       ? NULL
+                       : allocator->allocate(allocator->context,
+                                             slot_count * sizeof(IndexSlot));
+    bool const table_allocation_succeeded = (slots != NULL);
 
-    assert(!index_out_of_bounds);
-    if (index_out_of_bounds)
+    assert(table_allocation_succeeded);
+    if (!table_allocation_succeeded)
     {
-        return NULL;
+        return 0;
     }
+    memset(slots, 0, slot_count * sizeof(IndexSlot));
+
+    /*
+     * Each element is looked up among the ones kept before it, which have all
+     * been moved to their final positions (below `e`) by then, so the table
+     * can hold those positions.
+     */
+    size_t const element_size = v->hot.element_size;
+    size_t const mask = slot_count - 1;
+    size_t e = 0; // The end of the elements kept so far
 
-    if (external_index >= v->count)
+    for (size_t i = 0; i < v->hot.count_bytes; i += element_size)
     {
-        // No element exists at the index.
-        return NULL;
+        uint8_t const* element = v->hot.data + i;
+        uint64_t const hash = hash_bytes(element, element_size);
+        size_t s = (size_t) hash & mask;
+        bool duplicate = false;
+
+        for (; slots[s].position != 0; s = (s + 1) & mask)
+        {
+            if (slots[s].hash == hash &&
+                memcmp(v->hot.data + (slots[s].position - 1) * element_size,
+                       element,
+                       element_size) == 0)
+            {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+
+        if (e != i)
+        {
+            move_bytes(v, v->hot.data + e, element, element_size);
+        }
+        slots[s].position = e / element_size + 1;
+        slots[s].hash = hash;
+        e += element_size;
     }
+    allocator->deallocate(allocator->context,
+                          slots,
+                          slot_count * sizeof(IndexSlot));
 
-    return v->data + to_internal_index(v, external_index);
+    return truncate_compacted(v, e);
 }
 
-/**
- * @brief Resizes the given vector to exactly the given capacity
- *
- * WARNING: This may invalidate stored pointers or indices! After a vector's
- * data block is resized, the data block may reside in a totally different
- * region of memory than the one still being pointed to by outside pointers!
- * Also, if the vector was downsized and elements were truncated, pointers or
- * indices that used to correspond to elements in the vector may now be outside
- * the vector's bounds!
- *
- * This fails, and doesn't modify the vector (or, if assertions are enabled,
- * causes an assert crash), if any of the following are true:
- *     - The new capacity is zero or less than the vector's current capacity
- *     - The total byte size (type size * capacity) of the vector will be too
- *       huge to be numerically represented in the vector without overflow
- *     - Reallocating the memory (`realloc()`) failed, internally
- *     - The given vector pointer is null
- *
- * @param v The vector to resize
- * @param new_capacity The new capacity
- * @return Whether the vector was successfully resized
- */
-static bool Vec_resize(Vec* v, size_t const new_capacity)
+bool Vec_qsort(Vec* v,
+               int (*cmp)(void const*, void const*))
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(new_capacity != 0);
-    assert(new_capacity > v->capacity);
+    assert(v->hot.data != NULL);
+    assert(cmp != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        new_capacity == 0 ||
-        new_capacity <= v->capacity)
+        v->hot.data == NULL ||
+        cmp == NULL ||
+        v->hot.count == 0)
     {
         return false;
     }
 
-    // (If okay with requiring C23, this should just be a `ckd_mul()`.)
-    size_t const max_elements = SIZE_MAX / v->element_size;
-    bool const total_byte_size_overflowed = new_capacity > max_elements;
+    qsort(v->hot.data, v->hot.count, v->hot.element_size, cmp);
+    index_rebuild(v);
 
-    assert(!total_byte_size_overflowed);
-    if (total_byte_size_overflowed)
+    return true;
+}
+
+/**
+ * @brief Reads the radix sort key of the given element as an unsigned integer
+ * whose order is the key's order
+ *
+ * For signed keys, flipping the sign bit maps the most negative key to 0, and
+ * the most positive key to the biggest unsigned value, preserving order in
+ * between.
+ *
+ * @param element The element
+ * @param key_offset The byte offset of the key in the element
+ * @param key_size The byte size of the key (4 or 8)
+ * @param key_signed Whether the key is a signed integer
+ * @return The key, as an order-preserving unsigned integer
+ */
+static uint64_t radix_key(uint8_t const* element,
+                          size_t const key_offset,
+                          size_t const key_size,
+                          bool const key_signed)
+{
+    if (key_size == sizeof(uint32_t))
     {
-        return false;
-    }
+        uint32_t key = 0;
 
-    size_t const new_capacity_bytes = v->element_size * new_capacity;
-    uint8_t* success = realloc(v->data, sizeof(uint8_t*[new_capacity_bytes]));
-    bool const vector_realloc_succeeded = (success != NULL);
+        memcpy(&key, element + key_offset, sizeof(key));
 
-    assert(vector_realloc_succeeded);
-    if (!vector_realloc_succeeded)
-    {
-        return false;
+        return key_signed ? (key ^ ((uint32_t) 1 << 31)) : key;
     }
 
-    v->data = success;
-    v->capacity = new_capacity;
-    v->capacity_bytes = new_capacity_bytes;
+    uint64_t key = 0;
 
-    return true;
+    memcpy(&key, element + key_offset, sizeof(key));
+
+    return key_signed ? (key ^ ((uint64_t) 1 << 63)) : key;
 }
 
-/**
- * @brief Handles expansion of the given vector when it's run out of room for
- * new elements
- *
- * WARNING: This may invalidate stored pointers or indices! After a vector's
- * data block is resized, the data block may reside in a totally different
- * region of memory than the one still being pointed to by outside pointers!
- * Also, if the vector was downsized and elements were truncated, pointers or
- * indices that used to correspond to elements in the vector may now be outside
- * the vector's bounds!
- *
- * This fails, and doesn't modify the vector (or, if assertions are enabled,
- * causes an assert crash), if any of the following are true:
- *     - The vector's not full (i.e., its capacity is not actually exhausted)
- *     - When expanded, the vector's capacity would become so huge that it can
- *       no longer be represented by the vector's internal data without overflow
- *     - The vector pointer is null
- *
- * @param v The vector to expand
- * @return Whether the vector was successfully expanded
- */
-static bool handle_capacity_exhaustion(Vec* v)
+bool Vec_radix_sort(Vec* v,
+                    size_t const key_offset,
+                    size_t const key_size,
+                    bool const key_signed)
 {
     assert(v != NULL);
-    assert(v->count == v->capacity);
+    assert(v->hot.data != NULL);
     if (v == NULL ||
-        v->count != v->capacity)
+        v->hot.data == NULL)
     {
         return false;
     }
 
-    size_t const expansion_factor = 2;
-
-    /*
-     * Do nothing if the total bytes overflow when multiplied by some factor.
-     *
-     * (If okay with requiring C23, this should just be a `ckd_mul()` on the new
-     * capacity.)
-     */
-    bool const expanded_capacity_overflowed =
-        (v->capacity > 0 &&
-        (v->capacity > (SIZE_MAX / expansion_factor)));
+    bool const key_valid =
+        (key_size == sizeof(uint32_t) || key_size == sizeof(uint64_t)) &&
+        key_offset <= v->hot.element_size &&
+        key_size <= v->hot.element_size - key_offset;
 
-    assert(!expanded_capacity_overflowed);
-    if (expanded_capacity_overflowed)
+    assert(key_valid);
+    if (!key_valid)
     {
         return false;
     }
 
-    size_t const expanded_capacity = v->capacity * expansion_factor;
+    if (v->hot.count < 2)
+    {
+        return true; // Already sorted
+    }
 
-    return Vec_resize(v, expanded_capacity);
-}
+    // Count the occurrences of every byte value in every byte of the keys.
+    size_t counts[sizeof(uint64_t)][UINT8_MAX + 1] = {{0}};
 
-bool Vec_append(Vec* v, void const* item, size_t const item_size)
-{
-    assert(v != NULL);
-    assert(v->data != NULL);
-    assert(item != NULL);
-    assert(item_size == v->element_size);
-    if (v == NULL ||
-        v->data == NULL ||
-        item == NULL ||
-        item_size != v->element_size)
+    for (size_t i = 0; i < v->hot.count_bytes; i += v->hot.element_size)
     {
-        return false;
+        uint64_t const key = radix_key(v->hot.data + i,
+                                       key_offset,
+                                       key_size,
+                                       key_signed);
+
+        for (size_t b = 0; b < key_size; ++b)
+        {
+            counts[b][(key >> (b * 8)) & UINT8_MAX] += 1;
+        }
     }
 
-    /*
-     * Do nothing if size will overflow after addition.
-     *
-     * (If okay with requiring C23, this should just be a `ckd_add()` on the
-     * new size.)
-     */
-    bool const element_count_overflowed = ((v->count + 1) < v->count);
+    uint8_t* buffer = v->cold->allocator.allocate(v->cold->allocator.context,
+                                                  v->hot.count_bytes);
 
-    assert(!element_count_overflowed);
-    if (element_count_overflowed)
+    assert(buffer != NULL);
+    if (buffer == NULL)
     {
         return false;
     }
 
-    // If at capacity, try to expand the vector first.
-    if (v->count == v->capacity)
+    uint8_t* src = v->hot.data;
+    uint8_t* dst = buffer;
+
+    // Stably distribute the elements by each key byte, least significant first.
+    for (size_t b = 0; b < key_size; ++b)
     {
-        if (!handle_capacity_exhaustion(v))
+        // Where a byte's elements start is the count of all smaller bytes.
+        size_t offsets[UINT8_MAX + 1];
+        size_t offset = 0;
+        bool all_same = false;
+
+        for (size_t value = 0; value <= UINT8_MAX; ++value)
         {
-            // Do nothing if expansion failed.
-            return false;
+            all_same = all_same || counts[b][value] == v->hot.count;
+            offsets[value] = offset;
+            offset += counts[b][value] * v->hot.element_size;
         }
 
-        // We're assured we expanded.
-        assert(v->count < v->capacity);
+        if (all_same)
+        {
+            continue; // Every key has the same byte here; nothing to reorder.
+        }
 
-        // Check that we expanded such that we have room for one more element.
-        assert(v->capacity_bytes - v->count_bytes >= v->element_size);
+        for (size_t i = 0; i < v->hot.count_bytes; i += v->hot.element_size)
+        {
+            uint64_t const key = radix_key(src + i,
+                                           key_offset,
+                                           key_size,
+                                           key_signed);
+            size_t* slot = &offsets[(key >> (b * 8)) & UINT8_MAX];
+
+            memcpy(dst + *slot, src + i, v->hot.element_size);
+            *slot += v->hot.element_size;
+        }
+
+        uint8_t* swap = src;
+
+        src = dst;
+        dst = swap;
     }
 
-    // Append the item.
-    memcpy((v->data + (v->count * v->element_size)),
-           item,
-           item_size);
-    v->count += 1;
-    v->count_bytes += v->element_size;
+    if (src != v->hot.data)
+    {
+        memcpy(v->hot.data, src, v->hot.count_bytes);
+    }
+
+    v->cold->allocator.deallocate(v->cold->allocator.context,
+                                  buffer,
+                                  v->hot.count_bytes);
+    index_rebuild(v);
 
     return true;
 }
 
 /**
- * @brief Swaps the elements at the given internal indices in the given vector
- *
- * WARNING: This may invalidate stored pointers or indices! After a vector's
- * elements are swapped, pointers or indices that used to correspond to those
- * elements in the vector will now correspond to the swapped element!
+ * @brief Binary searches the given (sorted) vector for the first element that
+ * isn't "less" than the given item or, for an upper bound, that's "greater"
+ * than the item
+ * @param v The vector to search, sorted according to the comparator
+ * @param item The item to search for
+ * @param cmp The comparator the vector is sorted by
+ * @param upper Whether to search for an upper bound, as opposed to a lower one
+ * @return The external index of the bound (or, if there's no such element, the
+ * number of elements)
+ */
+static size_t bound(Vec const* v,
+                    void const* item,
+                    int (*cmp)(void const*, void const*),
+                    bool const upper)
+{
+    size_t low = 0;
+    size_t high = v->hot.count;
+
+    while (low < high)
+    {
+        size_t const mid = low + (high - low) / 2;
+        int const order = cmp(v->hot.data + to_internal_index(v, mid), item);
+
+        if (upper ? (order <= 0) : (order < 0))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Checks the arguments of the binary search functions
  *
- * This fails, and doesn't modify the vector (or, if assertions are enabled,
- * causes an assert crash), if any of the following are true:
- *     - The indices are the same
- *     - Either index is not aligned on an element boundary (and thus invalid
- *       since it's not pointing to the first byte of an element)
- *     - Either index is out of bounds of the vector's elements
- *     - The vector pointer is null
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the pointers are null, or the item size doesn't
+ * match the vector's element size.
  *
- * @param v The vector to swap the elements of
- * @param a The internal index of an element
- * @param b The internal index of another element
- * @return Whether the elements were swapped
+ * @param v The vector to search
+ * @param item The item to search for
+ * @param item_size The item's size in bytes
+ * @param cmp The comparator the vector is sorted by
+ * @return Whether the arguments are valid
  */
-static bool swap(Vec* v, size_t const a, size_t const b)
+static bool search_valid(Vec const* v,
+                         void const* item,
+                         size_t const item_size,
+                         int (*cmp)(void const*, void const*))
+{
+    assert(item != NULL);
+    assert(item_size == v->hot.element_size);
+    assert(cmp != NULL);
+
+    return item != NULL &&
+           item_size == v->hot.element_size &&
+           cmp != NULL;
+}
+
+size_t Vec_lower_bound(Vec const* v,
+                       void const* item,
+                       size_t const item_size,
+                       int (*cmp)(void const*, void const*))
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    if (v == NULL ||
-        v->data == NULL)
+    if (v == NULL)
     {
-
-        return false;
+        return 0;
     }
 
-    assert(a != b);
-    assert(a % v->element_size == 0); // Aligned on element boundary
-    assert(b % v->element_size == 0);
-    assert(a < v->count_bytes); // Within element bounds
-    assert(b < v->count_bytes);
-    if (a == b ||
-        a % v->element_size != 0 ||
-        b % v->element_size != 0 ||
-        a >= v->count_bytes ||
-        b >= v->count_bytes)
+    if (!search_valid(v, item, item_size, cmp))
     {
-        return false;
+        return v->hot.count;
     }
 
-    // Iterate through the elements' bytes and swap one byte pair at a time.
-    for (size_t i = 0; i < v->element_size; ++i)
+    return bound(v, item, cmp, false);
+}
+
+size_t Vec_upper_bound(Vec const* v,
+                       void const* item,
+                       size_t const item_size,
+                       int (*cmp)(void const*, void const*))
+{
+    assert(v != NULL);
+    if (v == NULL)
     {
-        uint8_t* a_byte = (v->data + a + i);
-        uint8_t* b_byte = (v->data + b + i);
+        return 0;
+    }
 
-        *a_byte ^= *b_byte;
-        *b_byte ^= *a_byte;
-        *a_byte ^= *b_byte;
+    if (!search_valid(v, item, item_size, cmp))
+    {
+        return v->hot.count;
     }
 
-    return true;
+    return bound(v, item, cmp, true);
 }
 
-/**
- * @brief Inserts the given item in the given vector (which has free space for
- * at least one additional element)
- *
- * The index at which to insert is intuited from the given number of elements to
- * be shifted.
- *
- * WARNING: This may invalidate stored pointers or indices! To make room for the
- * insertion (if it's anywhere else than the end of the elements), the vector's
- * elements are automatically shifted to make room. As a result, pre-existing
- * pointers or indices may no longer correspond to the elements they did before
- * insertion!
- *
- * @param v The vector to insert to
- * @param elements_to_shift How many elements need to be displaced for insertion
- * @param item The item to insert
- */
-static bool insert_when_room(Vec* v,
-                             size_t elements_to_shift,
-                             void const* item)
+size_t Vec_bsearch(Vec const* v,
+                   void const* item,
+                   size_t const item_size,
+                   int (*cmp)(void const*, void const*))
 {
-    /*
-     * Write the item to the first free internal index of the vector (i.e., at
-     * the end of the elements, immediately after the final element).
-     */
-    memcpy(v->data + v->count_bytes,
-           item,
-           v->element_size);
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
 
-    size_t inserted_index_i = v->count_bytes;
+    if (!search_valid(v, item, item_size, cmp))
+    {
+        return v->hot.count;
+    }
 
-    /*
-     * Update metadata here so the swap function doesn't think we're swapping
-     * with empty space past the final element.
-     */
-    v->count += 1;
-    v->count_bytes += v->element_size;
+    size_t const index = bound(v, item, cmp, false);
 
-    while (elements_to_shift > 0)
+    if (index < v->hot.count &&
+        cmp(v->hot.data + to_internal_index(v, index), item) == 0)
     {
-        swap(v,
-             inserted_index_i,
-             inserted_index_i - v->element_size);
-
-        elements_to_shift--;
-        inserted_index_i -= v->element_size;
+        return index;
     }
 
-    return true;
+    return v->hot.count;
 }
 
-/**
- * @brief Inserts the given item at the given internal index of the given vector
- * (which has no free space left and must be expanded first)
- *
- * WARNING: This may invalidate stored pointers or indices! To make room for the
- * insertion (if it's anywhere else than the end of the elements), the vector's
- * elements are automatically shifted to make room. As a result, pre-existing
- * pointers or indices may no longer correspond to the elements they did before
- * insertion! Also, since it's full, the vector undergoes automatic expansion to
- * fit the new element, so the vector's data block is resized. Resizing may
- * relocate the data block to a totally different region of memory than the one
- * still being pointed to by outside pointers!
- *
- * This fails, and doesn't modify the vector (or, if assertions are enabled,
- * causes an assert crash), if any of the following are true:
- *     - A temporary copy of the item can't be allocated
- *     - The vector can't be expanded
- *
- * @param v The vector to insert to
- * @param insertion_index_i The internal index to insert at
- * @param elements_to_shift How many elements need to be displaced for insertion
- * @param item The item to insert
- */
-static void insert_when_no_room(Vec* v,
-                                size_t const insertion_index_i,
-                                size_t const elements_to_shift,
-                                void const* item)
+bool Vec_insert_sorted(Vec* v,
+                       void const* item,
+                       size_t const item_size,
+                       int (*cmp)(void const*, void const*))
 {
-    /*
-     * Dynamically allocate a temporary copy of the item. This way, if the item
-     * pointer is pointing to an item that's already inside the vector, we won't
-     * lose the item when the pointer gets invalidated after expanding the
-     * vector.
-     *
-     * Note that an alternative is searching the vector to get the index where
-     * the item is (if the item, or an exact copy, is in the vector), tracking
-     * the index across any shifts, and using the index to re-acquire the item
-     * after vector expansion and element shifting before insertion. This would
-     * require no dynamic allocation. However, since the item may be a struct,
-     * which means it has random ("uninitialized") padding bytes, and since we
-     * don't have a caller-supplied comparator, we'll have to use bytewise
-     * comparison of the elements when searching the vector. Since we're
-     * searching the vector for the same exact item, or an exact copy, bytewise
-     * comparison would still work despite the item's random padding bytes.
-     * Valgrind can't know this, though, and will issue "Conditional jump or
-     * move depends on uninitialised value(s)" errors for every struct insertion
-     * because we're comparing random bytes (even if it's against themselves).
-     * So, just to keep Valgrind output clean, dynamic allocation is used here
-     * instead of vector search and index acquisition.
-     */
-    void* tmp = malloc(v->element_size);
-
-    assert(tmp != NULL);
-    if (tmp == NULL)
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        !search_valid(v, item, item_size, cmp))
     {
-        return;
+        return false;
     }
-    memcpy(tmp, item, v->element_size);
 
-    // Since the vector's full, expand it before insertion.
-    bool const resized = handle_capacity_exhaustion(v);
+    bool const element_count_overflowed = ((v->hot.count + 1) < v->hot.count);
 
-    assert(resized);
-    if (!resized)
+    assert(!element_count_overflowed);
+    if (element_count_overflowed)
     {
-        // Do nothing if expansion failed.
-        return;
+        return false;
     }
 
     /*
-     * Shift the elements at and after the insertion site to the right to make
-     * room for insertion.
+     * Inserting after any equal elements keeps equal elements in the order
+     * they were inserted. (Like with `Vec_insert()`, the item may be inside
+     * the vector; the insertion engine stages a copy of it before shifting.)
      */
-    if (elements_to_shift > 0)
-    {
-        // Shift element(s) to the right by one element's size in bytes.
-        memmove(v->data + insertion_index_i + v->element_size,
-                v->data + insertion_index_i,
-                elements_to_shift * v->element_size);
-    }
+    size_t const insertion_index_e = bound(v, item, cmp, true);
 
-    // Insert the item.
-    memcpy(v->data + insertion_index_i,
-           tmp,
-           v->element_size);
-    v->count += 1;
-    v->count_bytes += v->element_size;
-
-    // Free the temporary copy.
-    free(tmp);
+    return insert_at(v, to_internal_index(v, insertion_index_e), item);
 }
 
-bool Vec_insert(Vec* v,
-                size_t const insertion_index_e,
-                void const* item,
-                size_t const item_size)
+bool Vec_merge_sorted(Vec* v,
+                      void const* items,
+                      size_t const n,
+                      size_t const item_size,
+                      int (*cmp)(void const*, void const*))
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(item != NULL);
-    assert(item_size == v->element_size);
+    assert(v->hot.data != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        item == NULL ||
-        item_size != v->element_size)
+        v->hot.data == NULL ||
+        !search_valid(v, items, item_size, cmp))
     {
         return false;
     }
 
-    /*
-     * Do nothing if size will overflow after addition.
-     *
-     * (If okay with requiring C23, this should just be a `ckd_add()` on the
-     * new size.)
-     */
-    bool const element_count_overflowed = ((v->count + 1) < v->count);
-    bool const index_out_of_bounds = (insertion_index_e > v->count);
+    if (n == 0)
+    {
+        return true;
+    }
 
-    assert(!element_count_overflowed);
-    assert(!index_out_of_bounds);
-    if (element_count_overflowed ||
-        index_out_of_bounds)
+    // Do nothing if the items' total byte size overflows.
+    bool const total_byte_overflow = n > (SIZE_MAX / v->hot.element_size);
+
+    assert(!total_byte_overflow);
+    if (total_byte_overflow ||
+        !reserve_room(v, n))
     {
         return false;
     }
 
-    size_t const insertion_index_i = to_internal_index(v, insertion_index_e);
-    size_t const elements_to_shift = (v->count - insertion_index_e);
-
     /*
-     * How insertion is done depends on whether the vector's full.
-     *
-     * This is an insurance policy for the case where the given item pointer is
-     * pointing to an item that's already inside the vector. In such a case, the
-     * item will move out from under the pointer if it needs to shift along with
-     * the other elements to make room at the insertion site. If the vector is
-     * full and needs to be resized, the item might move out from under the
-     * pointer in an additional way: the vector's elements may be allocated to a
-     * totally different block of memory than the one where the item pointer
-     * would still be pointing. In other words, the item pointer will be
-     * invalidated before we get to insert the item.
-     *
-     * When this is not the case -- when the item pointer is NOT pointing to an
-     * item already inside the vector -- this is all unfortunate overhead, but
-     * there's no way to know if the item pointer is pointing inside the vector,
-     * at least not without pointer address comparison (which is avoided for
-     * safety/portability and totally not superstition surrounding rumored GCC
-     * bugs in that StackOverflow article linked elsewhere in this file).
-     *
-     * To handle this case in a way that doesn't involve bytewise comparison
-     * between the vector's elements and the item to acquire its index (this
-     * would work whether the vector's full or not but causes Valgrind errors
-     * due to bytewise comparison of the random padding bytes when the elements
-     * are structs), two different methods are employed based on whether the
-     * vector is full.
+     * Merge from the back, into the room at the end, so every element is
+     * written at most once and never over an element that's yet to be read.
+     * On ties, the items go after the elements (like with
+     * `Vec_insert_sorted()`). Once the items run out, the elements left at the
+     * front are already where they belong.
      */
-    if (v->count == v->capacity)
-    {
-        insert_when_no_room(v,
-                            insertion_index_i,
-                            elements_to_shift,
-                            item);
-    }
-    else
+    size_t const element_size = v->hot.element_size;
+    uint8_t const* item_bytes = (uint8_t const*) items;
+    uint8_t* elements_end = v->hot.data + v->hot.count_bytes;
+    uint8_t const* items_end = item_bytes + n * element_size;
+    uint8_t* out = elements_end + n * element_size;
+
+    while (items_end != item_bytes)
     {
-        insert_when_room(v,
-                         elements_to_shift,
-                         item);
+        out -= element_size;
+        if (elements_end != v->hot.data &&
+            cmp(elements_end - element_size, items_end - element_size) > 0)
+        {
+            elements_end -= element_size;
+            memcpy(out, elements_end, element_size);
+        }
+        else
+        {
+            items_end -= element_size;
+            memcpy(out, items_end, element_size);
+        }
     }
 
+    v->hot.count += n;
+    v->hot.count_bytes += n * element_size;
+    index_rebuild(v);
+    hash_rebuild(v);
+
     return true;
 }
 
-size_t Vec_remove(Vec* v, size_t const external_index)
+int Vec_apply(Vec* v,
+              int (*fun)(void* element,
+                         size_t const element_size,
+                         void* state),
+              void* caller_state)
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(v->count > 0);
+    assert(v->hot.data != NULL);
+    assert(fun != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        v->count == 0)
+        v->hot.data == NULL ||
+        fun == NULL ||
+        v->hot.count == 0)
     {
-        return 0;
+        return 1;
     }
 
-    bool const index_out_of_bounds = (external_index >= v->count);
+    size_t i = 0;
+    int return_value = 0;
+    size_t const ahead = prefetch_distance(v);
 
-    assert(!index_out_of_bounds);
-    if (index_out_of_bounds)
+    while (i < v->hot.count_bytes)
     {
-        return v->count;
+        prefetch_ahead(v, i, ahead);
+        return_value = fun(v->hot.data + i,
+                           v->hot.element_size,
+                           caller_state);
+
+        if (return_value != 0)
+        {
+            // Terminate early, relaying the function's error return value.
+            break;
+        }
+
+        i += v->hot.element_size;
     }
 
-    size_t internal_index = to_internal_index(v, external_index);
+    // The function may have changed elements (and their keys).
+    index_rebuild(v);
+    hash_rebuild(v);
 
-    /*
-     * "Removing" the element from the vector's data block primarily means
-     * changing the vector's metadata to let it reuse the element's bytes in the
-     * block as if there were no element there anymore.
-     */
-    v->count -= 1;
-    v->count_bytes -= v->element_size;
+    return return_value;
+}
 
-    /*
-     * To maintain contiguity of the block data, though (and we assume it
-     * was contiguous prior to removing the element), we have to shift the
-     * vector's elements leftward.
-     *
-     * E.g., if removing the element at index 2 and the vector looks like
-     * this
-     *
-     * ```
-     * [a][b][ ][d][e][ ]
-     *  0  1  2  3  4  5
-     * ```
-     *
-     * the data is no longer contiguous, and we have to shift the elements
-     * so it looks like this
-     *
-     * ```
-     * [a][b][d][e][ ][ ]
-     *  0  1  2  3  4  5
-     * ```
-     *
-     * so the data is contiguous again.
-     */
-    size_t elements_to_shift = (v->count - external_index);
+int Vec_apply_const(Vec const* v,
+                    int (*fun)(void const* element,
+                               size_t const element_size,
+                               void* state),
+                    void* caller_state)
+{
+    assert(v != NULL);
+    assert(v->hot.data != NULL);
+    assert(fun != NULL);
+    if (v == NULL ||
+        v->hot.data == NULL ||
+        fun == NULL ||
+        v->hot.count == 0)
+    {
+        return 1;
+    }
+
+    size_t i = 0;
+    int return_value = 0;
+    size_t const ahead = prefetch_distance(v);
 
-    while (elements_to_shift > 0)
+    while (i < v->hot.count_bytes)
     {
-        // Shift the elements leftward to fill the gap.
-        memcpy(v->data + internal_index,
-               v->data + internal_index + v->element_size,
-               v->element_size);
+        prefetch_ahead(v, i, ahead);
+        return_value = fun(v->hot.data + i,
+                           v->hot.element_size,
+                           caller_state);
 
-        internal_index += v->element_size;
-        elements_to_shift -= 1;
-    }
+        if (return_value != 0)
+        {
+            // Terminate early, relaying the function's error return value.
+            break;
+        }
 
-    /*
-     * Next, whether or not any elements were shifted, there now exists a "ghost
-     * element" at the end of the vector:
-     *
-     * ```
-     * [a][b][d][e][-][ ]
-     *  0  1  2  3  4  5
-     * ```
-     *
-     * The "ghost element" is `-`.
-     *
-     * If we shifted elements (after removing an element `c` near the beginning
-     * of the vector), `-` contains the memory of the element `e`, which used to
-     * occupy the bytes at index 4 in the data block but has been shifted left
-     * to index 3.
-     *
-     * If we didn't shift elements, `-` contains the memory of the element that
-     * was removed, which was the final element in the vector.
-     *
-     * While the vector is free to reuse and overwrite that segment of the data
-     * block, the "ghost data" in that segment might still be read (accidentally
-     * or otherwise) by a user of the vector.
-     *
-     * The caller should reasonably expect the data of removed elements to be
-     * completely "gone", but nothing prevents a later caller from obtaining the
-     * `void*` to the element at index 3, casting it to a pointer type they can
-     * do pointer arithmetic with, and incrementing it by one in order to read
-     * the memory at index 4, recovering `-`'s ghost data. Since this data might
-     * be sensitive and this might pose a security concern, we zero out the
-     * "ghost element", setting its bytes to `0`:
-     *
-     * ```
-     * [a][b][d][e][0][ ]
-     *  0  1  2  3  4  5
-     * ```
-     *
-     * (If okay with requiring C23, `memset_explicit()` should be used here
-     * instead, which prevents the compiler from optimizing it away, unlike
-     * `memset()`.)
-     */
-    memset((v->data + internal_index),
-           0,
-           v->element_size);
+        i += v->hot.element_size;
+    }
 
-    /*
-     * Finally, return the index of the next element.
-     *
-     * Since the elements are contiguous and we shifted them down by one, the
-     * element after the one we removed is at the same index as the element we
-     * removed.
-     *
-     * If the element we removed was the final one, we return the index of the
-     * "one-past the last element". Since the elements are contiguous, that's
-     * also just the index of the element we removed.
-     */
-    return external_index;
+    return return_value;
 }
 
-size_t Vec_remove_all_if(Vec* v,
-                         bool (*predicate)(void const*, size_t const))
+int Vec_apply_masked(Vec* v,
+                     uint64_t const* mask,
+                     size_t const mask_count,
+                     int (*fun)(void* element,
+                                size_t const element_size,
+                                void* state),
+                     void* caller_state)
 {
-    assert(v != NULL);
-    assert(v->data != NULL);
-    assert(predicate != NULL);
-    if (v == NULL ||
-        v->data == NULL ||
-        predicate == NULL ||
-        v->count == 0)
+    bool const valid = mask_valid(v, mask, mask_count) &&
+                       fun != NULL;
+
+    assert(valid);
+    if (!valid ||
+        v->hot.count == 0)
     {
-        return 0;
+        return 1;
     }
 
-    /*
-     * Remove all elements which satisfy the predicate.
-     *
-     * The most obvious way to do this would be to iterate through the vector
-     * and, for every element that satisfies the predicate, call the regular
-     * remove function with that element's index.
-     *
-     * However, for every removed element `x`, the remove function would shift
-     * all the elements after `x` to the left to keep the vector contiguous.
-     * Since we're potentially removing some of those shifted elements as well,
-     * those shifts are a waste! Each shift can be thought of as a linear
-     * traversal of the vector's byte array, so that's `r` traversals where `r`
-     * is the number of elements removed. That's on top of the traversal we were
-     * doing to find elements that satisfy the predicate, so it's a total of
-     * `r + 1` traversals.
-     *
-     * We can actually do it in just 1 traversal if we swap the elements that we
-     * know we're NOT removing!
-     *
-     * We iterate through the vector while keeping an "end of the elements we're
-     * NOT removing" index. Call that index `e`. For every element that does NOT
-     * satisfy the predicate (i.e., that we're NOT removing), swap it with the
-     * element at index `e` and then increment `e`. By the end of the iteration,
-     * all the elements we're removing will be clustered together at the tail
-     * end of the array. Let the elements to be removed be `x` and suppose the
-     * vector initially looks like this:
-     *
-     * ```
-     * [a][x][b][x][c][x]
-     *  0  1  2  3  4  5
-     *  ^
-     *  e starts here
-     * ```
-     *
-     * At the end of the iteration, the vector will look like this:
-     *
-     * ```
-     * [a][b][c][x][x][x]
-     *  0  1  2  3  4  5
-     *           ^
-     *           e ends up here
-     * ```
-     *
-     * Then the `x`s can be removed all at once by "cutting off" the tail end of
-     * the vector at index `e`.
-     *
-     * That's all elements removed with only 1 traversal and, in the worst case,
-     * `k` O(1) swaps where `k` is the number of elements kept after all the
-     * removals (to be convinced of that, picture an array with a single `x` at
-     * the beginning and count the swaps made). This is the "erase-remove idiom"
-     * from C++, but it's being done all in this function instead of through
-     * container-generic algorithms.
-     */
-    size_t e = 0; // The end of the elements that we're NOT removing
+    size_t const words = (mask_count + 63) / 64;
+    int return_value = 0;
 
-    for (size_t i = 0; i < v->count_bytes; i += v->element_size)
+    for (size_t w = 0; w < words && return_value == 0; ++w)
     {
-        bool const removing = predicate(v->data + i, v->element_size);
+        uint64_t bits = mask_word(mask, w, mask_count);
 
-        // For an element we're NOT removing...
-        if (!removing)
+        while (bits != 0)
         {
-            /*
-             * ...if it follows an element we ARE removing (at which point `i`
-             * outpaces `e`, with the element are ARE removing at `e`), swap it
-             * with the element at `e`.
-             */
-            if (i > e)
+            size_t const i = w * 64 + lowest_set_bit(bits);
+
+            bits &= bits - 1; // Clear the lowest set bit.
+            return_value = fun(v->hot.data + i * v->hot.element_size,
+                               v->hot.element_size,
+                               caller_state);
+            if (return_value != 0)
             {
-                if (!swap(v, i, e))
-                {
-                    // Terminate early if there was a problem swapping elements.
-                    return 0;
-                }
-                /*
-                 * After the swap, the element we're NOT removing, which was at
-                 * `e`, is now at `i`, closer to the tail end of the vector.
-                 *
-                 * Also, update the built-in `memcmp()` predicate item pointer
-                 * to the swapped element's new location, at `i`. If this call
-                 * is using not using the built-in `memcmp()` predicate, this is
-                 * just unfortunate overhead. However, if we are using the
-                 * built-in `memcmp()` predicate, and if the caller passed in an
-                 * item pointer to memory inside the vector, the swap might've
-                 * just changed the bytes from underneath that pointer! That'd
-                 * cause the built-in `memcmp()` predicate to compare subsequent
-                 * elements against totally different bytes than those of the
-                 * target element. Updating the pointer to the just-swapped
-                 * element safeguards against this. Assuming the caller heeded
-                 * the warning in the docs to not use bytewise comparisons for
-                 * element types whose bytes may vary for otherwise equivalent
-                 * elements (such as structs), the element we just swapped has
-                 * bytes that match the target element's, so we can confidently
-                 * use it as the target even if it's a different instance.
-                 */
-                item_for_memcmp_predicate = (void const*) (v->data + i);
+                // Terminate early, relaying the function's error return value.
+                break;
             }
-            e += v->element_size;
         }
     }
 
-    /*
-     * Remove all the elements now concentrated at the tail by chopping off the
-     * tail at `e`.
-     *
-     * Just like when removing a single element, all this takes is updating the
-     * vector's metadata to consider that number of elements gone from its tail
-     * end.
-     */
-    size_t const elements_removed = (v->count - to_external_index(v, e));
+    // The function may have changed elements (and their keys).
+    index_rebuild(v);
+    hash_rebuild(v);
 
-    v->count -= elements_removed;
-    v->count_bytes -= (v->element_size * elements_removed);
+    return return_value;
+}
 
-    /*
-     * Also just like when removing a single element, zero out the memory of the
-     * removed elements.
-     *
-     * (If okay with requiring C23, `memset_explicit()` should be used here
-     * instead, which prevents the compiler from optimizing it away, unlike
-     * `memset()`.)
-     */
-    memset((v->data + e),
-           0,
-           (v->element_size * elements_removed));
+#if defined(VEC_STATS)
+/**
+ * @brief Copies the given counters out into the given stats
+ */
+static void read_stats(Vec const* v,
+                       StatsRecord const* record,
+                       VecStats* stats)
+{
+    *stats = (VecStats) { .element_size = v->hot.element_size };
+    if (record == NULL)
+    {
+        return;
+    }
 
-    return elements_removed;
+    stats->name = record->name;
+    stats->expansions = atomic_load_explicit(&record->expansions,
+                                             memory_order_relaxed);
+    stats->resizes = atomic_load_explicit(&record->resizes,
+                                          memory_order_relaxed);
+    stats->bytes_reallocated =
+        atomic_load_explicit(&record->bytes_reallocated, memory_order_relaxed);
+    stats->bytes_moved = atomic_load_explicit(&record->bytes_moved,
+                                              memory_order_relaxed);
+    stats->peak_capacity = atomic_load_explicit(&record->peak_capacity,
+                                                memory_order_relaxed);
+    stats->predicate_calls =
+        atomic_load_explicit(&record->predicate_calls, memory_order_relaxed);
+    stats->searches = atomic_load_explicit(&record->searches,
+                                           memory_order_relaxed);
+    stats->elements_searched =
+        atomic_load_explicit(&record->elements_searched, memory_order_relaxed);
+    stats->indexed_searches =
+        atomic_load_explicit(&record->indexed_searches, memory_order_relaxed);
 }
 
-size_t Vec_remove_all(Vec* v,
-                      void const* item,
-                      size_t const item_size)
+bool Vec_stats(Vec const* v, VecStats* stats)
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(item != NULL);
-    assert(item_size == v->element_size);
+    assert(stats != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        item == NULL ||
-        item_size != v->element_size ||
-        v->count == 0)
+        stats == NULL)
     {
-        return 0;
+        return false;
     }
 
-    /*
-     * Remove all elements whose bytes match the given item's.
-     *
-     * First, store the given item pointer globally, allowing us to re-use the
-     * predicate form of this function with the `memcmp()` predicate.
-     */
-    item_for_memcmp_predicate = item;
+    read_stats(v, v->stats, stats);
 
-    return Vec_remove_all_if(v, memcmp_predicate);
+    return true;
 }
 
-bool Vec_qsort(Vec* v,
-               int (*cmp)(void const*, void const*))
+void Vec_reset_stats(Vec* v)
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(cmp != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        cmp == NULL ||
-        v->count == 0)
+        v->stats == NULL)
     {
-        return false;
+        return;
     }
 
-    qsort(v->data, v->count, v->element_size, cmp);
-
-    return true;
+    StatsRecord* record = v->stats;
+
+    atomic_store_explicit(&record->expansions, 0, memory_order_relaxed);
+    atomic_store_explicit(&record->resizes, 0, memory_order_relaxed);
+    atomic_store_explicit(&record->bytes_reallocated, 0, memory_order_relaxed);
+    atomic_store_explicit(&record->bytes_moved, 0, memory_order_relaxed);
+    atomic_store_explicit(&record->peak_capacity,
+                          v->hot.capacity,
+                          memory_order_relaxed);
+    atomic_store_explicit(&record->predicate_calls, 0, memory_order_relaxed);
+    atomic_store_explicit(&record->searches, 0, memory_order_relaxed);
+    atomic_store_explicit(&record->elements_searched, 0, memory_order_relaxed);
+    atomic_store_explicit(&record->indexed_searches, 0, memory_order_relaxed);
 }
 
-int Vec_apply(Vec* v,
-              int (*fun)(void* element,
-                         size_t const element_size,
-                         void* state),
-              void* caller_state)
+void Vec_set_stats_name(Vec* v, char const* name)
 {
     assert(v != NULL);
-    assert(v->data != NULL);
-    assert(fun != NULL);
     if (v == NULL ||
-        v->data == NULL ||
-        fun == NULL ||
-        v->count == 0)
+        v->stats == NULL)
     {
-        return 1;
+        return;
     }
 
-    size_t i = 0;
+    // (Dumps read the name under the registry's lock.)
+    stats_lock();
+    v->stats->name = name;
+    stats_unlock();
+}
 
-    while (i < v->count_bytes)
+size_t Vec_visit_stats(void (*visit)(Vec const* v,
+                                     VecStats const* stats,
+                                     void* context),
+                       void* context)
+{
+    assert(visit != NULL);
+    if (visit == NULL)
     {
-        int return_value = fun(v->data + i, v->element_size, caller_state);
+        return 0;
+    }
 
-        if (return_value != 0)
-        {
-            // Terminate early, relaying the function's error return value.
-            return return_value;
-        }
+    size_t visited = 0;
+
+    stats_lock();
+    for (StatsRecord const* r = stats_registry; r != NULL; r = r->next)
+    {
+        VecStats stats;
+
+        read_stats(r->v, r, &stats);
+        visit(r->v, &stats, context);
+        visited += 1;
+    }
+    stats_unlock();
+
+    return visited;
+}
 
-        i += v->element_size;
+/**
+ * @brief Writes the given vector's counters to the given file as one line
+ */
+static void dump_stats(Vec const* v, VecStats const* stats, void* context)
+{
+    FILE* out = (FILE*) context;
+
+    (void) v;
+    fprintf(out,
+            "name=%s element_size=%zu expansions=%zu resizes=%zu "
+            "bytes_reallocated=%zu bytes_moved=%zu peak_capacity=%zu "
+            "predicate_calls=%zu searches=%zu elements_searched=%zu "
+            "indexed_searches=%zu\n",
+            (stats->name != NULL) ? stats->name : "-",
+            stats->element_size,
+            stats->expansions,
+            stats->resizes,
+            stats->bytes_reallocated,
+            stats->bytes_moved,
+            stats->peak_capacity,
+            stats->predicate_calls,
+            stats->searches,
+            stats->elements_searched,
+            stats->indexed_searches);
+}
+
+void Vec_dump_stats(FILE* out)
+{
+    assert(out != NULL);
+    if (out == NULL)
+    {
+        return;
     }
 
-    return 0;
+    Vec_visit_stats(dump_stats, out);
 }
+#endif
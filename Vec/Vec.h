@@ -34,13 +34,22 @@
  *     - Insertion or removal of elements at the end is amortized constant,
  *       O(1)+, since there may be occasional, and linear (which is greater than
  *       constant and hence amortizing), resizing when necessary.
- *     - Insertion or removal of elements NOT at the end is linear in the
+ *     - Insertion or removal of elements at the front, via `Vec_push_front()`
+ *       and `Vec_pop_front()`, is amortized constant, O(1)+, too, so vectors
+ *       work as queues and deques.
+ *     - Insertion or removal of elements anywhere else is linear in the
  *       distance to the end of the vector, O(n).
+ *
+ * The vector functions keep no hidden state between calls. Different threads
+ * can freely work on different vectors at the same time, and any number of
+ * threads can search or read the same vector at the same time (as long as no
+ * thread is modifying that vector meanwhile).
  */
 #ifndef VEC_H
 #define VEC_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 /**
@@ -50,6 +59,199 @@
  */
 typedef struct Vec Vec;
 
+/**
+ * @struct
+ * The vector members that are read on every element access
+ *
+ * WARNING: This isn't part of the API! It's exposed only so that inline
+ * functions in headers (like `Vec_get_unchecked()`, or the typed vectors of
+ * `VecTyped.h`) can access elements without a function call. Every vector
+ * starts with these members, so a vector pointer converts to a pointer to them,
+ * but callers must never write to them (that breaks the vector's integrity) and
+ * shouldn't read them either (use the vector functions instead).
+ */
+typedef struct VecHot
+{
+    uint8_t* data; // Vector data (`uint8_t` for bytewise pointer arithmetic)
+    size_t element_size; // Size of the vector's element type in bytes
+    size_t capacity; // Number of elements the vector can store before resizing
+    size_t count; // Current number of elements stored in the vector
+    size_t count_bytes; // Current element count in bytes
+    bool slow_append; // Whether appends must update an index, hash, or bound
+} VecHot;
+
+/**
+ * @enum
+ * How a vector's capacity grows when it runs out of room for new elements
+ */
+typedef enum VecGrowth
+{
+    /**
+     * The capacity doubles (the default)
+     */
+    VEC_GROWTH_DOUBLE = 0,
+
+    /**
+     * The capacity grows by half (i.e., it's multiplied by 1.5)
+     */
+    VEC_GROWTH_ONE_AND_A_HALF,
+
+    /**
+     * The capacity grows by a fixed number of elements, the growth chunk
+     */
+    VEC_GROWTH_CHUNK
+} VecGrowth;
+
+/**
+ * @struct
+ * A memory allocator that a vector gets all of its memory from
+ *
+ * Each function gets the allocator's context pointer as its first argument, so
+ * one set of functions can serve many allocator instances (e.g., one arena per
+ * request). Blocks are always given back with the same size they were last
+ * allocated or reallocated with, so allocators don't need to keep track of
+ * block sizes themselves.
+ *
+ * Blocks must be suitably aligned for any type (like `malloc()`'s are), since
+ * a vector's element type could be anything.
+ *
+ * `VecArena.h` and `VecPool.h` provide ready-made allocators.
+ */
+typedef struct VecAllocator
+{
+    /**
+     * Allocates a block of the given (non-zero) size, returning a null pointer
+     * on failure
+     */
+    void* (*allocate)(void* context, size_t size);
+
+    /**
+     * Resizes the given block from its old size to the new (non-zero) size,
+     * keeping its contents up to the smaller of the two sizes, and returning
+     * a null pointer (leaving the old block intact) on failure
+     */
+    void* (*reallocate)(void* context,
+                        void* block,
+                        size_t old_size,
+                        size_t new_size);
+
+    /**
+     * Gives back the given block of the given size
+     */
+    void (*deallocate)(void* context, void* block, size_t size);
+
+    /**
+     * Passed as the first argument to each of the functions above
+     */
+    void* context;
+} VecAllocator;
+
+/**
+ * @struct
+ * Options for configuring a vector when creating it via `Vec_new_with()`
+ *
+ * Every option's zero value is its default, so options can be initialized with
+ * `{0}` and only the options of interest set. For example, a vector that grows
+ * by 1.5 times its capacity, but never by more than a million elements at a
+ * time, could be created like this:
+ *
+ * ```
+ * VecOptions const options =
+ * {
+ *     .growth = VEC_GROWTH_ONE_AND_A_HALF,
+ *     .growth_max_step = 1000000
+ * };
+ * Vec* v = Vec_new_with(16, sizeof(int64_t), &options);
+ * ```
+ */
+typedef struct VecOptions
+{
+    /**
+     * How the vector's capacity grows when it runs out of room
+     */
+    VecGrowth growth;
+
+    /**
+     * How many elements the capacity grows by with `VEC_GROWTH_CHUNK` (which
+     * must be non-zero with that growth policy, and is ignored otherwise)
+     */
+    size_t growth_chunk;
+
+    /**
+     * The most elements the capacity may grow by in one expansion, whatever
+     * the growth policy (0 for no limit)
+     *
+     * This is useful for huge vectors, where doubling would briefly require
+     * three times the memory the vector's using (the old data block, plus the
+     * new one that's twice as big).
+     */
+    size_t growth_max_step;
+
+    /**
+     * The most elements the vector may hold (0 for no limit), which makes it
+     * a bounded queue that overwrites its oldest elements
+     *
+     * Appending to a full bounded vector (with `Vec_append()` or, equally, the
+     * back of a queue) drops its first element to make room, and pushing onto
+     * its front (with `Vec_push_front()`) drops its last. Functions that add
+     * elements anywhere else, or several at once (like `Vec_insert()` or
+     * `Vec_append_n()`), fail instead of going past the limit.
+     *
+     * The first time a full bounded vector runs out of room at the end of its
+     * block, the block is grown to room for twice the limit (unless it has
+     * that already, or is the caller's inline storage). From then on, it never
+     * grows: the room freed at one end of the block by dropped elements is
+     * reused, by moving the elements back into it when the other end is
+     * reached (see `Vec_pop_front()`). With room for twice the limit, that
+     * happens once per limit's worth of drops, so each overwrite takes
+     * amortized constant time.
+     */
+    size_t max_count;
+
+    /**
+     * The allocator that the vector gets its memory from, including the memory
+     * for the vector struct itself (or a null pointer for the default
+     * `malloc()`, `realloc()`, and `free()`)
+     *
+     * The allocator struct is copied into the vector, so it doesn't have to
+     * outlive the call to `Vec_new_with()`, but its context does have to
+     * outlive the vector.
+     */
+    VecAllocator const* allocator;
+} VecOptions;
+
+/**
+ * @def
+ * The number of bytes that a vector struct takes up at the start of inline
+ * storage (see `Vec_new_inline()`)
+ *
+ * This is a fixed upper bound on the size of the (encapsulated) vector struct,
+ * and a multiple of the strictest alignment, so elements following it are
+ * aligned.
+ */
+#define VEC_HEADER_SIZE ((size_t) 96)
+
+/**
+ * @def
+ * The byte size of inline storage for a vector with room for the given number
+ * of elements of the given byte size
+ */
+#define VEC_INLINE_STORAGE_SIZE(capacity, element_size) \
+    (VEC_HEADER_SIZE + (size_t) (capacity) * (size_t) (element_size))
+
+/**
+ * @def
+ * Declares a suitably aligned `unsigned char` array of the given name, usable
+ * as inline storage for a vector with room for the given number of elements of
+ * the given byte size (see `Vec_new_inline()`)
+ *
+ * This works anywhere an array can be declared, e.g., as a local variable or
+ * as a member of the caller's own struct.
+ */
+#define VEC_INLINE_STORAGE(name, capacity, element_size) \
+    _Alignas(max_align_t) \
+    unsigned char name[VEC_INLINE_STORAGE_SIZE(capacity, element_size)]
+
 /**
  * @brief Allocates a new vector prepared to hold the given number of elements,
  * each of which is the given size in bytes
@@ -79,10 +281,146 @@ typedef struct Vec Vec;
 Vec* Vec_new(size_t const least_capacity,
              size_t const element_size);
 
+/**
+ * @brief Allocates a new vector, like `Vec_new()`, but configured with the
+ * given options
+ *
+ * `Vec_new(least_capacity, element_size)` is the same as
+ * `Vec_new_with(least_capacity, element_size, NULL)`.
+ *
+ * WARNING: This returns a dynamically allocated vector whose memory should
+ * eventually be freed with `Vec_destroy()`. Otherwise, the vector's memory will
+ * leak.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The capacity or element size are 0
+ *     - The capacity and/or element size are so astronomically huge that the
+ *       total number of bytes to be allocated can't be numerically represented
+ *       in the vector without overflow
+ *     - The options are invalid (e.g., an unknown growth policy, a growth
+ *       chunk of 0 with `VEC_GROWTH_CHUNK`, or an allocator missing any of
+ *       its functions)
+ *     - Allocating memory for the vector failed, internally
+ *
+ * @param least_capacity The vector should be able to hold at least this many
+ * elements
+ * @param element_size The byte size of each element in the vector
+ * @param options The options to configure the vector with (or a null pointer
+ * for the default options)
+ * @return A pointer to the newly-allocated vector
+ */
+Vec* Vec_new_with(size_t const least_capacity,
+                  size_t const element_size,
+                  VecOptions const* options);
+
+/**
+ * @brief Creates a new vector inside the given caller-owned storage, which
+ * holds both the vector struct and as many elements as fit after it
+ *
+ * This lets small vectors live without any dynamic allocation at all, e.g., on
+ * the stack or inside the caller's own struct. Only if the vector grows past
+ * the elements that its storage fits does it move its elements to memory from
+ * its allocator (while the vector struct stays in the storage).
+ *
+ * The struct in the storage only holds what most operations use. The rest
+ * (the options, allocator, index, and hash) goes in one small block from the
+ * allocator, which a vector with the default options only allocates once it
+ * enables an index or hash. So a vector created with any other options makes
+ * that one allocation, up front.
+ *
+ * The storage is best declared with `VEC_INLINE_STORAGE()`, which gets its size
+ * and alignment right:
+ *
+ * ```
+ * VEC_INLINE_STORAGE(storage, 16, sizeof(int64_t));
+ * Vec* v = Vec_new_inline(storage, sizeof(storage), sizeof(int64_t), NULL);
+ *
+ * // ...use the vector (which only allocates past 16 elements)...
+ *
+ * Vec_destroy(&v); // Frees any elements that moved out of the storage
+ * ```
+ *
+ * WARNING: The storage must outlive the vector, and mustn't be moved or copied
+ * while the vector's in use (since the vector points into it)! The vector
+ * should still eventually be destroyed with `Vec_destroy()`, which leaves
+ * the storage itself alone but frees the elements if they moved out of it.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The storage pointer is null, or the storage isn't aligned for any type
+ *     - The storage is too small for the vector struct and one element, i.e.,
+ *       smaller than `VEC_INLINE_STORAGE_SIZE(1, element_size)`
+ *     - The element size is 0
+ *     - The options are invalid (see `Vec_new_with()`)
+ *     - The options aren't the defaults, and allocating memory for them
+ *       failed, internally
+ *
+ * @param storage The storage to create the vector in
+ * @param storage_size The byte size of the storage
+ * @param element_size The byte size of each element in the vector
+ * @param options The options to configure the vector with (or a null pointer
+ * for the default options)
+ * @return A pointer to the vector (which points into the storage)
+ */
+Vec* Vec_new_inline(void* storage,
+                    size_t const storage_size,
+                    size_t const element_size,
+                    VecOptions const* options);
+
+/**
+ * @brief Creates a new vector around the given existing block of elements,
+ * taking ownership of it (rather than copying the elements into a new block)
+ *
+ * The block must have come from the given allocator (or, if no allocator is
+ * given, from `malloc()`), since that's where the vector resizes and frees it:
+ * resizing goes through the allocator's `reallocate()`, and `Vec_destroy()`
+ * gives the block back via the allocator's `deallocate()` (with the byte size
+ * of the vector's capacity at the time).
+ *
+ * ```
+ * int64_t* block = malloc(16 * sizeof(int64_t));
+ *
+ * // ...fill in the block's first 10 elements...
+ *
+ * Vec* v = Vec_adopt(block, 10, 16, sizeof(int64_t), NULL);
+ * ```
+ *
+ * WARNING: After this succeeds, the block belongs to the vector! The caller
+ * mustn't free or resize it, and should only access it through the vector
+ * (since the vector may move it when resizing).
+ *
+ * This fails, and returns a null pointer without taking ownership of the block
+ * (or, if assertions are enabled, causes an assert crash), if any of the
+ * following are true:
+ *     - The block pointer is null
+ *     - The capacity or element size is 0
+ *     - The count is bigger than the capacity
+ *     - The capacity and element size are so huge that the block's byte size
+ *       can't be represented without overflow
+ *     - The allocator is missing any of its functions
+ *     - Allocating memory for the vector struct failed, internally
+ *
+ * @param block The block of elements to adopt
+ * @param count How many elements the block starts out with
+ * @param capacity How many elements the block has room for
+ * @param element_size The byte size of each element
+ * @param allocator The allocator the block came from (or a null pointer for
+ * `malloc()`)
+ * @return A pointer to the newly-allocated vector
+ */
+Vec* Vec_adopt(void* block,
+               size_t const count,
+               size_t const capacity,
+               size_t const element_size,
+               VecAllocator const* allocator);
+
 /**
  * @brief Destroys the given vector, taking it as a double pointer so that it
  * can null out the caller's single pointer to the vector (for convenience)
  *
+ * The vector's memory is given back to the allocator it was created with.
+ *
  * The double pointer or inner vector pointer can be null, in which case this
  * does nothing.
  *
@@ -90,6 +428,76 @@ Vec* Vec_new(size_t const least_capacity,
  */
 void Vec_destroy(Vec** v);
 
+/**
+ * @brief Destroys the given vector, but hands its block of elements over to
+ * the caller instead of freeing it (the reverse of `Vec_adopt()`), taking the
+ * vector as a double pointer so that it can null out the caller's single
+ * pointer to the vector (like `Vec_destroy()`)
+ *
+ * The elements stay where they are, and the block keeps the vector's capacity
+ * (which can be gotten with `Vec_capacity()` beforehand). So, the caller can
+ * pass the elements on, e.g., to another subsystem, or to `Vec_adopt()`,
+ * without copying them.
+ *
+ * ```
+ * size_t count = 0;
+ * int64_t* elements = Vec_release(&v, &count);
+ *
+ * // ...use the elements...
+ *
+ * free(elements);
+ * ```
+ *
+ * WARNING: The block belongs to the caller afterwards, who must eventually
+ * give it back to the allocator the vector was created with (or, if it was
+ * created without one, `free()` it), with the byte size of the vector's
+ * capacity! Vectors whose allocator does its own bookkeeping for the block,
+ * like those from `Vec_open_mmap()` or `Vec_from_buffer()`, must not be
+ * released, since the bookkeeping is freed with the vector.
+ *
+ * NOTE: If the elements are in the caller's inline storage (see
+ * `Vec_new_inline()`), which isn't the vector's to hand over, they're copied
+ * out to a block from the vector's allocator, and that block is returned.
+ *
+ * This fails, and returns a null pointer leaving the vector alone (or, if
+ * assertions are enabled, causes an assert crash), if any of the following are
+ * true:
+ *     - The double pointer or inner vector pointer is null
+ *     - Allocating the block to copy inline elements out to failed, internally
+ *
+ * @param v A double pointer to a vector
+ * @param count An optional pointer to a count that's set to the number of
+ * elements in the block (or a null pointer if the count isn't needed)
+ * @return The vector's block of elements
+ */
+void* Vec_release(Vec** v, size_t* count);
+
+/**
+ * @brief Creates a new vector that's a copy of the given vector: the same
+ * elements, capacity, options, allocator, zeroing, and index (if enabled)
+ *
+ * The copy's elements are copied with one `memcpy()`, into a block of the
+ * same capacity, so the copy can grow as far as the original could before
+ * resizing.
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `Vec_destroy()`. The copy gets its memory from the same
+ * allocator, so the allocator must outlive it, too. (A copy of a vector from
+ * `Vec_open_mmap()` or `Vec_from_buffer()` gets its memory from `malloc()`, or
+ * the buffer's allocator, and can outlive the original.)
+ *
+ * NOTE: If the index's slots can't be allocated, the copy's index is left
+ * without any, like when rebuilding it fails (see `Vec_enable_index()`).
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the vector pointer is null, or if allocating memory for
+ * the copy failed, internally.
+ *
+ * @param v The vector to copy
+ * @return A pointer to the newly-allocated copy
+ */
+Vec* Vec_clone(Vec const* v);
+
 /**
  * @brief Gets the number of elements that the given vector has allocated memory
  * for so far
@@ -102,6 +510,57 @@ void Vec_destroy(Vec** v);
  */
 size_t Vec_capacity(Vec const* v);
 
+/**
+ * @brief Makes sure the given vector can hold at least the given number of
+ * elements without needing to expand
+ *
+ * If the vector's capacity is smaller than that, the vector is resized to
+ * exactly that capacity. Otherwise, this does nothing.
+ *
+ * WARNING: This may invalidate stored pointers! If the vector is resized, its
+ * data block may reside in a totally different region of memory than the one
+ * still being pointed to by outside pointers!
+ *
+ * This fails, leaving the vector unmodified and returning false (or, if
+ * assertions are enabled, causing an assert crash), if any of the following are
+ * true:
+ *     - The capacity is so astronomically huge that the total number of bytes
+ *       to be allocated can't be numerically represented without overflow
+ *     - Expanding the vector failed, internally
+ *     - The vector pointer is null
+ *
+ * @param v The vector
+ * @param least_capacity The vector should be able to hold at least this many
+ * elements
+ * @return Whether the vector can now hold that many elements
+ */
+bool Vec_reserve(Vec* v,
+                 size_t const least_capacity);
+
+/**
+ * @brief Gives back the given vector's unused capacity, shrinking the vector's
+ * capacity to its number of elements
+ *
+ * An empty vector keeps room for one element. A full bounded vector (see
+ * `VecOptions`) keeps room for up to twice its limit, which it needs to
+ * overwrite in constant time. A vector whose elements are still in the
+ * caller's inline storage (see `Vec_new_inline()`) is left as it is.
+ *
+ * WARNING: This may invalidate stored pointers! Once the vector is resized, its
+ * data block may reside in a totally different region of memory than the one
+ * still being pointed to by outside pointers!
+ *
+ * This fails, leaving the vector unmodified and returning false (or, if
+ * assertions are enabled, causing an assert crash), if any of the following are
+ * true:
+ *     - Shrinking the vector failed, internally
+ *     - The vector pointer is null
+ *
+ * @param v The vector
+ * @return Whether the vector's capacity now fits its elements
+ */
+bool Vec_shrink_to_fit(Vec* v);
+
 /**
  * @brief Gets the number of elements currently stored in the given vector
  *
@@ -124,6 +583,204 @@ size_t Vec_count(Vec const* v);
  */
 size_t Vec_element_size(Vec const* v);
 
+/**
+ * @brief Gets the allocator that the given vector gets its memory from (the
+ * default one, wrapping `malloc()`, if it was created without one)
+ *
+ * This lets code that made the allocator (like `VecMmap.h` and `VecIO.h`) find
+ * its context again from the vector. The allocator isn't meant to be called
+ * with the vector's own blocks, which are the vector's to resize and free.
+ *
+ * If the vector pointer is null, this just returns an allocator whose members
+ * are all null (or, if assertions are enabled, causes an assert crash).
+ *
+ * @param v The vector
+ * @return A copy of the vector's allocator
+ */
+VecAllocator Vec_allocator(Vec const* v);
+
+/**
+ * @brief Gets the default allocator, wrapping `malloc()`, `realloc()`, and
+ * `free()`, which vectors created without an allocator use
+ *
+ * This lets code with allocators of its own (like `VecSeg.h` and `VecIO.h`)
+ * fall back on the same default as the vectors.
+ *
+ * @return A copy of the default allocator
+ */
+VecAllocator Vec_default_allocator(void);
+
+/**
+ * @brief Sets whether the given vector zeroes out the bytes of elements removed
+ * from it
+ *
+ * By default, vectors zero out the memory of removed elements. This way, the
+ * data of removed elements is really "gone", even from the vector's unused
+ * capacity, where it could otherwise still be recovered by, say, applying an
+ * offset to a pointer received from `Vec_get()`.
+ *
+ * When a vector's elements aren't sensitive, zeroing can be turned off to spare
+ * every removal the extra write.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector pointer is null.
+ *
+ * @param v The vector
+ * @param zeroing Whether the vector should zero out removed elements' bytes
+ * @return Whether the setting was applied
+ */
+bool Vec_set_zeroing(Vec* v,
+                     bool const zeroing);
+
+/**
+ * @brief Gives the given vector a hash index of its elements' keys, which
+ * makes searching it for an item (`Vec_where()` and `Vec_has()`) or for a key
+ * (`Vec_where_key()` and `Vec_has_key()`) take constant time on average,
+ * instead of scanning every element
+ *
+ * The key is the given byte range of each element: e.g., the whole element
+ * (`0` and `sizeof(T)`) to search for items, or `offsetof(Record, id)` and
+ * `sizeof(uint64_t)` to also search records by their `id`. Keys are hashed
+ * bytewise, so (unlike the elements themselves) they shouldn't have padding
+ * bytes in them.
+ *
+ * The index is an open-addressing hash table that maps each key to the
+ * positions of the elements with that key. It's kept up to date as elements
+ * are added and removed: adding or removing at either end (appending, or
+ * pushing or popping) costs constant time (on average), while inserting or
+ * removing anywhere else shifts the positions of the elements on whichever
+ * side of the site has fewer. Functions that re-order or rewrite many elements
+ * at once (sorting, `Vec_remove_all()`, and `Vec_apply()`, for instance)
+ * rebuild it from scratch, though `Vec_apply_const()` doesn't.
+ *
+ * NOTE: The index takes up another 32 to 64 bytes of memory per element (from
+ * the vector's allocator).
+ *
+ * WARNING: The index only knows about changes that the vector functions make!
+ * After modifying elements' keys directly (through pointers from `Vec_get()`
+ * or `Vec_data()`), call `Vec_reindex()`.
+ *
+ * If the index later runs out of room and can't be grown, it's put aside (so
+ * the searches go back to scanning) until `Vec_reindex()` can rebuild it.
+ * Enabling an index on a vector that already has one replaces it.
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The key size is 0
+ *     - The key doesn't fit inside the element at the given offset
+ *     - Allocating memory for the index failed, internally
+ *     - The vector pointer is null
+ *
+ * @param v The vector to index
+ * @param key_offset The byte offset of the key in each element
+ * @param key_size The byte size of the key
+ * @return Whether the vector was indexed
+ */
+bool Vec_enable_index(Vec* v,
+                      size_t const key_offset,
+                      size_t const key_size);
+
+/**
+ * @brief Removes the given vector's hash index, if it has one, freeing its
+ * memory
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector pointer is null.
+ *
+ * @param v The vector
+ * @return Whether the vector no longer has an index
+ */
+bool Vec_disable_index(Vec* v);
+
+/**
+ * @brief Determines whether the given vector has a hash index (see
+ * `Vec_enable_index()`)
+ *
+ * If the vector pointer is null, this just returns false (or, if assertions
+ * are enabled, causes an assert crash).
+ *
+ * @param v The vector
+ * @return Whether the vector has an index
+ */
+bool Vec_indexed(Vec const* v);
+
+/**
+ * @brief Rebuilds the given vector's hash index (if it has one) from its
+ * elements, e.g., after elements were modified through pointers to them
+ *
+ * A vector without an index is left as it is.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - Allocating memory for the index failed, internally (in which case the
+ *       searches scan the elements until the index can be rebuilt)
+ *     - The vector pointer is null
+ *
+ * @param v The vector
+ * @return Whether the index (if any) is up to date
+ */
+bool Vec_reindex(Vec* v);
+
+/**
+ * @brief Has the given vector keep its hash (see `Vec_hash()`) up to date as
+ * its elements change, so getting it and telling the vector apart from others
+ * (with `Vec_equal()`) take constant time
+ *
+ * Adding or removing an element updates the hash by hashing just that element.
+ * Functions that rewrite or remove many elements at once (`Vec_apply()` and
+ * `Vec_remove_all()`, for instance) rehash all of them, like they rebuild the
+ * index. (Sorting doesn't, since the hash doesn't depend on the elements'
+ * order.)
+ *
+ * WARNING: The kept hash only knows about changes that the vector functions
+ * make! After modifying elements directly (through pointers from `Vec_get()`
+ * or `Vec_data()`), call `Vec_reindex()`, which rehashes them, too.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector pointer is null, or allocating memory to keep
+ * the hash in (which only an inline vector with the default options needs)
+ * failed, internally.
+ *
+ * @param v The vector
+ * @return Whether the vector keeps its hash
+ */
+bool Vec_enable_hash(Vec* v);
+
+/**
+ * @brief Has the given vector stop keeping its hash (see `Vec_enable_hash()`)
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector pointer is null.
+ *
+ * @param v The vector
+ * @return Whether the vector no longer keeps its hash
+ */
+bool Vec_disable_hash(Vec* v);
+
+/**
+ * @brief Hashes the given vector's elements (bytewise), e.g., to find
+ * duplicate vectors among many with a hash table
+ *
+ * Vectors with the same bytes (i.e., that `Vec_equal()` with no comparator
+ * considers equal) have the same hash. The hash is made from each element's own
+ * hash, added up, so it doesn't depend on the elements' order: the elements
+ * hash independently of each other (which is faster), but vectors that only
+ * differ in order have the same hash.
+ *
+ * This takes constant time if the vector keeps its hash (see
+ * `Vec_enable_hash()`), or else hashes every element.
+ *
+ * WARNING: Like `Vec_equal()` without a comparator, this is unsuitable when
+ * elements are structs with padding bytes or floating point values.
+ *
+ * If the vector pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The vector
+ * @return The hash
+ */
+uint64_t Vec_hash(Vec const* v);
+
 /**
  * @brief Determines whether two different vectors have equivalent elements
  *
@@ -145,6 +802,10 @@ size_t Vec_element_size(Vec const* v);
  * or floating point values, provide a comparator function (do not use a null
  * comparator pointer argument).
  *
+ * Without a comparator, two vectors that both keep their hashes (see
+ * `Vec_enable_hash()`) and whose hashes differ are told apart in constant time,
+ * without comparing any elements.
+ *
  * This fails, and returns false (or, if assertions are enabled, causes an
  * assert crash), if either of the vector pointers are null. (The optional
  * comparator pointer may be null, however.)
@@ -163,7 +824,9 @@ bool Vec_equal(Vec const* v_a,
  * @brief Determines where the first (lowest indexed) element that matches the
  * given item is located in the given vector
  *
- * An element matches if its bytes are the same as the given item's.
+ * An element matches if its bytes are the same as the given item's. If the
+ * vector has a hash index (see `Vec_enable_index()`), only the elements with
+ * the same key as the item are compared.
  *
  * WARNING: Bytewise element comparison makes this function unsuitable when
  * elements are structs (which may have bytewise differences even with
@@ -214,6 +877,11 @@ size_t Vec_where(Vec const* v,
  * }
  * ```
  *
+ * NOTE: Elements of 64 bytes or more are prefetched from memory a few elements
+ * ahead of the one the predicate is called on, so scans over big elements
+ * don't wait on each one (see `VecAligned.h` for allocators that also cut down
+ * on TLB misses in huge vectors).
+ *
  * On failure, the following values are returned instead, each indicating one or
  * more corresponding reasons for failure (or, if assertions are enabled, an
  * assert crash happens for each failure case):
@@ -232,11 +900,88 @@ size_t Vec_where(Vec const* v,
 size_t Vec_where_if(Vec const* v,
                     bool (*predicate)(void const*, size_t const));
 
+/**
+ * @brief Determines where the first (lowest indexed) element that satisfies the
+ * given context-taking predicate is located in the given vector
+ *
+ * This is like `Vec_where_if()`, except that the predicate is also passed the
+ * given context pointer on every call. This way, the "thing to look for" can be
+ * handed to the predicate by the caller instead of being baked into it (or
+ * smuggled in through a global variable, which would break as soon as two
+ * threads search at the same time).
+ *
+ * For example, if the vector is known to hold `int`s, a predicate used to find
+ * the first element less than some caller-chosen limit could be:
+ *
+ * ```
+ * bool less_than(void const* element, size_t const element_size, void* context)
+ * {
+ *     if (NULL == element ||
+ *         NULL == context ||
+ *         sizeof(int) != element_size) // Explicit size check
+ *     {
+ *         return false; // Error; return early.
+ *     }
+ *
+ *     int const* i = (int const*) element; // Cast to the known type.
+ *     int const* limit = (int const*) context;
+ *
+ *     return *i < *limit;
+ * }
+ * ```
+ *
+ * On failure, the following values are returned instead, each indicating one or
+ * more corresponding reasons for failure (or, if assertions are enabled, an
+ * assert crash happens for each failure case):
+ *     - The number of elements in the vector is returned if:
+ *         - The predicate pointer is null
+ *     - 0 is returned if:
+ *         - The vector pointer is null
+ *
+ * @param v The vector to search
+ * @param predicate A function that takes an element pointer, an element size,
+ * and the given context pointer and returns true if the element behind the
+ * pointer looks like the one we're searching for
+ * @param context An optional pointer to call the predicate with
+ * @return The index of the first element that satisfies the predicate (or, if
+ * no satisfactory element was found, the number of elements) in the vector
+ */
+size_t Vec_where_if_ctx(Vec const* v,
+                        bool (*predicate)(void const*, size_t const, void*),
+                        void* context);
+
+/**
+ * @brief Determines where the first element that's selected by the given mask
+ * is in the given vector
+ *
+ * A mask is a packed array of bits, one per element: element `i` is selected
+ * if bit `i % 64` of word `i / 64` is set (as with the words of a `VecBits`;
+ * see `VecBits.h`). A mask computed once for a whole vector (say, by a
+ * vectorized comparison) stands in for a predicate, without a call per
+ * element.
+ *
+ * This fails, and returns the number of elements (or, if assertions are
+ * enabled, causes an assert crash), if the mask pointer is null, or the mask's
+ * bit count isn't the vector's element count. (If the vector pointer is null,
+ * this returns 0, instead.)
+ *
+ * @param v The vector to search
+ * @param mask The mask's words
+ * @param mask_count The number of bits in the mask
+ * @return The index of the first selected element (or, if none is selected,
+ * the number of elements) in the vector
+ */
+size_t Vec_where_masked(Vec const* v,
+                        uint64_t const* mask,
+                        size_t const mask_count);
+
 /**
  * @brief Determines if the given vector contains an element that matches the
  * given item
  *
- * An element matches if its bytes are the same as the given item's.
+ * An element matches if its bytes are the same as the given item's. If the
+ * vector has a hash index (see `Vec_enable_index()`), only the elements with
+ * the same key as the item are compared.
  *
  * WARNING: Bytewise element comparison makes this function unsuitable when
  * elements are structs (which may have bytewise differences even with
@@ -296,6 +1041,77 @@ bool Vec_has(Vec const* v,
 bool Vec_has_if(Vec const* v,
                 bool (*predicate)(void const*, size_t const));
 
+/**
+ * @brief Determines if the given vector contains an element that satisfies the
+ * given context-taking predicate
+ *
+ * This is like `Vec_has_if()`, except that the predicate is also passed the
+ * given context pointer on every call (see `Vec_where_if_ctx()`).
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector or predicate pointers are null. (The optional
+ * context pointer may be null, however.)
+ *
+ * @param v The vector to search
+ * @param predicate A function that takes an element pointer, an element size,
+ * and the given context pointer and returns true if the element behind the
+ * pointer looks like the one we're searching for
+ * @param context An optional pointer to call the predicate with
+ * @return Whether the vector has an element that satisfies the predicate
+ */
+bool Vec_has_if_ctx(Vec const* v,
+                    bool (*predicate)(void const*, size_t const, void*),
+                    void* context);
+
+/**
+ * @brief Determines where the first (lowest indexed) element with the given
+ * key is located in the given indexed vector
+ *
+ * An element has the key if the bytes of its key (the byte range given to
+ * `Vec_enable_index()`) are the same as the given key's. With the vector's
+ * index, this takes constant time on average.
+ *
+ * On failure, the following values are returned instead, each indicating one or
+ * more corresponding reasons for failure (or, if assertions are enabled, an
+ * assert crash happens for each failure case):
+ *     - The number of elements in the vector is returned if:
+ *         - The vector doesn't have an index
+ *         - The key's size does not match the index's key size
+ *         - The key pointer is null
+ *     - 0 is returned if:
+ *         - The vector pointer is null
+ *
+ * @param v The vector to search
+ * @param key A key to search for
+ * @param key_size The key's size in bytes (as a size-based "type check" to make
+ * sure the key looks like it's the same type as the elements' keys)
+ * @return The index of the first element with the key (or, if no element has
+ * the key, the number of elements) in the vector
+ */
+size_t Vec_where_key(Vec const* v,
+                     void const* key,
+                     size_t const key_size);
+
+/**
+ * @brief Determines if the given indexed vector contains an element with the
+ * given key (see `Vec_where_key()`)
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The vector doesn't have an index
+ *     - The key's size does not match the index's key size
+ *     - The vector or key pointers are null
+ *
+ * @param v The vector to search
+ * @param key A key to search for
+ * @param key_size The key's size in bytes (as a size-based "type check" to make
+ * sure the key looks like it's the same type as the elements' keys)
+ * @return Whether the vector has an element with the key
+ */
+bool Vec_has_key(Vec const* v,
+                 void const* key,
+                 size_t const key_size);
+
 /**
  * @brief Accesses vector elements
  *
@@ -312,11 +1128,94 @@ bool Vec_has_if(Vec const* v,
 void* Vec_get(Vec const* v,
               size_t const i);
 
+/**
+ * @brief Accesses vector elements, like `Vec_get()`, but without any checks
+ *
+ * This is inlined into the caller, so tight loops over a vector's elements
+ * don't pay for a function call (or for checks that the loop's own bounds
+ * already make unnecessary) per element.
+ *
+ * WARNING: Nothing is checked! The vector pointer must not be null, and the
+ * index must be less than the vector's number of elements (`Vec_count()`).
+ * Otherwise, the behavior is undefined.
+ *
+ * @param v The vector to access
+ * @param i An index (which must be in bounds)
+ * @return A pointer to the element at the given index in the given vector
+ */
+static inline void* Vec_get_unchecked(Vec const* v,
+                                      size_t const i)
+{
+    VecHot const* hot = (VecHot const*) (void const*) v;
+
+    return hot->data + i * hot->element_size;
+}
+
+/**
+ * @brief Gets a pointer to the given vector's first element, where the rest of
+ * its elements follow contiguously
+ *
+ * The pointer can be cast to a pointer to the vector's element type and used
+ * like an array of `Vec_count()` elements.
+ *
+ * WARNING: The pointer is invalidated by any function that adds elements to,
+ * removes elements from, or resizes the vector!
+ *
+ * NOTE: An empty vector still returns a (non-null) pointer, but there's no
+ * element behind it.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the vector pointer is null.
+ *
+ * @param v The vector
+ * @return A pointer to the vector's first element
+ */
+void* Vec_data(Vec const* v);
+
+/**
+ * @brief Gets the range of the given vector's elements, as pointers to its
+ * first element and to just past its last element
+ *
+ * This allows looping over plain pointers, which compilers can optimize far
+ * better than a loop that calls `Vec_get()` per element. For example, with
+ * `int64_t` elements:
+ *
+ * ```
+ * void* begin = NULL;
+ * void* end = NULL;
+ *
+ * Vec_span(v, &begin, &end);
+ * for (int64_t* p = begin; p != end; ++p)
+ * {
+ *     *p *= 2;
+ * }
+ * ```
+ *
+ * For an empty vector, the two pointers are equal.
+ *
+ * WARNING: The pointers are invalidated by any function that adds elements to,
+ * removes elements from, or resizes the vector!
+ *
+ * This fails, and returns false after setting any non-null range pointers to
+ * null (or, if assertions are enabled, causes an assert crash), if the vector
+ * pointer or either range pointer is null.
+ *
+ * @param v The vector
+ * @param begin Where to store the pointer to the vector's first element
+ * @param end Where to store the pointer to just past the vector's last element
+ * @return Whether the range was stored
+ */
+bool Vec_span(Vec const* v,
+              void** begin,
+              void** end);
+
 /**
  * @brief Appends the given item to the given vector
  *
  * When the vector is full, this function attempts to automatically resize it to
- * a larger capacity before appending the given item.
+ * a larger capacity before appending the given item. (If the vector is bounded,
+ * though, and holds as many elements as it may, its first element is dropped to
+ * make room instead, as with `Vec_pop_front()`; see `VecOptions`.)
  *
  * WARNING: This may invalidate stored pointers! If the vector undergoes
  * automatic expansion to fit the new element, the vector's data block is
@@ -341,6 +1240,76 @@ bool Vec_append(Vec* v,
                 void const* item,
                 size_t const item_size);
 
+/**
+ * @brief Appends the given array of items to the given vector, all at once
+ *
+ * This is equivalent to appending the items one by one, in order, but the
+ * vector's room is checked (and, if need be, expanded) just once, and the items
+ * are copied in as a single block. If the vector needs to be resized, it's
+ * resized straight to a capacity that fits all the items (or, when that's
+ * larger, to the capacity it would have expanded to anyway).
+ *
+ * Appending 0 items succeeds without doing anything.
+ *
+ * WARNING: This may invalidate stored pointers! If the vector undergoes
+ * automatic expansion to fit the new elements, the vector's data block is
+ * resized, so the data block may reside in a totally different region of memory
+ * than the one still being pointed to by outside pointers (including the items
+ * pointer, if it points into the vector)!
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The given item size does not match the vector's expected element size
+ *     - The number of elements in the vector becomes so huge that it can no
+ *       longer be represented by the vector's internal data without overflow
+ *     - Expanding the vector (if it needed to be resized) failed
+ *     - The vector is bounded (see `VecOptions`), and this would put it over
+ *       its limit
+ *     - The given vector or items pointers are null
+ *
+ * @param v The vector to append to
+ * @param items An array of items to add
+ * @param n How many items are in the array
+ * @param item_size The size of each item in bytes (as a size-based "type check"
+ * to make sure the items look like they're the same type as the vector's
+ * elements)
+ * @return Whether the items were added to the vector
+ */
+bool Vec_append_n(Vec* v,
+                  void const* items,
+                  size_t const n,
+                  size_t const item_size);
+
+/**
+ * @brief Appends all the elements of one vector to another, all at once
+ *
+ * The source vector is left unmodified. A vector can be extended with itself,
+ * doubling up its elements.
+ *
+ * Extending with an empty vector succeeds without doing anything.
+ *
+ * WARNING: This may invalidate stored pointers! If the destination vector
+ * undergoes automatic expansion to fit the new elements, its data block is
+ * resized, so the data block may reside in a totally different region of memory
+ * than the one still being pointed to by outside pointers!
+ *
+ * This fails, and doesn't modify the destination vector (or, if assertions are
+ * enabled, causes an assert crash), if any of the following are true:
+ *     - The vectors' element sizes differ
+ *     - The number of elements in the destination vector becomes so huge that
+ *       it can no longer be represented without overflow
+ *     - Expanding the destination vector (if it needed to be resized) failed
+ *     - The destination vector is bounded (see `VecOptions`), and this would
+ *       put it over its limit
+ *     - Either vector pointer is null
+ *
+ * @param dst The vector to append to
+ * @param src The vector whose elements to append
+ * @return Whether the source vector's elements were added to the destination
+ */
+bool Vec_extend(Vec* dst,
+                Vec const* src);
+
 /**
  * @brief Inserts the given item at the given index in the given vector,
  * shifting the element at that index (and all elements after it) to the right
@@ -401,19 +1370,74 @@ bool Vec_append(Vec* v,
  *     - The number of elements in the vector becomes so huge that it can no
  *       longer be represented by the vector's internal data without overflow
  *     - Expanding the vector (if it needed to be resized) failed
- *     - The given vector or item pointers are null
+ *     - The vector is bounded (see `VecOptions`), and this would put it over
+ *       its limit
+ *     - The given vector or item pointers are null
+ *
+ * @param v The vector to insert to
+ * @param i The index to insert at
+ * @param item The item to insert
+ * @param item_size The item's size in bytes (as a size-based "type check" to
+ * make sure the item looks like it's the same type as the vector's elements)
+ * @return Whether the item was inserted in the vector
+ */
+bool Vec_insert(Vec* v,
+                size_t const i,
+                void const* item,
+                size_t const item_size);
+
+/**
+ * @brief Inserts the given items into the given vector, each at the index
+ * given for it, all at once
+ *
+ * The indices are indices into the vector as it is BEFORE any of the items are
+ * inserted: the item for index `i` goes right before the element currently at
+ * `i` (or at the end, for an index equal to the number of elements). So, e.g.,
+ * inserting `x` and `y` at the indices 1 and 3 of `[a][b][c][d]` results in
+ * `[a][x][b][c][y][d]`. Items given the same index go in the order they're
+ * given in.
+ *
+ * This is equivalent to inserting the items one by one (adjusting each index
+ * for the items inserted before it), but the vector's room is made (with at
+ * most one resize) just once, and every element is moved at most once, as part
+ * of a single block move per run of elements between insertion sites. So, k
+ * insertions into n elements take O(n + k) time, instead of O(k * n).
+ *
+ * Inserting 0 items succeeds without doing anything.
+ *
+ * WARNING: The indices must be sorted in ascending order, and the items must
+ * not be inside the vector itself!
+ *
+ * WARNING: This may invalidate stored pointers or indices! See
+ * `Vec_append_n()` and `Vec_insert()`.
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - An index is out of the bound `[0, n]` where `n` is the number of
+ *       elements in the vector
+ *     - The indices aren't sorted in ascending order
+ *     - The given item size does not match the vector's expected element size
+ *     - The number of elements in the vector becomes so huge that it can no
+ *       longer be represented by the vector's internal data without overflow
+ *     - Expanding the vector (if it needed to be resized) failed
+ *     - The vector is bounded (see `VecOptions`), and this would put it over
+ *       its limit
+ *     - The given vector, indices, or items pointers are null
  *
  * @param v The vector to insert to
- * @param i The index to insert at
- * @param item The item to insert
- * @param item_size The item's size in bytes (as a size-based "type check" to
- * make sure the item looks like it's the same type as the vector's elements)
- * @return Whether the item was inserted in the vector
+ * @param indices A sorted array of the indices to insert the items at
+ * @param items An array of items to insert (one per index)
+ * @param k How many indices and items there are
+ * @param item_size The size of each item in bytes (as a size-based "type check"
+ * to make sure the items look like they're the same type as the vector's
+ * elements)
+ * @return Whether the items were inserted in the vector
  */
-bool Vec_insert(Vec* v,
-                size_t const i,
-                void const* item,
-                size_t const item_size);
+bool Vec_insert_many(Vec* v,
+                     size_t const* indices,
+                     void const* items,
+                     size_t const k,
+                     size_t const item_size);
 
 /**
  * @brief Removes the element at the given index from the given vector
@@ -424,6 +1448,9 @@ bool Vec_insert(Vec* v,
  * a result, pre-existing pointers or indices may no longer correspond to the
  * elements they did before the removal (or to any element at all)!
  *
+ * NOTE: Unless zeroing was turned off with `Vec_set_zeroing()`, the bytes the
+ * removed element leaves behind in the vector's unused capacity are zeroed out.
+ *
  * This fails, leaving the vector unmodified and returning 0 (or, if assertions
  * are enabled, causing an assert crash), if any of the following are true:
  *     - The vector is empty
@@ -439,6 +1466,143 @@ bool Vec_insert(Vec* v,
 size_t Vec_remove(Vec* v,
                   size_t const i);
 
+/**
+ * @brief Adds the given item to the front of the given vector (at index 0),
+ * in amortized constant time
+ *
+ * Unlike `Vec_insert()` at index 0, this doesn't shift the vector's elements
+ * over every time. Room freed at the front by `Vec_pop_front()` is reused
+ * directly. When there's none, the elements are moved up once, leaving as much
+ * room at the front as there are elements (growing the vector, if need be), so
+ * that many more pushes fit before the next move.
+ *
+ * If the vector is bounded (see `VecOptions`) and full, its last element is
+ * dropped to make room.
+ *
+ * WARNING: This may invalidate stored pointers or indices! Every element's
+ * index goes up by one, and whenever the elements are moved up (or the vector
+ * is resized), so are their addresses.
+ *
+ * NOTE: If the vector is indexed (see `Vec_enable_index()`), every position in
+ * the index goes up by one, too, so each push is linear in the index's size.
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The given item size does not match the vector's expected element size
+ *     - The number of elements in the vector becomes so huge that it can no
+ *       longer be represented by the vector's internal data without overflow
+ *     - A temporary copy of a large item can't be allocated, or expanding the
+ *       vector (if it needed to be resized) failed
+ *     - The given vector or item pointers are null
+ *
+ * @param v The vector to add to
+ * @param item The item to add
+ * @param item_size The item's size in bytes (as a size-based "type check" to
+ * make sure the item looks like it's the same type as the vector's elements)
+ * @return Whether the item was added to the vector
+ */
+bool Vec_push_front(Vec* v,
+                    void const* item,
+                    size_t const item_size);
+
+/**
+ * @brief Removes the first element of the given vector (at index 0), in
+ * constant time, copying it out first
+ *
+ * Unlike `Vec_remove()` at index 0, this doesn't shift the vector's elements
+ * down. The vector's data just starts one element later in its block, leaving
+ * room at the front for `Vec_push_front()`. With `Vec_append()`, this makes
+ * the vector a FIFO queue: once at least as much room is free at the front as
+ * there are elements (and the vector would otherwise have to grow), the
+ * elements are moved back to the front of the block in one go, which keeps
+ * appends amortized constant, too. (Emptying the vector gives all the room
+ * back right away, with nothing to move.)
+ *
+ * NOTE: The room freed at the front doesn't count towards `Vec_capacity()`,
+ * which is the number of elements that fit from the first element on, until
+ * the elements are moved back.
+ *
+ * NOTE: Unless zeroing was turned off with `Vec_set_zeroing()`, the bytes the
+ * removed element leaves behind are zeroed out. If the vector is indexed, every
+ * position in the index goes down by one, so each pop is linear in the index's
+ * size.
+ *
+ * WARNING: This may invalidate stored indices! Every element's index goes down
+ * by one. (Pointers to the other elements stay valid.)
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The vector is empty
+ *     - The given item pointer isn't null, but the given item size does not
+ *       match the vector's expected element size
+ *     - The given vector pointer is null
+ *
+ * @param v The vector to remove from
+ * @param item Where to copy the removed element to (or a null pointer to just
+ * drop it)
+ * @param item_size The byte size of the item (ignored if the item pointer is
+ * null)
+ * @return Whether an element was removed
+ */
+bool Vec_pop_front(Vec* v,
+                   void* item,
+                   size_t const item_size);
+
+/**
+ * @brief Removes the last element of the given vector, copying it out first
+ *
+ * This is `Vec_remove()` of the last index, plus the copy.
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), under the same conditions as `Vec_pop_front()`.
+ *
+ * @param v The vector to remove from
+ * @param item Where to copy the removed element to (or a null pointer to just
+ * drop it)
+ * @param item_size The byte size of the item (ignored if the item pointer is
+ * null)
+ * @return Whether an element was removed
+ */
+bool Vec_pop_back(Vec* v,
+                  void* item,
+                  size_t const item_size);
+
+/**
+ * @brief Removes the elements at the given indices from the given vector, all
+ * at once
+ *
+ * This is equivalent to removing the elements one by one (from the highest
+ * index down, so the indices stay valid), but in a single pass over the
+ * vector, with one block move per run of kept elements (like
+ * `Vec_remove_all_if()`). So, k removals from n elements take O(n + k) time,
+ * instead of O(k * n).
+ *
+ * An index given more than once removes just the one element at that index.
+ * Removing 0 elements succeeds without doing anything.
+ *
+ * WARNING: The indices must be sorted in ascending order!
+ *
+ * WARNING: This may invalidate stored pointers or indices! See `Vec_remove()`.
+ *
+ * NOTE: Unless zeroing was turned off with `Vec_set_zeroing()`, the bytes the
+ * removed elements leave behind in the vector's unused capacity are zeroed out.
+ *
+ * This fails, leaving the vector unmodified and returning 0 (or, if assertions
+ * are enabled, causing an assert crash), if any of the following are true:
+ *     - An index is out of the bound `[0, n)` where `n` is the number of
+ *       elements in the vector
+ *     - The indices aren't sorted in ascending order
+ *     - The given vector or indices pointers are null
+ *
+ * @param v The vector to remove from
+ * @param sorted_indices A sorted array of the indices of the elements to remove
+ * @param k How many indices there are
+ * @return How many elements were removed
+ */
+size_t Vec_remove_indices(Vec* v,
+                          size_t const* sorted_indices,
+                          size_t const k);
+
 /**
  * @brief Removes all elements that match the given item from the given vector
  *
@@ -519,6 +1683,114 @@ size_t Vec_remove_all(Vec* v,
 size_t Vec_remove_all_if(Vec* v,
                          bool (*predicate)(void const*, size_t const));
 
+/**
+ * @brief Removes all elements that satisfy the given context-taking predicate
+ * from the given vector
+ *
+ * This is like `Vec_remove_all_if()`, except that the predicate is also passed
+ * the given context pointer on every call (see `Vec_where_if_ctx()`).
+ *
+ * WARNING: This may invalidate stored pointers or indices! After an element is
+ * removed, the vector's other elements are automatically shifted to fill the
+ * empty gap created by the removal so that the elements are kept contiguous. As
+ * a result, pre-existing pointers or indices may no longer correspond to the
+ * elements they did before the removal (or to any element at all)!
+ *
+ * This fails, leaving the vector unmodified and returning 0 (or, if assertions
+ * are enabled, causing an assert crash), if the given vector or predicate
+ * pointers are null. (The optional context pointer may be null, however.)
+ *
+ * @param v The vector to remove from
+ * @param predicate A function that takes an element pointer, an element size,
+ * and the given context pointer and returns true if the element behind the
+ * pointer looks like one of the ones to remove
+ * @param context An optional pointer to call the predicate with
+ * @return How many elements were removed
+ */
+size_t Vec_remove_all_if_ctx(Vec* v,
+                             bool (*predicate)(void const*,
+                                               size_t const,
+                                               void*),
+                             void* context);
+
+/**
+ * @brief Removes all elements that are selected by the given mask (see
+ * `Vec_where_masked()`) from the given vector
+ *
+ * This compacts the vector in one pass, like `Vec_remove_all_if()`, but finds
+ * the elements to remove by scanning the mask's set bits a word at a time, so
+ * runs of kept elements are skipped over without looking at each one.
+ *
+ * WARNING: This may invalidate stored pointers or indices, like
+ * `Vec_remove_all_if()`.
+ *
+ * This fails, leaving the vector unmodified and returning 0 (or, if assertions
+ * are enabled, causing an assert crash), if the vector or mask pointers are
+ * null, or the mask's bit count isn't the vector's element count.
+ *
+ * @param v The vector to remove from
+ * @param mask The mask's words
+ * @param mask_count The number of bits in the mask
+ * @return How many elements were removed
+ */
+size_t Vec_remove_all_masked(Vec* v,
+                             uint64_t const* mask,
+                             size_t const mask_count);
+
+/**
+ * @brief Removes every element of the given vector that's equivalent to the
+ * one right before it, so each run of equivalent elements is left with just
+ * its first
+ *
+ * After sorting the vector (with the same comparator), this leaves only one
+ * of each distinct element, like C++'s `std::unique()`. It's done in a single
+ * pass, by the same compaction as `Vec_remove_all_if()`.
+ *
+ * If the pointer to the comparator function is null, elements are equivalent
+ * if their bytes are identical (see the warning on `Vec_equal()` about structs
+ * and floating point values).
+ *
+ * WARNING: This may invalidate stored pointers or indices, like
+ * `Vec_remove_all_if()`.
+ *
+ * This fails, leaving the vector unmodified and returning 0 (or, if assertions
+ * are enabled, causing an assert crash), if the vector pointer is null. (The
+ * optional comparator pointer may be null, however.)
+ *
+ * @param v The vector to remove from
+ * @param cmp An optional comparator function that returns zero when it
+ * considers its two arguments to be equivalent
+ * @return How many elements were removed
+ */
+size_t Vec_unique(Vec* v,
+                  int (*cmp)(void const*, void const*));
+
+/**
+ * @brief Removes every element of the given vector whose bytes match an
+ * earlier element's, keeping the first of each in its original order
+ *
+ * Unlike `Vec_unique()`, this needs no sorting first. It's done in a single
+ * pass, looking each element up in a temporary open-addressing hash table of
+ * the elements kept so far (which takes 32 to 64 bytes per element, from the
+ * vector's allocator, until it returns).
+ *
+ * WARNING: Bytewise element comparison makes this function unsuitable when
+ * elements are structs (which may have bytewise differences even with
+ * equivalent members due random values in padding bytes) or floating point
+ * values (which can differ slightly due to rounding errors).
+ *
+ * WARNING: This may invalidate stored pointers or indices, like
+ * `Vec_remove_all_if()`.
+ *
+ * This fails, leaving the vector unmodified and returning 0 (or, if assertions
+ * are enabled, causing an assert crash), if the vector pointer is null, or
+ * allocating memory for the table failed, internally.
+ *
+ * @param v The vector to remove from
+ * @return How many elements were removed
+ */
+size_t Vec_dedup_hashed(Vec* v);
+
 /**
  * @brief Sorts the elements of the given vector according to the given
  * comparator function (using `stdlib.h`'s implementation of `qsort()`)
@@ -546,6 +1818,210 @@ size_t Vec_remove_all_if(Vec* v,
 bool Vec_qsort(Vec* v,
                int (*cmp)(void const*, void const*));
 
+/**
+ * @brief Sorts the elements of the given vector by an integer key inside each
+ * element, in ascending order of the key, using a (least significant digit)
+ * radix sort
+ *
+ * A radix sort never compares elements. Instead, it distributes them by one
+ * byte of their keys at a time, which takes linear time (one pass per key
+ * byte, skipping bytes that are the same in every key). This beats any
+ * comparison sort on big vectors with integer keys.
+ *
+ * The key is a 4- or 8-byte integer of the machine's native byte order, at the
+ * given byte offset in each element (e.g., `offsetof(Record, id)` for records
+ * keyed by `id`, or 0 for a vector of plain integers). Elements may be bigger
+ * than their keys; whole elements are moved along with their keys.
+ *
+ * The sort is stable, so elements with equal keys keep their relative order.
+ *
+ * WARNING: This may invalidate stored pointers or indices! After elements are
+ * re-ordered by the sort, pre-existing pointers or indices may no longer
+ * correspond to the elements they did before the sort!
+ *
+ * NOTE: This temporarily allocates a buffer as big as the vector's elements
+ * (from the vector's allocator).
+ *
+ * This fails, leaving the vector unmodified and returning false (or, if
+ * assertions are enabled, causing an assert crash), if any of the following
+ * are true:
+ *     - The key size isn't 4 or 8
+ *     - The key doesn't fit inside the element at the given offset
+ *     - Allocating the temporary buffer failed, internally
+ *     - The vector pointer is null
+ *
+ * @param v The vector to sort
+ * @param key_offset The byte offset of the key in each element
+ * @param key_size The byte size of the key (4 or 8)
+ * @param key_signed Whether the key is a signed (two's complement) integer, as
+ * opposed to an unsigned one
+ * @return Whether the vector was sorted
+ */
+bool Vec_radix_sort(Vec* v,
+                    size_t const key_offset,
+                    size_t const key_size,
+                    bool const key_signed);
+
+/**
+ * @brief Binary searches the given sorted vector for the first (lowest
+ * indexed) element that isn't "less" than the given item
+ *
+ * This is where the item would go to be inserted before any elements equal to
+ * it. The vector must be sorted (in ascending order) according to the given
+ * comparator, e.g., by `Vec_qsort()` with the same comparator. The comparator
+ * is called with an element as its first argument and the item as its second.
+ *
+ * Unlike `Vec_where()`, which checks every element, this takes logarithmic
+ * time.
+ *
+ * On failure, the following values are returned instead, each indicating one or
+ * more corresponding reasons for failure (or, if assertions are enabled, an
+ * assert crash happens for each failure case):
+ *     - The number of elements in the vector is returned if:
+ *         - The item's size does not match the vector's expected element size
+ *         - The item or comparator pointers are null
+ *     - 0 is returned if:
+ *         - The vector pointer is null
+ *
+ * @param v The vector to search, sorted according to the comparator
+ * @param item An item to search for
+ * @param item_size The item's size in bytes (as a size-based "type check" to
+ * make sure the item looks like it's the same type as the vector's elements)
+ * @param cmp The comparator function that the vector is sorted by
+ * @return The index of the first element that isn't less than the item (or, if
+ * every element is less than the item, the number of elements)
+ */
+size_t Vec_lower_bound(Vec const* v,
+                       void const* item,
+                       size_t const item_size,
+                       int (*cmp)(void const*, void const*));
+
+/**
+ * @brief Binary searches the given sorted vector for the first (lowest
+ * indexed) element that's "greater" than the given item
+ *
+ * This is where the item would go to be inserted after any elements equal to
+ * it, so the elements equal to the item are the ones from
+ * `Vec_lower_bound()` up to (but not including) this. Otherwise, this is like
+ * `Vec_lower_bound()`, and fails the same ways.
+ *
+ * @param v The vector to search, sorted according to the comparator
+ * @param item An item to search for
+ * @param item_size The item's size in bytes (as a size-based "type check" to
+ * make sure the item looks like it's the same type as the vector's elements)
+ * @param cmp The comparator function that the vector is sorted by
+ * @return The index of the first element that's greater than the item (or, if
+ * no element is greater than the item, the number of elements)
+ */
+size_t Vec_upper_bound(Vec const* v,
+                       void const* item,
+                       size_t const item_size,
+                       int (*cmp)(void const*, void const*));
+
+/**
+ * @brief Binary searches the given sorted vector for the first (lowest
+ * indexed) element that's "equal" to the given item
+ *
+ * This is `Vec_where()` for sorted vectors, in logarithmic time, with elements
+ * matching when the comparator returns 0 (so it's also suitable for structs
+ * and floating point values). See `Vec_lower_bound()` for how the vector must
+ * be sorted, and the ways this fails.
+ *
+ * @param v The vector to search, sorted according to the comparator
+ * @param item An item to search for
+ * @param item_size The item's size in bytes (as a size-based "type check" to
+ * make sure the item looks like it's the same type as the vector's elements)
+ * @param cmp The comparator function that the vector is sorted by
+ * @return The index of the first element equal to the item (or, if no equal
+ * element was found, the number of elements) in the vector
+ */
+size_t Vec_bsearch(Vec const* v,
+                   void const* item,
+                   size_t const item_size,
+                   int (*cmp)(void const*, void const*));
+
+/**
+ * @brief Inserts the given item into the given sorted vector where it belongs,
+ * keeping the vector sorted
+ *
+ * The insertion index is binary searched for (via `Vec_upper_bound()`), so the
+ * item goes after any elements equal to it, and equal elements stay in the
+ * order they were inserted. The elements after the insertion site are then
+ * shifted over as a single block, like with `Vec_insert()`.
+ *
+ * NOTE: Inserting many items one at a time shifts the elements once per item.
+ * To insert a batch of items, sort them and use `Vec_merge_sorted()`, which
+ * moves each element at most once.
+ *
+ * WARNING: This may invalidate stored pointers or indices! See
+ * `Vec_insert()`.
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The given item size does not match the vector's expected element size
+ *     - The number of elements in the vector becomes so huge that it can no
+ *       longer be represented by the vector's internal data without overflow
+ *     - Expanding the vector (if it needed to be resized) failed
+ *     - The vector is bounded (see `VecOptions`), and this would put it over
+ *       its limit
+ *     - The given vector, item, or comparator pointers are null
+ *
+ * @param v The vector to insert into, sorted according to the comparator
+ * @param item The item to insert
+ * @param item_size The item's size in bytes (as a size-based "type check" to
+ * make sure the item looks like it's the same type as the vector's elements)
+ * @param cmp The comparator function that the vector is sorted by
+ * @return Whether the item was inserted
+ */
+bool Vec_insert_sorted(Vec* v,
+                       void const* item,
+                       size_t const item_size,
+                       int (*cmp)(void const*, void const*));
+
+/**
+ * @brief Merges the given sorted array of items into the given sorted vector,
+ * keeping the vector sorted
+ *
+ * This is equivalent to inserting the items one by one via
+ * `Vec_insert_sorted()`, but in a single linear pass: the vector's room is
+ * made just once, and the elements and items are merged from the back into it,
+ * so each element moves at most once (and elements before the first item's
+ * insertion site don't move at all). Items go after any elements equal to
+ * them.
+ *
+ * Merging 0 items succeeds without doing anything.
+ *
+ * WARNING: The items must be sorted according to the same comparator as the
+ * vector (e.g., by `qsort()`), and must not be inside the vector itself!
+ *
+ * WARNING: This may invalidate stored pointers or indices! See
+ * `Vec_append_n()` and `Vec_insert()`.
+ *
+ * This fails, and doesn't modify the vector (or, if assertions are enabled,
+ * causes an assert crash), if any of the following are true:
+ *     - The given item size does not match the vector's expected element size
+ *     - The number of elements in the vector becomes so huge that it can no
+ *       longer be represented by the vector's internal data without overflow
+ *     - Expanding the vector (if it needed to be resized) failed
+ *     - The vector is bounded (see `VecOptions`), and this would put it over
+ *       its limit
+ *     - The given vector, items, or comparator pointers are null
+ *
+ * @param v The vector to merge into, sorted according to the comparator
+ * @param items A sorted array of items to merge in
+ * @param n How many items are in the array
+ * @param item_size The size of each item in bytes (as a size-based "type check"
+ * to make sure the items look like they're the same type as the vector's
+ * elements)
+ * @param cmp The comparator function that the vector and items are sorted by
+ * @return Whether the items were merged into the vector
+ */
+bool Vec_merge_sorted(Vec* v,
+                      void const* items,
+                      size_t const n,
+                      size_t const item_size,
+                      int (*cmp)(void const*, void const*));
+
 /**
  * @brief Applies the given function to the elements of the given vector
  *
@@ -601,6 +2077,14 @@ bool Vec_qsort(Vec* v,
  * }
  * ```
  *
+ * NOTE: Like with `Vec_where_if()`, elements of 64 bytes or more are prefetched
+ * a few elements ahead of the one the function is called on.
+ *
+ * NOTE: Since the function may change elements, the vector's index and kept
+ * hash (if it has them) are rebuilt afterwards, which allocates the index anew
+ * and goes over every element again. A function that only reads elements
+ * should be applied with `Vec_apply_const()` instead.
+ *
  * This fails, leaving the vector unmodified and returning 1 (or, if assertions
  * are enabled, causing an assert crash), if the vector or function pointers are
  * null. (The optional caller state pointer may be null, however.)
@@ -624,4 +2108,169 @@ int Vec_apply(Vec* v,
               int (*fun)(void* element, size_t const element_size, void* state),
               void* caller_state);
 
+/**
+ * @brief Applies the given function, which only reads elements, to the
+ * elements of the given vector
+ *
+ * This is like `Vec_apply()`, except that the function gets `const` element
+ * pointers, and the vector is left unmodified, so there's no index or kept hash
+ * to rebuild afterwards. Since nothing's written, several threads can apply
+ * functions to one vector at once (e.g., to a pinned version of a shared
+ * vector; see `VecShared.h`).
+ *
+ * This fails, returning 1 (or, if assertions are enabled, causing an assert
+ * crash), if the vector or function pointers are null. (The optional caller
+ * state pointer may be null, however.)
+ *
+ * @param v The vector to apply over
+ * @param fun A function like `Vec_apply()`'s, but taking a `const` element
+ * pointer
+ * @param caller_state An optional pointer to call the function with
+ * @return 1 if an assert-worthy precondition failed or if the vector is empty;
+ * the first non-0 returned by a call of the given function; or 0 if no calls
+ * returned non-0
+ */
+int Vec_apply_const(Vec const* v,
+                    int (*fun)(void const* element,
+                               size_t const element_size,
+                               void* state),
+                    void* caller_state);
+
+/**
+ * @brief Applies the given function to each element in the given vector that's
+ * selected by the given mask (see `Vec_where_masked()`), in order
+ *
+ * This is like `Vec_apply()`, except that the elements that aren't selected
+ * are skipped over without a call.
+ *
+ * This fails, leaving the vector unmodified and returning 1 (or, if assertions
+ * are enabled, causing an assert crash), if the vector, mask, or function
+ * pointers are null, or the mask's bit count isn't the vector's element count.
+ * (The optional caller state pointer may be null, however.)
+ *
+ * @param v The vector to apply over
+ * @param mask The mask's words
+ * @param mask_count The number of bits in the mask
+ * @param fun A function like `Vec_apply()`'s
+ * @param caller_state An optional pointer to call the function with
+ * @return 1 if an assert-worthy precondition failed or if the vector is empty;
+ * the first non-0 returned by a call of the given function; or 0 if no calls
+ * returned non-0 (including if no element was selected)
+ */
+int Vec_apply_masked(Vec* v,
+                     uint64_t const* mask,
+                     size_t const mask_count,
+                     int (*fun)(void* element,
+                                size_t const element_size,
+                                void* state),
+                     void* caller_state);
+
+#if defined(VEC_STATS)
+#include <stdio.h>
+
+/**
+ * @struct
+ * What a vector has been doing, for finding the vectors that grow too often,
+ * shift too much, or search too slowly
+ *
+ * The counters are only kept when the vector code (and the caller's) is
+ * compiled with `VEC_STATS` defined, and only for the vectors using the
+ * default allocator (since the others' memory may be freed without their being
+ * destroyed, like by `VecArena_reset()`). Searches on the same vector from
+ * several threads at once still count correctly. (Otherwise, the vector
+ * functions keep no hidden state, and without `VEC_STATS`, none of this exists
+ * at all.)
+ *
+ * Knowing these, a vector that expands a lot could be created with a bigger
+ * capacity (say, its peak capacity), and one that searches a lot could get an
+ * index (see `Vec_enable_index()`) or be kept sorted.
+ */
+typedef struct VecStats
+{
+    char const* name; // The vector's name (see `Vec_set_stats_name()`)
+    size_t element_size; // The byte size of each element
+    size_t expansions; // Times it ran out of room when adding elements
+    size_t resizes; // Times its data block was reallocated (for any reason)
+    size_t bytes_reallocated; // The byte sizes of those blocks, added up
+    size_t bytes_moved; // Bytes shifted by insertions and removals
+    size_t peak_capacity; // The most elements it has had room for
+    size_t predicate_calls; // Calls of the predicates given to it
+    size_t searches; // Searches that went over the elements
+    size_t elements_searched; // The elements those searches looked at
+    size_t indexed_searches; // Searches that went through its hash index
+} VecStats;
+
+/**
+ * @brief Gets the given vector's counters
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector or stats pointers are null. (If keeping the
+ * vector's counters failed, internally, they're all 0.)
+ *
+ * @param v The vector
+ * @param stats Where to put the counters
+ * @return Whether the counters were gotten
+ */
+bool Vec_stats(Vec const* v, VecStats* stats);
+
+/**
+ * @brief Sets all of the given vector's counters back to 0 (except for its
+ * peak capacity, which becomes its current capacity)
+ *
+ * If the vector pointer is null, this does nothing (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The vector
+ */
+void Vec_reset_stats(Vec* v);
+
+/**
+ * @brief Names the given vector, so it can be told apart from the others in
+ * `Vec_dump_stats()`
+ *
+ * The name isn't copied, so it must outlive the vector (like a string literal
+ * does).
+ *
+ * If the vector pointer is null, this does nothing (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The vector
+ * @param name The name (or a null pointer, for none)
+ */
+void Vec_set_stats_name(Vec* v, char const* name);
+
+/**
+ * @brief Calls the given function with the counters of every vector that's
+ * been created and not yet destroyed, in no particular order
+ *
+ * The vectors are kept in a registry for this from when they're created until
+ * they're destroyed (or released). The registry is locked while the function
+ * is called, so the function mustn't create or destroy vectors, and the other
+ * threads that do wait for it.
+ *
+ * If the function pointer is null, this does nothing and returns 0 (or, if
+ * assertions are enabled, causes an assert crash).
+ *
+ * @param visit A function that takes a vector, its counters, and the given
+ * context pointer
+ * @param context An optional pointer to call the function with
+ * @return How many vectors there were
+ */
+size_t Vec_visit_stats(void (*visit)(Vec const* v,
+                                     VecStats const* stats,
+                                     void* context),
+                       void* context);
+
+/**
+ * @brief Writes every live vector's counters (see `Vec_visit_stats()`) to the
+ * given file, one line of `name=value` pairs per vector
+ *
+ * If the file pointer is null, this does nothing (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param out The file to write to (like `stderr`)
+ */
+void Vec_dump_stats(FILE* out);
+#endif
+
 #endif
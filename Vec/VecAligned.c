@@ -0,0 +1,338 @@
+// For `mremap()` on Linux (and the POSIX functions under strict C11)
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "VecAligned.h"
+
+/**
+ * @struct
+ * How one of the allocators places its blocks (its context)
+ */
+typedef struct
+{
+    VecAlignedMode mode; // Where big blocks' pages come from
+    size_t threshold; // The byte size from which blocks are mapped
+} Placement;
+
+static Placement placements[] =
+{
+    { VEC_ALIGNED_DEFAULT, VEC_ALIGNED_MAP_THRESHOLD },
+    {
+        VEC_ALIGNED_HUGE_PAGES,
+        (VEC_ALIGNED_MAP_THRESHOLD > VEC_ALIGNED_HUGE_PAGE)
+        ? VEC_ALIGNED_MAP_THRESHOLD
+        : VEC_ALIGNED_HUGE_PAGE
+    },
+    { VEC_ALIGNED_NUMA_LOCAL, VEC_ALIGNED_MAP_THRESHOLD }
+};
+
+/**
+ * @brief Rounds the given size up to a multiple of the given power of 2 (or
+ * gives 0, if that overflows)
+ */
+static size_t round_up(size_t const size, size_t const multiple)
+{
+    if (size > SIZE_MAX - (multiple - 1))
+    {
+        return 0;
+    }
+
+    return (size + multiple - 1) & ~(multiple - 1);
+}
+
+/**
+ * @brief Gets the byte size of the pages that the given placement maps a block
+ * in multiples of
+ */
+static size_t page_size(Placement const* placement)
+{
+    if (placement->mode == VEC_ALIGNED_HUGE_PAGES)
+    {
+        return VEC_ALIGNED_HUGE_PAGE;
+    }
+
+    long const size = sysconf(_SC_PAGESIZE);
+
+    return (size > 0) ? (size_t) size : 4096;
+}
+
+/**
+ * @brief Gets the byte size of the mapping the given placement makes for a
+ * block of the given size (or 0, if that overflows)
+ */
+static size_t mapping_size(Placement const* placement, size_t const size)
+{
+    return round_up(size, page_size(placement));
+}
+
+/**
+ * @brief Writes to every page of the given range of a mapping, so the calling
+ * thread faults them in (and, with NUMA, on its own node)
+ */
+static void touch_pages(uint8_t* begin, uint8_t* end)
+{
+    long const size = sysconf(_SC_PAGESIZE);
+    size_t const step = (size > 0) ? (size_t) size : 4096;
+    size_t const bytes = (size_t) (end - begin);
+
+    for (size_t i = 0; i < bytes; i += step)
+    {
+        // (Fresh anonymous pages are zeroed, so this changes nothing.)
+        ((uint8_t volatile*) begin)[i] = 0;
+    }
+}
+
+/**
+ * @brief Does what the given placement does to the given (new) range of a
+ * mapping: asks for huge pages, or faults the pages in
+ */
+static void place(Placement const* placement, uint8_t* begin, uint8_t* end)
+{
+    if (placement->mode == VEC_ALIGNED_HUGE_PAGES)
+    {
+#if defined(MADV_HUGEPAGE)
+        // (Just a hint; without huge pages, the block still works.)
+        (void) madvise(begin, (size_t) (end - begin), MADV_HUGEPAGE);
+#endif
+    }
+    else if (placement->mode == VEC_ALIGNED_NUMA_LOCAL)
+    {
+        touch_pages(begin, end);
+    }
+}
+
+/**
+ * @brief Maps a block of the given (mapping) size, aligned to the placement's
+ * page size
+ *
+ * Huge pages have to be aligned to their size, which `mmap()` doesn't promise,
+ * so a bigger mapping is made and the parts sticking out either side are
+ * unmapped.
+ *
+ * @return The block, or a null pointer on failure
+ */
+static uint8_t* map_block(Placement const* placement, size_t const size)
+{
+    size_t const alignment = page_size(placement);
+    size_t const padded = (placement->mode == VEC_ALIGNED_HUGE_PAGES)
+                          ? size + alignment
+                          : size;
+
+    if (padded < size)
+    {
+        return NULL;
+    }
+
+    void* mapped = mmap(NULL,
+                        padded,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+
+    if (mapped == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    uint8_t* start = (uint8_t*) mapped;
+    uint8_t* block = start;
+
+    if (padded != size)
+    {
+        size_t const skew = (uintptr_t) start % alignment;
+
+        block = start + ((skew != 0) ? alignment - skew : 0);
+        if (block != start)
+        {
+            munmap(start, (size_t) (block - start));
+        }
+        if (start + padded != block + size)
+        {
+            munmap(block + size, (size_t) ((start + padded) - (block + size)));
+        }
+    }
+    place(placement, block, block + size);
+
+    return block;
+}
+
+/**
+ * @brief Allocates the given number of bytes, aligned to a cache line
+ * @param context The `Placement`
+ * @param size The byte size of the allocation
+ * @return The allocation, or a null pointer on failure
+ */
+static void* aligned_allocate(void* context, size_t size)
+{
+    Placement const* placement = (Placement const*) context;
+
+    if (size >= placement->threshold)
+    {
+        size_t const mapped = mapping_size(placement, size);
+
+        return (mapped != 0) ? map_block(placement, mapped) : NULL;
+    }
+
+    // (`aligned_alloc()` needs the size to be a multiple of the alignment.)
+    size_t const rounded = round_up(size, VEC_ALIGNED_LINE);
+
+    return (rounded != 0) ? aligned_alloc(VEC_ALIGNED_LINE, rounded) : NULL;
+}
+
+/**
+ * @brief Gives back the given allocation
+ * @param context The `Placement`
+ * @param block The allocation to give back
+ * @param size The allocation's byte size
+ */
+static void aligned_deallocate(void* context, void* block, size_t size)
+{
+    Placement const* placement = (Placement const*) context;
+
+    if (block == NULL)
+    {
+        return;
+    }
+
+    if (size >= placement->threshold)
+    {
+        munmap(block, mapping_size(placement, size));
+    }
+    else
+    {
+        free(block);
+    }
+}
+
+/**
+ * @brief Resizes the given mapped block in its pages (without copying them),
+ * if the OS can
+ * @return The resized block, or a null pointer if it couldn't be (in which
+ * case the old block is left alone)
+ */
+static uint8_t* remap_block(Placement const* placement,
+                            uint8_t* block,
+                            size_t const old_mapped,
+                            size_t const new_mapped)
+{
+#if defined(__linux__)
+    // Huge pages stay put, so their alignment does too.
+    int const flags = (placement->mode == VEC_ALIGNED_HUGE_PAGES)
+                      ? 0
+                      : MREMAP_MAYMOVE;
+    void* remapped = mremap(block, old_mapped, new_mapped, flags);
+
+    if (remapped == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    uint8_t* resized = (uint8_t*) remapped;
+
+    if (new_mapped > old_mapped)
+    {
+        place(placement, resized + old_mapped, resized + new_mapped);
+    }
+
+    return resized;
+#else
+    (void) placement;
+    (void) block;
+    (void) old_mapped;
+    (void) new_mapped;
+
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Resizes the given allocation, keeping it aligned
+ * @param context The `Placement`
+ * @param block The allocation to resize
+ * @param old_size The allocation's current byte size
+ * @param new_size The byte size to resize the allocation to
+ * @return The resized allocation, or a null pointer on failure
+ */
+static void* aligned_reallocate(void* context,
+                                void* block,
+                                size_t old_size,
+                                size_t new_size)
+{
+    Placement const* placement = (Placement const*) context;
+
+    if (block == NULL)
+    {
+        return aligned_allocate(context, new_size);
+    }
+
+    bool const old_mapped = (old_size >= placement->threshold);
+    bool const new_mapped = (new_size >= placement->threshold);
+
+    if (old_mapped &&
+        new_mapped)
+    {
+        size_t const old_mapping = mapping_size(placement, old_size);
+        size_t const new_mapping = mapping_size(placement, new_size);
+
+        if (new_mapping == 0)
+        {
+            return NULL;
+        }
+        if (new_mapping == old_mapping)
+        {
+            return block;
+        }
+
+        uint8_t* resized = remap_block(placement,
+                                       (uint8_t*) block,
+                                       old_mapping,
+                                       new_mapping);
+
+        if (resized != NULL)
+        {
+            return resized;
+        }
+    }
+
+    /*
+     * Otherwise, move to a new block. (Since `realloc()` doesn't keep the
+     * alignment, that goes for the small blocks, too.)
+     */
+    void* moved = aligned_allocate(context, new_size);
+
+    if (moved == NULL)
+    {
+        return NULL;
+    }
+    memcpy(moved, block, (old_size < new_size) ? old_size : new_size);
+    aligned_deallocate(context, block, old_size);
+
+    return moved;
+}
+
+VecAllocator VecAligned_allocator(VecAlignedMode const mode)
+{
+    bool const valid_mode = (mode == VEC_ALIGNED_DEFAULT ||
+                             mode == VEC_ALIGNED_HUGE_PAGES ||
+                             mode == VEC_ALIGNED_NUMA_LOCAL);
+
+    assert(valid_mode);
+
+    VecAllocator const allocator =
+    {
+        .allocate = aligned_allocate,
+        .reallocate = aligned_reallocate,
+        .deallocate = aligned_deallocate,
+        .context = &placements[valid_mode ? mode : VEC_ALIGNED_DEFAULT]
+    };
+
+    return allocator;
+}
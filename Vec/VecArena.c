@@ -0,0 +1,389 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "VecArena.h"
+
+/**
+ * @def
+ * The byte size of an arena's blocks when none is given to `VecArena_new()`
+ */
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t) 64 * 1024)
+
+/**
+ * @def
+ * The alignment of every allocation from an arena, which is suitable for any
+ * type (like `malloc()`'s)
+ */
+#define ARENA_ALIGNMENT (_Alignof(max_align_t))
+
+typedef struct ArenaBlock ArenaBlock;
+struct ArenaBlock
+{
+    ArenaBlock* next; // The block allocated before this one
+    size_t size; // Number of bytes in the block's data
+    size_t used; // Number of bytes of data allocated so far
+    size_t last_offset; // Where in the data the latest allocation starts
+    max_align_t data[]; // The block's data (`max_align_t` for its alignment)
+};
+
+struct VecArena
+{
+    ArenaBlock* blocks; // The block being bumped through, and all before it
+    size_t block_size; // Byte size of the data of each (regular) block
+    size_t used; // Number of bytes allocated from all blocks
+};
+
+/**
+ * @brief Rounds the given size up to a multiple of the arena alignment
+ * @param size The size to round up
+ * @param rounded Where to write the rounded size
+ * @return Whether the rounded size could be represented without overflow
+ */
+static bool round_to_alignment(size_t const size, size_t* rounded)
+{
+    if (size > SIZE_MAX - (ARENA_ALIGNMENT - 1))
+    {
+        return false;
+    }
+
+    *rounded = (size + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1);
+
+    return true;
+}
+
+/**
+ * @brief Allocates a new, empty block with room for the given number of bytes
+ * @param size The byte size of the block's data
+ * @return The block, or a null pointer on failure
+ */
+static ArenaBlock* new_block(size_t const size)
+{
+    if (size > SIZE_MAX - sizeof(ArenaBlock))
+    {
+        return NULL;
+    }
+
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    block->last_offset = 0;
+
+    return block;
+}
+
+/**
+ * @brief Gets a pointer to the given offset in the given block's data
+ * @param block The block
+ * @param offset The byte offset into the block's data
+ * @return The pointer
+ */
+static uint8_t* block_at(ArenaBlock* block, size_t const offset)
+{
+    return (uint8_t*) block->data + offset;
+}
+
+/**
+ * @brief Determines whether the given pointer is the latest allocation that
+ * was bumped off of the arena's current block
+ * @param arena The arena
+ * @param p The pointer
+ * @return Whether the pointer's the current block's latest allocation
+ */
+static bool is_latest(VecArena* arena, void const* p)
+{
+    ArenaBlock* current = arena->blocks;
+
+    return current != NULL &&
+           current->used > current->last_offset &&
+           p == block_at(current, current->last_offset);
+}
+
+VecArena* VecArena_new(size_t const block_size)
+{
+    size_t rounded_block_size = ARENA_DEFAULT_BLOCK_SIZE;
+    bool const block_size_overflowed =
+        block_size > 0 && !round_to_alignment(block_size, &rounded_block_size);
+
+    assert(!block_size_overflowed);
+    if (block_size_overflowed)
+    {
+        return NULL;
+    }
+
+    VecArena* arena = malloc(sizeof(VecArena));
+    bool const arena_allocation_succeeded = (arena != NULL);
+
+    assert(arena_allocation_succeeded);
+    if (!arena_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    arena->used = 0;
+    arena->block_size = rounded_block_size;
+    arena->blocks = new_block(arena->block_size);
+
+    bool const block_allocation_succeeded = (arena->blocks != NULL);
+
+    assert(block_allocation_succeeded);
+    if (!block_allocation_succeeded)
+    {
+        free(arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+void VecArena_destroy(VecArena** arena)
+{
+    if (arena == NULL ||
+        (*arena) == NULL)
+    {
+        return;
+    }
+
+    ArenaBlock* block = (*arena)->blocks;
+
+    while (block != NULL)
+    {
+        ArenaBlock* next = block->next;
+
+        free(block);
+        block = next;
+    }
+
+    free(*arena);
+    *arena = NULL;
+}
+
+void VecArena_reset(VecArena* arena)
+{
+    assert(arena != NULL);
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    // Keep the first regular-sized block, and free the rest.
+    ArenaBlock* kept = NULL;
+    ArenaBlock* block = arena->blocks;
+
+    while (block != NULL)
+    {
+        ArenaBlock* next = block->next;
+
+        if (kept == NULL &&
+            block->size == arena->block_size)
+        {
+            kept = block;
+        }
+        else
+        {
+            free(block);
+        }
+        block = next;
+    }
+
+    if (kept != NULL)
+    {
+        kept->next = NULL;
+        kept->used = 0;
+        kept->last_offset = 0;
+    }
+
+    arena->blocks = kept;
+    arena->used = 0;
+}
+
+size_t VecArena_used(VecArena const* arena)
+{
+    assert(arena != NULL);
+    if (arena == NULL)
+    {
+        return 0;
+    }
+
+    return arena->used;
+}
+
+/**
+ * @brief Allocates the given number of bytes from the arena given as context
+ *
+ * An allocation bigger than the arena's block size gets a dedicated block,
+ * which is slotted in behind the current block so that the rest of the
+ * current block can still be bumped through.
+ *
+ * @param context The arena
+ * @param size The byte size of the allocation
+ * @return The allocation, or a null pointer on failure
+ */
+static void* arena_allocate(void* context, size_t size)
+{
+    VecArena* arena = (VecArena*) context;
+    size_t rounded = 0;
+
+    if (arena == NULL ||
+        size == 0 ||
+        !round_to_alignment(size, &rounded))
+    {
+        return NULL;
+    }
+
+    ArenaBlock* current = arena->blocks;
+
+    if (rounded > arena->block_size)
+    {
+        ArenaBlock* dedicated = new_block(rounded);
+
+        if (dedicated == NULL)
+        {
+            return NULL;
+        }
+
+        dedicated->used = rounded;
+        if (current == NULL)
+        {
+            arena->blocks = dedicated;
+        }
+        else
+        {
+            dedicated->next = current->next;
+            current->next = dedicated;
+        }
+        arena->used += rounded;
+
+        return block_at(dedicated, 0);
+    }
+
+    if (current == NULL ||
+        current->size - current->used < rounded)
+    {
+        // The current block's out of room, so start bumping through a new one.
+        current = new_block(arena->block_size);
+        if (current == NULL)
+        {
+            return NULL;
+        }
+        current->next = arena->blocks;
+        arena->blocks = current;
+    }
+
+    current->last_offset = current->used;
+    current->used += rounded;
+    arena->used += rounded;
+
+    return block_at(current, current->last_offset);
+}
+
+/**
+ * @brief Resizes the given allocation from the arena given as context
+ *
+ * If the allocation is the latest one bumped off of the current block and the
+ * block has room, it's resized in place. Otherwise, it's copied to a new
+ * allocation, and the old one stays in the arena until it's reset.
+ *
+ * @param context The arena
+ * @param block The allocation to resize
+ * @param old_size The allocation's current byte size
+ * @param new_size The byte size to resize the allocation to
+ * @return The resized allocation, or a null pointer on failure
+ */
+static void* arena_reallocate(void* context,
+                              void* block,
+                              size_t old_size,
+                              size_t new_size)
+{
+    VecArena* arena = (VecArena*) context;
+    size_t rounded = 0;
+
+    if (arena == NULL ||
+        new_size == 0 ||
+        !round_to_alignment(new_size, &rounded))
+    {
+        return NULL;
+    }
+
+    if (block == NULL)
+    {
+        return arena_allocate(context, new_size);
+    }
+
+    if (is_latest(arena, block))
+    {
+        ArenaBlock* current = arena->blocks;
+        size_t const latest_size = current->used - current->last_offset;
+
+        if (rounded <= current->size - current->last_offset)
+        {
+            current->used = current->last_offset + rounded;
+            arena->used = arena->used - latest_size + rounded;
+
+            return block;
+        }
+    }
+
+    void* moved = arena_allocate(context, new_size);
+
+    if (moved == NULL)
+    {
+        return NULL;
+    }
+    memcpy(moved, block, old_size < new_size ? old_size : new_size);
+
+    return moved;
+}
+
+/**
+ * @brief Gives back the given allocation to the arena given as context
+ *
+ * Only the latest allocation bumped off of the current block is actually
+ * reclaimed (by bumping back); everything else stays in the arena until it's
+ * reset or destroyed.
+ *
+ * @param context The arena
+ * @param block The allocation to give back
+ * @param size The allocation's byte size
+ */
+static void arena_deallocate(void* context, void* block, size_t size)
+{
+    (void) size;
+
+    VecArena* arena = (VecArena*) context;
+
+    if (arena == NULL ||
+        block == NULL ||
+        !is_latest(arena, block))
+    {
+        return;
+    }
+
+    ArenaBlock* current = arena->blocks;
+
+    arena->used -= current->used - current->last_offset;
+    current->used = current->last_offset;
+}
+
+VecAllocator VecArena_allocator(VecArena* arena)
+{
+    assert(arena != NULL);
+
+    VecAllocator const allocator =
+    {
+        .allocate = arena_allocate,
+        .reallocate = arena_reallocate,
+        .deallocate = arena_deallocate,
+        .context = arena
+    };
+
+    return allocator;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file
+ * A bump ("arena") allocator usable as a vector's allocator
+ *
+ * An arena hands out memory by bumping a pointer through big blocks that it
+ * gets from `malloc()`, which makes allocating from it about as cheap as
+ * allocating gets. Individual allocations are never freed, though; instead,
+ * everything allocated from an arena is released in one go, by resetting or
+ * destroying the arena.
+ *
+ * This suits short-lived vectors whose lifetimes end together, like the
+ * vectors used while handling one request in a server: every vector used for
+ * the request comes from the request's arena, and the arena is reset when the
+ * request's done, without having to destroy each vector. Since each thread can
+ * work with its own arena, threads don't contend over a shared `malloc()`.
+ *
+ * ```
+ * VecArena* arena = VecArena_new(0);
+ * VecAllocator const allocator = VecArena_allocator(arena);
+ * VecOptions const options = { .allocator = &allocator };
+ * Vec* v = Vec_new_with(16, sizeof(int64_t), &options);
+ *
+ * // ...use the vector...
+ *
+ * VecArena_reset(arena); // Releases the vector (don't use it past here)
+ * ```
+ *
+ * An arena isn't thread-safe; only one thread should use a given arena (and
+ * the vectors allocated from it) at a time.
+ */
+#ifndef VEC_ARENA_H
+#define VEC_ARENA_H
+
+#include <stddef.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The arena struct, `typedef`'d so that its implementation details are
+ * encapsulated
+ */
+typedef struct VecArena VecArena;
+
+/**
+ * @brief Allocates a new, empty arena
+ *
+ * WARNING: This returns a dynamically allocated arena whose memory should
+ * eventually be freed with `VecArena_destroy()`. Otherwise, the arena's memory
+ * will leak.
+ *
+ * The arena gets memory from `malloc()` in blocks of the given size, and each
+ * allocation bigger than that gets a block of its own.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if allocating memory for the arena failed, internally.
+ *
+ * @param block_size The byte size of the blocks the arena bumps through (or 0
+ * for a default of 64 KiB)
+ * @return A pointer to the newly-allocated arena
+ */
+VecArena* VecArena_new(size_t const block_size);
+
+/**
+ * @brief Destroys the given arena, and with it all memory allocated from it,
+ * taking it as a double pointer so that it can null out the caller's single
+ * pointer to the arena (for convenience)
+ *
+ * WARNING: Vectors allocated from the arena are destroyed along with it, and
+ * must not be used (or passed to `Vec_destroy()`) afterwards!
+ *
+ * The double pointer or inner arena pointer can be null, in which case this
+ * does nothing.
+ *
+ * @param arena A double pointer to an arena
+ */
+void VecArena_destroy(VecArena** arena);
+
+/**
+ * @brief Releases all memory allocated from the given arena, making it
+ * available for allocating from again
+ *
+ * WARNING: Vectors allocated from the arena are released along with their
+ * memory, and must not be used (or passed to `Vec_destroy()`) afterwards!
+ *
+ * The arena keeps one of its blocks around to be reused, and gives the rest of
+ * its blocks back to `free()`.
+ *
+ * If the arena pointer is null, this does nothing (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param arena The arena to reset
+ */
+void VecArena_reset(VecArena* arena);
+
+/**
+ * @brief Gets the number of bytes currently allocated from the given arena
+ *
+ * This includes any padding added to keep allocations aligned.
+ *
+ * If the arena pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param arena The arena to query
+ * @return The number of bytes allocated from the arena so far
+ */
+size_t VecArena_used(VecArena const* arena);
+
+/**
+ * @brief Gets an allocator that allocates from the given arena, usable as a
+ * vector's allocator via `VecOptions`
+ *
+ * Memory that's deallocated through the allocator stays in the arena until it's
+ * reset or destroyed. Reallocating the arena's most recent allocation grows or
+ * shrinks it in place when there's room to.
+ *
+ * The arena must outlive any vector using the allocator.
+ *
+ * @param arena The arena to allocate from
+ * @return The allocator
+ */
+VecAllocator VecArena_allocator(VecArena* arena);
+
+#endif
@@ -0,0 +1,600 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*
+ * Like the vector's exact-match scans, combining bit vectors goes a whole
+ * vector register at a time where the CPU allows it: SSE2 (or AVX2, when the
+ * CPU turns out to support it) on x86-64, and NEON on 64-bit ARM.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define VEC_SIMD_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define VEC_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#include "VecBits.h"
+
+struct VecBits
+{
+    size_t count; // The number of bits
+    size_t word_capacity; // The number of words allocated
+    uint64_t* words; // The bits, 64 to a word
+};
+
+/**
+ * @enum
+ * A way to combine bit vectors' words
+ */
+typedef enum
+{
+    COMBINE_AND, // Destination AND source
+    COMBINE_OR, // Destination OR source
+    COMBINE_NOT // NOT destination (ignoring the source)
+} Combine;
+
+/**
+ * @brief Gets the number of words that hold the given number of bits
+ */
+static size_t words_for(size_t const count)
+{
+    return count / 64 + (count % 64 != 0);
+}
+
+/**
+ * @brief Clears the bits past the last one, in the given bit vector's last
+ * word
+ */
+static void clear_tail(VecBits* b)
+{
+    size_t const last_bits = b->count % 64;
+
+    if (last_bits != 0)
+    {
+        b->words[b->count / 64] &= ((uint64_t) 1 << last_bits) - 1;
+    }
+}
+
+/**
+ * @brief Combines the given words one at a time
+ */
+static void combine_scalar(uint64_t* dst,
+                           uint64_t const* src,
+                           size_t const words,
+                           Combine const how)
+{
+    for (size_t i = 0; i < words; ++i)
+    {
+        if (how == COMBINE_AND)
+        {
+            dst[i] &= src[i];
+        }
+        else if (how == COMBINE_OR)
+        {
+            dst[i] |= src[i];
+        }
+        else
+        {
+            dst[i] = ~dst[i];
+        }
+    }
+}
+
+#if defined(VEC_SIMD_X86)
+/**
+ * @brief Combines the given words 2 at a time (using SSE2)
+ *
+ * @return How many words were combined (leaving the rest, fewer than 2)
+ */
+static size_t combine_sse2(uint64_t* dst,
+                           uint64_t const* src,
+                           size_t const words,
+                           Combine const how)
+{
+    __m128i const ones = _mm_set1_epi32(-1);
+    size_t i = 0;
+
+    for (; i + 2 <= words; i += 2)
+    {
+        __m128i const d = _mm_loadu_si128((__m128i const*) (dst + i));
+        __m128i result;
+
+        if (how == COMBINE_AND)
+        {
+            result = _mm_and_si128(d, _mm_loadu_si128((__m128i const*)
+                                                      (src + i)));
+        }
+        else if (how == COMBINE_OR)
+        {
+            result = _mm_or_si128(d, _mm_loadu_si128((__m128i const*)
+                                                     (src + i)));
+        }
+        else
+        {
+            result = _mm_xor_si128(d, ones);
+        }
+        _mm_storeu_si128((__m128i*) (dst + i), result);
+    }
+
+    return i;
+}
+
+/**
+ * @brief Combines the given words 4 at a time (using AVX2)
+ *
+ * This must only be called when the CPU supports AVX2.
+ *
+ * @return How many words were combined (leaving the rest, fewer than 4)
+ */
+__attribute__((target("avx2")))
+static size_t combine_avx2(uint64_t* dst,
+                           uint64_t const* src,
+                           size_t const words,
+                           Combine const how)
+{
+    __m256i const ones = _mm256_set1_epi32(-1);
+    size_t i = 0;
+
+    for (; i + 4 <= words; i += 4)
+    {
+        __m256i const d = _mm256_loadu_si256((__m256i const*) (dst + i));
+        __m256i result;
+
+        if (how == COMBINE_AND)
+        {
+            result = _mm256_and_si256(d, _mm256_loadu_si256((__m256i const*)
+                                                            (src + i)));
+        }
+        else if (how == COMBINE_OR)
+        {
+            result = _mm256_or_si256(d, _mm256_loadu_si256((__m256i const*)
+                                                           (src + i)));
+        }
+        else
+        {
+            result = _mm256_xor_si256(d, ones);
+        }
+        _mm256_storeu_si256((__m256i*) (dst + i), result);
+    }
+
+    return i;
+}
+
+/**
+ * @brief Counts the set bits of the given words (using the POPCNT
+ * instruction)
+ *
+ * This must only be called when the CPU supports POPCNT.
+ */
+__attribute__((target("popcnt")))
+static size_t popcount_popcnt(uint64_t const* words, size_t const count)
+{
+    size_t total = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        total += (size_t) __builtin_popcountll(words[i]);
+    }
+
+    return total;
+}
+#endif
+
+#if defined(VEC_SIMD_NEON)
+/**
+ * @brief Combines the given words 2 at a time (using NEON)
+ *
+ * @return How many words were combined (leaving the rest, fewer than 2)
+ */
+static size_t combine_neon(uint64_t* dst,
+                           uint64_t const* src,
+                           size_t const words,
+                           Combine const how)
+{
+    size_t i = 0;
+
+    for (; i + 2 <= words; i += 2)
+    {
+        uint64x2_t const d = vld1q_u64(dst + i);
+        uint64x2_t result;
+
+        if (how == COMBINE_AND)
+        {
+            result = vandq_u64(d, vld1q_u64(src + i));
+        }
+        else if (how == COMBINE_OR)
+        {
+            result = vorrq_u64(d, vld1q_u64(src + i));
+        }
+        else
+        {
+            result = vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(d)));
+        }
+        vst1q_u64(dst + i, result);
+    }
+
+    return i;
+}
+#endif
+
+/**
+ * @brief Combines the given words, as many at a time as the CPU allows
+ */
+static void combine(uint64_t* dst,
+                    uint64_t const* src,
+                    size_t const words,
+                    Combine const how)
+{
+    size_t done = 0;
+
+    if (words == 0)
+    {
+        return;
+    }
+
+#if defined(VEC_SIMD_X86)
+    if (__builtin_cpu_supports("avx2"))
+    {
+        done = combine_avx2(dst, src, words, how);
+    }
+    else
+    {
+        done = combine_sse2(dst, src, words, how);
+    }
+#elif defined(VEC_SIMD_NEON)
+    done = combine_neon(dst, src, words, how);
+#endif
+
+    combine_scalar(dst + done,
+                   (src != NULL) ? src + done : NULL,
+                   words - done,
+                   how);
+}
+
+/**
+ * @brief Counts the set bits of the given word
+ */
+static size_t popcount_word(uint64_t word)
+{
+#if defined(__GNUC__)
+    return (size_t) __builtin_popcountll(word);
+#else
+    size_t total = 0;
+
+    while (word != 0)
+    {
+        word &= word - 1; // Clear the lowest set bit.
+        total += 1;
+    }
+
+    return total;
+#endif
+}
+
+/**
+ * @brief Gets the index of the lowest set bit of the given (non-0) word
+ */
+static size_t lowest_set_bit(uint64_t const word)
+{
+#if defined(__GNUC__)
+    return (size_t) __builtin_ctzll(word);
+#else
+    size_t i = 0;
+
+    while (((word >> i) & 1) == 0)
+    {
+        i += 1;
+    }
+
+    return i;
+#endif
+}
+
+VecBits* VecBits_new(size_t const count)
+{
+    VecBits* b = malloc(sizeof(VecBits));
+    bool const bits_allocation_succeeded = (b != NULL);
+
+    assert(bits_allocation_succeeded);
+    if (!bits_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    b->count = 0;
+    b->word_capacity = 0;
+    b->words = NULL;
+
+    if (!VecBits_resize(b, count))
+    {
+        VecBits_destroy(&b);
+        return NULL;
+    }
+
+    return b;
+}
+
+VecBits* VecBits_from_if(Vec const* v,
+                         bool (*predicate)(void const*, size_t const))
+{
+    assert(v != NULL);
+    assert(predicate != NULL);
+    if (v == NULL ||
+        predicate == NULL)
+    {
+        return NULL;
+    }
+
+    size_t const count = Vec_count(v);
+    size_t const size = Vec_element_size(v);
+    VecBits* b = VecBits_new(count);
+
+    if (b == NULL)
+    {
+        return NULL;
+    }
+
+    uint8_t const* element = (uint8_t const*) Vec_data(v);
+
+    // Gather each word's bits before storing it, rather than bit by bit.
+    for (size_t w = 0; w < words_for(count); ++w)
+    {
+        size_t const end = (count - w * 64 < 64) ? count - w * 64 : 64;
+        uint64_t word = 0;
+
+        for (size_t bit = 0; bit < end; ++bit, element += size)
+        {
+            word |= (uint64_t) predicate(element, size) << bit;
+        }
+        b->words[w] = word;
+    }
+
+    return b;
+}
+
+void VecBits_destroy(VecBits** b)
+{
+    if (b == NULL ||
+        (*b) == NULL)
+    {
+        return;
+    }
+
+    free((*b)->words);
+    free(*b);
+    *b = NULL;
+}
+
+size_t VecBits_count(VecBits const* b)
+{
+    assert(b != NULL);
+    if (b == NULL)
+    {
+        return 0;
+    }
+
+    return b->count;
+}
+
+bool VecBits_resize(VecBits* b, size_t const count)
+{
+    assert(b != NULL);
+    if (b == NULL)
+    {
+        return false;
+    }
+
+    size_t const words = words_for(count);
+
+    if (words > b->word_capacity)
+    {
+        // (If okay with requiring C23, this should just be a `ckd_mul()`.)
+        bool const bytes_overflowed = words > SIZE_MAX / sizeof(uint64_t);
+        uint64_t* grown = bytes_overflowed
+                          ? NULL
+                          : realloc(b->words, words * sizeof(uint64_t));
+        bool const words_allocation_succeeded = (grown != NULL);
+
+        assert(words_allocation_succeeded);
+        if (!words_allocation_succeeded)
+        {
+            return false;
+        }
+
+        b->words = grown;
+        b->word_capacity = words;
+    }
+
+    // New bits start clear (and the tail of the last word already is).
+    size_t const old_words = words_for(b->count);
+
+    if (words > old_words)
+    {
+        memset(b->words + old_words, 0,
+               (words - old_words) * sizeof(uint64_t));
+    }
+    b->count = count;
+    if (count != 0)
+    {
+        clear_tail(b);
+    }
+
+    return true;
+}
+
+uint64_t* VecBits_words(VecBits* b)
+{
+    assert(b != NULL);
+    if (b == NULL ||
+        b->count == 0)
+    {
+        return NULL;
+    }
+
+    return b->words;
+}
+
+bool VecBits_get(VecBits const* b, size_t const i)
+{
+    assert(b != NULL);
+    assert(b == NULL || i < b->count);
+    if (b == NULL ||
+        i >= b->count)
+    {
+        return false;
+    }
+
+    return (b->words[i / 64] >> (i % 64)) & 1;
+}
+
+bool VecBits_set(VecBits* b, size_t const i, bool const value)
+{
+    assert(b != NULL);
+    assert(b == NULL || i < b->count);
+    if (b == NULL ||
+        i >= b->count)
+    {
+        return false;
+    }
+
+    uint64_t const bit = (uint64_t) 1 << (i % 64);
+
+    if (value)
+    {
+        b->words[i / 64] |= bit;
+    }
+    else
+    {
+        b->words[i / 64] &= ~bit;
+    }
+
+    return true;
+}
+
+void VecBits_fill(VecBits* b, bool const value)
+{
+    assert(b != NULL);
+    if (b == NULL ||
+        b->count == 0)
+    {
+        return;
+    }
+
+    memset(b->words, value ? 0xFF : 0, words_for(b->count) * sizeof(uint64_t));
+    clear_tail(b);
+}
+
+size_t VecBits_popcount(VecBits const* b)
+{
+    assert(b != NULL);
+    if (b == NULL)
+    {
+        return 0;
+    }
+
+    size_t const words = words_for(b->count);
+
+#if defined(VEC_SIMD_X86)
+    if (__builtin_cpu_supports("popcnt"))
+    {
+        return popcount_popcnt(b->words, words);
+    }
+#endif
+
+    size_t total = 0;
+
+    for (size_t i = 0; i < words; ++i)
+    {
+        total += popcount_word(b->words[i]);
+    }
+
+    return total;
+}
+
+size_t VecBits_first_set(VecBits const* b, size_t const from)
+{
+    assert(b != NULL);
+    if (b == NULL)
+    {
+        return 0;
+    }
+
+    if (from >= b->count)
+    {
+        return b->count;
+    }
+
+    size_t const words = words_for(b->count);
+    size_t w = from / 64;
+
+    // Ignore the bits before `from` in its word.
+    uint64_t word = b->words[w] & ~(((uint64_t) 1 << (from % 64)) - 1);
+
+    while (word == 0)
+    {
+        w += 1;
+        if (w == words)
+        {
+            return b->count;
+        }
+        word = b->words[w];
+    }
+
+    return w * 64 + lowest_set_bit(word);
+}
+
+/**
+ * @brief Checks the arguments of `VecBits_and()` and `VecBits_or()`
+ */
+static bool binary_valid(VecBits const* dst, VecBits const* src)
+{
+    return dst != NULL &&
+           src != NULL &&
+           dst->count == src->count;
+}
+
+bool VecBits_and(VecBits* dst, VecBits const* src)
+{
+    bool const valid = binary_valid(dst, src);
+
+    assert(valid);
+    if (!valid)
+    {
+        return false;
+    }
+
+    combine(dst->words, src->words, words_for(dst->count), COMBINE_AND);
+
+    return true;
+}
+
+bool VecBits_or(VecBits* dst, VecBits const* src)
+{
+    bool const valid = binary_valid(dst, src);
+
+    assert(valid);
+    if (!valid)
+    {
+        return false;
+    }
+
+    combine(dst->words, src->words, words_for(dst->count), COMBINE_OR);
+
+    return true;
+}
+
+void VecBits_not(VecBits* b)
+{
+    assert(b != NULL);
+    if (b == NULL ||
+        b->count == 0)
+    {
+        return;
+    }
+
+    combine(b->words, NULL, words_for(b->count), COMBINE_NOT);
+    clear_tail(b);
+}
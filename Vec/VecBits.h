@@ -0,0 +1,239 @@
+/**
+ * @file
+ * Bit vectors: packed flags, one bit each, for masks over vectors
+ *
+ * A vector of `bool`s spends a byte (at least) on every flag. A bit vector
+ * packs 64 flags into each 64-bit word, so a mask over a million elements
+ * takes 125 KiB instead of 1 MB, and combining, counting, or searching masks
+ * goes a whole word (or, with SIMD, a whole register of words) at a time.
+ *
+ * ```
+ * VecBits* stale = VecBits_from_if(orders, is_stale);
+ * VecBits* unpaid = VecBits_from_if(orders, is_unpaid);
+ *
+ * VecBits_and(stale, unpaid); // Stale AND unpaid
+ * Vec_remove_all_masked(orders, VecBits_words(stale), VecBits_count(stale));
+ * ```
+ *
+ * Bit `i` is bit `i % 64` of word `i / 64`, which is the layout the vector's
+ * mask-driven functions (like `Vec_remove_all_masked()` and
+ * `Vec_apply_masked()`) take. The bits past the last one, in the last word,
+ * are always kept clear.
+ */
+#ifndef VEC_BITS_H
+#define VEC_BITS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The bit vector struct, `typedef`'d so that its implementation details are
+ * encapsulated
+ */
+typedef struct VecBits VecBits;
+
+/**
+ * @brief Creates a new bit vector of the given number of bits, all clear
+ *
+ * WARNING: This returns a dynamically allocated bit vector that should
+ * eventually be destroyed with `VecBits_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if allocating memory for the bit vector failed,
+ * internally.
+ *
+ * @param count The number of bits (which may be 0)
+ * @return A pointer to the newly-allocated bit vector
+ */
+VecBits* VecBits_new(size_t const count);
+
+/**
+ * @brief Creates a new bit vector with a bit for each element of the given
+ * vector, set if the element satisfies the given predicate
+ *
+ * WARNING: This returns a dynamically allocated bit vector that should
+ * eventually be destroyed with `VecBits_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the vector or predicate pointers are null, or allocating
+ * memory for the bit vector failed, internally.
+ *
+ * @param v The vector to test
+ * @param predicate A function that takes an element pointer and the element
+ * size, and returns whether to set the element's bit
+ * @return A pointer to the newly-allocated bit vector
+ */
+VecBits* VecBits_from_if(Vec const* v,
+                         bool (*predicate)(void const*, size_t const));
+
+/**
+ * @brief Destroys the given bit vector, taking it as a double pointer so that
+ * it can null out the caller's single pointer to the bit vector (for
+ * convenience)
+ *
+ * The double pointer or inner bit vector pointer can be null, in which case
+ * this does nothing.
+ *
+ * @param b A double pointer to a bit vector
+ */
+void VecBits_destroy(VecBits** b);
+
+/**
+ * @brief Gets the number of bits in the given bit vector
+ *
+ * If the bit vector pointer is null, this just returns 0 (or, if assertions
+ * are enabled, causes an assert crash).
+ *
+ * @param b The bit vector
+ * @return The number of bits
+ */
+size_t VecBits_count(VecBits const* b);
+
+/**
+ * @brief Changes the number of bits in the given bit vector, clearing any new
+ * bits
+ *
+ * This fails, leaving the bit vector unmodified and returning false (or, if
+ * assertions are enabled, causing an assert crash), if the bit vector pointer
+ * is null, or allocating memory failed, internally.
+ *
+ * @param b The bit vector
+ * @param count The new number of bits
+ * @return Whether the bit vector was resized
+ */
+bool VecBits_resize(VecBits* b, size_t const count);
+
+/**
+ * @brief Gets the given bit vector's words, for reading or writing the bits
+ * directly (see the file's documentation for how they're laid out)
+ *
+ * The words stay valid until the bit vector is resized or destroyed. Setting
+ * the bits past the last one, in the last word, isn't allowed.
+ *
+ * If the bit vector pointer is null, this just returns a null pointer (or, if
+ * assertions are enabled, causes an assert crash).
+ *
+ * @param b The bit vector
+ * @return A pointer to the first word (or a null pointer, if there are no bits)
+ */
+uint64_t* VecBits_words(VecBits* b);
+
+/**
+ * @brief Gets the given bit of the given bit vector
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the bit vector pointer is null or the index is out of
+ * bounds.
+ *
+ * @param b The bit vector
+ * @param i The index of the bit
+ * @return Whether the bit is set
+ */
+bool VecBits_get(VecBits const* b, size_t const i);
+
+/**
+ * @brief Sets or clears the given bit of the given bit vector
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the bit vector pointer is null or the index is out of
+ * bounds.
+ *
+ * @param b The bit vector
+ * @param i The index of the bit
+ * @param value Whether to set the bit (or else clear it)
+ * @return Whether the bit was changed (or already had the value)
+ */
+bool VecBits_set(VecBits* b, size_t const i, bool const value);
+
+/**
+ * @brief Sets or clears every bit of the given bit vector
+ *
+ * If the bit vector pointer is null, this does nothing (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param b The bit vector
+ * @param value Whether to set the bits (or else clear them)
+ */
+void VecBits_fill(VecBits* b, bool const value);
+
+/**
+ * @brief Counts the set bits of the given bit vector
+ *
+ * The bits are counted a word at a time, with the CPU's population count
+ * instruction where it has one.
+ *
+ * If the bit vector pointer is null, this just returns 0 (or, if assertions
+ * are enabled, causes an assert crash).
+ *
+ * @param b The bit vector
+ * @return The number of set bits
+ */
+size_t VecBits_popcount(VecBits const* b);
+
+/**
+ * @brief Finds the first set bit of the given bit vector at or after the given
+ * index
+ *
+ * Words with no set bits are skipped whole, so going over every set bit with
+ * this (starting each search just after the last bit found) takes time in
+ * proportion to the number of words, plus the number of set bits.
+ *
+ * If the bit vector pointer is null, this just returns 0 (or, if assertions
+ * are enabled, causes an assert crash).
+ *
+ * @param b The bit vector
+ * @param from The index to start at
+ * @return The index of the first set bit (or, if there's none, the number of
+ * bits)
+ */
+size_t VecBits_first_set(VecBits const* b, size_t const from);
+
+/**
+ * @brief Ands the given source bit vector into the given destination bit
+ * vector, so each of the destination's bits is only left set if it's set in
+ * both
+ *
+ * The words are combined as many at a time as the CPU's SIMD instructions
+ * allow (using AVX2 on x86-64 when the CPU supports it, or else SSE2; or NEON
+ * on 64-bit ARM).
+ *
+ * This fails, leaving the destination unmodified and returning false (or, if
+ * assertions are enabled, causing an assert crash), if either pointer is null,
+ * or the bit vectors' counts differ.
+ *
+ * @param dst The bit vector to modify
+ * @param src The bit vector to and in
+ * @return Whether the bit vectors were combined
+ */
+bool VecBits_and(VecBits* dst, VecBits const* src);
+
+/**
+ * @brief Ors the given source bit vector into the given destination bit
+ * vector, so each of the destination's bits is set if it's set in either
+ *
+ * This combines the words like `VecBits_and()`, and fails under the same
+ * conditions.
+ *
+ * @param dst The bit vector to modify
+ * @param src The bit vector to or in
+ * @return Whether the bit vectors were combined
+ */
+bool VecBits_or(VecBits* dst, VecBits const* src);
+
+/**
+ * @brief Flips every bit of the given bit vector
+ *
+ * This flips the words as many at a time as `VecBits_and()` combines them.
+ *
+ * If the bit vector pointer is null, this does nothing (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param b The bit vector
+ */
+void VecBits_not(VecBits* b);
+
+#endif
@@ -0,0 +1,427 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+
+#include "VecConcurrent.h"
+
+/**
+ * @def
+ * The byte size of a cache line, which the counters are kept apart by
+ */
+#define CACHE_LINE_SIZE 64
+
+/**
+ * @def
+ * The most segments a concurrent vector can have (one per bit of an index,
+ * which is more than enough, since segments double in size)
+ */
+#define SEGMENT_COUNT 64
+
+struct VecConcurrent
+{
+    /*
+     * Every append increments the claim counter, and moves the published
+     * count along, so each counter gets its own cache line, away from the
+     * read-only fields (which every append reads).
+     */
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t claimed; // Slots handed out
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t published; // Slots readers see
+
+    _Alignas(CACHE_LINE_SIZE) size_t element_size; // Byte size of an element
+    unsigned first_shift; // The first segment's capacity is `1 << first_shift`
+    size_t max_count; // The most elements the vector can hold
+    atomic_bool broken; // Whether a segment failed to be allocated
+
+    /*
+     * Each segment is its elements, followed by a flag per element that's set
+     * once the element is completely copied in.
+     */
+    _Atomic(uint8_t*) segments[SEGMENT_COUNT];
+};
+
+/**
+ * @brief Gets the index of the highest set bit of the given (non-0) number
+ * @param n The number
+ * @return The index of the highest set bit
+ */
+static unsigned floor_log2(size_t n)
+{
+#if defined(__GNUC__)
+    return (unsigned) (sizeof(unsigned long long) * 8 - 1) -
+           (unsigned) __builtin_clzll((unsigned long long) n);
+#else
+    unsigned log = 0;
+
+    while (n >>= 1)
+    {
+        ++log;
+    }
+
+    return log;
+#endif
+}
+
+/**
+ * @brief Finds where the element at the given index of the given concurrent
+ * vector lives
+ *
+ * Segment `k` holds `first << k` elements, and starts at index
+ * `first * ((1 << k) - 1)`, so the segment is the highest set bit of
+ * `index / first + 1`.
+ *
+ * @param v The concurrent vector
+ * @param index The element's index
+ * @param segment Where to put the index of the element's segment
+ * @param offset Where to put the element's index within its segment
+ */
+static void locate(VecConcurrent const* v,
+                   size_t const index,
+                   unsigned* segment,
+                   size_t* offset)
+{
+    *segment = floor_log2((index >> v->first_shift) + 1);
+    *offset = index - ((((size_t) 1 << *segment) - 1) << v->first_shift);
+}
+
+/**
+ * @brief Gets the number of elements in the given segment of the given
+ * concurrent vector
+ */
+static size_t segment_capacity(VecConcurrent const* v, unsigned const segment)
+{
+    return (size_t) 1 << (v->first_shift + segment);
+}
+
+/**
+ * @brief Gets the flag of the element at the given offset in the given segment
+ * of the given concurrent vector
+ */
+static atomic_uchar* ready_flag(VecConcurrent const* v,
+                                uint8_t* block,
+                                unsigned const segment,
+                                size_t const offset)
+{
+    uint8_t* flags = block + segment_capacity(v, segment) * v->element_size;
+
+    return (atomic_uchar*) flags + offset;
+}
+
+/**
+ * @brief Gets the given segment of the given concurrent vector, allocating it
+ * if nobody has yet
+ *
+ * Every append that needs a missing segment races to allocate it, and the
+ * first one to install its allocation wins, while the others free theirs.
+ *
+ * @param v The concurrent vector
+ * @param segment The segment's index
+ * @return The segment, or a null pointer if allocating it failed
+ */
+static uint8_t* get_segment(VecConcurrent* v, unsigned const segment)
+{
+    uint8_t* block = atomic_load_explicit(&v->segments[segment],
+                                          memory_order_acquire);
+
+    if (block != NULL)
+    {
+        return block;
+    }
+
+    // Each element's flag starts out cleared (as does the element).
+    uint8_t* allocated = calloc(segment_capacity(v, segment),
+                                v->element_size + sizeof(atomic_uchar));
+
+    if (allocated == NULL)
+    {
+        return NULL;
+    }
+
+    if (atomic_compare_exchange_strong_explicit(&v->segments[segment],
+                                                &block,
+                                                allocated,
+                                                memory_order_acq_rel,
+                                                memory_order_acquire))
+    {
+        return allocated;
+    }
+
+    free(allocated);
+
+    return block; // Since it lost, this is the winner's segment.
+}
+
+/**
+ * @brief Moves the given concurrent vector's published count past every
+ * element that's completely copied in, stopping at the first that isn't
+ *
+ * Every append does this after its own element is copied in, so whichever
+ * append finishes last (of the ones before a given element) moves the count
+ * past all of them.
+ *
+ * @param v The concurrent vector
+ */
+static void publish(VecConcurrent* v)
+{
+    size_t published = atomic_load_explicit(&v->published,
+                                            memory_order_acquire);
+
+    while (published < v->max_count)
+    {
+        unsigned segment = 0;
+        size_t offset = 0;
+
+        locate(v, published, &segment, &offset);
+
+        uint8_t* block = atomic_load_explicit(&v->segments[segment],
+                                              memory_order_acquire);
+
+        /*
+         * (The flag is read sequentially consistently, pairing with the
+         * sequentially consistent store of the flag, so that of two appends
+         * finishing at once, at least one sees that the other's element is
+         * done, and neither leaves the count stuck behind it.)
+         */
+        if (block == NULL ||
+            !atomic_load(ready_flag(v, block, segment, offset)))
+        {
+            return;
+        }
+
+        // On failure, someone else moved the count, so carry on from there.
+        if (atomic_compare_exchange_weak_explicit(&v->published,
+                                                  &published,
+                                                  published + 1,
+                                                  memory_order_acq_rel,
+                                                  memory_order_acquire))
+        {
+            ++published;
+        }
+    }
+}
+
+VecConcurrent* VecConcurrent_new(size_t const least_capacity,
+                                 size_t const element_size)
+{
+    assert(least_capacity != 0);
+    assert(element_size != 0);
+    if (least_capacity == 0 ||
+        element_size == 0)
+    {
+        return NULL;
+    }
+
+    /*
+     * Every segment's byte size (with its flags) has to be representable, so
+     * keep the elements to half of what a size can count.
+     *
+     * (If okay with requiring C23, this should just be a `ckd_mul()`.)
+     */
+    size_t const max_count = (SIZE_MAX / 2) / (element_size + 1);
+    unsigned first_shift = 0;
+
+    while (((size_t) 1 << first_shift) < least_capacity &&
+           ((size_t) 1 << first_shift) <= max_count)
+    {
+        ++first_shift;
+    }
+
+    bool const capacity_overflowed = ((size_t) 1 << first_shift) > max_count;
+
+    assert(!capacity_overflowed);
+    if (capacity_overflowed)
+    {
+        return NULL;
+    }
+
+    VecConcurrent* v = aligned_alloc(CACHE_LINE_SIZE, sizeof(VecConcurrent));
+    bool const vector_allocation_succeeded = (v != NULL);
+
+    assert(vector_allocation_succeeded);
+    if (!vector_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    atomic_init(&v->claimed, 0);
+    atomic_init(&v->published, 0);
+    v->element_size = element_size;
+    v->first_shift = first_shift;
+    v->max_count = max_count;
+    atomic_init(&v->broken, false);
+    for (size_t i = 0; i < SEGMENT_COUNT; ++i)
+    {
+        atomic_init(&v->segments[i], NULL);
+    }
+
+    // The first segment is allocated up front, so small vectors never race.
+    bool const segment_allocation_succeeded = (get_segment(v, 0) != NULL);
+
+    assert(segment_allocation_succeeded);
+    if (!segment_allocation_succeeded)
+    {
+        free(v);
+        return NULL;
+    }
+
+    return v;
+}
+
+void VecConcurrent_destroy(VecConcurrent** v)
+{
+    if (v == NULL ||
+        (*v) == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < SEGMENT_COUNT; ++i)
+    {
+        free(atomic_load_explicit(&(*v)->segments[i], memory_order_relaxed));
+    }
+    free(*v);
+    *v = NULL;
+}
+
+bool VecConcurrent_append(VecConcurrent* v,
+                          void const* item,
+                          size_t const item_size)
+{
+    assert(v != NULL);
+    assert(item != NULL);
+    if (v == NULL ||
+        item == NULL)
+    {
+        return false;
+    }
+
+    assert(item_size == v->element_size);
+    if (item_size != v->element_size)
+    {
+        return false;
+    }
+
+    bool const broken = atomic_load_explicit(&v->broken,
+                                             memory_order_relaxed);
+
+    assert(!broken);
+    if (broken)
+    {
+        return false;
+    }
+
+    size_t const index = atomic_fetch_add_explicit(&v->claimed,
+                                                   1,
+                                                   memory_order_relaxed);
+    bool const full = index >= v->max_count;
+
+    assert(!full);
+    if (full)
+    {
+        return false;
+    }
+
+    unsigned segment = 0;
+    size_t offset = 0;
+
+    locate(v, index, &segment, &offset);
+
+    uint8_t* block = get_segment(v, segment);
+    bool const segment_allocation_succeeded = (block != NULL);
+
+    assert(segment_allocation_succeeded);
+    if (!segment_allocation_succeeded)
+    {
+        // The claimed slot can never be filled, so nothing after it can show.
+        atomic_store_explicit(&v->broken, true, memory_order_relaxed);
+        return false;
+    }
+
+    memcpy(block + offset * v->element_size, item, item_size);
+    atomic_store(ready_flag(v, block, segment, offset), 1);
+    publish(v);
+
+    return true;
+}
+
+size_t VecConcurrent_count(VecConcurrent const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return atomic_load_explicit(&((VecConcurrent*) v)->published,
+                                memory_order_acquire);
+}
+
+void const* VecConcurrent_get(VecConcurrent const* v, size_t const index)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return NULL;
+    }
+
+    bool const index_valid = index < VecConcurrent_count(v);
+
+    assert(index_valid);
+    if (!index_valid)
+    {
+        return NULL;
+    }
+
+    unsigned segment = 0;
+    size_t offset = 0;
+
+    locate(v, index, &segment, &offset);
+
+    uint8_t* block =
+        atomic_load_explicit(&((VecConcurrent*) v)->segments[segment],
+                             memory_order_acquire);
+
+    return block + offset * v->element_size;
+}
+
+Vec* VecConcurrent_collect(VecConcurrent const* v,
+                           VecOptions const* options)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return NULL;
+    }
+
+    size_t const count = VecConcurrent_count(v);
+    Vec* collected = Vec_new_with(count > 0 ? count : 1,
+                                  v->element_size,
+                                  options);
+    bool const vector_allocation_succeeded = (collected != NULL);
+
+    assert(vector_allocation_succeeded);
+    if (!vector_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    // Copy whole segments at a time (the last one only up to the count).
+    size_t copied = 0;
+
+    for (unsigned segment = 0; copied < count; ++segment)
+    {
+        size_t const capacity = segment_capacity(v, segment);
+        size_t const n = (count - copied < capacity) ? count - copied
+                                                     : capacity;
+        uint8_t const* block =
+            atomic_load_explicit(&((VecConcurrent*) v)->segments[segment],
+                                 memory_order_acquire);
+
+        // (This can't fail, since the new vector already has the capacity.)
+        Vec_append_n(collected, block, n, v->element_size);
+        copied += n;
+    }
+
+    return collected;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file
+ * A vector that any number of threads can append to at once, without locks
+ *
+ * Appending to a regular vector isn't thread-safe, so vectors shared between
+ * producer threads need a lock around every append, which the producers then
+ * contend over. A concurrent vector instead lets each append claim its own
+ * slot with a single atomic increment, and copy its item in without waiting
+ * on anyone.
+ *
+ * ```
+ * VecConcurrent* events = VecConcurrent_new(1024, sizeof(Event));
+ *
+ * // On any number of threads at once:
+ * VecConcurrent_append(events, &event, sizeof(Event));
+ *
+ * // On any thread, at any time:
+ * for (size_t i = 0; i < VecConcurrent_count(events); ++i)
+ * {
+ *     Event const* e = VecConcurrent_get(events, i);
+ * }
+ * ```
+ *
+ * The elements live in segments, each twice as big as the last, which are
+ * never moved or resized once allocated. So growing never copies elements,
+ * and pointers to elements stay valid for as long as the vector does (unlike
+ * with a regular vector, whose elements move when it's resized).
+ *
+ * Appends can finish out of order (e.g., when a thread is interrupted in the
+ * middle of copying its item), so readers only see the elements up to the
+ * first one that's still being copied in: the count is always a prefix of
+ * elements that are completely written, and only grows.
+ *
+ * Elements can't be removed, or modified (other than through pointers the
+ * caller synchronizes on its own). When the producers are done, the elements
+ * can be copied into a regular vector with `VecConcurrent_collect()`.
+ */
+#ifndef VEC_CONCURRENT_H
+#define VEC_CONCURRENT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The concurrent vector struct, `typedef`'d so that its implementation details
+ * are encapsulated
+ */
+typedef struct VecConcurrent VecConcurrent;
+
+/**
+ * @brief Creates a new concurrent vector of elements of the given size, whose
+ * first segment has room for (at least) the given number of elements
+ *
+ * The first segment's capacity is rounded up to a power of 2, and each segment
+ * after it is twice as big as the one before. Segments are allocated (with
+ * `malloc()`) by the append that first needs them.
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `VecConcurrent_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The capacity or element size is 0
+ *     - The capacity is so huge that the first segment's byte size can't be
+ *       represented without overflow
+ *     - Allocating memory for the vector failed, internally
+ *
+ * @param least_capacity The first segment's minimum number of elements
+ * @param element_size The byte size of each element
+ * @return A pointer to the newly-allocated vector
+ */
+VecConcurrent* VecConcurrent_new(size_t const least_capacity,
+                                 size_t const element_size);
+
+/**
+ * @brief Destroys the given concurrent vector, taking it as a double pointer
+ * so that it can null out the caller's single pointer to the vector (for
+ * convenience)
+ *
+ * WARNING: No other thread may be using the vector (or pointers to its
+ * elements)!
+ *
+ * The double pointer or inner vector pointer can be null, in which case this
+ * does nothing.
+ *
+ * @param v A double pointer to a concurrent vector
+ */
+void VecConcurrent_destroy(VecConcurrent** v);
+
+/**
+ * @brief Appends a copy of the given item to the end of the given concurrent
+ * vector
+ *
+ * This is safe to call from any number of threads at once. Each call claims a
+ * slot with an atomic increment, so it never waits for other appends, except,
+ * occasionally, for the allocation of a new segment (when the claimed slot is
+ * in a segment nobody has allocated yet, every append landing there races to
+ * allocate it, and the losers free theirs).
+ *
+ * The item is visible to readers (i.e., counted by `VecConcurrent_count()`)
+ * once it and every item appended before it are completely copied in.
+ *
+ * WARNING: If allocating a segment fails, the slot this claimed can never be
+ * filled, so the vector's count never grows past it, and every append after
+ * that fails!
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The vector or item pointers are null
+ *     - The item's size isn't the vector's element size
+ *     - The vector is too huge to grow any further
+ *     - Allocating a segment failed, internally (now or before)
+ *
+ * @param v The concurrent vector to append to
+ * @param item The item to append
+ * @param item_size The byte size of the item
+ * @return Whether the item was appended
+ */
+bool VecConcurrent_append(VecConcurrent* v,
+                          void const* item,
+                          size_t const item_size);
+
+/**
+ * @brief Gets the number of elements in the given concurrent vector that are
+ * visible to readers: the elements up to the first one that's still being
+ * copied in
+ *
+ * This is safe to call from any thread at any time, and the count it returns
+ * never goes down.
+ *
+ * If the vector pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The concurrent vector
+ * @return The number of visible elements
+ */
+size_t VecConcurrent_count(VecConcurrent const* v);
+
+/**
+ * @brief Gets a pointer to the element at the given index in the given
+ * concurrent vector
+ *
+ * This is safe to call from any thread at any time. The pointer stays valid
+ * until the vector is destroyed.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the vector pointer is null, or the index isn't below
+ * the vector's count (see `VecConcurrent_count()`).
+ *
+ * @param v The concurrent vector
+ * @param index The element's index
+ * @return A pointer to the element
+ */
+void const* VecConcurrent_get(VecConcurrent const* v, size_t const index);
+
+/**
+ * @brief Copies the given concurrent vector's visible elements (see
+ * `VecConcurrent_count()`) into a new, regular vector
+ *
+ * This is safe to call while other threads append; they just may not make it
+ * into the copy. The copy goes a segment at a time, so it's a handful of
+ * `memcpy()`s, however many elements there are.
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `Vec_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the concurrent vector pointer is null, or if allocating
+ * memory for the new vector failed, internally.
+ *
+ * @param v The concurrent vector
+ * @param options The options to create the new vector with (or a null pointer
+ * for the default options)
+ * @return A pointer to the new vector
+ */
+Vec* VecConcurrent_collect(VecConcurrent const* v,
+                           VecOptions const* options);
+
+#endif
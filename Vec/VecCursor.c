@@ -0,0 +1,404 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "VecCursor.h"
+
+/**
+ * @struct
+ * A filter or map stage
+ */
+typedef struct
+{
+    bool (*predicate)(void const*, size_t const, void*); // Null if a map
+    void (*fun)(void const*, size_t const, void*, void*); // Null if a filter
+    void* context; // The pointer to call the predicate or function with
+    void* result; // Where a map puts its result (if it's not the last stage)
+    size_t result_size; // The byte size of a map's result
+} Stage;
+
+struct VecCursor
+{
+    Vec const* v; // The vector being iterated over
+    size_t position; // The index of the next element to look at
+    size_t element_size; // The byte size of the elements produced
+    Vec* stages; // The stages, in order (or null, until one's added)
+};
+
+/**
+ * @brief Gets the number of stages the given cursor has
+ */
+static size_t stage_count(VecCursor const* c)
+{
+    return (c->stages != NULL) ? Vec_count(c->stages) : 0;
+}
+
+/**
+ * @brief Runs the given element through the given cursor's stages
+ *
+ * If the last stage is a map, it puts its result straight into the given slot.
+ *
+ * @return A pointer to what came out of the last stage (which may be the slot),
+ * or a null pointer if a filter stopped the element
+ */
+static void const* run_stages(VecCursor const* c,
+                              void const* element,
+                              void* slot)
+{
+    size_t const stages = stage_count(c);
+    size_t size = Vec_element_size(c->v);
+
+    for (size_t i = 0; i < stages; ++i)
+    {
+        Stage const* s = Vec_get(c->stages, i);
+
+        if (s->predicate != NULL)
+        {
+            if (!s->predicate(element, size, s->context))
+            {
+                return NULL;
+            }
+            continue;
+        }
+
+        void* result = (i == stages - 1) ? slot : s->result;
+
+        s->fun(element, size, result, s->context);
+        element = result;
+        size = s->result_size;
+    }
+
+    return element;
+}
+
+VecCursor* VecCursor_new(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return NULL;
+    }
+
+    VecCursor* c = malloc(sizeof(VecCursor));
+    bool const cursor_allocation_succeeded = (c != NULL);
+
+    assert(cursor_allocation_succeeded);
+    if (!cursor_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    c->v = v;
+    c->position = 0;
+    c->element_size = Vec_element_size(v);
+    c->stages = NULL;
+
+    return c;
+}
+
+void VecCursor_destroy(VecCursor** c)
+{
+    if (c == NULL ||
+        (*c) == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < stage_count(*c); ++i)
+    {
+        free(((Stage*) Vec_get((*c)->stages, i))->result);
+    }
+    Vec_destroy(&(*c)->stages);
+    free(*c);
+    *c = NULL;
+}
+
+/**
+ * @brief Adds the given stage to the end of the given cursor's stages
+ */
+static bool add_stage(VecCursor* c, Stage const* stage)
+{
+    if (c->stages == NULL)
+    {
+        c->stages = Vec_new(4, sizeof(Stage));
+    }
+
+    bool const stage_added = c->stages != NULL &&
+                             Vec_append(c->stages, stage, sizeof(Stage));
+
+    assert(stage_added);
+    return stage_added;
+}
+
+bool VecCursor_filter(VecCursor* c,
+                      bool (*predicate)(void const*, size_t const, void*),
+                      void* context)
+{
+    assert(c != NULL);
+    assert(predicate != NULL);
+    if (c == NULL ||
+        predicate == NULL)
+    {
+        return false;
+    }
+
+    Stage const stage =
+    {
+        .predicate = predicate,
+        .fun = NULL,
+        .context = context,
+        .result = NULL,
+        .result_size = 0
+    };
+
+    return add_stage(c, &stage);
+}
+
+bool VecCursor_map(VecCursor* c,
+                   size_t const result_size,
+                   void (*fun)(void const* element, size_t const element_size,
+                               void* result, void* context),
+                   void* context)
+{
+    assert(c != NULL);
+    assert(result_size != 0);
+    assert(fun != NULL);
+    if (c == NULL ||
+        result_size == 0 ||
+        fun == NULL)
+    {
+        return false;
+    }
+
+    // The result goes here when a later stage needs it as input.
+    void* result = malloc(result_size);
+    bool const result_allocation_succeeded = (result != NULL);
+
+    assert(result_allocation_succeeded);
+    if (!result_allocation_succeeded)
+    {
+        return false;
+    }
+
+    Stage const stage =
+    {
+        .predicate = NULL,
+        .fun = fun,
+        .context = context,
+        .result = result,
+        .result_size = result_size
+    };
+
+    if (!add_stage(c, &stage))
+    {
+        free(result);
+        return false;
+    }
+    c->element_size = result_size;
+
+    return true;
+}
+
+size_t VecCursor_element_size(VecCursor const* c)
+{
+    assert(c != NULL);
+    if (c == NULL)
+    {
+        return 0;
+    }
+
+    return c->element_size;
+}
+
+size_t VecCursor_position(VecCursor const* c)
+{
+    assert(c != NULL);
+    if (c == NULL)
+    {
+        return 0;
+    }
+
+    return c->position;
+}
+
+bool VecCursor_seek(VecCursor* c, size_t const position)
+{
+    assert(c != NULL);
+    if (c == NULL)
+    {
+        return false;
+    }
+
+    assert(position <= Vec_count(c->v));
+    if (position > Vec_count(c->v))
+    {
+        return false;
+    }
+
+    c->position = position;
+
+    return true;
+}
+
+bool VecCursor_done(VecCursor const* c)
+{
+    assert(c != NULL);
+    if (c == NULL)
+    {
+        return true;
+    }
+
+    return c->position >= Vec_count(c->v);
+}
+
+size_t VecCursor_next(VecCursor* c,
+                      void* batch,
+                      size_t const k,
+                      size_t const element_size)
+{
+    assert(c != NULL);
+    assert(batch != NULL);
+    if (c == NULL ||
+        batch == NULL)
+    {
+        return 0;
+    }
+
+    assert(element_size == c->element_size);
+    if (element_size != c->element_size)
+    {
+        return 0;
+    }
+
+    // Re-read the vector, since it may have changed since the last call.
+    size_t const count = Vec_count(c->v);
+    size_t const source_size = Vec_element_size(c->v);
+    uint8_t const* source = (uint8_t const*) Vec_data(c->v);
+    uint8_t* slot = (uint8_t*) batch;
+
+    if (c->position >= count)
+    {
+        return 0;
+    }
+
+    // Without stages, the batch is just a run of the vector's elements.
+    if (stage_count(c) == 0)
+    {
+        size_t const produced = (count - c->position < k) ?
+                                count - c->position : k;
+
+        memcpy(slot, source + c->position * source_size,
+               produced * source_size);
+        c->position += produced;
+
+        return produced;
+    }
+
+    size_t produced = 0;
+
+    while (produced < k &&
+           c->position < count)
+    {
+        void const* out = run_stages(c,
+                                     source + c->position * source_size,
+                                     slot);
+
+        c->position += 1;
+        if (out == NULL)
+        {
+            continue;
+        }
+
+        if (out != slot)
+        {
+            memcpy(slot, out, element_size);
+        }
+        slot += element_size;
+        produced += 1;
+    }
+
+    return produced;
+}
+
+Vec* VecCursor_collect(VecCursor* c)
+{
+    assert(c != NULL);
+    if (c == NULL)
+    {
+        return NULL;
+    }
+
+    size_t const count = Vec_count(c->v);
+    size_t const source_size = Vec_element_size(c->v);
+    uint8_t const* source = (uint8_t const*) Vec_data(c->v);
+    size_t const remaining = (c->position < count) ? count - c->position : 0;
+    bool const staged = (stage_count(c) != 0);
+
+    // (Filters may let through far fewer, so this only sizes exactly if not.)
+    Vec* collected = Vec_new((!staged && remaining != 0) ? remaining : 16,
+                             c->element_size);
+    bool const vector_allocation_succeeded = (collected != NULL);
+
+    assert(vector_allocation_succeeded);
+    if (!vector_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    // Without stages, every remaining element goes in, in one copy.
+    if (!staged)
+    {
+        bool const copied = remaining == 0 ||
+                            Vec_append_n(collected,
+                                         source + c->position * source_size,
+                                         remaining,
+                                         source_size);
+
+        assert(copied);
+        if (!copied)
+        {
+            Vec_destroy(&collected);
+            return NULL;
+        }
+        c->position += remaining;
+
+        return collected;
+    }
+
+    // Otherwise, each element goes through every stage, then straight in.
+    void* slot = malloc(c->element_size);
+    bool const slot_allocation_succeeded = (slot != NULL);
+
+    assert(slot_allocation_succeeded);
+    if (!slot_allocation_succeeded)
+    {
+        Vec_destroy(&collected);
+        return NULL;
+    }
+
+    for (; c->position < count; ++c->position)
+    {
+        void const* out = run_stages(c,
+                                     source + c->position * source_size,
+                                     slot);
+
+        if (out == NULL)
+        {
+            continue;
+        }
+
+        bool const appended = Vec_append(collected, out, c->element_size);
+
+        assert(appended);
+        if (!appended)
+        {
+            free(slot);
+            Vec_destroy(&collected);
+            return NULL;
+        }
+    }
+    free(slot);
+
+    return collected;
+}
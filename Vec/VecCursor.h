@@ -0,0 +1,213 @@
+/**
+ * @file
+ * Cursors: resumable, batched iteration over a vector, through lazy filter and
+ * map stages
+ *
+ * `Vec_apply()` and `Vec_where_if()` go over a whole vector in one call. A
+ * cursor instead remembers where it is, so the caller can take the elements a
+ * batch at a time, stop, do something else, and pick up where it left off.
+ *
+ * A cursor can also filter and map the elements on the way out. The stages are
+ * lazy: nothing is done to an element until a batch reaches it, and each
+ * element goes through every stage before the next element is looked at. So a
+ * pipeline of stages, collected into a new vector, is one pass over the source,
+ * with no intermediate vectors between the stages.
+ *
+ * ```
+ * VecCursor* c = VecCursor_new(orders);
+ *
+ * VecCursor_filter(c, is_open, NULL);
+ * VecCursor_map(c, sizeof(double), to_total, &tax_rate);
+ *
+ * Vec* totals = VecCursor_collect(c); // One pass over `orders`
+ * ```
+ *
+ * A cursor reads its source vector as it goes (fetching the vector's elements
+ * anew on every call), so the source can be changed between calls; the cursor
+ * just resumes at the same index. The source must outlive the cursor.
+ */
+#ifndef VEC_CURSOR_H
+#define VEC_CURSOR_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The cursor struct, `typedef`'d so that its implementation details are
+ * encapsulated
+ */
+typedef struct VecCursor VecCursor;
+
+/**
+ * @brief Creates a new cursor at the start of the given vector, with no stages
+ *
+ * WARNING: This returns a dynamically allocated cursor that should eventually
+ * be destroyed with `VecCursor_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the vector pointer is null, or allocating memory for the
+ * cursor failed, internally.
+ *
+ * @param v The vector to iterate over
+ * @return A pointer to the newly-allocated cursor
+ */
+VecCursor* VecCursor_new(Vec const* v);
+
+/**
+ * @brief Destroys the given cursor (but not its vector), taking it as a double
+ * pointer so that it can null out the caller's single pointer to the cursor
+ * (for convenience)
+ *
+ * The double pointer or inner cursor pointer can be null, in which case this
+ * does nothing.
+ *
+ * @param c A double pointer to a cursor
+ */
+void VecCursor_destroy(VecCursor** c);
+
+/**
+ * @brief Adds a stage to the end of the given cursor's stages that only lets
+ * through the elements that satisfy the given predicate
+ *
+ * The predicate is called with the given context pointer, like with
+ * `Vec_where_if_ctx()`, and with the output of the stage before it (or, if it's
+ * the first stage, with the vector's elements).
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the cursor or predicate pointers are null, or allocating
+ * memory failed, internally. (The optional context pointer may be null,
+ * however.)
+ *
+ * @param c The cursor
+ * @param predicate A function that takes an element pointer, an element size,
+ * and the given context pointer, and returns whether to let the element through
+ * @param context An optional pointer to call the predicate with
+ * @return Whether the stage was added
+ */
+bool VecCursor_filter(VecCursor* c,
+                      bool (*predicate)(void const*, size_t const, void*),
+                      void* context);
+
+/**
+ * @brief Adds a stage to the end of the given cursor's stages that turns each
+ * element into a result of the given size
+ *
+ * The function is called with the output of the stage before it (or, if it's
+ * the first stage, with the vector's elements) and a pointer to where to put
+ * the result. From then on, the cursor's elements are the results.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the cursor or function pointers are null, the result size
+ * is 0, or allocating memory failed, internally. (The optional context pointer
+ * may be null, however.)
+ *
+ * @param c The cursor
+ * @param result_size The byte size of each result
+ * @param fun A function that takes an element pointer, an element size, a
+ * pointer to a result to fill in, and the given context pointer
+ * @param context An optional pointer to call the function with
+ * @return Whether the stage was added
+ */
+bool VecCursor_map(VecCursor* c,
+                   size_t const result_size,
+                   void (*fun)(void const* element, size_t const element_size,
+                               void* result, void* context),
+                   void* context);
+
+/**
+ * @brief Gets the byte size of the elements the given cursor produces (the
+ * result size of its last map stage, or else the vector's element size)
+ *
+ * If the cursor pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param c The cursor
+ * @return The byte size of the cursor's elements
+ */
+size_t VecCursor_element_size(VecCursor const* c);
+
+/**
+ * @brief Gets the index of the next element of the vector the given cursor
+ * will look at
+ *
+ * If the cursor pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param c The cursor
+ * @return The cursor's index into its vector
+ */
+size_t VecCursor_position(VecCursor const* c);
+
+/**
+ * @brief Moves the given cursor to the given index of its vector
+ *
+ * This fails, leaving the cursor where it was and returning false (or, if
+ * assertions are enabled, causing an assert crash), if the cursor pointer is
+ * null or the index is past the end of the vector.
+ *
+ * @param c The cursor
+ * @param position The index to move to (which may be the vector's count, to
+ * skip to the end)
+ * @return Whether the cursor moved
+ */
+bool VecCursor_seek(VecCursor* c, size_t const position);
+
+/**
+ * @brief Determines whether the given cursor has reached the end of its vector
+ *
+ * If the cursor pointer is null, this just returns true (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param c The cursor
+ * @return Whether there are no more elements to look at
+ */
+bool VecCursor_done(VecCursor const* c);
+
+/**
+ * @brief Advances the given cursor until it has produced the given number of
+ * elements (or reaches the end of its vector), copying them into the given
+ * batch
+ *
+ * The elements the stages filter out don't count toward the batch, so this may
+ * go over more of the vector than the batch size.
+ *
+ * This fails, leaving the cursor where it was and returning 0 (or, if
+ * assertions are enabled, causing an assert crash), if any of the following
+ * are true:
+ *     - The cursor or batch pointers are null
+ *     - The element size isn't the cursor's element size (see
+ *       `VecCursor_element_size()`)
+ *
+ * @param c The cursor
+ * @param batch An array of (at least) `k` elements to fill in
+ * @param k The most elements to produce
+ * @param element_size The byte size of each element in the batch
+ * @return How many elements were produced (which is fewer than `k` only if the
+ * cursor reached the end of its vector)
+ */
+size_t VecCursor_next(VecCursor* c,
+                      void* batch,
+                      size_t const k,
+                      size_t const element_size);
+
+/**
+ * @brief Advances the given cursor to the end of its vector, collecting every
+ * element it produces into a new vector, in one pass
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `Vec_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the cursor pointer is null, or allocating memory failed,
+ * internally. (If it fails partway, the cursor is left past the elements it
+ * collected before failing.)
+ *
+ * @param c The cursor
+ * @return A pointer to the new vector
+ */
+Vec* VecCursor_collect(VecCursor* c);
+
+#endif
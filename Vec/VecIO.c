@@ -0,0 +1,519 @@
+// For `read()`, `write()`, and `writev()` under strict C11
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "VecIO.h"
+
+/**
+ * @def
+ * The version of the saved vector format, which changes whenever the format
+ * does
+ */
+#define FORMAT_VERSION 1
+
+/**
+ * @brief The header that comes before a saved vector's elements
+ */
+typedef struct
+{
+    char magic[4]; // "Vec" and a null terminator
+    uint32_t version; // The `FORMAT_VERSION` the vector was saved with
+    uint64_t element_size; // The byte size of each element
+    uint64_t count; // The number of elements
+    uint64_t checksum; // The checksum of the elements
+} Header;
+
+_Static_assert(sizeof(Header) == VEC_IO_HEADER_SIZE,
+               "The header's layout doesn't match its advertised size");
+_Static_assert(VEC_IO_HEADER_SIZE % _Alignof(max_align_t) == 0,
+               "The header would misalign the elements after it");
+
+static char const MAGIC[4] = "Vec";
+
+/**
+ * @brief Mixes the given 8 bytes into the given checksum lane
+ */
+static uint64_t checksum_round(uint64_t lane, uint64_t const word)
+{
+    lane += word * UINT64_C(0xC2B2AE3D27D4EB4F);
+    lane = (lane << 31) | (lane >> 33);
+
+    return lane * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+/**
+ * @brief Computes the checksum of the given elements
+ *
+ * The bytes are mixed into four independent lanes, 32 at a time, so the
+ * multiplications overlap instead of waiting on each other, and the checksum
+ * keeps up with a fast disk. The lanes are then folded together, along with
+ * the element size and count, and the result goes through the SplitMix64
+ * finalizer.
+ *
+ * This catches corruption, not tampering: it's not a cryptographic hash.
+ *
+ * @param bytes The elements' bytes
+ * @param element_size The byte size of each element
+ * @param count The number of elements
+ * @return The checksum
+ */
+static uint64_t checksum(uint8_t const* bytes,
+                         size_t const element_size,
+                         size_t const count)
+{
+    size_t size = element_size * count;
+    uint64_t lanes[4] =
+    {
+        UINT64_C(0x9E3779B97F4A7C15),
+        UINT64_C(0xBF58476D1CE4E5B9),
+        UINT64_C(0x94D049BB133111EB),
+        UINT64_C(0xC2B2AE3D27D4EB4F)
+    };
+
+    for (; size >= sizeof(lanes); size -= sizeof(lanes))
+    {
+        for (size_t i = 0; i < 4; ++i)
+        {
+            uint64_t word;
+
+            memcpy(&word, bytes, sizeof(word));
+            lanes[i] = checksum_round(lanes[i], word);
+            bytes += sizeof(word);
+        }
+    }
+
+    // The last few bytes (if any) go into the first lane.
+    while (size > 0)
+    {
+        uint64_t word = 0;
+        size_t const chunk = (size < sizeof(word)) ? size : sizeof(word);
+
+        memcpy(&word, bytes, chunk);
+        lanes[0] = checksum_round(lanes[0], word);
+        bytes += chunk;
+        size -= chunk;
+    }
+
+    uint64_t sum = (uint64_t) element_size ^ ((uint64_t) count << 1);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        sum = checksum_round(sum, lanes[i]);
+    }
+    sum ^= sum >> 30;
+    sum *= UINT64_C(0xBF58476D1CE4E5B9);
+    sum ^= sum >> 27;
+    sum *= UINT64_C(0x94D049BB133111EB);
+    sum ^= sum >> 31;
+
+    return sum;
+}
+
+/**
+ * @brief Checks whether the given header is one this version can load, taking
+ * its element size and count out of it
+ * @param header The header
+ * @param element_size Where to put the element size
+ * @param count Where to put the element count
+ * @return Whether the header is valid
+ */
+static bool header_valid(Header const* header,
+                         size_t* element_size,
+                         size_t* count)
+{
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header->version != FORMAT_VERSION ||
+        header->element_size == 0 ||
+        (uint64_t) (size_t) header->element_size != header->element_size ||
+        (uint64_t) (size_t) header->count != header->count)
+    {
+        return false;
+    }
+
+    *element_size = (size_t) header->element_size;
+    *count = (size_t) header->count;
+
+    // The elements must fit in memory (and leave room for the header).
+    return *count <= (SIZE_MAX - VEC_IO_HEADER_SIZE) / *element_size;
+}
+
+/**
+ * @brief Reads exactly the given number of bytes from the given file
+ * descriptor, however many reads it takes
+ * @param fd The file descriptor
+ * @param bytes Where to read the bytes to
+ * @param size How many bytes to read
+ * @return Whether all the bytes were read (which they aren't if the file ends
+ * first)
+ */
+static bool read_all(int const fd, uint8_t* bytes, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t const got = read(fd, bytes, size);
+
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return false;
+        }
+        bytes += got;
+        size -= (size_t) got;
+    }
+
+    return true;
+}
+
+bool Vec_write(Vec const* v, int const fd)
+{
+    assert(v != NULL);
+    assert(fd >= 0);
+    if (v == NULL ||
+        fd < 0)
+    {
+        return false;
+    }
+
+    size_t const element_size = Vec_element_size(v);
+    size_t const count = Vec_count(v);
+    uint8_t const* data = (uint8_t const*) Vec_data(v);
+    Header header =
+    {
+        .version = FORMAT_VERSION,
+        .element_size = element_size,
+        .count = count,
+        .checksum = checksum(data, element_size, count)
+    };
+
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+
+    struct iovec pieces[2] =
+    {
+        { .iov_base = &header, .iov_len = sizeof(header) },
+        { .iov_base = (void*) data, .iov_len = count * element_size }
+    };
+    struct iovec* remaining = pieces;
+    int remaining_count = 2;
+
+    // Keep going after a short write, from wherever it stopped.
+    while (remaining_count > 0)
+    {
+        ssize_t written = writev(fd, remaining, remaining_count);
+
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        // (Nothing written at all means the file can't take any more.)
+        bool const write_succeeded = (written > 0);
+
+        assert(write_succeeded);
+        if (!write_succeeded)
+        {
+            return false;
+        }
+
+        while (remaining_count > 0 &&
+               (size_t) written >= remaining->iov_len)
+        {
+            written -= (ssize_t) remaining->iov_len;
+            ++remaining;
+            --remaining_count;
+        }
+        if (remaining_count > 0)
+        {
+            remaining->iov_base = (uint8_t*) remaining->iov_base + written;
+            remaining->iov_len -= (size_t) written;
+        }
+    }
+
+    return true;
+}
+
+Vec* Vec_read(int const fd, VecAllocator const* allocator)
+{
+    assert(fd >= 0);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    bool const valid_allocator = allocator == NULL ||
+                                 (allocator->allocate != NULL &&
+                                  allocator->reallocate != NULL &&
+                                  allocator->deallocate != NULL);
+
+    assert(valid_allocator);
+    if (!valid_allocator)
+    {
+        return NULL;
+    }
+
+    Header header;
+    size_t element_size = 0;
+    size_t count = 0;
+    bool const header_read =
+        read_all(fd, (uint8_t*) &header, sizeof(header)) &&
+        header_valid(&header, &element_size, &count);
+
+    assert(header_read);
+    if (!header_read)
+    {
+        return NULL;
+    }
+
+    // An empty vector still needs room for one element.
+    size_t const capacity = (count > 0) ? count : 1;
+    size_t const block_size = capacity * element_size;
+    VecAllocator const a = (allocator != NULL) ? *allocator
+                                               : Vec_default_allocator();
+    uint8_t* block = a.allocate(a.context, block_size);
+    bool const block_allocation_succeeded = (block != NULL);
+
+    assert(block_allocation_succeeded);
+    if (!block_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    bool const elements_read =
+        read_all(fd, block, count * element_size) &&
+        checksum(block, element_size, count) == header.checksum;
+    Vec* v = NULL;
+
+    assert(elements_read);
+    if (elements_read)
+    {
+        v = Vec_adopt(block, count, capacity, element_size, allocator);
+    }
+
+    if (v == NULL)
+    {
+        a.deallocate(a.context, block, block_size);
+    }
+
+    return v;
+}
+
+/**
+ * @brief The bookkeeping of a vector whose elements are in a saved-vector
+ * buffer it took over, after the buffer's header
+ */
+typedef struct
+{
+    VecAllocator upstream; // The allocator the buffer came from
+    uint8_t* buffer; // The buffer
+    size_t size; // The buffer's byte size
+    size_t blocks; // Allocations through the buffer that aren't freed yet
+} Buffer;
+
+/**
+ * @brief Allocates the given number of bytes from the buffer's allocator
+ * @param context The buffer
+ * @param size The byte size of the allocation
+ * @return The allocation, or a null pointer on failure
+ */
+static void* buffer_allocate(void* context, size_t size)
+{
+    Buffer* buffer = (Buffer*) context;
+    void* block = buffer->upstream.allocate(buffer->upstream.context, size);
+
+    if (block != NULL)
+    {
+        buffer->blocks++;
+    }
+
+    return block;
+}
+
+/**
+ * @brief Resizes the given allocation, which, if it's the elements, means
+ * resizing the whole buffer (keeping the elements after its header)
+ * @param context The buffer
+ * @param block The allocation to resize
+ * @param old_size The allocation's current byte size
+ * @param new_size The byte size to resize the allocation to
+ * @return The resized allocation, or a null pointer on failure
+ */
+static void* buffer_reallocate(void* context,
+                               void* block,
+                               size_t old_size,
+                               size_t new_size)
+{
+    Buffer* buffer = (Buffer*) context;
+    VecAllocator const* upstream = &buffer->upstream;
+
+    if (buffer->buffer == NULL ||
+        (uint8_t*) block != buffer->buffer + VEC_IO_HEADER_SIZE)
+    {
+        return upstream->reallocate(upstream->context,
+                                    block,
+                                    old_size,
+                                    new_size);
+    }
+
+    if (new_size > SIZE_MAX - VEC_IO_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    uint8_t* resized = upstream->reallocate(upstream->context,
+                                            buffer->buffer,
+                                            buffer->size,
+                                            VEC_IO_HEADER_SIZE + new_size);
+
+    if (resized == NULL)
+    {
+        return NULL;
+    }
+    buffer->buffer = resized;
+    buffer->size = VEC_IO_HEADER_SIZE + new_size;
+
+    return resized + VEC_IO_HEADER_SIZE;
+}
+
+/**
+ * @brief Frees the given allocation, which, if it's the elements, means freeing
+ * the whole buffer
+ *
+ * Copies of the vector (see `Vec_clone()`) get their memory through the
+ * buffer's allocator, too, so the buffer's bookkeeping is only freed once the
+ * buffer and every allocation made through it are freed, whichever vector goes
+ * last.
+ *
+ * @param context The buffer
+ * @param block The allocation to free
+ * @param size The allocation's byte size
+ */
+static void buffer_deallocate(void* context, void* block, size_t size)
+{
+    Buffer* buffer = (Buffer*) context;
+    VecAllocator const upstream = buffer->upstream;
+
+    if (buffer->buffer != NULL &&
+        (uint8_t*) block == buffer->buffer + VEC_IO_HEADER_SIZE)
+    {
+        upstream.deallocate(upstream.context, buffer->buffer, buffer->size);
+        buffer->buffer = NULL;
+    }
+    else
+    {
+        upstream.deallocate(upstream.context, block, size);
+        buffer->blocks--;
+    }
+
+    if (buffer->buffer == NULL &&
+        buffer->blocks == 0)
+    {
+        upstream.deallocate(upstream.context, buffer, sizeof(Buffer));
+    }
+}
+
+Vec* Vec_from_buffer(void* buffer,
+                     size_t const size,
+                     VecAllocator const* allocator)
+{
+    assert(buffer != NULL);
+    if (buffer == NULL)
+    {
+        return NULL;
+    }
+
+    bool const valid_allocator = allocator == NULL ||
+                                 (allocator->allocate != NULL &&
+                                  allocator->reallocate != NULL &&
+                                  allocator->deallocate != NULL);
+
+    assert(valid_allocator);
+    if (!valid_allocator)
+    {
+        return NULL;
+    }
+
+    VecAllocator const upstream = (allocator != NULL)
+                                  ? *allocator
+                                  : Vec_default_allocator();
+    uint8_t* bytes = (uint8_t*) buffer;
+    Header header = {0};
+    size_t element_size = 0;
+    size_t count = 0;
+
+    if (size >= sizeof(header))
+    {
+        memcpy(&header, bytes, sizeof(header));
+    }
+
+    bool const buffer_valid =
+        size >= sizeof(header) &&
+        header_valid(&header, &element_size, &count) &&
+        count * element_size <= size - sizeof(header) &&
+        checksum(bytes + sizeof(header), element_size, count) ==
+        header.checksum;
+
+    assert(buffer_valid);
+    if (!buffer_valid)
+    {
+        return NULL;
+    }
+
+    if (count == 0)
+    {
+        VecOptions const options = { .allocator = allocator };
+        Vec* v = Vec_new_with(1, element_size, &options);
+
+        if (v != NULL)
+        {
+            upstream.deallocate(upstream.context, buffer, size);
+        }
+        return v;
+    }
+
+    Buffer* taken = upstream.allocate(upstream.context, sizeof(Buffer));
+    bool const bookkeeping_allocation_succeeded = (taken != NULL);
+
+    assert(bookkeeping_allocation_succeeded);
+    if (!bookkeeping_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    taken->upstream = upstream;
+    taken->buffer = bytes;
+    taken->size = size;
+    taken->blocks = 0;
+
+    VecAllocator const buffer_allocator =
+    {
+        .allocate = buffer_allocate,
+        .reallocate = buffer_reallocate,
+        .deallocate = buffer_deallocate,
+        .context = taken
+    };
+
+    // Any room in the buffer after the elements is spare capacity.
+    Vec* v = Vec_adopt(bytes + sizeof(header),
+                       count,
+                       (size - sizeof(header)) / element_size,
+                       element_size,
+                       &buffer_allocator);
+
+    if (v == NULL)
+    {
+        upstream.deallocate(upstream.context, taken, sizeof(Buffer));
+        return NULL;
+    }
+
+    return v;
+}
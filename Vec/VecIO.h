@@ -0,0 +1,126 @@
+/**
+ * @file
+ * Saving vectors to, and loading them from, files (on POSIX systems)
+ *
+ * A saved vector is a small header followed by the vector's elements, exactly
+ * as they are in memory, so saving is one write of the whole data block, and
+ * loading is one read straight into a block of the right size. Either way,
+ * the elements move at the speed of the disk.
+ *
+ * ```
+ * Vec_write(v, fd); // Saves the vector
+ *
+ * Vec* copy = Vec_read(fd, NULL); // Loads it back (after seeking the file)
+ * ```
+ *
+ * The header records a format version, the element size, the element count,
+ * and a checksum of the elements, so a truncated or corrupted file, or one
+ * that isn't a saved vector at all, is rejected rather than loaded.
+ *
+ * NOTE: The header and elements are saved in the machine's own byte order and
+ * layout, so a saved vector is only meant to be loaded on the same kind of
+ * machine (e.g., for snapshots of state, not data exchange).
+ */
+#ifndef VEC_IO_H
+#define VEC_IO_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @def
+ * The byte size of a saved vector's header, which comes before its elements
+ *
+ * The header's size is a multiple of the alignment of any type, so a saved
+ * vector's elements are as aligned within a buffer as the buffer itself.
+ */
+#define VEC_IO_HEADER_SIZE 32
+
+/**
+ * @brief Saves the given vector to the given file descriptor (at its current
+ * position), as a header followed by the vector's elements
+ *
+ * The header and elements are written together with `writev()`, so a vector
+ * is saved with one system call (unless the OS writes it in pieces, in which
+ * case this keeps writing until it's all written).
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The vector pointer is null, or the file descriptor is negative
+ *     - Writing failed, internally (in which case part of the vector may have
+ *       been written)
+ *
+ * @param v The vector to save
+ * @param fd The file descriptor to write to
+ * @return Whether the vector was saved
+ */
+bool Vec_write(Vec const* v, int const fd);
+
+/**
+ * @brief Loads a vector saved by `Vec_write()` from the given file descriptor
+ * (at its current position), reading its elements straight into the new
+ * vector's data block
+ *
+ * The vector gets exactly as much capacity as it has elements (or 1, if it has
+ * none).
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `Vec_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The file descriptor is negative
+ *     - The allocator (if given) doesn't have every function
+ *     - What's read isn't a saved vector of this version, or is cut short, or
+ *       its elements don't match its checksum
+ *     - Reading, or allocating memory for the vector, failed, internally
+ *
+ * @param fd The file descriptor to read from
+ * @param allocator The allocator to allocate the vector with (or a null pointer
+ * for `malloc()`)
+ * @return A pointer to the newly-loaded vector
+ */
+Vec* Vec_read(int const fd, VecAllocator const* allocator);
+
+/**
+ * @brief Turns the given buffer, holding a vector saved by `Vec_write()`
+ * (e.g., read from a file or received over a network), into a vector without
+ * copying the elements: the vector takes the buffer over, and its elements
+ * stay where they are in it
+ *
+ * The buffer must have come from the given allocator (or, if it's a null
+ * pointer, from `malloc()`), which the vector then frees it with. The
+ * buffer stays the vector's storage, with the elements after the header, and
+ * any room left after the elements as spare capacity; growing the vector past
+ * that reallocates the whole buffer.
+ *
+ * An empty saved vector has no elements to keep in the buffer, so the buffer
+ * is freed right away, and the new vector allocates a block of its own.
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `Vec_destroy()`. Once this succeeds, the buffer belongs to
+ * the vector, and must not be used or freed by the caller anymore! (If this
+ * fails, though, the buffer still belongs to the caller.) The vector must not
+ * be released with `Vec_release()`, either.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The buffer pointer is null
+ *     - The allocator (if given) doesn't have every function
+ *     - The buffer doesn't hold a saved vector of this version, or is smaller
+ *       than the saved vector, or its elements don't match its checksum
+ *     - Allocating memory for the vector failed, internally
+ *
+ * @param buffer The buffer holding the saved vector
+ * @param size The buffer's byte size
+ * @param allocator The allocator the buffer came from (or a null pointer for
+ * `malloc()`)
+ * @return A pointer to the new vector
+ */
+Vec* Vec_from_buffer(void* buffer,
+                     size_t const size,
+                     VecAllocator const* allocator);
+
+#endif
@@ -0,0 +1,512 @@
+// For `mremap()` on Linux (and the POSIX functions under strict C11)
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "VecMmap.h"
+
+typedef struct
+{
+    int fd; // The mapped file
+    unsigned flags; // The `VecMmapFlags` the file was opened with
+    bool file_backed; // Whether the mapping is of the file (not anonymous)
+    uint8_t* base; // The mapping, which is the vector's data block
+    size_t size; // The mapping's byte size
+    Vec* v; // The vector the mapping belongs to (until its struct is freed)
+    size_t blocks; // Allocations through the mapping that aren't freed yet
+} Mapping;
+
+/**
+ * @brief Gets the `madvise()` advice for the given flags' access hint
+ * @param flags The flags
+ * @return The advice
+ */
+static int flags_advice(unsigned const flags)
+{
+    if (flags & VEC_MMAP_SEQUENTIAL)
+    {
+        return MADV_SEQUENTIAL;
+    }
+    if (flags & VEC_MMAP_RANDOM)
+    {
+        return MADV_RANDOM;
+    }
+
+    return MADV_NORMAL;
+}
+
+/**
+ * @brief Maps the given number of bytes of the given mapping's file, with the
+ * protection and sharing of the mapping's mode
+ * @param mapping The mapping
+ * @param size The byte size to map
+ * @return The new mapping, or a null pointer on failure
+ */
+static uint8_t* map_file(Mapping const* mapping, size_t const size)
+{
+    int const protection = (mapping->flags & VEC_MMAP_READ_ONLY)
+                           ? PROT_READ
+                           : PROT_READ | PROT_WRITE;
+    int const sharing = (mapping->flags & VEC_MMAP_COPY_ON_WRITE)
+                        ? MAP_PRIVATE
+                        : MAP_SHARED;
+    void* mapped = mmap(NULL, size, protection, sharing, mapping->fd, 0);
+
+    return (mapped != MAP_FAILED) ? (uint8_t*) mapped : NULL;
+}
+
+/**
+ * @brief Maps the given number of bytes of (zeroed, private) memory that
+ * belongs to no file
+ * @param size The byte size to map
+ * @return The new mapping, or a null pointer on failure
+ */
+static uint8_t* map_anonymous(size_t const size)
+{
+    void* mapped = mmap(NULL,
+                        size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+
+    return (mapped != MAP_FAILED) ? (uint8_t*) mapped : NULL;
+}
+
+/**
+ * @brief Resizes the given mapping of its file (which must already be at
+ * least the new size), moving it if it can't be resized where it is
+ * @param mapping The mapping
+ * @param new_size The byte size to resize the mapping to
+ * @return The resized mapping, or a null pointer on failure (in which case the
+ * old mapping is left alone)
+ */
+static uint8_t* remap_file(Mapping const* mapping, size_t const new_size)
+{
+#if defined(__linux__)
+    // The kernel moves the mapping's pages, if need be, without copying them.
+    void* remapped = mremap(mapping->base,
+                            mapping->size,
+                            new_size,
+                            MREMAP_MAYMOVE);
+
+    return (remapped != MAP_FAILED) ? (uint8_t*) remapped : NULL;
+#else
+    // Elsewhere, map the file anew; its contents are still in the page cache.
+    uint8_t* remapped = map_file(mapping, new_size);
+
+    if (remapped != NULL)
+    {
+        munmap(mapping->base, mapping->size);
+    }
+
+    return remapped;
+#endif
+}
+
+/**
+ * @brief Allocates the given number of bytes for anything other than the
+ * elements of the mapped vector (which are the mapping itself)
+ * @param context The mapping
+ * @param size The byte size of the allocation
+ * @return The allocation, or a null pointer on failure
+ */
+static void* mmap_allocate(void* context, size_t size)
+{
+    Mapping* mapping = (Mapping*) context;
+    void* block = malloc(size);
+
+    if (block != NULL)
+    {
+        mapping->blocks++;
+    }
+
+    return block;
+}
+
+/**
+ * @brief Resizes the given allocation, which, if it's the mapping, means
+ * resizing the file (read-write mode) or moving to anonymous memory
+ * (copy-on-write mode) along with it
+ * @param context The mapping
+ * @param block The allocation to resize
+ * @param old_size The allocation's current byte size
+ * @param new_size The byte size to resize the allocation to
+ * @return The resized allocation, or a null pointer on failure
+ */
+static void* mmap_reallocate(void* context,
+                             void* block,
+                             size_t old_size,
+                             size_t new_size)
+{
+    Mapping* mapping = (Mapping*) context;
+
+    if ((uint8_t*) block != mapping->base)
+    {
+        return realloc(block, new_size);
+    }
+
+    if (mapping->flags & VEC_MMAP_READ_ONLY)
+    {
+        return NULL; // The file can't change, so neither can the mapping.
+    }
+
+    uint8_t* resized = NULL;
+
+    if (mapping->flags & VEC_MMAP_COPY_ON_WRITE)
+    {
+        /*
+         * Growing a private mapping past the end of the file would map pages
+         * that aren't there, so the elements move to anonymous memory instead,
+         * leaving the file behind.
+         */
+        resized = map_anonymous(new_size);
+        if (resized == NULL)
+        {
+            return NULL;
+        }
+        memcpy(resized, mapping->base, old_size < new_size ? old_size
+                                                           : new_size);
+        munmap(mapping->base, mapping->size);
+        mapping->file_backed = false;
+    }
+    else
+    {
+        // The file has to cover the whole mapping before it's grown.
+        if (new_size > old_size &&
+            ftruncate(mapping->fd, (off_t) new_size) != 0)
+        {
+            return NULL;
+        }
+
+        resized = remap_file(mapping, new_size);
+        if (resized == NULL)
+        {
+            if (new_size > old_size)
+            {
+                // Put the file back the way it was.
+                (void) ftruncate(mapping->fd, (off_t) old_size);
+            }
+            return NULL;
+        }
+
+        if (new_size < old_size)
+        {
+            // Whether or not the file shrinks, the mapping already did.
+            (void) ftruncate(mapping->fd, (off_t) new_size);
+        }
+    }
+
+    mapping->base = resized;
+    mapping->size = new_size;
+    (void) madvise(mapping->base, mapping->size, flags_advice(mapping->flags));
+
+    return resized;
+}
+
+/**
+ * @brief Unmaps the given mapping and closes its file, cutting a read-write
+ * file down to the vector's elements first
+ * @param mapping The mapping
+ */
+static void unmap(Mapping* mapping)
+{
+    bool const writing_back =
+        mapping->file_backed &&
+        !(mapping->flags & (VEC_MMAP_READ_ONLY | VEC_MMAP_COPY_ON_WRITE)) &&
+        mapping->v != NULL;
+    size_t const bytes = writing_back ? Vec_count(mapping->v) *
+                                        Vec_element_size(mapping->v)
+                                      : 0;
+
+    // Elements popped off the front leave the rest later in the mapping.
+    if (writing_back &&
+        bytes > 0 &&
+        (uint8_t*) Vec_data(mapping->v) != mapping->base)
+    {
+        memmove(mapping->base, Vec_data(mapping->v), bytes);
+    }
+    munmap(mapping->base, mapping->size);
+
+    if (writing_back)
+    {
+        (void) ftruncate(mapping->fd, (off_t) bytes);
+    }
+
+    close(mapping->fd);
+    mapping->base = NULL;
+    mapping->size = 0;
+}
+
+/**
+ * @brief Frees the given allocation, which, if it's the mapping, means
+ * unmapping it
+ *
+ * Copies of the vector (see `Vec_clone()`) get their memory through the
+ * mapping's allocator, too, so the mapping's bookkeeping is only freed once
+ * it's unmapped and every allocation made through it is freed, whichever
+ * vector goes last.
+ *
+ * @param context The mapping
+ * @param block The allocation to free
+ * @param size The allocation's byte size
+ */
+static void mmap_deallocate(void* context, void* block, size_t size)
+{
+    Mapping* mapping = (Mapping*) context;
+
+    (void) size;
+    if (mapping->base != NULL &&
+        (uint8_t*) block == mapping->base)
+    {
+        unmap(mapping);
+    }
+    else
+    {
+        if ((Vec*) block == mapping->v)
+        {
+            mapping->v = NULL;
+        }
+        free(block);
+        mapping->blocks--;
+    }
+
+    if (mapping->base == NULL &&
+        mapping->blocks == 0)
+    {
+        free(mapping);
+    }
+}
+
+/**
+ * @brief Gets the mapping of the given vector
+ * @param v The vector
+ * @return The mapping, or a null pointer if the vector isn't mapped (including
+ * if it's a copy of a mapped vector)
+ */
+static Mapping* vector_mapping(Vec const* v)
+{
+    VecAllocator const allocator = Vec_allocator(v);
+
+    if (allocator.deallocate != mmap_deallocate)
+    {
+        return NULL;
+    }
+
+    Mapping* mapping = (Mapping*) allocator.context;
+
+    return (mapping->v == v && mapping->base != NULL) ? mapping : NULL;
+}
+
+Vec* Vec_open_mmap(char const* path,
+                   size_t const element_size,
+                   unsigned const flags)
+{
+    assert(path != NULL);
+    assert(element_size != 0);
+    if (path == NULL ||
+        element_size == 0)
+    {
+        return NULL;
+    }
+
+    unsigned const modes = VEC_MMAP_READ_ONLY | VEC_MMAP_COPY_ON_WRITE;
+    unsigned const hints = VEC_MMAP_SEQUENTIAL | VEC_MMAP_RANDOM;
+    bool const valid_flags =
+        (flags & modes) != modes &&
+        (flags & hints) != hints &&
+        !((flags & VEC_MMAP_CREATE) && (flags & modes));
+
+    assert(valid_flags);
+    if (!valid_flags)
+    {
+        return NULL;
+    }
+
+    bool const writable_file = !(flags & modes);
+    int const fd = open(path,
+                        writable_file
+                        ? O_RDWR | ((flags & VEC_MMAP_CREATE) ? O_CREAT : 0)
+                        : O_RDONLY,
+                        0666);
+    struct stat file_stat;
+    bool const file_opened = fd >= 0 && fstat(fd, &file_stat) == 0;
+
+    assert(file_opened);
+    if (!file_opened)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return NULL;
+    }
+
+    size_t const file_size = (size_t) file_stat.st_size;
+    bool const file_valid =
+        file_size % element_size == 0 &&
+        !(file_size == 0 && (flags & VEC_MMAP_READ_ONLY));
+
+    assert(file_valid);
+    if (!file_valid)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    Mapping* mapping = malloc(sizeof(Mapping));
+    bool const mapping_allocation_succeeded = (mapping != NULL);
+
+    assert(mapping_allocation_succeeded);
+    if (!mapping_allocation_succeeded)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    mapping->fd = fd;
+    mapping->flags = flags;
+    mapping->file_backed = true;
+    mapping->v = NULL;
+    mapping->blocks = 0;
+
+    /*
+     * An empty file has nothing to map, but a vector needs room for at least
+     * one element: a read-write file is extended to one element, and a
+     * copy-on-write vector starts out in anonymous memory.
+     */
+    mapping->size = (file_size > 0) ? file_size : element_size;
+    if (file_size > 0)
+    {
+        mapping->base = map_file(mapping, mapping->size);
+    }
+    else if (writable_file)
+    {
+        mapping->base = (ftruncate(fd, (off_t) mapping->size) == 0)
+                        ? map_file(mapping, mapping->size)
+                        : NULL;
+    }
+    else
+    {
+        mapping->base = map_anonymous(mapping->size);
+        mapping->file_backed = false;
+    }
+
+    bool const file_mapped = (mapping->base != NULL);
+
+    assert(file_mapped);
+    if (!file_mapped)
+    {
+        if (writable_file && file_size == 0)
+        {
+            (void) ftruncate(fd, 0);
+        }
+        close(fd);
+        free(mapping);
+        return NULL;
+    }
+
+    (void) madvise(mapping->base, mapping->size, flags_advice(flags));
+
+    VecAllocator const allocator =
+    {
+        .allocate = mmap_allocate,
+        .reallocate = mmap_reallocate,
+        .deallocate = mmap_deallocate,
+        .context = mapping
+    };
+    Vec* v = Vec_adopt(mapping->base,
+                       file_size / element_size,
+                       mapping->size / element_size,
+                       element_size,
+                       &allocator);
+
+    if (v == NULL)
+    {
+        unmap(mapping);
+        free(mapping);
+        return NULL;
+    }
+    mapping->v = v;
+
+    return v;
+}
+
+bool Vec_advise_mmap(Vec const* v, VecMmapAdvice const advice)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    Mapping const* mapping = vector_mapping(v);
+
+    assert(mapping != NULL);
+    if (mapping == NULL)
+    {
+        return false;
+    }
+
+    int advised = MADV_NORMAL;
+
+    switch (advice)
+    {
+        case VEC_MMAP_ADVICE_SEQUENTIAL:
+            advised = MADV_SEQUENTIAL;
+            break;
+        case VEC_MMAP_ADVICE_RANDOM:
+            advised = MADV_RANDOM;
+            break;
+        case VEC_MMAP_ADVICE_WILL_NEED:
+            advised = MADV_WILLNEED;
+            break;
+        case VEC_MMAP_ADVICE_NORMAL:
+        default:
+            break;
+    }
+
+    /*
+     * (The vector's data isn't necessarily the start of the mapping, which
+     * `madvise()` needs to be page-aligned, since elements popped off the
+     * front leave room before it.)
+     */
+    bool const hint_given =
+        madvise(mapping->base, mapping->size, advised) == 0;
+
+    assert(hint_given);
+
+    return hint_given;
+}
+
+bool Vec_sync_mmap(Vec const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    Mapping const* mapping = vector_mapping(v);
+
+    assert(mapping != NULL);
+    if (mapping == NULL)
+    {
+        return false;
+    }
+
+    bool const synced = msync(mapping->base, mapping->size, MS_SYNC) == 0;
+
+    assert(synced);
+
+    return synced;
+}
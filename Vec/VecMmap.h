@@ -0,0 +1,174 @@
+/**
+ * @file
+ * Vectors whose elements live in a memory-mapped file (on POSIX systems)
+ *
+ * A mapped vector's data block IS the file's contents, mapped into memory, so
+ * opening even a huge file takes no time and no copying: the OS reads the
+ * file's pages in as the elements are accessed, and can drop them again under
+ * memory pressure, so the file can be bigger than RAM. Otherwise, the vector
+ * works like any other, through the same vector functions.
+ *
+ * ```
+ * Vec* v = Vec_open_mmap("snapshot.bin", sizeof(Record), VEC_MMAP_CREATE);
+ *
+ * Vec_append(v, &record, sizeof(Record)); // Grows the file
+ * Vec_destroy(&v); // Unmaps the file (which keeps the elements)
+ * ```
+ *
+ * The file holds the elements and nothing else, i.e., a file of N bytes is a
+ * vector of N / element size elements.
+ *
+ * In the default (read-write) mode, changes to the elements are changes to the
+ * file. When the vector outgrows the file, the file is extended, and the
+ * mapping is grown in place (or moved, without copying, where it can't grow in
+ * place). When the vector is destroyed, the file is cut down to the vector's
+ * elements (since the vector's spare capacity is part of the file while it's
+ * mapped).
+ *
+ * A mapped vector's allocator (see `VecOptions`) manages the mapping, and
+ * hands out everything else (like the vector struct itself) from `malloc()`.
+ */
+#ifndef VEC_MMAP_H
+#define VEC_MMAP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @enum
+ * How a file is mapped into a vector (combined with `|`)
+ *
+ * Without any flags, an existing file is mapped for reading and writing.
+ */
+typedef enum VecMmapFlags
+{
+    /**
+     * The file is mapped for reading only
+     *
+     * WARNING: Adding elements to a read-only vector fails (since the file
+     * can't grow), but functions that modify or remove elements write to the
+     * mapping, which crashes the program (like writing to any other read-only
+     * memory)! Only use read-only vectors with functions that don't modify the
+     * vector (e.g., `Vec_get()`, `Vec_where()`).
+     */
+    VEC_MMAP_READ_ONLY = 1 << 0,
+
+    /**
+     * The file is mapped copy-on-write: the vector can be modified (and grown)
+     * like any other, but its changes stay in memory and never reach the file
+     */
+    VEC_MMAP_COPY_ON_WRITE = 1 << 1,
+
+    /**
+     * The file is created (empty) if it doesn't exist (read-write mode only)
+     */
+    VEC_MMAP_CREATE = 1 << 2,
+
+    /**
+     * The elements will mostly be scanned in order (e.g., by `Vec_apply()` or
+     * `Vec_where_if()`), so the OS should read ahead aggressively, and can drop
+     * pages soon after they're scanned
+     */
+    VEC_MMAP_SEQUENTIAL = 1 << 3,
+
+    /**
+     * The elements will mostly be accessed in no particular order, so the OS
+     * shouldn't bother reading ahead
+     */
+    VEC_MMAP_RANDOM = 1 << 4
+} VecMmapFlags;
+
+/**
+ * @enum
+ * A hint to the OS about how a mapped vector's elements will be accessed
+ */
+typedef enum VecMmapAdvice
+{
+    /**
+     * No particular access pattern (the default)
+     */
+    VEC_MMAP_ADVICE_NORMAL = 0,
+
+    /**
+     * In order, like `VEC_MMAP_SEQUENTIAL`
+     */
+    VEC_MMAP_ADVICE_SEQUENTIAL,
+
+    /**
+     * In no particular order, like `VEC_MMAP_RANDOM`
+     */
+    VEC_MMAP_ADVICE_RANDOM,
+
+    /**
+     * Soon, so the OS should start reading the whole file in now
+     */
+    VEC_MMAP_ADVICE_WILL_NEED
+} VecMmapAdvice;
+
+/**
+ * @brief Opens the given file as a vector of elements of the given size, with
+ * the file memory-mapped as the vector's data block
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `Vec_destroy()`, which also unmaps and closes the file.
+ * Until then, the file shouldn't be modified (or, especially, truncated) by
+ * anything else. A mapped vector must not be released with `Vec_release()`.
+ *
+ * A copy of a mapped vector (see `Vec_clone()`) gets its elements from
+ * `malloc()`, not the file, and can outlive the original.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The path pointer is null, or the element size is 0
+ *     - The flags combine read-only and copy-on-write modes, sequential and
+ *       random hints, or creating with a mode other than read-write
+ *     - The file's size isn't a multiple of the element size
+ *     - The file is empty, and the mode is read-only (there's nothing to map)
+ *     - Opening or mapping the file, or allocating memory for the vector,
+ *       failed, internally
+ *
+ * @param path The path of the file to open
+ * @param element_size The byte size of each element in the vector
+ * @param flags `VecMmapFlags` combined with `|` (or 0 for the defaults)
+ * @return A pointer to the newly-opened vector
+ */
+Vec* Vec_open_mmap(char const* path,
+                   size_t const element_size,
+                   unsigned const flags);
+
+/**
+ * @brief Hints to the OS how the elements of the given mapped vector will be
+ * accessed from now on (e.g., before a full scan of them)
+ *
+ * The hint only affects performance, never the elements.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector pointer is null, the vector wasn't opened with
+ * `Vec_open_mmap()` (which includes copies of mapped vectors, whose elements
+ * aren't mapped), or the OS rejected the hint.
+ *
+ * @param v The mapped vector
+ * @param advice How the elements will be accessed
+ * @return Whether the hint was given
+ */
+bool Vec_advise_mmap(Vec const* v, VecMmapAdvice const advice);
+
+/**
+ * @brief Writes the elements of the given (read-write) mapped vector through
+ * to its file, and waits for the write to complete
+ *
+ * Changes to a read-write vector reach its file eventually in any case. This
+ * makes sure they have, so the file is complete even if the system crashes.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector pointer is null, the vector wasn't opened with
+ * `Vec_open_mmap()` (like with `Vec_advise_mmap()`), or the write failed.
+ *
+ * @param v The mapped vector
+ * @return Whether the elements were written to the file
+ */
+bool Vec_sync_mmap(Vec const* v);
+
+#endif
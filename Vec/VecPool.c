@@ -0,0 +1,318 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "VecPool.h"
+
+/**
+ * @def
+ * The byte size of the smallest size class
+ */
+#define POOL_MIN_CLASS_SIZE ((size_t) 16)
+
+/**
+ * @def
+ * The number of size classes, each twice the size of the one before it (so
+ * the biggest is `POOL_MIN_CLASS_SIZE << (POOL_CLASS_COUNT - 1)`, 32 KiB)
+ */
+#define POOL_CLASS_COUNT 12
+
+/**
+ * @def
+ * The byte size of the data of each slab that blocks are carved out of
+ */
+#define POOL_SLAB_SIZE ((size_t) 64 * 1024)
+
+// Blocks carved out of slabs have to be aligned for any type.
+_Static_assert(POOL_MIN_CLASS_SIZE % _Alignof(max_align_t) == 0,
+               "The smallest size class must keep blocks aligned");
+
+typedef struct PoolSlab PoolSlab;
+struct PoolSlab
+{
+    PoolSlab* next; // The slab allocated before this one
+    max_align_t data[]; // The slab's data (`max_align_t` for its alignment)
+};
+
+typedef struct PoolBlock PoolBlock;
+struct PoolBlock
+{
+    PoolBlock* next; // The next free block of the same size class
+};
+
+struct VecPool
+{
+    PoolBlock* free_lists[POOL_CLASS_COUNT]; // Free blocks, per size class
+    size_t free_bytes; // Total size of the blocks on the free lists
+    PoolSlab* slabs; // The slab being carved up, and all before it
+    size_t slab_used; // Number of bytes carved out of the current slab
+};
+
+/**
+ * @brief Gets the byte size of the blocks of the given size class
+ * @param class_index The size class
+ * @return The byte size of the class's blocks
+ */
+static size_t class_size(size_t const class_index)
+{
+    return POOL_MIN_CLASS_SIZE << class_index;
+}
+
+/**
+ * @brief Finds the smallest size class whose blocks fit the given size
+ * @param size The byte size to fit
+ * @return The size class, or `POOL_CLASS_COUNT` if the size's too big for any
+ */
+static size_t class_of(size_t const size)
+{
+    size_t class_index = 0;
+
+    while (class_index < POOL_CLASS_COUNT &&
+           class_size(class_index) < size)
+    {
+        ++class_index;
+    }
+
+    return class_index;
+}
+
+VecPool* VecPool_new(void)
+{
+    VecPool* pool = malloc(sizeof(VecPool));
+    bool const pool_allocation_succeeded = (pool != NULL);
+
+    assert(pool_allocation_succeeded);
+    if (!pool_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < POOL_CLASS_COUNT; ++i)
+    {
+        pool->free_lists[i] = NULL;
+    }
+    pool->free_bytes = 0;
+    pool->slabs = NULL;
+    pool->slab_used = POOL_SLAB_SIZE; // No slab yet, so none with room
+
+    return pool;
+}
+
+void VecPool_destroy(VecPool** pool)
+{
+    if (pool == NULL ||
+        (*pool) == NULL)
+    {
+        return;
+    }
+
+    PoolSlab* slab = (*pool)->slabs;
+
+    while (slab != NULL)
+    {
+        PoolSlab* next = slab->next;
+
+        free(slab);
+        slab = next;
+    }
+
+    free(*pool);
+    *pool = NULL;
+}
+
+size_t VecPool_free_bytes(VecPool const* pool)
+{
+    assert(pool != NULL);
+    if (pool == NULL)
+    {
+        return 0;
+    }
+
+    return pool->free_bytes;
+}
+
+/**
+ * @brief Gets a block of the given size class, from the class's free list if
+ * it has one, or else carved out of the pool's current slab
+ * @param pool The pool
+ * @param class_index The size class
+ * @return The block, or a null pointer on failure
+ */
+static void* class_allocate(VecPool* pool, size_t const class_index)
+{
+    size_t const size = class_size(class_index);
+    PoolBlock* block = pool->free_lists[class_index];
+
+    if (block != NULL)
+    {
+        pool->free_lists[class_index] = block->next;
+        pool->free_bytes -= size;
+
+        return block;
+    }
+
+    if (POOL_SLAB_SIZE - pool->slab_used < size)
+    {
+        // The current slab's used up, so start carving up a new one.
+        PoolSlab* slab = malloc(sizeof(PoolSlab) + POOL_SLAB_SIZE);
+
+        if (slab == NULL)
+        {
+            return NULL;
+        }
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->slab_used = 0;
+    }
+
+    uint8_t* carved = (uint8_t*) pool->slabs->data + pool->slab_used;
+
+    pool->slab_used += size;
+
+    return carved;
+}
+
+/**
+ * @brief Puts the given block onto the free list of the given size class
+ * @param pool The pool
+ * @param block The block
+ * @param class_index The size class
+ */
+static void class_deallocate(VecPool* pool,
+                             void* block,
+                             size_t const class_index)
+{
+    PoolBlock* freed = (PoolBlock*) block;
+
+    freed->next = pool->free_lists[class_index];
+    pool->free_lists[class_index] = freed;
+    pool->free_bytes += class_size(class_index);
+}
+
+/**
+ * @brief Allocates the given number of bytes from the pool given as context
+ * @param context The pool
+ * @param size The byte size of the allocation
+ * @return The allocation, or a null pointer on failure
+ */
+static void* pool_allocate(void* context, size_t size)
+{
+    VecPool* pool = (VecPool*) context;
+
+    if (pool == NULL ||
+        size == 0)
+    {
+        return NULL;
+    }
+
+    size_t const class_index = class_of(size);
+
+    if (class_index == POOL_CLASS_COUNT)
+    {
+        return malloc(size); // Too big for any size class
+    }
+
+    return class_allocate(pool, class_index);
+}
+
+/**
+ * @brief Resizes the given allocation from the pool given as context
+ *
+ * An allocation that stays in the same size class isn't moved at all.
+ *
+ * @param context The pool
+ * @param block The allocation to resize
+ * @param old_size The allocation's current byte size
+ * @param new_size The byte size to resize the allocation to
+ * @return The resized allocation, or a null pointer on failure
+ */
+static void* pool_reallocate(void* context,
+                             void* block,
+                             size_t old_size,
+                             size_t new_size)
+{
+    VecPool* pool = (VecPool*) context;
+
+    if (pool == NULL ||
+        new_size == 0)
+    {
+        return NULL;
+    }
+
+    if (block == NULL)
+    {
+        return pool_allocate(context, new_size);
+    }
+
+    size_t const old_class = class_of(old_size);
+    size_t const new_class = class_of(new_size);
+
+    if (old_class == new_class)
+    {
+        // Either it still fits its block, or it's big enough for `realloc()`.
+        return old_class == POOL_CLASS_COUNT ? realloc(block, new_size) : block;
+    }
+
+    void* moved = pool_allocate(context, new_size);
+
+    if (moved == NULL)
+    {
+        return NULL;
+    }
+    memcpy(moved, block, old_size < new_size ? old_size : new_size);
+
+    if (old_class == POOL_CLASS_COUNT)
+    {
+        free(block);
+    }
+    else
+    {
+        class_deallocate(pool, block, old_class);
+    }
+
+    return moved;
+}
+
+/**
+ * @brief Gives back the given allocation to the pool given as context
+ * @param context The pool
+ * @param block The allocation to give back
+ * @param size The allocation's byte size
+ */
+static void pool_deallocate(void* context, void* block, size_t size)
+{
+    VecPool* pool = (VecPool*) context;
+
+    if (pool == NULL ||
+        block == NULL)
+    {
+        return;
+    }
+
+    size_t const class_index = class_of(size);
+
+    if (class_index == POOL_CLASS_COUNT)
+    {
+        free(block);
+    }
+    else
+    {
+        class_deallocate(pool, block, class_index);
+    }
+}
+
+VecAllocator VecPool_allocator(VecPool* pool)
+{
+    assert(pool != NULL);
+
+    VecAllocator const allocator =
+    {
+        .allocate = pool_allocate,
+        .reallocate = pool_reallocate,
+        .deallocate = pool_deallocate,
+        .context = pool
+    };
+
+    return allocator;
+}
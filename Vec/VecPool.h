@@ -0,0 +1,99 @@
+/**
+ * @file
+ * A size-class ("pool") allocator usable as a vector's allocator
+ *
+ * A pool sorts allocations into a fixed set of size classes (powers of two,
+ * from 16 bytes up to 32 KiB) and keeps a free list of blocks per class. Blocks
+ * are carved out of big slabs that the pool gets from `malloc()`, and blocks
+ * that are given back go onto their class's free list to be handed out again.
+ * Allocations bigger than the biggest class go straight to `malloc()`.
+ *
+ * Since a vector's capacity grows by doubling (by default), its data block
+ * moves up one size class at a time, and the block it leaves behind is there
+ * for the next vector of that size. This suits a thread that keeps creating and
+ * destroying vectors of similar sizes. Giving each thread its own pool keeps
+ * threads from contending over a shared `malloc()`.
+ *
+ * ```
+ * VecPool* pool = VecPool_new();
+ * VecAllocator const allocator = VecPool_allocator(pool);
+ * VecOptions const options = { .allocator = &allocator };
+ * Vec* v = Vec_new_with(16, sizeof(int64_t), &options);
+ *
+ * // ...use the vector...
+ *
+ * Vec_destroy(&v); // The vector's memory goes back to the pool.
+ * VecPool_destroy(&pool);
+ * ```
+ *
+ * A pool isn't thread-safe; only one thread should use a given pool (and the
+ * vectors allocated from it) at a time.
+ */
+#ifndef VEC_POOL_H
+#define VEC_POOL_H
+
+#include <stddef.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The pool struct, `typedef`'d so that its implementation details are
+ * encapsulated
+ */
+typedef struct VecPool VecPool;
+
+/**
+ * @brief Allocates a new, empty pool
+ *
+ * WARNING: This returns a dynamically allocated pool whose memory should
+ * eventually be freed with `VecPool_destroy()`. Otherwise, the pool's memory
+ * will leak.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if allocating memory for the pool failed, internally.
+ *
+ * @return A pointer to the newly-allocated pool
+ */
+VecPool* VecPool_new(void);
+
+/**
+ * @brief Destroys the given pool, and with it all of its slabs, taking it as a
+ * double pointer so that it can null out the caller's single pointer to the
+ * pool (for convenience)
+ *
+ * WARNING: Vectors allocated from the pool must be destroyed before the pool!
+ * Their memory is gone with the pool's slabs (except for allocations too big
+ * for any size class, which leak).
+ *
+ * The double pointer or inner pool pointer can be null, in which case this
+ * does nothing.
+ *
+ * @param pool A double pointer to a pool
+ */
+void VecPool_destroy(VecPool** pool);
+
+/**
+ * @brief Gets the number of bytes the given pool currently has on its free
+ * lists, ready to be handed out again
+ *
+ * If the pool pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param pool The pool to query
+ * @return The number of free bytes in the pool's size classes
+ */
+size_t VecPool_free_bytes(VecPool const* pool);
+
+/**
+ * @brief Gets an allocator that allocates from the given pool, usable as a
+ * vector's allocator via `VecOptions`
+ *
+ * The pool must outlive any vector using the allocator.
+ *
+ * @param pool The pool to allocate from
+ * @return The allocator
+ */
+VecAllocator VecPool_allocator(VecPool* pool);
+
+#endif
@@ -0,0 +1,619 @@
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "VecSeg.h"
+
+struct VecSeg
+{
+    uint8_t** chunks; // The table of chunks (the first `chunk_count` are used)
+    size_t chunk_count; // The number of chunks allocated
+    size_t table_capacity; // How many chunk pointers the table has room for
+    size_t count; // The number of elements
+    size_t element_size; // The byte size of each element
+    size_t chunk_bytes; // The byte size of each chunk
+    unsigned shift; // The log2 of the number of elements per chunk
+    size_t mask; // The number of elements per chunk, minus 1
+    VecAllocator allocator; // Where the chunks and table come from
+};
+
+/**
+ * @brief Gets a pointer to the element at the given index of the given
+ * segmented vector, whose chunk must be allocated
+ */
+static uint8_t* element(VecSeg const* v, size_t const i)
+{
+    return v->chunks[i >> v->shift] + (i & v->mask) * v->element_size;
+}
+
+/**
+ * @brief Allocates one more chunk for the given segmented vector, first
+ * doubling its table of chunks if the table is full
+ *
+ * Only the table is ever resized (and with it, copied), and it's one pointer
+ * per chunk, so existing elements never move.
+ *
+ * @param v The segmented vector
+ * @return Whether a chunk was added
+ */
+static bool add_chunk(VecSeg* v)
+{
+    VecAllocator const* a = &v->allocator;
+
+    if (v->chunk_count == v->table_capacity)
+    {
+        size_t const old_capacity = v->table_capacity;
+        size_t const new_capacity = (old_capacity == 0) ? 4 : old_capacity * 2;
+
+        // (If okay with requiring C23, this should just be a `ckd_mul()`.)
+        bool const table_size_overflowed =
+            new_capacity > SIZE_MAX / 2 / sizeof(uint8_t*);
+
+        if (table_size_overflowed)
+        {
+            return false;
+        }
+
+        uint8_t** table = (old_capacity == 0)
+                          ? a->allocate(a->context,
+                                        new_capacity * sizeof(uint8_t*))
+                          : a->reallocate(a->context,
+                                          v->chunks,
+                                          old_capacity * sizeof(uint8_t*),
+                                          new_capacity * sizeof(uint8_t*));
+
+        if (table == NULL)
+        {
+            return false;
+        }
+
+        v->chunks = table;
+        v->table_capacity = new_capacity;
+    }
+
+    uint8_t* chunk = a->allocate(a->context, v->chunk_bytes);
+
+    if (chunk == NULL)
+    {
+        return false;
+    }
+
+    v->chunks[v->chunk_count] = chunk;
+    v->chunk_count += 1;
+
+    return true;
+}
+
+/**
+ * @brief Makes sure the given segmented vector has room for one more element
+ */
+static bool room_for_one(VecSeg* v)
+{
+    // (The capacity can't overflow, since every chunk is allocated memory.)
+    return (v->count < (v->chunk_count << v->shift)) || add_chunk(v);
+}
+
+/**
+ * @brief Moves the elements from the given index on up by one, leaving a gap
+ * at the index, in the given segmented vector, which must have room for one
+ * more element
+ *
+ * Each chunk's part is moved with one `memmove()`, and the element that falls
+ * off the end of a chunk is carried over to the start of the next.
+ *
+ * @param v The segmented vector
+ * @param from The index of the first element to move
+ */
+static void shift_up(VecSeg* v, size_t const from)
+{
+    size_t const es = v->element_size;
+    size_t i = v->count; // The highest destination not yet filled
+
+    while (i > from)
+    {
+        size_t const chunk_start = i - (i & v->mask);
+
+        if (i == chunk_start)
+        {
+            memcpy(element(v, i), element(v, i - 1), es);
+            i -= 1;
+            continue;
+        }
+
+        size_t const lowest = (from + 1 > chunk_start + 1)
+                              ? from + 1
+                              : chunk_start + 1;
+
+        memmove(element(v, lowest),
+                element(v, lowest - 1),
+                (i - lowest + 1) * es);
+        i = lowest - 1;
+    }
+}
+
+/**
+ * @brief Moves the elements after the given index down by one, overwriting the
+ * element at the index, in the given segmented vector
+ *
+ * This is `shift_up()` in reverse, and doesn't change the count.
+ *
+ * @param v The segmented vector
+ * @param to The index to move the next element into
+ */
+static void shift_down(VecSeg* v, size_t const to)
+{
+    size_t const es = v->element_size;
+    size_t const last = v->count - 1; // One past the last destination
+    size_t i = to; // The lowest destination not yet filled
+
+    while (i < last)
+    {
+        size_t const chunk_last = i | v->mask;
+
+        if (i == chunk_last)
+        {
+            memcpy(element(v, i), element(v, i + 1), es);
+            i += 1;
+            continue;
+        }
+
+        size_t const highest = (last - 1 < chunk_last - 1)
+                               ? last - 1
+                               : chunk_last - 1;
+
+        memmove(element(v, i),
+                element(v, i + 1),
+                (highest - i + 1) * es);
+        i = highest + 1;
+    }
+}
+
+VecSeg* VecSeg_new(size_t const chunk_capacity,
+                   size_t const element_size,
+                   VecAllocator const* allocator)
+{
+    assert(chunk_capacity != 0);
+    assert(element_size != 0);
+    if (chunk_capacity == 0 ||
+        element_size == 0)
+    {
+        return NULL;
+    }
+
+    bool const valid_allocator = allocator == NULL ||
+                                 (allocator->allocate != NULL &&
+                                  allocator->reallocate != NULL &&
+                                  allocator->deallocate != NULL);
+
+    assert(valid_allocator);
+    if (!valid_allocator)
+    {
+        return NULL;
+    }
+
+    unsigned shift = 0;
+
+    while (shift < sizeof(size_t) * 8 - 1 &&
+           ((size_t) 1 << shift) < chunk_capacity)
+    {
+        ++shift;
+    }
+
+    size_t const rounded = (size_t) 1 << shift;
+
+    // (If okay with requiring C23, this should just be a `ckd_mul()`.)
+    bool const chunk_size_overflowed = rounded < chunk_capacity ||
+                                       rounded > SIZE_MAX / element_size;
+
+    assert(!chunk_size_overflowed);
+    if (chunk_size_overflowed)
+    {
+        return NULL;
+    }
+
+    VecAllocator const a = (allocator != NULL) ? *allocator
+                                               : Vec_default_allocator();
+    VecSeg* v = a.allocate(a.context, sizeof(VecSeg));
+    bool const vec_allocation_succeeded = (v != NULL);
+
+    assert(vec_allocation_succeeded);
+    if (!vec_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    v->chunks = NULL;
+    v->chunk_count = 0;
+    v->table_capacity = 0;
+    v->count = 0;
+    v->element_size = element_size;
+    v->chunk_bytes = rounded * element_size;
+    v->shift = shift;
+    v->mask = rounded - 1;
+    v->allocator = a;
+
+    return v;
+}
+
+void VecSeg_destroy(VecSeg** v)
+{
+    if (v == NULL ||
+        (*v) == NULL)
+    {
+        return;
+    }
+
+    VecSeg* s = *v;
+    VecAllocator const a = s->allocator;
+
+    for (size_t i = 0; i < s->chunk_count; ++i)
+    {
+        a.deallocate(a.context, s->chunks[i], s->chunk_bytes);
+    }
+    if (s->chunks != NULL)
+    {
+        a.deallocate(a.context,
+                     s->chunks,
+                     s->table_capacity * sizeof(uint8_t*));
+    }
+    a.deallocate(a.context, s, sizeof(VecSeg));
+    *v = NULL;
+}
+
+size_t VecSeg_count(VecSeg const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return v->count;
+}
+
+size_t VecSeg_capacity(VecSeg const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return v->chunk_count << v->shift;
+}
+
+size_t VecSeg_chunk_capacity(VecSeg const* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    return v->mask + 1;
+}
+
+bool VecSeg_reserve(VecSeg* v, size_t const least_capacity)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    while ((v->chunk_count << v->shift) < least_capacity)
+    {
+        bool const chunk_allocation_succeeded = add_chunk(v);
+
+        assert(chunk_allocation_succeeded);
+        if (!chunk_allocation_succeeded)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void VecSeg_shrink_to_fit(VecSeg* v)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return;
+    }
+
+    size_t const needed = (v->count + v->mask) >> v->shift;
+
+    while (v->chunk_count > needed)
+    {
+        v->chunk_count -= 1;
+        v->allocator.deallocate(v->allocator.context,
+                                v->chunks[v->chunk_count],
+                                v->chunk_bytes);
+    }
+}
+
+void* VecSeg_get(VecSeg const* v, size_t const i)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return NULL;
+    }
+
+    assert(i < v->count);
+    if (i >= v->count)
+    {
+        return NULL;
+    }
+
+    return element(v, i);
+}
+
+void* VecSeg_chunk(VecSeg const* v, size_t const chunk, size_t* count)
+{
+    assert(v != NULL);
+    assert(count != NULL);
+    if (v == NULL ||
+        count == NULL)
+    {
+        return NULL;
+    }
+
+    size_t const first = chunk << v->shift;
+    bool const chunk_has_elements = (chunk < v->chunk_count) &&
+                                    (first < v->count);
+
+    assert(chunk_has_elements);
+    if (!chunk_has_elements)
+    {
+        return NULL;
+    }
+
+    size_t const left = v->count - first;
+
+    *count = (left > v->mask) ? v->mask + 1 : left;
+
+    return v->chunks[chunk];
+}
+
+bool VecSeg_append(VecSeg* v, void const* item, size_t const item_size)
+{
+    assert(v != NULL);
+    assert(item != NULL);
+    if (v == NULL ||
+        item == NULL)
+    {
+        return false;
+    }
+
+    assert(item_size == v->element_size);
+    if (item_size != v->element_size)
+    {
+        return false;
+    }
+
+    bool const room_succeeded = room_for_one(v);
+
+    assert(room_succeeded);
+    if (!room_succeeded)
+    {
+        return false;
+    }
+
+    memcpy(element(v, v->count), item, item_size);
+    v->count += 1;
+
+    return true;
+}
+
+bool VecSeg_insert(VecSeg* v,
+                   size_t const i,
+                   void const* item,
+                   size_t const item_size)
+{
+    assert(v != NULL);
+    assert(item != NULL);
+    if (v == NULL ||
+        item == NULL)
+    {
+        return false;
+    }
+
+    assert(item_size == v->element_size);
+    assert(i <= v->count);
+    if (item_size != v->element_size ||
+        i > v->count)
+    {
+        return false;
+    }
+
+    bool const room_succeeded = room_for_one(v);
+
+    assert(room_succeeded);
+    if (!room_succeeded)
+    {
+        return false;
+    }
+
+    shift_up(v, i);
+    memcpy(element(v, i), item, item_size);
+    v->count += 1;
+
+    return true;
+}
+
+size_t VecSeg_remove(VecSeg* v, size_t const i)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    assert(i < v->count);
+    if (i >= v->count)
+    {
+        return 0;
+    }
+
+    shift_down(v, i);
+    v->count -= 1;
+
+    return i;
+}
+
+size_t VecSeg_remove_all_if(VecSeg* v,
+                            bool (*predicate)(void const*, size_t const))
+{
+    assert(v != NULL);
+    assert(predicate != NULL);
+    if (v == NULL ||
+        predicate == NULL)
+    {
+        return 0;
+    }
+
+    // Keep the elements that don't satisfy the predicate, in order, in place.
+    size_t kept = 0;
+
+    for (size_t i = 0; i < v->count; ++i)
+    {
+        uint8_t const* e = element(v, i);
+
+        if (predicate(e, v->element_size))
+        {
+            continue;
+        }
+        if (kept != i)
+        {
+            memcpy(element(v, kept), e, v->element_size);
+        }
+        ++kept;
+    }
+
+    size_t const removed = v->count - kept;
+
+    v->count = kept;
+
+    return removed;
+}
+
+size_t VecSeg_where(VecSeg const* v, void const* item, size_t const item_size)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    assert(item != NULL);
+    assert(item_size == v->element_size);
+    if (item == NULL ||
+        item_size != v->element_size)
+    {
+        return v->count;
+    }
+
+    // Scan chunk by chunk, so each element is just a step along its chunk.
+    for (size_t first = 0; first < v->count; first += v->mask + 1)
+    {
+        uint8_t const* e = v->chunks[first >> v->shift];
+        size_t const left = v->count - first;
+        size_t const n = (left > v->mask) ? v->mask + 1 : left;
+
+        for (size_t j = 0; j < n; ++j, e += item_size)
+        {
+            if (memcmp(e, item, item_size) == 0)
+            {
+                return first + j;
+            }
+        }
+    }
+
+    return v->count;
+}
+
+size_t VecSeg_where_if(VecSeg const* v,
+                       bool (*predicate)(void const*, size_t const))
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return 0;
+    }
+
+    assert(predicate != NULL);
+    if (predicate == NULL)
+    {
+        return v->count;
+    }
+
+    for (size_t first = 0; first < v->count; first += v->mask + 1)
+    {
+        uint8_t const* e = v->chunks[first >> v->shift];
+        size_t const left = v->count - first;
+        size_t const n = (left > v->mask) ? v->mask + 1 : left;
+
+        for (size_t j = 0; j < n; ++j, e += v->element_size)
+        {
+            if (predicate(e, v->element_size))
+            {
+                return first + j;
+            }
+        }
+    }
+
+    return v->count;
+}
+
+bool VecSeg_has(VecSeg const* v, void const* item, size_t const item_size)
+{
+    assert(v != NULL);
+    if (v == NULL)
+    {
+        return false;
+    }
+
+    return VecSeg_where(v, item, item_size) < v->count;
+}
+
+int VecSeg_apply(VecSeg* v,
+                 int (*fun)(void* element, size_t const element_size,
+                            void* state),
+                 void* state)
+{
+    assert(v != NULL);
+    assert(fun != NULL);
+    if (v == NULL ||
+        fun == NULL)
+    {
+        return 1;
+    }
+
+    assert(v->count != 0);
+    if (v->count == 0)
+    {
+        return 1;
+    }
+
+    for (size_t first = 0; first < v->count; first += v->mask + 1)
+    {
+        uint8_t* e = v->chunks[first >> v->shift];
+        size_t const left = v->count - first;
+        size_t const n = (left > v->mask) ? v->mask + 1 : left;
+
+        for (size_t j = 0; j < n; ++j, e += v->element_size)
+        {
+            int const result = fun(e, v->element_size, state);
+
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,316 @@
+/**
+ * @file
+ * A segmented vector: elements in fixed-size chunks, which never move
+ *
+ * A regular vector keeps its elements in one block, which has to be resized
+ * (and, often, moved, copying every element) when it fills up. For a big
+ * vector, that's a long pause, and it invalidates every pointer to an element.
+ * A segmented vector instead keeps its elements in chunks of a fixed number of
+ * elements, listed in a table. Growing just adds a chunk (and, now and then,
+ * resizes the table, which is one pointer per chunk), so growing never copies
+ * elements, and an element's address never changes while it's at the same
+ * index.
+ *
+ * ```
+ * VecSeg* v = VecSeg_new(4096, sizeof(Order), NULL);
+ *
+ * VecSeg_append(v, &order, sizeof(Order));
+ * Order* first = VecSeg_get(v, 0);
+ *
+ * // ...millions of appends later, `first` still points to the first order.
+ * ```
+ *
+ * Element `i` is in chunk `i / chunk capacity`, at `i % chunk capacity`, and
+ * the chunk capacity is a power of 2, so getting an element is a shift, a mask,
+ * and a table lookup. The API mirrors the regular vector's, with `VecSeg_`
+ * instead of `Vec_`.
+ *
+ * Inserting and removing elements shifts the elements after them, like with a
+ * regular vector (chunk by chunk), so those do change the elements at later
+ * indices.
+ */
+#ifndef VEC_SEG_H
+#define VEC_SEG_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The segmented vector struct, `typedef`'d so that its implementation details
+ * are encapsulated
+ */
+typedef struct VecSeg VecSeg;
+
+/**
+ * @brief Creates a new, empty segmented vector of elements of the given size,
+ * in chunks of (at least) the given number of elements
+ *
+ * The chunk capacity is rounded up to a power of 2. Chunks are allocated as
+ * they're needed, so the new vector has no chunks yet (see `VecSeg_reserve()`).
+ *
+ * WARNING: This returns a dynamically allocated vector that should eventually
+ * be destroyed with `VecSeg_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The chunk capacity or element size is 0
+ *     - The chunk capacity and element size are so huge that a chunk's byte
+ *       size can't be represented without overflow
+ *     - The allocator (if given) doesn't have every function
+ *     - Allocating memory for the vector failed, internally
+ *
+ * @param chunk_capacity The minimum number of elements per chunk
+ * @param element_size The byte size of each element
+ * @param allocator The allocator to get the chunks (and everything else) from
+ * (or a null pointer for `malloc()`)
+ * @return A pointer to the newly-allocated vector
+ */
+VecSeg* VecSeg_new(size_t const chunk_capacity,
+                   size_t const element_size,
+                   VecAllocator const* allocator);
+
+/**
+ * @brief Destroys the given segmented vector, taking it as a double pointer
+ * so that it can null out the caller's single pointer to the vector (for
+ * convenience)
+ *
+ * The double pointer or inner vector pointer can be null, in which case this
+ * does nothing.
+ *
+ * @param v A double pointer to a segmented vector
+ */
+void VecSeg_destroy(VecSeg** v);
+
+/**
+ * @brief Gets the number of elements in the given segmented vector
+ *
+ * If the vector pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The segmented vector
+ * @return The number of elements
+ */
+size_t VecSeg_count(VecSeg const* v);
+
+/**
+ * @brief Gets the number of elements the given segmented vector has room for
+ * in the chunks it has allocated
+ *
+ * If the vector pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The segmented vector
+ * @return The capacity
+ */
+size_t VecSeg_capacity(VecSeg const* v);
+
+/**
+ * @brief Gets the number of elements in each of the given segmented vector's
+ * chunks
+ *
+ * If the vector pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The segmented vector
+ * @return The chunk capacity
+ */
+size_t VecSeg_chunk_capacity(VecSeg const* v);
+
+/**
+ * @brief Allocates chunks until the given segmented vector has room for (at
+ * least) the given number of elements
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if the vector pointer is null, or allocating memory failed,
+ * internally. (Chunks allocated before the failure are kept.)
+ *
+ * @param v The segmented vector
+ * @param least_capacity The minimum capacity
+ * @return Whether the vector has the capacity
+ */
+bool VecSeg_reserve(VecSeg* v, size_t const least_capacity);
+
+/**
+ * @brief Frees the given segmented vector's chunks that hold no elements
+ *
+ * If the vector pointer is null, this does nothing (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param v The segmented vector
+ */
+void VecSeg_shrink_to_fit(VecSeg* v);
+
+/**
+ * @brief Gets a pointer to the element at the given index in the given
+ * segmented vector
+ *
+ * The pointer stays valid until the element is shifted to another index (by
+ * an insertion or removal before it), removed, or its chunk is freed (by
+ * `VecSeg_shrink_to_fit()` after it's removed); in particular, appending never
+ * invalidates it.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the vector pointer is null or the index is out of
+ * bounds.
+ *
+ * @param v The segmented vector
+ * @param i The index of the element
+ * @return A pointer to the element
+ */
+void* VecSeg_get(VecSeg const* v, size_t const i);
+
+/**
+ * @brief Gets a pointer to the given chunk of the given segmented vector, and
+ * how many elements are in it, for scanning the elements chunk by chunk
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the vector or count pointers are null or the chunk
+ * holds no elements.
+ *
+ * @param v The segmented vector
+ * @param chunk The index of the chunk
+ * @param count Where to put the number of elements in the chunk
+ * @return A pointer to the chunk's first element
+ */
+void* VecSeg_chunk(VecSeg const* v, size_t const chunk, size_t* count);
+
+/**
+ * @brief Appends a copy of the given item to the end of the given segmented
+ * vector, allocating a new chunk if the last one's full
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The vector or item pointers are null
+ *     - The item's size isn't the vector's element size
+ *     - Allocating memory failed, internally
+ *
+ * @param v The segmented vector to append to
+ * @param item The item to append
+ * @param item_size The byte size of the item
+ * @return Whether the item was appended
+ */
+bool VecSeg_append(VecSeg* v, void const* item, size_t const item_size);
+
+/**
+ * @brief Inserts a copy of the given item at the given index of the given
+ * segmented vector, shifting the elements from that index on up by one
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The vector or item pointers are null
+ *     - The item's size isn't the vector's element size
+ *     - The index is past the end of the vector
+ *     - Allocating memory failed, internally
+ *
+ * @param v The segmented vector to insert into
+ * @param i The index to insert at
+ * @param item The item to insert
+ * @param item_size The byte size of the item
+ * @return Whether the item was inserted
+ */
+bool VecSeg_insert(VecSeg* v,
+                   size_t const i,
+                   void const* item,
+                   size_t const item_size);
+
+/**
+ * @brief Removes the element at the given index of the given segmented vector,
+ * shifting the elements after it down by one
+ *
+ * This fails, leaving the vector unmodified and returning 0 (or, if assertions
+ * are enabled, causing an assert crash), if the vector pointer is null or the
+ * index is out of bounds.
+ *
+ * @param v The segmented vector to remove from
+ * @param i The index to remove
+ * @return The index of the element after the removed one (like `Vec_remove()`)
+ */
+size_t VecSeg_remove(VecSeg* v, size_t const i);
+
+/**
+ * @brief Removes all elements that satisfy the given predicate from the given
+ * segmented vector, in one pass, like `Vec_remove_all_if()`
+ *
+ * If the vector or predicate pointers are null, this does nothing and returns
+ * 0 (or, if assertions are enabled, causes an assert crash).
+ *
+ * @param v The segmented vector to remove from
+ * @param predicate A function that takes an element pointer and the element
+ * size, and returns whether to remove the element
+ * @return How many elements were removed
+ */
+size_t VecSeg_remove_all_if(VecSeg* v,
+                            bool (*predicate)(void const*, size_t const));
+
+/**
+ * @brief Determines where the first element that matches the given item is in
+ * the given segmented vector, like `Vec_where()`
+ *
+ * This fails, and returns the number of elements (or, if assertions are
+ * enabled, causes an assert crash), if the vector or item pointers are null, or
+ * the item's size isn't the vector's element size.
+ *
+ * @param v The segmented vector to search
+ * @param item The item to match
+ * @param item_size The byte size of the item
+ * @return The index of the first match (or, if there's none, the number of
+ * elements)
+ */
+size_t VecSeg_where(VecSeg const* v, void const* item, size_t const item_size);
+
+/**
+ * @brief Determines where the first element that satisfies the given predicate
+ * is in the given segmented vector, like `Vec_where_if()`
+ *
+ * This fails, and returns the number of elements (or, if assertions are
+ * enabled, causes an assert crash), if the vector or predicate pointers are
+ * null.
+ *
+ * @param v The segmented vector to search
+ * @param predicate A function that takes an element pointer and the element
+ * size, and returns whether the element satisfies some condition
+ * @return The index of the first satisfying element (or, if there's none, the
+ * number of elements)
+ */
+size_t VecSeg_where_if(VecSeg const* v,
+                       bool (*predicate)(void const*, size_t const));
+
+/**
+ * @brief Determines whether the given segmented vector has an element that
+ * matches the given item, like `Vec_has()`
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), under the same conditions as `VecSeg_where()`.
+ *
+ * @param v The segmented vector to search
+ * @param item The item to match
+ * @param item_size The byte size of the item
+ * @return Whether there's a matching element
+ */
+bool VecSeg_has(VecSeg const* v, void const* item, size_t const item_size);
+
+/**
+ * @brief Applies the given function to each element in the given segmented
+ * vector, in order, like `Vec_apply()`
+ *
+ * This fails, and returns 1 (or, if assertions are enabled, causes an assert
+ * crash), if the vector or function pointers are null, or the vector is empty.
+ *
+ * @param v The segmented vector to apply over
+ * @param fun A function that takes an element pointer, an element size, and a
+ * state pointer, does something with the element, and returns non-0 to stop
+ * early or 0 to proceed
+ * @param state An optional pointer to call the function with
+ * @return 1 if an assert-worthy precondition failed or if the vector is empty;
+ * the first non-0 the function returned; or 0 if the function returned 0 for
+ * every element
+ */
+int VecSeg_apply(VecSeg* v,
+                 int (*fun)(void* element, size_t const element_size,
+                            void* state),
+                 void* state);
+
+#endif
@@ -0,0 +1,415 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <threads.h>
+#include <stdatomic.h>
+
+#include "VecShared.h"
+
+/**
+ * @def
+ * The byte size of a cache line, which each reader's pin gets to itself (so
+ * readers pinning at once don't contend over a shared cache line)
+ */
+#define CACHE_LINE_SIZE 64
+
+/**
+ * @def
+ * The epoch a reader records while it's not pinned (real epochs start at 1)
+ */
+#define UNPINNED ((size_t) 0)
+
+struct VecSharedReader
+{
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t epoch; // Epoch pinned in, if any
+    Vec const* pinned; // The pinned version (only touched by its reader)
+    VecShared* shared; // The shared vector being read
+    VecSharedReader* next; // The next reader of the shared vector
+    bool joined; // Whether the reader is in use (guarded by the lock)
+};
+
+/**
+ * @brief An old version, waiting for readers that may have it pinned to unpin
+ */
+typedef struct
+{
+    Vec* version; // The old version
+    size_t epoch; // The epoch it was retired in
+} Retired;
+
+struct VecShared
+{
+    _Atomic(Vec*) current; // The current version
+    atomic_size_t epoch; // The current epoch, bumped by each publish
+
+    mtx_t lock; // Guards everything below, and serializes writers
+    VecSharedReader* readers; // Every reader (joined or not)
+    Vec* retired; // A vector of `Retired` versions, oldest first
+};
+
+/**
+ * @brief Gets the earliest epoch that any reader of the given shared vector is
+ * pinned in (or `SIZE_MAX`, if none are pinned)
+ *
+ * The lock must be held (so the list of readers stays put).
+ *
+ * @param shared The shared vector
+ * @return The earliest pinned epoch
+ */
+static size_t earliest_pin(VecShared* shared)
+{
+    size_t earliest = SIZE_MAX;
+
+    for (VecSharedReader* r = shared->readers; r != NULL; r = r->next)
+    {
+        size_t const epoch = atomic_load(&r->epoch);
+
+        if (epoch != UNPINNED && epoch < earliest)
+        {
+            earliest = epoch;
+        }
+    }
+
+    return earliest;
+}
+
+/**
+ * @brief Checks whether the given retired version has been freed
+ */
+static bool is_freed(void const* element, size_t const element_size)
+{
+    (void) element_size;
+
+    return ((Retired const*) element)->version == NULL;
+}
+
+/**
+ * @brief Frees every retired version of the given shared vector that was
+ * retired before the earliest pinned epoch
+ *
+ * A version retired in epoch `e` was the current version up to (and during)
+ * epoch `e`, so only readers pinned in epoch `e` or earlier can have it. Since
+ * versions are retired oldest first, the ones that can be freed are the ones
+ * at the front.
+ *
+ * The lock must be held.
+ *
+ * @param shared The shared vector
+ * @return The number of retired versions left
+ */
+static size_t reclaim(VecShared* shared)
+{
+    size_t const count = Vec_count(shared->retired);
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    size_t const earliest = earliest_pin(shared);
+    size_t freed = 0;
+
+    while (freed < count)
+    {
+        Retired* r = (Retired*) Vec_get(shared->retired, freed);
+
+        if (r->epoch >= earliest)
+        {
+            break;
+        }
+        Vec_destroy(&r->version);
+        ++freed;
+    }
+
+    // Drop the freed versions from the list in one pass.
+    if (freed > 0)
+    {
+        Vec_remove_all_if(shared->retired, is_freed);
+    }
+
+    return Vec_count(shared->retired);
+}
+
+/**
+ * @brief Swaps the given version in as the given shared vector's current
+ * version, and retires the old one
+ *
+ * The lock must be held.
+ *
+ * @param shared The shared vector
+ * @param next The new version
+ */
+static void publish(VecShared* shared, Vec* next)
+{
+    Vec* old = atomic_exchange(&shared->current, next);
+
+    /*
+     * Readers that pin from here on record the next epoch, and see the new
+     * version. Readers that recorded this epoch (or earlier) may have the old
+     * one.
+     */
+    size_t const epoch = atomic_fetch_add(&shared->epoch, 1);
+    Retired const retired = { .version = old, .epoch = epoch };
+
+    if (!Vec_append(shared->retired, &retired, sizeof(retired)))
+    {
+        /*
+         * With nowhere to keep the old version until it's safe to free, wait
+         * for the readers that may have it to unpin, and free it now.
+         */
+        while (earliest_pin(shared) <= epoch)
+        {
+            thrd_yield();
+        }
+        Vec_destroy(&old);
+    }
+    reclaim(shared);
+}
+
+VecShared* VecShared_new(Vec* initial)
+{
+    assert(initial != NULL);
+    if (initial == NULL)
+    {
+        return NULL;
+    }
+
+    VecShared* shared = malloc(sizeof(VecShared));
+    bool const shared_allocation_succeeded = (shared != NULL);
+
+    assert(shared_allocation_succeeded);
+    if (!shared_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    shared->retired = Vec_new(4, sizeof(Retired));
+
+    bool const initialization_succeeded =
+        shared->retired != NULL &&
+        mtx_init(&shared->lock, mtx_plain) == thrd_success;
+
+    assert(initialization_succeeded);
+    if (!initialization_succeeded)
+    {
+        Vec_destroy(&shared->retired);
+        free(shared);
+        return NULL;
+    }
+
+    atomic_init(&shared->current, initial);
+    atomic_init(&shared->epoch, 1);
+    shared->readers = NULL;
+
+    return shared;
+}
+
+void VecShared_destroy(VecShared** shared)
+{
+    if (shared == NULL ||
+        (*shared) == NULL)
+    {
+        return;
+    }
+
+    VecShared* s = *shared;
+    VecSharedReader* r = s->readers;
+
+    while (r != NULL)
+    {
+        VecSharedReader* next = r->next;
+
+        free(r);
+        r = next;
+    }
+
+    for (size_t i = 0; i < Vec_count(s->retired); ++i)
+    {
+        Vec_destroy(&((Retired*) Vec_get(s->retired, i))->version);
+    }
+    Vec_destroy(&s->retired);
+
+    Vec* current = atomic_load(&s->current);
+
+    Vec_destroy(&current);
+    mtx_destroy(&s->lock);
+    free(s);
+    *shared = NULL;
+}
+
+VecSharedReader* VecShared_join(VecShared* shared)
+{
+    assert(shared != NULL);
+    if (shared == NULL)
+    {
+        return NULL;
+    }
+
+    mtx_lock(&shared->lock);
+
+    // Reuse a reader that left, if there is one.
+    VecSharedReader* reader = shared->readers;
+
+    while (reader != NULL && reader->joined)
+    {
+        reader = reader->next;
+    }
+
+    if (reader == NULL)
+    {
+        reader = aligned_alloc(CACHE_LINE_SIZE, sizeof(VecSharedReader));
+
+        bool const reader_allocation_succeeded = (reader != NULL);
+
+        assert(reader_allocation_succeeded);
+        if (!reader_allocation_succeeded)
+        {
+            mtx_unlock(&shared->lock);
+            return NULL;
+        }
+
+        atomic_init(&reader->epoch, UNPINNED);
+        reader->shared = shared;
+        reader->next = shared->readers;
+        shared->readers = reader;
+    }
+
+    reader->pinned = NULL;
+    reader->joined = true;
+    mtx_unlock(&shared->lock);
+
+    return reader;
+}
+
+void VecShared_leave(VecSharedReader** reader)
+{
+    if (reader == NULL ||
+        (*reader) == NULL)
+    {
+        return;
+    }
+
+    VecSharedReader* r = *reader;
+
+    VecShared_unpin(r);
+    mtx_lock(&r->shared->lock);
+    r->joined = false;
+    mtx_unlock(&r->shared->lock);
+    *reader = NULL;
+}
+
+Vec const* VecShared_pin(VecSharedReader* reader)
+{
+    assert(reader != NULL);
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+
+    if (reader->pinned != NULL)
+    {
+        return reader->pinned;
+    }
+
+    VecShared* shared = reader->shared;
+
+    /*
+     * Record the epoch before looking at the current version. If a writer
+     * swaps versions in between, the recorded epoch is older than the version
+     * seen, which only keeps versions around longer than needed. (These are
+     * all sequentially consistent, pairing with the writer's swap, epoch bump,
+     * and scan of the readers, so a writer that misses this pin has already
+     * swapped in the version this sees.)
+     */
+    atomic_store(&reader->epoch, atomic_load(&shared->epoch));
+    reader->pinned = atomic_load(&shared->current);
+
+    return reader->pinned;
+}
+
+void VecShared_unpin(VecSharedReader* reader)
+{
+    if (reader == NULL ||
+        reader->pinned == NULL)
+    {
+        return;
+    }
+
+    reader->pinned = NULL;
+    atomic_store_explicit(&reader->epoch, UNPINNED, memory_order_release);
+}
+
+bool VecShared_update(VecShared* shared,
+                      bool (*edit)(Vec* draft, void* context),
+                      void* context)
+{
+    assert(shared != NULL);
+    assert(edit != NULL);
+    if (shared == NULL ||
+        edit == NULL)
+    {
+        return false;
+    }
+
+    mtx_lock(&shared->lock);
+
+    // Only writers change the current version, and they hold the lock.
+    Vec* draft = Vec_clone(atomic_load_explicit(&shared->current,
+                                                memory_order_relaxed));
+    bool const clone_succeeded = (draft != NULL);
+
+    assert(clone_succeeded);
+    if (!clone_succeeded)
+    {
+        mtx_unlock(&shared->lock);
+        return false;
+    }
+
+    bool const publishing = edit(draft, context);
+
+    if (publishing)
+    {
+        publish(shared, draft);
+    }
+    else
+    {
+        Vec_destroy(&draft);
+    }
+    mtx_unlock(&shared->lock);
+
+    return publishing;
+}
+
+bool VecShared_publish(VecShared* shared, Vec* next)
+{
+    assert(shared != NULL);
+    assert(next != NULL);
+    if (shared == NULL ||
+        next == NULL)
+    {
+        return false;
+    }
+
+    mtx_lock(&shared->lock);
+    publish(shared, next);
+    mtx_unlock(&shared->lock);
+
+    return true;
+}
+
+size_t VecShared_reclaim(VecShared* shared)
+{
+    assert(shared != NULL);
+    if (shared == NULL)
+    {
+        return 0;
+    }
+
+    mtx_lock(&shared->lock);
+
+    size_t const left = reclaim(shared);
+
+    mtx_unlock(&shared->lock);
+
+    return left;
+}
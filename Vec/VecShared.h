@@ -0,0 +1,226 @@
+/**
+ * @file
+ * A vector for many readers and rare writers, whose readers never lock
+ *
+ * A shared vector is a sequence of versions, each an ordinary vector that never
+ * changes once it's published. A writer makes a new version by copying the
+ * current one, changing the copy, and then publishing it with one atomic
+ * pointer swap. A reader pins the current version, reads it for as long as it
+ * likes (with `Vec_get()`, `Vec_where()`, and the like), and unpins it, without
+ * ever taking a lock or waiting on a writer, so reads stay fast no matter what
+ * the writers are doing.
+ *
+ * ```
+ * VecShared* routes = VecShared_new(initial_routes);
+ * VecSharedReader* reader = VecShared_join(routes); // Once per thread
+ *
+ * Vec const* current = VecShared_pin(reader);
+ * size_t const i = Vec_where(current, &route, sizeof(Route));
+ * VecShared_unpin(reader);
+ *
+ * VecShared_update(routes, add_route, &new_route); // On any thread
+ * ```
+ *
+ * An old version is freed once no reader can still have it pinned. To know
+ * when that is, versions are numbered by epoch: each reader records the epoch
+ * it pinned in, and a version retired in a given epoch is freed once every
+ * pinned reader pinned in a later one. Writers free what they can whenever
+ * they publish (or reclaim explicitly, via `VecShared_reclaim()`).
+ *
+ * Writers take turns (writing is serialized by a lock), and each write copies
+ * the whole vector, so writes are meant to be rare, like updates to
+ * configuration or routing tables.
+ */
+#ifndef VEC_SHARED_H
+#define VEC_SHARED_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The shared vector struct, `typedef`'d so that its implementation details
+ * are encapsulated
+ */
+typedef struct VecShared VecShared;
+
+/**
+ * @typedef
+ * The struct of a reader of a shared vector, `typedef`'d so that its
+ * implementation details are encapsulated
+ */
+typedef struct VecSharedReader VecSharedReader;
+
+/**
+ * @brief Creates a new shared vector whose first version is the given vector,
+ * taking ownership of it
+ *
+ * WARNING: This returns a dynamically allocated shared vector that should
+ * eventually be destroyed with `VecShared_destroy()`. The given vector then
+ * belongs to the shared vector, and must not be used (or destroyed) directly
+ * anymore, other than through the shared vector.
+ *
+ * This fails, and returns a null pointer without taking ownership of the
+ * vector (or, if assertions are enabled, causes an assert crash), if the
+ * vector pointer is null, or if allocating memory for the shared vector
+ * failed, internally.
+ *
+ * @param initial The first version of the shared vector
+ * @return A pointer to the newly-allocated shared vector
+ */
+VecShared* VecShared_new(Vec* initial);
+
+/**
+ * @brief Destroys the given shared vector, every version of it, and every
+ * reader of it, taking it as a double pointer so that it can null out the
+ * caller's single pointer to it (for convenience)
+ *
+ * WARNING: No other thread may be using the shared vector, or any of its
+ * readers or versions!
+ *
+ * The double pointer or inner pointer can be null, in which case this does
+ * nothing.
+ *
+ * @param shared A double pointer to a shared vector
+ */
+void VecShared_destroy(VecShared** shared);
+
+/**
+ * @brief Registers a new reader of the given shared vector
+ *
+ * A reader is meant to be used by one thread at a time (usually, each reading
+ * thread joins once, and keeps its reader), since it records one pin.
+ *
+ * WARNING: The reader belongs to the shared vector, and is freed with it (or
+ * with `VecShared_leave()`).
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the shared vector pointer is null, or if allocating
+ * memory for the reader failed, internally.
+ *
+ * @param shared The shared vector
+ * @return A pointer to the new reader
+ */
+VecSharedReader* VecShared_join(VecShared* shared);
+
+/**
+ * @brief Unregisters the given reader, taking it as a double pointer so that it
+ * can null out the caller's single pointer to it (for convenience)
+ *
+ * A reader that's left is kept around (unpinned) for the next
+ * `VecShared_join()` to reuse.
+ *
+ * The double pointer or inner pointer can be null, in which case this does
+ * nothing.
+ *
+ * @param reader A double pointer to a reader
+ */
+void VecShared_leave(VecSharedReader** reader);
+
+/**
+ * @brief Pins the current version of the given reader's shared vector, so that
+ * it isn't freed until it's unpinned
+ *
+ * This never locks or waits: it's two atomic stores and two atomic loads.
+ *
+ * The pinned version never changes, so any number of readers can read it at
+ * once with functions that don't modify vectors (like `Vec_get()`,
+ * `Vec_where()`, `Vec_where_if()`, `Vec_has()`, `Vec_equal()`,
+ * `Vec_bsearch()`, or `Vec_apply_const()`).
+ *
+ * WARNING: `Vec_apply()` mustn't be used on a pinned version (not even cast to
+ * non-`const`, with a function that doesn't modify elements), since it
+ * rebuilds the vector's index and kept hash afterwards, which races with the
+ * other readers.
+ *
+ * WARNING: Pinning while already pinned just returns the version that's
+ * already pinned. Readers should unpin promptly, since versions retired while
+ * a reader is pinned aren't freed until it unpins.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the reader pointer is null.
+ *
+ * @param reader The reader
+ * @return The pinned version
+ */
+Vec const* VecShared_pin(VecSharedReader* reader);
+
+/**
+ * @brief Unpins the version pinned by the given reader (see `VecShared_pin()`)
+ *
+ * WARNING: Once this returns, the version may be freed at any time, so it (and
+ * pointers into it) must not be used anymore!
+ *
+ * If the reader pointer is null (or the reader isn't pinned), this does
+ * nothing.
+ *
+ * @param reader The reader
+ */
+void VecShared_unpin(VecSharedReader* reader);
+
+/**
+ * @brief Publishes a new version of the given shared vector, made by copying
+ * the current version (with `Vec_clone()`) and calling the given function on
+ * the copy
+ *
+ * The function can modify the copy in any way (append, remove, sort, and so
+ * on), and returns true to publish it, or false to throw it away. Readers
+ * never see the copy until it's published, and then see all of the function's
+ * changes at once.
+ *
+ * Writers are serialized, so the function never runs concurrently with another
+ * write to the same shared vector, and this waits for other writes to finish.
+ *
+ * This fails, and returns false without publishing anything (or, if
+ * assertions are enabled, causes an assert crash), if any of the following are
+ * true:
+ *     - The shared vector or function pointers are null
+ *     - Copying the current version failed, internally
+ *     - The function returned false (which doesn't cause an assert crash)
+ *
+ * @param shared The shared vector
+ * @param edit A function that takes the copy and the context pointer, modifies
+ * the copy, and returns whether to publish it
+ * @param context An optional pointer to call the function with
+ * @return Whether a new version was published
+ */
+bool VecShared_update(VecShared* shared,
+                      bool (*edit)(Vec* draft, void* context),
+                      void* context);
+
+/**
+ * @brief Publishes the given vector as the new version of the given shared
+ * vector, taking ownership of it (for writers that build versions from scratch,
+ * rather than by copying the current one)
+ *
+ * WARNING: The vector then belongs to the shared vector, and must not be used
+ * (or destroyed) directly anymore, other than through the shared vector.
+ *
+ * This fails, and returns false without taking ownership of the vector (or,
+ * if assertions are enabled, causes an assert crash), if the shared vector or
+ * vector pointers are null.
+ *
+ * @param shared The shared vector
+ * @param next The new version
+ * @return Whether the new version was published
+ */
+bool VecShared_publish(VecShared* shared, Vec* next);
+
+/**
+ * @brief Frees every old version of the given shared vector that no reader can
+ * still have pinned
+ *
+ * Writes already do this whenever they publish, so it's only needed to free
+ * versions sooner, e.g., when there won't be another write for a while.
+ *
+ * If the shared vector pointer is null, this just returns 0 (or, if assertions
+ * are enabled, causes an assert crash).
+ *
+ * @param shared The shared vector
+ * @return The number of old versions that are still waiting to be freed
+ */
+size_t VecShared_reclaim(VecShared* shared);
+
+#endif
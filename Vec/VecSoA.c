@@ -0,0 +1,412 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "VecSoA.h"
+
+/**
+ * @struct
+ * A field, and the column holding it
+ */
+typedef struct
+{
+    VecSoAField field; // Where the field is in a record
+    Vec* column; // The field of every record
+} Column;
+
+struct VecSoA
+{
+    size_t record_size; // The byte size of each record
+    size_t field_count; // The number of fields (and columns)
+    Column columns[]; // Each field's column
+};
+
+/**
+ * @brief Checks whether the given field index is in bounds for the given
+ * container
+ */
+static bool field_valid(VecSoA const* soa, size_t const field)
+{
+    return field < soa->field_count;
+}
+
+VecSoA* VecSoA_new(size_t const least_capacity,
+                   size_t const record_size,
+                   VecSoAField const* fields,
+                   size_t const field_count,
+                   VecOptions const* options)
+{
+    assert(least_capacity != 0);
+    assert(record_size != 0);
+    assert(fields != NULL);
+    assert(field_count != 0);
+    if (least_capacity == 0 ||
+        record_size == 0 ||
+        fields == NULL ||
+        field_count == 0)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < field_count; ++i)
+    {
+        bool const field_fits = fields[i].size != 0 &&
+                                fields[i].offset < record_size &&
+                                fields[i].size <= record_size -
+                                                  fields[i].offset;
+
+        assert(field_fits);
+        if (!field_fits)
+        {
+            return NULL;
+        }
+    }
+
+    // (If okay with requiring C23, this should just be a `ckd_mul()`.)
+    bool const struct_size_overflowed =
+        field_count > (SIZE_MAX - sizeof(VecSoA)) / sizeof(Column);
+
+    assert(!struct_size_overflowed);
+    if (struct_size_overflowed)
+    {
+        return NULL;
+    }
+
+    VecSoA* soa = malloc(sizeof(VecSoA) + field_count * sizeof(Column));
+    bool const container_allocation_succeeded = (soa != NULL);
+
+    assert(container_allocation_succeeded);
+    if (!container_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    soa->record_size = record_size;
+    soa->field_count = 0; // Counts the columns made so far, until done
+
+    for (size_t i = 0; i < field_count; ++i)
+    {
+        Vec* column = Vec_new_with(least_capacity, fields[i].size, options);
+        bool const column_allocation_succeeded = (column != NULL);
+
+        assert(column_allocation_succeeded);
+        if (!column_allocation_succeeded)
+        {
+            VecSoA_destroy(&soa);
+            return NULL;
+        }
+
+        soa->columns[i].field = fields[i];
+        soa->columns[i].column = column;
+        soa->field_count += 1;
+    }
+
+    return soa;
+}
+
+void VecSoA_destroy(VecSoA** soa)
+{
+    if (soa == NULL ||
+        (*soa) == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < (*soa)->field_count; ++i)
+    {
+        Vec_destroy(&(*soa)->columns[i].column);
+    }
+    free(*soa);
+    *soa = NULL;
+}
+
+size_t VecSoA_count(VecSoA const* soa)
+{
+    assert(soa != NULL);
+    if (soa == NULL)
+    {
+        return 0;
+    }
+
+    // Every column has the same count, so any will do.
+    return Vec_count(soa->columns[0].column);
+}
+
+Vec const* VecSoA_column(VecSoA const* soa, size_t const field)
+{
+    assert(soa != NULL);
+    if (soa == NULL)
+    {
+        return NULL;
+    }
+
+    assert(field_valid(soa, field));
+    if (!field_valid(soa, field))
+    {
+        return NULL;
+    }
+
+    return soa->columns[field].column;
+}
+
+bool VecSoA_append(VecSoA* soa,
+                   void const* record,
+                   size_t const record_size)
+{
+    assert(soa != NULL);
+    assert(record != NULL);
+    if (soa == NULL ||
+        record == NULL)
+    {
+        return false;
+    }
+
+    assert(record_size == soa->record_size);
+    if (record_size != soa->record_size)
+    {
+        return false;
+    }
+
+    uint8_t const* bytes = (uint8_t const*) record;
+
+    for (size_t i = 0; i < soa->field_count; ++i)
+    {
+        Column const* c = &soa->columns[i];
+        bool const append_succeeded = Vec_append(c->column,
+                                                 bytes + c->field.offset,
+                                                 c->field.size);
+
+        assert(append_succeeded);
+        if (!append_succeeded)
+        {
+            // Take the field back out of the columns that already got it.
+            while (i > 0)
+            {
+                Vec* column = soa->columns[--i].column;
+
+                Vec_remove(column, Vec_count(column) - 1);
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool VecSoA_get(VecSoA const* soa,
+                size_t const index,
+                void* record,
+                size_t const record_size)
+{
+    assert(soa != NULL);
+    assert(record != NULL);
+    if (soa == NULL ||
+        record == NULL)
+    {
+        return false;
+    }
+
+    assert(record_size == soa->record_size);
+    assert(index < VecSoA_count(soa));
+    if (record_size != soa->record_size ||
+        index >= VecSoA_count(soa))
+    {
+        return false;
+    }
+
+    uint8_t* bytes = (uint8_t*) record;
+
+    memset(bytes, 0, record_size);
+    for (size_t i = 0; i < soa->field_count; ++i)
+    {
+        Column const* c = &soa->columns[i];
+
+        memcpy(bytes + c->field.offset,
+               Vec_get(c->column, index),
+               c->field.size);
+    }
+
+    return true;
+}
+
+bool VecSoA_set(VecSoA* soa,
+                size_t const index,
+                void const* record,
+                size_t const record_size)
+{
+    assert(soa != NULL);
+    assert(record != NULL);
+    if (soa == NULL ||
+        record == NULL)
+    {
+        return false;
+    }
+
+    assert(record_size == soa->record_size);
+    assert(index < VecSoA_count(soa));
+    if (record_size != soa->record_size ||
+        index >= VecSoA_count(soa))
+    {
+        return false;
+    }
+
+    uint8_t const* bytes = (uint8_t const*) record;
+
+    for (size_t i = 0; i < soa->field_count; ++i)
+    {
+        Column const* c = &soa->columns[i];
+
+        memcpy(Vec_get(c->column, index),
+               bytes + c->field.offset,
+               c->field.size);
+    }
+
+    return true;
+}
+
+void VecSoA_remove(VecSoA* soa, size_t const index)
+{
+    assert(soa != NULL);
+    if (soa == NULL)
+    {
+        return;
+    }
+
+    assert(index < VecSoA_count(soa));
+    if (index >= VecSoA_count(soa))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < soa->field_count; ++i)
+    {
+        Vec_remove(soa->columns[i].column, index);
+    }
+}
+
+size_t VecSoA_where(VecSoA const* soa,
+                    size_t const field,
+                    void const* value,
+                    size_t const value_size)
+{
+    assert(soa != NULL);
+    if (soa == NULL)
+    {
+        return 0;
+    }
+
+    assert(field_valid(soa, field));
+    if (!field_valid(soa, field))
+    {
+        return VecSoA_count(soa);
+    }
+
+    return Vec_where(soa->columns[field].column, value, value_size);
+}
+
+size_t VecSoA_where_if(VecSoA const* soa,
+                       size_t const field,
+                       bool (*predicate)(void const*, size_t const))
+{
+    assert(soa != NULL);
+    if (soa == NULL)
+    {
+        return 0;
+    }
+
+    assert(field_valid(soa, field));
+    if (!field_valid(soa, field))
+    {
+        return VecSoA_count(soa);
+    }
+
+    return Vec_where_if(soa->columns[field].column, predicate);
+}
+
+int VecSoA_apply(VecSoA* soa,
+                 size_t const field,
+                 int (*fun)(void* element, size_t const element_size,
+                            void* state),
+                 void* state)
+{
+    assert(soa != NULL);
+    if (soa == NULL)
+    {
+        return 1;
+    }
+
+    assert(field_valid(soa, field));
+    if (!field_valid(soa, field))
+    {
+        return 1;
+    }
+
+    return Vec_apply(soa->columns[field].column, fun, state);
+}
+
+size_t VecSoA_remove_all_if(VecSoA* soa,
+                            size_t const field,
+                            bool (*predicate)(void const*, size_t const))
+{
+    assert(soa != NULL);
+    assert(predicate != NULL);
+    if (soa == NULL ||
+        predicate == NULL)
+    {
+        return 0;
+    }
+
+    assert(field_valid(soa, field));
+    if (!field_valid(soa, field))
+    {
+        return 0;
+    }
+
+    // Test the field's column once, noting every record to remove.
+    Vec const* tested = soa->columns[field].column;
+    size_t const count = Vec_count(tested);
+    size_t const size = soa->columns[field].field.size;
+    uint8_t const* element = (uint8_t const*) Vec_data(tested);
+    Vec* removing = NULL;
+
+    for (size_t i = 0; i < count; ++i, element += size)
+    {
+        if (!predicate(element, size))
+        {
+            continue;
+        }
+
+        if (removing == NULL)
+        {
+            removing = Vec_new(16, sizeof(size_t));
+        }
+
+        bool const noted = removing != NULL &&
+                           Vec_append(removing, &i, sizeof(i));
+
+        assert(noted);
+        if (!noted)
+        {
+            Vec_destroy(&removing);
+            return 0;
+        }
+    }
+
+    if (removing == NULL)
+    {
+        return 0;
+    }
+
+    // Then compact every column the same way.
+    size_t const* indices = (size_t const*) Vec_data(removing);
+    size_t const removed = Vec_count(removing);
+
+    for (size_t i = 0; i < soa->field_count; ++i)
+    {
+        Vec_remove_indices(soa->columns[i].column, indices, removed);
+    }
+    Vec_destroy(&removing);
+
+    return removed;
+}
@@ -0,0 +1,307 @@
+/**
+ * @file
+ * A structure-of-arrays container: records whose fields are each kept in a
+ * vector of their own
+ *
+ * When records are kept whole in a vector, a scan of one field (like
+ * `Vec_where_if()` looking at an ID) drags every record's other fields through
+ * the cache, too. A structure-of-arrays keeps each field in its own column, so
+ * a scan of one field only touches that field's column: for 64-byte records
+ * with an 8-byte field, an eighth of the memory.
+ *
+ * ```
+ * typedef struct { uint64_t id; double price; char name[48]; } Item;
+ *
+ * VecSoAField const fields[] =
+ * {
+ *     { offsetof(Item, id), sizeof(uint64_t) },
+ *     { offsetof(Item, price), sizeof(double) },
+ *     { offsetof(Item, name), 48 }
+ * };
+ * VecSoA* items = VecSoA_new(1024, sizeof(Item), fields, 3, NULL);
+ *
+ * VecSoA_append(items, &item, sizeof(Item)); // Splits the item up by field
+ * VecSoA_remove_all_if(items, 1, too_expensive); // Scans prices only
+ * ```
+ *
+ * Records go in and come out whole (split up by field on the way in, and put
+ * back together on the way out), and row-level changes keep every column in
+ * step. Each column is a regular vector of one field, which can be read
+ * directly via `VecSoA_column()`.
+ */
+#ifndef VEC_SOA_H
+#define VEC_SOA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @struct
+ * Where a field is in a record
+ */
+typedef struct VecSoAField
+{
+    size_t offset; // The byte offset of the field in the record
+    size_t size; // The byte size of the field
+} VecSoAField;
+
+/**
+ * @typedef
+ * The structure-of-arrays struct, `typedef`'d so that its implementation
+ * details are encapsulated
+ */
+typedef struct VecSoA VecSoA;
+
+/**
+ * @brief Creates a new structure-of-arrays of records of the given size, split
+ * up into the given fields, with room for (at least) the given number of
+ * records
+ *
+ * The fields should cover the parts of the record that matter; bytes of the
+ * record outside any field (like padding) aren't kept, and come back out as
+ * zeros. The fields are copied, so the array of them doesn't have to outlive
+ * the container.
+ *
+ * WARNING: This returns a dynamically allocated container that should
+ * eventually be destroyed with `VecSoA_destroy()`.
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The capacity, record size, or number of fields is 0
+ *     - The fields pointer is null
+ *     - Any field's size is 0, or any field goes past the end of the record
+ *     - The options are invalid (see `Vec_new_with()`)
+ *     - Allocating memory for the container or its columns failed, internally
+ *
+ * @param least_capacity The minimum number of records to allocate room for
+ * @param record_size The byte size of each record
+ * @param fields The fields of each record (one column each)
+ * @param field_count The number of fields
+ * @param options The options to create each column with (or a null pointer for
+ * the default options)
+ * @return A pointer to the newly-allocated container
+ */
+VecSoA* VecSoA_new(size_t const least_capacity,
+                   size_t const record_size,
+                   VecSoAField const* fields,
+                   size_t const field_count,
+                   VecOptions const* options);
+
+/**
+ * @brief Destroys the given container (and its columns), taking it as a double
+ * pointer so that it can null out the caller's single pointer to it (for
+ * convenience)
+ *
+ * The double pointer or inner pointer can be null, in which case this does
+ * nothing.
+ *
+ * @param soa A double pointer to a container
+ */
+void VecSoA_destroy(VecSoA** soa);
+
+/**
+ * @brief Gets the number of records in the given container
+ *
+ * If the container pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param soa The container
+ * @return The number of records
+ */
+size_t VecSoA_count(VecSoA const* soa);
+
+/**
+ * @brief Gets the column of the given field in the given container: a vector
+ * of that field of every record, in record order
+ *
+ * WARNING: The column belongs to the container. It can be read (e.g., with
+ * `Vec_get()`, `Vec_where()`, or `Vec_data()`) but must not be modified
+ * directly, since that would put it out of step with the other columns!
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if the container pointer is null or the field index is out
+ * of bounds.
+ *
+ * @param soa The container
+ * @param field The index of the field (in the fields the container was created
+ * with)
+ * @return The field's column
+ */
+Vec const* VecSoA_column(VecSoA const* soa, size_t const field);
+
+/**
+ * @brief Appends a copy of the given record to the end of the given container,
+ * splitting it up into its fields' columns
+ *
+ * If any column fails to grow, the columns that already got their field are
+ * put back, so the container is left unmodified.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The container or record pointers are null
+ *     - The record's size isn't the container's record size
+ *     - Allocating memory for a column failed, internally
+ *
+ * @param soa The container to append to
+ * @param record The record to append
+ * @param record_size The byte size of the record
+ * @return Whether the record was appended
+ */
+bool VecSoA_append(VecSoA* soa,
+                   void const* record,
+                   size_t const record_size);
+
+/**
+ * @brief Puts the record at the given index of the given container back
+ * together, into the given record
+ *
+ * Bytes of the record outside any field are zeroed.
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The container or record pointers are null
+ *     - The record's size isn't the container's record size
+ *     - The index is out of bounds
+ *
+ * @param soa The container
+ * @param index The index of the record
+ * @param record Where to put the record
+ * @param record_size The byte size of the record
+ * @return Whether the record was gotten
+ */
+bool VecSoA_get(VecSoA const* soa,
+                size_t const index,
+                void* record,
+                size_t const record_size);
+
+/**
+ * @brief Overwrites the record at the given index of the given container with
+ * the given record
+ *
+ * This fails, and returns false (or, if assertions are enabled, causes an
+ * assert crash), if any of the following are true:
+ *     - The container or record pointers are null
+ *     - The record's size isn't the container's record size
+ *     - The index is out of bounds
+ *
+ * @param soa The container
+ * @param index The index of the record
+ * @param record The record to overwrite with
+ * @param record_size The byte size of the record
+ * @return Whether the record was overwritten
+ */
+bool VecSoA_set(VecSoA* soa,
+                size_t const index,
+                void const* record,
+                size_t const record_size);
+
+/**
+ * @brief Removes the record at the given index of the given container, from
+ * every column
+ *
+ * WARNING: Like `Vec_remove()`, this shifts the records after it up by one.
+ *
+ * If the container pointer is null or the index is out of bounds, this does
+ * nothing (or, if assertions are enabled, causes an assert crash).
+ *
+ * @param soa The container
+ * @param index The index of the record to remove
+ */
+void VecSoA_remove(VecSoA* soa, size_t const index);
+
+/**
+ * @brief Determines where the first record whose given field matches the given
+ * value is, like `Vec_where()`, scanning only the field's column
+ *
+ * This fails, and returns the number of records (or, if assertions are
+ * enabled, causes an assert crash), if the container or value pointers are
+ * null, the field index is out of bounds, or the value's size isn't the
+ * field's size.
+ *
+ * @param soa The container to search
+ * @param field The index of the field to match
+ * @param value The value to match
+ * @param value_size The byte size of the value
+ * @return The index of the first matching record (or, if there's none, the
+ * number of records)
+ */
+size_t VecSoA_where(VecSoA const* soa,
+                    size_t const field,
+                    void const* value,
+                    size_t const value_size);
+
+/**
+ * @brief Determines where the first record whose given field satisfies the
+ * given predicate is, like `Vec_where_if()`, scanning only the field's column
+ *
+ * The predicate gets a pointer to the record's field (and the field's size),
+ * not the whole record.
+ *
+ * This fails, and returns the number of records (or, if assertions are
+ * enabled, causes an assert crash), if the container or predicate pointers are
+ * null, or the field index is out of bounds.
+ *
+ * @param soa The container to search
+ * @param field The index of the field to test
+ * @param predicate A function that takes a field pointer and the field's size,
+ * and returns whether the field satisfies some condition
+ * @return The index of the first satisfying record (or, if there's none, the
+ * number of records)
+ */
+size_t VecSoA_where_if(VecSoA const* soa,
+                       size_t const field,
+                       bool (*predicate)(void const*, size_t const));
+
+/**
+ * @brief Applies the given function to the given field of every record in the
+ * given container, like `Vec_apply()`, touching only the field's column
+ *
+ * The function gets a pointer to the record's field (and the field's size),
+ * not the whole record, and can modify the field.
+ *
+ * This fails, and returns 1 (or, if assertions are enabled, causes an assert
+ * crash), like `Vec_apply()`, if the container or function pointers are null,
+ * the field index is out of bounds, or the container is empty.
+ *
+ * @param soa The container to apply over
+ * @param field The index of the field to apply to
+ * @param fun A function that takes a field pointer, the field's size, and a
+ * state pointer, does something with the field, and returns non-0 to stop
+ * early or 0 to proceed
+ * @param state An optional pointer to call the function with
+ * @return The value `Vec_apply()` returns for the field's column
+ */
+int VecSoA_apply(VecSoA* soa,
+                 size_t const field,
+                 int (*fun)(void* element, size_t const element_size,
+                            void* state),
+                 void* state);
+
+/**
+ * @brief Removes every record whose given field satisfies the given predicate,
+ * from every column, like `Vec_remove_all_if()`
+ *
+ * The predicate only looks at the field's column, once per record. Then, every
+ * column is compacted in one pass over it.
+ *
+ * NOTE: This temporarily allocates a list of the indices of the records to
+ * remove.
+ *
+ * This fails, leaving the container unmodified and returning 0 (or, if
+ * assertions are enabled, causing an assert crash), if the container or
+ * predicate pointers are null, the field index is out of bounds, or allocating
+ * the list of indices failed, internally.
+ *
+ * @param soa The container to remove from
+ * @param field The index of the field to test
+ * @param predicate A function that takes a field pointer and the field's size,
+ * and returns whether to remove the field's record
+ * @return How many records were removed
+ */
+size_t VecSoA_remove_all_if(VecSoA* soa,
+                            size_t const field,
+                            bool (*predicate)(void const*, size_t const));
+
+#endif
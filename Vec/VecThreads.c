@@ -0,0 +1,819 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <threads.h>
+#include <stdatomic.h>
+
+#include "VecThreads.h"
+
+/**
+ * @def
+ * The byte size of a cache line, which chunks of elements are multiples of
+ */
+#define CACHE_LINE_SIZE ((size_t) 64)
+
+/**
+ * @def
+ * How many chunks of elements `Vec_apply_parallel()` aims to give each worker,
+ * so that workers that finish early have chunks left to pick up
+ */
+#define CHUNKS_PER_WORKER ((size_t) 16)
+
+typedef struct Worker Worker;
+struct Worker
+{
+    VecThreads* pool; // The pool the worker's in
+    size_t index; // The worker's index in the pool (0 is the caller's)
+};
+
+struct VecThreads
+{
+    thrd_t* threads; // The started threads (one fewer than the workers)
+    Worker* workers; // Each started thread's worker
+    size_t count; // Number of workers, including the caller of a job
+
+    mtx_t run_lock; // Held for the duration of a job, one job at a time
+    mtx_t lock; // Guards everything below (except the task counter)
+    cnd_t wake; // Signaled when there's a new job, or when stopping
+    cnd_t done; // Signaled when the last busy thread finishes its job
+
+    void (*task)(void*, size_t const, size_t const); // The job's function
+    void* context; // The job's context pointer
+    size_t task_count; // The job's number of tasks
+    atomic_size_t next_task; // The next task for a worker to claim
+    size_t generation; // Incremented for each job, so threads can spot it
+    size_t busy; // Number of threads still working on the job
+    bool stopping; // Whether the threads should exit
+};
+
+/**
+ * @brief Claims and runs tasks of the given pool's current job until there are
+ * none left to claim
+ * @param pool The pool
+ * @param worker_index The index of the worker running the tasks
+ */
+static void work(VecThreads* pool, size_t const worker_index)
+{
+    while (true)
+    {
+        size_t const task_index = atomic_fetch_add(&pool->next_task, 1);
+
+        if (task_index >= pool->task_count)
+        {
+            return;
+        }
+        pool->task(pool->context, task_index, worker_index);
+    }
+}
+
+/**
+ * @brief The function each started thread runs, working on each new job until
+ * the pool is stopped
+ * @param arg The thread's worker
+ * @return 0
+ */
+static int thread_main(void* arg)
+{
+    Worker* worker = (Worker*) arg;
+    VecThreads* pool = worker->pool;
+    size_t seen_generation = 0;
+
+    while (true)
+    {
+        mtx_lock(&pool->lock);
+        while (!pool->stopping &&
+               pool->generation == seen_generation)
+        {
+            cnd_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping)
+        {
+            mtx_unlock(&pool->lock);
+            return 0;
+        }
+        seen_generation = pool->generation;
+        mtx_unlock(&pool->lock);
+
+        work(pool, worker->index);
+
+        mtx_lock(&pool->lock);
+        pool->busy -= 1;
+        if (pool->busy == 0)
+        {
+            cnd_signal(&pool->done);
+        }
+        mtx_unlock(&pool->lock);
+    }
+}
+
+/**
+ * @brief Stops and joins the given number of the pool's started threads, then
+ * frees the pool
+ * @param pool The pool
+ * @param started How many of the pool's threads were started
+ */
+static void stop(VecThreads* pool, size_t const started)
+{
+    mtx_lock(&pool->lock);
+    pool->stopping = true;
+    cnd_broadcast(&pool->wake);
+    mtx_unlock(&pool->lock);
+
+    for (size_t i = 0; i < started; ++i)
+    {
+        thrd_join(pool->threads[i], NULL);
+    }
+
+    cnd_destroy(&pool->done);
+    cnd_destroy(&pool->wake);
+    mtx_destroy(&pool->lock);
+    mtx_destroy(&pool->run_lock);
+    free(pool->workers);
+    free(pool->threads);
+    free(pool);
+}
+
+VecThreads* VecThreads_new(size_t const worker_count)
+{
+    assert(worker_count != 0);
+    if (worker_count == 0)
+    {
+        return NULL;
+    }
+
+    VecThreads* pool = malloc(sizeof(VecThreads));
+    bool const pool_allocation_succeeded = (pool != NULL);
+
+    assert(pool_allocation_succeeded);
+    if (!pool_allocation_succeeded)
+    {
+        return NULL;
+    }
+
+    size_t const thread_count = worker_count - 1;
+
+    // (`calloc()` checks the multiplication for overflow.)
+    pool->threads = calloc(thread_count > 0 ? thread_count : 1,
+                           sizeof(thrd_t));
+    pool->workers = calloc(thread_count > 0 ? thread_count : 1,
+                           sizeof(Worker));
+
+    bool const synchronization_initialized =
+        mtx_init(&pool->run_lock, mtx_plain) == thrd_success &&
+        mtx_init(&pool->lock, mtx_plain) == thrd_success &&
+        cnd_init(&pool->wake) == thrd_success &&
+        cnd_init(&pool->done) == thrd_success;
+    bool const allocations_succeeded =
+        pool->threads != NULL &&
+        pool->workers != NULL;
+
+    // (Initializing a C11 mutex or condition only fails when out of memory.)
+    assert(synchronization_initialized);
+    assert(allocations_succeeded);
+    if (!synchronization_initialized ||
+        !allocations_succeeded)
+    {
+        free(pool->workers);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    pool->count = worker_count;
+    pool->task = NULL;
+    pool->context = NULL;
+    pool->task_count = 0;
+    atomic_init(&pool->next_task, 0);
+    pool->generation = 0;
+    pool->busy = 0;
+    pool->stopping = false;
+
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i + 1; // Worker 0 is the job's caller.
+
+        bool const thread_started = thrd_create(&pool->threads[i],
+                                                thread_main,
+                                                &pool->workers[i])
+                                    == thrd_success;
+
+        assert(thread_started);
+        if (!thread_started)
+        {
+            stop(pool, i);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void VecThreads_destroy(VecThreads** pool)
+{
+    if (pool == NULL ||
+        (*pool) == NULL)
+    {
+        return;
+    }
+
+    stop(*pool, (*pool)->count - 1);
+    *pool = NULL;
+}
+
+size_t VecThreads_count(VecThreads const* pool)
+{
+    assert(pool != NULL);
+    if (pool == NULL)
+    {
+        return 0;
+    }
+
+    return pool->count;
+}
+
+bool VecThreads_for(VecThreads* pool,
+                    size_t const task_count,
+                    void (*task)(void* context,
+                                 size_t const task_index,
+                                 size_t const worker_index),
+                    void* context)
+{
+    assert(pool != NULL);
+    assert(task != NULL);
+    if (pool == NULL ||
+        task == NULL)
+    {
+        return false;
+    }
+
+    if (task_count == 0)
+    {
+        return true;
+    }
+
+    mtx_lock(&pool->run_lock);
+
+    pool->task = task;
+    pool->context = context;
+    pool->task_count = task_count;
+    atomic_store(&pool->next_task, 0);
+
+    if (pool->count == 1 ||
+        task_count == 1)
+    {
+        // There's nobody to share the work with, so don't wake anyone.
+        work(pool, 0);
+        mtx_unlock(&pool->run_lock);
+        return true;
+    }
+
+    mtx_lock(&pool->lock);
+    pool->generation += 1;
+    pool->busy = pool->count - 1;
+    cnd_broadcast(&pool->wake);
+    mtx_unlock(&pool->lock);
+
+    work(pool, 0);
+
+    // Wait for the threads to finish the tasks they claimed.
+    mtx_lock(&pool->lock);
+    while (pool->busy > 0)
+    {
+        cnd_wait(&pool->done, &pool->lock);
+    }
+    mtx_unlock(&pool->lock);
+
+    mtx_unlock(&pool->run_lock);
+
+    return true;
+}
+
+/**
+ * @struct
+ * What each chunk of a parallel apply needs to know
+ */
+typedef struct
+{
+    uint8_t* data; // The vector's elements
+    size_t element_size; // The vector's element size
+    size_t count; // The vector's number of elements
+    size_t chunk; // The number of elements per chunk (except maybe the last)
+    int (*fun)(void*, size_t const, void*); // The function to apply
+    uint8_t* states; // The per-worker states (or a null pointer)
+    size_t state_size; // The byte size of each per-worker state
+    atomic_size_t stop_index; // The lowest index that the function stopped at
+    mtx_t lock; // Guards the stop value (and the stop index's lowering)
+    int stop_value; // The value the function stopped with at that index
+} ApplyJob;
+
+/**
+ * @brief Records that the function stopped at the given index with the given
+ * value, unless it already stopped at a lower index
+ * @param job The parallel apply job
+ * @param index The element index that the function stopped at
+ * @param value The non-0 value the function returned there
+ */
+static void record_stop(ApplyJob* job, size_t const index, int const value)
+{
+    mtx_lock(&job->lock);
+    if (index < atomic_load(&job->stop_index))
+    {
+        atomic_store(&job->stop_index, index);
+        job->stop_value = value;
+    }
+    mtx_unlock(&job->lock);
+}
+
+/**
+ * @brief Applies a parallel apply job's function to the elements of one chunk
+ * @param context The parallel apply job
+ * @param task_index The index of the chunk
+ * @param worker_index The index of the worker, which picks its state
+ */
+static void apply_chunk(void* context,
+                        size_t const task_index,
+                        size_t const worker_index)
+{
+    ApplyJob* job = (ApplyJob*) context;
+    size_t const begin = task_index * job->chunk;
+    size_t const remaining = job->count - begin;
+    size_t const end = begin +
+                       (remaining < job->chunk ? remaining : job->chunk);
+    void* state = (job->states != NULL)
+                  ? job->states + worker_index * job->state_size
+                  : NULL;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        // Don't go past where the function already stopped.
+        if (i >= atomic_load_explicit(&job->stop_index, memory_order_relaxed))
+        {
+            return;
+        }
+
+        int const return_value = job->fun(job->data + i * job->element_size,
+                                          job->element_size,
+                                          state);
+
+        if (return_value != 0)
+        {
+            record_stop(job, i, return_value);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Finds the greatest common divisor of the given numbers
+ * @param a A number
+ * @param b Another number
+ * @return The greatest common divisor
+ */
+static size_t gcd(size_t a, size_t b)
+{
+    while (b != 0)
+    {
+        size_t const r = a % b;
+
+        a = b;
+        b = r;
+    }
+
+    return a;
+}
+
+int Vec_apply_parallel(Vec* v,
+                       int (*fun)(void* element,
+                                  size_t const element_size,
+                                  void* state),
+                       void* states,
+                       size_t const state_size,
+                       VecThreads* pool)
+{
+    assert(v != NULL);
+    assert(fun != NULL);
+    assert(pool != NULL);
+    if (v == NULL ||
+        fun == NULL ||
+        pool == NULL ||
+        Vec_count(v) == 0)
+    {
+        return 1;
+    }
+
+    ApplyJob job =
+    {
+        .data = (uint8_t*) Vec_data(v),
+        .element_size = Vec_element_size(v),
+        .count = Vec_count(v),
+        .fun = fun,
+        .states = (uint8_t*) states,
+        .state_size = state_size,
+        .stop_value = 0
+    };
+
+    atomic_init(&job.stop_index, SIZE_MAX);
+
+    /*
+     * Chunks are a whole number of cache lines long, i.e., a multiple of the
+     * fewest elements that add up to a multiple of a cache line.
+     */
+    size_t const line_elements =
+        CACHE_LINE_SIZE / gcd(job.element_size, CACHE_LINE_SIZE);
+    size_t const target_chunks = pool->count * CHUNKS_PER_WORKER;
+    size_t const target_chunk = (job.count + target_chunks - 1) / target_chunks;
+
+    job.chunk = ((target_chunk + line_elements - 1) / line_elements)
+                * line_elements;
+
+    bool const lock_initialized =
+        mtx_init(&job.lock, mtx_plain) == thrd_success;
+
+    assert(lock_initialized);
+    if (!lock_initialized)
+    {
+        return 1;
+    }
+
+    VecThreads_for(pool,
+                   (job.count + job.chunk - 1) / job.chunk,
+                   apply_chunk,
+                   &job);
+    mtx_destroy(&job.lock);
+
+    // The function may have changed elements' keys.
+    Vec_reindex(v);
+
+    return job.stop_value;
+}
+
+/**
+ * @def
+ * The length of the runs that a merge sort sorts by insertion before merging
+ */
+#define INSERTION_RUN ((size_t) 16)
+
+/**
+ * @brief Stably merges two sorted runs of elements into the given output
+ * (which may not overlap either run)
+ * @param a The first run
+ * @param a_count The number of elements in the first run
+ * @param b The second run
+ * @param b_count The number of elements in the second run
+ * @param out Where to write the merged elements
+ * @param size The byte size of each element
+ * @param cmp The comparator the runs are sorted by
+ */
+static void merge(uint8_t const* a,
+                  size_t a_count,
+                  uint8_t const* b,
+                  size_t b_count,
+                  uint8_t* out,
+                  size_t const size,
+                  int (*cmp)(void const*, void const*))
+{
+    while (a_count > 0 &&
+           b_count > 0)
+    {
+        // Taking from the first run on ties is what keeps the merge stable.
+        if (cmp(b, a) < 0)
+        {
+            memcpy(out, b, size);
+            b += size;
+            --b_count;
+        }
+        else
+        {
+            memcpy(out, a, size);
+            a += size;
+            --a_count;
+        }
+        out += size;
+    }
+
+    memcpy(out, a, a_count * size);
+    memcpy(out + a_count * size, b, b_count * size);
+}
+
+/**
+ * @brief Stably sorts the given elements by insertion, which is fastest for
+ * only a few elements
+ * @param data The elements
+ * @param count The number of elements
+ * @param size The byte size of each element
+ * @param cmp The comparator to sort by
+ * @param temp Room for one element
+ */
+static void insertion_sort(uint8_t* data,
+                           size_t const count,
+                           size_t const size,
+                           int (*cmp)(void const*, void const*),
+                           uint8_t* temp)
+{
+    for (size_t i = 1; i < count; ++i)
+    {
+        size_t j = i;
+
+        // Only move past strictly greater elements, to keep the sort stable.
+        while (j > 0 &&
+               cmp(data + (j - 1) * size, data + i * size) > 0)
+        {
+            --j;
+        }
+
+        if (j != i)
+        {
+            memcpy(temp, data + i * size, size);
+            memmove(data + (j + 1) * size, data + j * size, (i - j) * size);
+            memcpy(data + j * size, temp, size);
+        }
+    }
+}
+
+/**
+ * @brief Stably sorts the given elements with a bottom-up merge sort
+ * @param data The elements
+ * @param buffer Room for as many elements
+ * @param count The number of elements
+ * @param size The byte size of each element
+ * @param cmp The comparator to sort by
+ * @param temp Room for one element
+ */
+static void merge_sort(uint8_t* data,
+                       uint8_t* buffer,
+                       size_t const count,
+                       size_t const size,
+                       int (*cmp)(void const*, void const*),
+                       uint8_t* temp)
+{
+    for (size_t i = 0; i < count; i += INSERTION_RUN)
+    {
+        size_t const remaining = count - i;
+
+        insertion_sort(data + i * size,
+                       remaining < INSERTION_RUN ? remaining : INSERTION_RUN,
+                       size,
+                       cmp,
+                       temp);
+    }
+
+    uint8_t* src = data;
+    uint8_t* dst = buffer;
+
+    for (size_t width = INSERTION_RUN; width < count; width *= 2)
+    {
+        for (size_t i = 0; i < count; i += 2 * width)
+        {
+            size_t const a_count = (count - i < width) ? count - i : width;
+            size_t const rest = count - i - a_count;
+            size_t const b_count = (rest < width) ? rest : width;
+
+            merge(src + i * size,
+                  a_count,
+                  src + (i + a_count) * size,
+                  b_count,
+                  dst + i * size,
+                  size,
+                  cmp);
+        }
+
+        uint8_t* swap = src;
+
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != data)
+    {
+        memcpy(data, src, count * size);
+    }
+}
+
+/**
+ * @brief Finds how many of the first `k` elements of the stable merge of two
+ * sorted runs come from the first run
+ *
+ * This lets a merge be split into independent pieces: the piece of the output
+ * from `k0` to `k1` merges the first run from `co_rank(k0)` to `co_rank(k1)`
+ * with the second run from `k0 - co_rank(k0)` to `k1 - co_rank(k1)`.
+ *
+ * @param k The number of merged elements
+ * @param a The first run
+ * @param a_count The number of elements in the first run
+ * @param b The second run
+ * @param b_count The number of elements in the second run
+ * @param size The byte size of each element
+ * @param cmp The comparator the runs are sorted by
+ * @return How many of the first `k` merged elements come from the first run
+ */
+static size_t co_rank(size_t const k,
+                      uint8_t const* a,
+                      size_t const a_count,
+                      uint8_t const* b,
+                      size_t const b_count,
+                      size_t const size,
+                      int (*cmp)(void const*, void const*))
+{
+    size_t low = (k > b_count) ? k - b_count : 0;
+    size_t high = (k < a_count) ? k : a_count;
+
+    while (true)
+    {
+        size_t const i = low + (high - low) / 2;
+        size_t const j = k - i;
+
+        if (i > 0 && j < b_count &&
+            cmp(a + (i - 1) * size, b + j * size) > 0)
+        {
+            high = i - 1; // Too many from the first run
+        }
+        else if (j > 0 && i < a_count &&
+                 cmp(b + (j - 1) * size, a + i * size) >= 0)
+        {
+            low = i + 1; // Too few from the first run (ties go to it)
+        }
+        else
+        {
+            return i;
+        }
+    }
+}
+
+/**
+ * @struct
+ * What each task of a parallel merge sort needs to know
+ */
+typedef struct
+{
+    uint8_t* data; // The vector's elements
+    uint8_t* buffer; // Room for as many elements
+    uint8_t* temps; // Room for one element per worker
+    size_t count; // The number of elements
+    size_t size; // The byte size of each element
+    int (*cmp)(void const*, void const*); // The comparator to sort by
+    size_t run; // The number of elements per sorted run, this round
+    uint8_t const* src; // Where this round's runs are
+    uint8_t* dst; // Where this round merges the runs to
+    size_t pieces; // How many tasks each merge is split into, this round
+} SortJob;
+
+/**
+ * @brief Sorts one of a parallel merge sort's initial runs
+ * @param context The parallel merge sort job
+ * @param task_index The index of the run
+ * @param worker_index The index of the worker, which picks its temp element
+ */
+static void sort_run(void* context,
+                     size_t const task_index,
+                     size_t const worker_index)
+{
+    SortJob* job = (SortJob*) context;
+    size_t const begin = task_index * job->run;
+    size_t const remaining = job->count - begin;
+
+    merge_sort(job->data + begin * job->size,
+               job->buffer + begin * job->size,
+               remaining < job->run ? remaining : job->run,
+               job->size,
+               job->cmp,
+               job->temps + worker_index * job->size);
+}
+
+/**
+ * @brief Merges one piece of a pair of runs in a round of a parallel merge
+ * sort
+ * @param context The parallel merge sort job
+ * @param task_index The index of the pair of runs and the piece of the pair
+ * @param worker_index Unused
+ */
+static void merge_piece(void* context,
+                        size_t const task_index,
+                        size_t const worker_index)
+{
+    (void) worker_index;
+
+    SortJob* job = (SortJob*) context;
+    size_t const pair = task_index / job->pieces;
+    size_t const piece = task_index % job->pieces;
+    size_t const begin = pair * 2 * job->run;
+    size_t const remaining = job->count - begin;
+    size_t const a_count = remaining < job->run ? remaining : job->run;
+    size_t const rest = remaining - a_count;
+    size_t const b_count = rest < job->run ? rest : job->run;
+    uint8_t const* a = job->src + begin * job->size;
+    uint8_t const* b = a + a_count * job->size;
+
+    // This piece's share of the merged output
+    size_t const total = a_count + b_count;
+    size_t const k0 = total * piece / job->pieces;
+    size_t const k1 = total * (piece + 1) / job->pieces;
+    size_t const i0 = co_rank(k0, a, a_count, b, b_count, job->size, job->cmp);
+    size_t const i1 = co_rank(k1, a, a_count, b, b_count, job->size, job->cmp);
+
+    merge(a + i0 * job->size,
+          i1 - i0,
+          b + (k0 - i0) * job->size,
+          (k1 - i1) - (k0 - i0),
+          job->dst + (begin + k0) * job->size,
+          job->size,
+          job->cmp);
+}
+
+bool Vec_merge_sort_parallel(Vec* v,
+                             int (*cmp)(void const*, void const*),
+                             VecThreads* pool)
+{
+    assert(v != NULL);
+    assert(cmp != NULL);
+    assert(pool != NULL);
+    if (v == NULL ||
+        cmp == NULL ||
+        pool == NULL)
+    {
+        return false;
+    }
+
+    size_t const count = Vec_count(v);
+    size_t const size = Vec_element_size(v);
+
+    if (count < 2)
+    {
+        return true; // Already sorted
+    }
+
+    // (The elements' byte size can't overflow, since they're all in memory.)
+    bool const temps_overflow = pool->count > SIZE_MAX / size;
+
+    assert(!temps_overflow);
+    if (temps_overflow)
+    {
+        return false;
+    }
+
+    // The scratch space comes from the vector's allocator, like its elements.
+    VecAllocator const allocator = Vec_allocator(v);
+    size_t const buffer_bytes = count * size;
+    size_t const temps_bytes = pool->count * size;
+    uint8_t* buffer = allocator.allocate(allocator.context, buffer_bytes);
+    uint8_t* temps = allocator.allocate(allocator.context, temps_bytes);
+
+    assert(buffer != NULL);
+    assert(temps != NULL);
+    if (buffer == NULL ||
+        temps == NULL)
+    {
+        if (temps != NULL)
+        {
+            allocator.deallocate(allocator.context, temps, temps_bytes);
+        }
+        if (buffer != NULL)
+        {
+            allocator.deallocate(allocator.context, buffer, buffer_bytes);
+        }
+        return false;
+    }
+
+    SortJob job =
+    {
+        .data = (uint8_t*) Vec_data(v),
+        .buffer = buffer,
+        .temps = temps,
+        .count = count,
+        .size = size,
+        .cmp = cmp
+    };
+
+    // Sort one run per worker, all at once...
+    job.run = (count + pool->count - 1) / pool->count;
+    VecThreads_for(pool, (count + job.run - 1) / job.run, sort_run, &job);
+
+    // ...then merge pairs of runs, round by round, until there's one run.
+    job.src = job.data;
+    job.dst = job.buffer;
+    for (; job.run < count; job.run *= 2)
+    {
+        size_t const pairs = (count + 2 * job.run - 1) / (2 * job.run);
+
+        // Split the merges up so that every worker has something to merge.
+        job.pieces = (pool->count + pairs - 1) / pairs;
+        VecThreads_for(pool, pairs * job.pieces, merge_piece, &job);
+
+        uint8_t* swap = (uint8_t*) job.src;
+
+        job.src = job.dst;
+        job.dst = swap;
+    }
+
+    if (job.src != job.data)
+    {
+        memcpy(job.data, job.src, count * size);
+    }
+
+    allocator.deallocate(allocator.context, temps, temps_bytes);
+    allocator.deallocate(allocator.context, buffer, buffer_bytes);
+
+    // The elements moved, so their index (if any) has to be rebuilt.
+    return Vec_reindex(v);
+}
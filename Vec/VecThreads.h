@@ -0,0 +1,219 @@
+/**
+ * @file
+ * A reusable pool of worker threads, and parallel versions of vector
+ * functions that run on one
+ *
+ * Starting threads costs far more than handing work to ones that are already
+ * running, so a pool starts its threads once, parks them between jobs, and
+ * wakes them up for each job given to it via `VecThreads_for()`. The thread
+ * calling `VecThreads_for()` works on the job, too, so a pool of N workers
+ * starts N - 1 threads.
+ *
+ * A job is a number of tasks, which the workers claim one at a time from a
+ * shared counter until there are none left. A worker that's done with a cheap
+ * task just claims the next one, so tasks of uneven cost even out across the
+ * workers without any up-front planning.
+ *
+ * ```
+ * VecThreads* pool = VecThreads_new(8);
+ *
+ * Vec_apply_parallel(v, fun, NULL, 0, pool);
+ * Vec_apply_parallel(w, fun, NULL, 0, pool); // Reuses the same threads
+ * VecThreads_destroy(&pool);
+ * ```
+ *
+ * A pool can be shared by any number of threads, but it runs only one job at
+ * a time; `VecThreads_for()` waits for the pool to be free.
+ */
+#ifndef VEC_THREADS_H
+#define VEC_THREADS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Vec.h"
+
+/**
+ * @typedef
+ * The thread pool struct, `typedef`'d so that its implementation details are
+ * encapsulated
+ */
+typedef struct VecThreads VecThreads;
+
+/**
+ * @brief Starts a new pool of the given number of workers
+ *
+ * WARNING: This returns a dynamically allocated pool whose threads and memory
+ * should eventually be freed with `VecThreads_destroy()`. Otherwise, the
+ * pool's threads keep running, and its memory leaks.
+ *
+ * Since the thread that calls `VecThreads_for()` is one of the workers, this
+ * starts one fewer thread than the number of workers (so a pool of one worker
+ * starts no threads at all, and runs its jobs on the calling thread).
+ *
+ * This fails, and returns a null pointer (or, if assertions are enabled, causes
+ * an assert crash), if any of the following are true:
+ *     - The number of workers is 0
+ *     - Allocating memory, or starting threads, for the pool failed,
+ *       internally
+ *
+ * @param worker_count The number of workers
+ * @return A pointer to the newly-started pool
+ */
+VecThreads* VecThreads_new(size_t const worker_count);
+
+/**
+ * @brief Stops the given pool's threads and frees it, taking it as a double
+ * pointer so that it can null out the caller's single pointer to the pool (for
+ * convenience)
+ *
+ * WARNING: The pool must not be running a job!
+ *
+ * The double pointer or inner pool pointer can be null, in which case this
+ * does nothing.
+ *
+ * @param pool A double pointer to a pool
+ */
+void VecThreads_destroy(VecThreads** pool);
+
+/**
+ * @brief Gets the number of workers in the given pool (including the thread
+ * that calls `VecThreads_for()`)
+ *
+ * If the pool pointer is null, this just returns 0 (or, if assertions are
+ * enabled, causes an assert crash).
+ *
+ * @param pool The pool
+ * @return The pool's number of workers
+ */
+size_t VecThreads_count(VecThreads const* pool);
+
+/**
+ * @brief Runs the given number of tasks on the given pool's workers, and waits
+ * for all of them to finish
+ *
+ * Each task is run exactly once, by whichever worker claims it first. The
+ * given function gets the context pointer, the task's index (from 0 up to the
+ * number of tasks), and the index of the worker running it (from 0 up to the
+ * pool's number of workers). Since a worker runs one task at a time, the
+ * worker index can be used to pick per-worker scratch space that needs no
+ * synchronization.
+ *
+ * WARNING: Tasks run concurrently! Whatever they share through the context
+ * must be safe to access from several threads at once. Tasks must not call
+ * `VecThreads_for()` on the same pool (which would wait forever for itself).
+ *
+ * This fails, and returns false without running any tasks (or, if assertions
+ * are enabled, causes an assert crash), if the pool or function pointers are
+ * null.
+ *
+ * @param pool The pool to run the tasks on
+ * @param task_count How many tasks to run
+ * @param task The function to run each task with
+ * @param context An optional pointer to call the function with
+ * @return Whether the tasks were run
+ */
+bool VecThreads_for(VecThreads* pool,
+                    size_t const task_count,
+                    void (*task)(void* context,
+                                 size_t const task_index,
+                                 size_t const worker_index),
+                    void* context);
+
+/**
+ * @brief Applies the given function to each element in the given vector, like
+ * `Vec_apply()`, but with the elements split up between the workers of the
+ * given pool
+ *
+ * The elements are split up into contiguous chunks, each a multiple of 64
+ * bytes (a cache line) long from the start of the vector's data, so workers
+ * writing to neighboring chunks don't contend over a shared cache line.
+ * There are several chunks per worker, so a worker that gets through its
+ * chunks quickly (because the function happened to be cheap on those
+ * elements) picks up the chunks left over.
+ *
+ * Each worker calls the function with its own state pointer, pointing into the
+ * given array of per-worker states, which are each the given byte size apart.
+ * The worker with index `w` (see `VecThreads_for()`) gets
+ * `(char*) states + w * state_size`. So, e.g., for a parallel minimum, each
+ * worker can keep its own minimum without synchronizing with anyone, and the
+ * caller combines the per-worker minimums afterwards. If the states pointer
+ * is null, every call gets a null state pointer.
+ *
+ * Like with `Vec_apply()`, the function returns non-0 to stop early. Once it
+ * does, the workers don't start any elements after that one. Elements that
+ * came after it, but were already in progress on other workers, may have had
+ * the function applied to them regardless. If non-0 is returned for several
+ * elements, the value returned for the element at the lowest index is the one
+ * this returns (which is the value `Vec_apply()` would have returned).
+ *
+ * WARNING: The function is called from several threads at once! It must only
+ * touch its element, its own state, and anything else that's safe to access
+ * concurrently.
+ *
+ * This fails, leaving the vector unmodified and returning 1 (or, if assertions
+ * are enabled, causing an assert crash), if the vector, function, or pool
+ * pointers are null, or the vector is empty (like `Vec_apply()`).
+ *
+ * @param v The vector to apply over
+ * @param fun A function that takes an element pointer, an element size, and a
+ * state pointer, does something with the element, and returns non-0 to stop
+ * early or 0 to proceed
+ * @param states An optional array of per-worker states (with one state per
+ * worker in the pool)
+ * @param state_size The byte size of each per-worker state
+ * @param pool The pool to run on
+ * @return 1 if an assert-worthy precondition failed or if the vector is empty;
+ * the non-0 returned for the lowest-index element that the function returned
+ * non-0 for; or 0 if the function returned 0 for every element
+ */
+int Vec_apply_parallel(Vec* v,
+                       int (*fun)(void* element,
+                                  size_t const element_size,
+                                  void* state),
+                       void* states,
+                       size_t const state_size,
+                       VecThreads* pool);
+
+/**
+ * @brief Sorts the elements of the given vector according to the given
+ * comparator function, like `Vec_qsort()`, but stably, and with the work split
+ * up between the workers of the given pool
+ *
+ * The elements are split up into one run per worker, the runs are merge sorted
+ * at the same time, and then pairs of runs are merged until there's one run
+ * left. Each merge is itself split up between workers (by binary searching for
+ * where to split it), so even the final merge of the last two runs keeps every
+ * worker busy.
+ *
+ * The sort is stable, so elements that compare equal keep their relative
+ * order.
+ *
+ * WARNING: This may invalidate stored pointers or indices! After elements are
+ * re-ordered by the sort, pre-existing pointers or indices may no longer
+ * correspond to the elements they did before the sort! Also, the comparator is
+ * called from several threads at once, so it must be safe to call
+ * concurrently (which any comparator that only reads its arguments is).
+ *
+ * NOTE: This temporarily allocates a buffer as big as the vector's elements,
+ * from the vector's allocator.
+ *
+ * This fails, leaving the vector unmodified and returning false (or, if
+ * assertions are enabled, causing an assert crash), if any of the following
+ * are true:
+ *     - Allocating the temporary buffer failed, internally
+ *     - The vector, comparator, or pool pointers are null
+ *
+ * @param v The vector to sort
+ * @param cmp A comparator function that returns a negative integer when it
+ * considers its first argument to be "less" than the second, a positive integer
+ * when the first argument is "greater" than the second, and zero when the
+ * arguments are "equal" to each other
+ * @param pool The pool to run on
+ * @return Whether the vector was sorted
+ */
+bool Vec_merge_sort_parallel(Vec* v,
+                             int (*cmp)(void const*, void const*),
+                             VecThreads* pool);
+
+#endif
@@ -0,0 +1,480 @@
+/**
+ * @file
+ * Typed vectors, generated for a given element type by `VEC_DEFINE()`
+ *
+ * The generic vector functions only know their element size at run time, so
+ * every access multiplies by it, and every predicate is called through a
+ * `void` pointer. A typed vector's functions are generated for one element
+ * type, as `static inline` functions in the including file, so the compiler
+ * knows the element size (and its predicates, if they're visible) and can fold,
+ * inline, unroll, and vectorize them into the caller's loops.
+ *
+ * For example, this generates an `I64Vec` type with `I64Vec_new()`,
+ * `I64Vec_append()`, `I64Vec_get()`, and so on:
+ *
+ * ```
+ * VEC_DEFINE(I64Vec, int64_t)
+ *
+ * I64Vec* v = I64Vec_new(16);
+ *
+ * I64Vec_append(v, 42);
+ * assert(*I64Vec_get(v, 0) == 42);
+ * I64Vec_destroy(&v);
+ * ```
+ *
+ * The generated functions mirror the generic functions of the same names
+ * (minus the `void` pointers and item sizes that the element type makes
+ * unnecessary), and fail the same ways. Under the hood, a typed vector IS a
+ * generic vector, so `name_vec()` gets it as a `Vec*` for any generic function
+ * without a typed counterpart (like `Vec_qsort()` or `Vec_apply()`), and
+ * `name_from_vec()` goes the other way.
+ *
+ * `VEC_DEFINE_SORT()` adds a sort to a typed vector, with the element
+ * comparison inlined into it.
+ *
+ * Each `VEC_DEFINE()` (and `VEC_DEFINE_SORT()`) should appear once per type
+ * name in a file, at file scope.
+ */
+#ifndef VEC_TYPED_H
+#define VEC_TYPED_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "Vec.h"
+
+/**
+ * @def
+ * Gets the members read on every access of the given (typed) vector
+ */
+#define VEC_TYPED_HOT(v) ((VecHot*) (void*) (v))
+
+/**
+ * @def
+ * Generates a typed vector of the given name, with elements of the given type
+ *
+ * The generated type is an incomplete struct, `name`, used only through
+ * pointers (like `Vec`). The generated functions are:
+ *     - `name* name_new(size_t least_capacity)`
+ *     - `name* name_new_with(size_t least_capacity, VecOptions const* options)`
+ *     - `name* name_new_inline(void* storage, size_t storage_size,
+ *                              VecOptions const* options)`
+ *     - `name* name_from_vec(Vec* v)`, which fails, returning a null pointer,
+ *       if the generic vector's element size isn't the type's size
+ *     - `Vec* name_vec(name* v)` and `Vec const* name_vec_const(name const* v)`
+ *     - `void name_destroy(name** v)`
+ *     - `size_t name_count(name const* v)`
+ *     - `size_t name_capacity(name const* v)`
+ *     - `bool name_reserve(name* v, size_t least_capacity)`
+ *     - `T* name_get(name const* v, size_t i)`
+ *     - `bool name_append(name* v, T item)`
+ *     - `bool name_insert(name* v, size_t i, T item)`
+ *     - `size_t name_remove(name* v, size_t i)`
+ *     - `bool name_push_front(name* v, T item)`
+ *     - `bool name_pop_front(name* v, T* item)` and
+ *       `bool name_pop_back(name* v, T* item)`, where the item pointer can be
+ *       null to just drop the element
+ *     - `size_t name_where(name const* v, T const* item)`
+ *     - `bool name_has(name const* v, T const* item)`
+ *     - `size_t name_where_if(name const* v, bool (*predicate)(T const*))`
+ *     - `bool name_has_if(name const* v, bool (*predicate)(T const*))`
+ *     - `size_t name_remove_all_if(name* v, bool (*predicate)(T const*))`
+ *
+ * Appending while there's room, getting, and predicate searches are done right
+ * in the generated functions. Everything else goes through the generic vector
+ * functions (e.g., `name_where()` goes to `Vec_where()`, which already scans
+ * with SIMD where it can).
+ *
+ * @param name The name of the typed vector type (and the prefix of its
+ * functions)
+ * @param T The element type
+ */
+#define VEC_DEFINE(name, T) \
+    typedef struct name name; \
+    \
+    typedef struct \
+    { \
+        bool (*predicate)(T const*); \
+    } name##_Predicate; \
+    \
+    static inline name* name##_new(size_t const least_capacity) \
+    { \
+        return (name*) (void*) Vec_new(least_capacity, sizeof(T)); \
+    } \
+    \
+    static inline name* name##_new_with(size_t const least_capacity, \
+                                        VecOptions const* options) \
+    { \
+        return (name*) (void*) Vec_new_with(least_capacity, \
+                                            sizeof(T), \
+                                            options); \
+    } \
+    \
+    static inline name* name##_new_inline(void* storage, \
+                                          size_t const storage_size, \
+                                          VecOptions const* options) \
+    { \
+        return (name*) (void*) Vec_new_inline(storage, \
+                                              storage_size, \
+                                              sizeof(T), \
+                                              options); \
+    } \
+    \
+    static inline name* name##_from_vec(Vec* v) \
+    { \
+        if (v == NULL || \
+            Vec_element_size(v) != sizeof(T)) \
+        { \
+            return NULL; \
+        } \
+        return (name*) (void*) v; \
+    } \
+    \
+    static inline Vec* name##_vec(name* v) \
+    { \
+        return (Vec*) (void*) v; \
+    } \
+    \
+    static inline Vec const* name##_vec_const(name const* v) \
+    { \
+        return (Vec const*) (void const*) v; \
+    } \
+    \
+    static inline void name##_destroy(name** v) \
+    { \
+        if (v == NULL) \
+        { \
+            return; \
+        } \
+        Vec* generic = name##_vec(*v); \
+        \
+        Vec_destroy(&generic); \
+        *v = NULL; \
+    } \
+    \
+    static inline size_t name##_count(name const* v) \
+    { \
+        return v != NULL ? VEC_TYPED_HOT(v)->count : 0; \
+    } \
+    \
+    static inline size_t name##_capacity(name const* v) \
+    { \
+        return v != NULL ? VEC_TYPED_HOT(v)->capacity : 0; \
+    } \
+    \
+    static inline bool name##_reserve(name* v, size_t const least_capacity) \
+    { \
+        return Vec_reserve(name##_vec(v), least_capacity); \
+    } \
+    \
+    static inline T* name##_get(name const* v, size_t const i) \
+    { \
+        if (v == NULL || \
+            i >= VEC_TYPED_HOT(v)->count) \
+        { \
+            return NULL; \
+        } \
+        return (T*) (void*) VEC_TYPED_HOT(v)->data + i; \
+    } \
+    \
+    static inline bool name##_append(name* v, T const item) \
+    { \
+        if (v == NULL) \
+        { \
+            return false; \
+        } \
+        VecHot* hot = VEC_TYPED_HOT(v); \
+        \
+        if (hot->count == hot->capacity || \
+            hot->slow_append) \
+        { \
+            /* Let the vector expand (or index, or bound, it). */ \
+            return Vec_append(name##_vec(v), &item, sizeof(T)); \
+        } \
+        memcpy(hot->data + hot->count_bytes, &item, sizeof(T)); \
+        hot->count += 1; \
+        hot->count_bytes += sizeof(T); \
+        return true; \
+    } \
+    \
+    static inline bool name##_insert(name* v, size_t const i, T const item) \
+    { \
+        return Vec_insert(name##_vec(v), i, &item, sizeof(T)); \
+    } \
+    \
+    static inline size_t name##_remove(name* v, size_t const i) \
+    { \
+        return Vec_remove(name##_vec(v), i); \
+    } \
+    \
+    static inline bool name##_push_front(name* v, T const item) \
+    { \
+        return Vec_push_front(name##_vec(v), &item, sizeof(T)); \
+    } \
+    \
+    static inline bool name##_pop_front(name* v, T* item) \
+    { \
+        return Vec_pop_front(name##_vec(v), item, sizeof(T)); \
+    } \
+    \
+    static inline bool name##_pop_back(name* v, T* item) \
+    { \
+        return Vec_pop_back(name##_vec(v), item, sizeof(T)); \
+    } \
+    \
+    static inline size_t name##_where(name const* v, T const* item) \
+    { \
+        return Vec_where(name##_vec_const(v), item, sizeof(T)); \
+    } \
+    \
+    static inline bool name##_has(name const* v, T const* item) \
+    { \
+        return Vec_has(name##_vec_const(v), item, sizeof(T)); \
+    } \
+    \
+    static inline size_t name##_where_if(name const* v, \
+                                         bool (*predicate)(T const*)) \
+    { \
+        if (v == NULL) \
+        { \
+            return 0; \
+        } \
+        if (predicate == NULL) \
+        { \
+            return VEC_TYPED_HOT(v)->count; \
+        } \
+        T const* elements = (T const*) (void const*) VEC_TYPED_HOT(v)->data; \
+        size_t const count = VEC_TYPED_HOT(v)->count; \
+        \
+        for (size_t i = 0; i < count; ++i) \
+        { \
+            if (predicate(&elements[i])) \
+            { \
+                return i; \
+            } \
+        } \
+        return count; \
+    } \
+    \
+    static inline bool name##_has_if(name const* v, \
+                                     bool (*predicate)(T const*)) \
+    { \
+        return v != NULL && \
+               predicate != NULL && \
+               name##_where_if(v, predicate) != VEC_TYPED_HOT(v)->count; \
+    } \
+    \
+    static inline bool name##_call_predicate(void const* element, \
+                                             size_t const element_size, \
+                                             void* context) \
+    { \
+        name##_Predicate const* wrapped = (name##_Predicate const*) context; \
+        \
+        return element_size == sizeof(T) && \
+               wrapped->predicate((T const*) element); \
+    } \
+    \
+    static inline size_t name##_remove_all_if(name* v, \
+                                              bool (*predicate)(T const*)) \
+    { \
+        if (predicate == NULL) \
+        { \
+            return 0; \
+        } \
+        name##_Predicate wrapped; \
+        \
+        wrapped.predicate = predicate; \
+        \
+        return Vec_remove_all_if_ctx(name##_vec(v), \
+                                     name##_call_predicate, \
+                                     &wrapped); \
+    }
+
+/**
+ * @def
+ * The partition size under which a typed introsort switches to insertion sort
+ */
+#define VEC_TYPED_INSERTION_SORT_MAX ((size_t) 16)
+
+/**
+ * @def
+ * Generates `bool name_sort(name* v)` for a typed vector generated by
+ * `VEC_DEFINE(name, T)`, which sorts the vector in ascending order according to
+ * the given "less than" comparison
+ *
+ * The sort is an introsort: a quicksort (with median-of-three pivots) that
+ * switches to insertion sort for small partitions and to heapsort if the
+ * partitioning goes too deep, so it never takes more than O(n log n) time. It
+ * isn't stable.
+ *
+ * Since the comparison is given to the generator (as the name of a function, or
+ * of a function-like macro, taking two `T const*`s and returning whether the
+ * first element is less than the second), it's inlined into the sort, unlike
+ * the comparator function pointer that `Vec_qsort()` calls for every
+ * comparison.
+ *
+ * ```
+ * VEC_DEFINE(I64Vec, int64_t)
+ *
+ * #define I64_LESS(a, b) (*(a) < *(b))
+ * VEC_DEFINE_SORT(I64Vec, int64_t, I64_LESS)
+ *
+ * I64Vec_sort(v);
+ * ```
+ *
+ * If the vector pointer is null, the generated function returns false.
+ *
+ * WARNING: This may invalidate stored pointers or indices! After elements are
+ * re-ordered by the sort, pre-existing pointers or indices may no longer
+ * correspond to the elements they did before the sort!
+ *
+ * @param name The name of the typed vector (as given to `VEC_DEFINE()`)
+ * @param T The element type (as given to `VEC_DEFINE()`)
+ * @param less The "less than" comparison
+ */
+#define VEC_DEFINE_SORT(name, T, less) \
+    static inline void name##_swap_elements(T* a, T* b) \
+    { \
+        T const temp = *a; \
+        \
+        *a = *b; \
+        *b = temp; \
+    } \
+    \
+    static inline void name##_insertion_sort(T* a, size_t const n) \
+    { \
+        for (size_t i = 1; i < n; ++i) \
+        { \
+            T const moving = a[i]; \
+            size_t j = i; \
+            \
+            while (j > 0 && less(&moving, &a[j - 1])) \
+            { \
+                a[j] = a[j - 1]; \
+                --j; \
+            } \
+            a[j] = moving; \
+        } \
+    } \
+    \
+    static inline void name##_sift_down(T* a, size_t root, size_t const n) \
+    { \
+        while (2 * root + 1 < n) \
+        { \
+            size_t child = 2 * root + 1; \
+            \
+            if (child + 1 < n && less(&a[child], &a[child + 1])) \
+            { \
+                ++child; \
+            } \
+            if (!less(&a[root], &a[child])) \
+            { \
+                return; \
+            } \
+            name##_swap_elements(&a[root], &a[child]); \
+            root = child; \
+        } \
+    } \
+    \
+    static inline void name##_heap_sort(T* a, size_t const n) \
+    { \
+        for (size_t i = n / 2; i > 0; --i) \
+        { \
+            name##_sift_down(a, i - 1, n); \
+        } \
+        for (size_t end = n; end > 1; --end) \
+        { \
+            name##_swap_elements(&a[0], &a[end - 1]); \
+            name##_sift_down(a, 0, end - 1); \
+        } \
+    } \
+    \
+    static inline void name##_introsort(T* a, size_t n, size_t depth) \
+    { \
+        while (n > VEC_TYPED_INSERTION_SORT_MAX) \
+        { \
+            if (depth == 0) \
+            { \
+                /* Partitioning's gone too deep; avoid quadratic time. */ \
+                name##_heap_sort(a, n); \
+                return; \
+            } \
+            --depth; \
+            \
+            /* Order the first, middle, and last; the middle's the pivot. */ \
+            size_t const mid = n / 2; \
+            \
+            if (less(&a[mid], &a[0])) \
+            { \
+                name##_swap_elements(&a[mid], &a[0]); \
+            } \
+            if (less(&a[n - 1], &a[0])) \
+            { \
+                name##_swap_elements(&a[n - 1], &a[0]); \
+            } \
+            if (less(&a[n - 1], &a[mid])) \
+            { \
+                name##_swap_elements(&a[n - 1], &a[mid]); \
+            } \
+            T const pivot = a[mid]; \
+            size_t i = 0; \
+            size_t j = n - 1; \
+            \
+            while (true) \
+            { \
+                while (less(&a[i], &pivot)) \
+                { \
+                    ++i; \
+                } \
+                while (less(&pivot, &a[j])) \
+                { \
+                    --j; \
+                } \
+                if (i >= j) \
+                { \
+                    break; \
+                } \
+                name##_swap_elements(&a[i], &a[j]); \
+                ++i; \
+                --j; \
+            } \
+            \
+            /* Recurse into the smaller side, and loop on the bigger one. */ \
+            if (i < n - i) \
+            { \
+                name##_introsort(a, i, depth); \
+                a += i; \
+                n -= i; \
+            } \
+            else \
+            { \
+                name##_introsort(a + i, n - i, depth); \
+                n = i; \
+            } \
+        } \
+        name##_insertion_sort(a, n); \
+    } \
+    \
+    static inline bool name##_sort(name* v) \
+    { \
+        if (v == NULL) \
+        { \
+            return false; \
+        } \
+        T* elements = (T*) (void*) VEC_TYPED_HOT(v)->data; \
+        size_t const count = VEC_TYPED_HOT(v)->count; \
+        size_t depth = 0; \
+        \
+        /* Allow twice the depth of perfectly balanced partitioning. */ \
+        for (size_t n = count; n > 1; n /= 2) \
+        { \
+            depth += 2; \
+        } \
+        name##_introsort(elements, count, depth); \
+        \
+        /* The elements moved, so their index (if any) has to be rebuilt. */ \
+        return Vec_reindex(name##_vec(v)); \
+    }
+
+#endif
@@ -1,483 +1,2782 @@
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
+#include <cmath>
+#include <cstdint>
+#include <chrono>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
 #include <string>
-#include <chrono>
-#include <cstdint>
 #include <vector>
-#include <time.h>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 extern "C"
 {
     #include "../Vec.h"
+    #include "../VecTyped.h"
+    #include "../VecAligned.h"
+    #include "../VecArena.h"
+    #include "../VecBits.h"
+    #include "../VecConcurrent.h"
+    #include "../VecCursor.h"
+    #include "../VecPool.h"
+    #include "../VecSeg.h"
+    #include "../VecSoA.h"
+}
+
+VEC_DEFINE(I64Vec, int64_t)
+
+/*
+ * Usage: ./benchmark.exe [option...]
+ *
+ * Every benchmark is run at every element size and count (n) in the sweep,
+ * against both the vector (or a companion container or allocator, like
+ * `VecSeg` or `VecPool`) and its closest C++ counterpart. Each one is run a
+ * few times first, untimed, to warm up the caches and the allocator, then
+ * timed over a number of repetitions, and the repetitions' median, 95th
+ * percentile, and standard deviation are reported.
+ *
+ *     --reps=N            Timed repetitions of each benchmark (default 11)
+ *     --warmup=N          Untimed runs before those (default 2)
+ *     --sizes=N,N,...     Element counts to sweep over (default 1e2 to 1e6)
+ *     --element-sizes=... Element sizes to sweep over, out of 1, 8, 64, and
+ *                         256 bytes (default all of them)
+ *     --ops=OP,OP,...     The benchmarks to run (default all of them)
+ *     --format=FORMAT     `text` (default), `csv`, or `json`
+ *     --baseline=FILE     A CSV file from an earlier run to compare against
+ *     --threshold=PCT     How much slower than the baseline counts as a
+ *                         regression (default 10)
+ *     --max-bytes=BYTES   Skip benchmarks whose elements would take more than
+ *                         this (default 256 MiB)
+ *     --list              List the benchmarks, and exit
+ *
+ * With a baseline, the exit status is 1 if any benchmark regressed.
+ */
+
+/**
+ * @brief Every benchmark folds something from its results into this, so that
+ * the compiler can't optimize the timed work out (without having to print it)
+ */
+static volatile uint64_t sink = 0;
+
+static void consume(const void* bytes)
+{
+    sink = sink + *(const uint8_t*) bytes;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static double seconds_since(const Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
 }
 
-static void print_my_vec_i64(const Vec* v, const size_t size)
+
+
+
+/*
+ * Elements of every size have a key in their first 8 bytes (or, for 1-byte
+ * elements, their only byte). Keys never have every bit set, so an element of
+ * all 1 bits is never in a vector, and searching for it scans everything.
+ */
+static uint64_t key_of(const void* element, const size_t k)
 {
-    if (v == nullptr)
+    if (k == 1)
     {
-        return;
+        return *(const uint8_t*) element;
     }
 
-    std::cerr << "My vector   ";
-    for (int i = 0; i < size; ++i)
-    {
-        const int64_t* probe = (const int64_t*) Vec_get(v, i);
+    uint64_t key = 0;
 
-        if (probe == nullptr)
-        {
-            std::cerr << "\nNull element pointer!\n";
-            exit(EXIT_FAILURE);
-        }
+    memcpy(&key, element, sizeof(key));
 
-        std::cerr << "[" << *probe << "]";
-    }
-    std::cerr << "\n";
+    return key;
 }
 
-static void print_std_vec_i64(const std::vector<int64_t>& v)
+static void make_element(uint8_t* element, const size_t k, const uint64_t i)
 {
-    std::cerr << "std::vector ";
-    for (int64_t i : v)
+    memset(element, 0, k);
+    if (k == 1)
+    {
+        element[0] = (uint8_t) (i % 255);
+    }
+    else
     {
-        std::cerr << "[" << i << "]";
+        memcpy(element, &i, sizeof(i));
     }
-    std::cerr << "\n";
 }
 
-static void report_times(const std::string bench_description,
-                        const std::chrono::duration<double> Vec_time,
-                        const std::chrono::duration<double> std_vec_time)
+static void make_absent_element(uint8_t* element, const size_t k)
 {
-    const std::chrono::duration<double, std::milli> Vec_ms = Vec_time;
-    const std::chrono::duration<double, std::milli> std_vec_ms = std_vec_time;
+    memset(element, 0xFF, k);
+}
+
+/**
+ * @brief Scrambles the given index into a random-looking (but repeatable) key
+ */
+static uint64_t scramble(uint64_t i)
+{
+    // (The SplitMix64 finalizer, then a shift so the key is never all 1s)
+    i = (i ^ (i >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    i = (i ^ (i >> 27)) * 0x94D049BB133111EBULL;
 
-    std::cout << "##########################################\n";
-    std::cout << bench_description;
-    std::cout << "\n\t     My Vec: " << Vec_ms.count() << " ms";
-    std::cout << "\n\tstd::vector: " << std_vec_ms.count() << " ms";
-    std::cout << "\n\nWINNER: " << (Vec_ms.count() < std_vec_ms.count() ? "My Vec" : "std::vector") << '\n';
-    std::cout << std::endl;
+    return (i ^ (i >> 31)) >> 1;
 }
 
+static int compare_key_1(const void* a, const void* b)
+{
+    const uint64_t key_a = key_of(a, 1);
+    const uint64_t key_b = key_of(b, 1);
+
+    return (key_a > key_b) - (key_a < key_b);
+}
 
+static int compare_key_8(const void* a, const void* b)
+{
+    const uint64_t key_a = key_of(a, 8);
+    const uint64_t key_b = key_of(b, 8);
 
+    return (key_a > key_b) - (key_a < key_b);
+}
 
-static std::chrono::duration<double> append_my_vec(const size_t n)
+static bool key_even(const void* element, const size_t element_size)
 {
-    size_t pre_append_cap = 0;
-    Vec* v = Vec_new(n, sizeof(int64_t));
+    return key_of(element, element_size) % 2 == 0;
+}
 
-    assert(v != nullptr);
-    pre_append_cap = Vec_capacity(v);
+static bool key_absent(const void* element, const size_t element_size)
+{
+    return key_of(element, element_size) ==
+           (element_size == 1 ? 0xFF : UINT64_MAX);
+}
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+#define UNUSED(x) (void)(x)
 
-    for (int64_t i = 0; (size_t) i < n; ++i)
-    {
-        Vec_append(v, &i, sizeof(i));
-    }
+static int bump_key(void* element, const size_t element_size, void* state)
+{
+    UNUSED(element_size);
+    UNUSED(state);
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    *(uint8_t*) element += 1;
 
-    assert(Vec_capacity(v) == pre_append_cap); // Vector did not resize
-    assert(Vec_count(v) == n); // All elements were added
+    return 0; // Continue to the next element.
+}
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_my_vec_i64(v, Vec_count(v));
 
-    Vec_destroy(&v);
 
-    return end - start;
+
+/*
+ * The vector's benchmarks
+ */
+static Vec* Vec_of_sequence(const size_t n,
+                            const size_t k,
+                            const bool scrambled)
+{
+    Vec* v = Vec_new(n, k);
+    uint8_t element[256];
+
+    assert(v != nullptr);
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, scrambled ? scramble(i) : i);
+        Vec_append(v, element, k);
+    }
+    assert(Vec_count(v) == n);
+
+    return v;
 }
 
-static std::chrono::duration<double> append_std_vec(const size_t n)
+static double Vec_append_reserved(const size_t n, const size_t k)
 {
-    size_t pre_append_cap = 0;
-    std::vector<int64_t> v;
+    Vec* v = Vec_new(n, k);
+    uint8_t element[256];
 
-    v.reserve(n);
-    pre_append_cap = v.capacity();
+    assert(v != nullptr);
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    const Clock::time_point start = Clock::now();
 
-    for (int64_t i = 0; (size_t) i < n; ++i)
+    for (size_t i = 0; i < n; ++i)
     {
-        v.push_back(i);
+        make_element(element, k, i);
+        Vec_append(v, element, k);
     }
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
-
-    assert(v.capacity() == pre_append_cap); // Vector did not resize
-    assert(v.size() == n); // All elements were added
+    const double seconds = seconds_since(start);
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_std_vec_i64(v);
+    assert(Vec_count(v) == n);
+    consume(Vec_get(v, n - 1));
+    Vec_destroy(&v);
 
-    return end - start;
+    return seconds;
 }
 
-static void append(const size_t n)
+static double Vec_append_growing(const size_t n, const size_t k)
 {
-    report_times("Append",
-                 append_my_vec(n),
-                 append_std_vec(n));
-}
+    Vec* v = Vec_new(1, k);
+    uint8_t element[256];
 
+    assert(v != nullptr);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, i);
+        Vec_append(v, element, k);
+    }
 
+    const double seconds = seconds_since(start);
+
+    assert(Vec_count(v) == n);
+    consume(Vec_get(v, n - 1));
+    Vec_destroy(&v);
 
+    return seconds;
+}
 
-static std::chrono::duration<double> append_with_resize_my_vec(const size_t n)
+static double I64Vec_append_reserved(const size_t n, const size_t k)
 {
-    size_t pre_resize_cap = 0;
-    Vec* v = Vec_new(n / 2, sizeof(int64_t));
+    UNUSED(k);
+
+    I64Vec* v = I64Vec_new(n);
 
     assert(v != nullptr);
-    pre_resize_cap = Vec_capacity(v);
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    const Clock::time_point start = Clock::now();
 
     for (int64_t i = 0; (size_t) i < n; ++i)
     {
-        Vec_append(v, &i, sizeof(i));
+        I64Vec_append(v, i);
     }
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    const double seconds = seconds_since(start);
+
+    assert(I64Vec_count(v) == n);
+    consume(Vec_get(I64Vec_vec(v), n - 1));
+    I64Vec_destroy(&v);
+
+    return seconds;
+}
+
+static double Vec_append_n_(const size_t n, const size_t k)
+{
+    Vec* src = Vec_of_sequence(n, k, false);
+    Vec* v = Vec_new(1, k);
+
+    assert(v != nullptr);
+
+    const Clock::time_point start = Clock::now();
 
-    assert(Vec_capacity(v) > pre_resize_cap); // Vector resized
-    assert(Vec_count(v) == n); // All elements were added
+    Vec_append_n(v, Vec_data(src), n, k);
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_my_vec_i64(v, Vec_count(v));
+    const double seconds = seconds_since(start);
 
+    assert(Vec_count(v) == n);
+    consume(Vec_get(v, n - 1));
     Vec_destroy(&v);
+    Vec_destroy(&src);
 
-    return end - start;
+    return seconds;
 }
 
-static std::chrono::duration<double> append_with_resize_std_vec(const size_t n)
+static double Vec_insert_front(const size_t n, const size_t k)
 {
-    size_t pre_resize_cap = 0;
-    std::vector<int64_t> v;
+    Vec* v = Vec_new(n, k);
+    uint8_t element[256];
 
-    v.reserve(n / 2);
-    pre_resize_cap = v.capacity();
+    assert(v != nullptr);
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    const Clock::time_point start = Clock::now();
 
-    for (int64_t i = 0; (size_t) i < n; ++i)
+    for (size_t i = 0; i < n; ++i)
     {
-        v.push_back(i);
+        make_element(element, k, i);
+        Vec_insert(v, 0, element, k);
     }
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
-
-    assert(v.capacity() > pre_resize_cap); // Vector resized
-    assert(v.size() == n); // All elements were added
+    const double seconds = seconds_since(start);
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_std_vec_i64(v);
+    assert(Vec_count(v) == n);
+    consume(Vec_get(v, 0));
+    Vec_destroy(&v);
 
-    return end - start;
+    return seconds;
 }
 
-static void append_with_resize(const size_t n)
+static double Vec_remove_front(const size_t n, const size_t k)
 {
-    report_times("Append with resize",
-                 append_with_resize_my_vec(n),
-                 append_with_resize_std_vec(n));
-}
+    Vec* v = Vec_of_sequence(n, k, false);
 
+    const Clock::time_point start = Clock::now();
 
+    while (Vec_count(v) > 1)
+    {
+        Vec_remove(v, 0);
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(Vec_get(v, 0));
+    Vec_destroy(&v);
 
+    return seconds;
+}
 
-static Vec* Vec_of_n_seq_i64(const size_t n)
+static double Vec_pop_front_(const size_t n, const size_t k)
 {
-    Vec* v = Vec_new(n, sizeof(int64_t));
+    Vec* v = Vec_of_sequence(n, k, false);
+    uint8_t element[256];
 
-    assert(v != nullptr);
+    const Clock::time_point start = Clock::now();
 
-    for (int64_t i = 0; (size_t) i < n; ++i)
+    while (Vec_pop_front(v, element, k))
     {
-        Vec_append(v, &i, sizeof(i));
+        consume(element);
     }
 
-    assert(Vec_count(v) == n); // All elements were added
+    const double seconds = seconds_since(start);
 
-    return v;
+    assert(Vec_count(v) == 0);
+    Vec_destroy(&v);
+
+    return seconds;
 }
 
-static bool even_i64(void const* element, size_t const element_size)
+static double Vec_get_all(const size_t n, const size_t k)
 {
-    if (element == nullptr ||
-        element_size != sizeof(int64_t))
+    Vec* v = Vec_of_sequence(n, k, false);
+    uint64_t sum = 0;
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
     {
-        return false; // Error; return early.
+        sum += *(const uint8_t*) Vec_get(v, i);
     }
 
-    int64_t const* i = (int64_t const*) element; // Cast to the known type.
+    const double seconds = seconds_since(start);
+
+    consume(&sum);
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+static double Vec_has_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
+    uint8_t absent[256];
+
+    make_absent_element(absent, k);
+
+    const Clock::time_point start = Clock::now();
+
+    const bool found = Vec_has(v, absent, k);
+
+    const double seconds = seconds_since(start);
 
-    return *i % 2 == 0;
+    assert(!found);
+    consume(&found);
+    Vec_destroy(&v);
+
+    return seconds;
 }
 
-static std::chrono::duration<double> remove_all_even_my_vec(const size_t n)
+static double Vec_has_if_(const size_t n, const size_t k)
 {
-    Vec* v = Vec_of_n_seq_i64(n);
+    Vec* v = Vec_of_sequence(n, k, false);
+
+    const Clock::time_point start = Clock::now();
+
+    const bool found = Vec_has_if(v, key_absent);
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    const double seconds = seconds_since(start);
+
+    assert(!found);
+    consume(&found);
+    Vec_destroy(&v);
+
+    return seconds;
+}
 
-    const size_t removed = Vec_remove_all_if(v, even_i64);
+static double Vec_remove_all_if_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    const Clock::time_point start = Clock::now();
 
-    assert(n % 2 == 0); // Assuming `n` is even...
-    assert(removed == n / 2); // ...we should've removed half the elts.
+    const size_t removed = Vec_remove_all_if(v, key_even);
 
-    // Print result to make sure operations weren't optimized out.
-    std::cerr << removed << " elements removed from my vector.\n";
+    const double seconds = seconds_since(start);
 
+    consume(&removed);
     Vec_destroy(&v);
 
-    return end - start;
+    return seconds;
 }
 
-static std::vector<int64_t> std_vec_of_n_seq_i64(const size_t n)
+static double Vec_remove_all_masked_(const size_t n, const size_t k)
 {
-    std::vector<int64_t> v;
+    Vec* v = Vec_of_sequence(n, k, false);
+    std::vector<uint64_t> mask((n + 63) / 64, 0);
 
-    for (int64_t i = 0; (size_t) i < n; ++i)
+    // The mask is worked out ahead of time, like a vectorized comparison's.
+    for (size_t i = 0; i < n; ++i)
     {
-        v.push_back(i);
+        if (key_even(Vec_get(v, i), k))
+        {
+            mask[i / 64] |= (uint64_t) 1 << (i % 64);
+        }
     }
 
-    assert(v.size() == n); // All elements were added
+    const Clock::time_point start = Clock::now();
 
-    return v;
+    const size_t removed = Vec_remove_all_masked(v, mask.data(), n);
+
+    const double seconds = seconds_since(start);
+
+    consume(&removed);
+    Vec_destroy(&v);
+
+    return seconds;
 }
 
-static std::chrono::duration<double> remove_all_even_std_vec(const size_t n)
+static double Vec_equal_(const size_t n, const size_t k)
 {
-    std::vector<int64_t> v = std_vec_of_n_seq_i64(n);
+    Vec* a = Vec_of_sequence(n, k, false);
+    Vec* b = Vec_of_sequence(n, k, false);
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
-
-    v.erase(std::remove_if(v.begin(),
-                           v.end(),
-                           [](int64_t& i) { return i % 2 == 0; }),
-            v.end());
+    const Clock::time_point start = Clock::now();
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    const bool equal = Vec_equal(a, b, nullptr);
 
-    assert(n % 2 == 0); // Assuming `n` is even...
-    assert(v.size() == n / 2); // ...we should've removed half the elts.
+    const double seconds = seconds_since(start);
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_std_vec_i64(v);
+    assert(equal);
+    consume(&equal);
+    Vec_destroy(&a);
+    Vec_destroy(&b);
 
-    return end - start;
+    return seconds;
 }
 
-static void remove_all_even(const size_t n)
+static double Vec_qsort_(const size_t n, const size_t k)
 {
-    report_times("Remove all even elements",
-                 remove_all_even_my_vec(n),
-                 remove_all_even_std_vec(n));
-}
+    Vec* v = Vec_of_sequence(n, k, true);
+
+    const Clock::time_point start = Clock::now();
 
+    Vec_qsort(v, (k == 1) ? compare_key_1 : compare_key_8);
 
+    const double seconds = seconds_since(start);
 
+    consume(Vec_get(v, 0));
+    Vec_destroy(&v);
+
+    return seconds;
+}
 
-static std::chrono::duration<double> insert_my_vec(const size_t n)
+static double Vec_apply_(const size_t n, const size_t k)
 {
-    Vec* v = Vec_of_n_seq_i64(n);
-    const int64_t element = 123;
-    const size_t index = 5;
+    Vec* v = Vec_of_sequence(n, k, false);
+
+    const Clock::time_point start = Clock::now();
+
+    Vec_apply(v, bump_key, nullptr);
+
+    const double seconds = seconds_since(start);
+
+    consume(Vec_get(v, n - 1));
+    Vec_destroy(&v);
 
-    assert(n > index); // Assuming `n` is larger than the `index`...
+    return seconds;
+}
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+static double Vec_clone_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
 
-    // ... `n - index` elements should shift to make room for the insertion.
-    Vec_insert(v, index, &element, sizeof(element));
+    const Clock::time_point start = Clock::now();
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    Vec* clone = Vec_clone(v);
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_my_vec_i64(v, Vec_count(v));
+    const double seconds = seconds_since(start);
 
+    assert(clone != nullptr);
+    consume(Vec_get(clone, n - 1));
+    Vec_destroy(&clone);
     Vec_destroy(&v);
 
-    return end - start;
+    return seconds;
 }
 
-static std::chrono::duration<double> insert_std_vec(const size_t n)
+static double Vec_handoff(const size_t n, const size_t k)
 {
-    std::vector<int64_t> v = std_vec_of_n_seq_i64(n);
-    const int64_t element = 123;
-    const size_t index = 5;
+    Vec* source = Vec_of_sequence(n, k, false);
+    size_t count = 0;
+    void* buffer = Vec_release(&source, &count);
 
-    assert(n > index); // Assuming `n` is larger than the `index`...
+    assert(buffer != nullptr);
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    const Clock::time_point start = Clock::now();
 
-    // ... `n - index` elements should shift to make room for the insertion.
-    v.insert(v.begin() + index, element);
+    // Take the buffer in without copying, then hand it back out.
+    Vec* v = Vec_adopt(buffer, count, count, k, nullptr);
+
+    assert(v != nullptr);
+    consume(Vec_get(v, n - 1));
+    buffer = Vec_release(&v, &count);
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    const double seconds = seconds_since(start);
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_std_vec_i64(v);
+    assert(count == n);
+    free(buffer);
 
-    return end - start;
+    return seconds;
 }
 
-static void insert(const size_t n)
+static double Vec_where_(const size_t n, const size_t k)
 {
-    report_times("Insertion",
-                 insert_my_vec(n),
-                 insert_std_vec(n));
+    Vec* v = Vec_of_sequence(n, k, false);
+    uint8_t absent[256];
+
+    make_absent_element(absent, k);
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t where = Vec_where(v, absent, k);
+
+    const double seconds = seconds_since(start);
+
+    assert(where == n);
+    consume(&where);
+    Vec_destroy(&v);
+
+    return seconds;
 }
 
+static double Vec_where_if_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t where = Vec_where_if(v, key_absent);
 
+    const double seconds = seconds_since(start);
+
+    assert(where == n);
+    consume(&where);
+    Vec_destroy(&v);
 
+    return seconds;
+}
 
-static std::chrono::duration<double> find_my_vec(const size_t n,
-                                                 const int64_t element)
+static double Vec_where_if_aligned(const size_t n, const size_t k)
 {
-    Vec* v = Vec_of_n_seq_i64(n);
+    const VecAllocator allocator = VecAligned_allocator(VEC_ALIGNED_HUGE_PAGES);
+    VecOptions options = {};
+
+    options.allocator = &allocator;
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    Vec* v = Vec_new_with(n, k, &options);
+    uint8_t element[256];
+
+    assert(v != nullptr);
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, i);
+        Vec_append(v, element, k);
+    }
 
-    const bool found = Vec_has(v, &element, sizeof(element));
+    const Clock::time_point start = Clock::now();
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    const size_t where = Vec_where_if(v, key_absent);
 
-    // Print result to make sure operations weren't optimized out.
-    std::cerr << "Element found? " << found << "\n";
+    const double seconds = seconds_since(start);
 
+    assert(where == n);
+    consume(&where);
     Vec_destroy(&v);
 
-    return end - start;
+    return seconds;
 }
 
-static std::chrono::duration<double> find_std_vec(const size_t n,
-                                                  const int64_t element)
+static double Vec_insert_middle(const size_t n, const size_t k)
 {
-    std::vector<int64_t> v = std_vec_of_n_seq_i64(n);
+    Vec* v = Vec_new(n, k);
+    uint8_t element[256];
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    assert(v != nullptr);
 
-    auto it = std::find(v.begin(), v.end(), element);
+    const Clock::time_point start = Clock::now();
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, i);
+        Vec_insert(v, Vec_count(v) / 2, element, k);
+    }
 
-    // Print result to make sure operations weren't optimized out.
-    const bool found = (it != std::end(v));
+    const double seconds = seconds_since(start);
 
-    std::cerr << "Element found? " << found << "\n";
+    assert(Vec_count(v) == n);
+    consume(Vec_get(v, n / 2));
+    Vec_destroy(&v);
 
-    return end - start;
+    return seconds;
 }
 
-static void find(const size_t n)
+/*
+ * The multi-element benchmarks insert or remove a quarter as many elements as
+ * there are, spread evenly through them (at every 4th index).
+ */
+static std::vector<size_t> spread_indices(const size_t n)
 {
-    /*
-     * NOTE: This assumes both vectors are constructed with the sequence of
-     * `int64_t` elements `[0, n)`.
-     */
-    srand(time(NULL));
-    const int64_t mid_to_end_element = rand() % (n / 2) + (n / 2);
+    std::vector<size_t> indices;
 
-    report_times("Search for a random element",
-                 find_my_vec(n, mid_to_end_element),
-                 find_std_vec(n, mid_to_end_element));
+    for (size_t i = 0; i < n; i += 4)
+    {
+        indices.push_back(i);
+    }
+
+    return indices;
 }
 
+static double Vec_insert_many_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
+    const std::vector<size_t> indices = spread_indices(n);
+    std::vector<uint8_t> items(indices.size() * k);
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        make_element(&items[i * k], k, i);
+    }
 
+    const Clock::time_point start = Clock::now();
 
+    Vec_insert_many(v, indices.data(), items.data(), indices.size(), k);
 
-#define UNUSED(x) (void)(x)
+    const double seconds = seconds_since(start);
+
+    assert(Vec_count(v) == n + indices.size());
+    consume(Vec_get(v, 0));
+    Vec_destroy(&v);
+
+    return seconds;
+}
 
-static int subtract_self(void* element, size_t const element_size, void* state)
+static double Vec_remove_middle(const size_t n, const size_t k)
 {
-    UNUSED(state);
-    if (element == nullptr ||
-        element_size != sizeof(int64_t))
+    Vec* v = Vec_of_sequence(n, k, false);
+
+    const Clock::time_point start = Clock::now();
+
+    while (Vec_count(v) > 1)
     {
-        return 1; // Error; return early.
+        Vec_remove(v, Vec_count(v) / 2);
     }
 
-    int64_t* i = (int64_t*) element; // Cast to the known type.
+    const double seconds = seconds_since(start);
+
+    consume(Vec_get(v, 0));
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+static double Vec_remove_indices_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
+    const std::vector<size_t> indices = spread_indices(n);
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t removed = Vec_remove_indices(v,
+                                              indices.data(),
+                                              indices.size());
+
+    const double seconds = seconds_since(start);
+
+    assert(removed == indices.size());
+    consume(&removed);
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+/*
+ * The sorted benchmarks' vectors are sorted by key (which, for elements bigger
+ * than 1 byte, the sequence already is).
+ */
+static Vec* Vec_of_sorted(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
 
-    *i -= *i; // Subtract the element from itself.
+    if (k == 1)
+    {
+        Vec_qsort(v, compare_key_1);
+    }
 
-    return 0; // Return success status.
+    return v;
 }
 
-static std::chrono::duration<double> apply_my_vec(const size_t n)
+static double Vec_bsearch_(const size_t n, const size_t k)
 {
-    Vec* v = Vec_of_n_seq_i64(n);
+    Vec* v = Vec_of_sorted(n, k);
+    int (*cmp)(const void*, const void*) =
+        (k == 1) ? compare_key_1 : compare_key_8;
+    uint8_t element[256];
+    size_t found = 0;
+
+    const Clock::time_point start = Clock::now();
+
+    // Look up every element, in a scattered order.
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, scramble(i) % n);
+        found += (Vec_bsearch(v, element, k, cmp) != n);
+    }
+
+    const double seconds = seconds_since(start);
+
+    assert(found == n);
+    consume(&found);
+    Vec_destroy(&v);
+
+    return seconds;
+}
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+static double Vec_insert_sorted_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_new(n, k);
+    int (*cmp)(const void*, const void*) =
+        (k == 1) ? compare_key_1 : compare_key_8;
+    uint8_t element[256];
 
-    Vec_apply(v, subtract_self, nullptr);
+    assert(v != nullptr);
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+    const Clock::time_point start = Clock::now();
 
-    // All the elements were subtracted from themselves so are now zero.
     for (size_t i = 0; i < n; ++i)
     {
-        int64_t* probe = (int64_t*) Vec_get(v, i);
+        make_element(element, k, scramble(i));
+        Vec_insert_sorted(v, element, k, cmp);
+    }
+
+    const double seconds = seconds_since(start);
+
+    assert(Vec_count(v) == n);
+    consume(Vec_get(v, 0));
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+/*
+ * The merge benchmarks merge the odd keys into a vector of the even ones.
+ */
+static std::vector<uint8_t> keys_of_parity(const size_t n,
+                                           const size_t k,
+                                           const uint64_t parity)
+{
+    std::vector<uint8_t> elements(n / 2 * k);
 
-        assert(probe != nullptr);
-        assert(*probe == 0);
+    for (size_t i = 0; i < n / 2; ++i)
+    {
+        make_element(&elements[i * k], k, 2 * i + parity);
+    }
+    if (k == 1)
+    {
+        qsort(elements.data(), n / 2, k, compare_key_1);
     }
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_my_vec_i64(v, Vec_count(v));
+    return elements;
+}
+
+static double Vec_merge_sorted_(const size_t n, const size_t k)
+{
+    const std::vector<uint8_t> evens = keys_of_parity(n, k, 0);
+    const std::vector<uint8_t> odds = keys_of_parity(n, k, 1);
+    Vec* v = Vec_new(n, k);
+
+    assert(v != nullptr);
+    Vec_append_n(v, evens.data(), n / 2, k);
+
+    const Clock::time_point start = Clock::now();
+
+    Vec_merge_sorted(v,
+                     odds.data(),
+                     n / 2,
+                     k,
+                     (k == 1) ? compare_key_1 : compare_key_8);
+
+    const double seconds = seconds_since(start);
 
+    assert(Vec_count(v) == n / 2 * 2);
+    consume(Vec_get(v, 0));
     Vec_destroy(&v);
 
-    return end - start;
+    return seconds;
 }
 
-static std::chrono::duration<double> apply_std_vec(const size_t n)
+static double Vec_radix_sort_(const size_t n, const size_t k)
 {
-    std::vector<int64_t> v = std_vec_of_n_seq_i64(n);
+    Vec* v = Vec_of_sequence(n, k, true);
 
-    auto start = std::chrono::high_resolution_clock::now(); // Start timer
+    const Clock::time_point start = Clock::now();
+
+    Vec_radix_sort(v, 0, (k == 1) ? 1 : 8, false);
+
+    const double seconds = seconds_since(start);
+
+    consume(Vec_get(v, 0));
+    Vec_destroy(&v);
 
-    std::for_each(v.begin(), v.end(), [](int64_t& i) { i -= i; });
+    return seconds;
+}
 
-    auto end = std::chrono::high_resolution_clock::now(); // End timer
+/*
+ * The deduplication benchmarks' vectors have every element twice: next to each
+ * other for `unique`, or scattered for `dedup_hashed`.
+ */
+static Vec* Vec_of_pairs(const size_t n, const size_t k, const bool scrambled)
+{
+    Vec* v = Vec_new(n, k);
+    uint8_t element[256];
 
-    // All the elements were subtracted from themselves so are now zero.
-    for (auto it = v.cbegin(); it != v.cend(); ++it)
+    assert(v != nullptr);
+    for (size_t i = 0; i < n; ++i)
     {
-        assert(*it == 0);
+        make_element(element,
+                     k,
+                     scrambled ? scramble(i % ((n + 1) / 2)) : i / 2);
+        Vec_append(v, element, k);
     }
+    if (!scrambled && k == 1)
+    {
+        Vec_qsort(v, compare_key_1);
+    }
+
+    return v;
+}
+
+static double Vec_unique_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_pairs(n, k, false);
+
+    const Clock::time_point start = Clock::now();
 
-    // Print vector contents to make sure operations weren't optimized out.
-    print_std_vec_i64(v);
+    const size_t removed =
+        Vec_unique(v, (k == 1) ? compare_key_1 : compare_key_8);
 
-    return end - start;
+    const double seconds = seconds_since(start);
+
+    consume(&removed);
+    Vec_destroy(&v);
+
+    return seconds;
 }
 
-static void apply(const size_t n)
+static double Vec_dedup_hashed_(const size_t n, const size_t k)
 {
-    report_times("Applying an operation on all elements",
-                 apply_my_vec(n),
-                 apply_std_vec(n));
+    Vec* v = Vec_of_pairs(n, k, true);
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t removed = Vec_dedup_hashed(v);
+
+    const double seconds = seconds_since(start);
+
+    consume(&removed);
+    Vec_destroy(&v);
+
+    return seconds;
 }
 
-int main()
+static double Vec_reserve_(const size_t n, const size_t k)
 {
-    append(1000000);
-    append_with_resize(1000000);
-    remove_all_even(1000000);
-    insert(1000000);
-    find(1000000);
-    apply(1000000);
+    Vec* v = Vec_of_sequence(n, k, false);
+
+    const Clock::time_point start = Clock::now();
+
+    // (Reserving twice the room moves every element to a new block.)
+    Vec_reserve(v, 2 * n);
+
+    const double seconds = seconds_since(start);
+
+    consume(Vec_get(v, n - 1));
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+static double Vec_shrink_to_fit_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
+
+    Vec_reserve(v, 2 * n);
+
+    const Clock::time_point start = Clock::now();
+
+    Vec_shrink_to_fit(v);
+
+    const double seconds = seconds_since(start);
+
+    consume(Vec_get(v, n - 1));
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+static double Vec_where_key_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
+    const size_t key_size = (k == 1) ? 1 : 8;
+    uint8_t element[256];
+    size_t found = 0;
+
+    Vec_enable_index(v, 0, key_size);
+
+    const Clock::time_point start = Clock::now();
+
+    // Look up every element's key, in a scattered order.
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, scramble(i) % n);
+        found += (Vec_where_key(v, element, key_size) != n);
+    }
+
+    const double seconds = seconds_since(start);
+
+    assert(found == n);
+    consume(&found);
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+/*
+ * The companion containers' (and allocators') benchmarks
+ */
+static double VecSeg_append_growing(const size_t n, const size_t k)
+{
+    VecSeg* v = VecSeg_new(1024, k, nullptr);
+    uint8_t element[256];
+
+    assert(v != nullptr);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, i);
+        VecSeg_append(v, element, k);
+    }
+
+    const double seconds = seconds_since(start);
+
+    assert(VecSeg_count(v) == n);
+    consume(VecSeg_get(v, n - 1));
+    VecSeg_destroy(&v);
+
+    return seconds;
+}
+
+static double VecSeg_get_all(const size_t n, const size_t k)
+{
+    VecSeg* v = VecSeg_new(1024, k, nullptr);
+    uint8_t element[256];
+    uint64_t sum = 0;
+
+    assert(v != nullptr);
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, i);
+        VecSeg_append(v, element, k);
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += *(const uint8_t*) VecSeg_get(v, i);
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(&sum);
+    VecSeg_destroy(&v);
+
+    return seconds;
+}
+
+static double VecConcurrent_append_growing(const size_t n, const size_t k)
+{
+    VecConcurrent* v = VecConcurrent_new(1, k);
+    uint8_t element[256];
+
+    assert(v != nullptr);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, i);
+        VecConcurrent_append(v, element, k);
+    }
+
+    const double seconds = seconds_since(start);
+
+    assert(VecConcurrent_count(v) == n);
+    consume(VecConcurrent_get(v, n - 1));
+    VecConcurrent_destroy(&v);
+
+    return seconds;
+}
+
+static double VecSoA_where_if_(const size_t n, const size_t k)
+{
+    // The key is one column, and the rest of the element (if any), another.
+    const size_t key_size = (k == 1) ? 1 : 8;
+    const VecSoAField fields[] =
+    {
+        { 0, key_size },
+        { key_size, k - key_size }
+    };
+    VecSoA* soa = VecSoA_new(n, k, fields, (k > key_size) ? 2 : 1, nullptr);
+    uint8_t element[256];
+
+    assert(soa != nullptr);
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_element(element, k, i);
+        VecSoA_append(soa, element, k);
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t where = VecSoA_where_if(soa, 0, key_absent);
+
+    const double seconds = seconds_since(start);
+
+    assert(where == n);
+    consume(&where);
+    VecSoA_destroy(&soa);
+
+    return seconds;
+}
+
+static bool key_even_ctx(const void* element,
+                         const size_t element_size,
+                         void* context)
+{
+    UNUSED(context);
+
+    return key_even(element, element_size);
+}
+
+static double VecCursor_filter_(const size_t n, const size_t k)
+{
+    Vec* v = Vec_of_sequence(n, k, false);
+    VecCursor* c = VecCursor_new(v);
+    std::vector<uint8_t> batch(256 * k);
+    size_t passed = 0;
+
+    assert(c != nullptr);
+
+    const Clock::time_point start = Clock::now();
+
+    // Pull the even keys through in batches, like a consumer would.
+    VecCursor_filter(c, key_even_ctx, nullptr);
+    while (!VecCursor_done(c))
+    {
+        passed += VecCursor_next(c, batch.data(), 256, k);
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(&passed);
+    VecCursor_destroy(&c);
+    Vec_destroy(&v);
+
+    return seconds;
+}
+
+static double VecBits_popcount_(const size_t n, const size_t k)
+{
+    UNUSED(k);
+
+    VecBits* b = VecBits_new(n);
+
+    assert(b != nullptr);
+    for (size_t i = 0; i < n; i += 2)
+    {
+        VecBits_set(b, i, true);
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t count = VecBits_popcount(b);
+
+    const double seconds = seconds_since(start);
+
+    assert(count == (n + 1) / 2);
+    consume(&count);
+    VecBits_destroy(&b);
+
+    return seconds;
+}
+
+/*
+ * The small-vector benchmarks fill and drop n / 16 vectors of 16 elements each
+ * (grown from 1), one after another, the way a caller handling many small
+ * requests would.
+ */
+static const size_t small_count = 16;
+
+static void fill_small(Vec* v, const size_t k, const size_t first)
+{
+    uint8_t element[256];
+
+    assert(v != nullptr);
+    for (size_t i = 0; i < small_count; ++i)
+    {
+        make_element(element, k, first + i);
+        Vec_append(v, element, k);
+    }
+    consume(Vec_get(v, small_count - 1));
+}
+
+static double Vec_small_vectors(const size_t n, const size_t k)
+{
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n / small_count; ++i)
+    {
+        Vec* v = Vec_new(1, k);
+
+        fill_small(v, k, i);
+        Vec_destroy(&v);
+    }
+
+    return seconds_since(start);
+}
+
+static double VecPool_small_vectors(const size_t n, const size_t k)
+{
+    VecPool* pool = VecPool_new();
+    const VecAllocator allocator = VecPool_allocator(pool);
+    VecOptions options = {};
+
+    assert(pool != nullptr);
+    options.allocator = &allocator;
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n / small_count; ++i)
+    {
+        Vec* v = Vec_new_with(1, k, &options);
+
+        fill_small(v, k, i);
+        Vec_destroy(&v);
+    }
+
+    const double seconds = seconds_since(start);
+
+    VecPool_destroy(&pool);
+
+    return seconds;
+}
+
+static double VecArena_small_vectors(const size_t n, const size_t k)
+{
+    VecArena* arena = VecArena_new(0);
+    const VecAllocator allocator = VecArena_allocator(arena);
+    VecOptions options = {};
+
+    assert(arena != nullptr);
+    options.allocator = &allocator;
+
+    const Clock::time_point start = Clock::now();
+
+    // The vectors aren't destroyed, just released by a reset after every 64
+    // of them (like after each request).
+    for (size_t i = 0; i < n / small_count; ++i)
+    {
+        Vec* v = Vec_new_with(1, k, &options);
+
+        fill_small(v, k, i);
+        if (i % 64 == 63)
+        {
+            VecArena_reset(arena);
+        }
+    }
+    VecArena_reset(arena);
+
+    const double seconds = seconds_since(start);
+
+    VecArena_destroy(&arena);
+
+    return seconds;
+}
+
+
+
+
+/*
+ * The C++ counterparts, for elements of each size
+ */
+template <size_t K>
+struct Element
+{
+    uint8_t bytes[K];
+
+    bool operator==(const Element& other) const
+    {
+        return memcmp(bytes, other.bytes, K) == 0;
+    }
+};
+
+template <size_t K>
+static Element<K> element_of(const uint64_t i)
+{
+    Element<K> e;
+
+    make_element(e.bytes, K, i);
+
+    return e;
+}
+
+template <size_t K>
+static std::vector<Element<K>> std_of_sequence(const size_t n,
+                                               const bool scrambled)
+{
+    std::vector<Element<K>> v;
+
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v.push_back(element_of<K>(scrambled ? scramble(i) : i));
+    }
+
+    return v;
+}
+
+template <size_t K>
+static double std_append_reserved_of(const size_t n)
+{
+    std::vector<Element<K>> v;
+
+    v.reserve(n);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        v.push_back(element_of<K>(i));
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(v.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_append_growing_of(const size_t n)
+{
+    std::vector<Element<K>> v;
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        v.push_back(element_of<K>(i));
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(v.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_append_n_of(const size_t n)
+{
+    const std::vector<Element<K>> src = std_of_sequence<K>(n, false);
+    std::vector<Element<K>> v;
+
+    const Clock::time_point start = Clock::now();
+
+    v.insert(v.end(), src.begin(), src.end());
+
+    const double seconds = seconds_since(start);
+
+    consume(v.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_insert_front_of(const size_t n)
+{
+    std::vector<Element<K>> v;
+
+    v.reserve(n);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        v.insert(v.begin(), element_of<K>(i));
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(v.front().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_remove_front_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    while (v.size() > 1)
+    {
+        v.erase(v.begin());
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(v.front().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_pop_front_of(const size_t n)
+{
+    const std::vector<Element<K>> src = std_of_sequence<K>(n, false);
+    std::deque<Element<K>> q(src.begin(), src.end());
+
+    const Clock::time_point start = Clock::now();
+
+    while (!q.empty())
+    {
+        consume(q.front().bytes);
+        q.pop_front();
+    }
+
+    return seconds_since(start);
+}
+
+template <size_t K>
+static double std_get_all_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+    uint64_t sum = 0;
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += v[i].bytes[0];
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(&sum);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_has_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+    Element<K> absent;
+
+    make_absent_element(absent.bytes, K);
+
+    const Clock::time_point start = Clock::now();
+
+    const bool found = std::find(v.begin(), v.end(), absent) != v.end();
+
+    const double seconds = seconds_since(start);
+
+    assert(!found);
+    consume(&found);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_has_if_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    const bool found = std::find_if(v.begin(),
+                                    v.end(),
+                                    [](const Element<K>& e)
+                                    {
+                                        return key_absent(e.bytes, K);
+                                    }) != v.end();
+
+    const double seconds = seconds_since(start);
+
+    assert(!found);
+    consume(&found);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_remove_all_if_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    v.erase(std::remove_if(v.begin(),
+                           v.end(),
+                           [](const Element<K>& e)
+                           {
+                               return key_even(e.bytes, K);
+                           }),
+            v.end());
+
+    const double seconds = seconds_since(start);
+
+    const size_t remaining = v.size();
+
+    consume(&remaining);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_equal_of(const size_t n)
+{
+    const std::vector<Element<K>> a = std_of_sequence<K>(n, false);
+    const std::vector<Element<K>> b = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    const bool equal = (a == b);
+
+    const double seconds = seconds_since(start);
+
+    assert(equal);
+    consume(&equal);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_qsort_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, true);
+
+    const Clock::time_point start = Clock::now();
+
+    std::sort(v.begin(),
+              v.end(),
+              [](const Element<K>& a, const Element<K>& b)
+              {
+                  return key_of(a.bytes, K) < key_of(b.bytes, K);
+              });
+
+    const double seconds = seconds_since(start);
+
+    consume(v.front().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_apply_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    std::for_each(v.begin(), v.end(), [](Element<K>& e) { e.bytes[0] += 1; });
+
+    const double seconds = seconds_since(start);
+
+    consume(v.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_clone_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    const std::vector<Element<K>> clone(v);
+
+    const double seconds = seconds_since(start);
+
+    consume(clone.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_handoff_of(const size_t n)
+{
+    const std::vector<Element<K>> source = std_of_sequence<K>(n, false);
+    Element<K>* buffer = (Element<K>*) malloc(n * sizeof(Element<K>));
+
+    assert(buffer != nullptr);
+    std::copy(source.begin(), source.end(), buffer);
+
+    const Clock::time_point start = Clock::now();
+
+    // A std::vector can't take over the buffer, so it has to be copied in...
+    std::vector<Element<K>> v(buffer, buffer + n);
+
+    free(buffer);
+    consume(v.back().bytes);
+
+    // ...and copied back out, since a std::vector can't give its storage up.
+    buffer = (Element<K>*) malloc(n * sizeof(Element<K>));
+    assert(buffer != nullptr);
+    std::copy(v.begin(), v.end(), buffer);
+
+    const double seconds = seconds_since(start);
+
+    free(buffer);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_where_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+    Element<K> absent;
+
+    make_absent_element(absent.bytes, K);
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t where = std::find(v.begin(), v.end(), absent) - v.begin();
+
+    const double seconds = seconds_since(start);
+
+    assert(where == n);
+    consume(&where);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_where_if_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t where = std::find_if(v.begin(),
+                                      v.end(),
+                                      [](const Element<K>& e)
+                                      {
+                                          return key_absent(e.bytes, K);
+                                      }) - v.begin();
+
+    const double seconds = seconds_since(start);
+
+    assert(where == n);
+    consume(&where);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_insert_middle_of(const size_t n)
+{
+    std::vector<Element<K>> v;
+
+    v.reserve(n);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        v.insert(v.begin() + v.size() / 2, element_of<K>(i));
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(v[n / 2].bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_insert_many_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+    const std::vector<size_t> indices = spread_indices(n);
+    std::vector<Element<K>> items;
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        items.push_back(element_of<K>(i));
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    // A std::vector has no multi-insert, so the nearest is one merging pass
+    // into a new vector.
+    std::vector<Element<K>> merged;
+
+    merged.reserve(v.size() + items.size());
+    for (size_t i = 0, next = 0; i <= v.size(); ++i)
+    {
+        while (next < indices.size() &&
+               indices[next] == i)
+        {
+            merged.push_back(items[next]);
+            next += 1;
+        }
+        if (i < v.size())
+        {
+            merged.push_back(v[i]);
+        }
+    }
+    v.swap(merged);
+
+    const double seconds = seconds_since(start);
+
+    consume(v.front().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_remove_middle_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    while (v.size() > 1)
+    {
+        v.erase(v.begin() + v.size() / 2);
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(v.front().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_remove_indices_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    // (Every 4th index, like `spread_indices()`'s)
+    size_t i = 0;
+
+    v.erase(std::remove_if(v.begin(),
+                           v.end(),
+                           [&i](const Element<K>&)
+                           {
+                               return i++ % 4 == 0;
+                           }),
+            v.end());
+
+    const double seconds = seconds_since(start);
+
+    const size_t remaining = v.size();
+
+    consume(&remaining);
+
+    return seconds;
+}
+
+template <size_t K>
+static bool key_less(const Element<K>& a, const Element<K>& b)
+{
+    return key_of(a.bytes, K) < key_of(b.bytes, K);
+}
+
+template <size_t K>
+static std::vector<Element<K>> std_of_sorted(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    if (K == 1)
+    {
+        std::sort(v.begin(), v.end(), key_less<K>);
+    }
+
+    return v;
+}
+
+template <size_t K>
+static double std_bsearch_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sorted<K>(n);
+    size_t found = 0;
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Element<K> e = element_of<K>(scramble(i) % n);
+        const typename std::vector<Element<K>>::const_iterator it =
+            std::lower_bound(v.begin(), v.end(), e, key_less<K>);
+
+        found += (it != v.end() && key_of(it->bytes, K) == key_of(e.bytes, K));
+    }
+
+    const double seconds = seconds_since(start);
+
+    assert(found == n);
+    consume(&found);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_insert_sorted_of(const size_t n)
+{
+    std::vector<Element<K>> v;
+
+    v.reserve(n);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Element<K> e = element_of<K>(scramble(i));
+
+        v.insert(std::upper_bound(v.begin(), v.end(), e, key_less<K>), e);
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(v.front().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_merge_sorted_of(const size_t n)
+{
+    const std::vector<uint8_t> evens = keys_of_parity(n, K, 0);
+    const std::vector<uint8_t> odds = keys_of_parity(n, K, 1);
+    const Element<K>* even_elements = (const Element<K>*) evens.data();
+    const Element<K>* odd_elements = (const Element<K>*) odds.data();
+    std::vector<Element<K>> v;
+
+    v.reserve(n);
+    v.insert(v.end(), even_elements, even_elements + n / 2);
+
+    const Clock::time_point start = Clock::now();
+
+    v.insert(v.end(), odd_elements, odd_elements + n / 2);
+    std::inplace_merge(v.begin(), v.begin() + n / 2, v.end(), key_less<K>);
+
+    const double seconds = seconds_since(start);
+
+    consume(v.front().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static std::vector<Element<K>> std_of_pairs(const size_t n,
+                                            const bool scrambled)
+{
+    std::vector<Element<K>> v;
+
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v.push_back(element_of<K>(scrambled ? scramble(i % ((n + 1) / 2))
+                                            : i / 2));
+    }
+    if (!scrambled && K == 1)
+    {
+        std::sort(v.begin(), v.end(), key_less<K>);
+    }
+
+    return v;
+}
+
+template <size_t K>
+static double std_unique_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_pairs<K>(n, false);
+
+    const Clock::time_point start = Clock::now();
+
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+
+    const double seconds = seconds_since(start);
+
+    const size_t remaining = v.size();
+
+    consume(&remaining);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_dedup_hashed_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_pairs<K>(n, true);
+
+    const Clock::time_point start = Clock::now();
+
+    // Keep the first of each element, like `Vec_dedup_hashed()`. (Every
+    // element's bytes are determined by its key, so keys stand in for them.)
+    std::unordered_set<uint64_t> seen;
+
+    seen.reserve(v.size());
+    v.erase(std::remove_if(v.begin(),
+                           v.end(),
+                           [&seen](const Element<K>& e)
+                           {
+                               return !seen.insert(key_of(e.bytes, K)).second;
+                           }),
+            v.end());
+
+    const double seconds = seconds_since(start);
+
+    const size_t remaining = v.size();
+
+    consume(&remaining);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_reserve_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    v.shrink_to_fit();
+
+    const Clock::time_point start = Clock::now();
+
+    v.reserve(2 * n);
+
+    const double seconds = seconds_since(start);
+
+    consume(v.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_shrink_to_fit_of(const size_t n)
+{
+    std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+
+    v.reserve(2 * n);
+
+    const Clock::time_point start = Clock::now();
+
+    v.shrink_to_fit();
+
+    const double seconds = seconds_since(start);
+
+    consume(v.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_where_key_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+    std::unordered_map<uint64_t, size_t> index;
+    size_t found = 0;
+
+    // (Keeping the first element with each key, like `Vec_where_key()` finds)
+    index.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        index.insert(std::make_pair(key_of(v[i].bytes, K), i));
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Element<K> e = element_of<K>(scramble(i) % n);
+
+        found += (index.find(key_of(e.bytes, K)) != index.end());
+    }
+
+    const double seconds = seconds_since(start);
+
+    assert(found == n);
+    consume(&found);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_seg_get_all_of(const size_t n)
+{
+    const std::vector<Element<K>> src = std_of_sequence<K>(n, false);
+    const std::deque<Element<K>> q(src.begin(), src.end());
+    uint64_t sum = 0;
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += q[i].bytes[0];
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(&sum);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_seg_append_growing_of(const size_t n)
+{
+    std::deque<Element<K>> q;
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        q.push_back(element_of<K>(i));
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(q.back().bytes);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_filter_of(const size_t n)
+{
+    const std::vector<Element<K>> v = std_of_sequence<K>(n, false);
+    std::vector<Element<K>> batch;
+    size_t passed = 0;
+
+    batch.reserve(256);
+
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (key_even(v[i].bytes, K))
+        {
+            batch.push_back(v[i]);
+        }
+        if (batch.size() == 256 ||
+            i == n - 1)
+        {
+            passed += batch.size();
+            batch.clear();
+        }
+    }
+
+    const double seconds = seconds_since(start);
+
+    consume(&passed);
+
+    return seconds;
+}
+
+template <size_t K>
+static double std_small_vectors_of(const size_t n)
+{
+    const Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < n / small_count; ++i)
+    {
+        std::vector<Element<K>> v;
+
+        for (size_t j = 0; j < small_count; ++j)
+        {
+            v.push_back(element_of<K>(i + j));
+        }
+        consume(v.back().bytes);
+    }
+
+    return seconds_since(start);
+}
+
+template <size_t K>
+static double std_popcount_of(const size_t n)
+{
+    std::vector<bool> bits(n, false);
+
+    for (size_t i = 0; i < n; i += 2)
+    {
+        bits[i] = true;
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    const size_t count = std::count(bits.begin(), bits.end(), true);
+
+    const double seconds = seconds_since(start);
+
+    assert(count == (n + 1) / 2);
+    consume(&count);
+
+    return seconds;
+}
+
+/*
+ * Picks the instantiation of the given C++ benchmark for the element size
+ * (which is always one of the sizes swept over).
+ */
+#define STD_BENCHMARK(name) \
+    static double name(const size_t n, const size_t k) \
+    { \
+        switch (k) \
+        { \
+            case 1: return name##_of<1>(n); \
+            case 8: return name##_of<8>(n); \
+            case 64: return name##_of<64>(n); \
+            default: return name##_of<256>(n); \
+        } \
+    }
+
+STD_BENCHMARK(std_append_reserved)
+STD_BENCHMARK(std_append_growing)
+STD_BENCHMARK(std_append_n)
+STD_BENCHMARK(std_insert_front)
+STD_BENCHMARK(std_remove_front)
+STD_BENCHMARK(std_pop_front)
+STD_BENCHMARK(std_get_all)
+STD_BENCHMARK(std_has)
+STD_BENCHMARK(std_has_if)
+STD_BENCHMARK(std_remove_all_if)
+STD_BENCHMARK(std_equal)
+STD_BENCHMARK(std_qsort)
+STD_BENCHMARK(std_apply)
+STD_BENCHMARK(std_clone)
+STD_BENCHMARK(std_handoff)
+STD_BENCHMARK(std_where)
+STD_BENCHMARK(std_where_if)
+STD_BENCHMARK(std_insert_middle)
+STD_BENCHMARK(std_insert_many)
+STD_BENCHMARK(std_remove_middle)
+STD_BENCHMARK(std_remove_indices)
+STD_BENCHMARK(std_bsearch)
+STD_BENCHMARK(std_insert_sorted)
+STD_BENCHMARK(std_merge_sorted)
+STD_BENCHMARK(std_unique)
+STD_BENCHMARK(std_dedup_hashed)
+STD_BENCHMARK(std_reserve)
+STD_BENCHMARK(std_shrink_to_fit)
+STD_BENCHMARK(std_where_key)
+STD_BENCHMARK(std_seg_append_growing)
+STD_BENCHMARK(std_seg_get_all)
+STD_BENCHMARK(std_filter)
+STD_BENCHMARK(std_small_vectors)
+STD_BENCHMARK(std_popcount)
+
+
+
+
+/*
+ * The harness
+ */
+struct Benchmark
+{
+    const char* op; // What's being timed
+    const char* impl; // `Vec`, `VecTyped`, a companion like `VecSeg`, or `std`
+    size_t only_element_size; // The one element size it runs at (or 0 for any)
+    bool quadratic; // Whether its time grows with the square of n
+    double (*run)(const size_t n, const size_t k); // Times one repetition
+};
+
+static const Benchmark benchmarks[] =
+{
+    { "append", "Vec", 0, false, Vec_append_reserved },
+    { "append", "VecTyped", 8, false, I64Vec_append_reserved },
+    { "append", "std", 0, false, std_append_reserved },
+    { "append_growing", "Vec", 0, false, Vec_append_growing },
+    { "append_growing", "std", 0, false, std_append_growing },
+    { "append_n", "Vec", 0, false, Vec_append_n_ },
+    { "append_n", "std", 0, false, std_append_n },
+    { "insert_front", "Vec", 0, true, Vec_insert_front },
+    { "insert_front", "std", 0, true, std_insert_front },
+    { "remove_front", "Vec", 0, true, Vec_remove_front },
+    { "remove_front", "std", 0, true, std_remove_front },
+    { "pop_front", "Vec", 0, false, Vec_pop_front_ },
+    { "pop_front", "std", 0, false, std_pop_front },
+    { "get", "Vec", 0, false, Vec_get_all },
+    { "get", "std", 0, false, std_get_all },
+    { "has", "Vec", 0, false, Vec_has_ },
+    { "has", "std", 0, false, std_has },
+    { "has_if", "Vec", 0, false, Vec_has_if_ },
+    { "has_if", "std", 0, false, std_has_if },
+    { "remove_all_if", "Vec", 0, false, Vec_remove_all_if_ },
+    { "remove_all_if", "std", 0, false, std_remove_all_if },
+    { "remove_all_masked", "Vec", 0, false, Vec_remove_all_masked_ },
+    { "equal", "Vec", 0, false, Vec_equal_ },
+    { "equal", "std", 0, false, std_equal },
+    { "qsort", "Vec", 0, false, Vec_qsort_ },
+    { "qsort", "std", 0, false, std_qsort },
+    { "apply", "Vec", 0, false, Vec_apply_ },
+    { "apply", "std", 0, false, std_apply },
+    { "clone", "Vec", 0, false, Vec_clone_ },
+    { "clone", "std", 0, false, std_clone },
+    { "handoff", "Vec", 0, false, Vec_handoff },
+    { "handoff", "std", 0, false, std_handoff },
+    { "where", "Vec", 0, false, Vec_where_ },
+    { "where", "std", 0, false, std_where },
+    { "where_if", "Vec", 0, false, Vec_where_if_ },
+    { "where_if", "VecAligned", 0, false, Vec_where_if_aligned },
+    { "where_if", "VecSoA", 0, false, VecSoA_where_if_ },
+    { "where_if", "std", 0, false, std_where_if },
+    { "insert_middle", "Vec", 0, true, Vec_insert_middle },
+    { "insert_middle", "std", 0, true, std_insert_middle },
+    { "insert_many", "Vec", 0, false, Vec_insert_many_ },
+    { "insert_many", "std", 0, false, std_insert_many },
+    { "remove_middle", "Vec", 0, true, Vec_remove_middle },
+    { "remove_middle", "std", 0, true, std_remove_middle },
+    { "remove_indices", "Vec", 0, false, Vec_remove_indices_ },
+    { "remove_indices", "std", 0, false, std_remove_indices },
+    { "bsearch", "Vec", 0, false, Vec_bsearch_ },
+    { "bsearch", "std", 0, false, std_bsearch },
+    { "insert_sorted", "Vec", 0, true, Vec_insert_sorted_ },
+    { "insert_sorted", "std", 0, true, std_insert_sorted },
+    { "merge_sorted", "Vec", 0, false, Vec_merge_sorted_ },
+    { "merge_sorted", "std", 0, false, std_merge_sorted },
+    { "radix_sort", "Vec", 0, false, Vec_radix_sort_ },
+    { "radix_sort", "std", 0, false, std_qsort },
+    { "unique", "Vec", 0, false, Vec_unique_ },
+    { "unique", "std", 0, false, std_unique },
+    { "dedup_hashed", "Vec", 0, false, Vec_dedup_hashed_ },
+    { "dedup_hashed", "std", 0, false, std_dedup_hashed },
+    { "reserve", "Vec", 0, false, Vec_reserve_ },
+    { "reserve", "std", 0, false, std_reserve },
+    { "shrink_to_fit", "Vec", 0, false, Vec_shrink_to_fit_ },
+    { "shrink_to_fit", "std", 0, false, std_shrink_to_fit },
+    { "where_key", "Vec", 0, false, Vec_where_key_ },
+    { "where_key", "std", 0, false, std_where_key },
+    { "seg_append", "VecSeg", 0, false, VecSeg_append_growing },
+    { "seg_append", "std", 0, false, std_seg_append_growing },
+    { "seg_get", "VecSeg", 0, false, VecSeg_get_all },
+    { "seg_get", "std", 0, false, std_seg_get_all },
+    { "append_growing", "VecConcurrent", 0, false,
+      VecConcurrent_append_growing },
+    { "filter", "VecCursor", 0, false, VecCursor_filter_ },
+    { "filter", "std", 0, false, std_filter },
+    { "small_vectors", "Vec", 0, false, Vec_small_vectors },
+    { "small_vectors", "VecPool", 0, false, VecPool_small_vectors },
+    { "small_vectors", "VecArena", 0, false, VecArena_small_vectors },
+    { "small_vectors", "std", 0, false, std_small_vectors },
+    { "popcount", "VecBits", 1, false, VecBits_popcount_ },
+    { "popcount", "std", 1, false, std_popcount },
+};
+
+static const size_t element_sizes[] = { 1, 8, 64, 256 };
+
+/*
+ * Quadratic benchmarks are skipped where they'd move more than this many
+ * bytes in total (about n * n * k / 2), so a sweep doesn't take hours.
+ */
+static const double quadratic_byte_limit = 4e9;
+
+struct Options
+{
+    size_t reps = 11;
+    size_t warmup = 2;
+    std::vector<size_t> sizes = { 100, 1000, 10000, 100000, 1000000 };
+    std::vector<size_t> element_sizes = { 1, 8, 64, 256 };
+    std::vector<std::string> ops; // (Empty for all of them)
+    std::string format = "text";
+    std::string baseline;
+    double threshold = 10;
+    double max_bytes = 256.0 * 1024 * 1024;
+};
+
+struct Stats
+{
+    double median;
+    double p95;
+    double mean;
+    double stddev;
+    double min;
+};
+
+struct Result
+{
+    std::string op;
+    std::string impl;
+    size_t element_size;
+    size_t n;
+    size_t reps;
+    Stats stats;
+};
+
+static Stats summarize(std::vector<double> samples)
+{
+    Stats s = {};
+    const size_t count = samples.size();
+
+    std::sort(samples.begin(), samples.end());
+    s.min = samples[0];
+    s.median = (count % 2 != 0)
+               ? samples[count / 2]
+               : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+
+    // (The nearest-rank percentile: the smallest sample with 95% at or below)
+    s.p95 = samples[(size_t) std::ceil(0.95 * count) - 1];
+
+    for (double sample : samples)
+    {
+        s.mean += sample;
+    }
+    s.mean /= count;
+
+    for (double sample : samples)
+    {
+        s.stddev += (sample - s.mean) * (sample - s.mean);
+    }
+    s.stddev = (count > 1) ? std::sqrt(s.stddev / (count - 1)) : 0;
+
+    return s;
+}
+
+static std::string key_of_result(const std::string& op,
+                                 const std::string& impl,
+                                 const size_t element_size,
+                                 const size_t n)
+{
+    std::ostringstream key;
+
+    key << op << '/' << impl << '/' << element_size << '/' << n;
+
+    return key.str();
+}
+
+static std::vector<std::string> split(const std::string& list,
+                                      const char delimiter)
+{
+    std::vector<std::string> parts;
+    std::string part;
+    std::istringstream stream(list);
+
+    while (std::getline(stream, part, delimiter))
+    {
+        parts.push_back(part);
+    }
+
+    return parts;
+}
+
+static bool parse_sizes(const std::string& list, std::vector<size_t>& sizes)
+{
+    sizes.clear();
+    for (const std::string& part : split(list, ','))
+    {
+        // (Accepts `1e6` as well as `1000000`.)
+        char* end = nullptr;
+        const double size = strtod(part.c_str(), &end);
+
+        if (end == part.c_str() ||
+            *end != '\0' ||
+            size < 1)
+        {
+            return false;
+        }
+        sizes.push_back((size_t) size);
+    }
+
+    return !sizes.empty();
+}
+
+static bool parse_options(const int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const size_t equals = arg.find('=');
+        const std::string name = arg.substr(0, equals);
+        const std::string value = (equals == std::string::npos)
+                                  ? ""
+                                  : arg.substr(equals + 1);
+
+        if (name == "--reps")
+        {
+            options.reps = strtoul(value.c_str(), nullptr, 10);
+            if (options.reps == 0)
+            {
+                return false;
+            }
+        }
+        else if (name == "--warmup")
+        {
+            options.warmup = strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--sizes")
+        {
+            if (!parse_sizes(value, options.sizes))
+            {
+                return false;
+            }
+        }
+        else if (name == "--element-sizes")
+        {
+            if (!parse_sizes(value, options.element_sizes))
+            {
+                return false;
+            }
+            for (size_t k : options.element_sizes)
+            {
+                const size_t* end = element_sizes + sizeof(element_sizes) /
+                                                    sizeof(element_sizes[0]);
+
+                if (std::find(element_sizes, end, k) == end)
+                {
+                    return false;
+                }
+            }
+        }
+        else if (name == "--ops")
+        {
+            options.ops = split(value, ',');
+        }
+        else if (name == "--format")
+        {
+            options.format = value;
+            if (value != "text" &&
+                value != "csv" &&
+                value != "json")
+            {
+                return false;
+            }
+        }
+        else if (name == "--baseline")
+        {
+            options.baseline = value;
+        }
+        else if (name == "--threshold")
+        {
+            options.threshold = strtod(value.c_str(), nullptr);
+        }
+        else if (name == "--max-bytes")
+        {
+            options.max_bytes = strtod(value.c_str(), nullptr);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Loads the medians from a CSV file written by `--format=csv`, keyed by
+ * `key_of_result()`
+ */
+static bool load_baseline(const std::string& path,
+                          std::map<std::string, double>& medians)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    if (!file ||
+        !std::getline(file, line))
+    {
+        return false;
+    }
+
+    // Find the columns by name, so that added columns don't break old files.
+    const std::vector<std::string> header = split(line, ',');
+    std::map<std::string, size_t> column;
+
+    for (size_t i = 0; i < header.size(); ++i)
+    {
+        column[header[i]] = i;
+    }
+
+    const char* needed[] = { "op", "impl", "element_size", "n", "median_s" };
+
+    for (const char* name : needed)
+    {
+        if (column.count(name) == 0)
+        {
+            return false;
+        }
+    }
+
+    while (std::getline(file, line))
+    {
+        const std::vector<std::string> fields = split(line, ',');
+
+        if (fields.size() < header.size())
+        {
+            continue;
+        }
+
+        const std::string key =
+            key_of_result(fields[column["op"]],
+                          fields[column["impl"]],
+                          strtoul(fields[column["element_size"]].c_str(),
+                                  nullptr, 10),
+                          strtoul(fields[column["n"]].c_str(), nullptr, 10));
+
+        medians[key] = strtod(fields[column["median_s"]].c_str(), nullptr);
+    }
+
+    return true;
+}
+
+static std::string format_seconds(const double seconds)
+{
+    std::ostringstream text;
+
+    text << std::fixed << std::setprecision(3);
+    if (seconds >= 1)
+    {
+        text << seconds << " s";
+    }
+    else if (seconds >= 1e-3)
+    {
+        text << seconds * 1e3 << " ms";
+    }
+    else if (seconds >= 1e-6)
+    {
+        text << seconds * 1e6 << " us";
+    }
+    else
+    {
+        text << seconds * 1e9 << " ns";
+    }
+
+    return text.str();
+}
+
+/**
+ * @brief Gets how much slower (as a percentage, negative if faster) the given
+ * result is than the baseline, if the baseline has it
+ */
+static bool change_from_baseline(const Result& r,
+                                 const std::map<std::string, double>& baseline,
+                                 double& change)
+{
+    const std::map<std::string, double>::const_iterator it =
+        baseline.find(key_of_result(r.op, r.impl, r.element_size, r.n));
+
+    if (it == baseline.end() ||
+        it->second <= 0)
+    {
+        return false;
+    }
+
+    change = (r.stats.median / it->second - 1) * 100;
+
+    return true;
+}
+
+static void print_text(const std::vector<Result>& results,
+                       const std::map<std::string, double>& baseline,
+                       const Options& options)
+{
+    std::map<std::string, double> std_medians;
+
+    for (const Result& r : results)
+    {
+        if (r.impl == "std")
+        {
+            std_medians[key_of_result(r.op, "", r.element_size, r.n)] =
+                r.stats.median;
+        }
+    }
+
+    std::cout << std::left << std::setw(18) << "op"
+              << std::setw(15) << "impl"
+              << std::right << std::setw(5) << "size"
+              << std::setw(11) << "n"
+              << std::setw(13) << "median"
+              << std::setw(13) << "p95"
+              << std::setw(13) << "stddev"
+              << std::setw(11) << "ns/elt"
+              << std::setw(9) << "vs std";
+    if (!options.baseline.empty())
+    {
+        std::cout << std::setw(11) << "vs base";
+    }
+    std::cout << '\n';
+
+    for (const Result& r : results)
+    {
+        std::cout << std::left << std::setw(18) << r.op
+                  << std::setw(15) << r.impl
+                  << std::right << std::setw(5) << r.element_size
+                  << std::setw(11) << r.n
+                  << std::setw(13) << format_seconds(r.stats.median)
+                  << std::setw(13) << format_seconds(r.stats.p95)
+                  << std::setw(13) << format_seconds(r.stats.stddev)
+                  << std::setw(11) << std::fixed << std::setprecision(2)
+                  << r.stats.median * 1e9 / r.n;
+
+        // How many times faster than the C++ counterpart (over 1 is faster)
+        const std::map<std::string, double>::const_iterator std_median =
+            std_medians.find(key_of_result(r.op, "", r.element_size, r.n));
+
+        if (r.impl != "std" &&
+            std_median != std_medians.end())
+        {
+            std::ostringstream ratio;
+
+            ratio << std::fixed << std::setprecision(2)
+                  << std_median->second / r.stats.median << 'x';
+            std::cout << std::setw(9) << ratio.str();
+        }
+        else
+        {
+            std::cout << std::setw(9) << "";
+        }
+
+        double change = 0;
+
+        if (!options.baseline.empty() &&
+            change_from_baseline(r, baseline, change))
+        {
+            std::ostringstream percent;
+
+            percent << std::showpos << std::fixed << std::setprecision(1)
+                    << change << '%';
+            std::cout << std::setw(11) << percent.str();
+            if (change > options.threshold)
+            {
+                std::cout << "  REGRESSED";
+            }
+        }
+        std::cout << '\n';
+    }
+}
+
+static void print_csv(const std::vector<Result>& results,
+                      const std::map<std::string, double>& baseline,
+                      const Options& options)
+{
+    std::cout << "op,impl,element_size,n,reps,"
+                 "median_s,p95_s,mean_s,stddev_s,min_s";
+    if (!options.baseline.empty())
+    {
+        std::cout << ",change_pct";
+    }
+    std::cout << '\n' << std::setprecision(9);
+
+    for (const Result& r : results)
+    {
+        std::cout << r.op << ',' << r.impl << ','
+                  << r.element_size << ',' << r.n << ',' << r.reps << ','
+                  << r.stats.median << ',' << r.stats.p95 << ','
+                  << r.stats.mean << ',' << r.stats.stddev << ','
+                  << r.stats.min;
+
+        double change = 0;
+
+        if (!options.baseline.empty())
+        {
+            std::cout << ',';
+            if (change_from_baseline(r, baseline, change))
+            {
+                std::cout << change;
+            }
+        }
+        std::cout << '\n';
+    }
+}
+
+static void print_json(const std::vector<Result>& results,
+                       const std::map<std::string, double>& baseline,
+                       const Options& options)
+{
+    std::cout << "[\n" << std::setprecision(9);
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+
+        std::cout << "  {\"op\": \"" << r.op << "\", "
+                  << "\"impl\": \"" << r.impl << "\", "
+                  << "\"element_size\": " << r.element_size << ", "
+                  << "\"n\": " << r.n << ", "
+                  << "\"reps\": " << r.reps << ", "
+                  << "\"median_s\": " << r.stats.median << ", "
+                  << "\"p95_s\": " << r.stats.p95 << ", "
+                  << "\"mean_s\": " << r.stats.mean << ", "
+                  << "\"stddev_s\": " << r.stats.stddev << ", "
+                  << "\"min_s\": " << r.stats.min;
+
+        double change = 0;
+
+        if (!options.baseline.empty() &&
+            change_from_baseline(r, baseline, change))
+        {
+            std::cout << ", \"change_pct\": " << change;
+        }
+        std::cout << '}' << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+
+    std::cout << "]\n";
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (argc == 2 &&
+        std::string(argv[1]) == "--list")
+    {
+        for (const Benchmark& b : benchmarks)
+        {
+            std::cout << b.op << ' ' << b.impl << '\n';
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (!parse_options(argc, argv, options))
+    {
+        std::cerr << "Bad option (see the top of benchmark.cpp for usage)\n";
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::string, double> baseline;
+
+    if (!options.baseline.empty() &&
+        !load_baseline(options.baseline, baseline))
+    {
+        std::cerr << "Couldn't read the baseline " << options.baseline << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Result> results;
+
+    for (const Benchmark& b : benchmarks)
+    {
+        if (!options.ops.empty() &&
+            std::find(options.ops.begin(), options.ops.end(), b.op) ==
+            options.ops.end())
+        {
+            continue;
+        }
+
+        for (size_t k : options.element_sizes)
+        {
+            if (b.only_element_size != 0 &&
+                b.only_element_size != k)
+            {
+                continue;
+            }
+
+            for (size_t n : options.sizes)
+            {
+                const double bytes = (double) n * k;
+
+                if (bytes > options.max_bytes ||
+                    (b.quadratic && bytes * n / 2 > quadratic_byte_limit))
+                {
+                    continue;
+                }
+
+                // (Progress goes to stderr, to keep stdout machine-readable.)
+                std::cerr << b.op << ' ' << b.impl << ' '
+                          << k << ' ' << n << '\n';
+
+                for (size_t i = 0; i < options.warmup; ++i)
+                {
+                    b.run(n, k);
+                }
+
+                std::vector<double> samples;
+
+                for (size_t i = 0; i < options.reps; ++i)
+                {
+                    samples.push_back(b.run(n, k));
+                }
+
+                const Result r = { b.op, b.impl, k, n, options.reps,
+                                   summarize(samples) };
+
+                results.push_back(r);
+            }
+        }
+    }
+
+    // Keep each op's runs together, with the C++ counterpart right after.
+    std::stable_sort(results.begin(),
+                     results.end(),
+                     [](const Result& a, const Result& b)
+                     {
+                         if (a.op != b.op)
+                         {
+                             return a.op < b.op;
+                         }
+                         if (a.element_size != b.element_size)
+                         {
+                             return a.element_size < b.element_size;
+                         }
+                         return a.n < b.n;
+                     });
+
+    if (options.format == "csv")
+    {
+        print_csv(results, baseline, options);
+    }
+    else if (options.format == "json")
+    {
+        print_json(results, baseline, options);
+    }
+    else
+    {
+        print_text(results, baseline, options);
+    }
+
+    // With a baseline, any benchmark getting slower fails the run.
+    for (const Result& r : results)
+    {
+        double change = 0;
+
+        if (!options.baseline.empty() &&
+            change_from_baseline(r, baseline, change) &&
+            change > options.threshold)
+        {
+            return 1;
+        }
+    }
 
     return EXIT_SUCCESS;
 }
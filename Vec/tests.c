@@ -1,11 +1,29 @@
+// For `fileno()` under strict C11 (to test saving to file descriptors)
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <stdint.h>
 #include <math.h>
 #include <string.h>
 #include <time.h>
+#include <stdatomic.h>
 
 #include "Vec.h"
+#include "VecArena.h"
+#include "VecPool.h"
+#include "VecTyped.h"
+#include "VecThreads.h"
+#include "VecMmap.h"
+#include "VecIO.h"
+#include "VecConcurrent.h"
+#include "VecShared.h"
+#include "VecSoA.h"
+#include "VecSeg.h"
+#include "VecCursor.h"
+#include "VecBits.h"
+#include "VecAligned.h"
 
 static void test_new(void)
 {
@@ -76,3146 +94,3412 @@ static void test_destroy(void)
     Vec_destroy(NULL);
 }
 
-static void test_where_invalid(void)
+static void test_new_with(void)
 {
-    Vec* v = Vec_new(5, sizeof(int));
+    // Null options are the default options.
+    Vec* v = Vec_new_with(5, sizeof(int), NULL);
 
     assert(v != NULL);
+    assert(Vec_capacity(v) >= 5);
+    assert(Vec_element_size(v) == sizeof(int));
+    Vec_destroy(&v);
 
-    // Since the vector is empty, the number of elements, 0, is returned.
-    assert(0 == Vec_count(v));
-    assert(0 == Vec_where(v, &(int){42}, sizeof(int)));
-
-    // With a null item pointer, the number of elements is returned as well.
-    assert(0 == Vec_where(v, NULL, sizeof(int))); // The number of elements is 0.
-    assert(true == Vec_append(v, &(int){777}, sizeof(int))); // Add an element.
-    // Now the number of elements is 1.
-    assert(1 == Vec_count(v));
-    assert(1 == Vec_where(v, NULL, sizeof(int)));
+    // Ditto with zero-initialized options
+    VecOptions options = {0};
 
-    // Ditto for when the item size differs from the vector's element size.
-    assert(1 == Vec_where(v, &(int){42}, 0));
-    assert(1 == Vec_where(v, &(int){42}, sizeof(int[5])));
+    v = Vec_new_with(5, sizeof(int), &options);
+    assert(v != NULL);
+    Vec_destroy(&v);
 
-    // If the vector pointer is null, 0 is always returned.
-    assert(0 == Vec_where(NULL, &(int){42}, sizeof(int)));
+    // Growing in chunks requires a non-zero chunk.
+    options.growth = VEC_GROWTH_CHUNK;
+    v = Vec_new_with(5, sizeof(int), &options);
+    assert(v == NULL);
 
+    options.growth_chunk = 3;
+    v = Vec_new_with(5, sizeof(int), &options);
+    assert(v != NULL);
     Vec_destroy(&v);
+
+    // An unknown growth policy is invalid.
+    options.growth = (VecGrowth) 12345;
+    v = Vec_new_with(5, sizeof(int), &options);
+    assert(v == NULL);
+
+    // The usual capacity and element size checks still apply.
+    v = Vec_new_with(0, sizeof(int), NULL);
+    assert(v == NULL);
+    v = Vec_new_with(5, 0, NULL);
+    assert(v == NULL);
 }
 
-static void test_where(void)
+/**
+ * @brief Fills the given vector up to its capacity, and then appends one more
+ * element, returning how much the vector's capacity grew by to fit it
+ * @param v A vector of `int`s
+ * @return The capacity added by the expansion
+ */
+static size_t overflow_capacity(Vec* v)
 {
-    Vec* v = Vec_new(5, sizeof(int));
+    while (Vec_count(v) < Vec_capacity(v))
+    {
+        assert(true == Vec_append(v, &(int){0}, sizeof(int)));
+    }
+
+    size_t const full_capacity = Vec_capacity(v);
+
+    assert(true == Vec_append(v, &(int){0}, sizeof(int)));
+    assert(Vec_capacity(v) > full_capacity);
+
+    return Vec_capacity(v) - full_capacity;
+}
+
+static void test_growth(void)
+{
+    // By default, the capacity doubles: 4 -> 8 -> 16
+    Vec* v = Vec_new(4, sizeof(int));
 
     assert(v != NULL);
+    assert(4 == Vec_capacity(v));
+    assert(4 == overflow_capacity(v));
+    assert(8 == overflow_capacity(v));
+    Vec_destroy(&v);
 
-    /*
-     * Find the index of various values in the vector:
-     *
-     * ```
-     * [5][6][6][6][7]
-     *  0  1  2  3  4
-     * ```
-     */
-    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){7}, sizeof(int)));
-    assert(5 == Vec_count(v));
+    // Growing by half: 4 -> 6 -> 9 -> 13
+    VecOptions options = { .growth = VEC_GROWTH_ONE_AND_A_HALF };
 
-    // `5` is at index 0.
-    assert(0 == Vec_where(v, &(int){5}, sizeof(int)));
+    v = Vec_new_with(4, sizeof(int), &options);
+    assert(v != NULL);
+    assert(2 == overflow_capacity(v));
+    assert(3 == overflow_capacity(v));
+    assert(4 == overflow_capacity(v));
+    Vec_destroy(&v);
 
-    // `7` is at index 4.
-    assert(4 == Vec_where(v, &(int){7}, sizeof(int)));
+    // Growing by half from a capacity of 1 still grows: 1 -> 2 -> 3
+    v = Vec_new_with(1, sizeof(int), &options);
+    assert(v != NULL);
+    assert(1 == overflow_capacity(v));
+    assert(1 == overflow_capacity(v));
+    Vec_destroy(&v);
 
-    /*
-     * `6` is at indices 1 through 3, but the first instance, at index 1, is
-     * always the one whose index is returned.
-     */
-    assert(1 == Vec_where(v, &(int){6}, sizeof(int)));
-    assert(1 == Vec_where(v, &(int){6}, sizeof(int)));
-    assert(1 == Vec_where(v, &(int){6}, sizeof(int)));
+    // Growing by chunks of 10: 4 -> 14 -> 24
+    options.growth = VEC_GROWTH_CHUNK;
+    options.growth_chunk = 10;
+    v = Vec_new_with(4, sizeof(int), &options);
+    assert(v != NULL);
+    assert(10 == overflow_capacity(v));
+    assert(10 == overflow_capacity(v));
+    Vec_destroy(&v);
 
-    // The number of elements is returned when an element is not found.
-    assert(Vec_count(v) == Vec_where(v, &(int){42}, sizeof(int)));
+    // Doubling, but by no more than 5 at a time: 4 -> 8 -> 13 -> 18
+    options.growth = VEC_GROWTH_DOUBLE;
+    options.growth_max_step = 5;
+    v = Vec_new_with(4, sizeof(int), &options);
+    assert(v != NULL);
+    assert(4 == overflow_capacity(v));
+    assert(5 == overflow_capacity(v));
+    assert(5 == overflow_capacity(v));
 
+    // The elements survive all that growing.
+    assert(Vec_count(v) == 14);
+    assert(Vec_count(v) == Vec_where(v, &(int){1}, sizeof(int)));
     Vec_destroy(&v);
 }
 
-static void test_where_inner_pointer(void)
+static void test_reserve(void)
 {
-    /*
-     * Make the following vector:
-     *
-     * ```
-     * [9][8][7]
-     *  0  1  2
-     * ```
-     */
-    Vec* v = Vec_new(3, sizeof(uint32_t));
+    Vec* v = Vec_new(2, sizeof(int64_t));
 
     assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
 
-    assert(true == Vec_append(v, &(uint32_t){9}, sizeof(uint32_t)));
-    assert(true == Vec_append(v, &(uint32_t){8}, sizeof(uint32_t)));
-    assert(true == Vec_append(v, &(uint32_t){7}, sizeof(uint32_t)));
-    assert(3 == Vec_count(v));
+    // Reserving no more than the current capacity does nothing.
+    assert(true == Vec_reserve(v, 1));
+    assert(2 == Vec_capacity(v));
+    assert(true == Vec_reserve(v, 2));
+    assert(2 == Vec_capacity(v));
 
-    // Get a pointer to the first element inside the vector.
-    uint32_t* probe = (uint32_t*) Vec_get(v, 0);
+    // Reserving more resizes to exactly that capacity.
+    assert(true == Vec_reserve(v, 1000));
+    assert(1000 == Vec_capacity(v));
 
-    // Verify that the vector correctly reports its location.
-    assert(probe != NULL);
-    assert(0 == Vec_where(v, probe, sizeof(*probe)));
+    // The elements survive reservation.
+    assert(1 == Vec_count(v));
+    assert(0 == Vec_where(v, &(int64_t){7}, sizeof(int64_t)));
 
-    // Ditto for the second element
-    probe = (uint32_t*) Vec_get(v, 1);
-    assert(probe != NULL);
-    assert(1 == Vec_where(v, probe, sizeof(*probe)));
+    // A capacity too huge to represent fails and leaves the vector alone.
+    assert(false == Vec_reserve(v, SIZE_MAX));
+    assert(1000 == Vec_capacity(v));
+    assert(false == Vec_reserve(NULL, 5));
 
-    // Ditto for the third element
-    probe = (uint32_t*) Vec_get(v, 2);
-    assert(probe != NULL);
-    assert(2 == Vec_where(v, probe, sizeof(*probe)));
+    Vec_destroy(&v);
+}
+
+static void test_shrink_to_fit(void)
+{
+    Vec* v = Vec_new(1000, sizeof(int64_t));
+
+    assert(v != NULL);
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    assert(1000 == Vec_capacity(v));
+
+    // Shrinking gives back the excess capacity.
+    assert(true == Vec_shrink_to_fit(v));
+    assert(10 == Vec_capacity(v));
+    assert(10 == Vec_count(v));
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        int64_t const* probe = (int64_t const*) Vec_get(v, (size_t) i);
+
+        assert(probe != NULL);
+        assert(*probe == i);
+    }
+
+    // Shrinking a vector that's already fitted does nothing.
+    assert(true == Vec_shrink_to_fit(v));
+    assert(10 == Vec_capacity(v));
+
+    // The fitted vector expands as usual.
+    assert(true == Vec_append(v, &(int64_t){10}, sizeof(int64_t)));
+    assert(20 == Vec_capacity(v));
+
+    // An empty vector keeps room for one element.
+    while (Vec_count(v) > 0)
+    {
+        Vec_remove(v, 0);
+    }
+    assert(true == Vec_shrink_to_fit(v));
+    assert(1 == Vec_capacity(v));
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+
+    assert(false == Vec_shrink_to_fit(NULL));
 
     Vec_destroy(&v);
 }
 
 /**
- * @brief A predicate that can be used by a vector's search or removal functions
- * to target `int`s less than 3
- * @param element An element provided by the vector when it calls this function
- * @param element_size The size of the element reported by the vector (usable as
- * a size-based "type check" to make sure the element looks like an `int`)
+ * @brief Keeps track of the blocks handed out by a counting allocator
  */
-static bool less_than_three(void const* element, size_t const element_size)
+typedef struct
 {
-    /*
-     * We know we're supposed to be dealing with `int`s.
-     *
-     * If this gets used by a vector with a different element size, the wrong
-     * element size will be passed in by that vector, allowing us to return
-     * early.
-     */
-    size_t const expected_size = sizeof(int);
+    size_t allocations; // Number of blocks currently handed out
+    size_t bytes; // Total size of the blocks currently handed out
+    size_t calls; // Number of calls made to the allocator
+} Counts;
 
-    if (NULL == element ||
-        element_size != expected_size)
+/**
+ * @brief A counting allocator's allocation function
+ */
+static void* counting_allocate(void* context, size_t size)
+{
+    Counts* counts = (Counts*) context;
+
+    counts->calls += 1;
+    counts->allocations += 1;
+    counts->bytes += size;
+
+    return malloc(size);
+}
+
+/**
+ * @brief A counting allocator's reallocation function
+ */
+static void* counting_reallocate(void* context,
+                                 void* block,
+                                 size_t old_size,
+                                 size_t new_size)
+{
+    Counts* counts = (Counts*) context;
+    void* resized = realloc(block, new_size);
+
+    counts->calls += 1;
+    if (resized != NULL)
     {
-        return false; // Error; return early.
+        assert(counts->bytes >= old_size);
+        counts->bytes = counts->bytes - old_size + new_size;
     }
 
-    int const* i = (int const*) element; // Cast to the known type.
+    return resized;
+}
 
-    return *i < 3;
+/**
+ * @brief A counting allocator's deallocation function
+ */
+static void counting_deallocate(void* context, void* block, size_t size)
+{
+    Counts* counts = (Counts*) context;
+
+    assert(counts->allocations > 0);
+    assert(counts->bytes >= size);
+    counts->calls += 1;
+    counts->allocations -= 1;
+    counts->bytes -= size;
+
+    free(block);
 }
 
-static void test_where_if_invalid(void)
+/**
+ * @brief An allocation function that always fails (as if out of memory)
+ */
+static void* failing_allocate(void* context, size_t size)
 {
-    Vec* v = Vec_new(5, sizeof(int16_t));
+    (void) context;
+    (void) size;
 
-    assert(v != NULL);
+    return NULL;
+}
 
-    // Since the vector is empty, the number of elements, 0, is returned.
-    assert(0 == Vec_count(v));
-    assert(0 == Vec_where_if(v, less_than_three));
+/**
+ * @brief A counting allocator's allocation function that fails on every call
+ * to the allocator but its first
+ */
+static void* first_call_allocate(void* context, size_t size)
+{
+    Counts* counts = (Counts*) context;
 
-    // With a null predicate pointer, the number of elements is returned too.
-    assert(0 == Vec_where_if(v, NULL)); // Number of elements is 0
-    // Add an element.
-    assert(true == Vec_append(v, &(int16_t){777}, sizeof(int16_t)));
-    // Now the number of elements is 1.
-    assert(1 == Vec_count(v));
-    assert(1 == Vec_where_if(v, NULL));
+    if (counts->calls > 0)
+    {
+        return NULL;
+    }
+
+    return counting_allocate(context, size);
+}
+
+static void test_allocator_invalid(void)
+{
+    Counts counts = {0};
+    VecAllocator allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = NULL,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+
+    // An allocator missing any of its functions is invalid.
+    assert(NULL == Vec_new_with(5, sizeof(int), &options));
+    allocator.deallocate = counting_deallocate;
+    allocator.reallocate = NULL;
+    assert(NULL == Vec_new_with(5, sizeof(int), &options));
+    allocator.reallocate = counting_reallocate;
+    allocator.allocate = NULL;
+    assert(NULL == Vec_new_with(5, sizeof(int), &options));
+
+    // Nothing was allocated for those.
+    assert(0 == counts.calls);
+}
+
+static void test_allocator(void)
+{
+    Counts counts = {0};
+    Vec* v = NULL;
+
+    {
+        VecAllocator const allocator =
+        {
+            .allocate = counting_allocate,
+            .reallocate = counting_reallocate,
+            .deallocate = counting_deallocate,
+            .context = &counts
+        };
+        VecOptions const options = { .allocator = &allocator };
+
+        v = Vec_new_with(2, sizeof(int64_t), &options);
+    }
 
     /*
-     * Ditto for when the item size differs from the vector's element size.
-     *
-     * First, we'll need a new vector with a different declared element size.
+     * Both the vector and its element block come from the allocator (which
+     * didn't have to outlive the vector's creation).
      */
+    assert(v != NULL);
+    assert(2 == counts.allocations);
+    assert(counts.bytes > 2 * sizeof(int64_t));
+
+    // Expansions go through the allocator, too.
+    size_t const bytes_before = counts.bytes;
+
+    for (int64_t i = 0; i < 100; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    assert(2 == counts.allocations);
+    assert(counts.bytes - bytes_before == Vec_capacity(v) * sizeof(int64_t) -
+                                          2 * sizeof(int64_t));
+
+    // The vector hands its allocator back (and one's context with it).
+    assert(counting_allocate == Vec_allocator(v).allocate);
+    assert(&counts == Vec_allocator(v).context);
+
     Vec_destroy(&v);
-    v = Vec_new(5, sizeof(int64_t));
+
+    // Everything was given back.
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
+
+    // Without an allocator, a vector uses the default one.
+    VecAllocator const default_allocator = Vec_default_allocator();
+
+    v = Vec_new(2, sizeof(int64_t));
     assert(v != NULL);
+    assert(default_allocator.allocate != NULL);
+    assert(default_allocator.allocate == Vec_allocator(v).allocate);
+    assert(default_allocator.reallocate == Vec_allocator(v).reallocate);
+    assert(default_allocator.deallocate == Vec_allocator(v).deallocate);
+    Vec_destroy(&v);
 
-    // Add a few elements.
-    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){9}, sizeof(int64_t)));
-    assert(3 == Vec_count(v));
+    // Large items staged for insertion are allocated from the allocator, too.
+    typedef struct { uint8_t bytes[1000]; } Large;
 
-    /*
-     * Now search for an element of the wrong size.
-     *
-     * `less_than_three()` expects `sizeof(int)` but `Vec_where_if()` will give
-     * it `sizeof(int64_t)`.
-     *
-     * The predicate will then return false for all elements. This is
-     * essentially the same as never finding an element that satisfies the
-     * predicate, causing the number of elements to be returned.
-     */
-    assert(Vec_count(v) == Vec_where_if(v, less_than_three));
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    Large large = {{0}};
 
-    // If the vector pointer is null, 0 is always returned.
-    assert(0 == Vec_where_if(NULL, less_than_three));
+    v = Vec_new_with(4, sizeof(Large), &options);
+    assert(v != NULL);
+    assert(true == Vec_append(v, &large, sizeof(large)));
+
+    size_t const calls_before = counts.calls;
+
+    large.bytes[0] = 1;
+    assert(true == Vec_insert(v, 0, &large, sizeof(large)));
+    assert(calls_before + 2 == counts.calls); // Staged and freed
+    assert(2 == counts.allocations);
 
     Vec_destroy(&v);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
 }
 
-static void test_where_if(void)
+static void test_new_inline_invalid(void)
 {
-    Vec* v = Vec_new(5, sizeof(int));
-    int* probe = NULL;
+    VEC_INLINE_STORAGE(storage, 4, sizeof(int64_t));
+
+    // Null storage
+    assert(NULL == Vec_new_inline(NULL, 1000, sizeof(int64_t), NULL));
+
+    // Element size 0
+    assert(NULL == Vec_new_inline(storage, sizeof(storage), 0, NULL));
+
+    // Storage too small for the vector struct plus one element
+    assert(NULL == Vec_new_inline(storage,
+                                  VEC_HEADER_SIZE,
+                                  sizeof(int64_t),
+                                  NULL));
+    assert(NULL == Vec_new_inline(storage,
+                                  VEC_INLINE_STORAGE_SIZE(1, sizeof(int64_t))
+                                  - 1,
+                                  sizeof(int64_t),
+                                  NULL));
+
+    // Misaligned storage
+    assert(NULL == Vec_new_inline(storage + 1,
+                                  sizeof(storage) - 1,
+                                  sizeof(int64_t),
+                                  NULL));
+
+    // Invalid options
+    VecOptions const options = { .growth = VEC_GROWTH_CHUNK };
+
+    assert(NULL == Vec_new_inline(storage,
+                                  sizeof(storage),
+                                  sizeof(int64_t),
+                                  &options));
+
+    // Allocating the cold state (for non-default options) failed
+    VecAllocator const allocator =
+    {
+        .allocate = failing_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = NULL
+    };
+    VecOptions const failing_options = { .allocator = &allocator };
+
+    assert(NULL == Vec_new_inline(storage,
+                                  sizeof(storage),
+                                  sizeof(int64_t),
+                                  &failing_options));
+}
+
+/**
+ * @brief A struct with an embedded vector, as a caller might have
+ */
+typedef struct
+{
+    int id;
+    VEC_INLINE_STORAGE(storage, 3, sizeof(int64_t));
+} HasInlineVec;
+
+static void test_new_inline(void)
+{
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    HasInlineVec embedding = { .id = 42 };
+    Vec* v = Vec_new_inline(embedding.storage,
+                            sizeof(embedding.storage),
+                            sizeof(int64_t),
+                            &options);
 
     assert(v != NULL);
+    assert(3 == Vec_capacity(v));
+    assert(0 == Vec_count(v));
+    assert(sizeof(int64_t) == Vec_element_size(v));
 
-    /*
-     * Make the following vector:
-     *
-     * ```
-     * [2][5][5][2][1]
-     *  0  1  2  3  4
-     * ```
-     */
-    assert(true == Vec_append(v, &(int){2}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){2}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){1}, sizeof(int)));
-    assert(5 == Vec_count(v));
+    // Only the cold state (for the non-default options) is allocated...
+    assert(1 == counts.calls);
+    assert(1 == counts.allocations);
 
-    // The first element less than 3 should be at index 0.
-    assert(0 == Vec_where_if(v, less_than_three));
-    probe = (int*) Vec_get(v, Vec_where_if(v, less_than_three));
-    assert(probe != NULL);
-    assert(*probe == (int){2});
-    // The same index is returned across repeated calls.
-    assert(0 == Vec_where_if(v, less_than_three));
-    assert(0 == Vec_where_if(v, less_than_three));
-    assert(0 == Vec_where_if(v, less_than_three));
+    // ...and filling the inline storage doesn't allocate anything more.
+    for (int64_t i = 0; i < 3; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    assert(1 == counts.calls);
 
-    // Now remove the element at that index.
-    Vec_remove(v, Vec_where_if(v, less_than_three));
+    // Elements live in the storage.
+    int64_t const* first = (int64_t const*) Vec_get(v, 0);
 
-    /*
-     * The vector now looks like this:
-     *
-     * ```
-     * [5][5][2][1][ ]
-     *  0  1  2  3  4
-     * ```
-     *
-     * So the first element less than 3 should now be at index 2.
-     */
-    assert(2 == Vec_where_if(v, less_than_three));
-    probe = (int*) Vec_get(v, Vec_where_if(v, less_than_three));
-    assert(probe != NULL);
-    assert(*probe == (int){2});
+    assert(first != NULL);
+    assert((void const*) first ==
+           (void const*) (embedding.storage + VEC_HEADER_SIZE));
 
-    // Remove that element as well.
-    Vec_remove(v, Vec_where_if(v, less_than_three));
+    // Nothing to give back while the elements are inline
+    assert(true == Vec_shrink_to_fit(v));
+    assert(3 == Vec_capacity(v));
 
-    /*
-     * The vector now looks like this:
-     *
-     * ```
-     * [5][5][1][ ][ ]
-     *  0  1  2  3  4
-     * ```
-     *
-     * The first element less than 3 should still be at index 2 since it got
-     * shifted to the left.
-     */
-    assert(2 == Vec_where_if(v, less_than_three));
-    probe = (int*) Vec_get(v, Vec_where_if(v, less_than_three));
-    assert(probe != NULL);
-    assert(*probe == (int){1});
+    // Growing past the storage moves the elements out to the allocator...
+    assert(true == Vec_append(v, &(int64_t){3}, sizeof(int64_t)));
+    assert(2 == counts.allocations);
+    assert(6 == Vec_capacity(v));
+    for (int64_t i = 0; i < 4; ++i)
+    {
+        int64_t const* probe = (int64_t const*) Vec_get(v, (size_t) i);
 
-    // Remove that element as well.
-    Vec_remove(v, Vec_where_if(v, less_than_three));
+        assert(probe != NULL && *probe == i);
+    }
 
-    /*
-     * The vector now looks like this:
-     *
-     * ```
-     * [5][5][ ][ ][ ]
-     *  0  1  2  3  4
-     * ```
-     *
-     * There are no more elements less than 3, so the number of elements in the
-     * vector should be returned on the next query.
-     */
-    assert(Vec_count(v) == Vec_where_if(v, less_than_three));
+    // ...and they keep growing out there.
+    for (int64_t i = 4; i < 100; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    assert(2 == counts.allocations);
+    assert(100 == Vec_count(v));
+    assert(true == Vec_shrink_to_fit(v));
+    assert(100 == Vec_capacity(v));
 
+    // Destruction frees the moved elements and the cold state, but not the
+    // storage.
     Vec_destroy(&v);
-}
+    assert(v == NULL);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
+    assert(42 == embedding.id);
 
-static void test_has_invalid(void)
-{
-    Vec* v = Vec_new(5, sizeof(uint16_t));
-    uint16_t const element = 7;
+    // A small vector never allocates anything but its cold state.
+    VEC_INLINE_STORAGE(storage, 16, sizeof(int64_t));
+    size_t const calls_before = counts.calls;
 
+    v = Vec_new_inline(storage, sizeof(storage), sizeof(int64_t), &options);
     assert(v != NULL);
-    assert(true == Vec_append(v, &element, sizeof(element)));
-    assert(Vec_count(v) == 1);
-    assert(true == Vec_has(v, &element, sizeof(uint16_t)));
-
-    // When the item size disagrees with the vector's declared element size
-    assert(false == Vec_has(v, &element, sizeof(uint32_t)));
+    assert(16 == Vec_capacity(v));
+    for (int64_t i = 0; i < 16; ++i)
+    {
+        assert(true == Vec_insert(v, 0, &i, sizeof(i)));
+    }
+    Vec_remove(v, 3);
+    assert(15 == Vec_count(v));
+    assert(0 == Vec_where(v, &(int64_t){15}, sizeof(int64_t)));
+    Vec_destroy(&v);
+    assert(calls_before + 2 == counts.calls);
 
-    // When pointers are null
-    assert(false == Vec_has(v, NULL, sizeof(uint16_t)));
-    assert(false == Vec_has(NULL, &element, sizeof(element)));
-    assert(false == Vec_has(NULL, NULL, sizeof(uint16_t)));
+    // With the default options, an index or hash gets the vector cold state
+    // of its own, which destruction frees.
+    VEC_INLINE_STORAGE(plain_storage, 4, sizeof(int64_t));
 
+    v = Vec_new_inline(plain_storage, sizeof(plain_storage), sizeof(int64_t),
+                       NULL);
+    assert(v != NULL);
+    for (int64_t i = 0; i < 4; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    assert(true == Vec_enable_index(v, 0, sizeof(int64_t)));
+    assert(true == Vec_enable_hash(v));
+    assert(2 == Vec_where_key(v, &(int64_t){2}, sizeof(int64_t)));
+    assert(true == Vec_disable_index(v));
+    assert(true == Vec_disable_hash(v));
+    assert(2 == Vec_where(v, &(int64_t){2}, sizeof(int64_t)));
     Vec_destroy(&v);
 }
 
-static void test_has(void)
+static void test_adopt_invalid(void)
 {
-    /*
-     * Make the following vector:
-     *
-     * ```
-     * [3][5][5][7]
-     *  0  1  2  3
-     * ```
-     */
-    Vec* v = Vec_new(5, sizeof(int));
-    int const first = 3;
-    int const middle = 5;
-    int const last = 7;
+    int64_t* block = malloc(4 * sizeof(int64_t));
 
-    // `false` is returned when searching an empty vector.
-    assert(v != NULL);
-    assert(false == Vec_has(v, &first, sizeof(first)));
+    assert(block != NULL);
 
-    // Add the elements.
-    assert(true == Vec_append(v, &first, sizeof(first)));
-    assert(true == Vec_append(v, &middle, sizeof(middle)));
-    assert(true == Vec_append(v, &middle, sizeof(middle)));
-    assert(true == Vec_append(v, &last, sizeof(last)));
-    assert(Vec_count(v) == 4);
+    // Null block
+    assert(NULL == Vec_adopt(NULL, 0, 4, sizeof(int64_t), NULL));
 
-    // We should find the first element.
-    assert(true == Vec_has(v, &first, sizeof(first)));
+    // Capacity or element size 0
+    assert(NULL == Vec_adopt(block, 0, 0, sizeof(int64_t), NULL));
+    assert(NULL == Vec_adopt(block, 0, 4, 0, NULL));
 
-    // We should find an element in the middle.
-    assert(true == Vec_has(v, &middle, sizeof(middle)));
+    // More elements than capacity
+    assert(NULL == Vec_adopt(block, 5, 4, sizeof(int64_t), NULL));
 
-    // We should find the last element.
-    assert(true == Vec_has(v, &last, sizeof(last)));
+    // Byte size overflow
+    assert(NULL == Vec_adopt(block, 0, SIZE_MAX, sizeof(int64_t), NULL));
 
-    // We should not find elements that aren't in the vector.
-    assert(false == Vec_has(v, &(int){6}, sizeof(int)));
-    assert(false == Vec_has(v, &(int){42}, sizeof(int)));
-    assert(false == Vec_has(v, &(int){13}, sizeof(int)));
+    // Incomplete allocator
+    VecAllocator const allocator = { .allocate = counting_allocate };
 
-    Vec_destroy(&v);
+    assert(NULL == Vec_adopt(block, 0, 4, sizeof(int64_t), &allocator));
+
+    free(block);
 }
 
-static void test_has_inner_pointer(void)
+static void test_adopt(void)
 {
-    /*
-     * Make the following vector:
-     *
-     * ```
-     * [9][8][7]
-     *  0  1  2
-     * ```
-     */
-    Vec* v = Vec_new(3, sizeof(int32_t));
-
-    assert(v != NULL);
-    assert(true == Vec_append(v, &(int32_t){9}, sizeof(int32_t)));
-    assert(true == Vec_append(v, &(int32_t){8}, sizeof(int32_t)));
-    assert(true == Vec_append(v, &(int32_t){7}, sizeof(int32_t)));
-    assert(3 == Vec_count(v));
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    int64_t* block = counting_allocate(&counts, 4 * sizeof(int64_t));
 
-    // Get a pointer to the first element inside the vector.
-    int32_t* probe = (int32_t*) Vec_get(v, 0);
+    assert(block != NULL);
+    block[0] = 10;
+    block[1] = 20;
 
-    // The vector should report possessing the first element.
-    assert(probe != NULL);
-    assert(true == Vec_has(v, probe, sizeof(*probe)));
+    // The vector takes the block (and its first two elements) as it is.
+    Vec* v = Vec_adopt(block, 2, 4, sizeof(int64_t), &allocator);
 
-    // Ditto for the second element
-    probe = (int32_t*) Vec_get(v, 1);
-    assert(probe != NULL);
-    assert(true == Vec_has(v, probe, sizeof(*probe)));
+    assert(v != NULL);
+    assert(2 == counts.allocations); // The block, and the vector struct
+    assert(2 == Vec_count(v));
+    assert(4 == Vec_capacity(v));
+    assert((void const*) block == Vec_data(v));
+    assert(1 == Vec_where(v, &(int64_t){20}, sizeof(int64_t)));
+
+    // Growing past the block reallocates it through the allocator.
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    assert(12 == Vec_count(v));
+    assert(10 == *(int64_t const*) Vec_get(v, 0));
 
-    // Ditto for the third element
-    probe = (int32_t*) Vec_get(v, 2);
-    assert(probe != NULL);
-    assert(true == Vec_has(v, probe, sizeof(*probe)));
+    // Destruction gives the block back to the allocator, too.
+    Vec_destroy(&v);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
 
+    // Without an allocator, the block must have come from `malloc()`.
+    block = malloc(sizeof(int64_t));
+    assert(block != NULL);
+    v = Vec_adopt(block, 0, 1, sizeof(int64_t), NULL);
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
     Vec_destroy(&v);
 }
 
-static void test_has_if_invalid(void)
+static void test_release_invalid(void)
 {
-    Vec* v = Vec_new(5, sizeof(uint16_t));
-    uint16_t const element = 2;
-
-    assert(v != NULL);
-    assert(true == Vec_append(v, &element, sizeof(element)));
-    assert(Vec_count(v) == 1);
-    assert(true == Vec_has(v, &element, sizeof(uint16_t)));
+    Vec* v = NULL;
+    size_t count = 42;
 
-    /*
-     * Search for an element of the wrong size.
-     *
-     * `less_than_three()` expects `sizeof(int)` but `Vec_where_if()` will give
-     * it `sizeof(uint16_t)`.
-     *
-     * The predicate will then return false for all elements. This is
-     * essentially the same as never finding an element that satisfies the
-     * predicate, so we expect to always get back false.
-     */
-    assert(false == Vec_has_if(v, less_than_three));
+    // Null double pointer, or null vector
+    assert(NULL == Vec_release(NULL, &count));
+    assert(NULL == Vec_release(&v, &count));
+    assert(42 == count);
 
-    // When pointers are null
-    assert(false == Vec_has_if(v, NULL));
-    assert(false == Vec_has_if(NULL, less_than_three));
-    assert(false == Vec_has_if(NULL, NULL));
+    // Copying inline elements out failed (after the cold state was allocated).
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = first_call_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    VEC_INLINE_STORAGE(storage, 4, sizeof(int64_t));
 
+    v = Vec_new_inline(storage, sizeof(storage), sizeof(int64_t), &options);
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+    assert(NULL == Vec_release(&v, &count));
+    assert(v != NULL); // The vector is left alone.
+    assert(1 == Vec_count(v));
     Vec_destroy(&v);
+    assert(0 == counts.allocations);
 }
 
-static void test_has_if_helper(Vec* v, size_t const n, size_t const X_index)
+static void test_release(void)
 {
-    /*
-     * Make a vector that looks like this
-     *
-     * ```
-     * [X][y][y][y]
-     *  0  1  2  3
-     * ```
-     *
-     * where `X` is an element we're searching for via the `less_than_three()`
-     * predicate (so, `X` is some `int` less than 3) at whatever `X_index` is
-     * and `y` is any other element.
-     */
-    int const X = -2;
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    Vec* v = Vec_new_with(8, sizeof(int64_t), &options);
 
-    // Add `n` elements, among them one `X` at `X_index`.
-    for (size_t i = 0; i < n; ++i)
+    assert(v != NULL);
+    for (int64_t i = 0; i < 5; ++i)
     {
-        if (i == X_index)
-        {
-            assert(true == Vec_append(v, &X, sizeof(X)));
-        }
-        else
-        {
-            assert(true == Vec_append(v, &(int){5}, sizeof(int)));
-        }
+        assert(true == Vec_append(v, &i, sizeof(i)));
     }
+    assert(true == Vec_enable_index(v, 0, sizeof(int64_t)));
 
-    // Check vector content.
-    assert(Vec_count(v) == n);
-    for (size_t i = 0; i < Vec_count(v); ++i)
+    // The elements are handed over where they are, and the rest is freed.
+    void const* data = Vec_data(v);
+    size_t const capacity = Vec_capacity(v);
+    size_t count = 0;
+    int64_t* elements = Vec_release(&v, &count);
+
+    assert(v == NULL);
+    assert((void const*) elements == data);
+    assert(5 == count);
+    assert(1 == counts.allocations); // Just the block
+    for (int64_t i = 0; i < 5; ++i)
     {
-        int* probe = NULL;
+        assert(i == elements[i]);
+    }
 
-        probe = (int*) Vec_get(v, i);
-        assert(probe != NULL);
+    // The block can go right back into a vector.
+    v = Vec_adopt(elements, count, capacity, sizeof(int64_t), &allocator);
+    assert(v != NULL);
+    assert(4 == Vec_where(v, &(int64_t){4}, sizeof(int64_t)));
+    Vec_destroy(&v);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
 
-        if (i == X_index)
-        {
-            assert(true == less_than_three(probe, sizeof(int)));
-        }
-        else
-        {
-            assert(false == less_than_three(probe, sizeof(int)));
-        }
-    }
+    // Inline elements are copied out, and the storage is left alone.
+    VEC_INLINE_STORAGE(storage, 4, sizeof(int64_t));
+
+    v = Vec_new_inline(storage, sizeof(storage), sizeof(int64_t), &options);
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
+    elements = Vec_release(&v, NULL);
+    assert(elements != NULL);
+    assert(1 == counts.allocations);
+    assert(7 == elements[0]);
+    counting_deallocate(&counts, elements, 4 * sizeof(int64_t));
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
 }
 
-static void test_has_if_head(void)
-{
-    size_t const cap = 4;
-    Vec* v = Vec_new(cap, sizeof(int));
+VEC_DEFINE(I64Vec, int64_t)
 
-    // `false` is returned when searching an empty vector.
-    assert(v != NULL);
-    assert(false == Vec_has_if(v, less_than_three));
+#define I64_LESS(a, b) (*(a) < *(b))
+VEC_DEFINE_SORT(I64Vec, int64_t, I64_LESS)
 
-    /*
-     * Make a vector that looks like this:
-     *
-     * ```
-     * [X][y][y][y]
-     *  0  1  2  3
-     * ```
-     */
-    size_t const X_index = 0;
-
-    test_has_if_helper(v, cap, X_index);
-
-    // Search for the `X`.
-    assert(true == Vec_has_if(v, less_than_three));
+/**
+ * @brief A typed predicate for `int64_t`s that are odd
+ */
+static bool i64_is_odd(int64_t const* i)
+{
+    return *i % 2 != 0;
+}
 
-    Vec_destroy(&v);
+/**
+ * @brief A typed predicate for `int64_t`s that are over 1000
+ */
+static bool i64_is_over_1000(int64_t const* i)
+{
+    return *i > 1000;
 }
 
-static void test_has_if_middle(void)
+static void test_typed_invalid(void)
 {
-    size_t const cap = 4;
-    Vec* v = Vec_new(cap, sizeof(int));
+    // Null vectors
+    assert(0 == I64Vec_count(NULL));
+    assert(0 == I64Vec_capacity(NULL));
+    assert(NULL == I64Vec_get(NULL, 0));
+    assert(false == I64Vec_append(NULL, 1));
+    assert(false == I64Vec_insert(NULL, 0, 1));
+    assert(0 == I64Vec_where_if(NULL, i64_is_odd));
+    assert(false == I64Vec_has_if(NULL, i64_is_odd));
+    assert(0 == I64Vec_remove_all_if(NULL, i64_is_odd));
+    assert(NULL == I64Vec_from_vec(NULL));
+    I64Vec_destroy(NULL);
+
+    // A generic vector of another element size isn't a typed vector.
+    Vec* generic = Vec_new(4, sizeof(int32_t));
+
+    assert(generic != NULL);
+    assert(NULL == I64Vec_from_vec(generic));
+    Vec_destroy(&generic);
+
+    // Zero capacity
+    assert(NULL == I64Vec_new(0));
+
+    // Null predicates
+    I64Vec* v = I64Vec_new(4);
 
     assert(v != NULL);
+    assert(true == I64Vec_append(v, 1));
+    assert(1 == I64Vec_where_if(v, NULL));
+    assert(false == I64Vec_has_if(v, NULL));
+    assert(0 == I64Vec_remove_all_if(v, NULL));
+    assert(1 == I64Vec_count(v));
 
-    /*
-     * Make a vector that looks like this:
-     *
-     * ```
-     * [y][y][X][y]
-     *  0  1  2  3
-     * ```
-     */
-    size_t const X_index = 2;
-
-    test_has_if_helper(v, cap, X_index);
-
-    // Search for the `X`.
-    assert(true == Vec_has_if(v, less_than_three));
+    // Out of bounds
+    assert(NULL == I64Vec_get(v, 1));
 
-    Vec_destroy(&v);
+    I64Vec_destroy(&v);
+    assert(v == NULL);
 }
 
-static void test_has_if_tail(void)
+static void test_typed(void)
 {
-    size_t const cap = 4;
-    Vec* v = Vec_new(cap, sizeof(int));
+    I64Vec* v = I64Vec_new(2);
 
     assert(v != NULL);
+    assert(0 == I64Vec_count(v));
+    assert(2 == I64Vec_capacity(v));
 
-    /*
-     * Make a vector that looks like this:
-     *
-     * ```
-     * [y][y][y][X]
-     *  0  1  2  3
-     * ```
-     */
-    size_t const X_index = 3;
+    // Appending expands the vector, like a generic vector.
+    for (int64_t i = 0; i < 100; ++i)
+    {
+        assert(true == I64Vec_append(v, i * 2));
+    }
+    assert(100 == I64Vec_count(v));
+    assert(I64Vec_capacity(v) >= 100);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        int64_t* probe = I64Vec_get(v, i);
 
-    test_has_if_helper(v, cap, X_index);
+        assert(probe != NULL);
+        assert(*probe == (int64_t) i * 2);
+    }
 
-    // Search for the `X`.
-    assert(true == Vec_has_if(v, less_than_three));
+    // Searching
+    assert(21 == I64Vec_where(v, &(int64_t){42}));
+    assert(100 == I64Vec_where(v, &(int64_t){43}));
+    assert(true == I64Vec_has(v, &(int64_t){198}));
+    assert(false == I64Vec_has(v, &(int64_t){199}));
+    assert(100 == I64Vec_where_if(v, i64_is_odd));
+    assert(false == I64Vec_has_if(v, i64_is_over_1000));
+
+    // Inserting and removing
+    assert(true == I64Vec_insert(v, 0, 1002));
+    assert(true == I64Vec_insert(v, 50, 7));
+    assert(102 == I64Vec_count(v));
+    assert(0 == I64Vec_where_if(v, i64_is_over_1000));
+    assert(50 == I64Vec_where_if(v, i64_is_odd));
+    assert(true == I64Vec_has_if(v, i64_is_odd));
+    assert(0 == I64Vec_remove(v, 0));
+    assert(49 == I64Vec_where_if(v, i64_is_odd));
+    assert(true == I64Vec_append(v, 9));
+    assert(2 == I64Vec_remove_all_if(v, i64_is_odd));
+    assert(100 == I64Vec_count(v));
+    assert(false == I64Vec_has_if(v, i64_is_odd));
+
+    // A typed vector is a generic vector, too.
+    Vec* generic = I64Vec_vec(v);
+
+    assert(100 == Vec_count(generic));
+    assert(sizeof(int64_t) == Vec_element_size(generic));
+    assert(true == Vec_append(generic, &(int64_t){5}, sizeof(int64_t)));
+    assert(v == I64Vec_from_vec(generic));
+    assert(100 == I64Vec_where_if(v, i64_is_odd));
+    assert(101 == I64Vec_count(v));
+
+    assert(true == I64Vec_reserve(v, 1000));
+    assert(1000 == I64Vec_capacity(v));
+    assert(101 == Vec_count(I64Vec_vec_const(v)));
+
+    I64Vec_destroy(&v);
+    assert(v == NULL);
 
-    Vec_destroy(&v);
+    // Typed vectors can be inline, too.
+    VEC_INLINE_STORAGE(storage, 4, sizeof(int64_t));
+    I64Vec* small = I64Vec_new_inline(storage, sizeof(storage), NULL);
+
+    assert(small != NULL);
+    assert(4 == I64Vec_capacity(small));
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        assert(true == I64Vec_append(small, i));
+    }
+    assert(10 == I64Vec_count(small));
+    assert(9 == *I64Vec_get(small, 9));
+    I64Vec_destroy(&small);
+
+    VecOptions const options = { .growth = VEC_GROWTH_CHUNK,
+                                 .growth_chunk = 3 };
+
+    v = I64Vec_new_with(1, &options);
+    assert(v != NULL);
+    assert(true == I64Vec_append(v, 1));
+    assert(true == I64Vec_append(v, 2));
+    assert(4 == I64Vec_capacity(v));
+    I64Vec_destroy(&v);
 }
 
-static void test_has_if_nowhere(void)
+static void test_arena(void)
 {
-    size_t const cap = 4;
-    Vec* v = Vec_new(cap, sizeof(int));
+    assert(NULL == VecArena_new(SIZE_MAX));
 
-    assert(v != NULL);
+    // A small block size makes the vectors outgrow the blocks.
+    VecArena* arena = VecArena_new(256);
 
-    /*
-     * Make a vector that looks like this:
-     *
-     * ```
-     * [y][y][y][y]
-     *  0  1  2  3
-     * ```
-     */
-    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){7}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){8}, sizeof(int)));
+    assert(arena != NULL);
+    assert(0 == VecArena_used(arena));
 
-    // Check vector content.
-    assert(Vec_count(v) == cap);
-    for (size_t i = 0; i < Vec_count(v); ++i)
+    VecAllocator const allocator = VecArena_allocator(arena);
+    VecOptions const options = { .allocator = &allocator };
+
+    for (int round = 0; round < 3; ++round)
     {
-        int* probe = NULL;
+        Vec* a = Vec_new_with(2, sizeof(int64_t), &options);
+        Vec* b = Vec_new_with(2, sizeof(int64_t), &options);
 
-        probe = (int*) Vec_get(v, i);
-        assert(probe != NULL);
-        assert(false == less_than_three(probe, sizeof(int)));
-    }
+        assert(a != NULL);
+        assert(b != NULL);
+        assert(VecArena_used(arena) > 0);
 
-    // Search for the `X`. (It shouldn't exist.)
-    assert(false == Vec_has_if(v, less_than_three));
+        // Interleaved appends keep moving the vectors' element blocks around.
+        for (int64_t i = 0; i < 1000; ++i)
+        {
+            assert(true == Vec_append(a, &i, sizeof(i)));
+            assert(true == Vec_append(b, &(int64_t){-i}, sizeof(i)));
+        }
+        for (int64_t i = 0; i < 1000; ++i)
+        {
+            int64_t const* in_a = (int64_t const*) Vec_get(a, (size_t) i);
+            int64_t const* in_b = (int64_t const*) Vec_get(b, (size_t) i);
 
-    Vec_destroy(&v);
-}
+            assert(in_a != NULL && *in_a == i);
+            assert(in_b != NULL && *in_b == -i);
+        }
 
-static void test_get_invalid(void)
-{
-    size_t const cap_hint = 5;
-    Vec* v = Vec_new(cap_hint, sizeof(int));
+        // Destroying the vectors is optional, since resetting frees them...
+        if (round == 0)
+        {
+            Vec_destroy(&a);
+            Vec_destroy(&b);
+        }
 
-    // A null pointer is returned when searching an empty vector.
-    assert(v != NULL);
-    assert(NULL == Vec_get(v, 0));
+        // ...along with everything else allocated from the arena.
+        VecArena_reset(arena);
+        assert(0 == VecArena_used(arena));
+    }
 
-    // Add some elements.
-    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){7}, sizeof(int)));
-    assert(Vec_count(v) == 3); // The elements were added.
+    // The arena's most recent allocation grows and shrinks in place.
+    void* p = allocator.allocate(allocator.context, 10);
 
-    // The initial capacity should be greater than the number of elements.
-    assert(Vec_capacity(v) > Vec_count(v));
+    assert(p != NULL);
+    assert(p == allocator.reallocate(allocator.context, p, 10, 100));
+    assert(p == allocator.reallocate(allocator.context, p, 100, 20));
 
-    /*
-     * The getter function fails, and returns a null pointer, if the given index
-     * is out of bounds of a vector's elements.
-     *
-     * ```
-     * [a][b][c][ ][ ]
-     *  0  1  2  3  4
-     * ```
-     *
-     * So, for the vector above, only indices 0, 1, and 2, can be queried. The
-     * bound of the vector's elements is [0, 2].
-     *
-     * Query an index out of the vector's bounds.
-     */
-    int* probe = NULL;
+    size_t const used = VecArena_used(arena);
 
-    probe = (int*) Vec_get(v, Vec_count(v));
-    assert(probe == NULL); // Getter failed and returned a null pointer.
+    // Giving back the most recent allocation makes room for the next one.
+    allocator.deallocate(allocator.context, p, 20);
+    assert(VecArena_used(arena) < used);
+    assert(p == allocator.allocate(allocator.context, 20));
 
-    probe = (int*) Vec_get(v, Vec_count(v) + 1);
-    assert(probe == NULL);
+    // Allocations bigger than a block are fine.
+    uint8_t* huge = allocator.allocate(allocator.context, 10000);
 
-    probe = (int*) Vec_get(v, Vec_capacity(v));
-    assert(probe == NULL);
+    assert(huge != NULL);
+    memset(huge, 0xAB, 10000);
 
-    Vec_destroy(&v);
+    VecArena_reset(NULL);
+    assert(0 == VecArena_used(NULL));
+    VecArena_destroy(&arena);
+    assert(arena == NULL);
+    VecArena_destroy(&arena);
+    VecArena_destroy(NULL);
 }
 
-static void test_get(void)
+static void test_pool(void)
 {
-    Vec* v = Vec_new(5, sizeof(int));
-    int const first = 5;
-    int const second = 6;
-    int const third = 7;
-    int const fourth = 8;
-    int const fifth = 9;
+    VecPool* pool = VecPool_new();
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &first, sizeof(first)));
-    assert(true == Vec_append(v, &second, sizeof(second)));
-    assert(true == Vec_append(v, &third, sizeof(third)));
-    assert(true == Vec_append(v, &fourth, sizeof(fourth)));
-    assert(true == Vec_append(v, &fifth, sizeof(fifth)));
-    assert(Vec_count(v) == 5);
-
-    // Verify the elements can be retrieved successfully.
-    int* probe = NULL;
+    assert(pool != NULL);
+    assert(0 == VecPool_free_bytes(pool));
 
-    probe = (int*) Vec_get(v, 0);
-    assert(probe != NULL);
-    assert(*probe == first);
+    VecAllocator const allocator = VecPool_allocator(pool);
+    VecOptions const options = { .allocator = &allocator };
+    Vec* v = Vec_new_with(2, sizeof(int64_t), &options);
 
-    probe = (int*) Vec_get(v, 1);
-    assert(probe != NULL);
-    assert(*probe == second);
+    assert(v != NULL);
 
-    probe = (int*) Vec_get(v, 2);
-    assert(probe != NULL);
-    assert(*probe == third);
+    // Growing past the biggest size class is fine.
+    for (int64_t i = 0; i < 10000; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    for (int64_t i = 0; i < 10000; ++i)
+    {
+        int64_t const* probe = (int64_t const*) Vec_get(v, (size_t) i);
 
-    probe = (int*) Vec_get(v, 3);
-    assert(probe != NULL);
-    assert(*probe == fourth);
+        assert(probe != NULL && *probe == i);
+    }
 
-    probe = (int*) Vec_get(v, 4);
-    assert(probe != NULL);
-    assert(*probe == fifth);
+    // The blocks the vector outgrew are back in the pool.
+    assert(VecPool_free_bytes(pool) > 0);
 
     Vec_destroy(&v);
-}
 
-static void test_append_invalid(void)
-{
-    Vec* v = Vec_new(5, sizeof(int));
+    // New vectors reuse the freed blocks.
+    size_t const free_bytes = VecPool_free_bytes(pool);
 
+    v = Vec_new_with(2, sizeof(int64_t), &options);
     assert(v != NULL);
+    assert(VecPool_free_bytes(pool) < free_bytes);
+    Vec_destroy(&v);
+    assert(VecPool_free_bytes(pool) == free_bytes);
 
-    // When the item size disagrees with the vector's declared element size
-    assert(Vec_append(v, &(int){2}, sizeof(int[50])) == false);
-    assert(Vec_count(v) == 0);
-
-    // When pointers are null
-    assert(Vec_append(NULL, &(int){3}, sizeof((int){3})) == false);
-    assert(Vec_append(v, NULL, sizeof((int){3})) == false);
-    assert(Vec_append(NULL, NULL, sizeof((int){3})) == false);
-    assert(Vec_count(v) == 0);
+    // Reallocating within a size class doesn't move the block.
+    void* p = allocator.allocate(allocator.context, 20);
 
-    Vec_destroy(&v);
+    assert(p != NULL);
+    assert(p == allocator.reallocate(allocator.context, p, 20, 32));
+    allocator.deallocate(allocator.context, p, 32);
+
+    assert(0 == VecPool_free_bytes(NULL));
+    VecPool_destroy(&pool);
+    assert(pool == NULL);
+    VecPool_destroy(&pool);
+    VecPool_destroy(NULL);
 }
 
-static void test_append(void)
+/**
+ * @struct
+ * A big element, for the scans that prefetch
+ */
+typedef struct
 {
-    Vec* v = Vec_new(5, sizeof(int));
-
-    assert(v != NULL);
-
-    // Trivial case
-    assert(Vec_count(v) == 0);
-    assert(Vec_append(v, &(int){1}, sizeof((int){1})) == true);
-    assert(Vec_count(v) == 1);
+    int64_t id;
+    uint8_t payload[248];
+} BigElement;
 
-    Vec_destroy(&v);
+static bool is_id_999(void const* element, size_t const element_size)
+{
+    return element_size == sizeof(BigElement) &&
+           ((BigElement const*) element)->id == 999;
+}
 
-    // Automatic expansion
-    size_t const least_cap_hint = 1;
+static int bump_id(void* element, size_t const element_size, void* state)
+{
+    (void) state;
+    if (element_size != sizeof(BigElement))
+    {
+        return 1;
+    }
+    ((BigElement*) element)->id += 1;
 
-    v = Vec_new(least_cap_hint, sizeof(uint64_t[4]));
-    assert(v != NULL);
+    return 0;
+}
 
-    size_t const initial_cap = Vec_capacity(v);
+static void test_aligned(void)
+{
+    // An unknown mode gets the default mode's allocator.
+    VecAllocator const fallback = VecAligned_allocator((VecAlignedMode) 42);
 
-    assert(initial_cap >= least_cap_hint); // The hint is the minimum capacity.
+    assert(fallback.context ==
+           VecAligned_allocator(VEC_ALIGNED_DEFAULT).context);
 
-    // Fill up the vector to its initial capacity.
-    for (size_t i = 0; i < initial_cap; ++i)
+    VecAlignedMode const modes[] =
     {
-        uint64_t const arr[4] = {i, i, i, i};
+        VEC_ALIGNED_DEFAULT,
+        VEC_ALIGNED_HUGE_PAGES,
+        VEC_ALIGNED_NUMA_LOCAL
+    };
 
-        assert(Vec_append(v, arr, sizeof(arr)) == true);
-        assert(Vec_count(v) == (i + 1));
-    }
-    assert(Vec_count(v) == Vec_capacity(v)); // Now, the vector should be full.
-    assert(Vec_capacity(v) == initial_cap); // And it shouldn't've resized yet.
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+    {
+        VecAllocator const allocator = VecAligned_allocator(modes[m]);
+        VecOptions const options = { .allocator = &allocator };
+        Vec* v = Vec_new_with(3, sizeof(int64_t), &options);
 
-    // Add one more element.
-    uint64_t arr[4] = {4, 3, 2, 1};
+        assert(v != NULL);
+        assert(0 == (uintptr_t) Vec_data(v) % VEC_ALIGNED_LINE);
 
-    assert(Vec_append(v, arr, sizeof(arr)) == true);
-    assert(Vec_count(v) == (initial_cap + 1)); // Going past initial capacity
-    assert(Vec_capacity(v) > initial_cap); // Should have triggered expansion
+        // Growing from small blocks into mapped ones keeps the elements.
+        int64_t const n = 1 << 20;
 
-    // The elements should be in the same order as appended above.
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        uint64_t (*stored_arr)[4] = (uint64_t (*)[4]) Vec_get(v, i);
+        for (int64_t i = 0; i < n; ++i)
+        {
+            assert(true == Vec_append(v, &i, sizeof(i)));
+            assert(0 == (uintptr_t) Vec_data(v) % VEC_ALIGNED_LINE);
+        }
+        if (modes[m] == VEC_ALIGNED_HUGE_PAGES)
+        {
+            assert(0 == (uintptr_t) Vec_data(v) % VEC_ALIGNED_HUGE_PAGE);
+        }
+        for (int64_t i = 0; i < n; i += 4099)
+        {
+            assert(i == *(int64_t const*) Vec_get(v, (size_t) i));
+        }
 
-        if (i < (Vec_count(v) - 1))
+        // ...and so does shrinking back down into a small block.
+        while (Vec_count(v) > 100)
         {
-            for (size_t j = 0; j < 4; ++j)
-            {
-                // The elements are arrays of all `i`s for the `i`th element.
-                assert((*stored_arr)[j] == i);
-            }
+            assert(true == Vec_pop_back(v, NULL, sizeof(int64_t)));
         }
-        else if (i == (Vec_count(v) - 1))
+        assert(true == Vec_shrink_to_fit(v));
+        assert(0 == (uintptr_t) Vec_data(v) % VEC_ALIGNED_LINE);
+        for (int64_t i = 0; i < 100; ++i)
         {
-            // But the last element is the hardcoded `arr`.
-            assert(memcmp(stored_arr, arr, sizeof(uint64_t[4])) == 0);
+            assert(i == *(int64_t const*) Vec_get(v, (size_t) i));
         }
+        Vec_destroy(&v);
     }
 
-    Vec_destroy(&v);
+    // Scans over big elements (which prefetch) find and change every element.
+    Vec* big = Vec_new(16, sizeof(BigElement));
+
+    assert(big != NULL);
+    for (int64_t i = 0; i < 2000; ++i)
+    {
+        BigElement const element = { .id = i, .payload = {0} };
+
+        assert(true == Vec_append(big, &element, sizeof(element)));
+    }
+    assert(999 == Vec_where_if(big, is_id_999));
+    assert(0 == Vec_apply(big, bump_id, NULL));
+    assert(998 == Vec_where_if(big, is_id_999));
+    assert(2000 == ((BigElement const*) Vec_get(big, 1999))->id);
+    Vec_destroy(&big);
 }
 
-static void test_append_inner_pointer(void)
+static void test_where_invalid(void)
 {
-    /*
-     * Make the following vector:
-     *
-     * ```
-     * [9][8][7][ ][ ][ ]
-     *  0  1  2  3  4  5
-     * ```
-     */
-    Vec* v = Vec_new(6, sizeof(int32_t));
-    int32_t const first = 9;
-    int32_t const second = 8;
-    int32_t const third = 7;
+    Vec* v = Vec_new(5, sizeof(int));
 
     assert(v != NULL);
-    assert(true == Vec_append(v, &first, sizeof(int32_t)));
-    assert(true == Vec_append(v, &second, sizeof(int32_t)));
-    assert(true == Vec_append(v, &third, sizeof(int32_t)));
-    assert(3 == Vec_count(v));
 
-    /*
-     * Get a pointer to the last element in the vector and append it. Then the
-     * vector should look like this:
-     *
-     * ```
-     * [9][8][7][7][ ][ ]
-     *  0  1  2  3  4  5
-     * ```
-     */
-    int32_t* probe = (int32_t*) Vec_get(v, 2);
-    size_t prev_cap = Vec_capacity(v);
+    // Since the vector is empty, the number of elements, 0, is returned.
+    assert(0 == Vec_count(v));
+    assert(0 == Vec_where(v, &(int){42}, sizeof(int)));
 
-    assert(probe != NULL);
-    assert(*probe == third);
-    assert(true == Vec_append(v, probe, sizeof(*probe)));
-    probe = NULL; // Pointer invalidated by the append
-    assert(Vec_capacity(v) == prev_cap); // No resize should have occurred.
-    // A copy of the element should've be added.
-    assert(4 == Vec_count(v));
-    probe = (int32_t*) Vec_get(v, 3); // Get the newly-added element.
-    assert(probe != NULL);
-    assert(*probe == third); // Check that it's a copy of the last element.
+    // With a null item pointer, the number of elements is returned as well.
+    assert(0 == Vec_where(v, NULL, sizeof(int))); // The number of elements is 0.
+    assert(true == Vec_append(v, &(int){777}, sizeof(int))); // Add an element.
+    // Now the number of elements is 1.
+    assert(1 == Vec_count(v));
+    assert(1 == Vec_where(v, NULL, sizeof(int)));
+
+    // Ditto for when the item size differs from the vector's element size.
+    assert(1 == Vec_where(v, &(int){42}, 0));
+    assert(1 == Vec_where(v, &(int){42}, sizeof(int[5])));
+
+    // If the vector pointer is null, 0 is always returned.
+    assert(0 == Vec_where(NULL, &(int){42}, sizeof(int)));
+
+    Vec_destroy(&v);
+}
+
+static void test_where(void)
+{
+    Vec* v = Vec_new(5, sizeof(int));
+
+    assert(v != NULL);
 
     /*
-     * Repeat with the second element to make the vector look like this:
+     * Find the index of various values in the vector:
      *
      * ```
-     * [9][8][7][7][8][ ]
-     *  0  1  2  3  4  5
+     * [5][6][6][6][7]
+     *  0  1  2  3  4
      * ```
      */
-    probe = (int32_t*) Vec_get(v, 1);
-    prev_cap = Vec_capacity(v);
-
-    assert(probe != NULL);
-    assert(*probe == second);
-    assert(true == Vec_append(v, probe, sizeof(*probe)));
-    probe = NULL; // Pointer invalidated by the append
-    assert(Vec_capacity(v) == prev_cap); // No resize should have occurred.
-    // A copy of the element should've be added.
+    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){7}, sizeof(int)));
     assert(5 == Vec_count(v));
-    probe = (int32_t*) Vec_get(v, 4);
-    assert(probe != NULL);
-    assert(*probe == second);
+
+    // `5` is at index 0.
+    assert(0 == Vec_where(v, &(int){5}, sizeof(int)));
+
+    // `7` is at index 4.
+    assert(4 == Vec_where(v, &(int){7}, sizeof(int)));
 
     /*
-     * Repeat with the first element to make the vector look like this:
-     *
-     * ```
-     * [9][8][7][7][8][9]
-     *  0  1  2  3  4  5
-     * ```
+     * `6` is at indices 1 through 3, but the first instance, at index 1, is
+     * always the one whose index is returned.
      */
-    probe = (int32_t*) Vec_get(v, 0);
-    prev_cap = Vec_capacity(v);
+    assert(1 == Vec_where(v, &(int){6}, sizeof(int)));
+    assert(1 == Vec_where(v, &(int){6}, sizeof(int)));
+    assert(1 == Vec_where(v, &(int){6}, sizeof(int)));
 
-    assert(probe != NULL);
-    assert(*probe == first);
-    assert(true == Vec_append(v, probe, sizeof(*probe)));
-    probe = NULL; // Pointer invalidated by the append
-    assert(Vec_capacity(v) == prev_cap); // No resize should have occurred.
-    // A copy of the element should've be added.
-    assert(6 == Vec_count(v));
-    probe = (int32_t*) Vec_get(v, 5);
-    assert(probe != NULL);
-    assert(*probe == first);
+    // The number of elements is returned when an element is not found.
+    assert(Vec_count(v) == Vec_where(v, &(int){42}, sizeof(int)));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_invalid(void)
+static void test_where_inner_pointer(void)
 {
-    Vec* v = Vec_new(10, sizeof(uint64_t));
+    /*
+     * Make the following vector:
+     *
+     * ```
+     * [9][8][7]
+     *  0  1  2
+     * ```
+     */
+    Vec* v = Vec_new(3, sizeof(uint32_t));
 
     assert(v != NULL);
 
-    // Insert something out of bounds of the capacity.
-    assert(Vec_insert(v,
-                      Vec_capacity(v),
-                      &(uint64_t){0},
-                      sizeof((uint64_t){0})) == false);
-    assert(Vec_count(v) == 0); // Insertion was rejected.
-
-    // Insert something out of `[0, n]` bounds (`n` being the element count, 0).
-    assert(Vec_insert(v,
-                      1,
-                      &(uint64_t){1},
-                      sizeof((uint64_t){1})) == false);
-    assert(Vec_count(v) == 0); // Insertion was rejected.
+    assert(true == Vec_append(v, &(uint32_t){9}, sizeof(uint32_t)));
+    assert(true == Vec_append(v, &(uint32_t){8}, sizeof(uint32_t)));
+    assert(true == Vec_append(v, &(uint32_t){7}, sizeof(uint32_t)));
+    assert(3 == Vec_count(v));
 
-    // Insert something within `[0, n]` bounds.
-    uint64_t const first = 1776;
-    uint64_t const second = 1787;
-    uint64_t* probe = NULL;
+    // Get a pointer to the first element inside the vector.
+    uint32_t* probe = (uint32_t*) Vec_get(v, 0);
 
-    assert(Vec_insert(v,
-                      0,
-                      &first,
-                      sizeof((uint64_t){0})) == true);
-    assert(Vec_count(v) == 1); // Insertion was accepted.
-    probe = (uint64_t*) Vec_get(v, 0);
+    // Verify that the vector correctly reports its location.
     assert(probe != NULL);
-    assert(*probe == first);
-    probe = NULL;
+    assert(0 == Vec_where(v, probe, sizeof(*probe)));
 
-    assert(Vec_insert(v,
-                      1,
-                      &second,
-                      sizeof((uint64_t){1})) == true);
-    assert(Vec_count(v) == 2); // Insertion was accepted.
-    probe = (uint64_t*) Vec_get(v, 1);
+    // Ditto for the second element
+    probe = (uint32_t*) Vec_get(v, 1);
     assert(probe != NULL);
-    assert(*probe == second);
-    probe = NULL;
-
-    // `n` is now 2. Insert something out of `[0, n]` bounds again, at 3.
-    assert(Vec_insert(v,
-                      3,
-                      &(uint64_t){3},
-                      sizeof((uint64_t){3})) == false);
-    assert(Vec_count(v) == 2); // Insertion was rejected.
-
-    // Insert something with an incorrect size.
-    assert(Vec_insert(v,
-                      0,
-                      &(uint32_t){9},
-                      sizeof((uint32_t){9})) == false); // A `uint32_t`
-    assert(Vec_count(v) == 2); // Insertion was rejected.
+    assert(1 == Vec_where(v, probe, sizeof(*probe)));
 
-    assert(Vec_insert(v,
-                      0,
-                      &(uint64_t){9},
-                      sizeof((uint32_t){9})) == false); // Just `uint32_t` size
-    assert(Vec_count(v) == 2); // Insertion was rejected.
+    // Ditto for the third element
+    probe = (uint32_t*) Vec_get(v, 2);
+    assert(probe != NULL);
+    assert(2 == Vec_where(v, probe, sizeof(*probe)));
 
-    assert(Vec_insert(v,
-                      0,
-                      &(char){'a'},
-                      sizeof((char){'a'})) == false); // A `char`
-    assert(Vec_count(v) == 2); // Insertion was rejected.
+    Vec_destroy(&v);
+}
 
-    // Insert with null pointers.
-    assert(Vec_insert(NULL,
-                      0,
-                      NULL,
-                      sizeof((uint64_t){9})) == false);
-    assert(Vec_count(v) == 2); // Insertion was rejected.
+/**
+ * @brief A predicate that can be used by a vector's search or removal functions
+ * to target `int`s less than 3
+ * @param element An element provided by the vector when it calls this function
+ * @param element_size The size of the element reported by the vector (usable as
+ * a size-based "type check" to make sure the element looks like an `int`)
+ */
+static bool less_than_three(void const* element, size_t const element_size)
+{
+    /*
+     * We know we're supposed to be dealing with `int`s.
+     *
+     * If this gets used by a vector with a different element size, the wrong
+     * element size will be passed in by that vector, allowing us to return
+     * early.
+     */
+    size_t const expected_size = sizeof(int);
 
-    assert(Vec_insert(NULL,
-                      0,
-                      &(uint64_t){9},
-                      sizeof((uint64_t){9})) == false);
-    assert(Vec_count(v) == 2); // Insertion was rejected.
+    if (NULL == element ||
+        element_size != expected_size)
+    {
+        return false; // Error; return early.
+    }
 
-    assert(Vec_insert(v,
-                      0,
-                      NULL,
-                      sizeof((uint64_t){9})) == false);
-    assert(Vec_count(v) == 2); // Insertion was rejected.
+    int const* i = (int const*) element; // Cast to the known type.
 
-    Vec_destroy(&v);
+    return *i < 3;
 }
 
-static void test_insert_empty(void)
+static void test_where_if_invalid(void)
 {
-    size_t const initial_cap_hint = 10;
-    Vec* v = Vec_new(initial_cap_hint, sizeof(char));
+    Vec* v = Vec_new(5, sizeof(int16_t));
 
     assert(v != NULL);
-    assert(Vec_capacity(v) >= initial_cap_hint);
 
-    /*
-     * Insert something in an empty vector.
-     *
-     * ```
-     *  Will insert here
-     *  v
-     * [ ][ ][ ][ ][ ][ ][ ][ ][ ][ ]. . .
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     */
-    size_t initial_cap = Vec_capacity(v);
+    // Since the vector is empty, the number of elements, 0, is returned.
+    assert(0 == Vec_count(v));
+    assert(0 == Vec_where_if(v, less_than_three));
 
-    assert(Vec_insert(v, 0, &(char){'x'}, sizeof(char)) == true);
+    // With a null predicate pointer, the number of elements is returned too.
+    assert(0 == Vec_where_if(v, NULL)); // Number of elements is 0
+    // Add an element.
+    assert(true == Vec_append(v, &(int16_t){777}, sizeof(int16_t)));
+    // Now the number of elements is 1.
+    assert(1 == Vec_count(v));
+    assert(1 == Vec_where_if(v, NULL));
 
     /*
-     * The vector should now look like:
+     * Ditto for when the item size differs from the vector's element size.
      *
-     * ```
-     *  Inserted here
-     *  v
-     * [x][ ][ ][ ][ ][ ][ ][ ][ ][ ]. . .
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
+     * First, we'll need a new vector with a different declared element size.
      */
-    assert(Vec_count(v) == 1);
-    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+    Vec_destroy(&v);
+    v = Vec_new(5, sizeof(int64_t));
+    assert(v != NULL);
 
-    char* probe = NULL;
+    // Add a few elements.
+    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){9}, sizeof(int64_t)));
+    assert(3 == Vec_count(v));
 
-    probe = (char*) Vec_get(v, 0);
-    assert(probe != NULL);
-    assert(*probe == (char){'x'});
+    /*
+     * Now search for an element of the wrong size.
+     *
+     * `less_than_three()` expects `sizeof(int)` but `Vec_where_if()` will give
+     * it `sizeof(int64_t)`.
+     *
+     * The predicate will then return false for all elements. This is
+     * essentially the same as never finding an element that satisfies the
+     * predicate, causing the number of elements to be returned.
+     */
+    assert(Vec_count(v) == Vec_where_if(v, less_than_three));
+
+    // If the vector pointer is null, 0 is always returned.
+    assert(0 == Vec_where_if(NULL, less_than_three));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_slack_middle(void)
+static void test_where_if(void)
 {
-    Vec* v = Vec_new(5, sizeof(char));
+    Vec* v = Vec_new(5, sizeof(int));
+    int* probe = NULL;
 
     assert(v != NULL);
 
-    // Add some elements to the vector.
-    size_t const initial_cap = Vec_capacity(v);
-
-    Vec_append(v, &(char){'a'}, sizeof(char)); // Index 0
-    Vec_append(v, &(char){'c'}, sizeof(char)); // Index 1
-    Vec_append(v, &(char){'d'}, sizeof(char)); // Index 2
-    assert(Vec_count(v) == 3);
-    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
-
     /*
-     * Insert something in the middle of some elements when the vector still has
-     * slack (so it won't resize due to the insertion):
+     * Make the following vector:
      *
      * ```
-     *     Will insert here
-     *     v
-     * [a][c][d][ ][ ]. . .
+     * [2][5][5][2][1]
      *  0  1  2  3  4
      * ```
      */
-    assert(Vec_insert(v, 1, &(char){'b'}, sizeof(char)) == true);
+    assert(true == Vec_append(v, &(int){2}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){2}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){1}, sizeof(int)));
+    assert(5 == Vec_count(v));
+
+    // The first element less than 3 should be at index 0.
+    assert(0 == Vec_where_if(v, less_than_three));
+    probe = (int*) Vec_get(v, Vec_where_if(v, less_than_three));
+    assert(probe != NULL);
+    assert(*probe == (int){2});
+    // The same index is returned across repeated calls.
+    assert(0 == Vec_where_if(v, less_than_three));
+    assert(0 == Vec_where_if(v, less_than_three));
+    assert(0 == Vec_where_if(v, less_than_three));
+
+    // Now remove the element at that index.
+    Vec_remove(v, Vec_where_if(v, less_than_three));
 
     /*
-     * The vector should now look like:
+     * The vector now looks like this:
      *
      * ```
-     *     Inserted here
-     *     v
-     * [a][b][c][d][ ]. . .
+     * [5][5][2][1][ ]
      *  0  1  2  3  4
      * ```
+     *
+     * So the first element less than 3 should now be at index 2.
      */
-    assert(Vec_count(v) == 4);
-    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
-
-    char* probe = NULL;
-
-    probe = (char*) Vec_get(v, 0);
+    assert(2 == Vec_where_if(v, less_than_three));
+    probe = (int*) Vec_get(v, Vec_where_if(v, less_than_three));
     assert(probe != NULL);
-    assert(*probe == 'a');
-    probe = NULL;
+    assert(*probe == (int){2});
 
-    probe = (char*) Vec_get(v, 1);
-    assert(probe != NULL);
-    assert(*probe == 'b');
-    probe = NULL;
+    // Remove that element as well.
+    Vec_remove(v, Vec_where_if(v, less_than_three));
 
-    probe = (char*) Vec_get(v, 2);
+    /*
+     * The vector now looks like this:
+     *
+     * ```
+     * [5][5][1][ ][ ]
+     *  0  1  2  3  4
+     * ```
+     *
+     * The first element less than 3 should still be at index 2 since it got
+     * shifted to the left.
+     */
+    assert(2 == Vec_where_if(v, less_than_three));
+    probe = (int*) Vec_get(v, Vec_where_if(v, less_than_three));
     assert(probe != NULL);
-    assert(*probe == 'c');
-    probe = NULL;
+    assert(*probe == (int){1});
 
-    probe = (char*) Vec_get(v, 3);
-    assert(probe != NULL);
-    assert(*probe == 'd');
+    // Remove that element as well.
+    Vec_remove(v, Vec_where_if(v, less_than_three));
+
+    /*
+     * The vector now looks like this:
+     *
+     * ```
+     * [5][5][ ][ ][ ]
+     *  0  1  2  3  4
+     * ```
+     *
+     * There are no more elements less than 3, so the number of elements in the
+     * vector should be returned on the next query.
+     */
+    assert(Vec_count(v) == Vec_where_if(v, less_than_three));
 
     Vec_destroy(&v);
 }
 
-typedef enum Color
+/**
+ * @brief A predicate that can be used by a vector's context-taking search or
+ * removal functions to target `int`s less than a limit given via the context
+ * @param element An element provided by the vector when it calls this function
+ * @param element_size The size of the element reported by the vector (usable as
+ * a size-based "type check" to make sure the element looks like an `int`)
+ * @param context A pointer to the `int` limit
+ */
+static bool less_than_limit(void const* element,
+                            size_t const element_size,
+                            void* context)
 {
-    RED,
-    GREEN,
-    BLUE,
-    COLOR_NUM
-} Color;
+    if (NULL == element ||
+        NULL == context ||
+        element_size != sizeof(int))
+    {
+        return false; // Error; return early.
+    }
 
-typedef struct Fish Fish;
-struct Fish
-{
-    Color color;
-    size_t size;
-};
+    int const* i = (int const*) element; // Cast to the known type.
+    int const* limit = (int const*) context;
 
-static void test_insert_slack_middle_struct(void)
+    return *i < *limit;
+}
+
+static void test_where_if_ctx_invalid(void)
 {
-    Vec* v = Vec_new(5, sizeof(Fish));
+    Vec* v = Vec_new(5, sizeof(int));
+    int limit = 3;
 
     assert(v != NULL);
 
-    // Add some elements to the vector.
-    size_t const initial_cap = Vec_capacity(v);
+    // Since the vector is empty, the number of elements, 0, is returned.
+    assert(0 == Vec_where_if_ctx(v, less_than_limit, &limit));
+    assert(false == Vec_has_if_ctx(v, less_than_limit, &limit));
+    assert(0 == Vec_remove_all_if_ctx(v, less_than_limit, &limit));
 
-    Vec_append(v,
-               &(Fish)
-               {
-                   .color = RED,
-                   .size = 0
-               },
-               sizeof(Fish)); // Index 0
-    Vec_append(v,
-               &(Fish)
-               {
-                   .color = GREEN,
-                   .size = 1
-               },
-               sizeof(Fish)); // Index 1
-    Vec_append(v,
-               &(Fish)
-               {
-                   .color = BLUE,
-                   .size = 2
-               },
-               sizeof(Fish)); // Index 2
-    assert(Vec_count(v) == 3);
-    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+    // With a null predicate pointer, the number of elements is returned too.
+    assert(true == Vec_append(v, &(int){1}, sizeof(int)));
+    assert(1 == Vec_where_if_ctx(v, NULL, &limit));
+    assert(false == Vec_has_if_ctx(v, NULL, &limit));
+    assert(0 == Vec_remove_all_if_ctx(v, NULL, &limit));
+    assert(1 == Vec_count(v));
+
+    // A null context is passed through as is (so the predicate rejects it).
+    assert(1 == Vec_where_if_ctx(v, less_than_limit, NULL));
+
+    // If the vector pointer is null, 0 (or false) is always returned.
+    assert(0 == Vec_where_if_ctx(NULL, less_than_limit, &limit));
+    assert(false == Vec_has_if_ctx(NULL, less_than_limit, &limit));
+    assert(0 == Vec_remove_all_if_ctx(NULL, less_than_limit, &limit));
+
+    Vec_destroy(&v);
+}
+
+static void test_where_if_ctx(void)
+{
+    Vec* v = Vec_new(5, sizeof(int));
+
+    assert(v != NULL);
 
     /*
-     * Insert something in the middle of the `Fish` (denoted by their colors)
-     * when the vector still has slack (so it won't resize due to the
-     * insertion):
+     * Make the following vector:
      *
      * ```
-     *     Will insert here
-     *     v
-     * [R][G][B][ ][ ]. . .
+     * [4][5][5][2][1]
      *  0  1  2  3  4
      * ```
      */
-    assert(Vec_insert(v,
-                      1,
-                      &(Fish)
-                      {
-                          .color = BLUE,
-                          .size = 10
-                      },
-                      sizeof(Fish)) == true);
+    assert(true == Vec_append(v, &(int){4}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){2}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){1}, sizeof(int)));
+
+    // The same predicate finds different elements for different limits.
+    int limit = 5;
+
+    assert(0 == Vec_where_if_ctx(v, less_than_limit, &limit));
+    limit = 3;
+    assert(3 == Vec_where_if_ctx(v, less_than_limit, &limit));
+    assert(true == Vec_has_if_ctx(v, less_than_limit, &limit));
+    limit = 1;
+    assert(Vec_count(v) == Vec_where_if_ctx(v, less_than_limit, &limit));
+    assert(false == Vec_has_if_ctx(v, less_than_limit, &limit));
+
+    // Remove everything less than 5, leaving `[5][5]`.
+    limit = 5;
+    assert(3 == Vec_remove_all_if_ctx(v, less_than_limit, &limit));
+    assert(2 == Vec_count(v));
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        int const* probe = (int const*) Vec_get(v, i);
+
+        assert(probe != NULL);
+        assert(*probe == 5);
+    }
 
+    Vec_destroy(&v);
+}
+
+static void test_where_bytes(void)
+{
     /*
-     * The vector should now look like this (with the `Fish` denoted by their
-     * colors and the inserted element by `X`):
+     * Search a vector of single bytes (which takes a different path than
+     * vectors of wider elements do):
      *
      * ```
-     *     Inserted here
-     *     v
-     * [R][X][G][B][ ]. . .
-     *  0  1  2  3  4
+     * [0][1][2]. . .[254][255][0][1]. . .
+     *  0  1  2       254  255 256 257
      * ```
      */
-    assert(Vec_count(v) == 4);
-    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
+    size_t const total = 1000;
+    Vec* v = Vec_new(total, sizeof(uint8_t));
 
-    Fish* probe = NULL;
-
-    probe = (Fish*) Vec_get(v, 0);
-    assert(probe != NULL);
-    assert(probe->color == RED);
-    assert(probe->size == 0);
-    probe = NULL;
+    assert(v != NULL);
+    for (size_t i = 0; i < total; ++i)
+    {
+        uint8_t const element = (uint8_t) i;
 
-    probe = (Fish*) Vec_get(v, 1);
-    assert(probe != NULL);
-    assert(probe->color == BLUE);
-    assert(probe->size == 10);
-    probe = NULL;
+        assert(true == Vec_append(v, &element, sizeof(element)));
+    }
 
-    probe = (Fish*) Vec_get(v, 2);
-    assert(probe != NULL);
-    assert(probe->color == GREEN);
-    assert(probe->size == 1);
-    probe = NULL;
+    assert(0 == Vec_where(v, &(uint8_t){0}, sizeof(uint8_t)));
+    assert(42 == Vec_where(v, &(uint8_t){42}, sizeof(uint8_t)));
+    assert(255 == Vec_where(v, &(uint8_t){255}, sizeof(uint8_t)));
+    assert(true == Vec_has(v, &(uint8_t){255}, sizeof(uint8_t)));
 
-    probe = (Fish*) Vec_get(v, 3);
-    assert(probe != NULL);
-    assert(probe->color == BLUE);
-    assert(probe->size == 2);
-    probe = NULL;
+    // Every `42` is removed, leaving none to find.
+    assert(4 == Vec_remove_all(v, &(uint8_t){42}, sizeof(uint8_t)));
+    assert(Vec_count(v) == Vec_where(v, &(uint8_t){42}, sizeof(uint8_t)));
+    assert(false == Vec_has(v, &(uint8_t){42}, sizeof(uint8_t)));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_slack_tail(void)
+/**
+ * @brief Fills the given vector with `n` elements, whose bytes are all `1`s
+ * except for those of the element at the given index, whose bytes are all `2`s
+ * @param v The vector to fill (emptied first)
+ * @param n How many elements to fill the vector with
+ * @param X_index The index of the odd element out (which may be `n` or more for
+ * there to be no odd element out at all)
+ */
+static void fill_with_one_odd_element(Vec* v,
+                                      size_t const n,
+                                      size_t const X_index)
 {
-    Vec* v = Vec_new(5, sizeof(char));
-
-    assert(v != NULL);
+    uint8_t element[8];
+    size_t const width = Vec_element_size(v);
 
-    // Add some elements to the vector.
-    size_t const initial_cap = Vec_capacity(v);
+    assert(width <= sizeof(element));
+    while (Vec_count(v) > 0)
+    {
+        Vec_remove(v, 0);
+    }
 
-    Vec_append(v, &(char){'a'}, sizeof(char)); // Index 0
-    Vec_append(v, &(char){'b'}, sizeof(char)); // Index 1
-    Vec_append(v, &(char){'d'}, sizeof(char)); // Index 2
-    assert(Vec_count(v) == 3);
-    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+    for (size_t i = 0; i < n; ++i)
+    {
+        memset(element, (i == X_index) ? 2 : 1, width);
+        assert(true == Vec_append(v, element, width));
+    }
+}
 
+static void test_where_fixed_width(void)
+{
     /*
-     * Insert something at the tail end of the vector's elements when the vector
-     * still has slack.
+     * Search vectors of 2, 4, and 8 byte elements (which are scanned many
+     * elements at a time) of many different lengths, with the target element
+     * at every possible index, including indices in the "tail" elements that
+     * don't fill a whole SIMD register:
      *
      * ```
-     *        Will insert here
-     *        v
-     * [a][b][d][ ][ ]. . .
-     *  0  1  2  3  4
+     * [1][1][1][X][1][1]. . .
+     *  0  1  2  3  4  5
      * ```
      */
-    assert(Vec_insert(v, 2, &(char){'c'}, sizeof(char)) == true);
+    size_t const widths[] = {2, 4, 8};
+    uint8_t X[8];
+
+    memset(X, 2, sizeof(X));
+    for (size_t w = 0; w < (sizeof(widths) / sizeof(widths[0])); ++w)
+    {
+        Vec* v = Vec_new(1, widths[w]);
+
+        assert(v != NULL);
+        for (size_t n = 1; n <= 70; ++n)
+        {
+            for (size_t X_index = 0; X_index <= n; ++X_index)
+            {
+                fill_with_one_odd_element(v, n, X_index);
+
+                // When `X_index` is `n`, there's no `X`, so `n` is expected.
+                assert(X_index == Vec_where(v, X, widths[w]));
+                assert((X_index < n) == Vec_has(v, X, widths[w]));
+            }
+        }
+
+        Vec_destroy(&v);
+    }
 
     /*
-     * The vector should now look like:
+     * Bytes that match the target's only when read across two elements don't
+     * count as a match.
+     *
+     * E.g., for 2 byte elements, searching for `[0xAB][0xCD]` in
      *
      * ```
-     *        Inserted here
-     *        v
-     * [a][b][c][d][ ]. . .
-     *  0  1  2  3  4
+     * [0x00][0xAB] [0xCD][0x00]
+     *  element 0    element 1
      * ```
+     *
+     * finds nothing.
      */
-    assert(Vec_count(v) == 4);
-    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
-
-    char* probe = NULL;
-
-    probe = (char*) Vec_get(v, 0);
-    assert(probe != NULL);
-    assert(*probe == 'a');
-    probe = NULL;
-
-    probe = (char*) Vec_get(v, 1);
-    assert(probe != NULL);
-    assert(*probe == 'b');
-    probe = NULL;
-
-    probe = (char*) Vec_get(v, 2);
-    assert(probe != NULL);
-    assert(*probe == 'c');
-    probe = NULL;
+    Vec* v = Vec_new(64, sizeof(uint16_t));
+    uint8_t const straddled[2] = {0xAB, 0xCD};
 
-    probe = (char*) Vec_get(v, 3);
-    assert(probe != NULL);
-    assert(*probe == 'd');
+    assert(v != NULL);
+    for (size_t i = 0; i < 32; ++i)
+    {
+        assert(true == Vec_append(v, (uint8_t[2]){0x00, 0xAB}, 2));
+        assert(true == Vec_append(v, (uint8_t[2]){0xCD, 0x00}, 2));
+    }
+    assert(Vec_count(v) == Vec_where(v, straddled, sizeof(straddled)));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_slack_past_tail(void)
+static void test_has_invalid(void)
 {
-    Vec* v = Vec_new(5, sizeof(char));
+    Vec* v = Vec_new(5, sizeof(uint16_t));
+    uint16_t const element = 7;
 
     assert(v != NULL);
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(Vec_count(v) == 1);
+    assert(true == Vec_has(v, &element, sizeof(uint16_t)));
 
-    // Add some elements to the vector.
-    size_t const initial_cap = Vec_capacity(v);
+    // When the item size disagrees with the vector's declared element size
+    assert(false == Vec_has(v, &element, sizeof(uint32_t)));
 
-    Vec_append(v, &(char){'a'}, sizeof(char)); // Index 0
-    Vec_append(v, &(char){'b'}, sizeof(char)); // Index 1
-    Vec_append(v, &(char){'c'}, sizeof(char)); // Index 2
-    assert(Vec_count(v) == 3);
-    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+    // When pointers are null
+    assert(false == Vec_has(v, NULL, sizeof(uint16_t)));
+    assert(false == Vec_has(NULL, &element, sizeof(element)));
+    assert(false == Vec_has(NULL, NULL, sizeof(uint16_t)));
 
-    /*
-     * Insert something at one past the last index of the vector's elements when
-     * the vector still has slack.
-     *
-     * ```
-     *           Will insert here
-     *           v
-     * [a][b][c][ ][ ]. . .
-     *  0  1  2  3  4
-     * ```
-     */
-    assert(Vec_insert(v, 3, &(char){'d'}, sizeof(char)) == true);
+    Vec_destroy(&v);
+}
 
+static void test_has(void)
+{
     /*
-     * The vector should now look like:
+     * Make the following vector:
      *
      * ```
-     *           Inserted here
-     *           v
-     * [a][b][c][d][ ]. . .
-     *  0  1  2  3  4
+     * [3][5][5][7]
+     *  0  1  2  3
      * ```
      */
-    assert(Vec_count(v) == 4);
-    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
+    Vec* v = Vec_new(5, sizeof(int));
+    int const first = 3;
+    int const middle = 5;
+    int const last = 7;
 
-    char* probe = NULL;
+    // `false` is returned when searching an empty vector.
+    assert(v != NULL);
+    assert(false == Vec_has(v, &first, sizeof(first)));
 
-    probe = (char*) Vec_get(v, 0);
-    assert(probe != NULL);
-    assert(*probe == 'a');
-    probe = NULL;
+    // Add the elements.
+    assert(true == Vec_append(v, &first, sizeof(first)));
+    assert(true == Vec_append(v, &middle, sizeof(middle)));
+    assert(true == Vec_append(v, &middle, sizeof(middle)));
+    assert(true == Vec_append(v, &last, sizeof(last)));
+    assert(Vec_count(v) == 4);
 
-    probe = (char*) Vec_get(v, 1);
-    assert(probe != NULL);
-    assert(*probe == 'b');
-    probe = NULL;
+    // We should find the first element.
+    assert(true == Vec_has(v, &first, sizeof(first)));
 
-    probe = (char*) Vec_get(v, 2);
-    assert(probe != NULL);
-    assert(*probe == 'c');
-    probe = NULL;
+    // We should find an element in the middle.
+    assert(true == Vec_has(v, &middle, sizeof(middle)));
 
-    probe = (char*) Vec_get(v, 3);
-    assert(probe != NULL);
-    assert(*probe == 'd');
+    // We should find the last element.
+    assert(true == Vec_has(v, &last, sizeof(last)));
+
+    // We should not find elements that aren't in the vector.
+    assert(false == Vec_has(v, &(int){6}, sizeof(int)));
+    assert(false == Vec_has(v, &(int){42}, sizeof(int)));
+    assert(false == Vec_has(v, &(int){13}, sizeof(int)));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_slack_head(void)
+static void test_has_inner_pointer(void)
 {
-    Vec* v = Vec_new(5, sizeof(char));
-
-    assert(v != NULL);
-
-    // Add some elements to the vector.
-    size_t const initial_cap = Vec_capacity(v);
-
-    Vec_append(v, &(char){'b'}, sizeof(char)); // Index 0
-    Vec_append(v, &(char){'c'}, sizeof(char)); // Index 1
-    Vec_append(v, &(char){'d'}, sizeof(char)); // Index 2
-    assert(Vec_count(v) == 3);
-    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
-
-    /*
-     Insert something at the beginning of the vector when the vector has slack.
-     *
-     * ```
-     *  Will insert here
-     *  v
-     * [b][c][d][ ][ ]. . .
-     *  0  1  2  3  4
-     * ```
-     */
-    assert(Vec_insert(v, 0, &(char){'a'}, sizeof(char)) == true);
-
     /*
-     * The vector should now look like:
+     * Make the following vector:
      *
      * ```
-     *  Inserted here
-     *  v
-     * [a][b][c][d][ ]. . .
-     *  0  1  2  3  4
+     * [9][8][7]
+     *  0  1  2
      * ```
      */
-    assert(Vec_count(v) == 4);
-    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
+    Vec* v = Vec_new(3, sizeof(int32_t));
 
-    char* probe = NULL;
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int32_t){9}, sizeof(int32_t)));
+    assert(true == Vec_append(v, &(int32_t){8}, sizeof(int32_t)));
+    assert(true == Vec_append(v, &(int32_t){7}, sizeof(int32_t)));
+    assert(3 == Vec_count(v));
 
-    probe = (char*) Vec_get(v, 0);
-    assert(probe != NULL);
-    assert(*probe == 'a');
-    probe = NULL;
+    // Get a pointer to the first element inside the vector.
+    int32_t* probe = (int32_t*) Vec_get(v, 0);
 
-    probe = (char*) Vec_get(v, 1);
+    // The vector should report possessing the first element.
     assert(probe != NULL);
-    assert(*probe == 'b');
-    probe = NULL;
+    assert(true == Vec_has(v, probe, sizeof(*probe)));
 
-    probe = (char*) Vec_get(v, 2);
+    // Ditto for the second element
+    probe = (int32_t*) Vec_get(v, 1);
     assert(probe != NULL);
-    assert(*probe == 'c');
-    probe = NULL;
+    assert(true == Vec_has(v, probe, sizeof(*probe)));
 
-    probe = (char*) Vec_get(v, 3);
+    // Ditto for the third element
+    probe = (int32_t*) Vec_get(v, 2);
     assert(probe != NULL);
-    assert(*probe == 'd');
+    assert(true == Vec_has(v, probe, sizeof(*probe)));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_until_full(void)
+static void test_has_if_invalid(void)
 {
-    Vec* v = Vec_new(5, sizeof(uint64_t));
+    Vec* v = Vec_new(5, sizeof(uint16_t));
+    uint16_t const element = 2;
 
     assert(v != NULL);
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(Vec_count(v) == 1);
+    assert(true == Vec_has(v, &element, sizeof(uint16_t)));
 
     /*
-     * Fill the vector to capacity using inserts.
+     * Search for an element of the wrong size.
+     *
+     * `less_than_three()` expects `sizeof(int)` but `Vec_where_if()` will give
+     * it `sizeof(uint16_t)`.
+     *
+     * The predicate will then return false for all elements. This is
+     * essentially the same as never finding an element that satisfies the
+     * predicate, so we expect to always get back false.
+     */
+    assert(false == Vec_has_if(v, less_than_three));
+
+    // When pointers are null
+    assert(false == Vec_has_if(v, NULL));
+    assert(false == Vec_has_if(NULL, less_than_three));
+    assert(false == Vec_has_if(NULL, NULL));
+
+    Vec_destroy(&v);
+}
+
+static void test_has_if_helper(Vec* v, size_t const n, size_t const X_index)
+{
+    /*
+     * Make a vector that looks like this
      *
      * ```
-     *  Will insert at every index
-     *  v  v  v  v  v  v . . . v
-     * [ ][ ][ ][ ][ ][ ]. . .[ ]
-     *  0  1  2  3  4  5       ^
-     *                         Current capacity
+     * [X][y][y][y]
+     *  0  1  2  3
      * ```
+     *
+     * where `X` is an element we're searching for via the `less_than_three()`
+     * predicate (so, `X` is some `int` less than 3) at whatever `X_index` is
+     * and `y` is any other element.
      */
-    size_t curr_cap = Vec_capacity(v);
+    int const X = -2;
 
-    for (size_t i = 0; i < curr_cap; ++i)
+    // Add `n` elements, among them one `X` at `X_index`.
+    for (size_t i = 0; i < n; ++i)
     {
-        assert(Vec_insert(v,
-                          i,
-                          &(uint64_t){i},
-                          sizeof(uint64_t)) == true);
+        if (i == X_index)
+        {
+            assert(true == Vec_append(v, &X, sizeof(X)));
+        }
+        else
+        {
+            assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+        }
     }
-    assert(Vec_count(v) == curr_cap); // Vector should be full.
-    assert(Vec_capacity(v) == curr_cap); // But it hasn't resized yet.
+
+    // Check vector content.
+    assert(Vec_count(v) == n);
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        int* probe = NULL;
+
+        probe = (int*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i == X_index)
+        {
+            assert(true == less_than_three(probe, sizeof(int)));
+        }
+        else
+        {
+            assert(false == less_than_three(probe, sizeof(int)));
+        }
+    }
+}
+
+static void test_has_if_head(void)
+{
+    size_t const cap = 4;
+    Vec* v = Vec_new(cap, sizeof(int));
+
+    // `false` is returned when searching an empty vector.
+    assert(v != NULL);
+    assert(false == Vec_has_if(v, less_than_three));
 
     /*
-     * The vector should now look like:
+     * Make a vector that looks like this:
      *
      * ```
-     *  Inserted at every index
-     *  v  v  v  v  v  v . . . v
-     * [0][1][2][3][4][5]. . .[x]
-     *  0  1  2  3  4  5       ^
-     *                         Current capacity
+     * [X][y][y][y]
+     *  0  1  2  3
      * ```
      */
-    for (size_t i = 0; i < curr_cap; ++i)
-    {
-        uint64_t* probe = NULL;
+    size_t const X_index = 0;
 
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
-        assert(*probe == (uint64_t){i});
-    }
+    test_has_if_helper(v, cap, X_index);
+
+    // Search for the `X`.
+    assert(true == Vec_has_if(v, less_than_three));
 
     Vec_destroy(&v);
 }
 
-/**
- * @param initial_cap_hint The vector's minimum initial capacity
- * @returns A new vector sized according to the given capacity hint, full to
- * capacity with different `uint64_t` elements
- */
-static Vec* new_full_u64_vec(size_t const initial_cap_hint)
+static void test_has_if_middle(void)
 {
-    Vec* v = Vec_new(initial_cap_hint, sizeof(uint64_t));
+    size_t const cap = 4;
+    Vec* v = Vec_new(cap, sizeof(int));
 
     assert(v != NULL);
 
-    // Fill the vector to capacity.
-    size_t const initial_cap = Vec_capacity(v);
-
-    for (size_t i = 0; i < initial_cap; ++i)
-    {
-        Vec_append(v, &(uint64_t){i}, sizeof((uint64_t){i}));
-    }
-    assert(Vec_count(v) == initial_cap); // The vector's full.
-    assert(Vec_capacity(v) == initial_cap); // The vector didn't expand yet.
+    /*
+     * Make a vector that looks like this:
+     *
+     * ```
+     * [y][y][X][y]
+     *  0  1  2  3
+     * ```
+     */
+    size_t const X_index = 2;
 
-    // Every element should be equal to its index.
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        uint64_t* probe = NULL;
+    test_has_if_helper(v, cap, X_index);
 
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
-        assert(*probe == (uint64_t){i});
-    }
+    // Search for the `X`.
+    assert(true == Vec_has_if(v, less_than_three));
 
-    return v;
+    Vec_destroy(&v);
 }
 
-static void test_insert_full_middle(void)
+static void test_has_if_tail(void)
 {
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
+    size_t const cap = 4;
+    Vec* v = Vec_new(cap, sizeof(int));
+
+    assert(v != NULL);
 
     /*
-     * Insert something in the middle the vector when it's full.
+     * Make a vector that looks like this:
      *
      * ```
-     *              Will insert here
-     *              v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
-     *  0  1  2  3  4  5  6  7  8  9       ^
-     *                                     Initial capacity
+     * [y][y][y][X]
+     *  0  1  2  3
      * ```
      */
-    size_t initial_cap = Vec_capacity(v);
-    size_t const inserted_element_index = 4;
-    uint64_t const inserted_element = 9;
+    size_t const X_index = 3;
 
-    assert(Vec_insert(v,
-                      inserted_element_index,
-                      &inserted_element,
-                      sizeof(uint64_t)) == true);
+    test_has_if_helper(v, cap, X_index);
+
+    // Search for the `X`.
+    assert(true == Vec_has_if(v, less_than_three));
+
+    Vec_destroy(&v);
+}
+
+static void test_has_if_nowhere(void)
+{
+    size_t const cap = 4;
+    Vec* v = Vec_new(cap, sizeof(int));
+
+    assert(v != NULL);
 
     /*
-     * The vector should now look like:
+     * Make a vector that looks like this:
      *
      * ```
-     *              Inserted here
-     *              v
-     * [0][1][2][3][9][4][5][6][7][8]. . .[x - 1][x]. . .[ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9         ^                  ^
-     *                                       Initial capacity   New capacity
+     * [y][y][y][y]
+     *  0  1  2  3
      * ```
      */
-    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
-    assert(Vec_count(v) == (initial_cap + 1));
+    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){7}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){8}, sizeof(int)));
 
+    // Check vector content.
+    assert(Vec_count(v) == cap);
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
-        uint64_t* probe = NULL;
+        int* probe = NULL;
 
-        probe = (uint64_t*) Vec_get(v, i);
+        probe = (int*) Vec_get(v, i);
         assert(probe != NULL);
-
-        if (i < inserted_element_index)
-        {
-            // The elements before the insertion site are still `i`.
-            assert(*probe == i);
-        }
-        else if (i == inserted_element_index)
-        {
-            // The insertion site contains the inserted element.
-            assert(*probe == inserted_element);
-        }
-        else
-        {
-            // The elements after the insertion site are `i - 1`.
-            assert(*probe == (i - 1));
-        }
+        assert(false == less_than_three(probe, sizeof(int)));
     }
 
-    Vec_destroy(&v);
-}
+    // Search for the `X`. (It shouldn't exist.)
+    assert(false == Vec_has_if(v, less_than_three));
 
-/**
- * @param i An index
- * @return A `Fish` whose color and size is based on the given index
- */
-static Fish index_to_Fish(size_t const i)
-{
-    return (Fish)
-    {
-        .color = i % COLOR_NUM,
-        .size = i
-    };
+    Vec_destroy(&v);
 }
 
-/**
- * @param initial_cap_hint The vector's minimum initial capacity
- * @returns A new vector sized according to the given capacity hint, full to
- * capacity with different `Fish` elements
- */
-static Vec* new_full_Fish_vec(size_t const initial_cap_hint)
+static void test_get_invalid(void)
 {
-    Vec* v = Vec_new(initial_cap_hint, sizeof(Fish));
+    size_t const cap_hint = 5;
+    Vec* v = Vec_new(cap_hint, sizeof(int));
 
+    // A null pointer is returned when searching an empty vector.
     assert(v != NULL);
+    assert(NULL == Vec_get(v, 0));
 
-    // Fill the vector to capacity.
-    size_t const initial_cap = Vec_capacity(v);
+    // Add some elements.
+    assert(true == Vec_append(v, &(int){5}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){6}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){7}, sizeof(int)));
+    assert(Vec_count(v) == 3); // The elements were added.
 
-    for (size_t i = 0; i < initial_cap; ++i)
-    {
-        Fish const f = index_to_Fish(i);
+    // The initial capacity should be greater than the number of elements.
+    assert(Vec_capacity(v) > Vec_count(v));
 
-        Vec_append(v, &f, sizeof(f));
-    }
-    assert(Vec_count(v) == initial_cap); // The vector's full.
-    assert(Vec_capacity(v) == initial_cap); // The vector didn't expand yet.
+    /*
+     * The getter function fails, and returns a null pointer, if the given index
+     * is out of bounds of a vector's elements.
+     *
+     * ```
+     * [a][b][c][ ][ ]
+     *  0  1  2  3  4
+     * ```
+     *
+     * So, for the vector above, only indices 0, 1, and 2, can be queried. The
+     * bound of the vector's elements is [0, 2].
+     *
+     * Query an index out of the vector's bounds.
+     */
+    int* probe = NULL;
 
-    // Every element should be equal to its index.
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        Fish* probe = NULL;
+    probe = (int*) Vec_get(v, Vec_count(v));
+    assert(probe == NULL); // Getter failed and returned a null pointer.
 
-        probe = (Fish*) Vec_get(v, i);
-        assert(probe != NULL);
+    probe = (int*) Vec_get(v, Vec_count(v) + 1);
+    assert(probe == NULL);
 
-        Fish const f = index_to_Fish(i);
+    probe = (int*) Vec_get(v, Vec_capacity(v));
+    assert(probe == NULL);
 
-        assert(probe->color == f.color);
-        assert(probe->size == f.size);
-    }
+    Vec_destroy(&v);
+}
 
-    return v;
+static void test_get(void)
+{
+    Vec* v = Vec_new(5, sizeof(int));
+    int const first = 5;
+    int const second = 6;
+    int const third = 7;
+    int const fourth = 8;
+    int const fifth = 9;
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &first, sizeof(first)));
+    assert(true == Vec_append(v, &second, sizeof(second)));
+    assert(true == Vec_append(v, &third, sizeof(third)));
+    assert(true == Vec_append(v, &fourth, sizeof(fourth)));
+    assert(true == Vec_append(v, &fifth, sizeof(fifth)));
+    assert(Vec_count(v) == 5);
+
+    // Verify the elements can be retrieved successfully.
+    int* probe = NULL;
+
+    probe = (int*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(*probe == first);
+
+    probe = (int*) Vec_get(v, 1);
+    assert(probe != NULL);
+    assert(*probe == second);
+
+    probe = (int*) Vec_get(v, 2);
+    assert(probe != NULL);
+    assert(*probe == third);
+
+    probe = (int*) Vec_get(v, 3);
+    assert(probe != NULL);
+    assert(*probe == fourth);
+
+    probe = (int*) Vec_get(v, 4);
+    assert(probe != NULL);
+    assert(*probe == fifth);
+
+    Vec_destroy(&v);
 }
 
-static void test_insert_full_middle_struct(void)
+static void test_get_unchecked(void)
 {
-    Vec* v = new_full_Fish_vec(10); // Get a full vector.
+    Vec* v = Vec_new(4, sizeof(int64_t));
 
-    /*
-     * Insert something in the middle the vector when it's full.
-     *
-     * ```
-     *              Will insert here
-     *              v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
-     *  0  1  2  3  4  5  6  7  8  9       ^
-     *                                     Initial capacity
-     * ```
-     */
-    size_t initial_cap = Vec_capacity(v);
-    size_t const inserted_element_index = 4;
-    Fish const inserted_element =
+    assert(v != NULL);
+    for (int64_t i = 0; i < 10; ++i)
     {
-        .color = BLUE,
-        .size = 123456
-    };
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
 
-    assert(Vec_insert(v,
-                      inserted_element_index,
-                      &inserted_element,
-                      sizeof(Fish)) == true);
+    // Unchecked access gets the same elements as checked access.
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        assert(Vec_get(v, i) == Vec_get_unchecked(v, i));
+        assert(*(int64_t*) Vec_get_unchecked(v, i) == (int64_t) i);
+    }
 
-    /*
-     * The vector should now look like this (with the inserted element denoted
-     * by `X`):
-     *
-     * ```
-     *              Inserted here
-     *              v
-     * [0][1][2][3][X][4][5][6][7][8]. . .[x - 1][x]. . .[ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9         ^                  ^
-     *                                       Initial capacity   New capacity
-     * ```
-     */
-    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
-    assert(Vec_count(v) == (initial_cap + 1));
+    Vec_destroy(&v);
+}
 
-    for (size_t i = 0; i < Vec_count(v); ++i)
+static void test_data(void)
+{
+    assert(NULL == Vec_data(NULL));
+
+    Vec* v = Vec_new(4, sizeof(int32_t));
+
+    assert(v != NULL);
+
+    // Even an empty vector has a data pointer.
+    assert(NULL != Vec_data(v));
+
+    for (int32_t i = 0; i < 10; ++i)
     {
-        Fish* probe = NULL;
-        Fish expected;
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
 
-        probe = (Fish*) Vec_get(v, i);
-        assert(probe != NULL);
+    // The elements are contiguous from the data pointer.
+    int32_t* elements = (int32_t*) Vec_data(v);
 
-        if (i < inserted_element_index)
-        {
-            // The elements before the insertion site still correspond to `i`.
-            expected = index_to_Fish(i);
-            assert(probe->color == expected.color);
-            assert(probe->size == expected.size);
-        }
-        else if (i == inserted_element_index)
-        {
-            // The insertion site contains the inserted element.
-            assert(probe->color == inserted_element.color);
-            assert(probe->size == inserted_element.size);
-        }
-        else
-        {
-            // The elements after the insertion site correspond to `i - 1`.
-            expected = index_to_Fish(i - 1);
-            assert(probe->color == expected.color);
-            assert(probe->size == expected.size);
-        }
+    assert(elements == Vec_get(v, 0));
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        assert(elements[i] == i);
+        elements[i] *= 3;
     }
+    assert(9 == Vec_where(v, &(int32_t){27}, sizeof(int32_t)));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_full_tail(void)
+static void test_span(void)
 {
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
+    void* begin = &(int){0};
+    void* end = &(int){0};
 
-    /*
-     * Insert something at the last index.
-     *
-     * ```
-     *                                     Will insert here
-     *                                     v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
-     *  0  1  2  3  4  5  6  7  8  9       ^
-     *                                     Initial capacity
-     * ```
-     */
-    size_t const initial_cap = Vec_capacity(v);
-    size_t const inserted_element_index = Vec_count(v) - 1; // The last index
-    uint64_t const inserted_element = 42;
-    uint64_t const shifted_element = Vec_count(v) - 1; // `x` will be shifted.
+    // Failures null out the range.
+    assert(false == Vec_span(NULL, &begin, &end));
+    assert(begin == NULL);
+    assert(end == NULL);
 
-    assert(Vec_insert(v,
-                      inserted_element_index,
-                      &inserted_element,
-                      sizeof(inserted_element)) == true);
+    Vec* v = Vec_new(4, sizeof(int64_t));
 
-    /*
-     * We expect that:
-     *     - The vector was automatically resized
-     *     - The element that occupied the last index before the insertion was
-     *       shifted into the newly-expanded region of the vector
-     *
-     * If the element we just inserted is `I` and the element that occupied the
-     * last index before the insertion is `P`, the vector should look like this:
-     *
-     * ```
-     *                         Inserted here
-     *                         v
-     * [0][1][2][3][4][5]. . .[I][P][ ]. . .[ ][ ][ ][ ]
-     *  0  1  2  3  4  5       ^                      ^
-     *                         Initial capacity       Current capacity
-     * ```
-     */
-    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
-    assert(Vec_count(v) == (initial_cap + 1));
+    assert(v != NULL);
+    assert(false == Vec_span(v, NULL, &end));
+    assert(false == Vec_span(v, &begin, NULL));
 
-    for (size_t i = 0; i < Vec_count(v); ++i)
+    // An empty vector's range is empty.
+    assert(true == Vec_span(v, &begin, &end));
+    assert(begin != NULL);
+    assert(begin == end);
+
+    for (int64_t i = 0; i < 100; ++i)
     {
-        uint64_t* probe = NULL;
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
 
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
+    // The range covers every element, in order.
+    assert(true == Vec_span(v, &begin, &end));
+    assert(begin == Vec_get(v, 0));
 
-        if (i < inserted_element_index)
-        {
-            // The elements before the insertion site are still `i`.
-            assert(*probe == i);
-        }
-        else if (i == inserted_element_index)
-        {
-            // The insertion site contains the inserted element.
-            assert(*probe == inserted_element);
-        }
-        else if (i == (inserted_element_index + 1))
-        {
-            // The element after the insertion site is the shifted element.
-            assert(*probe == shifted_element);
-        }
+    int64_t expected = 0;
+
+    for (int64_t* p = begin; p != end; ++p)
+    {
+        assert(*p == expected);
+        *p = -*p;
+        ++expected;
     }
+    assert(100 == expected);
+    assert(99 == Vec_where(v, &(int64_t){-99}, sizeof(int64_t)));
 
     Vec_destroy(&v);
 }
 
-static void test_insert_full_past_tail(void)
+static void test_append_invalid(void)
 {
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
+    Vec* v = Vec_new(5, sizeof(int));
 
-    /*
-     * Insert something at one past the last index.
-     *
-     * ```
-     *                                        Will insert here
-     *                                        v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x] _
-     *  0  1  2  3  4  5  6  7  8  9       ^
-     *                                     Initial capacity
-     * ```
-     */
-    size_t const initial_cap = Vec_capacity(v);
-    size_t const inserted_element_index = Vec_count(v); // One past last index
-    uint64_t const inserted_element = 777;
+    assert(v != NULL);
 
-    assert(Vec_insert(v,
-                      inserted_element_index,
-                      &inserted_element,
-                      sizeof(inserted_element)) == true);
+    // When the item size disagrees with the vector's declared element size
+    assert(Vec_append(v, &(int){2}, sizeof(int[50])) == false);
+    assert(Vec_count(v) == 0);
 
-    /*
-     * The vector should have expanded and, if the element we just inserted is
-     * `I`, look like this:
-     *
-     * ```
-     *                            Inserted here
-     *                            v
-     * [0][1][2][3][4][5]. . .[x][I][ ]. . .[ ][ ][ ][ ]
-     *  0  1  2  3  4  5       ^                      ^
-     *                         Initial capacity       Current capacity
-     * ```
-     */
-    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
-    assert(Vec_count(v) == (initial_cap + 1));
+    // When pointers are null
+    assert(Vec_append(NULL, &(int){3}, sizeof((int){3})) == false);
+    assert(Vec_append(v, NULL, sizeof((int){3})) == false);
+    assert(Vec_append(NULL, NULL, sizeof((int){3})) == false);
+    assert(Vec_count(v) == 0);
 
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        uint64_t* probe = NULL;
+    Vec_destroy(&v);
+}
 
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
+static void test_append(void)
+{
+    Vec* v = Vec_new(5, sizeof(int));
 
-        if (i < inserted_element_index)
-        {
-            // The elements before the insertion site are still `i`.
-            assert(*probe == i);
-        }
-        else if (i == inserted_element_index)
-        {
-            // The insertion site contains the inserted element.
-            assert(*probe == inserted_element);
-        }
-    }
+    assert(v != NULL);
+
+    // Trivial case
+    assert(Vec_count(v) == 0);
+    assert(Vec_append(v, &(int){1}, sizeof((int){1})) == true);
+    assert(Vec_count(v) == 1);
 
     Vec_destroy(&v);
-}
 
-static void test_insert_full_head(void)
-{
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
+    // Automatic expansion
+    size_t const least_cap_hint = 1;
+
+    v = Vec_new(least_cap_hint, sizeof(uint64_t[4]));
+    assert(v != NULL);
 
-    /*
-     * Insert something at the head of the vector.
-     *
-     * ```
-     *  Will insert here
-     *  v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
-     *  0  1  2  3  4  5  6  7  8  9       ^
-     *                                     Initial capacity
-     * ```
-     */
     size_t const initial_cap = Vec_capacity(v);
-    size_t const inserted_element_index = 0; // Head index
-    uint64_t const inserted_element = 2023;
 
-    assert(Vec_insert(v,
-                      inserted_element_index,
-                      &inserted_element,
-                      sizeof(inserted_element)) == true);
+    assert(initial_cap >= least_cap_hint); // The hint is the minimum capacity.
 
-    /*
-     * The vector should have expanded and, if the element we just inserted is
-     * `I`, look like this:
-     *
-     * ```
-     *  Inserted here
-     *  v
-     * [I][0][1][2][3][4][5]. . .[x][I][ ]. . .[ ][ ][ ][ ]
-     *  0  1  2  3  4  5          ^                      ^
-     *                            Initial capacity       Current capacity
-     * ```
-     */
-    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
-    assert(Vec_count(v) == (initial_cap + 1));
+    // Fill up the vector to its initial capacity.
+    for (size_t i = 0; i < initial_cap; ++i)
+    {
+        uint64_t const arr[4] = {i, i, i, i};
+
+        assert(Vec_append(v, arr, sizeof(arr)) == true);
+        assert(Vec_count(v) == (i + 1));
+    }
+    assert(Vec_count(v) == Vec_capacity(v)); // Now, the vector should be full.
+    assert(Vec_capacity(v) == initial_cap); // And it shouldn't've resized yet.
+
+    // Add one more element.
+    uint64_t arr[4] = {4, 3, 2, 1};
+
+    assert(Vec_append(v, arr, sizeof(arr)) == true);
+    assert(Vec_count(v) == (initial_cap + 1)); // Going past initial capacity
+    assert(Vec_capacity(v) > initial_cap); // Should have triggered expansion
 
+    // The elements should be in the same order as appended above.
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
-        uint64_t* probe = NULL;
-
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
+        uint64_t (*stored_arr)[4] = (uint64_t (*)[4]) Vec_get(v, i);
 
-        if (i > inserted_element_index)
+        if (i < (Vec_count(v) - 1))
         {
-            // The elements after the insertion site shifted, so are `i - 1`.
-            assert(*probe == (i - 1));
+            for (size_t j = 0; j < 4; ++j)
+            {
+                // The elements are arrays of all `i`s for the `i`th element.
+                assert((*stored_arr)[j] == i);
+            }
         }
-        else
+        else if (i == (Vec_count(v) - 1))
         {
-            // The insertion site contains the inserted element.
-            assert(*probe == inserted_element);
+            // But the last element is the hardcoded `arr`.
+            assert(memcmp(stored_arr, arr, sizeof(uint64_t[4])) == 0);
         }
     }
 
     Vec_destroy(&v);
 }
 
-static Vec* insert_inner_pointer_input_helper(void)
+static void test_append_inner_pointer(void)
 {
     /*
-     * Make a non-full vector of unique elements:
+     * Make the following vector:
      *
      * ```
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     * [9][8][7][ ][ ][ ]
+     *  0  1  2  3  4  5
      * ```
      */
-    Vec* v = Vec_new(10, sizeof(int64_t));
+    Vec* v = Vec_new(6, sizeof(int32_t));
+    int32_t const first = 9;
+    int32_t const second = 8;
+    int32_t const third = 7;
 
     assert(v != NULL);
-    assert(true == Vec_append(v, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
-    assert(5 == Vec_count(v));
-    assert(Vec_capacity(v) > Vec_count(v)); // The vector's not full.
-
-    return v;
-}
+    assert(true == Vec_append(v, &first, sizeof(int32_t)));
+    assert(true == Vec_append(v, &second, sizeof(int32_t)));
+    assert(true == Vec_append(v, &third, sizeof(int32_t)));
+    assert(3 == Vec_count(v));
 
-static void test_insert_inner_pointer_head_before_insertion(void)
-{
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Get a pointer to the last element in the vector and append it. Then the
+     * vector should look like this:
      *
      * ```
-     *        target
-     *        |  Will insert here
-     *        v  v
-     *       [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *        0  1  2  3  4  5  6  7  8  9
+     * [9][8][7][7][ ][ ]
+     *  0  1  2  3  4  5
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = insert_inner_pointer_input_helper();
-
-    // Get a pointer to the element.
-    int64_t const element = 9;
-    size_t const target_index = 0;
-    size_t const insertion_index = 1;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
+    int32_t* probe = (int32_t*) Vec_get(v, 2);
+    size_t prev_cap = Vec_capacity(v);
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(probe != NULL);
+    assert(*probe == third);
+    assert(true == Vec_append(v, probe, sizeof(*probe)));
+    probe = NULL; // Pointer invalidated by the append
+    assert(Vec_capacity(v) == prev_cap); // No resize should have occurred.
+    // A copy of the element should've be added.
+    assert(4 == Vec_count(v));
+    probe = (int32_t*) Vec_get(v, 3); // Get the newly-added element.
+    assert(probe != NULL);
+    assert(*probe == third); // Check that it's a copy of the last element.
 
     /*
-     * After insertion, the vector should look like this:
+     * Repeat with the second element to make the vector look like this:
      *
      * ```
-     *     Inserted here
-     *     v
-     * [9][9][8][7][6][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     * [9][8][7][7][8][ ]
+     *  0  1  2  3  4  5
      * ```
      */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
-
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
-
-    assert(true == Vec_equal(v, expected, NULL));
+    probe = (int32_t*) Vec_get(v, 1);
+    prev_cap = Vec_capacity(v);
 
-    Vec_destroy(&v);
-    Vec_destroy(&expected);
-}
+    assert(probe != NULL);
+    assert(*probe == second);
+    assert(true == Vec_append(v, probe, sizeof(*probe)));
+    probe = NULL; // Pointer invalidated by the append
+    assert(Vec_capacity(v) == prev_cap); // No resize should have occurred.
+    // A copy of the element should've be added.
+    assert(5 == Vec_count(v));
+    probe = (int32_t*) Vec_get(v, 4);
+    assert(probe != NULL);
+    assert(*probe == second);
 
-static void test_insert_inner_pointer_head_at_insertion(void)
-{
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Repeat with the first element to make the vector look like this:
      *
      * ```
-     * target   Will insert here
-     *       \ /
-     *        |
-     *        v
-     *       [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *        0  1  2  3  4  5  6  7  8  9
+     * [9][8][7][7][8][9]
+     *  0  1  2  3  4  5
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = insert_inner_pointer_input_helper();
+    probe = (int32_t*) Vec_get(v, 0);
+    prev_cap = Vec_capacity(v);
 
-    // Get a pointer to the element.
-    int64_t const element = 9;
-    size_t const target_index = 0;
-    size_t const insertion_index = 0;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-
-    /*
-     * After insertion, the vector should look like this:
-     *
-     * ```
-     *  Inserted here
-     *  v
-     * [9][9][8][7][6][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
-
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
-
-    assert(true == Vec_equal(v, expected, NULL));
+    assert(probe != NULL);
+    assert(*probe == first);
+    assert(true == Vec_append(v, probe, sizeof(*probe)));
+    probe = NULL; // Pointer invalidated by the append
+    assert(Vec_capacity(v) == prev_cap); // No resize should have occurred.
+    // A copy of the element should've be added.
+    assert(6 == Vec_count(v));
+    probe = (int32_t*) Vec_get(v, 5);
+    assert(probe != NULL);
+    assert(*probe == first);
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_insert_inner_pointer_head_after_insertion(void)
+static void test_append_n_invalid(void)
 {
-    /*
-     * Using a pointer, `target`, to an element inside the not-full vector
-     *
-     * ```
-     *        Will insert here
-     *        |  target
-     *        v  v
-     *       [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *        0  1  2  3  4  5  6  7  8  9
-     * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
-     */
-    Vec* v = insert_inner_pointer_input_helper();
+    Vec* v = Vec_new(5, sizeof(int64_t));
+    int64_t const items[] = {1, 2, 3};
+    size_t const n = sizeof(items) / sizeof(items[0]);
 
-    // Get a pointer to the element.
-    int64_t const element = 8;
-    size_t const target_index = 1;
-    size_t const insertion_index = 0;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
+    assert(v != NULL);
 
-    assert(target != NULL);
-    assert(*target == element);
+    // Null pointers
+    assert(false == Vec_append_n(NULL, items, n, sizeof(items[0])));
+    assert(false == Vec_append_n(v, NULL, n, sizeof(items[0])));
 
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
+    // Wrong item size
+    assert(false == Vec_append_n(v, items, n, sizeof(int32_t)));
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    // An element count that can't be represented
+    assert(false == Vec_append_n(v, items, SIZE_MAX, sizeof(items[0])));
 
-    /*
-     * After insertion, the vector should look like this:
-     *
-     * ```
-     *  Inserted here
-     *  v
-     * [8][9][8][7][6][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+    // Nothing was appended by any of those.
+    assert(0 == Vec_count(v));
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &element, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
+    // Appending no items does nothing (successfully).
+    assert(true == Vec_append_n(v, items, 0, sizeof(items[0])));
+    assert(0 == Vec_count(v));
 
-    assert(true == Vec_equal(v, expected, NULL));
+    // Extending with/to null vectors or vectors of different element sizes
+    Vec* other = Vec_new(5, sizeof(int32_t));
+
+    assert(other != NULL);
+    assert(true == Vec_append(other, &(int32_t){1}, sizeof(int32_t)));
+    assert(false == Vec_extend(NULL, v));
+    assert(false == Vec_extend(v, NULL));
+    assert(false == Vec_extend(v, other));
+    assert(0 == Vec_count(v));
 
+    Vec_destroy(&other);
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_insert_inner_pointer_middle_before_insertion(void)
+static void test_append_n(void)
 {
-    /*
-     * Using a pointer, `target`, to an element inside the not-full vector
-     *
-     * ```
-     *        target
-     *        |  Will insert here
-     *        v  v
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
-     */
-    Vec* v = insert_inner_pointer_input_helper();
+    Vec* v = Vec_new(4, sizeof(int64_t));
 
-    // Get a pointer to the element.
-    int64_t const element = 7;
-    size_t const target_index = 2;
-    size_t const insertion_index = 3;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
+    assert(v != NULL);
 
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
+    // Append a batch that fits.
+    int64_t const few[] = {0, 1, 2};
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(true == Vec_append_n(v, few, 3, sizeof(few[0])));
+    assert(3 == Vec_count(v));
+    assert(4 == Vec_capacity(v));
 
     /*
-     * After insertion, the vector should look like this:
-     *
-     * ```
-     *           Inserted here
-     *           v
-     * [9][8][7][7][6][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
+     * Append a batch that's much larger than the vector's capacity. The vector
+     * resizes once, to fit the whole batch, rather than repeatedly doubling.
      */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+    int64_t many[1000];
+    size_t const n = sizeof(many) / sizeof(many[0]);
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        many[i] = (int64_t) (i + 3);
+    }
+    assert(true == Vec_append_n(v, many, n, sizeof(many[0])));
+    assert((n + 3) == Vec_count(v));
+    assert((n + 3) == Vec_capacity(v));
 
-    assert(true == Vec_equal(v, expected, NULL));
+    // A small batch appended to a full vector expands it as usual.
+    assert(true == Vec_append_n(v, few, 1, sizeof(few[0])));
+    assert((n + 4) == Vec_count(v));
+    assert(Vec_capacity(v) >= 2 * (n + 3));
+
+    // The elements are all in order: `[0][1][2]. . .[1002][0]`
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        int64_t const* probe = (int64_t const*) Vec_get(v, i);
+
+        assert(probe != NULL);
+        assert(*probe == ((i < (n + 3)) ? (int64_t) i : 0));
+    }
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_insert_inner_pointer_middle_at_insertion(void)
+static void test_extend(void)
 {
-    /*
-     * Using a pointer, `target`, to an element inside the not-full vector
-     *
-     * ```
-     *    target   Will insert here
-     *          \ /
-     *           |
-     *           v
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
-     */
-    Vec* v = insert_inner_pointer_input_helper();
-
-    // Get a pointer to the element.
-    int64_t const element = 6;
-    size_t const target_index = 3;
-    size_t const insertion_index = 3;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
+    Vec* a = Vec_new(2, sizeof(int64_t));
+    Vec* b = Vec_new(2, sizeof(int64_t));
+
+    assert(a != NULL);
+    assert(b != NULL);
+
+    // `a` is `[1][2]`, `b` is `[3][4][5]`.
+    assert(true == Vec_append(a, &(int64_t){1}, sizeof(int64_t)));
+    assert(true == Vec_append(a, &(int64_t){2}, sizeof(int64_t)));
+    assert(true == Vec_append(b, &(int64_t){3}, sizeof(int64_t)));
+    assert(true == Vec_append(b, &(int64_t){4}, sizeof(int64_t)));
+    assert(true == Vec_append(b, &(int64_t){5}, sizeof(int64_t)));
+
+    // Extending `a` with `b` makes `a` `[1][2][3][4][5]` and leaves `b` alone.
+    assert(true == Vec_extend(a, b));
+    assert(5 == Vec_count(a));
+    assert(3 == Vec_count(b));
+    for (size_t i = 0; i < Vec_count(a); ++i)
+    {
+        int64_t const* probe = (int64_t const*) Vec_get(a, i);
 
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
+        assert(probe != NULL);
+        assert(*probe == (int64_t) (i + 1));
+    }
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    // Extending `b` with itself doubles it up: `[3][4][5][3][4][5]`
+    assert(true == Vec_extend(b, b));
+    assert(6 == Vec_count(b));
+    for (size_t i = 0; i < Vec_count(b); ++i)
+    {
+        int64_t const* probe = (int64_t const*) Vec_get(b, i);
 
-    /*
-     * After insertion, the vector should look like this:
-     *
-     * ```
-     *           Inserted here
-     *           v
-     * [9][8][7][6][6][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+        assert(probe != NULL);
+        assert(*probe == (int64_t) ((i % 3) + 3));
+    }
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
+    // Extending with an empty vector does nothing.
+    Vec* empty = Vec_new(1, sizeof(int64_t));
 
-    assert(true == Vec_equal(v, expected, NULL));
+    assert(empty != NULL);
+    assert(true == Vec_extend(a, empty));
+    assert(5 == Vec_count(a));
 
-    Vec_destroy(&v);
-    Vec_destroy(&expected);
+    Vec_destroy(&empty);
+    Vec_destroy(&b);
+    Vec_destroy(&a);
 }
 
-static void test_insert_inner_pointer_middle_after_insertion(void)
+static void test_insert_invalid(void)
 {
-    /*
-     * Using a pointer, `target`, to an element inside the not-full vector
-     *
-     * ```
-     *        Will insert here
-     *        |  target
-     *        v  v
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
-     */
-    Vec* v = insert_inner_pointer_input_helper();
+    Vec* v = Vec_new(10, sizeof(uint64_t));
 
-    // Get a pointer to the element.
-    int64_t const element = 6;
-    size_t const target_index = 3;
-    size_t const insertion_index = 2;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
+    assert(v != NULL);
 
-    assert(target != NULL);
-    assert(*target == element);
+    // Insert something out of bounds of the capacity.
+    assert(Vec_insert(v,
+                      Vec_capacity(v),
+                      &(uint64_t){0},
+                      sizeof((uint64_t){0})) == false);
+    assert(Vec_count(v) == 0); // Insertion was rejected.
 
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
+    // Insert something out of `[0, n]` bounds (`n` being the element count, 0).
+    assert(Vec_insert(v,
+                      1,
+                      &(uint64_t){1},
+                      sizeof((uint64_t){1})) == false);
+    assert(Vec_count(v) == 0); // Insertion was rejected.
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    // Insert something within `[0, n]` bounds.
+    uint64_t const first = 1776;
+    uint64_t const second = 1787;
+    uint64_t* probe = NULL;
+
+    assert(Vec_insert(v,
+                      0,
+                      &first,
+                      sizeof((uint64_t){0})) == true);
+    assert(Vec_count(v) == 1); // Insertion was accepted.
+    probe = (uint64_t*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(*probe == first);
+    probe = NULL;
+
+    assert(Vec_insert(v,
+                      1,
+                      &second,
+                      sizeof((uint64_t){1})) == true);
+    assert(Vec_count(v) == 2); // Insertion was accepted.
+    probe = (uint64_t*) Vec_get(v, 1);
+    assert(probe != NULL);
+    assert(*probe == second);
+    probe = NULL;
+
+    // `n` is now 2. Insert something out of `[0, n]` bounds again, at 3.
+    assert(Vec_insert(v,
+                      3,
+                      &(uint64_t){3},
+                      sizeof((uint64_t){3})) == false);
+    assert(Vec_count(v) == 2); // Insertion was rejected.
+
+    // Insert something with an incorrect size.
+    assert(Vec_insert(v,
+                      0,
+                      &(uint32_t){9},
+                      sizeof((uint32_t){9})) == false); // A `uint32_t`
+    assert(Vec_count(v) == 2); // Insertion was rejected.
+
+    assert(Vec_insert(v,
+                      0,
+                      &(uint64_t){9},
+                      sizeof((uint32_t){9})) == false); // Just `uint32_t` size
+    assert(Vec_count(v) == 2); // Insertion was rejected.
+
+    assert(Vec_insert(v,
+                      0,
+                      &(char){'a'},
+                      sizeof((char){'a'})) == false); // A `char`
+    assert(Vec_count(v) == 2); // Insertion was rejected.
+
+    // Insert with null pointers.
+    assert(Vec_insert(NULL,
+                      0,
+                      NULL,
+                      sizeof((uint64_t){9})) == false);
+    assert(Vec_count(v) == 2); // Insertion was rejected.
+
+    assert(Vec_insert(NULL,
+                      0,
+                      &(uint64_t){9},
+                      sizeof((uint64_t){9})) == false);
+    assert(Vec_count(v) == 2); // Insertion was rejected.
+
+    assert(Vec_insert(v,
+                      0,
+                      NULL,
+                      sizeof((uint64_t){9})) == false);
+    assert(Vec_count(v) == 2); // Insertion was rejected.
+
+    Vec_destroy(&v);
+}
+
+static void test_insert_empty(void)
+{
+    size_t const initial_cap_hint = 10;
+    Vec* v = Vec_new(initial_cap_hint, sizeof(char));
+
+    assert(v != NULL);
+    assert(Vec_capacity(v) >= initial_cap_hint);
 
     /*
-     * After insertion, the vector should look like this:
+     * Insert something in an empty vector.
      *
      * ```
-     *        Inserted here
-     *        v
-     * [9][8][6][7][6][5][ ][ ][ ][ ]
+     *  Will insert here
+     *  v
+     * [ ][ ][ ][ ][ ][ ][ ][ ][ ][ ]. . .
      *  0  1  2  3  4  5  6  7  8  9
      * ```
      */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+    size_t initial_cap = Vec_capacity(v);
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
+    assert(Vec_insert(v, 0, &(char){'x'}, sizeof(char)) == true);
 
-    assert(true == Vec_equal(v, expected, NULL));
+    /*
+     * The vector should now look like:
+     *
+     * ```
+     *  Inserted here
+     *  v
+     * [x][ ][ ][ ][ ][ ][ ][ ][ ][ ]. . .
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    assert(Vec_count(v) == 1);
+    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+
+    char* probe = NULL;
+
+    probe = (char*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(*probe == (char){'x'});
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-/**
- * @brief A `Fish` comparator to be used by a vector's equality function that
- * looks only at fish size
- * @param fish_a A `Fish`
- * @param fish_b Another `Fish`
- * @return 1 if there was an input problem; 0 if the given `Fish` have the same
- * size; 2 if they have different sizes
- */
-static int fish_size_equality_comparator(void const* fish_a, void const* fish_b)
+static void test_insert_slack_middle(void)
 {
-    if (fish_a == NULL ||
-        fish_b == NULL)
-    {
-        return 1;
-    }
+    Vec* v = Vec_new(5, sizeof(char));
 
-    // We know we're dealing with `Fish`; cast to the known type.
-    Fish const* a = (Fish const*) fish_a;
-    Fish const* b = (Fish const*) fish_b;
+    assert(v != NULL);
 
-    if (a->size == b->size)
-    {
-        return 0;
-    }
+    // Add some elements to the vector.
+    size_t const initial_cap = Vec_capacity(v);
 
-    return 2;
-}
+    Vec_append(v, &(char){'a'}, sizeof(char)); // Index 0
+    Vec_append(v, &(char){'c'}, sizeof(char)); // Index 1
+    Vec_append(v, &(char){'d'}, sizeof(char)); // Index 2
+    assert(Vec_count(v) == 3);
+    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
 
-static void test_insert_inner_pointer_middle_after_insertion_struct(void)
-{
     /*
-     * Using a pointer, `target`, to a `Fish` inside the not-full vector
+     * Insert something in the middle of some elements when the vector still has
+     * slack (so it won't resize due to the insertion):
      *
      * ```
      *     Will insert here
-     *     |     target
-     *     v     v
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *     v
+     * [a][c][d][ ][ ]. . .
+     *  0  1  2  3  4
      * ```
+     */
+    assert(Vec_insert(v, 1, &(char){'b'}, sizeof(char)) == true);
+
+    /*
+     * The vector should now look like:
      *
-     * insert a copy of that `Fish` in somwhere among the others (denoted by
-     * their sizes).
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
+     * ```
+     *     Inserted here
+     *     v
+     * [a][b][c][d][ ]. . .
+     *  0  1  2  3  4
+     * ```
      */
-    Vec* v = Vec_new(10, sizeof(Fish));
+    assert(Vec_count(v) == 4);
+    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
+
+    char* probe = NULL;
+
+    probe = (char*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(*probe == 'a');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 1);
+    assert(probe != NULL);
+    assert(*probe == 'b');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 2);
+    assert(probe != NULL);
+    assert(*probe == 'c');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 3);
+    assert(probe != NULL);
+    assert(*probe == 'd');
+
+    Vec_destroy(&v);
+}
+
+typedef enum Color
+{
+    RED,
+    GREEN,
+    BLUE,
+    COLOR_NUM
+} Color;
+
+typedef struct Fish Fish;
+struct Fish
+{
+    Color color;
+    size_t size;
+};
+
+static void test_insert_slack_middle_struct(void)
+{
+    Vec* v = Vec_new(5, sizeof(Fish));
 
     assert(v != NULL);
 
-    // Add some unique elements to the vector.
+    // Add some elements to the vector.
     size_t const initial_cap = Vec_capacity(v);
 
     Vec_append(v,
                &(Fish)
                {
                    .color = RED,
-                   .size = 9
+                   .size = 0
                },
                sizeof(Fish)); // Index 0
     Vec_append(v,
                &(Fish)
                {
                    .color = GREEN,
-                   .size = 8
+                   .size = 1
                },
                sizeof(Fish)); // Index 1
     Vec_append(v,
                &(Fish)
                {
                    .color = BLUE,
-                   .size = 7
+                   .size = 2
                },
                sizeof(Fish)); // Index 2
-    Vec_append(v,
-               &(Fish)
-               {
-                   .color = RED,
-                   .size = 6
-               },
-               sizeof(Fish)); // Index 3
-    Vec_append(v,
-               &(Fish)
-               {
-                   .color = GREEN,
-                   .size = 5
-               },
-               sizeof(Fish)); // Index 4
-    assert(Vec_count(v) == 5);
+    assert(Vec_count(v) == 3);
     assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
 
-    // Get a pointer to the element.
-    Fish const element =
-    {
-        .color = RED,
-        .size = 6
-    };
-    size_t const target_index = 3;
-    size_t const insertion_index = 1;
-    Fish* target = (Fish*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(target->color == element.color);
-    assert(target->size == element.size);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    /*
+     * Insert something in the middle of the `Fish` (denoted by their colors)
+     * when the vector still has slack (so it won't resize due to the
+     * insertion):
+     *
+     * ```
+     *     Will insert here
+     *     v
+     * [R][G][B][ ][ ]. . .
+     *  0  1  2  3  4
+     * ```
+     */
+    assert(Vec_insert(v,
+                      1,
+                      &(Fish)
+                      {
+                          .color = BLUE,
+                          .size = 10
+                      },
+                      sizeof(Fish)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should now look like this (with the `Fish` denoted by their
+     * colors and the inserted element by `X`):
      *
      * ```
      *     Inserted here
      *     v
-     * [9][6][8][7][6][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     * [R][X][G][B][ ]. . .
+     *  0  1  2  3  4
      * ```
      */
-    Vec* expected = Vec_new(10, sizeof(Fish));
+    assert(Vec_count(v) == 4);
+    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 9
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 6
-                              },
-                              sizeof(Fish))); // Inserted
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 8
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = BLUE,
-                                  .size = 7
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 6
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 5
-                              },
-                              sizeof(Fish)));
-    assert(Vec_count(expected) == prev_count + 1);
+    Fish* probe = NULL;
 
-    assert(true == Vec_equal(v, expected, fish_size_equality_comparator));
+    probe = (Fish*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(probe->color == RED);
+    assert(probe->size == 0);
+    probe = NULL;
+
+    probe = (Fish*) Vec_get(v, 1);
+    assert(probe != NULL);
+    assert(probe->color == BLUE);
+    assert(probe->size == 10);
+    probe = NULL;
+
+    probe = (Fish*) Vec_get(v, 2);
+    assert(probe != NULL);
+    assert(probe->color == GREEN);
+    assert(probe->size == 1);
+    probe = NULL;
+
+    probe = (Fish*) Vec_get(v, 3);
+    assert(probe != NULL);
+    assert(probe->color == BLUE);
+    assert(probe->size == 2);
+    probe = NULL;
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_insert_inner_pointer_tail_before_insertion(void)
+static void test_insert_slack_tail(void)
 {
+    Vec* v = Vec_new(5, sizeof(char));
+
+    assert(v != NULL);
+
+    // Add some elements to the vector.
+    size_t const initial_cap = Vec_capacity(v);
+
+    Vec_append(v, &(char){'a'}, sizeof(char)); // Index 0
+    Vec_append(v, &(char){'b'}, sizeof(char)); // Index 1
+    Vec_append(v, &(char){'d'}, sizeof(char)); // Index 2
+    assert(Vec_count(v) == 3);
+    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Insert something at the tail end of the vector's elements when the vector
+     * still has slack.
      *
      * ```
-     *              target
-     *              |  Will insert here
-     *              v  v
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *        Will insert here
+     *        v
+     * [a][b][d][ ][ ]. . .
+     *  0  1  2  3  4
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = insert_inner_pointer_input_helper();
-
-    // Get a pointer to the element.
-    int64_t const element = 5;
-    size_t const target_index = 4;
-    size_t const insertion_index = 5;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_insert(v, 2, &(char){'c'}, sizeof(char)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should now look like:
      *
      * ```
-     *                 Inserted here
-     *                 v
-     * [9][8][7][6][5][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *        Inserted here
+     *        v
+     * [a][b][c][d][ ]. . .
+     *  0  1  2  3  4
      * ```
      */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+    assert(Vec_count(v) == 4);
+    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t))); // New
-    assert(Vec_count(expected) == prev_count + 1);
+    char* probe = NULL;
 
-    assert(true == Vec_equal(v, expected, NULL));
+    probe = (char*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(*probe == 'a');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 1);
+    assert(probe != NULL);
+    assert(*probe == 'b');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 2);
+    assert(probe != NULL);
+    assert(*probe == 'c');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 3);
+    assert(probe != NULL);
+    assert(*probe == 'd');
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_insert_inner_pointer_tail_at_insertion(void)
+static void test_insert_slack_past_tail(void)
 {
+    Vec* v = Vec_new(5, sizeof(char));
+
+    assert(v != NULL);
+
+    // Add some elements to the vector.
+    size_t const initial_cap = Vec_capacity(v);
+
+    Vec_append(v, &(char){'a'}, sizeof(char)); // Index 0
+    Vec_append(v, &(char){'b'}, sizeof(char)); // Index 1
+    Vec_append(v, &(char){'c'}, sizeof(char)); // Index 2
+    assert(Vec_count(v) == 3);
+    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Insert something at one past the last index of the vector's elements when
+     * the vector still has slack.
      *
      * ```
-     *       target   Will insert here
-     *             \ /
-     *              |
-     *              v
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *           Will insert here
+     *           v
+     * [a][b][c][ ][ ]. . .
+     *  0  1  2  3  4
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = insert_inner_pointer_input_helper();
-
-    // Get a pointer to the element.
-    int64_t const element = 5;
-    size_t const target_index = 4;
-    size_t const insertion_index = 4;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_insert(v, 3, &(char){'d'}, sizeof(char)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should now look like:
      *
      * ```
-     *              Inserted here
-     *              v
-     * [9][8][7][6][5][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *           Inserted here
+     *           v
+     * [a][b][c][d][ ]. . .
+     *  0  1  2  3  4
      * ```
      */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+    assert(Vec_count(v) == 4);
+    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
+    char* probe = NULL;
 
-    assert(true == Vec_equal(v, expected, NULL));
+    probe = (char*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(*probe == 'a');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 1);
+    assert(probe != NULL);
+    assert(*probe == 'b');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 2);
+    assert(probe != NULL);
+    assert(*probe == 'c');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 3);
+    assert(probe != NULL);
+    assert(*probe == 'd');
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_insert_inner_pointer_tail_after_insertion(void)
+static void test_insert_slack_head(void)
 {
+    Vec* v = Vec_new(5, sizeof(char));
+
+    assert(v != NULL);
+
+    // Add some elements to the vector.
+    size_t const initial_cap = Vec_capacity(v);
+
+    Vec_append(v, &(char){'b'}, sizeof(char)); // Index 0
+    Vec_append(v, &(char){'c'}, sizeof(char)); // Index 1
+    Vec_append(v, &(char){'d'}, sizeof(char)); // Index 2
+    assert(Vec_count(v) == 3);
+    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
+
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     Insert something at the beginning of the vector when the vector has slack.
      *
      * ```
-     *           Will insert here
-     *           |  target
-     *           v  v
-     * [9][8][7][6][5][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *  Will insert here
+     *  v
+     * [b][c][d][ ][ ]. . .
+     *  0  1  2  3  4
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = insert_inner_pointer_input_helper();
-
-    // Get a pointer to the element.
-    int64_t const element = 5;
-    size_t const target_index = 4;
-    size_t const insertion_index = 3;
-    int64_t* target = (int64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_insert(v, 0, &(char){'a'}, sizeof(char)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should now look like:
      *
      * ```
-     *           Inserted here
-     *           v
-     * [9][8][7][5][6][5][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *  Inserted here
+     *  v
+     * [a][b][c][d][ ]. . .
+     *  0  1  2  3  4
      * ```
      */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+    assert(Vec_count(v) == 4);
+    assert(Vec_capacity(v) == initial_cap); // Still no resize has occurred.
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t))); // New
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(Vec_count(expected) == prev_count + 1);
+    char* probe = NULL;
 
-    assert(true == Vec_equal(v, expected, NULL));
+    probe = (char*) Vec_get(v, 0);
+    assert(probe != NULL);
+    assert(*probe == 'a');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 1);
+    assert(probe != NULL);
+    assert(*probe == 'b');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 2);
+    assert(probe != NULL);
+    assert(*probe == 'c');
+    probe = NULL;
+
+    probe = (char*) Vec_get(v, 3);
+    assert(probe != NULL);
+    assert(*probe == 'd');
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_insert_full_inner_pointer_head_before_insertion(void)
+static void test_insert_until_full(void)
 {
+    Vec* v = Vec_new(5, sizeof(uint64_t));
+
+    assert(v != NULL);
+
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Fill the vector to capacity using inserts.
      *
      * ```
-     *        target
-     *        |  Will insert here
-     *        v  v
-     *       [0][1][2]. . .[8][9][a]. . .[d][e][f]
-     *        0  1  2       8  9  a       d  e  f
+     *  Will insert at every index
+     *  v  v  v  v  v  v . . . v
+     * [ ][ ][ ][ ][ ][ ]. . .[ ]
+     *  0  1  2  3  4  5       ^
+     *                         Current capacity
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = new_full_u64_vec(16);
-
-    // Get a pointer to the element.
-    uint64_t const element = 0;
-    size_t const target_index = 0;
-    size_t const insertion_index = 1;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
+    size_t curr_cap = Vec_capacity(v);
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+    for (size_t i = 0; i < curr_cap; ++i)
+    {
+        assert(Vec_insert(v,
+                          i,
+                          &(uint64_t){i},
+                          sizeof(uint64_t)) == true);
+    }
+    assert(Vec_count(v) == curr_cap); // Vector should be full.
+    assert(Vec_capacity(v) == curr_cap); // But it hasn't resized yet.
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should now look like:
      *
      * ```
-     *     Inserted here
-     *     v
-     * [0][0][1]. . .[7][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
-     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     *  Inserted at every index
+     *  v  v  v  v  v  v . . . v
+     * [0][1][2][3][4][5]. . .[x]
+     *  0  1  2  3  4  5       ^
+     *                         Current capacity
      * ```
      */
-    uint64_t* probe = NULL;
-
-    for (size_t i = 0; i < Vec_count(v); ++i)
+    for (size_t i = 0; i < curr_cap; ++i)
     {
+        uint64_t* probe = NULL;
+
         probe = (uint64_t*) Vec_get(v, i);
         assert(probe != NULL);
-
-        if (i == 0 || i == 1)
-        {
-            assert(*probe == element); // Inserted
-        }
-        else
-        {
-            assert(*probe == (uint64_t){i - 1}); // Shifted
-        }
+        assert(*probe == (uint64_t){i});
     }
 
     Vec_destroy(&v);
 }
 
-static void test_insert_full_inner_pointer_head_at_insertion(void)
+/**
+ * @param initial_cap_hint The vector's minimum initial capacity
+ * @returns A new vector sized according to the given capacity hint, full to
+ * capacity with different `uint64_t` elements
+ */
+static Vec* new_full_u64_vec(size_t const initial_cap_hint)
 {
-    /*
-     * Using a pointer, `target`, to an element inside the not-full vector
-     *
-     * ```
-     * target   Will insert here
-     *       \ /
-     *        |
-     *        v
-     *       [0][1][2]. . .[8][9][a]. . .[d][e][f]
-     *        0  1  2       8  9  a       d  e  f
-     * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
-     */
-    Vec* v = new_full_u64_vec(16);
-
-    // Get a pointer to the element.
-    uint64_t const element = 0;
-    size_t const target_index = 0;
-    size_t const insertion_index = 0;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
+    Vec* v = Vec_new(initial_cap_hint, sizeof(uint64_t));
 
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
+    assert(v != NULL);
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+    // Fill the vector to capacity.
+    size_t const initial_cap = Vec_capacity(v);
 
-    /*
-     * After insertion, the vector should look like this:
-     *
-     * ```
-     *  Inserted here
-     *  v
-     * [0][0][1]. . .[7][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
-     *  0  1  2       8  9  a       d  e  f (Expanded space)
-     * ```
-     */
-    uint64_t* probe = NULL;
+    for (size_t i = 0; i < initial_cap; ++i)
+    {
+        Vec_append(v, &(uint64_t){i}, sizeof((uint64_t){i}));
+    }
+    assert(Vec_count(v) == initial_cap); // The vector's full.
+    assert(Vec_capacity(v) == initial_cap); // The vector didn't expand yet.
 
+    // Every element should be equal to its index.
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
+        uint64_t* probe = NULL;
+
         probe = (uint64_t*) Vec_get(v, i);
         assert(probe != NULL);
-
-        if (i == 0 || i == 1)
-        {
-            assert(*probe == element); // Inserted
-        }
-        else
-        {
-            assert(*probe == (uint64_t){i - 1}); // Shifted
-        }
+        assert(*probe == (uint64_t){i});
     }
 
-    Vec_destroy(&v);
+    return v;
 }
 
-static void test_insert_full_inner_pointer_head_after_insertion(void)
+static void test_insert_full_middle(void)
 {
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Insert something in the middle the vector when it's full.
      *
      * ```
-     *        Will insert here
-     *        |  target
-     *        v  v
-     *       [0][1][2]. . .[8][9][a]. . .[d][e][f]
-     *        0  1  2       8  9  a       d  e  f
+     *              Will insert here
+     *              v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
+     *  0  1  2  3  4  5  6  7  8  9       ^
+     *                                     Initial capacity
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = new_full_u64_vec(16);
-
-    // Get a pointer to the element.
-    uint64_t const element = 1;
-    size_t const target_index = 1;
-    size_t const insertion_index = 0;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
+    size_t initial_cap = Vec_capacity(v);
+    size_t const inserted_element_index = 4;
+    uint64_t const inserted_element = 9;
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+    assert(Vec_insert(v,
+                      inserted_element_index,
+                      &inserted_element,
+                      sizeof(uint64_t)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should now look like:
      *
      * ```
-     *  Inserted here
-     *  v
-     * [1][0][1]. . .[7][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
-     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     *              Inserted here
+     *              v
+     * [0][1][2][3][9][4][5][6][7][8]. . .[x - 1][x]. . .[ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9         ^                  ^
+     *                                       Initial capacity   New capacity
      * ```
      */
-    uint64_t* probe = NULL;
+    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
+    assert(Vec_count(v) == (initial_cap + 1));
 
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
+        uint64_t* probe = NULL;
+
         probe = (uint64_t*) Vec_get(v, i);
         assert(probe != NULL);
 
-        if (i == 0)
+        if (i < inserted_element_index)
         {
-            assert(*probe == element); // Inserted
+            // The elements before the insertion site are still `i`.
+            assert(*probe == i);
+        }
+        else if (i == inserted_element_index)
+        {
+            // The insertion site contains the inserted element.
+            assert(*probe == inserted_element);
         }
         else
         {
-            assert(*probe == (uint64_t){i - 1}); // Shifted
+            // The elements after the insertion site are `i - 1`.
+            assert(*probe == (i - 1));
         }
     }
 
     Vec_destroy(&v);
 }
 
-static void test_insert_full_inner_pointer_middle_before_insertion(void)
+/**
+ * @param i An index
+ * @return A `Fish` whose color and size is based on the given index
+ */
+static Fish index_to_Fish(size_t const i)
 {
-    /*
-     * Using a pointer, `target`, to an element inside the not-full vector
-     *
-     * ```
-     *                   target
-     *                   |  Will insert here
-     *                   v  v
-     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
-     *  0  1  2       7  8  9       d  e  f
-     * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
-     */
-    Vec* v = new_full_u64_vec(16);
+    return (Fish)
+    {
+        .color = i % COLOR_NUM,
+        .size = i
+    };
+}
 
-    // Get a pointer to the element.
-    uint64_t const element = Vec_count(v) / 2; // Assuming elements are indices
-    size_t const target_index = Vec_count(v) / 2;
-    size_t const insertion_index = target_index + 1;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+/**
+ * @param initial_cap_hint The vector's minimum initial capacity
+ * @returns A new vector sized according to the given capacity hint, full to
+ * capacity with different `Fish` elements
+ */
+static Vec* new_full_Fish_vec(size_t const initial_cap_hint)
+{
+    Vec* v = Vec_new(initial_cap_hint, sizeof(Fish));
 
-    assert(target != NULL);
-    assert(*target == element);
+    assert(v != NULL);
 
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
+    // Fill the vector to capacity.
+    size_t const initial_cap = Vec_capacity(v);
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+    for (size_t i = 0; i < initial_cap; ++i)
+    {
+        Fish const f = index_to_Fish(i);
 
-    /*
-     * After insertion, the vector should look like this:
-     *
-     * ```
-     *                      Inserted here
-     *                      |  Shifted elements begin here
-     *                      v  v
-     * [0][1][2]. . .[7][8][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
-     *  0  1  2       7  8  9  a       d  e  f (Expanded space)
-     * ```
-     */
-    uint64_t* probe = NULL;
+        Vec_append(v, &f, sizeof(f));
+    }
+    assert(Vec_count(v) == initial_cap); // The vector's full.
+    assert(Vec_capacity(v) == initial_cap); // The vector didn't expand yet.
 
+    // Every element should be equal to its index.
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
-        probe = (uint64_t*) Vec_get(v, i);
+        Fish* probe = NULL;
+
+        probe = (Fish*) Vec_get(v, i);
         assert(probe != NULL);
 
-        if (i < insertion_index)
-        {
-            assert(*probe == (uint64_t){i}); // Unchanged
-        }
-        else if (i == insertion_index)
-        {
-            assert(*probe == element); // Inserted
-        }
-        else
-        {
-            assert(*probe == (uint64_t){i - 1}); // Shifted
-        }
+        Fish const f = index_to_Fish(i);
+
+        assert(probe->color == f.color);
+        assert(probe->size == f.size);
     }
 
-    Vec_destroy(&v);
+    return v;
 }
 
-static void test_insert_full_inner_pointer_middle_at_insertion(void)
+static void test_insert_full_middle_struct(void)
 {
+    Vec* v = new_full_Fish_vec(10); // Get a full vector.
+
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Insert something in the middle the vector when it's full.
      *
      * ```
-     *            target   Will insert here
-     *                  \ /
-     *                   |
-     *                   v
-     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
-     *  0  1  2       7  8  9       d  e  f
+     *              Will insert here
+     *              v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
+     *  0  1  2  3  4  5  6  7  8  9       ^
+     *                                     Initial capacity
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = new_full_u64_vec(16);
-
-    // Get a pointer to the element.
-    uint64_t const element = Vec_count(v) / 2; // Assuming elements are indices
-    size_t const target_index = Vec_count(v) / 2;
-    size_t const insertion_index = target_index;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
+    size_t initial_cap = Vec_capacity(v);
+    size_t const inserted_element_index = 4;
+    Fish const inserted_element =
+    {
+        .color = BLUE,
+        .size = 123456
+    };
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+    assert(Vec_insert(v,
+                      inserted_element_index,
+                      &inserted_element,
+                      sizeof(Fish)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should now look like this (with the inserted element denoted
+     * by `X`):
      *
      * ```
-     *                   Inserted here
-     *                   |  Shifted elements begin here
-     *                   v  v
-     * [0][1][2]. . .[7][8][8]. . .[c][d][e][f][ ][ ][ ]. . .
-     *  0  1  2       7  8  9       d  e  f (Expanded space)
+     *              Inserted here
+     *              v
+     * [0][1][2][3][X][4][5][6][7][8]. . .[x - 1][x]. . .[ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9         ^                  ^
+     *                                       Initial capacity   New capacity
      * ```
      */
-    uint64_t* probe = NULL;
+    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
+    assert(Vec_count(v) == (initial_cap + 1));
 
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
-        probe = (uint64_t*) Vec_get(v, i);
+        Fish* probe = NULL;
+        Fish expected;
+
+        probe = (Fish*) Vec_get(v, i);
         assert(probe != NULL);
 
-        if (i < insertion_index)
+        if (i < inserted_element_index)
         {
-            assert(*probe == (uint64_t){i}); // Unchanged
+            // The elements before the insertion site still correspond to `i`.
+            expected = index_to_Fish(i);
+            assert(probe->color == expected.color);
+            assert(probe->size == expected.size);
         }
-        else if (i == insertion_index)
+        else if (i == inserted_element_index)
         {
-            assert(*probe == element); // Inserted
+            // The insertion site contains the inserted element.
+            assert(probe->color == inserted_element.color);
+            assert(probe->size == inserted_element.size);
         }
         else
         {
-            assert(*probe == (uint64_t){i - 1}); // Shifted
+            // The elements after the insertion site correspond to `i - 1`.
+            expected = index_to_Fish(i - 1);
+            assert(probe->color == expected.color);
+            assert(probe->size == expected.size);
         }
     }
 
     Vec_destroy(&v);
 }
 
-static void test_insert_full_inner_pointer_middle_after_insertion(void)
+static void test_insert_full_tail(void)
 {
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
     /*
-     * Using a pointer, `target`, to an element inside the not-full vector
+     * Insert something at the last index.
      *
      * ```
-     *                Will insert here
-     *                |  target
-     *                v  v
-     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
-     *  0  1  2       7  8  9       d  e  f
+     *                                     Will insert here
+     *                                     v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
+     *  0  1  2  3  4  5  6  7  8  9       ^
+     *                                     Initial capacity
      * ```
-     *
-     * insert a copy of that element.
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = new_full_u64_vec(16);
-
-    // Get a pointer to the element.
-    uint64_t const element = Vec_count(v) / 2; // Assuming elements are indices
-    size_t const target_index = Vec_count(v) / 2;
-    size_t const insertion_index = target_index - 1;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(*target == element);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
+    size_t const initial_cap = Vec_capacity(v);
+    size_t const inserted_element_index = Vec_count(v) - 1; // The last index
+    uint64_t const inserted_element = 42;
+    uint64_t const shifted_element = Vec_count(v) - 1; // `x` will be shifted.
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+    assert(Vec_insert(v,
+                      inserted_element_index,
+                      &inserted_element,
+                      sizeof(inserted_element)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * We expect that:
+     *     - The vector was automatically resized
+     *     - The element that occupied the last index before the insertion was
+     *       shifted into the newly-expanded region of the vector
+     *
+     * If the element we just inserted is `I` and the element that occupied the
+     * last index before the insertion is `P`, the vector should look like this:
      *
      * ```
-     *                Inserted here
-     *                |  Shifted elements begin here
-     *                v  v
-     * [0][1][2]. . .[8][7][8]. . .[c][d][e][f][ ][ ][ ]. . .
-     *  0  1  2       7  8  9       d  e  f (Expanded space)
+     *                         Inserted here
+     *                         v
+     * [0][1][2][3][4][5]. . .[I][P][ ]. . .[ ][ ][ ][ ]
+     *  0  1  2  3  4  5       ^                      ^
+     *                         Initial capacity       Current capacity
      * ```
      */
-    uint64_t* probe = NULL;
+    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
+    assert(Vec_count(v) == (initial_cap + 1));
 
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
+        uint64_t* probe = NULL;
+
         probe = (uint64_t*) Vec_get(v, i);
         assert(probe != NULL);
 
-        if (i < insertion_index)
+        if (i < inserted_element_index)
         {
-            assert(*probe == (uint64_t){i}); // Unchanged
+            // The elements before the insertion site are still `i`.
+            assert(*probe == i);
         }
-        else if (i == insertion_index)
+        else if (i == inserted_element_index)
         {
-            assert(*probe == element); // Inserted
+            // The insertion site contains the inserted element.
+            assert(*probe == inserted_element);
         }
-        else
+        else if (i == (inserted_element_index + 1))
         {
-            assert(*probe == (uint64_t){i - 1}); // Shifted
+            // The element after the insertion site is the shifted element.
+            assert(*probe == shifted_element);
         }
     }
 
     Vec_destroy(&v);
 }
 
-static void test_insert_full_inner_pointer_middle_after_insertion_struct(void)
+static void test_insert_full_past_tail(void)
 {
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
     /*
-     * Using a pointer, `target`, to a `Fish` inside the not-full vector
+     * Insert something at one past the last index.
      *
      * ```
-     *                Will insert here
-     *                |     target
-     *                v     v
-     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
-     *  0  1  2       7  8  9       d  e  f
+     *                                        Will insert here
+     *                                        v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x] _
+     *  0  1  2  3  4  5  6  7  8  9       ^
+     *                                     Initial capacity
      * ```
-     *
-     * insert a copy of that `Fish` among the others (denoted by their sizes).
-     *
-     * Before insertion, all the elements of the vector are unique. This is so
-     * that, should the memory behind `target` shift before insertion, this test
-     * verifies that the correct element (the element initially behind `target`)
-     * gets inserted.
      */
-    Vec* v = new_full_Fish_vec(16);
-
-    // Get a pointer to the element.
-    size_t const target_index = (Vec_count(v) / 2) + 1;
-    size_t const insertion_index = target_index - 2;
-    Fish const element = index_to_Fish(target_index);
-    Fish* target = (Fish*) Vec_get(v, target_index);
-
-    assert(target != NULL);
-    assert(target->color == element.color);
-    assert(target->size == element.size);
-
-    // Insert a copy of the element via a pointer to itself.
-    size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
+    size_t const initial_cap = Vec_capacity(v);
+    size_t const inserted_element_index = Vec_count(v); // One past last index
+    uint64_t const inserted_element = 777;
 
-    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
-    target = NULL; // Pointer invalidated by insertion
-    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+    assert(Vec_insert(v,
+                      inserted_element_index,
+                      &inserted_element,
+                      sizeof(inserted_element)) == true);
 
     /*
-     * After insertion, the vector should look like this:
+     * The vector should have expanded and, if the element we just inserted is
+     * `I`, look like this:
      *
      * ```
-     *                Inserted here
-     *                |  Shifted elements begin here
-     *                v  v
-     * [0][1][2]. . .[9][7][8]. . .[c][d][e][f][ ][ ][ ]. . .
-     *  0  1  2       7  8  9       d  e  f (Expanded space)
+     *                            Inserted here
+     *                            v
+     * [0][1][2][3][4][5]. . .[x][I][ ]. . .[ ][ ][ ][ ]
+     *  0  1  2  3  4  5       ^                      ^
+     *                         Initial capacity       Current capacity
      * ```
      */
-    Fish* probe = NULL;
+    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
+    assert(Vec_count(v) == (initial_cap + 1));
 
     for (size_t i = 0; i < Vec_count(v); ++i)
     {
-        probe = (Fish*) Vec_get(v, i);
+        uint64_t* probe = NULL;
+
+        probe = (uint64_t*) Vec_get(v, i);
         assert(probe != NULL);
 
-        if (i < insertion_index)
+        if (i < inserted_element_index)
         {
-            // Unchanged
-            Fish const f = index_to_Fish(i);
-
-            assert(probe->color == f.color);
-            assert(probe->size == f.size);
+            // The elements before the insertion site are still `i`.
+            assert(*probe == i);
         }
-        else if (i == insertion_index)
+        else if (i == inserted_element_index)
         {
-            // Inserted
-            assert(probe->color == element.color);
-            assert(probe->size == element.size);
+            // The insertion site contains the inserted element.
+            assert(*probe == inserted_element);
         }
-        else
-        {
-            // Shifted
-            Fish const f = index_to_Fish(i - 1);
+    }
 
-            assert(probe->color == f.color);
-            assert(probe->size == f.size);
+    Vec_destroy(&v);
+}
+
+static void test_insert_full_head(void)
+{
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
+    /*
+     * Insert something at the head of the vector.
+     *
+     * ```
+     *  Will insert here
+     *  v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
+     *  0  1  2  3  4  5  6  7  8  9       ^
+     *                                     Initial capacity
+     * ```
+     */
+    size_t const initial_cap = Vec_capacity(v);
+    size_t const inserted_element_index = 0; // Head index
+    uint64_t const inserted_element = 2023;
+
+    assert(Vec_insert(v,
+                      inserted_element_index,
+                      &inserted_element,
+                      sizeof(inserted_element)) == true);
+
+    /*
+     * The vector should have expanded and, if the element we just inserted is
+     * `I`, look like this:
+     *
+     * ```
+     *  Inserted here
+     *  v
+     * [I][0][1][2][3][4][5]. . .[x][I][ ]. . .[ ][ ][ ][ ]
+     *  0  1  2  3  4  5          ^                      ^
+     *                            Initial capacity       Current capacity
+     * ```
+     */
+    assert(Vec_capacity(v) > initial_cap); // Resize should have occurred.
+    assert(Vec_count(v) == (initial_cap + 1));
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        uint64_t* probe = NULL;
+
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i > inserted_element_index)
+        {
+            // The elements after the insertion site shifted, so are `i - 1`.
+            assert(*probe == (i - 1));
+        }
+        else
+        {
+            // The insertion site contains the inserted element.
+            assert(*probe == inserted_element);
         }
     }
 
     Vec_destroy(&v);
 }
 
-static void test_insert_full_inner_pointer_tail_before_insertion(void)
+static Vec* insert_inner_pointer_input_helper(void)
+{
+    /*
+     * Make a non-full vector of unique elements:
+     *
+     * ```
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    Vec* v = Vec_new(10, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
+    assert(5 == Vec_count(v));
+    assert(Vec_capacity(v) > Vec_count(v)); // The vector's not full.
+
+    return v;
+}
+
+static void test_insert_inner_pointer_head_before_insertion(void)
 {
     /*
      * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     *                                    target
-     *                                    |  Will insert here
-     *                                    v  v
-     * [0][1][2]. . .[8][9][a]. . .[d][e][f][ ]
-     *  0  1  2       8  9  a       d  e  f  ^
-     *                                       One past the end
+     *        target
+     *        |  Will insert here
+     *        v  v
+     *       [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *        0  1  2  3  4  5  6  7  8  9
      * ```
      *
      * insert a copy of that element.
@@ -3225,72 +3509,63 @@ static void test_insert_full_inner_pointer_tail_before_insertion(void)
      * verifies that the correct element (the element initially behind `target`)
      * gets inserted.
      */
-    Vec* v = new_full_u64_vec(16);
+    Vec* v = insert_inner_pointer_input_helper();
 
     // Get a pointer to the element.
-    uint64_t const element = Vec_count(v) - 1; // Assuming elements are indices
-    size_t const target_index = Vec_count(v) - 1;
-    size_t const insertion_index = target_index + 1;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+    int64_t const element = 9;
+    size_t const target_index = 0;
+    size_t const insertion_index = 1;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
     assert(target != NULL);
     assert(*target == element);
 
     // Insert a copy of the element via a pointer to itself.
     size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
 
     assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
     target = NULL; // Pointer invalidated by insertion
     assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
     /*
      * After insertion, the vector should look like this:
      *
      * ```
-     *                                       Inserted here
-     *                                       v
-     * [0][1][2]. . .[8][9][a]. . .[d][e][f][f][ ][ ][ ]. . .
-     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     *     Inserted here
+     *     v
+     * [9][9][8][7][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
      */
-    uint64_t* probe = NULL;
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
 
-        if (i < insertion_index)
-        {
-            assert(*probe == (uint64_t){i}); // Unchanged
-        }
-        else if (i == insertion_index)
-        {
-            assert(*probe == element); // Inserted
-        }
-        else
-        {
-            assert(false); // There should be no elements past the insertion.
-        }
-    }
+    assert(true == Vec_equal(v, expected, NULL));
 
     Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_insert_full_inner_pointer_tail_at_insertion(void)
+static void test_insert_inner_pointer_head_at_insertion(void)
 {
     /*
      * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     *                             target   Will insert here
-     *                                   \ /
-     *                                    |
-     *                                    v
-     * [0][1][2]. . .[8][9][a]. . .[d][e][f]
-     *  0  1  2       8  9  a       d  e  f
+     * target   Will insert here
+     *       \ /
+     *        |
+     *        v
+     *       [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *        0  1  2  3  4  5  6  7  8  9
      * ```
      *
      * insert a copy of that element.
@@ -3300,76 +3575,62 @@ static void test_insert_full_inner_pointer_tail_at_insertion(void)
      * verifies that the correct element (the element initially behind `target`)
      * gets inserted.
      */
-    Vec* v = new_full_u64_vec(16);
+    Vec* v = insert_inner_pointer_input_helper();
 
     // Get a pointer to the element.
-    uint64_t const element = Vec_count(v) - 1; // Assuming elements are indices
-    size_t const target_index = Vec_count(v) - 1;
-    size_t const insertion_index = target_index;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+    int64_t const element = 9;
+    size_t const target_index = 0;
+    size_t const insertion_index = 0;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
     assert(target != NULL);
     assert(*target == element);
 
     // Insert a copy of the element via a pointer to itself.
     size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
 
     assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
     target = NULL; // Pointer invalidated by insertion
     assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
     /*
      * After insertion, the vector should look like this:
      *
      * ```
-     *                                    Inserted here
-     *                                    v
-     * [0][1][2]. . .[8][9][a]. . .[d][e][f][f][ ][ ][ ]. . .
-     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     *  Inserted here
+     *  v
+     * [9][9][8][7][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
      */
-    uint64_t* probe = NULL;
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
 
-        if (i < insertion_index)
-        {
-            assert(*probe == (uint64_t){i}); // Unchanged
-        }
-        else if (i == insertion_index)
-        {
-            assert(*probe == element); // Inserted
-        }
-        else if (i == insertion_index + 1)
-        {
-            assert(*probe == element); // Shifted original element
-        }
-        else
-        {
-            // There should be no elements past the shifted original element.
-            assert(false);
-        }
-    }
+    assert(true == Vec_equal(v, expected, NULL));
 
     Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_insert_full_inner_pointer_tail_after_insertion(void)
+static void test_insert_inner_pointer_head_after_insertion(void)
 {
     /*
      * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     *                                 Will insert here
-     *                                 |  target
-     *                                 v  v
-     * [0][1][2]. . .[8][9][a]. . .[d][e][f]
-     *  0  1  2       8  9  a       d  e  f
+     *        Will insert here
+     *        |  target
+     *        v  v
+     *       [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *        0  1  2  3  4  5  6  7  8  9
      * ```
      *
      * insert a copy of that element.
@@ -3379,337 +3640,256 @@ static void test_insert_full_inner_pointer_tail_after_insertion(void)
      * verifies that the correct element (the element initially behind `target`)
      * gets inserted.
      */
-    Vec* v = new_full_u64_vec(16);
+    Vec* v = insert_inner_pointer_input_helper();
 
     // Get a pointer to the element.
-    uint64_t const element = Vec_count(v) - 1; // Assuming elements are indices
-    size_t const target_index = Vec_count(v) - 1;
-    size_t const insertion_index = target_index - 1;
-    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+    int64_t const element = 8;
+    size_t const target_index = 1;
+    size_t const insertion_index = 0;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
     assert(target != NULL);
     assert(*target == element);
 
     // Insert a copy of the element via a pointer to itself.
     size_t const prev_count = Vec_count(v);
-    size_t const prev_cap = Vec_capacity(v);
 
     assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
     target = NULL; // Pointer invalidated by insertion
     assert(Vec_count(v) == prev_count + 1); // An element was inserted.
-    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
     /*
      * After insertion, the vector should look like this:
      *
      * ```
-     *                                 Inserted here
-     *                                 v
-     * [0][1][2]. . .[8][9][a]. . .[d][f][e][f][ ][ ][ ]. . .
-     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     *  Inserted here
+     *  v
+     * [8][9][8][7][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
      */
-    uint64_t* probe = NULL;
-
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-        if (i < insertion_index)
-        {
-            assert(*probe == (uint64_t){i}); // Unchanged
-        }
-        else if (i == insertion_index)
-        {
-            assert(*probe == element); // Inserted
-        }
-        else if (i == insertion_index + 1)
-        {
-            assert(*probe == element - 1); // Shifted penultimate element (`e`)
-        }
-        else if (i == insertion_index + 2)
-        {
-            // Shifted original tail element (`f`)
-            assert(*probe == element);
-        }
-        else
-        {
-            // There should be no elements past the shifted tail element.
-            assert(false);
-        }
-    }
-
-    Vec_destroy(&v);
-}
-
-static void test_remove_invalid(void)
-{
-    Vec* v = Vec_new(5, sizeof(uint64_t));
-
-    assert(v != NULL);
-
-    /*
-     * Remove from an out of bounds index.
-     *
-     * Since there is no element at that index, we should get back the index to
-     * one-past the last element. Since there are NO elements at all, the
-     * one-past the last index is 0.
-     */
-    assert(Vec_capacity(v) < 12345);
-    assert(Vec_remove(v, 12345) == 0);
-
-    /*
-     * Remove from an in bounds index where there's no element. Since the vector
-     * is empty, that's any in bounds index.
-     */
-    assert(Vec_count(v) == 0);
-    assert(Vec_remove(v, 0) == 0);
-    assert(Vec_capacity(v) > 3);
-    assert(Vec_remove(v, 1) == 0);
-    assert(Vec_remove(v, 2) == 0);
-    assert(Vec_remove(v, 3) == 0);
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &element, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
 
-    // Remove from a null vector.
-    assert(Vec_remove(NULL, 0) == 0);
+    assert(true == Vec_equal(v, expected, NULL));
 
     Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_remove_middle(void)
+static void test_insert_inner_pointer_middle_before_insertion(void)
 {
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
-
     /*
-     * Remove something from the middle of the vector.
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     *                 Will remove from here
-     *                 v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
-     *  0  1  2  3  4  5  6  7  8  9       ^
-     *                                     Initial capacity
+     *        target
+     *        |  Will insert here
+     *        v  v
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    size_t const initial_count = Vec_count(v);
-    size_t removed_element_index = 5;
-
-    // First, note the element following the one we're about to remove.
-    uint64_t following_pre_removal = 0;
-
-    {
-        /*
-         * Also note that we have to store it as a value, briefly using a
-         * pointer in this nested scope for null checking when fetching the
-         * value.
-         *
-         * The pointer will be invalidated after we do the removal since the
-         * removal will cause elements to shift, changing what the pointer's
-         * pointing at!
-         */
-        uint64_t* following_pre_ptr = NULL; // WARNING: Will be invalidated!
-
-        following_pre_ptr = (uint64_t*) Vec_get(v, (removed_element_index + 1));
-        assert(following_pre_ptr != NULL);
-        following_pre_removal = *following_pre_ptr;
-    }
+    Vec* v = insert_inner_pointer_input_helper();
 
-    /*
-     * Now remove the element, receiving the index to the element after the one
-     * we removed.
-     */
-    size_t const following_index = Vec_remove(v, removed_element_index);
+    // Get a pointer to the element.
+    int64_t const element = 7;
+    size_t const target_index = 2;
+    size_t const insertion_index = 3;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
-    assert(Vec_count(v) == (initial_count - 1)); // An element was removed.
+    assert(target != NULL);
+    assert(*target == element);
 
-    // The received index corresponds to the following element we noted earlier.
-    uint64_t* following_post_removal = NULL;
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
 
-    following_post_removal = (uint64_t*) Vec_get(v, following_index);
-    assert(following_post_removal != NULL);
-    assert(*following_post_removal == following_pre_removal);
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
 
     /*
-     * The vector now looks like this:
+     * After insertion, the vector should look like this:
      *
      * ```
-     *                 Removed from here
-     *                 v
-     * [0][1][2][3][4][6][7][8][9]. . .[x][ ]
-     *  0  1  2  3  4  5  6  7  8          ^
-     *                                     Initial capacity
+     *           Inserted here
+     *           v
+     * [9][8][7][7][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
      */
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        uint64_t* probe = NULL;
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
-        if (i < removed_element_index)
-        {
-            // The elements before the removal site are still `i`.
-            assert(*probe == i);
-        }
-        else
-        {
-            // Those at and past the removal site are now `i + 1`.
-            assert(*probe == (i + 1));
-        }
-    }
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
+
+    assert(true == Vec_equal(v, expected, NULL));
 
     Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_remove_tail(void)
+static void test_insert_inner_pointer_middle_at_insertion(void)
 {
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
-
     /*
-     * Remove the last element of the vector.
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     *                                            Will remove from here
-     *                                            v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x - 1][x]
-     *  0  1  2  3  4  5  6  7  8  9              ^
-     *                                            Initial capacity
+     *    target   Will insert here
+     *          \ /
+     *           |
+     *           v
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    size_t const initial_count = Vec_count(v);
-    size_t last_index_pre_removal = initial_count - 1;
+    Vec* v = insert_inner_pointer_input_helper();
 
-    // Remove the element, receiving the index one past the last index.
-    assert(Vec_remove(v, last_index_pre_removal) == Vec_count(v));
-    assert(Vec_count(v) == (initial_count - 1)); // An element was removed.
+    // Get a pointer to the element.
+    int64_t const element = 6;
+    size_t const target_index = 3;
+    size_t const insertion_index = 3;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
+
+    assert(target != NULL);
+    assert(*target == element);
+
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
 
     /*
-     * The vector now looks like this:
+     * After insertion, the vector should look like this:
      *
      * ```
-     *                                         Removed from here
-     *                                         v
-     * [0][1][2][3][4][6][7][8][9]. . .[x - 1][ ]
-     *  0  1  2  3  4  5  6  7  8              ^
-     *                                         Initial capacity
+     *           Inserted here
+     *           v
+     * [9][8][7][6][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
      */
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        uint64_t* probe = NULL;
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
-        // The elements before the removal site are still `i`.
-        assert(*probe == i);
-        // And we never even reach the removal site since it's past the end!
-        assert(i < last_index_pre_removal);
-    }
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
+
+    assert(true == Vec_equal(v, expected, NULL));
 
     Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_remove_head(void)
+static void test_insert_inner_pointer_middle_after_insertion(void)
 {
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
-
     /*
-     * Remove something from the middle of the vector.
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     *  Will remove from here
-     *  v
-     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
-     *  0  1  2  3  4  5  6  7  8  9       ^
-     *                                     Initial capacity
+     *        Will insert here
+     *        |  target
+     *        v  v
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
-     */
-    size_t const initial_count = Vec_count(v);
-    size_t removed_element_index = 0;
-
-    /*
-     * Note the element following the one we're about to remove.
      *
-     * We have to store the element as a value because the pointer will be
-     * invalidated after we do the removal since the removal will cause elements
-     * to shift, changing what the pointer's pointing at!
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    uint64_t following_pre_removal = 0;
-    uint64_t* probe = (uint64_t*) Vec_get(v, (removed_element_index + 1));
+    Vec* v = insert_inner_pointer_input_helper();
 
-    assert(probe != NULL);
-    following_pre_removal = *probe;
+    // Get a pointer to the element.
+    int64_t const element = 6;
+    size_t const target_index = 3;
+    size_t const insertion_index = 2;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
-    /*
-     * Now remove the element, receiving the index to the element after the one
-     * we removed.
-     */
-    size_t const following_index = Vec_remove(v, removed_element_index);
+    assert(target != NULL);
+    assert(*target == element);
 
-    probe = NULL; // Pointer invalidated by the removal
-    assert(0 == following_index); // The element after should be the new head.
-    assert(Vec_count(v) == (initial_count - 1)); // An element was removed.
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
 
-    // The received index corresponds to the following element we noted earlier.
-    probe = (uint64_t*) Vec_get(v, following_index);
-    assert(probe != NULL);
-    assert(*probe == following_pre_removal);
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
 
     /*
-     * The vector now looks like this:
+     * After insertion, the vector should look like this:
      *
      * ```
-     *  Removed from here
-     *  v
-     * [1][2][3][4][5][6][7][8][9]. . .[x][ ]
-     *  0  1  2  3  4  5  6  7  8          ^
-     *                                     Initial capacity
+     *        Inserted here
+     *        v
+     * [9][8][6][7][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
      * ```
      */
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        uint64_t* probe = NULL;
-
-        probe = (uint64_t*) Vec_get(v, i);
-        assert(probe != NULL);
-        // The elements are all now `i + 1`.
-        assert(*probe == (i + 1));
-    }
-
-    Vec_destroy(&v);
-}
-
-static void test_remove_until_empty(void)
-{
-    Vec* v = new_full_u64_vec(10); // Get a full vector.
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-    // Starting at the first index, remove an element until none remain.
-    size_t i = 0;
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
 
-    while (i < Vec_count(v))
-    {
-        /*
-         * `i` will be set to the index of the next element to remove.
-         *
-         * Since we started at the first index, `i` will be equal to the number
-         * of elements when there are no elements left.
-         */
-        i = Vec_remove(v, i);
-    }
-    assert(Vec_count(v) == 0); // The vector is empty.
+    assert(true == Vec_equal(v, expected, NULL));
 
     Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
 /**
  * @brief A `Fish` comparator to be used by a vector's equality function that
- * looks only at fish color
+ * looks only at fish size
  * @param fish_a A `Fish`
  * @param fish_b Another `Fish`
  * @return 1 if there was an input problem; 0 if the given `Fish` have the same
- * color; 2 if they have different colors
+ * size; 2 if they have different sizes
  */
-static int fish_color_comparator(void const* fish_a, void const* fish_b)
+static int fish_size_equality_comparator(void const* fish_a, void const* fish_b)
 {
     if (fish_a == NULL ||
         fish_b == NULL)
@@ -3721,7 +3901,7 @@ static int fish_color_comparator(void const* fish_a, void const* fish_b)
     Fish const* a = (Fish const*) fish_a;
     Fish const* b = (Fish const*) fish_b;
 
-    if (a->color == b->color)
+    if (a->size == b->size)
     {
         return 0;
     }
@@ -3729,2039 +3909,7367 @@ static int fish_color_comparator(void const* fish_a, void const* fish_b)
     return 2;
 }
 
-static void test_equal_invalid(void)
+static void test_insert_inner_pointer_middle_after_insertion_struct(void)
 {
-    Vec* v = Vec_new(5, sizeof(Fish));
-
-    assert(v != NULL);
-
     /*
-     * The equality function fails and returns false if either vector pointer is
-     * null (but the comparator pointer is optional).
+     * Using a pointer, `target`, to a `Fish` inside the not-full vector
+     *
+     * ```
+     *     Will insert here
+     *     |     target
+     *     v     v
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * insert a copy of that `Fish` in somwhere among the others (denoted by
+     * their sizes).
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    assert(false == Vec_equal(v, NULL, fish_color_comparator));
-    assert(false == Vec_equal(v, NULL, NULL));
-
-    assert(false == Vec_equal(NULL, v, fish_color_comparator));
-    assert(false == Vec_equal(NULL, v, NULL));
-
-    assert(false == Vec_equal(NULL, NULL, fish_color_comparator));
-    assert(false == Vec_equal(NULL, NULL, NULL));
-
-    Vec_destroy(&v);
-}
-
-static void test_equal_unmodified_default_comparator(void)
-{
-    // Make two identical vectors.
-    Vec* v1 = Vec_new(15, sizeof(uint16_t));
-    Vec* v2 = Vec_new(15, sizeof(uint16_t));
+    Vec* v = Vec_new(10, sizeof(Fish));
 
-    assert(v1 != NULL);
-    assert(v2 != NULL);
+    assert(v != NULL);
 
-    assert(true == Vec_append(v1, &(uint16_t){42}, sizeof(uint16_t)));
-    assert(true == Vec_append(v1, &(uint16_t){43}, sizeof(uint16_t)));
-    assert(true == Vec_append(v1, &(uint16_t){44}, sizeof(uint16_t)));
+    // Add some unique elements to the vector.
+    size_t const initial_cap = Vec_capacity(v);
 
-    assert(true == Vec_append(v2, &(uint16_t){42}, sizeof(uint16_t)));
-    assert(true == Vec_append(v2, &(uint16_t){43}, sizeof(uint16_t)));
-    assert(true == Vec_append(v2, &(uint16_t){44}, sizeof(uint16_t)));
+    Vec_append(v,
+               &(Fish)
+               {
+                   .color = RED,
+                   .size = 9
+               },
+               sizeof(Fish)); // Index 0
+    Vec_append(v,
+               &(Fish)
+               {
+                   .color = GREEN,
+                   .size = 8
+               },
+               sizeof(Fish)); // Index 1
+    Vec_append(v,
+               &(Fish)
+               {
+                   .color = BLUE,
+                   .size = 7
+               },
+               sizeof(Fish)); // Index 2
+    Vec_append(v,
+               &(Fish)
+               {
+                   .color = RED,
+                   .size = 6
+               },
+               sizeof(Fish)); // Index 3
+    Vec_append(v,
+               &(Fish)
+               {
+                   .color = GREEN,
+                   .size = 5
+               },
+               sizeof(Fish)); // Index 4
+    assert(Vec_count(v) == 5);
+    assert(Vec_capacity(v) == initial_cap); // No resize should have occurred.
 
-    assert(Vec_count(v1) == 3);
-    assert(Vec_count(v2) == 3);
-    assert(Vec_capacity(v1) == Vec_capacity(v2));
+    // Get a pointer to the element.
+    Fish const element =
+    {
+        .color = RED,
+        .size = 6
+    };
+    size_t const target_index = 3;
+    size_t const insertion_index = 1;
+    Fish* target = (Fish*) Vec_get(v, target_index);
 
-    // Verify that they are considered equal.
-    assert(true == Vec_equal(v1, v2, NULL));
+    assert(target != NULL);
+    assert(target->color == element.color);
+    assert(target->size == element.size);
 
-    Vec_destroy(&v1);
-    Vec_destroy(&v2);
-}
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
 
-static void test_equal_unmodified_custom_comparator(void)
-{
-    // Make two vectors that have the same elements but different capacities.
-    Vec* v1 = Vec_new(1, sizeof(Fish));
-    Vec* v2 = Vec_new(1000, sizeof(Fish));
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
 
-    assert(v1 != NULL);
-    assert(v2 != NULL);
+    /*
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *     Inserted here
+     *     v
+     * [9][6][8][7][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    Vec* expected = Vec_new(10, sizeof(Fish));
 
-    assert(true == Vec_append(v1,
+    assert(expected != NULL);
+    assert(true == Vec_append(expected,
                               &(Fish)
                               {
                                   .color = RED,
-                                  .size = 1
+                                  .size = 9
                               },
                               sizeof(Fish)));
-    assert(true == Vec_append(v1,
+    assert(true == Vec_append(expected,
                               &(Fish)
                               {
-                                  .color = GREEN,
-                                  .size = 1
+                                  .color = RED,
+                                  .size = 6
                               },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v1,
+                              sizeof(Fish))); // Inserted
+    assert(true == Vec_append(expected,
                               &(Fish)
                               {
-                                  .color = RED,
-                                  .size = 2
+                                  .color = GREEN,
+                                  .size = 8
                               },
                               sizeof(Fish)));
-
-    assert(true == Vec_append(v2,
+    assert(true == Vec_append(expected,
                               &(Fish)
                               {
-                                  .color = RED,
-                                  .size = 1
+                                  .color = BLUE,
+                                  .size = 7
                               },
                               sizeof(Fish)));
-    assert(true == Vec_append(v2,
+    assert(true == Vec_append(expected,
                               &(Fish)
                               {
-                                  .color = GREEN,
-                                  .size = 1
+                                  .color = RED,
+                                  .size = 6
                               },
                               sizeof(Fish)));
-    assert(true == Vec_append(v2,
+    assert(true == Vec_append(expected,
                               &(Fish)
                               {
-                                  .color = RED,
-                                  .size = 2
+                                  .color = GREEN,
+                                  .size = 5
                               },
                               sizeof(Fish)));
+    assert(Vec_count(expected) == prev_count + 1);
 
-    assert(Vec_count(v1) == 3);
-    assert(Vec_count(v2) == 3);
-    assert(Vec_capacity(v1) != Vec_capacity(v2));
-
-    // Verify they're are considered equal (since they have the same elements).
-    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+    assert(true == Vec_equal(v, expected, fish_size_equality_comparator));
 
-    Vec_destroy(&v1);
-    Vec_destroy(&v2);
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_equal_modified(void)
+static void test_insert_inner_pointer_tail_before_insertion(void)
 {
-    // Make two vectors that have all but one element in common.
-    Vec* v1 = Vec_new(3, sizeof(Fish));
-    Vec* v2 = Vec_new(3, sizeof(Fish));
-
-    assert(v1 != NULL);
-    assert(v2 != NULL);
-
-    // Two empty vectors with the same element size are considered equal.
-    assert(true == Vec_equal(v1, v2, NULL));
-    assert(true == Vec_equal(v1, v2, fish_color_comparator));
-
-    Fish const f1 =
-    {
-        .color = RED,
-        .size = 1
-    };
-    Fish const f2 =
-    {
-        .color = GREEN,
-        .size = 2
-    };
-    Fish const f3 =
-    {
-        .color = BLUE,
-        .size = 3
-    };
-
-    Vec_append(v1, &f1, sizeof(f1));
-    Vec_append(v1, &f2, sizeof(f2));
-    Vec_append(v1, &f3, sizeof(f3));
-
-    Vec_append(v2, &f1, sizeof(f1));
-    Vec_append(v2, &f2, sizeof(f2));
-    // Last element missing!
-
-    assert(Vec_count(v1) > Vec_count(v2));
-    assert(false == Vec_equal(v1, v2, fish_color_comparator));
-
-    // After adding the missing element, the vectors should report as equal.
-    Vec_append(v2, &f3, sizeof(f3));
+    /*
+     * Using a pointer, `target`, to an element inside the not-full vector
+     *
+     * ```
+     *              target
+     *              |  Will insert here
+     *              v  v
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
+     */
+    Vec* v = insert_inner_pointer_input_helper();
 
-    assert(Vec_count(v1) == Vec_count(v2));
-    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+    // Get a pointer to the element.
+    int64_t const element = 5;
+    size_t const target_index = 4;
+    size_t const insertion_index = 5;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
-    // After inserting a new element into one vector, they should be unequal.
-    size_t const index = 0;
-    Fish inserted =
-    {
-        .color = RED,
-        .size = 2
-    };
+    assert(target != NULL);
+    assert(*target == element);
 
-    assert(true == Vec_insert(v1, index, &inserted, sizeof(inserted)));
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
 
-    assert(Vec_count(v1) > Vec_count(v2));
-    assert(false == Vec_equal(v1, v2, fish_color_comparator));
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
 
     /*
-     * After inserting the element in the same place in the other vector, they
-     * should be equal.
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *                 Inserted here
+     *                 v
+     * [9][8][7][6][5][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
      */
-    assert(true == Vec_insert(v2, index, &inserted, sizeof(inserted)));
-
-    assert(Vec_count(v1) == Vec_count(v2));
-    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-    // Removing an element from one vector makes the vectors unequal.
-    size_t const last_index = Vec_count(v1) - 1;
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t))); // New
+    assert(Vec_count(expected) == prev_count + 1);
 
-    Vec_remove(v1, last_index);
+    assert(true == Vec_equal(v, expected, NULL));
 
-    assert(Vec_count(v1) < Vec_count(v2));
-    assert(false == Vec_equal(v1, v2, fish_color_comparator));
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
 
-    // Removing the same element in the other vector, they should be equal.
-    Vec_remove(v2, last_index);
+static void test_insert_inner_pointer_tail_at_insertion(void)
+{
+    /*
+     * Using a pointer, `target`, to an element inside the not-full vector
+     *
+     * ```
+     *       target   Will insert here
+     *             \ /
+     *              |
+     *              v
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
+     */
+    Vec* v = insert_inner_pointer_input_helper();
 
-    assert(Vec_count(v1) == Vec_count(v2));
-    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+    // Get a pointer to the element.
+    int64_t const element = 5;
+    size_t const target_index = 4;
+    size_t const insertion_index = 4;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
-    // Add elements to the first vector until it resizes.
-    size_t old_cap = Vec_capacity(v1);
-    Fish const filler =
-    {
-        .color = GREEN,
-        .size = 1
-    };
+    assert(target != NULL);
+    assert(*target == element);
 
-    while (Vec_capacity(v1) == old_cap)
-    {
-        assert(true == Vec_append(v1, &filler, sizeof(filler)));
-    }
-    assert(false == Vec_equal(v1, v2, fish_color_comparator)); // Now unequal.
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
 
-    // Add the same elements to the other vector until it resizes.
-    old_cap = Vec_capacity(v2);
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
 
-    while (Vec_capacity(v2) == old_cap)
-    {
-        assert(true == Vec_append(v2, &filler, sizeof(filler)));
-    }
-    assert(true == Vec_equal(v1, v2, fish_color_comparator)); // Now equal.
+    /*
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *              Inserted here
+     *              v
+     * [9][8][7][6][5][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-    // Remove elements from the first vector until it's empty.
-    while (Vec_count(v1) > 0)
-    {
-        Vec_remove(v1, 0);
-    }
-    assert(Vec_count(v1) == 0);
-    assert(false == Vec_equal(v1, v2, fish_color_comparator)); // Now unequal.
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
 
-    // Remove elements from the other vector until it's empty.
-    while (Vec_count(v2) > 0)
-    {
-        Vec_remove(v2, 0);
-    }
-    assert(Vec_count(v2) == 0);
-    assert(true == Vec_equal(v1, v2, fish_color_comparator)); // Now equal.
+    assert(true == Vec_equal(v, expected, NULL));
 
-    Vec_destroy(&v1);
-    Vec_destroy(&v2);
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_equal_empty_same_element_size(void)
+static void test_insert_inner_pointer_tail_after_insertion(void)
 {
-    // Make two empty vectors that take elements of the same size (`Fish`).
-    Vec* v1 = Vec_new(1, sizeof(Fish));
-    Vec* v2 = Vec_new(1, sizeof(Fish));
-
-    assert(v1 != NULL);
-    assert(v2 != NULL);
-
     /*
-     * The vectors should be empty, and, since both take elements of the same
-     * size, they should be equal (regardless of what comparator is used).
+     * Using a pointer, `target`, to an element inside the not-full vector
+     *
+     * ```
+     *           Will insert here
+     *           |  target
+     *           v  v
+     * [9][8][7][6][5][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    assert(Vec_count(v1) == 0);
-    assert(Vec_count(v2) == Vec_count(v1));
-    assert(true == Vec_equal(v1, v2, NULL));
-    assert(true == Vec_equal(v1, v2, fish_color_comparator));
-
-    // Add an element to one of the vectors.
-    Fish const dory = (Fish)
-    {
-        .color = BLUE,
-        .size = 2
-    };
-
-    assert(true == Vec_append(v1,
-                              &dory,
-                              sizeof(Fish)));
-
-    // The vectors are no longer equal.
-    assert(Vec_count(v1) == 1);
-    assert(Vec_count(v2) != Vec_count(v1));
-    assert(false == Vec_equal(v1, v2, NULL));
-    assert(false == Vec_equal(v1, v2, fish_color_comparator));
-
-    // Remove the element.
-    assert(Vec_get(v1, 0) != NULL);
-    assert(Vec_remove(v1, 0) == 0);
+    Vec* v = insert_inner_pointer_input_helper();
 
-    // Both vectors should be empty and equal again.
-    assert(Vec_count(v1) == 0);
-    assert(Vec_count(v2) == Vec_count(v1));
-    assert(true == Vec_equal(v1, v2, NULL));
-    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+    // Get a pointer to the element.
+    int64_t const element = 5;
+    size_t const target_index = 4;
+    size_t const insertion_index = 3;
+    int64_t* target = (int64_t*) Vec_get(v, target_index);
 
-    Vec_destroy(&v1);
-    Vec_destroy(&v2);
-}
+    assert(target != NULL);
+    assert(*target == element);
 
-static void test_equal_empty_diff_element_size(void)
-{
-    // Make two empty vectors that take elements of the different sizes.
-    Vec* v1 = Vec_new(1, sizeof(uint16_t));
-    Vec* v2 = Vec_new(1, sizeof(uint32_t));
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
 
-    assert(v1 != NULL);
-    assert(v2 != NULL);
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
 
     /*
-     * The vectors should be empty, and, since both take elements of different
-     * sizes, they should NOT be equal (regardless of what comparator is used).
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *           Inserted here
+     *           v
+     * [9][8][7][5][6][5][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
      */
-    assert(Vec_count(v1) == 0);
-    assert(Vec_count(v2) == Vec_count(v1));
-    assert(false == Vec_equal(v1, v2, NULL));
-    assert(false == Vec_equal(v1, v2, fish_color_comparator));
-
-    Vec_destroy(&v1);
-    Vec_destroy(&v2);
-}
-
-static void test_remove_all_invalid(void)
-{
-    Vec* v = Vec_new(10, sizeof(uint8_t));
-
-    assert(v != NULL);
+    Vec* expected = Vec_new(10, sizeof(int64_t));
 
-    // Try removing an element not matching the size expected by the vector.
-    assert(0 == Vec_remove_all(v, &(uint8_t){5}, sizeof(uint8_t)));
-    assert(0 == Vec_remove_all(v, &(uint8_t){5}, 0));
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t))); // New
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_count(expected) == prev_count + 1);
 
-    // Try removing with null pointers.
-    assert(0 == Vec_remove_all(NULL, &(uint8_t){5}, sizeof(uint8_t)));
-    assert(0 == Vec_remove_all(v, NULL, sizeof(uint8_t)));
-    assert(0 == Vec_remove_all(NULL, NULL, sizeof(uint8_t)));
+    assert(true == Vec_equal(v, expected, NULL));
 
     Vec_destroy(&v);
+    Vec_destroy(&expected);
 }
 
-static void test_remove_all_none(void)
+static void test_insert_full_inner_pointer_head_before_insertion(void)
 {
     /*
-     * Remove an element that doesn't match any element in the vector. So from
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     * [y][y][y]
-     *  0  1  2
+     *        target
+     *        |  Will insert here
+     *        v  v
+     *       [0][1][2]. . .[8][9][a]. . .[d][e][f]
+     *        0  1  2       8  9  a       d  e  f
      * ```
      *
-     * we'll try removing all instances of `X` (of which there are none).
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    Vec* v = Vec_new(10, sizeof(int));
+    Vec* v = new_full_u64_vec(16);
 
-    // Removing all from an empty vector is fine but does nothing.
-    assert(v != NULL);
-    assert(0 == Vec_remove_all(v, &(uint8_t){5}, sizeof(uint8_t)));
-    assert(0 == Vec_count(v));
+    // Get a pointer to the element.
+    uint64_t const element = 0;
+    size_t const target_index = 0;
+    size_t const insertion_index = 1;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
 
-    // So add some positive integers...
-    assert(true == Vec_append(v, &(int){0}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){1}, sizeof(int)));
-    assert(true == Vec_append(v, &(int){2}, sizeof(int)));
-    assert(Vec_count(v) == 3);
+    assert(target != NULL);
+    assert(*target == element);
 
-    // ...and try to remove all integers that are -2 (when there aren't any).
-    assert(0 == Vec_remove_all(v, &(int){-2}, sizeof(int)));
-    assert(Vec_count(v) == 3); // No elements were removed.
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
 
-    Vec_destroy(&v);
-}
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
-static void test_remove_all_one(void)
-{
     /*
-     * Remove an element that only matches one element in the vector. So from
+     * After insertion, the vector should look like this:
      *
      * ```
-     * [9][8][7][6]
-     *  0  1  2  3
+     *     Inserted here
+     *     v
+     * [0][0][1]. . .[7][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
+     *  0  1  2       8  9  a       d  e  f (Expanded space)
      * ```
-     *
-     * we'll try removing all instances of `9` (of which there is one, at the
-     * very beginning).
      */
-    Vec* v = Vec_new(5, sizeof(uint64_t));
-    Vec* expected = NULL;
+    uint64_t* probe = NULL;
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &(uint64_t){9}, sizeof(uint64_t)));
-    assert(true == Vec_append(v, &(uint64_t){8}, sizeof(uint64_t)));
-    assert(true == Vec_append(v, &(uint64_t){7}, sizeof(uint64_t)));
-    assert(true == Vec_append(v, &(uint64_t){6}, sizeof(uint64_t)));
-    assert(Vec_count(v) == 4);
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
 
-    // Try to remove all elements that match `9`.
-    assert(1 == Vec_remove_all(v, &(uint64_t){9}, sizeof(uint64_t)));
-    assert(Vec_count(v) == 3); // One element was removed.
+        if (i == 0 || i == 1)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else
+        {
+            assert(*probe == (uint64_t){i - 1}); // Shifted
+        }
+    }
+
+    Vec_destroy(&v);
+}
 
+static void test_insert_full_inner_pointer_head_at_insertion(void)
+{
     /*
-     * The vector now looks like this:
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     * [8][7][6][ ]
-     *  0  1  2  3
+     * target   Will insert here
+     *       \ /
+     *        |
+     *        v
+     *       [0][1][2]. . .[8][9][a]. . .[d][e][f]
+     *        0  1  2       8  9  a       d  e  f
      * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    expected = Vec_new(3, sizeof(uint64_t));
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(uint64_t){8}, sizeof(uint64_t)));
-    assert(true == Vec_append(expected, &(uint64_t){7}, sizeof(uint64_t)));
-    assert(true == Vec_append(expected, &(uint64_t){6}, sizeof(uint64_t)));
-    assert(Vec_count(expected) == 3);
+    Vec* v = new_full_u64_vec(16);
 
-    assert(true == Vec_equal(v, expected, NULL));
-    Vec_destroy(&expected);
+    // Get a pointer to the element.
+    uint64_t const element = 0;
+    size_t const target_index = 0;
+    size_t const insertion_index = 0;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+
+    assert(target != NULL);
+    assert(*target == element);
+
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
     /*
-     * Next, remove one element from the middle, making the vector look like:
+     * After insertion, the vector should look like this:
      *
      * ```
-     * [8][6][ ][ ]
-     *  0  1  2  3
-     * ```
-     */
-    assert(1 == Vec_remove_all(v, &(uint64_t){7}, sizeof(uint64_t)));
-    assert(Vec_count(v) == 2); // One element was removed.
-
-    expected = Vec_new(2, sizeof(uint64_t));
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(uint64_t){8}, sizeof(uint64_t)));
-    assert(true == Vec_append(expected, &(uint64_t){6}, sizeof(uint64_t)));
-    assert(Vec_count(expected) == 2);
-
-    assert(true == Vec_equal(v, expected, NULL));
-    Vec_destroy(&expected);
-
-    /*
-     * Next, remove one element from the end, making the vector look like:
-     *
-     * ```
-     * [8][ ][ ][ ]
-     *  0  1  2  3
+     *  Inserted here
+     *  v
+     * [0][0][1]. . .[7][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
+     *  0  1  2       8  9  a       d  e  f (Expanded space)
      * ```
      */
-    assert(1 == Vec_remove_all(v, &(uint64_t){6}, sizeof(uint64_t)));
-    assert(Vec_count(v) == 1); // One element was removed.
+    uint64_t* probe = NULL;
 
-    expected = Vec_new(1, sizeof(uint64_t));
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(uint64_t){8}, sizeof(uint64_t)));
-    assert(Vec_count(expected) == 1);
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
 
-    assert(true == Vec_equal(v, expected, NULL));
-    Vec_destroy(&expected);
+        if (i == 0 || i == 1)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else
+        {
+            assert(*probe == (uint64_t){i - 1}); // Shifted
+        }
+    }
 
     Vec_destroy(&v);
 }
 
-static void test_remove_all_partial(void)
+static void test_insert_full_inner_pointer_head_after_insertion(void)
 {
     /*
-     * Remove an element that matches several elements in the vector. So from
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     * [X][X][a][X][X][X][b][X][c][X]
-     *  0  1  2  3  4  5  6  7  8  9
+     *        Will insert here
+     *        |  target
+     *        v  v
+     *       [0][1][2]. . .[8][9][a]. . .[d][e][f]
+     *        0  1  2       8  9  a       d  e  f
      * ```
      *
-     * we'll try removing all instances of `X`.
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    Vec* v = Vec_new(10, sizeof(uint64_t));
-    uint64_t const a = 1;
-    uint64_t const b = 2;
-    uint64_t const c = 3;
-    uint64_t const X = 4;
+    Vec* v = new_full_u64_vec(16);
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &X, sizeof(X)));
-    assert(true == Vec_append(v, &X, sizeof(X)));
-    assert(true == Vec_append(v, &a, sizeof(a))); // a
-    assert(true == Vec_append(v, &X, sizeof(X)));
-    assert(true == Vec_append(v, &X, sizeof(X)));
-    assert(true == Vec_append(v, &X, sizeof(X)));
-    assert(true == Vec_append(v, &b, sizeof(b))); // b
-    assert(true == Vec_append(v, &X, sizeof(X)));
-    assert(true == Vec_append(v, &c, sizeof(c))); // c
-    assert(true == Vec_append(v, &X, sizeof(X)));
-    assert(Vec_count(v) == 10);
+    // Get a pointer to the element.
+    uint64_t const element = 1;
+    size_t const target_index = 1;
+    size_t const insertion_index = 0;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
 
-    uint64_t* probe = Vec_get(v, 0);
+    assert(target != NULL);
+    assert(*target == element);
 
-    assert(probe != NULL);
-    assert(*probe == X);
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
 
-    // Remove all elements that match `X`.
-    assert(7 == Vec_remove_all(v, probe, sizeof(*probe)));
-    probe = NULL; // Pointer invalidated by the removal
-    assert(Vec_count(v) == 3); // No `X`s remain.
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
     /*
-     * The vector should now look like this:
+     * After insertion, the vector should look like this:
      *
      * ```
-     * [a][b][c][ ][ ][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *  Inserted here
+     *  v
+     * [1][0][1]. . .[7][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
+     *  0  1  2       8  9  a       d  e  f (Expanded space)
      * ```
      */
-    Vec* expected = Vec_new(3, sizeof(uint64_t));
+    uint64_t* probe = NULL;
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &a, sizeof(a)));
-    assert(true == Vec_append(expected, &b, sizeof(b)));
-    assert(true == Vec_append(expected, &c, sizeof(c)));
-    assert(Vec_count(expected) == 3);
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
 
-    assert(true == Vec_equal(v, expected, NULL));
+        if (i == 0)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else
+        {
+            assert(*probe == (uint64_t){i - 1}); // Shifted
+        }
+    }
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_remove_all_except_one(void)
+static void test_insert_full_inner_pointer_middle_before_insertion(void)
 {
     /*
-     * Remove all elements except one. So from
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     * [X][X][X][X][a]
-     *  0  1  2  3  4
+     *                   target
+     *                   |  Will insert here
+     *                   v  v
+     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
+     *  0  1  2       7  8  9       d  e  f
      * ```
      *
-     * we'll try removing all instances of `X`.
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    Vec* v = Vec_new(5, sizeof(uint64_t));
-    uint64_t const X = 1;
-    uint64_t const a = 2;
-
-    assert(v != NULL);
-    for (int i = 0; i < 4; ++i)
-    {
-        assert(true == Vec_append(v, &X, sizeof(X)));
-    }
-    assert(true == Vec_append(v, &a, sizeof(a)));
-    assert(5 == Vec_count(v));
-
-    // Remove all `X`s.
-    assert(4 == Vec_remove_all(v, &X, sizeof(X)));
+    Vec* v = new_full_u64_vec(16);
 
-    // No `X`s remain, leaving only one element.
-    assert(1 == Vec_count(v));
+    // Get a pointer to the element.
+    uint64_t const element = Vec_count(v) / 2; // Assuming elements are indices
+    size_t const target_index = Vec_count(v) / 2;
+    size_t const insertion_index = target_index + 1;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
 
-    uint64_t* probe = (uint64_t*) Vec_get(v, 0);
+    assert(target != NULL);
+    assert(*target == element);
 
-    assert(probe != NULL);
-    assert(*probe == a);
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
 
-    Vec_destroy(&v);
-}
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
-static void test_remove_all_total(void)
-{
     /*
-     * Remove all elements. So from
+     * After insertion, the vector should look like this:
      *
      * ```
-     * [X][X][X][X][X][X][X][X][X][X]
-     *  0  1  2  3  4  5  6  7  8  9
+     *                      Inserted here
+     *                      |  Shifted elements begin here
+     *                      v  v
+     * [0][1][2]. . .[7][8][8][9]. . .[c][d][e][f][ ][ ][ ]. . .
+     *  0  1  2       7  8  9  a       d  e  f (Expanded space)
      * ```
-     *
-     * we'll try removing all instances of `X` (i.e., all the elements).
      */
-    Vec* v = Vec_new(10, sizeof(uint64_t));
+    uint64_t* probe = NULL;
 
-    for (int i = 0; i < 10; ++i)
+    for (size_t i = 0; i < Vec_count(v); ++i)
     {
-        assert(true == Vec_append(v, &(uint64_t){6}, sizeof(uint64_t)));
-    }
-    assert(10 == Vec_count(v));
-
-    // Remove all `X`s.
-    assert(10 == Vec_remove_all(v, &(uint64_t){6}, sizeof(uint64_t)));
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
 
-    // No `X`s remain.
-    assert(0 == Vec_count(v));
+        if (i < insertion_index)
+        {
+            assert(*probe == (uint64_t){i}); // Unchanged
+        }
+        else if (i == insertion_index)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else
+        {
+            assert(*probe == (uint64_t){i - 1}); // Shifted
+        }
+    }
 
     Vec_destroy(&v);
 }
 
-static Vec* remove_all_partial_inner_pointer_input_helper(int64_t const X,
-                                                          int64_t const y)
+static void test_insert_full_inner_pointer_middle_at_insertion(void)
 {
     /*
-     * Create the vector
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     * [X][X][y][X][X][X][y][y][X][X]
-     *  0  1  2  3  4  5  6  7  8  9
+     *            target   Will insert here
+     *                  \ /
+     *                   |
+     *                   v
+     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
+     *  0  1  2       7  8  9       d  e  f
      * ```
      *
-     * using the given `X` and `y` parameters.
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    Vec* v = Vec_new(10, sizeof(int64_t));
+    Vec* v = new_full_u64_vec(16);
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &X, sizeof(X))); // 0
-    assert(true == Vec_append(v, &X, sizeof(X))); // 1
-    assert(true == Vec_append(v, &y, sizeof(y))); // 2
-    assert(true == Vec_append(v, &X, sizeof(X))); // 3
-    assert(true == Vec_append(v, &X, sizeof(X))); // 4
-    assert(true == Vec_append(v, &X, sizeof(X))); // 5
-    assert(true == Vec_append(v, &y, sizeof(y))); // 6
-    assert(true == Vec_append(v, &y, sizeof(y))); // 7
-    assert(true == Vec_append(v, &X, sizeof(X))); // 8
-    assert(true == Vec_append(v, &X, sizeof(X))); // 9
-    assert(10 == Vec_count(v));
+    // Get a pointer to the element.
+    uint64_t const element = Vec_count(v) / 2; // Assuming elements are indices
+    size_t const target_index = Vec_count(v) / 2;
+    size_t const insertion_index = target_index;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
 
-    return v;
+    assert(target != NULL);
+    assert(*target == element);
+
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+
+    /*
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *                   Inserted here
+     *                   |  Shifted elements begin here
+     *                   v  v
+     * [0][1][2]. . .[7][8][8]. . .[c][d][e][f][ ][ ][ ]. . .
+     *  0  1  2       7  8  9       d  e  f (Expanded space)
+     * ```
+     */
+    uint64_t* probe = NULL;
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i < insertion_index)
+        {
+            assert(*probe == (uint64_t){i}); // Unchanged
+        }
+        else if (i == insertion_index)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else
+        {
+            assert(*probe == (uint64_t){i - 1}); // Shifted
+        }
+    }
+
+    Vec_destroy(&v);
 }
 
-static Vec* remove_all_partial_inner_pointer_expected_helper(int64_t const y)
+static void test_insert_full_inner_pointer_middle_after_insertion(void)
 {
     /*
-     * Create the vector
+     * Using a pointer, `target`, to an element inside the not-full vector
      *
      * ```
-     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *                Will insert here
+     *                |  target
+     *                v  v
+     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
+     *  0  1  2       7  8  9       d  e  f
      * ```
      *
-     * using the given `y` parameter.
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    Vec* expected = Vec_new(10, sizeof(int64_t));
+    Vec* v = new_full_u64_vec(16);
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &y, sizeof(y))); // 0
-    assert(true == Vec_append(expected, &y, sizeof(y))); // 1
-    assert(true == Vec_append(expected, &y, sizeof(y))); // 2
-    assert(3 == Vec_count(expected));
+    // Get a pointer to the element.
+    uint64_t const element = Vec_count(v) / 2; // Assuming elements are indices
+    size_t const target_index = Vec_count(v) / 2;
+    size_t const insertion_index = target_index - 1;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
 
-    return expected;
+    assert(target != NULL);
+    assert(*target == element);
+
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+
+    /*
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *                Inserted here
+     *                |  Shifted elements begin here
+     *                v  v
+     * [0][1][2]. . .[8][7][8]. . .[c][d][e][f][ ][ ][ ]. . .
+     *  0  1  2       7  8  9       d  e  f (Expanded space)
+     * ```
+     */
+    uint64_t* probe = NULL;
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i < insertion_index)
+        {
+            assert(*probe == (uint64_t){i}); // Unchanged
+        }
+        else if (i == insertion_index)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else
+        {
+            assert(*probe == (uint64_t){i - 1}); // Shifted
+        }
+    }
+
+    Vec_destroy(&v);
 }
 
-static void test_remove_all_partial_inner_pointer_to_head(void)
+static void test_insert_full_inner_pointer_middle_after_insertion_struct(void)
 {
     /*
-     * Remove all instances of `X` using a pointer, `p`, to the first element
-     * inside the vector:
+     * Using a pointer, `target`, to a `Fish` inside the not-full vector
      *
      * ```
-     *  p
-     *  v
-     * [X][X][y][X][X][X][y][y][X][X]
-     *  0  1  2  3  4  5  6  7  8  9
+     *                Will insert here
+     *                |     target
+     *                v     v
+     * [0][1][2]. . .[7][8][9]. . .[d][e][f]
+     *  0  1  2       7  8  9       d  e  f
      * ```
+     *
+     * insert a copy of that `Fish` among the others (denoted by their sizes).
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
      */
-    int64_t const X = 6;
-    int64_t const y = 7;
-    Vec* v = remove_all_partial_inner_pointer_input_helper(X, y);
+    Vec* v = new_full_Fish_vec(16);
 
-    // Get a pointer to the first element.
-    int64_t* p = (int64_t*) Vec_get(v, 0);
+    // Get a pointer to the element.
+    size_t const target_index = (Vec_count(v) / 2) + 1;
+    size_t const insertion_index = target_index - 2;
+    Fish const element = index_to_Fish(target_index);
+    Fish* target = (Fish*) Vec_get(v, target_index);
 
-    assert(p != NULL);
-    assert(*p == X);
-    assert(7 == Vec_remove_all(v, p, sizeof(*p)));
-    p = NULL; // Pointer invalidated by the removal
-    assert(3 == Vec_count(v));
+    assert(target != NULL);
+    assert(target->color == element.color);
+    assert(target->size == element.size);
 
-    Vec* expected = remove_all_partial_inner_pointer_expected_helper(y);
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
 
     /*
-     * With the `X`s removed, the vector should now look like this:
+     * After insertion, the vector should look like this:
      *
      * ```
-     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
+     *                Inserted here
+     *                |  Shifted elements begin here
+     *                v  v
+     * [0][1][2]. . .[9][7][8]. . .[c][d][e][f][ ][ ][ ]. . .
+     *  0  1  2       7  8  9       d  e  f (Expanded space)
      * ```
      */
-    assert(true == Vec_equal(v, expected, NULL));
+    Fish* probe = NULL;
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (Fish*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i < insertion_index)
+        {
+            // Unchanged
+            Fish const f = index_to_Fish(i);
+
+            assert(probe->color == f.color);
+            assert(probe->size == f.size);
+        }
+        else if (i == insertion_index)
+        {
+            // Inserted
+            assert(probe->color == element.color);
+            assert(probe->size == element.size);
+        }
+        else
+        {
+            // Shifted
+            Fish const f = index_to_Fish(i - 1);
+
+            assert(probe->color == f.color);
+            assert(probe->size == f.size);
+        }
+    }
+
+    Vec_destroy(&v);
+}
+
+static void test_insert_full_inner_pointer_tail_before_insertion(void)
+{
+    /*
+     * Using a pointer, `target`, to an element inside the not-full vector
+     *
+     * ```
+     *                                    target
+     *                                    |  Will insert here
+     *                                    v  v
+     * [0][1][2]. . .[8][9][a]. . .[d][e][f][ ]
+     *  0  1  2       8  9  a       d  e  f  ^
+     *                                       One past the end
+     * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
+     */
+    Vec* v = new_full_u64_vec(16);
+
+    // Get a pointer to the element.
+    uint64_t const element = Vec_count(v) - 1; // Assuming elements are indices
+    size_t const target_index = Vec_count(v) - 1;
+    size_t const insertion_index = target_index + 1;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+
+    assert(target != NULL);
+    assert(*target == element);
+
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+
+    /*
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *                                       Inserted here
+     *                                       v
+     * [0][1][2]. . .[8][9][a]. . .[d][e][f][f][ ][ ][ ]. . .
+     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     * ```
+     */
+    uint64_t* probe = NULL;
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i < insertion_index)
+        {
+            assert(*probe == (uint64_t){i}); // Unchanged
+        }
+        else if (i == insertion_index)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else
+        {
+            assert(false); // There should be no elements past the insertion.
+        }
+    }
+
+    Vec_destroy(&v);
+}
+
+static void test_insert_full_inner_pointer_tail_at_insertion(void)
+{
+    /*
+     * Using a pointer, `target`, to an element inside the not-full vector
+     *
+     * ```
+     *                             target   Will insert here
+     *                                   \ /
+     *                                    |
+     *                                    v
+     * [0][1][2]. . .[8][9][a]. . .[d][e][f]
+     *  0  1  2       8  9  a       d  e  f
+     * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
+     */
+    Vec* v = new_full_u64_vec(16);
+
+    // Get a pointer to the element.
+    uint64_t const element = Vec_count(v) - 1; // Assuming elements are indices
+    size_t const target_index = Vec_count(v) - 1;
+    size_t const insertion_index = target_index;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+
+    assert(target != NULL);
+    assert(*target == element);
+
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+
+    /*
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *                                    Inserted here
+     *                                    v
+     * [0][1][2]. . .[8][9][a]. . .[d][e][f][f][ ][ ][ ]. . .
+     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     * ```
+     */
+    uint64_t* probe = NULL;
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i < insertion_index)
+        {
+            assert(*probe == (uint64_t){i}); // Unchanged
+        }
+        else if (i == insertion_index)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else if (i == insertion_index + 1)
+        {
+            assert(*probe == element); // Shifted original element
+        }
+        else
+        {
+            // There should be no elements past the shifted original element.
+            assert(false);
+        }
+    }
+
+    Vec_destroy(&v);
+}
+
+static void test_insert_full_inner_pointer_tail_after_insertion(void)
+{
+    /*
+     * Using a pointer, `target`, to an element inside the not-full vector
+     *
+     * ```
+     *                                 Will insert here
+     *                                 |  target
+     *                                 v  v
+     * [0][1][2]. . .[8][9][a]. . .[d][e][f]
+     *  0  1  2       8  9  a       d  e  f
+     * ```
+     *
+     * insert a copy of that element.
+     *
+     * Before insertion, all the elements of the vector are unique. This is so
+     * that, should the memory behind `target` shift before insertion, this test
+     * verifies that the correct element (the element initially behind `target`)
+     * gets inserted.
+     */
+    Vec* v = new_full_u64_vec(16);
+
+    // Get a pointer to the element.
+    uint64_t const element = Vec_count(v) - 1; // Assuming elements are indices
+    size_t const target_index = Vec_count(v) - 1;
+    size_t const insertion_index = target_index - 1;
+    uint64_t* target = (uint64_t*) Vec_get(v, target_index);
+
+    assert(target != NULL);
+    assert(*target == element);
+
+    // Insert a copy of the element via a pointer to itself.
+    size_t const prev_count = Vec_count(v);
+    size_t const prev_cap = Vec_capacity(v);
+
+    assert(true == Vec_insert(v, insertion_index, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+    assert(Vec_count(v) == prev_count + 1); // An element was inserted.
+    assert(Vec_capacity(v) > prev_cap); // The vector was full, so it expanded.
+
+    /*
+     * After insertion, the vector should look like this:
+     *
+     * ```
+     *                                 Inserted here
+     *                                 v
+     * [0][1][2]. . .[8][9][a]. . .[d][f][e][f][ ][ ][ ]. . .
+     *  0  1  2       8  9  a       d  e  f (Expanded space)
+     * ```
+     */
+    uint64_t* probe = NULL;
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+
+        if (i < insertion_index)
+        {
+            assert(*probe == (uint64_t){i}); // Unchanged
+        }
+        else if (i == insertion_index)
+        {
+            assert(*probe == element); // Inserted
+        }
+        else if (i == insertion_index + 1)
+        {
+            assert(*probe == element - 1); // Shifted penultimate element (`e`)
+        }
+        else if (i == insertion_index + 2)
+        {
+            // Shifted original tail element (`f`)
+            assert(*probe == element);
+        }
+        else
+        {
+            // There should be no elements past the shifted tail element.
+            assert(false);
+        }
+    }
+
+    Vec_destroy(&v);
+}
+
+/**
+ * @struct
+ * An element type large enough that the vector can't stage it on the stack when
+ * inserting it
+ */
+typedef struct
+{
+    uint64_t words[64];
+} Block;
+
+/**
+ * @brief Makes a `Block` whose words are all the given value
+ * @param value The value of every word
+ * @return The `Block`
+ */
+static Block value_to_Block(uint64_t const value)
+{
+    Block b;
+
+    for (size_t i = 0; i < (sizeof(b.words) / sizeof(b.words[0])); ++i)
+    {
+        b.words[i] = value;
+    }
+
+    return b;
+}
+
+static void test_insert_inner_pointer_large_element(void)
+{
+    /*
+     * Using a pointer, `target`, to an element inside a not-full vector of
+     * `Block`s (which are too large to be staged on the stack during insertion)
+     *
+     * ```
+     *  Will insert here
+     *  |        target
+     *  v        v
+     * [0][1][2][3][ ][ ]
+     *  0  1  2  3  4  5
+     * ```
+     *
+     * insert a copy of that element. Then, once the vector's full, do it again.
+     */
+    Vec* v = Vec_new(6, sizeof(Block));
+
+    assert(v != NULL);
+    for (uint64_t i = 0; i < 4; ++i)
+    {
+        Block const b = value_to_Block(i);
+
+        assert(true == Vec_append(v, &b, sizeof(b)));
+    }
+    assert(Vec_capacity(v) > Vec_count(v)); // The vector's not full.
+
+    Block* target = (Block*) Vec_get(v, 3);
+
+    assert(target != NULL);
+    assert(true == Vec_insert(v, 0, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+
+    // Fill the vector up.
+    {
+        Block const b = value_to_Block(4);
+
+        while (Vec_count(v) < Vec_capacity(v))
+        {
+            assert(true == Vec_append(v, &b, sizeof(b)));
+        }
+    }
+    assert(Vec_capacity(v) == Vec_count(v)); // The vector's full.
+
+    /*
+     * The vector now looks like this:
+     *
+     * ```
+     *     Will insert here
+     *     |     target
+     *     v     v
+     * [3][0][1][2][3][4]
+     *  0  1  2  3  4  5
+     * ```
+     */
+    target = (Block*) Vec_get(v, 3);
+    assert(target != NULL);
+    assert(true == Vec_insert(v, 1, target, sizeof(*target)));
+    target = NULL; // Pointer invalidated by insertion
+
+    // `[3][2][0][1][2][3][4]`
+    uint64_t const expected[] = {3, 2, 0, 1, 2, 3, 4};
+
+    assert(Vec_count(v) == (sizeof(expected) / sizeof(expected[0])));
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        Block const* probe = (Block const*) Vec_get(v, i);
+        Block const b = value_to_Block(expected[i]);
+
+        assert(probe != NULL);
+        assert(0 == memcmp(probe, &b, sizeof(b)));
+    }
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_invalid(void)
+{
+    Vec* v = Vec_new(5, sizeof(uint64_t));
+
+    assert(v != NULL);
+
+    /*
+     * Remove from an out of bounds index.
+     *
+     * Since there is no element at that index, we should get back the index to
+     * one-past the last element. Since there are NO elements at all, the
+     * one-past the last index is 0.
+     */
+    assert(Vec_capacity(v) < 12345);
+    assert(Vec_remove(v, 12345) == 0);
+
+    /*
+     * Remove from an in bounds index where there's no element. Since the vector
+     * is empty, that's any in bounds index.
+     */
+    assert(Vec_count(v) == 0);
+    assert(Vec_remove(v, 0) == 0);
+    assert(Vec_capacity(v) > 3);
+    assert(Vec_remove(v, 1) == 0);
+    assert(Vec_remove(v, 2) == 0);
+    assert(Vec_remove(v, 3) == 0);
+
+    // Remove from a null vector.
+    assert(Vec_remove(NULL, 0) == 0);
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_middle(void)
+{
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
+    /*
+     * Remove something from the middle of the vector.
+     *
+     * ```
+     *                 Will remove from here
+     *                 v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
+     *  0  1  2  3  4  5  6  7  8  9       ^
+     *                                     Initial capacity
+     * ```
+     */
+    size_t const initial_count = Vec_count(v);
+    size_t removed_element_index = 5;
+
+    // First, note the element following the one we're about to remove.
+    uint64_t following_pre_removal = 0;
+
+    {
+        /*
+         * Also note that we have to store it as a value, briefly using a
+         * pointer in this nested scope for null checking when fetching the
+         * value.
+         *
+         * The pointer will be invalidated after we do the removal since the
+         * removal will cause elements to shift, changing what the pointer's
+         * pointing at!
+         */
+        uint64_t* following_pre_ptr = NULL; // WARNING: Will be invalidated!
+
+        following_pre_ptr = (uint64_t*) Vec_get(v, (removed_element_index + 1));
+        assert(following_pre_ptr != NULL);
+        following_pre_removal = *following_pre_ptr;
+    }
+
+    /*
+     * Now remove the element, receiving the index to the element after the one
+     * we removed.
+     */
+    size_t const following_index = Vec_remove(v, removed_element_index);
+
+    assert(Vec_count(v) == (initial_count - 1)); // An element was removed.
+
+    // The received index corresponds to the following element we noted earlier.
+    uint64_t* following_post_removal = NULL;
+
+    following_post_removal = (uint64_t*) Vec_get(v, following_index);
+    assert(following_post_removal != NULL);
+    assert(*following_post_removal == following_pre_removal);
+
+    /*
+     * The vector now looks like this:
+     *
+     * ```
+     *                 Removed from here
+     *                 v
+     * [0][1][2][3][4][6][7][8][9]. . .[x][ ]
+     *  0  1  2  3  4  5  6  7  8          ^
+     *                                     Initial capacity
+     * ```
+     */
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        uint64_t* probe = NULL;
+
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+        if (i < removed_element_index)
+        {
+            // The elements before the removal site are still `i`.
+            assert(*probe == i);
+        }
+        else
+        {
+            // Those at and past the removal site are now `i + 1`.
+            assert(*probe == (i + 1));
+        }
+    }
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_tail(void)
+{
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
+    /*
+     * Remove the last element of the vector.
+     *
+     * ```
+     *                                            Will remove from here
+     *                                            v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x - 1][x]
+     *  0  1  2  3  4  5  6  7  8  9              ^
+     *                                            Initial capacity
+     * ```
+     */
+    size_t const initial_count = Vec_count(v);
+    size_t last_index_pre_removal = initial_count - 1;
+
+    // Remove the element, receiving the index one past the last index.
+    assert(Vec_remove(v, last_index_pre_removal) == Vec_count(v));
+    assert(Vec_count(v) == (initial_count - 1)); // An element was removed.
+
+    /*
+     * The vector now looks like this:
+     *
+     * ```
+     *                                         Removed from here
+     *                                         v
+     * [0][1][2][3][4][6][7][8][9]. . .[x - 1][ ]
+     *  0  1  2  3  4  5  6  7  8              ^
+     *                                         Initial capacity
+     * ```
+     */
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        uint64_t* probe = NULL;
+
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+        // The elements before the removal site are still `i`.
+        assert(*probe == i);
+        // And we never even reach the removal site since it's past the end!
+        assert(i < last_index_pre_removal);
+    }
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_head(void)
+{
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
+    /*
+     * Remove something from the middle of the vector.
+     *
+     * ```
+     *  Will remove from here
+     *  v
+     * [0][1][2][3][4][5][6][7][8][9]. . .[x]
+     *  0  1  2  3  4  5  6  7  8  9       ^
+     *                                     Initial capacity
+     * ```
+     */
+    size_t const initial_count = Vec_count(v);
+    size_t removed_element_index = 0;
+
+    /*
+     * Note the element following the one we're about to remove.
+     *
+     * We have to store the element as a value because the pointer will be
+     * invalidated after we do the removal since the removal will cause elements
+     * to shift, changing what the pointer's pointing at!
+     */
+    uint64_t following_pre_removal = 0;
+    uint64_t* probe = (uint64_t*) Vec_get(v, (removed_element_index + 1));
+
+    assert(probe != NULL);
+    following_pre_removal = *probe;
+
+    /*
+     * Now remove the element, receiving the index to the element after the one
+     * we removed.
+     */
+    size_t const following_index = Vec_remove(v, removed_element_index);
+
+    probe = NULL; // Pointer invalidated by the removal
+    assert(0 == following_index); // The element after should be the new head.
+    assert(Vec_count(v) == (initial_count - 1)); // An element was removed.
+
+    // The received index corresponds to the following element we noted earlier.
+    probe = (uint64_t*) Vec_get(v, following_index);
+    assert(probe != NULL);
+    assert(*probe == following_pre_removal);
+
+    /*
+     * The vector now looks like this:
+     *
+     * ```
+     *  Removed from here
+     *  v
+     * [1][2][3][4][5][6][7][8][9]. . .[x][ ]
+     *  0  1  2  3  4  5  6  7  8          ^
+     *                                     Initial capacity
+     * ```
+     */
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        uint64_t* probe = NULL;
+
+        probe = (uint64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+        // The elements are all now `i + 1`.
+        assert(*probe == (i + 1));
+    }
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_until_empty(void)
+{
+    Vec* v = new_full_u64_vec(10); // Get a full vector.
+
+    // Starting at the first index, remove an element until none remain.
+    size_t i = 0;
+
+    while (i < Vec_count(v))
+    {
+        /*
+         * `i` will be set to the index of the next element to remove.
+         *
+         * Since we started at the first index, `i` will be equal to the number
+         * of elements when there are no elements left.
+         */
+        i = Vec_remove(v, i);
+    }
+    assert(Vec_count(v) == 0); // The vector is empty.
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_zeroing(void)
+{
+    /*
+     * Remove the final element of a vector, then peek at the bytes it leaves
+     * behind in the vector's unused capacity (by offsetting a pointer to the
+     * remaining element).
+     *
+     * ```
+     *     Will remove from here
+     *     v
+     * [7][7][ ]
+     *  0  1  2
+     * ```
+     */
+    Vec* v = Vec_new(3, sizeof(uint64_t));
+    uint64_t const element = 7;
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(true == Vec_append(v, &element, sizeof(element)));
+
+    // By default, the removed element's bytes are zeroed out.
+    assert(1 == Vec_remove(v, 1));
+
+    uint8_t const* head = (uint8_t const*) Vec_get(v, 0);
+    uint64_t ghost = 0;
+
+    assert(head != NULL);
+    memcpy(&ghost, head + sizeof(uint64_t), sizeof(ghost));
+    assert(0 == ghost);
+
+    // With zeroing turned off, the removed element's bytes are left as is.
+    assert(true == Vec_set_zeroing(v, false));
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(1 == Vec_remove(v, 1));
+
+    head = (uint8_t const*) Vec_get(v, 0);
+    assert(head != NULL);
+    memcpy(&ghost, head + sizeof(uint64_t), sizeof(ghost));
+    assert(element == ghost);
+
+    // Ditto for removing multiple elements at once
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(3 == Vec_remove_all(v, &element, sizeof(element)));
+    assert(0 == Vec_count(v));
+
+    head = (uint8_t const*) Vec_get(v, 0); // There's no element to get...
+    assert(head == NULL);
+
+    // ...so turn zeroing back on and make sure removal zeroes many elements.
+    assert(true == Vec_set_zeroing(v, true));
+    assert(true == Vec_append(v, &(uint64_t){1}, sizeof(uint64_t)));
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(true == Vec_append(v, &element, sizeof(element)));
+    assert(2 == Vec_remove_all(v, &element, sizeof(element)));
+
+    head = (uint8_t const*) Vec_get(v, 0);
+    assert(head != NULL);
+    for (size_t i = 1; i < 3; ++i)
+    {
+        memcpy(&ghost, head + (i * sizeof(uint64_t)), sizeof(ghost));
+        assert(0 == ghost);
+    }
+
+    // A null vector can't have its zeroing set.
+    assert(false == Vec_set_zeroing(NULL, false));
+
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief A `Fish` comparator to be used by a vector's equality function that
+ * looks only at fish color
+ * @param fish_a A `Fish`
+ * @param fish_b Another `Fish`
+ * @return 1 if there was an input problem; 0 if the given `Fish` have the same
+ * color; 2 if they have different colors
+ */
+static int fish_color_comparator(void const* fish_a, void const* fish_b)
+{
+    if (fish_a == NULL ||
+        fish_b == NULL)
+    {
+        return 1;
+    }
+
+    // We know we're dealing with `Fish`; cast to the known type.
+    Fish const* a = (Fish const*) fish_a;
+    Fish const* b = (Fish const*) fish_b;
+
+    if (a->color == b->color)
+    {
+        return 0;
+    }
+
+    return 2;
+}
+
+static void test_equal_invalid(void)
+{
+    Vec* v = Vec_new(5, sizeof(Fish));
+
+    assert(v != NULL);
+
+    /*
+     * The equality function fails and returns false if either vector pointer is
+     * null (but the comparator pointer is optional).
+     */
+    assert(false == Vec_equal(v, NULL, fish_color_comparator));
+    assert(false == Vec_equal(v, NULL, NULL));
+
+    assert(false == Vec_equal(NULL, v, fish_color_comparator));
+    assert(false == Vec_equal(NULL, v, NULL));
+
+    assert(false == Vec_equal(NULL, NULL, fish_color_comparator));
+    assert(false == Vec_equal(NULL, NULL, NULL));
+
+    Vec_destroy(&v);
+}
+
+static void test_equal_unmodified_default_comparator(void)
+{
+    // Make two identical vectors.
+    Vec* v1 = Vec_new(15, sizeof(uint16_t));
+    Vec* v2 = Vec_new(15, sizeof(uint16_t));
+
+    assert(v1 != NULL);
+    assert(v2 != NULL);
+
+    assert(true == Vec_append(v1, &(uint16_t){42}, sizeof(uint16_t)));
+    assert(true == Vec_append(v1, &(uint16_t){43}, sizeof(uint16_t)));
+    assert(true == Vec_append(v1, &(uint16_t){44}, sizeof(uint16_t)));
+
+    assert(true == Vec_append(v2, &(uint16_t){42}, sizeof(uint16_t)));
+    assert(true == Vec_append(v2, &(uint16_t){43}, sizeof(uint16_t)));
+    assert(true == Vec_append(v2, &(uint16_t){44}, sizeof(uint16_t)));
+
+    assert(Vec_count(v1) == 3);
+    assert(Vec_count(v2) == 3);
+    assert(Vec_capacity(v1) == Vec_capacity(v2));
+
+    // Verify that they are considered equal.
+    assert(true == Vec_equal(v1, v2, NULL));
+
+    Vec_destroy(&v1);
+    Vec_destroy(&v2);
+}
+
+static void test_equal_unmodified_custom_comparator(void)
+{
+    // Make two vectors that have the same elements but different capacities.
+    Vec* v1 = Vec_new(1, sizeof(Fish));
+    Vec* v2 = Vec_new(1000, sizeof(Fish));
+
+    assert(v1 != NULL);
+    assert(v2 != NULL);
+
+    assert(true == Vec_append(v1,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v1,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v1,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 2
+                              },
+                              sizeof(Fish)));
+
+    assert(true == Vec_append(v2,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v2,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v2,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 2
+                              },
+                              sizeof(Fish)));
+
+    assert(Vec_count(v1) == 3);
+    assert(Vec_count(v2) == 3);
+    assert(Vec_capacity(v1) != Vec_capacity(v2));
+
+    // Verify they're are considered equal (since they have the same elements).
+    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+
+    Vec_destroy(&v1);
+    Vec_destroy(&v2);
+}
+
+static void test_equal_modified(void)
+{
+    // Make two vectors that have all but one element in common.
+    Vec* v1 = Vec_new(3, sizeof(Fish));
+    Vec* v2 = Vec_new(3, sizeof(Fish));
+
+    assert(v1 != NULL);
+    assert(v2 != NULL);
+
+    // Two empty vectors with the same element size are considered equal.
+    assert(true == Vec_equal(v1, v2, NULL));
+    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+
+    Fish const f1 =
+    {
+        .color = RED,
+        .size = 1
+    };
+    Fish const f2 =
+    {
+        .color = GREEN,
+        .size = 2
+    };
+    Fish const f3 =
+    {
+        .color = BLUE,
+        .size = 3
+    };
+
+    Vec_append(v1, &f1, sizeof(f1));
+    Vec_append(v1, &f2, sizeof(f2));
+    Vec_append(v1, &f3, sizeof(f3));
+
+    Vec_append(v2, &f1, sizeof(f1));
+    Vec_append(v2, &f2, sizeof(f2));
+    // Last element missing!
+
+    assert(Vec_count(v1) > Vec_count(v2));
+    assert(false == Vec_equal(v1, v2, fish_color_comparator));
+
+    // After adding the missing element, the vectors should report as equal.
+    Vec_append(v2, &f3, sizeof(f3));
+
+    assert(Vec_count(v1) == Vec_count(v2));
+    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+
+    // After inserting a new element into one vector, they should be unequal.
+    size_t const index = 0;
+    Fish inserted =
+    {
+        .color = RED,
+        .size = 2
+    };
+
+    assert(true == Vec_insert(v1, index, &inserted, sizeof(inserted)));
+
+    assert(Vec_count(v1) > Vec_count(v2));
+    assert(false == Vec_equal(v1, v2, fish_color_comparator));
+
+    /*
+     * After inserting the element in the same place in the other vector, they
+     * should be equal.
+     */
+    assert(true == Vec_insert(v2, index, &inserted, sizeof(inserted)));
+
+    assert(Vec_count(v1) == Vec_count(v2));
+    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+
+    // Removing an element from one vector makes the vectors unequal.
+    size_t const last_index = Vec_count(v1) - 1;
+
+    Vec_remove(v1, last_index);
+
+    assert(Vec_count(v1) < Vec_count(v2));
+    assert(false == Vec_equal(v1, v2, fish_color_comparator));
+
+    // Removing the same element in the other vector, they should be equal.
+    Vec_remove(v2, last_index);
+
+    assert(Vec_count(v1) == Vec_count(v2));
+    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+
+    // Add elements to the first vector until it resizes.
+    size_t old_cap = Vec_capacity(v1);
+    Fish const filler =
+    {
+        .color = GREEN,
+        .size = 1
+    };
+
+    while (Vec_capacity(v1) == old_cap)
+    {
+        assert(true == Vec_append(v1, &filler, sizeof(filler)));
+    }
+    assert(false == Vec_equal(v1, v2, fish_color_comparator)); // Now unequal.
+
+    // Add the same elements to the other vector until it resizes.
+    old_cap = Vec_capacity(v2);
+
+    while (Vec_capacity(v2) == old_cap)
+    {
+        assert(true == Vec_append(v2, &filler, sizeof(filler)));
+    }
+    assert(true == Vec_equal(v1, v2, fish_color_comparator)); // Now equal.
+
+    // Remove elements from the first vector until it's empty.
+    while (Vec_count(v1) > 0)
+    {
+        Vec_remove(v1, 0);
+    }
+    assert(Vec_count(v1) == 0);
+    assert(false == Vec_equal(v1, v2, fish_color_comparator)); // Now unequal.
+
+    // Remove elements from the other vector until it's empty.
+    while (Vec_count(v2) > 0)
+    {
+        Vec_remove(v2, 0);
+    }
+    assert(Vec_count(v2) == 0);
+    assert(true == Vec_equal(v1, v2, fish_color_comparator)); // Now equal.
+
+    Vec_destroy(&v1);
+    Vec_destroy(&v2);
+}
+
+static void test_equal_empty_same_element_size(void)
+{
+    // Make two empty vectors that take elements of the same size (`Fish`).
+    Vec* v1 = Vec_new(1, sizeof(Fish));
+    Vec* v2 = Vec_new(1, sizeof(Fish));
+
+    assert(v1 != NULL);
+    assert(v2 != NULL);
+
+    /*
+     * The vectors should be empty, and, since both take elements of the same
+     * size, they should be equal (regardless of what comparator is used).
+     */
+    assert(Vec_count(v1) == 0);
+    assert(Vec_count(v2) == Vec_count(v1));
+    assert(true == Vec_equal(v1, v2, NULL));
+    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+
+    // Add an element to one of the vectors.
+    Fish const dory = (Fish)
+    {
+        .color = BLUE,
+        .size = 2
+    };
+
+    assert(true == Vec_append(v1,
+                              &dory,
+                              sizeof(Fish)));
+
+    // The vectors are no longer equal.
+    assert(Vec_count(v1) == 1);
+    assert(Vec_count(v2) != Vec_count(v1));
+    assert(false == Vec_equal(v1, v2, NULL));
+    assert(false == Vec_equal(v1, v2, fish_color_comparator));
+
+    // Remove the element.
+    assert(Vec_get(v1, 0) != NULL);
+    assert(Vec_remove(v1, 0) == 0);
+
+    // Both vectors should be empty and equal again.
+    assert(Vec_count(v1) == 0);
+    assert(Vec_count(v2) == Vec_count(v1));
+    assert(true == Vec_equal(v1, v2, NULL));
+    assert(true == Vec_equal(v1, v2, fish_color_comparator));
+
+    Vec_destroy(&v1);
+    Vec_destroy(&v2);
+}
+
+static void test_equal_empty_diff_element_size(void)
+{
+    // Make two empty vectors that take elements of the different sizes.
+    Vec* v1 = Vec_new(1, sizeof(uint16_t));
+    Vec* v2 = Vec_new(1, sizeof(uint32_t));
+
+    assert(v1 != NULL);
+    assert(v2 != NULL);
+
+    /*
+     * The vectors should be empty, and, since both take elements of different
+     * sizes, they should NOT be equal (regardless of what comparator is used).
+     */
+    assert(Vec_count(v1) == 0);
+    assert(Vec_count(v2) == Vec_count(v1));
+    assert(false == Vec_equal(v1, v2, NULL));
+    assert(false == Vec_equal(v1, v2, fish_color_comparator));
+
+    Vec_destroy(&v1);
+    Vec_destroy(&v2);
+}
+
+static void test_remove_all_invalid(void)
+{
+    Vec* v = Vec_new(10, sizeof(uint8_t));
+
+    assert(v != NULL);
+
+    // Try removing an element not matching the size expected by the vector.
+    assert(0 == Vec_remove_all(v, &(uint8_t){5}, sizeof(uint8_t)));
+    assert(0 == Vec_remove_all(v, &(uint8_t){5}, 0));
+
+    // Try removing with null pointers.
+    assert(0 == Vec_remove_all(NULL, &(uint8_t){5}, sizeof(uint8_t)));
+    assert(0 == Vec_remove_all(v, NULL, sizeof(uint8_t)));
+    assert(0 == Vec_remove_all(NULL, NULL, sizeof(uint8_t)));
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_none(void)
+{
+    /*
+     * Remove an element that doesn't match any element in the vector. So from
+     *
+     * ```
+     * [y][y][y]
+     *  0  1  2
+     * ```
+     *
+     * we'll try removing all instances of `X` (of which there are none).
+     */
+    Vec* v = Vec_new(10, sizeof(int));
+
+    // Removing all from an empty vector is fine but does nothing.
+    assert(v != NULL);
+    assert(0 == Vec_remove_all(v, &(uint8_t){5}, sizeof(uint8_t)));
+    assert(0 == Vec_count(v));
+
+    // So add some positive integers...
+    assert(true == Vec_append(v, &(int){0}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){1}, sizeof(int)));
+    assert(true == Vec_append(v, &(int){2}, sizeof(int)));
+    assert(Vec_count(v) == 3);
+
+    // ...and try to remove all integers that are -2 (when there aren't any).
+    assert(0 == Vec_remove_all(v, &(int){-2}, sizeof(int)));
+    assert(Vec_count(v) == 3); // No elements were removed.
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_one(void)
+{
+    /*
+     * Remove an element that only matches one element in the vector. So from
+     *
+     * ```
+     * [9][8][7][6]
+     *  0  1  2  3
+     * ```
+     *
+     * we'll try removing all instances of `9` (of which there is one, at the
+     * very beginning).
+     */
+    Vec* v = Vec_new(5, sizeof(uint64_t));
+    Vec* expected = NULL;
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(uint64_t){9}, sizeof(uint64_t)));
+    assert(true == Vec_append(v, &(uint64_t){8}, sizeof(uint64_t)));
+    assert(true == Vec_append(v, &(uint64_t){7}, sizeof(uint64_t)));
+    assert(true == Vec_append(v, &(uint64_t){6}, sizeof(uint64_t)));
+    assert(Vec_count(v) == 4);
+
+    // Try to remove all elements that match `9`.
+    assert(1 == Vec_remove_all(v, &(uint64_t){9}, sizeof(uint64_t)));
+    assert(Vec_count(v) == 3); // One element was removed.
+
+    /*
+     * The vector now looks like this:
+     *
+     * ```
+     * [8][7][6][ ]
+     *  0  1  2  3
+     * ```
+     */
+    expected = Vec_new(3, sizeof(uint64_t));
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(uint64_t){8}, sizeof(uint64_t)));
+    assert(true == Vec_append(expected, &(uint64_t){7}, sizeof(uint64_t)));
+    assert(true == Vec_append(expected, &(uint64_t){6}, sizeof(uint64_t)));
+    assert(Vec_count(expected) == 3);
+
+    assert(true == Vec_equal(v, expected, NULL));
+    Vec_destroy(&expected);
+
+    /*
+     * Next, remove one element from the middle, making the vector look like:
+     *
+     * ```
+     * [8][6][ ][ ]
+     *  0  1  2  3
+     * ```
+     */
+    assert(1 == Vec_remove_all(v, &(uint64_t){7}, sizeof(uint64_t)));
+    assert(Vec_count(v) == 2); // One element was removed.
+
+    expected = Vec_new(2, sizeof(uint64_t));
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(uint64_t){8}, sizeof(uint64_t)));
+    assert(true == Vec_append(expected, &(uint64_t){6}, sizeof(uint64_t)));
+    assert(Vec_count(expected) == 2);
+
+    assert(true == Vec_equal(v, expected, NULL));
+    Vec_destroy(&expected);
+
+    /*
+     * Next, remove one element from the end, making the vector look like:
+     *
+     * ```
+     * [8][ ][ ][ ]
+     *  0  1  2  3
+     * ```
+     */
+    assert(1 == Vec_remove_all(v, &(uint64_t){6}, sizeof(uint64_t)));
+    assert(Vec_count(v) == 1); // One element was removed.
+
+    expected = Vec_new(1, sizeof(uint64_t));
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(uint64_t){8}, sizeof(uint64_t)));
+    assert(Vec_count(expected) == 1);
+
+    assert(true == Vec_equal(v, expected, NULL));
+    Vec_destroy(&expected);
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_partial(void)
+{
+    /*
+     * Remove an element that matches several elements in the vector. So from
+     *
+     * ```
+     * [X][X][a][X][X][X][b][X][c][X]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * we'll try removing all instances of `X`.
+     */
+    Vec* v = Vec_new(10, sizeof(uint64_t));
+    uint64_t const a = 1;
+    uint64_t const b = 2;
+    uint64_t const c = 3;
+    uint64_t const X = 4;
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &X, sizeof(X)));
+    assert(true == Vec_append(v, &X, sizeof(X)));
+    assert(true == Vec_append(v, &a, sizeof(a))); // a
+    assert(true == Vec_append(v, &X, sizeof(X)));
+    assert(true == Vec_append(v, &X, sizeof(X)));
+    assert(true == Vec_append(v, &X, sizeof(X)));
+    assert(true == Vec_append(v, &b, sizeof(b))); // b
+    assert(true == Vec_append(v, &X, sizeof(X)));
+    assert(true == Vec_append(v, &c, sizeof(c))); // c
+    assert(true == Vec_append(v, &X, sizeof(X)));
+    assert(Vec_count(v) == 10);
+
+    uint64_t* probe = Vec_get(v, 0);
+
+    assert(probe != NULL);
+    assert(*probe == X);
+
+    // Remove all elements that match `X`.
+    assert(7 == Vec_remove_all(v, probe, sizeof(*probe)));
+    probe = NULL; // Pointer invalidated by the removal
+    assert(Vec_count(v) == 3); // No `X`s remain.
+
+    /*
+     * The vector should now look like this:
+     *
+     * ```
+     * [a][b][c][ ][ ][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    Vec* expected = Vec_new(3, sizeof(uint64_t));
+
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &a, sizeof(a)));
+    assert(true == Vec_append(expected, &b, sizeof(b)));
+    assert(true == Vec_append(expected, &c, sizeof(c)));
+    assert(Vec_count(expected) == 3);
+
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
+
+static void test_remove_all_except_one(void)
+{
+    /*
+     * Remove all elements except one. So from
+     *
+     * ```
+     * [X][X][X][X][a]
+     *  0  1  2  3  4
+     * ```
+     *
+     * we'll try removing all instances of `X`.
+     */
+    Vec* v = Vec_new(5, sizeof(uint64_t));
+    uint64_t const X = 1;
+    uint64_t const a = 2;
+
+    assert(v != NULL);
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(true == Vec_append(v, &X, sizeof(X)));
+    }
+    assert(true == Vec_append(v, &a, sizeof(a)));
+    assert(5 == Vec_count(v));
+
+    // Remove all `X`s.
+    assert(4 == Vec_remove_all(v, &X, sizeof(X)));
+
+    // No `X`s remain, leaving only one element.
+    assert(1 == Vec_count(v));
+
+    uint64_t* probe = (uint64_t*) Vec_get(v, 0);
+
+    assert(probe != NULL);
+    assert(*probe == a);
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_total(void)
+{
+    /*
+     * Remove all elements. So from
+     *
+     * ```
+     * [X][X][X][X][X][X][X][X][X][X]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * we'll try removing all instances of `X` (i.e., all the elements).
+     */
+    Vec* v = Vec_new(10, sizeof(uint64_t));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        assert(true == Vec_append(v, &(uint64_t){6}, sizeof(uint64_t)));
+    }
+    assert(10 == Vec_count(v));
+
+    // Remove all `X`s.
+    assert(10 == Vec_remove_all(v, &(uint64_t){6}, sizeof(uint64_t)));
+
+    // No `X`s remain.
+    assert(0 == Vec_count(v));
+
+    Vec_destroy(&v);
+}
+
+static Vec* remove_all_partial_inner_pointer_input_helper(int64_t const X,
+                                                          int64_t const y)
+{
+    /*
+     * Create the vector
+     *
+     * ```
+     * [X][X][y][X][X][X][y][y][X][X]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * using the given `X` and `y` parameters.
+     */
+    Vec* v = Vec_new(10, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &X, sizeof(X))); // 0
+    assert(true == Vec_append(v, &X, sizeof(X))); // 1
+    assert(true == Vec_append(v, &y, sizeof(y))); // 2
+    assert(true == Vec_append(v, &X, sizeof(X))); // 3
+    assert(true == Vec_append(v, &X, sizeof(X))); // 4
+    assert(true == Vec_append(v, &X, sizeof(X))); // 5
+    assert(true == Vec_append(v, &y, sizeof(y))); // 6
+    assert(true == Vec_append(v, &y, sizeof(y))); // 7
+    assert(true == Vec_append(v, &X, sizeof(X))); // 8
+    assert(true == Vec_append(v, &X, sizeof(X))); // 9
+    assert(10 == Vec_count(v));
+
+    return v;
+}
+
+static Vec* remove_all_partial_inner_pointer_expected_helper(int64_t const y)
+{
+    /*
+     * Create the vector
+     *
+     * ```
+     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * using the given `y` parameter.
+     */
+    Vec* expected = Vec_new(10, sizeof(int64_t));
+
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &y, sizeof(y))); // 0
+    assert(true == Vec_append(expected, &y, sizeof(y))); // 1
+    assert(true == Vec_append(expected, &y, sizeof(y))); // 2
+    assert(3 == Vec_count(expected));
+
+    return expected;
+}
+
+static void test_remove_all_partial_inner_pointer_to_head(void)
+{
+    /*
+     * Remove all instances of `X` using a pointer, `p`, to the first element
+     * inside the vector:
+     *
+     * ```
+     *  p
+     *  v
+     * [X][X][y][X][X][X][y][y][X][X]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    int64_t const X = 6;
+    int64_t const y = 7;
+    Vec* v = remove_all_partial_inner_pointer_input_helper(X, y);
+
+    // Get a pointer to the first element.
+    int64_t* p = (int64_t*) Vec_get(v, 0);
+
+    assert(p != NULL);
+    assert(*p == X);
+    assert(7 == Vec_remove_all(v, p, sizeof(*p)));
+    p = NULL; // Pointer invalidated by the removal
+    assert(3 == Vec_count(v));
+
+    Vec* expected = remove_all_partial_inner_pointer_expected_helper(y);
+
+    /*
+     * With the `X`s removed, the vector should now look like this:
+     *
+     * ```
+     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
+
+static void test_remove_all_partial_inner_pointer_to_middle(void)
+{
+    /*
+     * Remove all instances of `X` using a pointer, `p`, to an element in the
+     * middle of the vector:
+     *
+     * ```
+     *              p
+     *              v
+     * [X][X][y][X][X][X][y][y][X][X]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    int64_t const X = 6;
+    int64_t const y = 7;
+    Vec* v = remove_all_partial_inner_pointer_input_helper(X, y);
+
+    // Get a pointer to a middle element.
+    int64_t* p = (int64_t*) Vec_get(v, 4);
+
+    assert(p != NULL);
+    assert(*p == X);
+    assert(7 == Vec_remove_all(v, p, sizeof(*p)));
+    p = NULL; // Pointer invalidated by the removal
+    assert(3 == Vec_count(v));
+
+    Vec* expected = remove_all_partial_inner_pointer_expected_helper(y);
+
+    /*
+     * With the `X`s removed, the vector should now look like this:
+     *
+     * ```
+     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
+
+static void test_remove_all_partial_inner_pointer_to_tail(void)
+{
+    /*
+     * Remove all instances of `X` using a pointer, `p`, to the last element in
+     * the vector:
+     *
+     * ```
+     *                             p
+     *                             v
+     * [X][X][y][X][X][X][y][y][X][X]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    int64_t const X = 6;
+    int64_t const y = 7;
+    Vec* v = remove_all_partial_inner_pointer_input_helper(X, y);
+
+    // Get a pointer to the last element.
+    int64_t* p = (int64_t*) Vec_get(v, 9);
+
+    assert(p != NULL);
+    assert(*p == X);
+    assert(7 == Vec_remove_all(v, p, sizeof(*p)));
+    p = NULL; // Pointer invalidated by the removal
+    assert(3 == Vec_count(v));
+
+    Vec* expected = remove_all_partial_inner_pointer_expected_helper(y);
+
+    /*
+     * With the `X`s removed, the vector should now look like this:
+     *
+     * ```
+     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     */
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
+
+static Vec* new_full_i64_vec_same_element(size_t const initial_cap_hint,
+                                          int64_t const X)
+{
+    /*
+     * Create the vector
+     *
+     * ```
+     * [X][X][X][X][X][. . .
+     *  0  1  2  3  4. . . .
+     * ```
+     *
+     * full of elements matching the given `X` parameter and of a capacity
+     * greater than or equal to the given capacity hint parameter.
+     */
+    Vec* v = Vec_new(initial_cap_hint, sizeof(int64_t));
+
+    assert(v != NULL);
+
+    // Fill the vector to capacity.
+    size_t const initial_cap = Vec_capacity(v);
+
+    for (size_t i = 0; i < initial_cap; ++i)
+    {
+        Vec_append(v, &X, sizeof(X));
+    }
+    assert(Vec_count(v) == initial_cap); // The vector's full.
+    assert(Vec_capacity(v) == initial_cap); // The vector didn't expand yet.
+
+    // Every element should be equal to `X`.
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        int64_t* probe = NULL;
+
+        probe = (int64_t*) Vec_get(v, i);
+        assert(probe != NULL);
+        assert(*probe == X);
+    }
+
+    return v;
+}
+
+static void test_remove_all_total_inner_pointer_to_head(void)
+{
+    /*
+     * Remove all instances of `X` using a pointer, `p`, to the first element in
+     * a vector full of `X`s:
+     *
+     * ```
+     *  p
+     *  v
+     * [X][X][X][X][X]
+     *  0  1  2  3  4
+     * ```
+     */
+    size_t const cap_hint = 5;
+    int64_t const X = 6;
+    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
+
+    // Get a pointer to the first element.
+    int64_t* p = (int64_t*) Vec_get(v, 0);
+    size_t const count = Vec_count(v);
+
+    assert(p != NULL);
+    assert(*p == X);
+    assert(count == Vec_remove_all(v, p, sizeof(*p)));
+    p = NULL; // Pointer invalidated by the removal
+    assert(0 == Vec_count(v)); // The vector's now empty.
+
+    // The vector should compare equal against an empty vector.
+    Vec* expected = Vec_new(cap_hint, sizeof(int64_t));
+
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
+
+static void test_remove_all_total_inner_pointer_to_middle(void)
+{
+    /*
+     * Remove all instances of `X` using a pointer, `p`, to an element in the
+     * middle of a vector full of `X`s:
+     *
+     * ```
+     *        p
+     *        v
+     * [X][X][X][X][X]
+     *  0  1  2  3  4
+     * ```
+     */
+    size_t const cap_hint = 5;
+    int64_t const X = 6;
+    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
+
+    // Get a pointer to a middle element.
+    int64_t* p = (int64_t*) Vec_get(v, 2);
+    size_t const count = Vec_count(v);
+
+    assert(p != NULL);
+    assert(*p == X);
+    assert(count == Vec_remove_all(v, p, sizeof(*p)));
+    p = NULL; // Pointer invalidated by the removal
+    assert(0 == Vec_count(v)); // The vector's now empty.
+
+    // The vector should compare equal against an empty vector.
+    Vec* expected = Vec_new(cap_hint, sizeof(int64_t));
+
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
+
+static void test_remove_all_total_inner_pointer_to_tail(void)
+{
+    /*
+     * Remove all instances of `X` using a pointer, `p`, to the last element in
+     * a vector full of `X`s:
+     *
+     * ```
+     *              p
+     *              v
+     * [X][X][X][X][X]
+     *  0  1  2  3  4
+     * ```
+     */
+    size_t const cap_hint = 5;
+    int64_t const X = 6;
+    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
+    size_t const count = Vec_count(v);
+
+    // Get a pointer to the last element.
+    int64_t* p = (int64_t*) Vec_get(v, count - 1);
+
+    assert(p != NULL);
+    assert(*p == X);
+    assert(count == Vec_remove_all(v, p, sizeof(*p)));
+    p = NULL; // Pointer invalidated by the removal
+    assert(0 == Vec_count(v)); // The vector's now empty.
+
+    // The vector should compare equal against an empty vector.
+    Vec* expected = Vec_new(cap_hint, sizeof(int64_t));
+
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&v);
+    Vec_destroy(&expected);
+}
+
+/**
+ * @brief A predicate that can be used by a vector's search or removal functions
+ * to target non-negative `int64_t`s
+ * @param element An element provided by the vector when it calls this function
+ * @param element_size The size of the element reported by the vector (usable as
+ * a size-based "type check" to make sure the element looks like an `int64_t`)
+ */
+static bool non_negative(void const* element, size_t const element_size)
+{
+    /*
+     * We know we're supposed to be dealing with `int64_t`s.
+     *
+     * If this gets used by a vector with a different element size, the wrong
+     * element size will be passed in by that vector, allowing us to return
+     * early.
+     */
+    size_t const expected_size = sizeof(int64_t);
+
+    if (NULL == element ||
+        element_size != expected_size)
+    {
+        return false; // Error; return early.
+    }
+
+    int64_t const* i = (int64_t const*) element; // Cast to the known type.
+
+    return *i >= 0;
+}
+
+static void test_remove_all_if_invalid(void)
+{
+    Vec* v = Vec_new(5, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){-42}, sizeof(int64_t)));
+    assert(1 == Vec_count(v));
+
+    // Null pointers should remove no elements.
+    assert(0 == Vec_remove_all_if(v, NULL));
+    assert(0 == Vec_remove_all_if(NULL, non_negative));
+    assert(0 == Vec_remove_all_if(NULL, NULL));
+    assert(1 == Vec_count(v)); // No element was removed.
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_if_none(void)
+{
+    // Make a vector of all negative elements.
+    Vec* v = Vec_new(5, sizeof(int64_t));
+
+    /*
+     * Removing all with a predicate from an empty vector is fine but does nothing.
+     */
+    assert(v != NULL);
+    assert(0 == Vec_remove_all_if(v, non_negative));
+    assert(0 == Vec_count(v));
+
+    assert(true == Vec_append(v, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-2}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-3}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-4}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-5}, sizeof(int64_t)));
+    assert(5 == Vec_count(v));
+
+    // Remove all non-negative elements (of which there are none).
+    assert(0 == Vec_remove_all_if(v, non_negative));
+    assert(5 == Vec_count(v)); // No element was removed.
+
+    // Compare with expected vector.
+    Vec* expected = Vec_new(5, sizeof(int64_t));
+
+    assert(true == Vec_append(expected, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-2}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-3}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-4}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-5}, sizeof(int64_t)));
+    assert(5 == Vec_count(expected));
+
+    assert(Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_if_one(void)
+{
+    // Make a vector with exactly 1 non-negative element.
+    Vec* v = Vec_new(5, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-2}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-3}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-4}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t))); // Non-neg
+    assert(5 == Vec_count(v));
+
+    // Remove all non-negative elements (of which there is exactly one).
+    assert(1 == Vec_remove_all_if(v, non_negative));
+    assert(4 == Vec_count(v)); // One element was removed.
+
+    // Compare with expected vector.
+    Vec* expected = Vec_new(5, sizeof(int64_t));
+
+    assert(true == Vec_append(expected, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-2}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-3}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-4}, sizeof(int64_t)));
+    assert(Vec_count(expected) == Vec_count(v));
+
+    assert(Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_if_some(void)
+{
+    /*
+     * Remove an element that matches several elements in the vector.
+     *
+     * So from
+     *
+     * ```
+     * [X][X][a][X][X][X][b][X][c][X][d][X][X]
+     *  0  1  2  3  4  5  6  7  8  9 10 11 12
+     * ```
+     *
+     * we'll try removing all instances of `X`, leaving 4 elements.
+     */
+    size_t const total = 13;
+    size_t const remaining = 4;
+    Vec* v = Vec_new(total, sizeof(int64_t));
+
+    assert(v != NULL);
+    // The `X` will be any non-negative element.
+    assert(true == Vec_append(v, &(int64_t){100}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){200}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-200}, sizeof(int64_t))); // `a`
+    assert(true == Vec_append(v, &(int64_t){300}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){400}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){500}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-1}, sizeof(int64_t))); // `b`
+    assert(true == Vec_append(v, &(int64_t){600}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-42}, sizeof(int64_t))); // `c`
+    assert(true == Vec_append(v, &(int64_t){700}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-800}, sizeof(int64_t))); // `d`
+    assert(true == Vec_append(v, &(int64_t){800}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){900}, sizeof(int64_t)));
+    assert(total == Vec_count(v));
+
+    // Remove all `X`s.
+    size_t const removed = total - remaining;
+
+    assert(removed == Vec_remove_all_if(v, non_negative));
+    assert(Vec_count(v) == remaining); // Only non-`X`s remain.
+
+    // Compare with expected vector.
+    Vec* expected = Vec_new(total, sizeof(int64_t));
+
+    assert(true == Vec_append(expected, &(int64_t){-200}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-42}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-800}, sizeof(int64_t)));
+    assert(remaining == Vec_count(expected));
+
+    assert(Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_if_all(void)
+{
+    /*
+     * Remove all elements.
+     *
+     * So from
+     *
+     * ```
+     * [X][X][X][X][X][X][X][X][X][X]
+     *  0  1  2  3  4  5  6  7  8  9
+     * ```
+     *
+     * remove all instances of `X` (i.e., all the elements).
+     */
+    size_t const cap_hint = 9000;
+    int64_t const X = 1;
+    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
+
+    assert(v != NULL);
+
+    // Remove all `X`s.
+    size_t const total = Vec_count(v);
+
+    assert(total >= cap_hint);
+    assert(total == Vec_remove_all_if(v, non_negative));
+    assert(0 == Vec_count(v)); // All elements removed
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_all_if_runs(void)
+{
+    /*
+     * Remove elements that are scattered in runs of different lengths, so that
+     * runs of kept elements of different lengths have to be moved.
+     *
+     * Element `i` is removed when `i % 7` is 0, 3, or 4:
+     *
+     * ```
+     * [X][1][2][X][X][5][6][X][8][9][X][X][12][13][X]. . .
+     *  0  1  2  3  4  5  6  7  8  9 10 11  12  13 14
+     * ```
+     */
+    size_t const total = 1000;
+    size_t removed = 0;
+    Vec* v = Vec_new(total, sizeof(int64_t));
+
+    assert(v != NULL);
+    for (int64_t i = 0; (size_t) i < total; ++i)
+    {
+        bool const is_X = (i % 7 == 0) || (i % 7 == 3) || (i % 7 == 4);
+        // The `X`s are non-negative; the elements to keep are negative.
+        int64_t const element = is_X ? i : -i - 1;
+
+        assert(true == Vec_append(v, &element, sizeof(element)));
+        if (is_X)
+        {
+            removed++;
+        }
+    }
+
+    // Remove all `X`s.
+    assert(removed == Vec_remove_all_if(v, non_negative));
+    assert(total - removed == Vec_count(v));
+
+    // The kept elements are all still there, in their original order.
+    int64_t expected = 0;
+
+    for (size_t i = 0; i < Vec_count(v); ++i)
+    {
+        while ((expected % 7 == 0) ||
+               (expected % 7 == 3) ||
+               (expected % 7 == 4))
+        {
+            expected++;
+        }
+
+        int64_t const* probe = (int64_t const*) Vec_get(v, i);
+
+        assert(probe != NULL);
+        assert(*probe == -expected - 1);
+        expected++;
+    }
+
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief An integer comparator usable for sorting elements in ascending order
+ * @param a The first integer
+ * @param b The second integer
+ * @return A positive `int` if the first integer is bigger than the second, a
+ * zero `int` when it's the same size as the second, or a negative `int` when
+ * it's smaller than the second or when either integer pointer is null
+ */
+static int int64_comparator(void const* int64_a, void const* int64_b)
+{
+    if (int64_a == NULL ||
+        int64_b == NULL)
+    {
+        return -1;
+    }
+
+    // We know we're dealing with `int64_t`s; cast to the known type.
+    int64_t const* a = (int64_t const*) int64_a;
+    int64_t const* b = (int64_t const*) int64_b;
+
+    return (int) (*a - *b);
+}
+
+static void test_qsort_invalid(void)
+{
+    size_t const count = 3;
+    Vec* v = Vec_new(count, sizeof(int64_t));
+    Vec* expected = Vec_new(count, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-42}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){0}, sizeof(int64_t)));
+    assert(count == Vec_count(v));
+
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-42}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){0}, sizeof(int64_t)));
+    assert(count == Vec_count(expected));
+
+    // Null pointers should not permit sorting.
+    assert(false == Vec_qsort(v, NULL));
+    assert(false == Vec_qsort(NULL, int64_comparator));
+    assert(false == Vec_qsort(NULL, NULL));
+    // The vector should be unsorted.
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+
+    v = Vec_new(count, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(0 == Vec_count(v));
+
+    // Empty vectors should not permit sorting.
+    assert(false == Vec_qsort(v, int64_comparator));
+
+    Vec_destroy(&v);
+}
+
+static void test_qsort_scalar(void)
+{
+    size_t const count = 5;
+    Vec* v = Vec_new(count, sizeof(int64_t));
+    Vec* expected = Vec_new(count, sizeof(int64_t));
+
+    // Sorting empty vectors is fine but does nothing, always returning `false`.
+    assert(false == Vec_qsort(v, int64_comparator));
+
+    // Add unsorted elements.
+    assert(true == Vec_append(v, &(int64_t){2077}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-666}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){1962}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-5}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){1945}, sizeof(int64_t)));
+    assert(Vec_count(v) == count);
+
+    // Add sorted elements.
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){-666}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){-5}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){1945}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){1962}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){2077}, sizeof(int64_t)));
+    assert(Vec_count(expected) == count);
+
+    assert(false == Vec_equal(v, expected, NULL)); // The elements are unsorted.
+    assert(true == Vec_qsort(v, int64_comparator)); // Sort the elements.
+    assert(true == Vec_equal(v, expected, NULL)); // The elements are sorted.
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief A `Fish` comparator usable for sorting `Fish` by size in ascending
+ * order
+ * @param fish_a The first `Fish`
+ * @param fish_b The second `Fish`
+ * @return A positive `int` if the first `Fish` is bigger than the second, a
+ * zero `int` when it's the same size as the second, or a negative `int` when
+ * it's smaller than the second or when either `Fish` pointer is null
+ */
+static int fish_size_comparator(void const* fish_a, void const* fish_b)
+{
+    if (fish_a == NULL ||
+        fish_b == NULL)
+    {
+        return -1;
+    }
+
+    // We know we're dealing with `Fish`; cast to the known type.
+    Fish const* a = (Fish const*) fish_a;
+    Fish const* b = (Fish const*) fish_b;
+
+    return (int) (a->size - b->size);
+}
+
+static void test_qsort_struct(void)
+{
+    size_t const count = 5;
+    Vec* v = Vec_new(count, sizeof(Fish));
+    Vec* expected = Vec_new(count, sizeof(Fish));
+
+    // Add (size-wise) unsorted elements.
+    assert(v != NULL);
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 6
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 4
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = BLUE,
+                                  .size = 2
+                              },
+                              sizeof(Fish)));
+    assert(Vec_count(v) == count);
+
+    // Add (size-wise) sorted elements.
+    assert(expected != NULL);
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 1
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = BLUE,
+                                  .size = 2
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 4
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 6
+                              },
+                              sizeof(Fish)));
+    assert(Vec_count(expected) == count);
+
+    // The elements are unsorted.
+    assert(false == Vec_equal(v, expected, fish_size_comparator));
+    assert(true == Vec_qsort(v, fish_size_comparator)); // Sort the elements.
+    // The elements are sorted.
+    assert(true == Vec_equal(v, expected, fish_size_comparator));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief Gets the next number from a simple (xorshift) pseudo-random number
+ * generator, so tests get the same "random" numbers on every run
+ * @param state The generator's state, which must start out non-0
+ * @return The next pseudo-random number
+ */
+static uint64_t next_random(uint64_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+/**
+ * @brief A `uint32_t` comparator usable for sorting in ascending order
+ */
+static int uint32_comparator(void const* uint32_a, void const* uint32_b)
+{
+    uint32_t const a = *(uint32_t const*) uint32_a;
+    uint32_t const b = *(uint32_t const*) uint32_b;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief An `int64_t` comparator usable for sorting in ascending order, which
+ * (unlike `int64_comparator()`) can't overflow
+ */
+static int int64_full_comparator(void const* int64_a, void const* int64_b)
+{
+    int64_t const a = *(int64_t const*) int64_a;
+    int64_t const b = *(int64_t const*) int64_b;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief A record with a sort key in the middle, and its original position so
+ * that sorts can be checked for stability
+ */
+typedef struct
+{
+    uint32_t padding;
+    int32_t key;
+    uint64_t index;
+} Record;
+
+/**
+ * @brief A `Record` comparator usable for sorting by key in ascending order
+ */
+static int record_key_comparator(void const* record_a, void const* record_b)
+{
+    Record const* a = (Record const*) record_a;
+    Record const* b = (Record const*) record_b;
+
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+/**
+ * @brief Fills the given vector of `Record`s with the given number of records,
+ * with pseudo-random keys in [-50, 50) (so there are plenty of equal keys)
+ */
+static void fill_records(Vec* v, size_t const count, uint64_t seed)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        Record const record =
+        {
+            .padding = 0xDEADBEEF,
+            .key = (int32_t) (next_random(&seed) % 100) - 50,
+            .index = i
+        };
+
+        assert(true == Vec_append(v, &record, sizeof(record)));
+    }
+}
+
+/**
+ * @brief Checks that the given vector of `Record`s is sorted by key, and that
+ * records with equal keys are in their original order
+ */
+static void assert_records_sorted_stably(Vec const* v, size_t const count)
+{
+    Record const* records = (Record const*) Vec_data(v);
+
+    assert(count == Vec_count(v));
+    for (size_t i = 1; i < count; ++i)
+    {
+        assert(records[i - 1].key <= records[i].key);
+        if (records[i - 1].key == records[i].key)
+        {
+            assert(records[i - 1].index < records[i].index);
+        }
+        assert(0xDEADBEEF == records[i].padding);
+    }
+}
+
+static void test_clone(void)
+{
+    assert(NULL == Vec_clone(NULL));
+
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options =
+    {
+        .allocator = &allocator,
+        .growth = VEC_GROWTH_CHUNK,
+        .growth_chunk = 10
+    };
+    Vec* v = Vec_new_with(20, sizeof(Record), &options);
+
+    assert(v != NULL);
+    fill_records(v, 15, 99);
+    assert(true == Vec_enable_index(v, offsetof(Record, index),
+                                    sizeof(uint64_t)));
+    Vec_set_zeroing(v, false);
+
+    // The copy has the same elements and capacity, from the same allocator.
+    Vec* clone = Vec_clone(v);
+
+    assert(clone != NULL);
+    assert(6 == counts.allocations); // Two structs, blocks, and indices
+    assert(true == Vec_equal(v, clone, NULL));
+    assert(20 == Vec_capacity(clone));
+    assert(Vec_data(v) != Vec_data(clone));
+
+    // It's indexed on the same key, and grows the same way.
+    assert(true == Vec_indexed(clone));
+    assert(7 == Vec_where_key(clone, &(uint64_t){7}, sizeof(uint64_t)));
+    fill_records(clone, 6, 100);
+    assert(30 == Vec_capacity(clone));
+
+    // Changing the copy leaves the original alone.
+    assert(15 == Vec_count(v));
+    assert(21 == Vec_count(clone));
+    Vec_destroy(&clone);
+    assert(3 == counts.allocations);
+
+    // An empty vector copies, too.
+    while (Vec_count(v) > 0)
+    {
+        Vec_remove(v, Vec_count(v) - 1);
+    }
+    clone = Vec_clone(v);
+    assert(clone != NULL);
+    assert(0 == Vec_count(clone));
+    Vec_destroy(&clone);
+    Vec_destroy(&v);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
+
+    // Inline elements are copied out to the heap.
+    VEC_INLINE_STORAGE(storage, 4, sizeof(int64_t));
+
+    v = Vec_new_inline(storage, sizeof(storage), sizeof(int64_t), NULL);
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){3}, sizeof(int64_t)));
+    clone = Vec_clone(v);
+    assert(clone != NULL);
+    assert(true == Vec_equal(v, clone, NULL));
+    Vec_destroy(&v);
+    assert(3 == *(int64_t const*) Vec_get(clone, 0));
+    Vec_destroy(&clone);
+}
+
+static void test_radix_sort_invalid(void)
+{
+    Vec* v = Vec_new(4, sizeof(uint32_t));
+
+    assert(v != NULL);
+
+    // Sorting empty vectors is fine, and does nothing.
+    assert(true == Vec_radix_sort(v, 0, sizeof(uint32_t), false));
+
+    assert(true == Vec_append(v, &(uint32_t){3}, sizeof(uint32_t)));
+    assert(true == Vec_append(v, &(uint32_t){1}, sizeof(uint32_t)));
+    assert(true == Vec_append(v, &(uint32_t){2}, sizeof(uint32_t)));
+
+    // A null pointer
+    assert(false == Vec_radix_sort(NULL, 0, sizeof(uint32_t), false));
+    // Unsupported key sizes
+    assert(false == Vec_radix_sort(v, 0, 0, false));
+    assert(false == Vec_radix_sort(v, 0, 2, false));
+    // Keys that don't fit in the elements
+    assert(false == Vec_radix_sort(v, 0, sizeof(uint64_t), false));
+    assert(false == Vec_radix_sort(v, 1, sizeof(uint32_t), false));
+    assert(false == Vec_radix_sort(v, SIZE_MAX, sizeof(uint32_t), false));
+
+    // The vector should be unsorted.
+    assert(3 == *(uint32_t const*) Vec_get(v, 0));
+    assert(1 == *(uint32_t const*) Vec_get(v, 1));
+    assert(2 == *(uint32_t const*) Vec_get(v, 2));
+
+    Vec_destroy(&v);
+}
+
+static void test_radix_sort(void)
+{
+    size_t const count = 10007;
+    uint64_t seed = 2077;
+
+    // Unsigned 4-byte keys, sorted like `Vec_qsort()` sorts them
+    Vec* v = Vec_new(count, sizeof(uint32_t));
+    Vec* expected = Vec_new(count, sizeof(uint32_t));
+
+    assert(v != NULL);
+    assert(expected != NULL);
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t const u = (uint32_t) next_random(&seed);
+
+        assert(true == Vec_append(v, &u, sizeof(u)));
+        assert(true == Vec_append(expected, &u, sizeof(u)));
+    }
+    assert(true == Vec_qsort(expected, uint32_comparator));
+    assert(true == Vec_radix_sort(v, 0, sizeof(uint32_t), false));
+    assert(true == Vec_equal(v, expected, NULL));
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+
+    // Signed 8-byte keys, with negatives sorted before positives
+    v = Vec_new(count, sizeof(int64_t));
+    expected = Vec_new(count, sizeof(int64_t));
+    assert(v != NULL);
+    assert(expected != NULL);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int64_t const i64 = (int64_t) next_random(&seed);
+
+        assert(true == Vec_append(v, &i64, sizeof(i64)));
+        assert(true == Vec_append(expected, &i64, sizeof(i64)));
+    }
+    assert(true == Vec_append(v, &(int64_t){INT64_MIN}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){INT64_MIN},
+                              sizeof(int64_t)));
+    assert(true == Vec_qsort(expected, int64_full_comparator));
+    assert(true == Vec_radix_sort(v, 0, sizeof(int64_t), true));
+    assert(true == Vec_equal(v, expected, NULL));
+    assert(INT64_MIN == *(int64_t const*) Vec_get(v, 0));
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+
+    // Signed 4-byte keys in the middle of bigger elements, sorted stably
+    v = Vec_new(count, sizeof(Record));
+    assert(v != NULL);
+    fill_records(v, count, seed);
+    assert(true == Vec_radix_sort(v, offsetof(Record, key), sizeof(int32_t),
+                                  true));
+    assert_records_sorted_stably(v, count);
+    Vec_destroy(&v);
+}
+
+static void test_merge_sort_parallel_invalid(void)
+{
+    VecThreads* pool = VecThreads_new(2);
+    Vec* v = Vec_new(4, sizeof(int64_t));
+
+    assert(pool != NULL);
+    assert(v != NULL);
+
+    // Sorting empty vectors is fine, and does nothing.
+    assert(true == Vec_merge_sort_parallel(v, int64_full_comparator, pool));
+
+    assert(true == Vec_append(v, &(int64_t){2}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+
+    // Null pointers
+    assert(false == Vec_merge_sort_parallel(NULL, int64_full_comparator,
+                                            pool));
+    assert(false == Vec_merge_sort_parallel(v, NULL, pool));
+    assert(false == Vec_merge_sort_parallel(v, int64_full_comparator, NULL));
+
+    // The vector should be unsorted.
+    assert(2 == *(int64_t const*) Vec_get(v, 0));
+    assert(1 == *(int64_t const*) Vec_get(v, 1));
+
+    Vec_destroy(&v);
+    VecThreads_destroy(&pool);
+}
+
+static void test_merge_sort_parallel(void)
+{
+    // Counts around the worker count, around the insertion runs, and big ones
+    size_t const counts[] = {1, 2, 3, 5, 17, 100, 1000, 100003};
+    size_t const worker_counts[] = {1, 3, 4};
+
+    for (size_t w = 0; w < sizeof(worker_counts) / sizeof(size_t); ++w)
+    {
+        VecThreads* pool = VecThreads_new(worker_counts[w]);
+
+        assert(pool != NULL);
+        for (size_t c = 0; c < sizeof(counts) / sizeof(size_t); ++c)
+        {
+            Vec* v = Vec_new(counts[c], sizeof(Record));
+
+            assert(v != NULL);
+            fill_records(v, counts[c], 1945 + c);
+            assert(true == Vec_merge_sort_parallel(v,
+                                                   record_key_comparator,
+                                                   pool));
+            assert_records_sorted_stably(v, counts[c]);
+
+            // Sorting sorted elements keeps them as they are.
+            assert(true == Vec_merge_sort_parallel(v,
+                                                   record_key_comparator,
+                                                   pool));
+            assert_records_sorted_stably(v, counts[c]);
+            Vec_destroy(&v);
+        }
+        VecThreads_destroy(&pool);
+    }
+
+    // The scratch space comes from (and goes back to) the vector's allocator.
+    Counts allocations = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &allocations
+    };
+    VecOptions const options = { .allocator = &allocator };
+    VecThreads* pool = VecThreads_new(3);
+    Vec* v = Vec_new_with(1000, sizeof(Record), &options);
+
+    assert(pool != NULL);
+    assert(v != NULL);
+    fill_records(v, 1000, 1966);
+
+    size_t const calls = allocations.calls;
+
+    assert(true == Vec_merge_sort_parallel(v, record_key_comparator, pool));
+    assert_records_sorted_stably(v, 1000);
+    assert(calls + 4 == allocations.calls); // Two blocks, each given back
+    assert(2 == allocations.allocations);
+    Vec_destroy(&v);
+    VecThreads_destroy(&pool);
+}
+
+static void test_typed_sort(void)
+{
+    size_t const count = 5003;
+    uint64_t seed = 1962;
+
+    assert(false == I64Vec_sort(NULL));
+
+    I64Vec* v = I64Vec_new(count);
+    Vec* expected = Vec_new(count, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(expected != NULL);
+
+    // Sorting empty vectors is fine, and does nothing.
+    assert(true == I64Vec_sort(v));
+
+    // Random elements, with a few duplicates
+    for (size_t i = 0; i < count; ++i)
+    {
+        int64_t const i64 = (int64_t) (next_random(&seed) % 4000) - 2000;
+
+        assert(true == I64Vec_append(v, i64));
+        assert(true == Vec_append(expected, &i64, sizeof(i64)));
+    }
+    assert(true == Vec_qsort(expected, int64_full_comparator));
+    assert(true == I64Vec_sort(v));
+    assert(true == Vec_equal(I64Vec_vec(v), expected, NULL));
+
+    // Sorted, reversed, and all-equal elements (the usual quicksort traps)
+    int64_t* elements = (int64_t*) Vec_data(I64Vec_vec(v));
+
+    assert(true == I64Vec_sort(v));
+    assert(true == Vec_equal(I64Vec_vec(v), expected, NULL));
+    for (size_t i = 0; i < count / 2; ++i)
+    {
+        int64_t const temp = elements[i];
+
+        elements[i] = elements[count - 1 - i];
+        elements[count - 1 - i] = temp;
+    }
+    assert(true == I64Vec_sort(v));
+    assert(true == Vec_equal(I64Vec_vec(v), expected, NULL));
+    for (size_t i = 0; i < count; ++i)
+    {
+        elements[i] = 7;
+    }
+    assert(true == I64Vec_sort(v));
+    for (size_t i = 0; i < count; ++i)
+    {
+        assert(7 == elements[i]);
+    }
+
+    // With no depth to spare, the sort falls back to heapsort.
+    for (size_t i = 0; i < count; ++i)
+    {
+        elements[i] = *(int64_t const*) Vec_get(expected, count - 1 - i);
+    }
+    I64Vec_introsort(elements, count, 0);
+    assert(true == Vec_equal(I64Vec_vec(v), expected, NULL));
+
+    Vec_destroy(&expected);
+    I64Vec_destroy(&v);
+}
+
+static void test_bsearch_invalid(void)
+{
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    int64_t const item = 1;
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){3}, sizeof(int64_t)));
+
+    // Null vectors get 0...
+    assert(0 == Vec_lower_bound(NULL, &item, sizeof(item),
+                                int64_full_comparator));
+    assert(0 == Vec_upper_bound(NULL, &item, sizeof(item),
+                                int64_full_comparator));
+    assert(0 == Vec_bsearch(NULL, &item, sizeof(item), int64_full_comparator));
+
+    // ...and other invalid arguments get the count.
+    assert(2 == Vec_lower_bound(v, NULL, sizeof(item), int64_full_comparator));
+    assert(2 == Vec_upper_bound(v, &item, sizeof(int32_t),
+                                int64_full_comparator));
+    assert(2 == Vec_bsearch(v, &item, sizeof(item), NULL));
+
+    // Invalid insertions and merges don't modify the vector.
+    assert(false == Vec_insert_sorted(NULL, &item, sizeof(item),
+                                      int64_full_comparator));
+    assert(false == Vec_insert_sorted(v, NULL, sizeof(item),
+                                      int64_full_comparator));
+    assert(false == Vec_insert_sorted(v, &item, sizeof(int32_t),
+                                      int64_full_comparator));
+    assert(false == Vec_insert_sorted(v, &item, sizeof(item), NULL));
+    assert(false == Vec_merge_sorted(NULL, &item, 1, sizeof(item),
+                                     int64_full_comparator));
+    assert(false == Vec_merge_sorted(v, NULL, 1, sizeof(item),
+                                     int64_full_comparator));
+    assert(false == Vec_merge_sorted(v, &item, 1, sizeof(int32_t),
+                                     int64_full_comparator));
+    assert(false == Vec_merge_sorted(v, &item, 1, sizeof(item), NULL));
+    assert(false == Vec_merge_sorted(v, &item, SIZE_MAX, sizeof(item),
+                                     int64_full_comparator));
+    assert(2 == Vec_count(v));
+
+    // Merging nothing is fine, and does nothing.
+    assert(true == Vec_merge_sorted(v, &item, 0, sizeof(item),
+                                    int64_full_comparator));
+    assert(2 == Vec_count(v));
+
+    Vec_destroy(&v);
+}
+
+static void test_bsearch(void)
+{
+    Vec* v = Vec_new(16, sizeof(int64_t));
+
+    assert(v != NULL);
+
+    // An empty vector has every bound at 0, and nothing to find.
+    assert(0 == Vec_lower_bound(v, &(int64_t){1}, sizeof(int64_t),
+                                int64_full_comparator));
+    assert(0 == Vec_upper_bound(v, &(int64_t){1}, sizeof(int64_t),
+                                int64_full_comparator));
+    assert(0 == Vec_bsearch(v, &(int64_t){1}, sizeof(int64_t),
+                            int64_full_comparator));
+
+    // 0, 10, 10, 10, 20, 30, ..., 90
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        assert(true == Vec_append(v, &(int64_t){i * 10}, sizeof(int64_t)));
+    }
+    assert(true == Vec_insert(v, 1, &(int64_t){10}, sizeof(int64_t)));
+    assert(true == Vec_insert(v, 1, &(int64_t){10}, sizeof(int64_t)));
+    assert(12 == Vec_count(v));
+
+    // Present elements, with duplicates spanning from the lower bound...
+    assert(1 == Vec_lower_bound(v, &(int64_t){10}, sizeof(int64_t),
+                                int64_full_comparator));
+    assert(4 == Vec_upper_bound(v, &(int64_t){10}, sizeof(int64_t),
+                                int64_full_comparator));
+    assert(1 == Vec_bsearch(v, &(int64_t){10}, sizeof(int64_t),
+                            int64_full_comparator));
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        size_t const index = Vec_bsearch(v,
+                                         &(int64_t){i * 10},
+                                         sizeof(int64_t),
+                                         int64_full_comparator);
+
+        assert(index == Vec_where(v, &(int64_t){i * 10}, sizeof(int64_t)));
+    }
+
+    // ...and absent ones, in between, before, and after the elements.
+    assert(5 == Vec_lower_bound(v, &(int64_t){25}, sizeof(int64_t),
+                                int64_full_comparator));
+    assert(5 == Vec_upper_bound(v, &(int64_t){25}, sizeof(int64_t),
+                                int64_full_comparator));
+    assert(12 == Vec_bsearch(v, &(int64_t){25}, sizeof(int64_t),
+                             int64_full_comparator));
+    assert(0 == Vec_lower_bound(v, &(int64_t){-1}, sizeof(int64_t),
+                                int64_full_comparator));
+    assert(12 == Vec_bsearch(v, &(int64_t){-1}, sizeof(int64_t),
+                             int64_full_comparator));
+    assert(12 == Vec_lower_bound(v, &(int64_t){91}, sizeof(int64_t),
+                                 int64_full_comparator));
+    assert(12 == Vec_upper_bound(v, &(int64_t){90}, sizeof(int64_t),
+                                 int64_full_comparator));
+    assert(12 == Vec_bsearch(v, &(int64_t){91}, sizeof(int64_t),
+                             int64_full_comparator));
+
+    Vec_destroy(&v);
+}
+
+static void test_insert_sorted(void)
+{
+    size_t const count = 1000;
+    uint64_t seed = 1066;
+    Vec* v = Vec_new(1, sizeof(Record));
+
+    assert(v != NULL);
+
+    // Records inserted in random order end up sorted, in insertion order.
+    for (size_t i = 0; i < count; ++i)
+    {
+        Record const record =
+        {
+            .padding = 0xDEADBEEF,
+            .key = (int32_t) (next_random(&seed) % 100) - 50,
+            .index = i
+        };
+
+        assert(true == Vec_insert_sorted(v,
+                                         &record,
+                                         sizeof(record),
+                                         record_key_comparator));
+    }
+    assert_records_sorted_stably(v, count);
+
+    // An item inside the vector itself can be inserted, too.
+    Record const* first = (Record const*) Vec_get(v, 0);
+    Record const expected = *first;
+
+    assert(true == Vec_insert_sorted(v,
+                                     first,
+                                     sizeof(Record),
+                                     record_key_comparator));
+    assert(count + 1 == Vec_count(v));
+
+    size_t const last_equal = Vec_upper_bound(v,
+                                              &expected,
+                                              sizeof(Record),
+                                              record_key_comparator) - 1;
+    Record const* inserted = (Record const*) Vec_get(v, last_equal);
+
+    assert(expected.key == inserted->key);
+    assert(expected.index == inserted->index);
+
+    Vec_destroy(&v);
+}
+
+static void test_merge_sorted(void)
+{
+    // Merges into empty, small, and big vectors, of small and big batches
+    size_t const element_counts[] = {0, 1, 7, 5000};
+    size_t const item_counts[] = {1, 3, 4000};
+
+    for (size_t e = 0; e < sizeof(element_counts) / sizeof(size_t); ++e)
+    {
+        for (size_t i = 0; i < sizeof(item_counts) / sizeof(size_t); ++i)
+        {
+            size_t const element_count = element_counts[e];
+            size_t const item_count = item_counts[i];
+            Vec* v = Vec_new(1, sizeof(Record));
+            Vec* items = Vec_new(item_count, sizeof(Record));
+
+            assert(v != NULL);
+            assert(items != NULL);
+            fill_records(v, element_count, 1337 + e);
+            assert(true == Vec_radix_sort(v,
+                                          offsetof(Record, key),
+                                          sizeof(int32_t),
+                                          true));
+
+            // The items' indices come after the elements', for stability.
+            fill_records(items, item_count, 7331 + i);
+            for (size_t j = 0; j < item_count; ++j)
+            {
+                ((Record*) Vec_get(items, j))->index += element_count;
+            }
+            assert(true == Vec_radix_sort(items,
+                                          offsetof(Record, key),
+                                          sizeof(int32_t),
+                                          true));
+
+            assert(true == Vec_merge_sorted(v,
+                                            Vec_data(items),
+                                            item_count,
+                                            sizeof(Record),
+                                            record_key_comparator));
+            assert_records_sorted_stably(v, element_count + item_count);
+
+            Vec_destroy(&items);
+            Vec_destroy(&v);
+        }
+    }
+
+    // Items all before, or all after, the elements
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    int64_t const before[] = {-3, -2, -1};
+    int64_t const after[] = {10, 11};
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){0}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
+    assert(true == Vec_merge_sorted(v, after, 2, sizeof(int64_t),
+                                    int64_full_comparator));
+    assert(true == Vec_merge_sorted(v, before, 3, sizeof(int64_t),
+                                    int64_full_comparator));
+    assert(7 == Vec_count(v));
+
+    int64_t const expected[] = {-3, -2, -1, 0, 5, 10, 11};
+
+    assert(0 == memcmp(Vec_data(v), expected, sizeof(expected)));
+
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief A `size_t` comparator usable for sorting indices in ascending order
+ */
+static int size_comparator(void const* size_a, void const* size_b)
+{
+    size_t const a = *(size_t const*) size_a;
+    size_t const b = *(size_t const*) size_b;
+
+    return (a > b) - (a < b);
+}
+
+static void test_insert_many_invalid(void)
+{
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    int64_t const items[] = {10, 20};
+    size_t const indices[] = {0, 1};
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+
+    // Null pointers and mismatched sizes
+    assert(false == Vec_insert_many(NULL, indices, items, 2, sizeof(int64_t)));
+    assert(false == Vec_insert_many(v, NULL, items, 2, sizeof(int64_t)));
+    assert(false == Vec_insert_many(v, indices, NULL, 2, sizeof(int64_t)));
+    assert(false == Vec_insert_many(v, indices, items, 2, sizeof(int32_t)));
+
+    // Out-of-bounds and unsorted indices
+    assert(false == Vec_insert_many(v, (size_t[]){0, 2}, items, 2,
+                                    sizeof(int64_t)));
+    assert(false == Vec_insert_many(v, (size_t[]){1, 0}, items, 2,
+                                    sizeof(int64_t)));
+
+    // Too many items
+    assert(false == Vec_insert_many(v, indices, items, SIZE_MAX,
+                                    sizeof(int64_t)));
+
+    // Nothing was inserted.
+    assert(1 == Vec_count(v));
+
+    // Inserting nothing is fine, and does nothing.
+    assert(true == Vec_insert_many(v, indices, items, 0, sizeof(int64_t)));
+    assert(1 == Vec_count(v));
+
+    Vec_destroy(&v);
+}
+
+static void test_insert_many(void)
+{
+    // [a][b][c][d] with x and y at 1 and 3 is [a][x][b][c][y][d].
+    Vec* v = Vec_new(4, sizeof(char));
+
+    assert(v != NULL);
+    assert(true == Vec_append_n(v, "abcd", 4, sizeof(char)));
+    assert(true == Vec_insert_many(v, (size_t[]){1, 3}, "xy", 2,
+                                   sizeof(char)));
+    assert(0 == memcmp(Vec_data(v), "axbcyd", 6));
+
+    // Items at the same index, at the head, and at the end, in their order
+    assert(true == Vec_insert_many(v, (size_t[]){0, 0, 6, 6}, "1234", 4,
+                                   sizeof(char)));
+    assert(0 == memcmp(Vec_data(v), "12axbcyd34", 10));
+    Vec_destroy(&v);
+
+    // Lots of scattered insertions, matching one-by-one insertions
+    uint64_t seed = 31337;
+    size_t const count = 5000;
+    size_t const k = 1500;
+    Vec* batched = Vec_new(1, sizeof(int64_t));
+    Vec* expected = Vec_new(1, sizeof(int64_t));
+    size_t indices[1500];
+    int64_t items[1500];
+
+    assert(batched != NULL);
+    assert(expected != NULL);
+    for (int64_t i = 0; (size_t) i < count; ++i)
+    {
+        assert(true == Vec_append(batched, &i, sizeof(i)));
+        assert(true == Vec_append(expected, &i, sizeof(i)));
+    }
+    for (size_t j = 0; j < k; ++j)
+    {
+        indices[j] = (size_t) (next_random(&seed) % (count + 1));
+        items[j] = -(int64_t) j - 1;
+    }
+    qsort(indices, k, sizeof(size_t), size_comparator);
+
+    // (Each item lands after the items inserted before it.)
+    for (size_t j = 0; j < k; ++j)
+    {
+        assert(true == Vec_insert(expected, indices[j] + j, &items[j],
+                                  sizeof(int64_t)));
+    }
+    assert(true == Vec_insert_many(batched, indices, items, k,
+                                   sizeof(int64_t)));
+    assert(true == Vec_equal(batched, expected, NULL));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&batched);
+}
+
+static void test_remove_indices_invalid(void)
+{
+    Vec* v = Vec_new(4, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){2}, sizeof(int64_t)));
+
+    // Null pointers
+    assert(0 == Vec_remove_indices(NULL, (size_t[]){0}, 1));
+    assert(0 == Vec_remove_indices(v, NULL, 1));
+
+    // Out-of-bounds and unsorted indices
+    assert(0 == Vec_remove_indices(v, (size_t[]){0, 2}, 2));
+    assert(0 == Vec_remove_indices(v, (size_t[]){1, 0}, 2));
+
+    // Removing nothing
+    assert(0 == Vec_remove_indices(v, (size_t[]){0}, 0));
+
+    // Nothing was removed.
+    assert(2 == Vec_count(v));
+
+    Vec_destroy(&v);
+}
+
+static void test_remove_indices(void)
+{
+    // Duplicate indices remove their element once.
+    Vec* v = Vec_new(8, sizeof(char));
+
+    assert(v != NULL);
+    assert(true == Vec_append_n(v, "abcdefgh", 8, sizeof(char)));
+    assert(4 == Vec_remove_indices(v, (size_t[]){0, 2, 2, 3, 7}, 5));
+    assert(0 == memcmp(Vec_data(v), "befg", 4));
+
+    // Removed elements' bytes are zeroed out.
+    assert(0 == *((char const*) Vec_data(v) + 4));
+    assert(0 == *((char const*) Vec_data(v) + 7));
+
+    // Removing every element empties the vector.
+    assert(4 == Vec_remove_indices(v, (size_t[]){0, 1, 2, 3}, 4));
+    assert(0 == Vec_count(v));
+    Vec_destroy(&v);
+
+    // Lots of scattered removals, matching one-by-one removals
+    uint64_t seed = 4242;
+    size_t const count = 5000;
+    size_t const k = 1500;
+    Vec* batched = Vec_new(1, sizeof(int64_t));
+    Vec* expected = Vec_new(1, sizeof(int64_t));
+    size_t indices[1500];
+
+    assert(batched != NULL);
+    assert(expected != NULL);
+    for (int64_t i = 0; (size_t) i < count; ++i)
+    {
+        assert(true == Vec_append(batched, &i, sizeof(i)));
+        assert(true == Vec_append(expected, &i, sizeof(i)));
+    }
+    for (size_t j = 0; j < k; ++j)
+    {
+        indices[j] = (size_t) (next_random(&seed) % count);
+    }
+    qsort(indices, k, sizeof(size_t), size_comparator);
+
+    // (From the highest index down, skipping duplicates)
+    size_t removed = 0;
+
+    for (size_t j = k; j > 0; --j)
+    {
+        if (j == k || indices[j - 1] != indices[j])
+        {
+            Vec_remove(expected, indices[j - 1]);
+            removed += 1;
+        }
+    }
+    assert(removed == Vec_remove_indices(batched, indices, k));
+    assert(true == Vec_equal(batched, expected, NULL));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&batched);
+}
+
+static void test_unique_invalid(void)
+{
+    assert(0 == Vec_unique(NULL, NULL));
+    assert(0 == Vec_unique(NULL, int64_comparator));
+    assert(0 == Vec_dedup_hashed(NULL));
+
+    // Vectors of fewer than 2 elements have no duplicates.
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    int64_t const item = 5;
+
+    assert(v != NULL);
+    assert(0 == Vec_unique(v, NULL));
+    assert(0 == Vec_dedup_hashed(v));
+    assert(true == Vec_append(v, &item, sizeof(item)));
+    assert(0 == Vec_unique(v, int64_comparator));
+    assert(0 == Vec_dedup_hashed(v));
+    assert(1 == Vec_count(v));
+    Vec_destroy(&v);
+}
+
+static void test_unique(void)
+{
+    int64_t const items[] = { 3, 1, 3, 3, 2, 1, 7, 7, 7, 2, 9, 3 };
+    size_t const n = sizeof(items) / sizeof(items[0]);
+    Vec* v = Vec_new(n, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append_n(v, items, n, sizeof(int64_t)));
+
+    // Only adjacent duplicates go, without sorting first.
+    Vec* adjacent = Vec_clone(v);
+    int64_t const expected_adjacent[] = { 3, 1, 3, 2, 1, 7, 2, 9, 3 };
+
+    assert(adjacent != NULL);
+    assert(3 == Vec_unique(adjacent, NULL));
+    assert(9 == Vec_count(adjacent));
+    assert(0 == memcmp(Vec_data(adjacent), expected_adjacent,
+                       sizeof(expected_adjacent)));
+    Vec_destroy(&adjacent);
+
+    // After sorting, one of each is left, in order.
+    Vec* sorted = Vec_clone(v);
+    int64_t const expected_sorted[] = { 1, 2, 3, 7, 9 };
+
+    assert(sorted != NULL);
+    assert(true == Vec_qsort(sorted, int64_comparator));
+    assert(7 == Vec_unique(sorted, int64_comparator));
+    assert(0 == memcmp(Vec_data(sorted), expected_sorted,
+                       sizeof(expected_sorted)));
+    assert(0 == Vec_unique(sorted, NULL));
+
+    // Hashed deduplication keeps the first of each, in the original order.
+    int64_t const expected_first[] = { 3, 1, 2, 7, 9 };
+
+    assert(7 == Vec_dedup_hashed(v));
+    assert(5 == Vec_count(v));
+    assert(0 == memcmp(Vec_data(v), expected_first, sizeof(expected_first)));
+    assert(0 == Vec_dedup_hashed(v));
+    Vec_destroy(&v);
+    Vec_destroy(&sorted);
+
+    // Many elements, each repeated, dedup to one of each (and keep an index).
+    size_t const count = 10000;
+
+    v = Vec_new(16, sizeof(int64_t));
+    assert(v != NULL);
+    assert(true == Vec_enable_index(v, 0, sizeof(int64_t)));
+    for (size_t i = 0; i < 3 * count; ++i)
+    {
+        int64_t const item = (int64_t) ((i * 7919) % count);
+
+        assert(true == Vec_append(v, &item, sizeof(item)));
+    }
+    assert(2 * count == Vec_dedup_hashed(v));
+    assert(count == Vec_count(v));
+    for (size_t i = 0; i < count; ++i)
+    {
+        int64_t const item = (int64_t) ((i * 7919) % count);
+
+        assert(item == *(int64_t const*) Vec_get(v, i));
+        assert(i == Vec_where(v, &item, sizeof(item)));
+    }
+    Vec_destroy(&v);
+}
+
+static void test_push_pop_invalid(void)
+{
+    Vec* v = Vec_new(2, sizeof(int64_t));
+    int64_t item = 0;
+
+    assert(v != NULL);
+    assert(false == Vec_push_front(NULL, &item, sizeof(item)));
+    assert(false == Vec_push_front(v, NULL, sizeof(item)));
+    assert(false == Vec_push_front(v, &(int32_t){1}, sizeof(int32_t)));
+    assert(false == Vec_pop_front(NULL, &item, sizeof(item)));
+    assert(false == Vec_pop_front(v, &item, sizeof(item))); // Empty
+    assert(false == Vec_pop_back(NULL, &item, sizeof(item)));
+    assert(false == Vec_pop_back(v, &item, sizeof(item))); // Empty
+    assert(true == Vec_append(v, &item, sizeof(item)));
+    assert(false == Vec_pop_front(v, &item, sizeof(int32_t)));
+    assert(false == Vec_pop_back(v, &item, sizeof(int32_t)));
+    assert(1 == Vec_count(v));
+
+    // Bounded vectors don't go past their limit in the middle, either.
+    VecOptions const options = { .max_count = 2 };
+    Vec* bounded = Vec_new_with(2, sizeof(int64_t), &options);
+    int64_t const items[2] = { 1, 2 };
+
+    assert(bounded != NULL);
+    assert(false == Vec_append_n(bounded, items, 3, sizeof(int64_t)));
+    assert(true == Vec_append_n(bounded, items, 2, sizeof(int64_t)));
+    assert(false == Vec_insert(bounded, 1, &item, sizeof(item)));
+    assert(false == Vec_extend(bounded, v));
+    assert(false == Vec_insert_sorted(bounded,
+                                      &item,
+                                      sizeof(item),
+                                      int64_comparator));
+    assert(2 == Vec_count(bounded));
+    assert(true == Vec_pop_back(bounded, NULL, 0));
+    assert(true == Vec_insert(bounded, 0, &item, sizeof(item)));
+    assert(0 == *(int64_t const*) Vec_get(bounded, 0));
+
+    Vec_destroy(&bounded);
+    Vec_destroy(&v);
+}
+
+static void test_push_pop(void)
+{
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    int64_t item = 0;
+
+    assert(v != NULL);
+    for (int64_t i = 0; i < 8; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+
+    // Popping the front moves nothing, so pointers to elements stay valid.
+    int64_t const* five = Vec_get(v, 5);
+
+    for (int64_t i = 0; i < 3; ++i)
+    {
+        assert(true == Vec_pop_front(v, &item, sizeof(item)));
+        assert(i == item);
+    }
+    assert(5 == Vec_count(v));
+    assert(five == Vec_get(v, 2));
+    assert(3 == *(int64_t const*) Vec_get(v, 0));
+    assert(3 == *(int64_t const*) Vec_data(v));
+
+    // The popped elements' bytes are zeroed out.
+    int64_t ghost = 1;
+
+    memcpy(&ghost, (uint8_t const*) Vec_data(v) - sizeof(ghost), sizeof(ghost));
+    assert(0 == ghost);
+
+    // Pushing onto the front reuses the freed room, without moving anything.
+    assert(true == Vec_push_front(v, &(int64_t){-1}, sizeof(int64_t)));
+    assert(five == Vec_get(v, 3));
+    assert(-1 == *(int64_t const*) Vec_get(v, 0));
+    assert(3 == *(int64_t const*) Vec_get(v, 1));
+
+    // Past that, the elements are moved up once to make room for more.
+    for (int64_t i = 2; i <= 100; ++i)
+    {
+        assert(true == Vec_push_front(v, &(int64_t){-i}, sizeof(int64_t)));
+    }
+    assert(105 == Vec_count(v));
+    for (size_t i = 0; i < 100; ++i)
+    {
+        assert(-(int64_t) (100 - i) == *(int64_t const*) Vec_get(v, i));
+    }
+    assert(3 == *(int64_t const*) Vec_get(v, 100));
+    assert(7 == *(int64_t const*) Vec_get(v, 104));
+
+    // Popping the back
+    assert(true == Vec_pop_back(v, &item, sizeof(item)));
+    assert(7 == item);
+    assert(true == Vec_pop_back(v, NULL, 0));
+    assert(103 == Vec_count(v));
+    assert(5 == *(int64_t const*) Vec_get(v, 102));
+
+    // Everything else works as usual on the elements.
+    void* begin = NULL;
+    void* end = NULL;
+
+    assert(true == Vec_span(v, &begin, &end));
+    assert(begin == Vec_data(v));
+    assert(103 == ((int64_t*) end - (int64_t*) begin));
+    assert(99 == Vec_where(v, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_qsort(v, int64_comparator));
+    assert(-100 == *(int64_t const*) Vec_get(v, 0));
+    assert(5 == *(int64_t const*) Vec_get(v, 102));
+
+    // Emptying the vector gives back all the room freed at the front.
+    size_t capacity = Vec_capacity(v);
+
+    assert(true == Vec_pop_front(v, NULL, 0));
+    assert(capacity - 1 == Vec_capacity(v));
+    while (Vec_count(v) > 0)
+    {
+        assert(true == Vec_pop_front(v, NULL, 0));
+    }
+    assert(Vec_capacity(v) >= capacity);
+    capacity = Vec_capacity(v);
+
+    // As a FIFO queue, the vector reuses its room instead of growing.
+    for (int64_t i = 0; i < 10000; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+        if (i >= 5)
+        {
+            assert(true == Vec_pop_front(v, &item, sizeof(item)));
+            assert(i - 5 == item);
+        }
+    }
+    assert(5 == Vec_count(v));
+    assert(Vec_capacity(v) <= capacity);
+
+    // Resizing, shrinking, and releasing put the elements back at the start.
+    assert(true == Vec_pop_front(v, &item, sizeof(item)));
+    assert(true == Vec_shrink_to_fit(v));
+    assert(4 == Vec_capacity(v));
+    assert(9996 == *(int64_t const*) Vec_get(v, 0));
+    assert(true == Vec_pop_front(v, NULL, 0));
+
+    size_t count = 0;
+    int64_t* block = Vec_release(&v, &count);
+
+    assert(block != NULL);
+    assert(3 == count);
+    assert(9997 == block[0]);
+    assert(9999 == block[2]);
+    free(block);
+
+    // Indexed vectors keep their index in step.
+    Vec* indexed = Vec_new(4, sizeof(int64_t));
+
+    assert(indexed != NULL);
+    assert(true == Vec_enable_index(indexed, 0, sizeof(int64_t)));
+    for (int64_t i = 0; i < 20; ++i)
+    {
+        assert(true == Vec_append(indexed, &i, sizeof(i)));
+    }
+    assert(true == Vec_pop_front(indexed, NULL, 0));
+    assert(true == Vec_push_front(indexed, &(int64_t){42}, sizeof(int64_t)));
+    assert(true == Vec_push_front(indexed, &(int64_t){43}, sizeof(int64_t)));
+    assert(0 == Vec_where_key(indexed, &(int64_t){43}, sizeof(int64_t)));
+    assert(1 == Vec_where_key(indexed, &(int64_t){42}, sizeof(int64_t)));
+    assert(20 == Vec_where_key(indexed, &(int64_t){19}, sizeof(int64_t)));
+    assert(21 == Vec_where_key(indexed, &(int64_t){0}, sizeof(int64_t)));
+    assert(true == Vec_pop_back(indexed, NULL, 0));
+    assert(20 == Vec_where_key(indexed, &(int64_t){19}, sizeof(int64_t)));
+    Vec_destroy(&indexed);
+
+    // Typed vectors have them, too.
+    I64Vec* typed = I64Vec_new(2);
+
+    assert(typed != NULL);
+    assert(true == I64Vec_append(typed, 2));
+    assert(true == I64Vec_push_front(typed, 1));
+    assert(true == I64Vec_append(typed, 3));
+    assert(true == I64Vec_pop_front(typed, &item));
+    assert(1 == item);
+    assert(true == I64Vec_pop_back(typed, &item));
+    assert(3 == item);
+    assert(2 == *I64Vec_get(typed, 0));
+    assert(true == I64Vec_pop_back(typed, NULL));
+    assert(false == I64Vec_pop_front(typed, NULL));
+    I64Vec_destroy(&typed);
+}
+
+static void test_bounded(void)
+{
+    VecOptions const options = { .max_count = 4 };
+    Vec* v = Vec_new_with(2, sizeof(int64_t), &options);
+
+    // A full bounded vector drops its oldest element for each new one.
+    assert(v != NULL);
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+        assert(Vec_count(v) <= 4);
+    }
+    assert(4 == Vec_count(v));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        assert((int64_t) (6 + i) == *(int64_t const*) Vec_get(v, i));
+    }
+
+    // Pushing onto the front drops the newest element instead.
+    assert(true == Vec_push_front(v, &(int64_t){5}, sizeof(int64_t)));
+    assert(4 == Vec_count(v));
+    assert(5 == *(int64_t const*) Vec_get(v, 0));
+    assert(8 == *(int64_t const*) Vec_get(v, 3));
+
+    // Typed appends respect the bound, too, as do clones.
+    I64Vec* typed = I64Vec_from_vec(v);
+
+    assert(typed != NULL);
+    assert(true == I64Vec_append(typed, 9));
+    assert(4 == I64Vec_count(typed));
+    assert(6 == *I64Vec_get(typed, 0));
+
+    Vec* clone = Vec_clone(v);
+
+    assert(clone != NULL);
+    assert(true == Vec_append(clone, &(int64_t){10}, sizeof(int64_t)));
+    assert(4 == Vec_count(clone));
+    assert(7 == *(int64_t const*) Vec_get(clone, 0));
+    Vec_destroy(&clone);
+
+    // The room freed by dropped elements is reused, so the vector stays small.
+    for (int64_t i = 10; i < 10000; ++i)
+    {
+        assert(true == I64Vec_append(typed, i));
+    }
+    assert(4 == Vec_count(v));
+    assert(9996 == *(int64_t const*) Vec_get(v, 0));
+    assert(9999 == *(int64_t const*) Vec_get(v, 3));
+    assert(Vec_capacity(v) <= 16);
+    Vec_destroy(&v);
+
+    // A bounded vector with no spare room gets room for twice its limit (just
+    // once), so it only moves its elements once per limit's worth of drops.
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const fixed = { .max_count = 8, .allocator = &allocator };
+
+    v = Vec_new_with(8, sizeof(int64_t), &fixed);
+    assert(v != NULL);
+    assert(true == Vec_enable_index(v, 0, sizeof(int64_t)));
+    for (int64_t i = 0; i < 8; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+
+    size_t const calls = counts.calls;
+    size_t moves = 0;
+
+    for (int64_t i = 8; i < 100; ++i)
+    {
+        int64_t const* before = (int64_t const*) Vec_data(v);
+
+        assert(true == Vec_append(v, &i, sizeof(i)));
+        assert(8 == Vec_count(v));
+        assert(i - 7 == *(int64_t const*) Vec_get(v, 0));
+        assert(7 == Vec_where_key(v, &i, sizeof(i)));
+        moves += ((int64_t const*) Vec_data(v) != before + 1);
+    }
+    // (The block's one reallocation, and the index's one rebuild, since an
+    // appended item is in it for a moment before the first element's dropped)
+    assert(calls + 3 == counts.calls);
+    assert(moves <= 92 / 8 + 1);
+    moves = 0;
+    for (int64_t i = 91; i > 0; --i)
+    {
+        int64_t const* before = (int64_t const*) Vec_data(v);
+
+        assert(true == Vec_push_front(v, &i, sizeof(i)));
+        assert(8 == Vec_count(v));
+        assert(i + 7 == *(int64_t const*) Vec_get(v, 7));
+        assert(0 == Vec_where_key(v, &i, sizeof(i)));
+        moves += ((int64_t const*) Vec_data(v) != before - 1);
+    }
+    assert(moves <= 91 / 8 + 1);
+
+    // (Even an item from the vector itself is copied before it's dropped.)
+    assert(true == Vec_append(v, Vec_get(v, 0), sizeof(int64_t)));
+    assert(1 == *(int64_t const*) Vec_get(v, 7));
+    assert(calls + 3 == counts.calls);
+
+    // Shrinking keeps the room for twice the limit.
+    assert(true == Vec_shrink_to_fit(v));
+    assert(16 == Vec_capacity(v));
+    assert(calls + 3 == counts.calls);
+
+    Vec_destroy(&v);
+    assert(0 == counts.allocations);
+}
+
+#define UNUSED(x) (void)(x)
+
+/**
+ * @brief Increments the given element by one
+ * @param element A pointer to an `int64_t`
+ * @param element_size For size-based type checking
+ * @param state An unused pointer
+ * @return 1 if there was an input problem; 0 otherwise
+ */
+static int add_one(void* element, size_t const element_size, void* state)
+{
+    UNUSED(state);
+    if (element == NULL ||
+        sizeof(int64_t) != element_size) // Explicit size check
+    {
+        return 1; // Input error
+    }
+
+    int64_t* i = (int64_t*) element;
+
+    *i += 1;
+
+    return 0;
+}
+
+static void test_apply_invalid(void)
+{
+    Vec* v = Vec_new(5, sizeof(int));
+
+    assert(v != NULL);
+
+    // Null pointers should cause the function to fail...
+    int const failure_flag = 1;
+
+    assert(failure_flag == Vec_apply(v, NULL, NULL));
+    assert(failure_flag == Vec_apply(NULL, add_one, NULL));
+    assert(failure_flag == Vec_apply(NULL, NULL, NULL));
+    // ...regardless of the caller state pointer supplied.
+    assert(failure_flag == Vec_apply(v, NULL, &v));
+    assert(failure_flag == Vec_apply(NULL, add_one, &v));
+    assert(failure_flag == Vec_apply(NULL, NULL, &v));
+
+    Vec_destroy(&v);
+}
+
+static void test_apply_modify_scalar(void)
+{
+    // Make a vector with some scalar elements.
+    size_t const count = 5;
+    Vec* v = Vec_new(count, sizeof(int64_t));
+
+    /*
+     * Applying something on an empty vector is fine but does nothing, returning
+     * `1`.
+     */
+    assert(v != NULL);
+    assert(1 == Vec_apply(v, add_one, NULL));
+    assert(0 == Vec_count(v));
+
+    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){9}, sizeof(int64_t)));
+    assert(count == Vec_count(v));
+
+    // Increment all elements by one.
+    int const success_flag = 0;
+
+    assert(success_flag == Vec_apply(v, add_one, NULL));
+
+    // Make a vector with the same scalar elements incremented by one.
+    Vec* expected = Vec_new(count, sizeof(int64_t));
+
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){10}, sizeof(int64_t)));
+    assert(count == Vec_count(expected));
+
+    // The vectors should match.
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&expected);
+
+    /*
+     * If we increment by one three more times (regardless of caller state
+     * pointer supplied)...
+     */
+    assert(success_flag == Vec_apply(v, add_one, NULL));
+    assert(success_flag == Vec_apply(v, add_one, &expected));
+    assert(success_flag == Vec_apply(v, add_one, &(int){666}));
+
+    /*
+     * ...the vector should match one with the original elements incremented by
+     * four.
+     */
+    expected = Vec_new(count, sizeof(int64_t));
+
+    assert(expected != NULL);
+    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){10}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){11}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){12}, sizeof(int64_t)));
+    assert(true == Vec_append(expected, &(int64_t){13}, sizeof(int64_t)));
+    assert(count == Vec_count(expected));
+
+    assert(true == Vec_equal(v, expected, NULL));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief Increases the size of the given `Fish` if it's a green one
+ * @param element A `Fish`
+ * @param element_size For size-based type checking
+ * @param state An unused pointer
+ * @return 1 if there was an input problem; 0 otherwise
+ */
+static int grow_green_fish(void* element,
+                           size_t const element_size,
+                           void* state)
+{
+    UNUSED(state);
+    if (element == NULL ||
+        sizeof(Fish) != element_size) // Explicit size check
+    {
+        return 1; // Input error
+    }
+
+    Fish* fish = (Fish*) element;
+
+    if (fish->color == GREEN)
+    {
+        fish->size += 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief A `Fish` comparator to be used by a vector's equality function that
+ * considers all the members of a `Fish`
+ * @param fish_a A `Fish`
+ * @param fish_b Another `Fish`
+ * @return 1 if there was an input problem; 0 if the given `Fish` have the same
+ * members; 2 if their members differ
+ */
+static int fish_precise_comparator(void const* fish_a, void const* fish_b)
+{
+    if (fish_a == NULL ||
+        fish_b == NULL)
+    {
+        return 1;
+    }
+
+    // We know we're dealing with `Fish`; cast to the known type.
+    Fish const* a = (Fish const*) fish_a;
+    Fish const* b = (Fish const*) fish_b;
+
+    if ((a->color == b->color) &&
+        (a->size == b->size))
+    {
+        return 0;
+    }
+
+    return 2;
+}
+
+static void test_apply_modify_struct(void)
+{
+    // Make a vector of `Fish`.
+    size_t const count = 5;
+    Vec* v = Vec_new(count, sizeof(Fish));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 6
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 3
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = BLUE,
+                                  .size = 4
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 10
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(v,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 41
+                              },
+                              sizeof(Fish)));
+    assert(count == Vec_count(v));
+
+    // Increment the size of all the green `Fish` by one.
+    int const success_flag = 0;
+
+    assert(success_flag == Vec_apply(v, grow_green_fish, NULL));
+
+    /*
+     * Make a vector of the same `Fish`, with the size of the green ones
+     * incremented by one.
+     */
+    Vec* expected = Vec_new(count, sizeof(Fish));
+
+    assert(expected != NULL);
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 7
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 3
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = BLUE,
+                                  .size = 4
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 11
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 42
+                              },
+                              sizeof(Fish)));
+    assert(count == Vec_count(expected));
+
+    // The vectors should match.
+    assert(true == Vec_equal(v, expected, fish_precise_comparator));
+
+    Vec_destroy(&expected);
+
+    /*
+     * If we increment by one three more times (regardless of caller state
+     * pointer supplied)...
+     */
+    assert(success_flag == Vec_apply(v, grow_green_fish, NULL));
+    assert(success_flag == Vec_apply(v, grow_green_fish, &expected));
+    assert(success_flag == Vec_apply(v, grow_green_fish, &(int){666}));
+
+    /*
+     * ...the vector should match one with the original elements incremented by
+     * four.
+     */
+    expected = Vec_new(count, sizeof(Fish));
+
+    assert(expected != NULL);
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 10
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = RED,
+                                  .size = 3
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = BLUE,
+                                  .size = 4
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 14
+                              },
+                              sizeof(Fish)));
+    assert(true == Vec_append(expected,
+                              &(Fish)
+                              {
+                                  .color = GREEN,
+                                  .size = 45
+                              },
+                              sizeof(Fish)));
+    assert(count == Vec_count(expected));
+
+    assert(true == Vec_equal(v, expected, fish_precise_comparator));
+
+    Vec_destroy(&expected);
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief Records the largest element seen so far
+ * @param element An `int64_t`
+ * @param element_size For size-based type checking
+ * @param state Used to update the largest element seen so far
+ * @return 1 if there was an input problem; 0 otherwise
+ */
+static int store_max(void* element, size_t const element_size, void* state)
+{
+    if (element == NULL ||
+        state == NULL ||
+        sizeof(int64_t) != element_size) // Explicit size check
+    {
+        return 1; // Input error
+    }
+
+    int64_t const* i = (int64_t const*) element;
+    int64_t* curr_max = (int64_t*) state;
+
+    if (*i > *curr_max)
+    {
+        *curr_max = *i; // Update largest element so far
+    }
+
+    return 0;
+}
+
+static void test_apply_state_scalar(void)
+{
+    // Make a vector with one maximum element.
+    int64_t const max_actual = 43;
+    Vec* v = Vec_new(10, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-4}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){42}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &max_actual, sizeof(int64_t))); // Max
+    assert(true == Vec_append(v, &(int64_t){0}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){-777}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){39}, sizeof(int64_t)));
+    assert(true == Vec_append(v, &(int64_t){4}, sizeof(int64_t)));
+    assert(10 == Vec_count(v));
+
+    // Find the maximum value in the vector.
+    int64_t min = INT64_MIN;
+    int64_t* max = &min; // Initialize to the smallest value to find max
+    int const success = 0; // Processed all elements
+
+    assert(success == Vec_apply(v, store_max, max));
+    assert(*max == max_actual); // The max value should have been found.
+
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief Records the number of green `Fish` seen so far
+ * @param element A `Fish`
+ * @param element_size For size-based type checking
+ * @param state Used to update the number of green `Fish` seen so far
+ * @return 1 if there was an input problem; 0 otherwise
+ */
+static int count_green_fish(void* element,
+                            size_t const element_size,
+                            void* state)
+{
+    if (element == NULL ||
+        state == NULL ||
+        sizeof(Fish) != element_size) // Explicit size check
+    {
+        return 1; // Input error
+    }
+
+    Fish const* f = (Fish const*) element;
+    size_t* green_fish_count = (size_t*) state;
+
+    if (f->color == GREEN)
+    {
+        *green_fish_count += 1;
+    }
+
+    return 0;
+}
+
+static void test_apply_state_struct(void)
+{
+    // Make a vector with some green `Fish`.
+    size_t greens_added = 0;
+    size_t const total = 100;
+    Vec* v = Vec_new(10, sizeof(Fish)); // Smaller than `total` for resizing
+
+    assert(v != NULL);
+    // Just for fun, let's have a random number of green ones.
+    srand(time(NULL));
+    for (size_t i = 0; i < total; ++i)
+    {
+        int const die = rand() % COLOR_NUM;
+
+        switch(die)
+        {
+            case 0: // Red
+                assert(true == Vec_append(v,
+                                          &(Fish)
+                                          {
+                                              .color = RED,
+                                              .size = 1
+                                          },
+                                          sizeof(Fish)));
+                break;
+            case 1: // Green
+                assert(true == Vec_append(v,
+                                          &(Fish)
+                                          {
+                                              .color = GREEN,
+                                              .size = 1
+                                          },
+                                          sizeof(Fish)));
+                greens_added++; // Note that we added a green.
+                break;
+            default: // Blue
+                assert(true == Vec_append(v,
+                                          &(Fish)
+                                          {
+                                              .color = BLUE,
+                                              .size = 1
+                                          },
+                                          sizeof(Fish)));
+        }
+    }
+
+    size_t greens_counted = 0;
+    size_t* greens_counted_ptr = &greens_counted;
+    int const success = 0; // Processed all elements
+
+    assert(success == Vec_apply(v, count_green_fish, greens_counted_ptr));
+    assert(*greens_counted_ptr == greens_added); // The count is correct
+
+    Vec_destroy(&v);
+}
+
+/**
+ * @brief Counts the number of blue `Fish` seen so far, requesting termination
+ * when seeing a red or a green `Fish`
+ * @param element A `Fish`
+ * @param element_size For size-based type checking
+ * @param state Used to update the number of blue `Fish` seen so far
+ * @return 1 if there was an input problem; 0 if a blue `Fish` was seen and
+ * counting should proceed; 2 if a red `Fish` was seen and counting should stop;
+ * 3 if a green `Fish` was seen and counting should stop
+ */
+static int count_to_red_and_green_fish(void* element,
+                                       size_t const element_size,
+                                       void* state)
+{
+    if (element == NULL ||
+        state == NULL ||
+        sizeof(Fish) != element_size)
+    {
+        return 1; // Input error
+    }
+
+    Fish const* f = (Fish const*) element;
+    size_t* non_red_count = (size_t*) state;
+
+    if (f->color == RED)
+    {
+        return 2; // Red `Fish` seen; stop the count.
+    }
+    else if (f->color == GREEN)
+    {
+        return 3; // Green `Fish` seen; stop the count.
+    }
+    else
+    {
+        // Non-red `Fish` seen; update the count and proceed.
+        *non_red_count += 1;
+
+        return 0;
+    }
+}
+
+static void test_apply_early_return_head(void)
+{
+    // Make a vector with a stop-worthy element at the beginning.
+    Fish const stop = (Fish)
+    {
+        .color = RED,
+        .size = 1
+    };
+    Fish const go = (Fish)
+    {
+        .color = BLUE,
+        .size = 1
+    };
+    int const stop_error = 2;
+    size_t const count = 7;
+    Vec* v = Vec_new(count, sizeof(Fish));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(count == Vec_count(v));
+
+    /*
+     * We should iterate the correct number of times before hitting the
+     * stop-worthy element.
+     */
+    size_t const iterations_expected = 0;
+    size_t iterations = 0;
+    size_t* p = &iterations;
+
+    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
+    assert(*p == iterations_expected);
+
+    Vec_destroy(&v);
+}
+
+static void test_apply_early_return_middle(void)
+{
+    // Make a vector with a stop-worthy element at the middle.
+    Fish const stop = (Fish)
+    {
+        .color = RED,
+        .size = 1
+    };
+    Fish const go = (Fish)
+    {
+        .color = BLUE,
+        .size = 1
+    };
+    int const stop_error = 2;
+    size_t const count = 7;
+    Vec* v = Vec_new(count, sizeof(Fish));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(count == Vec_count(v));
+
+    /*
+     * We should iterate the correct number of times before hitting the
+     * stop-worthy element.
+     */
+    size_t const iterations_expected = 3;
+    size_t iterations = 0;
+    size_t* p = &iterations;
+
+    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
+    assert(*p == iterations_expected);
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_remove_all_partial_inner_pointer_to_middle(void)
+static void test_apply_early_return_tail(void)
 {
-    /*
-     * Remove all instances of `X` using a pointer, `p`, to an element in the
-     * middle of the vector:
-     *
-     * ```
-     *              p
-     *              v
-     * [X][X][y][X][X][X][y][y][X][X]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     */
-    int64_t const X = 6;
-    int64_t const y = 7;
-    Vec* v = remove_all_partial_inner_pointer_input_helper(X, y);
-
-    // Get a pointer to a middle element.
-    int64_t* p = (int64_t*) Vec_get(v, 4);
-
-    assert(p != NULL);
-    assert(*p == X);
-    assert(7 == Vec_remove_all(v, p, sizeof(*p)));
-    p = NULL; // Pointer invalidated by the removal
-    assert(3 == Vec_count(v));
+    // Make a vector with a stop-worthy element at the end.
+    Fish const stop = (Fish)
+    {
+        .color = RED,
+        .size = 1
+    };
+    Fish const go = (Fish)
+    {
+        .color = BLUE,
+        .size = 1
+    };
+    int const stop_error = 2;
+    size_t const count = 7;
+    Vec* v = Vec_new(count, sizeof(Fish));
 
-    Vec* expected = remove_all_partial_inner_pointer_expected_helper(y);
+    assert(v != NULL);
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
+    assert(count == Vec_count(v));
 
     /*
-     * With the `X`s removed, the vector should now look like this:
-     *
-     * ```
-     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
+     * We should iterate the correct number of times before hitting the
+     * stop-worthy element.
      */
-    assert(true == Vec_equal(v, expected, NULL));
+    size_t const iterations_expected = 6;
+    size_t iterations = 0;
+    size_t* p = &iterations;
+
+    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
+    assert(*p == iterations_expected);
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static void test_remove_all_partial_inner_pointer_to_tail(void)
+static void test_apply_early_return_different_error_codes(void)
 {
+    // Make a vector with a stop-worthy element somewhere.
+    Fish const stop = (Fish)
+    {
+        .color = RED,
+        .size = 1
+    };
+    Fish const stop_different = (Fish)
+    {
+        .color = GREEN,
+        .size = 1
+    };
+    Fish const go = (Fish)
+    {
+        .color = BLUE,
+        .size = 1
+    };
+    int const stop_error = 2;
+    int const stop_different_error = 3;
+    size_t const count = 7;
+    Vec* v = Vec_new(count, sizeof(Fish));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
+    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Unreachable
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Unreachable
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Unreachable
+    assert(count == Vec_count(v));
+
     /*
-     * Remove all instances of `X` using a pointer, `p`, to the last element in
-     * the vector:
-     *
-     * ```
-     *                             p
-     *                             v
-     * [X][X][y][X][X][X][y][y][X][X]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
+     * We should iterate the correct number of times before hitting the
+     * stop-worthy element, and we should get the correct error code (that of
+     * the FIRST kind of stop-worthy element).
      */
-    int64_t const X = 6;
-    int64_t const y = 7;
-    Vec* v = remove_all_partial_inner_pointer_input_helper(X, y);
+    size_t iterations_expected = 1;
+    size_t iterations = 0;
+    size_t* p = &iterations;
 
-    // Get a pointer to the last element.
-    int64_t* p = (int64_t*) Vec_get(v, 9);
+    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
+    assert(*p == iterations_expected);
 
-    assert(p != NULL);
-    assert(*p == X);
-    assert(7 == Vec_remove_all(v, p, sizeof(*p)));
-    p = NULL; // Pointer invalidated by the removal
-    assert(3 == Vec_count(v));
+    Vec_destroy(&v);
 
-    Vec* expected = remove_all_partial_inner_pointer_expected_helper(y);
+    // Then make a vector with a different stop-worthy element somewhere.
+    v = Vec_new(count, sizeof(Fish));
+
+    assert(v != NULL);
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Stop here
+    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Unreachable
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Unreachable
+    assert(true == Vec_append(v, &go, sizeof(Fish)));
+    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Unreachable
+    assert(count == Vec_count(v));
 
     /*
-     * With the `X`s removed, the vector should now look like this:
-     *
-     * ```
-     * [y][y][y][ ][ ][ ][ ][ ][ ][ ]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
+     * We should iterate the correct number of times before hitting the
+     * stop-worthy element, and we should get the correct error code (that of
+     * the SECOND kind of stop-worthy element).
      */
-    assert(true == Vec_equal(v, expected, NULL));
+    iterations_expected = 1;
+    iterations = 0;
+    p = &iterations;
+
+    assert(stop_different_error == Vec_apply(v,
+                                             count_to_red_and_green_fish,
+                                             p));
+    assert(*p == iterations_expected);
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
 }
 
-static Vec* new_full_i64_vec_same_element(size_t const initial_cap_hint,
-                                          int64_t const X)
+/**
+ * @brief The state of `sum_keys()`
+ */
+typedef struct
 {
-    /*
-     * Create the vector
-     *
-     * ```
-     * [X][X][X][X][X][. . .
-     *  0  1  2  3  4. . . .
-     * ```
-     *
-     * full of elements matching the given `X` parameter and of a capacity
-     * greater than or equal to the given capacity hint parameter.
-     */
-    Vec* v = Vec_new(initial_cap_hint, sizeof(int64_t));
-
-    assert(v != NULL);
-
-    // Fill the vector to capacity.
-    size_t const initial_cap = Vec_capacity(v);
+    int64_t sum; // The keys added up so far
+    bool stop_at_negative; // Whether to stop at the first negative key
+} KeySum;
 
-    for (size_t i = 0; i < initial_cap; ++i)
+/**
+ * @brief Adds up the keys of `Record`s, stopping at the first negative one if
+ * told to
+ * @param element A `Record`
+ * @param element_size For size-based type checking
+ * @param state A `KeySum` to update
+ * @return 1 if there was an input problem; 2 if stopped; 0 otherwise
+ */
+static int sum_keys(void const* element,
+                    size_t const element_size,
+                    void* state)
+{
+    if (element == NULL ||
+        state == NULL ||
+        sizeof(Record) != element_size) // Explicit size check
     {
-        Vec_append(v, &X, sizeof(X));
+        return 1; // Input error
     }
-    assert(Vec_count(v) == initial_cap); // The vector's full.
-    assert(Vec_capacity(v) == initial_cap); // The vector didn't expand yet.
 
-    // Every element should be equal to `X`.
-    for (size_t i = 0; i < Vec_count(v); ++i)
-    {
-        int64_t* probe = NULL;
+    Record const* r = (Record const*) element;
+    KeySum* key_sum = (KeySum*) state;
 
-        probe = (int64_t*) Vec_get(v, i);
-        assert(probe != NULL);
-        assert(*probe == X);
+    if (key_sum->stop_at_negative &&
+        r->key < 0)
+    {
+        return 2;
     }
+    key_sum->sum += r->key;
 
-    return v;
+    return 0;
 }
 
-static void test_remove_all_total_inner_pointer_to_head(void)
+static void test_apply_const(void)
 {
-    /*
-     * Remove all instances of `X` using a pointer, `p`, to the first element in
-     * a vector full of `X`s:
-     *
-     * ```
-     *  p
-     *  v
-     * [X][X][X][X][X]
-     *  0  1  2  3  4
-     * ```
-     */
-    size_t const cap_hint = 5;
-    int64_t const X = 6;
-    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
-
-    // Get a pointer to the first element.
-    int64_t* p = (int64_t*) Vec_get(v, 0);
-    size_t const count = Vec_count(v);
-
-    assert(p != NULL);
-    assert(*p == X);
-    assert(count == Vec_remove_all(v, p, sizeof(*p)));
-    p = NULL; // Pointer invalidated by the removal
-    assert(0 == Vec_count(v)); // The vector's now empty.
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    size_t const count = 1000;
+    Vec* v = Vec_new_with(1, sizeof(Record), &options);
 
-    // The vector should compare equal against an empty vector.
-    Vec* expected = Vec_new(cap_hint, sizeof(int64_t));
+    assert(v != NULL);
+    fill_records(v, count, 7);
+    assert(true == Vec_enable_index(v, offsetof(Record, key), sizeof(int32_t)));
+    assert(true == Vec_enable_hash(v));
 
-    assert(true == Vec_equal(v, expected, NULL));
+    // Null pointers cause it to fail, as does an empty vector.
+    KeySum key_sum = {0};
 
-    Vec_destroy(&v);
-    Vec_destroy(&expected);
-}
+    assert(1 == Vec_apply_const(NULL, sum_keys, &key_sum));
+    assert(1 == Vec_apply_const(v, NULL, &key_sum));
 
-static void test_remove_all_total_inner_pointer_to_middle(void)
-{
-    /*
-     * Remove all instances of `X` using a pointer, `p`, to an element in the
-     * middle of a vector full of `X`s:
-     *
-     * ```
-     *        p
-     *        v
-     * [X][X][X][X][X]
-     *  0  1  2  3  4
-     * ```
-     */
-    size_t const cap_hint = 5;
-    int64_t const X = 6;
-    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
+    Vec* empty = Vec_new(1, sizeof(Record));
 
-    // Get a pointer to a middle element.
-    int64_t* p = (int64_t*) Vec_get(v, 2);
-    size_t const count = Vec_count(v);
+    assert(empty != NULL);
+    assert(1 == Vec_apply_const(empty, sum_keys, &key_sum));
+    Vec_destroy(&empty);
 
-    assert(p != NULL);
-    assert(*p == X);
-    assert(count == Vec_remove_all(v, p, sizeof(*p)));
-    p = NULL; // Pointer invalidated by the removal
-    assert(0 == Vec_count(v)); // The vector's now empty.
+    // The function sees every element, without the index or hash rebuilt.
+    int64_t expected = 0;
+    int64_t expected_before_negative = 0;
+    size_t first_negative = count;
 
-    // The vector should compare equal against an empty vector.
-    Vec* expected = Vec_new(cap_hint, sizeof(int64_t));
+    for (size_t i = 0; i < count; ++i)
+    {
+        int32_t const key = ((Record const*) Vec_get(v, i))->key;
 
-    assert(true == Vec_equal(v, expected, NULL));
+        if (key < 0 &&
+            first_negative == count)
+        {
+            first_negative = i;
+            expected_before_negative = expected;
+        }
+        expected += key;
+    }
+
+    size_t const calls = counts.calls;
+    uint64_t const hash = Vec_hash(v);
+
+    assert(0 == Vec_apply_const(v, sum_keys, &key_sum));
+    assert(expected == key_sum.sum);
+    assert(calls == counts.calls);
+    assert(hash == Vec_hash(v));
+
+    // Early returns are relayed.
+    assert(first_negative < count);
+    key_sum = (KeySum) { .stop_at_negative = true };
+    assert(2 == Vec_apply_const(v, sum_keys, &key_sum));
+    assert(expected_before_negative == key_sum.sum);
+    assert(calls == counts.calls);
 
     Vec_destroy(&v);
-    Vec_destroy(&expected);
+    assert(0 == counts.allocations);
 }
 
-static void test_remove_all_total_inner_pointer_to_tail(void)
+/**
+ * @brief A thread pool task that counts how many times each task ran, and
+ * checks its worker index
+ */
+static void count_task(void* context,
+                       size_t const task_index,
+                       size_t const worker_index)
 {
-    /*
-     * Remove all instances of `X` using a pointer, `p`, to the last element in
-     * a vector full of `X`s:
-     *
-     * ```
-     *              p
-     *              v
-     * [X][X][X][X][X]
-     *  0  1  2  3  4
-     * ```
-     */
-    size_t const cap_hint = 5;
-    int64_t const X = 6;
-    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
-    size_t const count = Vec_count(v);
+    size_t* runs = (size_t*) context;
 
-    // Get a pointer to the last element.
-    int64_t* p = (int64_t*) Vec_get(v, count - 1);
+    assert(worker_index < 4);
+    runs[task_index] += 1; // Each task has its own slot, so no race
+}
 
-    assert(p != NULL);
-    assert(*p == X);
-    assert(count == Vec_remove_all(v, p, sizeof(*p)));
-    p = NULL; // Pointer invalidated by the removal
-    assert(0 == Vec_count(v)); // The vector's now empty.
+static void test_threads(void)
+{
+    // Invalid pool
+    assert(NULL == VecThreads_new(0));
+    assert(0 == VecThreads_count(NULL));
+    assert(false == VecThreads_for(NULL, 1, count_task, NULL));
+    VecThreads_destroy(NULL);
 
-    // The vector should compare equal against an empty vector.
-    Vec* expected = Vec_new(cap_hint, sizeof(int64_t));
+    VecThreads* pool = VecThreads_new(4);
 
-    assert(true == Vec_equal(v, expected, NULL));
+    assert(pool != NULL);
+    assert(4 == VecThreads_count(pool));
+    assert(false == VecThreads_for(pool, 1, NULL, NULL));
 
-    Vec_destroy(&v);
-    Vec_destroy(&expected);
+    // No tasks is fine.
+    assert(true == VecThreads_for(pool, 0, count_task, NULL));
+
+    // Every task runs exactly once per job, job after job.
+    size_t runs[1000] = {0};
+
+    for (size_t job = 1; job <= 20; ++job)
+    {
+        assert(true == VecThreads_for(pool, job * 50, count_task, runs));
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            // Task `i` is in every job so far with more than `i` tasks.
+            size_t const expected = (job > i / 50) ? job - (i / 50) : 0;
+
+            assert(runs[i] == expected);
+        }
+    }
+
+    VecThreads_destroy(&pool);
+    assert(pool == NULL);
+
+    // A single-worker pool runs its jobs on the calling thread.
+    size_t single[10] = {0};
+
+    pool = VecThreads_new(1);
+    assert(pool != NULL);
+    assert(true == VecThreads_for(pool, 10, count_task, single));
+    for (size_t i = 0; i < 10; ++i)
+    {
+        assert(1 == single[i]);
+    }
+    VecThreads_destroy(&pool);
 }
 
 /**
- * @brief A predicate that can be used by a vector's search or removal functions
- * to target non-negative `int64_t`s
- * @param element An element provided by the vector when it calls this function
- * @param element_size The size of the element reported by the vector (usable as
- * a size-based "type check" to make sure the element looks like an `int64_t`)
+ * @brief Negates the given `int64_t` and adds it to the given per-worker sum
  */
-static bool non_negative(void const* element, size_t const element_size)
+static int negate_and_sum(void* element, size_t const element_size, void* state)
 {
-    /*
-     * We know we're supposed to be dealing with `int64_t`s.
-     *
-     * If this gets used by a vector with a different element size, the wrong
-     * element size will be passed in by that vector, allowing us to return
-     * early.
-     */
-    size_t const expected_size = sizeof(int64_t);
+    if (element == NULL ||
+        element_size != sizeof(int64_t))
+    {
+        return 1;
+    }
 
-    if (NULL == element ||
-        element_size != expected_size)
+    int64_t* i = (int64_t*) element;
+
+    *i = -*i;
+    if (state != NULL)
     {
-        return false; // Error; return early.
+        *(int64_t*) state += *i;
     }
 
-    int64_t const* i = (int64_t const*) element; // Cast to the known type.
+    return 0;
+}
 
-    return *i >= 0;
+/**
+ * @brief Stops at any `int64_t` that's a multiple of 1000 (except 0), with the
+ * element's value as the stop value
+ */
+static int stop_at_thousands(void* element,
+                             size_t const element_size,
+                             void* state)
+{
+    (void) state;
+    if (element == NULL ||
+        element_size != sizeof(int64_t))
+    {
+        return 1;
+    }
+
+    int64_t const i = *(int64_t const*) element;
+
+    return (i != 0 && i % 1000 == 0) ? (int) (i / 1000) : 0;
 }
 
-static void test_remove_all_if_invalid(void)
+static void test_apply_parallel_invalid(void)
 {
-    Vec* v = Vec_new(5, sizeof(int64_t));
+    VecThreads* pool = VecThreads_new(2);
+    Vec* v = Vec_new(4, sizeof(int64_t));
 
+    assert(pool != NULL);
     assert(v != NULL);
-    assert(true == Vec_append(v, &(int64_t){-42}, sizeof(int64_t)));
-    assert(1 == Vec_count(v));
 
-    // Null pointers should remove no elements.
-    assert(0 == Vec_remove_all_if(v, NULL));
-    assert(0 == Vec_remove_all_if(NULL, non_negative));
-    assert(0 == Vec_remove_all_if(NULL, NULL));
-    assert(1 == Vec_count(v)); // No element was removed.
+    // An empty vector
+    assert(1 == Vec_apply_parallel(v, negate_and_sum, NULL, 0, pool));
+
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+
+    // Null pointers
+    assert(1 == Vec_apply_parallel(NULL, negate_and_sum, NULL, 0, pool));
+    assert(1 == Vec_apply_parallel(v, NULL, NULL, 0, pool));
+    assert(1 == Vec_apply_parallel(v, negate_and_sum, NULL, 0, NULL));
+
+    // Nothing was applied.
+    assert(0 == Vec_where(v, &(int64_t){1}, sizeof(int64_t)));
 
     Vec_destroy(&v);
+    VecThreads_destroy(&pool);
 }
 
-static void test_remove_all_if_none(void)
+static void test_apply_parallel(void)
 {
-    // Make a vector of all negative elements.
-    Vec* v = Vec_new(5, sizeof(int64_t));
+    size_t const worker_count = 4;
+    size_t const n = 100003; // Not a multiple of anything in particular
+    VecThreads* pool = VecThreads_new(worker_count);
+    Vec* v = Vec_new(n, sizeof(int64_t));
 
-    /*
-     * Removing all with a predicate from an empty vector is fine but does nothing.
-     */
+    assert(pool != NULL);
     assert(v != NULL);
-    assert(0 == Vec_remove_all_if(v, non_negative));
-    assert(0 == Vec_count(v));
+    for (int64_t i = 0; (size_t) i < n; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
 
-    assert(true == Vec_append(v, &(int64_t){-1}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-2}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-3}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-4}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-5}, sizeof(int64_t)));
-    assert(5 == Vec_count(v));
+    // Each worker sums into its own state.
+    int64_t sums[4] = {0};
 
-    // Remove all non-negative elements (of which there are none).
-    assert(0 == Vec_remove_all_if(v, non_negative));
-    assert(5 == Vec_count(v)); // No element was removed.
+    assert(0 == Vec_apply_parallel(v,
+                                   negate_and_sum,
+                                   sums,
+                                   sizeof(sums[0]),
+                                   pool));
 
-    // Compare with expected vector.
-    Vec* expected = Vec_new(5, sizeof(int64_t));
+    // Every element was negated exactly once...
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert(*(int64_t const*) Vec_get(v, i) == -(int64_t) i);
+    }
 
-    assert(true == Vec_append(expected, &(int64_t){-1}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-2}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-3}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-4}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-5}, sizeof(int64_t)));
-    assert(5 == Vec_count(expected));
+    // ...and the per-worker sums add up.
+    int64_t const expected = -(int64_t) ((n - 1) * n / 2);
 
-    assert(Vec_equal(v, expected, NULL));
+    assert(sums[0] + sums[1] + sums[2] + sums[3] == expected);
+
+    // Without states, the function gets null state pointers.
+    assert(0 == Vec_apply_parallel(v, negate_and_sum, NULL, 0, pool));
+    assert(12345 == *(int64_t const*) Vec_get(v, 12345));
+
+    // Tiny vectors work, too.
+    Vec* tiny = Vec_new(1, sizeof(int64_t));
+
+    assert(tiny != NULL);
+    assert(true == Vec_append(tiny, &(int64_t){7}, sizeof(int64_t)));
+    assert(0 == Vec_apply_parallel(tiny, negate_and_sum, NULL, 0, pool));
+    assert(-7 == *(int64_t const*) Vec_get(tiny, 0));
+    Vec_destroy(&tiny);
+
+    /*
+     * Stopping early returns the value for the lowest-index stop, like
+     * `Vec_apply()`, no matter which worker got there first.
+     */
+    for (int round = 0; round < 10; ++round)
+    {
+        assert(1 == Vec_apply_parallel(v, stop_at_thousands, NULL, 0, pool));
+        assert(1 == Vec_apply(v, stop_at_thousands, NULL));
+    }
+
+    // With the first stops removed, the next one's value is returned.
+    *(int64_t*) Vec_get(v, 1000) = 1;
+    *(int64_t*) Vec_get(v, 2000) = 2;
+    assert(3 == Vec_apply_parallel(v, stop_at_thousands, NULL, 0, pool));
 
-    Vec_destroy(&expected);
     Vec_destroy(&v);
+    VecThreads_destroy(&pool);
 }
 
-static void test_remove_all_if_one(void)
+/**
+ * @brief Checks that searching the given indexed vector finds every item where
+ * searching the given unindexed vector (with the same elements) does
+ */
+static void assert_index_agrees(Vec const* indexed, Vec const* plain)
 {
-    // Make a vector with exactly 1 non-negative element.
-    Vec* v = Vec_new(5, sizeof(int64_t));
-
-    assert(v != NULL);
-    assert(true == Vec_append(v, &(int64_t){-1}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-2}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-3}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-4}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t))); // Non-neg
-    assert(5 == Vec_count(v));
-
-    // Remove all non-negative elements (of which there is exactly one).
-    assert(1 == Vec_remove_all_if(v, non_negative));
-    assert(4 == Vec_count(v)); // One element was removed.
+    assert(true == Vec_indexed(indexed));
+    assert(false == Vec_indexed(plain));
+    assert(Vec_count(indexed) == Vec_count(plain));
+    for (int64_t i = -2; i < 202; ++i)
+    {
+        assert(Vec_where(indexed, &i, sizeof(i)) ==
+               Vec_where(plain, &i, sizeof(i)));
+        assert(Vec_has(indexed, &i, sizeof(i)) ==
+               Vec_has(plain, &i, sizeof(i)));
+    }
+}
 
-    // Compare with expected vector.
-    Vec* expected = Vec_new(5, sizeof(int64_t));
+/**
+ * @brief A predicate for `int64_t`s that are multiples of 7
+ */
+static bool is_multiple_of_7(void const* element, size_t const element_size)
+{
+    return element_size == sizeof(int64_t) &&
+           *(int64_t const*) element % 7 == 0;
+}
 
-    assert(true == Vec_append(expected, &(int64_t){-1}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-2}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-3}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-4}, sizeof(int64_t)));
-    assert(Vec_count(expected) == Vec_count(v));
+static void test_index_invalid(void)
+{
+    Vec* v = Vec_new(4, sizeof(Record));
 
-    assert(Vec_equal(v, expected, NULL));
+    assert(v != NULL);
+    assert(false == Vec_indexed(v));
+
+    // Null pointers
+    assert(false == Vec_enable_index(NULL, 0, sizeof(Record)));
+    assert(false == Vec_disable_index(NULL));
+    assert(false == Vec_reindex(NULL));
+    assert(false == Vec_indexed(NULL));
+    assert(0 == Vec_where_key(NULL, &(int32_t){0}, sizeof(int32_t)));
+    assert(false == Vec_has_key(NULL, &(int32_t){0}, sizeof(int32_t)));
+
+    // Keys that are empty, or don't fit in the elements
+    assert(false == Vec_enable_index(v, 0, 0));
+    assert(false == Vec_enable_index(v, 0, sizeof(Record) + 1));
+    assert(false == Vec_enable_index(v, sizeof(Record), 1));
+    assert(false == Vec_enable_index(v, SIZE_MAX, 1));
+    assert(false == Vec_indexed(v));
+
+    fill_records(v, 3, 42);
+
+    // Without an index, there are no keys to search for.
+    assert(3 == Vec_where_key(v, &(int32_t){0}, sizeof(int32_t)));
+    assert(false == Vec_has_key(v, &(int32_t){0}, sizeof(int32_t)));
+
+    // A vector without an index needs no reindexing.
+    assert(true == Vec_reindex(v));
+    assert(true == Vec_disable_index(v));
+
+    // With an index, keys must be its size.
+    assert(true == Vec_enable_index(v, offsetof(Record, key), sizeof(int32_t)));
+    assert(3 == Vec_where_key(v, &(int64_t){0}, sizeof(int64_t)));
+    assert(3 == Vec_where_key(v, NULL, sizeof(int32_t)));
+    assert(false == Vec_has_key(v, NULL, sizeof(int32_t)));
 
-    Vec_destroy(&expected);
     Vec_destroy(&v);
 }
 
-static void test_remove_all_if_some(void)
+static void test_index(void)
 {
-    /*
-     * Remove an element that matches several elements in the vector.
-     *
-     * So from
-     *
-     * ```
-     * [X][X][a][X][X][X][b][X][c][X][d][X][X]
-     *  0  1  2  3  4  5  6  7  8  9 10 11 12
-     * ```
-     *
-     * we'll try removing all instances of `X`, leaving 4 elements.
-     */
-    size_t const total = 13;
-    size_t const remaining = 4;
-    Vec* v = Vec_new(total, sizeof(int64_t));
+    uint64_t seed = 1984;
+    Vec* indexed = Vec_new(1, sizeof(int64_t));
+    Vec* plain = Vec_new(1, sizeof(int64_t));
 
-    assert(v != NULL);
-    // The `X` will be any non-negative element.
-    assert(true == Vec_append(v, &(int64_t){100}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){200}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-200}, sizeof(int64_t))); // `a`
-    assert(true == Vec_append(v, &(int64_t){300}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){400}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){500}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-1}, sizeof(int64_t))); // `b`
-    assert(true == Vec_append(v, &(int64_t){600}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-42}, sizeof(int64_t))); // `c`
-    assert(true == Vec_append(v, &(int64_t){700}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-800}, sizeof(int64_t))); // `d`
-    assert(true == Vec_append(v, &(int64_t){800}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){900}, sizeof(int64_t)));
-    assert(total == Vec_count(v));
+    assert(indexed != NULL);
+    assert(plain != NULL);
+    assert(true == Vec_enable_index(indexed, 0, sizeof(int64_t)));
+    assert_index_agrees(indexed, plain);
 
-    // Remove all `X`s.
-    size_t const removed = total - remaining;
+    // Appends, with plenty of duplicates, and growth of the index
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        int64_t const item = (int64_t) (next_random(&seed) % 200);
 
-    assert(removed == Vec_remove_all_if(v, non_negative));
-    assert(Vec_count(v) == remaining); // Only non-`X`s remain.
+        assert(true == Vec_append(indexed, &item, sizeof(item)));
+        assert(true == Vec_append(plain, &item, sizeof(item)));
+    }
+    assert_index_agrees(indexed, plain);
 
-    // Compare with expected vector.
-    Vec* expected = Vec_new(total, sizeof(int64_t));
+    // Insertions at the head, middle, and tail, and removals likewise
+    for (size_t i = 0; i < 60; ++i)
+    {
+        int64_t const item = (int64_t) (next_random(&seed) % 200);
+        size_t const at = (size_t) next_random(&seed) % (Vec_count(plain) + 1);
 
-    assert(true == Vec_append(expected, &(int64_t){-200}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-1}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-42}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-800}, sizeof(int64_t)));
-    assert(remaining == Vec_count(expected));
+        assert(true == Vec_insert(indexed, at, &item, sizeof(item)));
+        assert(true == Vec_insert(plain, at, &item, sizeof(item)));
 
-    assert(Vec_equal(v, expected, NULL));
+        size_t const from = (size_t) next_random(&seed) % Vec_count(plain);
 
-    Vec_destroy(&expected);
-    Vec_destroy(&v);
+        assert(from == Vec_remove(indexed, from));
+        assert(from == Vec_remove(plain, from));
+    }
+    assert(true == Vec_insert(indexed, 0, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_insert(plain, 0, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == Vec_append(indexed, &(int64_t){200}, sizeof(int64_t)));
+    assert(true == Vec_append(plain, &(int64_t){200}, sizeof(int64_t)));
+    assert_index_agrees(indexed, plain);
+    Vec_remove(indexed, Vec_count(indexed) - 1);
+    Vec_remove(plain, Vec_count(plain) - 1);
+    Vec_remove(indexed, 0);
+    Vec_remove(plain, 0);
+    assert_index_agrees(indexed, plain);
+
+    // Bulk removals, appends, sorts, and applies
+    assert(Vec_remove_all(plain, &(int64_t){5}, sizeof(int64_t)) ==
+           Vec_remove_all(indexed, &(int64_t){5}, sizeof(int64_t)));
+    assert(false == Vec_has(indexed, &(int64_t){5}, sizeof(int64_t)));
+    assert(Vec_remove_all_if(plain, is_multiple_of_7) ==
+           Vec_remove_all_if(indexed, is_multiple_of_7));
+    assert_index_agrees(indexed, plain);
+
+    int64_t const batch[] = {3, 1, 4, 1, 5, 9, 2, 6};
+
+    assert(true == Vec_append_n(indexed, batch, 8, sizeof(int64_t)));
+    assert(true == Vec_append_n(plain, batch, 8, sizeof(int64_t)));
+    assert(true == Vec_extend(indexed, plain));
+    assert(true == Vec_extend(plain, plain));
+    assert_index_agrees(indexed, plain);
+
+    assert(true == Vec_qsort(indexed, int64_full_comparator));
+    assert(true == Vec_qsort(plain, int64_full_comparator));
+    assert_index_agrees(indexed, plain);
+    assert(true == Vec_insert_sorted(indexed, &(int64_t){100},
+                                     sizeof(int64_t), int64_full_comparator));
+    assert(true == Vec_insert_sorted(plain, &(int64_t){100},
+                                     sizeof(int64_t), int64_full_comparator));
+    assert(true == Vec_merge_sorted(indexed, batch, 1, sizeof(int64_t),
+                                    int64_full_comparator));
+    assert(true == Vec_merge_sorted(plain, batch, 1, sizeof(int64_t),
+                                    int64_full_comparator));
+    assert_index_agrees(indexed, plain);
+
+    assert(0 == Vec_apply(indexed, add_one, NULL));
+    assert(0 == Vec_apply(plain, add_one, NULL));
+    assert_index_agrees(indexed, plain);
+
+    // Typed vectors update the index, too.
+    I64Vec* typed = I64Vec_from_vec(indexed);
+
+    assert(true == I64Vec_append(typed, 201));
+    assert(Vec_count(indexed) - 1 == I64Vec_where(typed, &(int64_t){201}));
+    assert(true == I64Vec_sort(typed));
+    assert(Vec_count(indexed) - 1 == I64Vec_where(typed, &(int64_t){201}));
+
+    // After changing elements directly, reindexing catches the index up.
+    *(int64_t*) Vec_get(indexed, 0) = -2;
+    assert(true == Vec_reindex(indexed));
+    assert(0 == Vec_where(indexed, &(int64_t){-2}, sizeof(int64_t)));
+
+    // Without the index, searches scan again.
+    assert(true == Vec_disable_index(indexed));
+    assert(false == Vec_indexed(indexed));
+    assert(0 == Vec_where(indexed, &(int64_t){-2}, sizeof(int64_t)));
+
+    Vec_destroy(&plain);
+    Vec_destroy(&indexed);
 }
 
-static void test_remove_all_if_all(void)
+static void test_index_key(void)
 {
-    /*
-     * Remove all elements.
-     *
-     * So from
-     *
-     * ```
-     * [X][X][X][X][X][X][X][X][X][X]
-     *  0  1  2  3  4  5  6  7  8  9
-     * ```
-     *
-     * remove all instances of `X` (i.e., all the elements).
-     */
-    size_t const cap_hint = 9000;
-    int64_t const X = 1;
-    Vec* v = new_full_i64_vec_same_element(cap_hint, X);
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    size_t const count = 2000;
+    Vec* v = Vec_new_with(1, sizeof(Record), &options);
 
     assert(v != NULL);
+    fill_records(v, count, 2024);
 
-    // Remove all `X`s.
-    size_t const total = Vec_count(v);
+    // Index the records by their keys (after they were added).
+    assert(true == Vec_enable_index(v, offsetof(Record, key), sizeof(int32_t)));
+    assert(true == Vec_indexed(v));
+    assert(3 == counts.allocations); // The vector, its data, and its index
 
-    assert(total >= cap_hint);
-    assert(total == Vec_remove_all_if(v, non_negative));
-    assert(0 == Vec_count(v)); // All elements removed
+    for (int32_t key = -51; key < 51; ++key)
+    {
+        size_t expected = count;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (((Record const*) Vec_get(v, i))->key == key)
+            {
+                expected = i;
+                break;
+            }
+        }
+        assert(expected == Vec_where_key(v, &key, sizeof(key)));
+        assert((expected != count) == Vec_has_key(v, &key, sizeof(key)));
+    }
+
+    // Searching for a whole record matches its bytes, not just its key.
+    Record first = *(Record const*) Vec_get(v, 0);
+
+    assert(0 == Vec_where(v, &first, sizeof(first)));
+    first.index = count;
+    assert(count == Vec_where(v, &first, sizeof(first)));
+
+    // Removing every record with a key leaves none to find.
+    int32_t const key = first.key;
+
+    while (Vec_has_key(v, &key, sizeof(key)))
+    {
+        Vec_remove(v, Vec_where_key(v, &key, sizeof(key)));
+    }
+    assert(Vec_count(v) == Vec_where_key(v, &key, sizeof(key)));
+
+    // Re-enabling the index on another key replaces the old index.
+    assert(true == Vec_enable_index(v, offsetof(Record, index),
+                                    sizeof(uint64_t)));
+    assert(3 == counts.allocations);
+    assert(Vec_count(v) == Vec_where_key(v, &(uint64_t){count},
+                                         sizeof(uint64_t)));
 
     Vec_destroy(&v);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
 }
 
 /**
- * @brief An integer comparator usable for sorting elements in ascending order
- * @param a The first integer
- * @param b The second integer
- * @return A positive `int` if the first integer is bigger than the second, a
- * zero `int` when it's the same size as the second, or a negative `int` when
- * it's smaller than the second or when either integer pointer is null
+ * @brief Checks that looking each key up in the given indexed vector of
+ * `Record`s finds the same element as scanning for it would
  */
-static int int64_comparator(void const* int64_a, void const* int64_b)
+static void assert_keys_indexed(Vec const* v)
 {
-    if (int64_a == NULL ||
-        int64_b == NULL)
+    for (int32_t key = -51; key < 51; ++key)
     {
-        return -1;
-    }
-
-    // We know we're dealing with `int64_t`s; cast to the known type.
-    int64_t const* a = (int64_t const*) int64_a;
-    int64_t const* b = (int64_t const*) int64_b;
+        size_t expected = Vec_count(v);
 
-    return (int) (*a - *b);
+        for (size_t i = 0; i < Vec_count(v); ++i)
+        {
+            if (((Record const*) Vec_get(v, i))->key == key)
+            {
+                expected = i;
+                break;
+            }
+        }
+        assert(expected == Vec_where_key(v, &key, sizeof(key)));
+    }
 }
 
-static void test_qsort_invalid(void)
+static void test_index_shifts(void)
 {
-    size_t const count = 3;
-    Vec* v = Vec_new(count, sizeof(int64_t));
-    Vec* expected = Vec_new(count, sizeof(int64_t));
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    Vec* v = Vec_new_with(1, sizeof(Record), &options);
+    uint64_t seed = 31337;
 
     assert(v != NULL);
-    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-42}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){0}, sizeof(int64_t)));
-    assert(count == Vec_count(v));
-
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){5}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-42}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){0}, sizeof(int64_t)));
-    assert(count == Vec_count(expected));
+    fill_records(v, 500, 2025);
+    assert(true == Vec_enable_index(v, offsetof(Record, key), sizeof(int32_t)));
+    assert(true == Vec_reserve(v, 1000));
 
-    // Null pointers should not permit sorting.
-    assert(false == Vec_qsort(v, NULL));
-    assert(false == Vec_qsort(NULL, int64_comparator));
-    assert(false == Vec_qsort(NULL, NULL));
-    // The vector should be unsorted.
-    assert(true == Vec_equal(v, expected, NULL));
+    // Taking from and adding to either end doesn't rebuild the index.
+    size_t const calls = counts.calls;
+    Record record = {0};
 
-    Vec_destroy(&expected);
-    Vec_destroy(&v);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        assert(true == Vec_pop_front(v, &record, sizeof(record)));
+        assert(true == Vec_push_front(v, &record, sizeof(record)));
+        assert(true == Vec_pop_front(v, &record, sizeof(record)));
+        assert(true == Vec_pop_back(v, NULL, 0));
+        assert(true == Vec_append(v, &record, sizeof(record)));
+    }
+    assert(400 == Vec_count(v));
+    assert(calls == counts.calls);
+    assert_keys_indexed(v);
 
-    v = Vec_new(count, sizeof(int64_t));
+    // Inserting and removing anywhere keeps every key findable.
+    for (size_t i = 0; i < 300; ++i)
+    {
+        size_t const at = (size_t) (next_random(&seed) % Vec_count(v));
 
-    assert(v != NULL);
-    assert(0 == Vec_count(v));
+        record.key = (int32_t) (next_random(&seed) % 100) - 50;
+        if (i % 3 == 0)
+        {
+            Vec_remove(v, at);
+        }
+        else
+        {
+            assert(true == Vec_insert(v, at, &record, sizeof(record)));
+        }
+        if (i % 25 == 0)
+        {
+            assert_keys_indexed(v);
+        }
+    }
+    assert(500 == Vec_count(v));
+    assert_keys_indexed(v);
 
-    // Empty vectors should not permit sorting.
-    assert(false == Vec_qsort(v, int64_comparator));
+    // Draining the vector from both ends leaves nothing to find.
+    while (Vec_count(v) > 0)
+    {
+        assert(true == Vec_pop_front(v, NULL, 0));
+        assert(true == Vec_pop_back(v, NULL, 0));
+    }
+    assert_keys_indexed(v);
 
     Vec_destroy(&v);
+    assert(0 == counts.allocations);
 }
 
-static void test_qsort_scalar(void)
+/**
+ * @brief Hashes a copy of the given vector that doesn't keep its hash, so the
+ * hash is computed from scratch
+ */
+static uint64_t rehashed(Vec const* v)
 {
-    size_t const count = 5;
-    Vec* v = Vec_new(count, sizeof(int64_t));
-    Vec* expected = Vec_new(count, sizeof(int64_t));
+    size_t const count = Vec_count(v);
+    Vec* copy = Vec_new(count + 1, Vec_element_size(v));
 
-    // Sorting empty vectors is fine but does nothing, always returning `false`.
-    assert(false == Vec_qsort(v, int64_comparator));
+    assert(copy != NULL);
+    assert(count == 0 ||
+           true == Vec_append_n(copy,
+                                Vec_data((Vec*) v),
+                                count,
+                                Vec_element_size(v)));
 
-    // Add unsorted elements.
-    assert(true == Vec_append(v, &(int64_t){2077}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-666}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){1962}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-5}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){1945}, sizeof(int64_t)));
-    assert(Vec_count(v) == count);
+    uint64_t const hash = Vec_hash(copy);
 
-    // Add sorted elements.
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){-666}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){-5}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){1945}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){1962}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){2077}, sizeof(int64_t)));
-    assert(Vec_count(expected) == count);
+    Vec_destroy(&copy);
 
-    assert(false == Vec_equal(v, expected, NULL)); // The elements are unsorted.
-    assert(true == Vec_qsort(v, int64_comparator)); // Sort the elements.
-    assert(true == Vec_equal(v, expected, NULL)); // The elements are sorted.
+    return hash;
+}
 
-    Vec_destroy(&expected);
-    Vec_destroy(&v);
+static void test_hash_invalid(void)
+{
+    // Null pointers
+    assert(false == Vec_enable_hash(NULL));
+    assert(false == Vec_disable_hash(NULL));
+    assert(0 == Vec_hash(NULL));
+
+    // Empty vectors hash alike only if their element sizes match.
+    Vec* a = Vec_new(4, sizeof(int64_t));
+    Vec* b = Vec_new(4, sizeof(int32_t));
+
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(Vec_hash(a) != Vec_hash(b));
+    assert(true == Vec_enable_hash(a));
+    assert(true == Vec_enable_hash(a));
+    assert(Vec_hash(a) == rehashed(a));
+    Vec_destroy(&a);
+    Vec_destroy(&b);
 }
 
-/**
- * @brief A `Fish` comparator usable for sorting `Fish` by size in ascending
- * order
- * @param fish_a The first `Fish`
- * @param fish_b The second `Fish`
- * @return A positive `int` if the first `Fish` is bigger than the second, a
- * zero `int` when it's the same size as the second, or a negative `int` when
- * it's smaller than the second or when either `Fish` pointer is null
- */
-static int fish_size_comparator(void const* fish_a, void const* fish_b)
+static void test_hash(void)
 {
-    if (fish_a == NULL ||
-        fish_b == NULL)
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    Vec* w = Vec_new(4, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(w != NULL);
+    for (int64_t i = 0; i < 100; ++i)
     {
-        return -1;
+        assert(true == Vec_append(v, &i, sizeof(i)));
+        assert(true == Vec_append(w, &i, sizeof(i)));
     }
 
-    // We know we're dealing with `Fish`; cast to the known type.
-    Fish const* a = (Fish const*) fish_a;
-    Fish const* b = (Fish const*) fish_b;
+    // Keeping the hash doesn't change it.
+    uint64_t const untracked = Vec_hash(v);
+
+    assert(untracked == Vec_hash(w));
+    assert(true == Vec_enable_hash(v));
+    assert(untracked == Vec_hash(v));
+
+    // Every kind of change keeps it up to date.
+    int64_t const item = 1000;
+    size_t const indices[] = { 0, 50, 100 };
+    int64_t const items[] = { -1, -2, -3 };
+    int64_t const sorted_items[] = { -10, 55, 500 };
+
+    assert(true == Vec_push_front(v, &item, sizeof(item)));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(true == Vec_insert(v, 10, &item, sizeof(item)));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(true == Vec_append_n(v, items, 3, sizeof(int64_t)));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(true == Vec_extend(v, w));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(true == Vec_insert_many(v, indices, items, 3, sizeof(int64_t)));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(4 == Vec_remove(v, 4));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(true == Vec_pop_front(v, NULL, sizeof(int64_t)));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(2 == Vec_remove_all(v, &item, sizeof(item)));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(true == Vec_qsort(v, int64_comparator));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(true == Vec_merge_sorted(v, sorted_items, 3, sizeof(int64_t),
+                                    int64_comparator));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(0 == Vec_apply(v, add_one, NULL));
+    assert(Vec_hash(v) == rehashed(v));
+    assert(0 < Vec_remove_all_if(v, is_multiple_of_7));
+    assert(Vec_hash(v) == rehashed(v));
+
+    // Direct changes need a rehash.
+    *(int64_t*) Vec_get(v, 0) += 1;
+    assert(Vec_hash(v) != rehashed(v));
+    assert(true == Vec_reindex(v));
+    assert(Vec_hash(v) == rehashed(v));
+
+    // Vectors keeping different hashes are unequal; equal ones hash alike.
+    Vec* copy = Vec_clone(v);
+
+    assert(copy != NULL);
+    assert(Vec_hash(copy) == Vec_hash(v));
+    assert(true == Vec_equal(copy, v, NULL));
+    *(int64_t*) Vec_get(copy, 3) += 1;
+    assert(true == Vec_reindex(copy));
+    assert(Vec_hash(copy) != Vec_hash(v));
+    assert(false == Vec_equal(copy, v, NULL));
+    *(int64_t*) Vec_get(copy, 3) -= 1;
+    assert(true == Vec_reindex(copy));
+    assert(true == Vec_equal(copy, v, NULL));
+    Vec_destroy(&copy);
+
+    // The hash doesn't depend on the elements' order.
+    Vec* reversed = Vec_new(4, sizeof(int64_t));
+
+    assert(reversed != NULL);
+    for (int64_t i = 99; i >= 0; --i)
+    {
+        assert(true == Vec_append(reversed, &i, sizeof(i)));
+    }
+    assert(untracked == Vec_hash(reversed));
+    assert(false == Vec_equal(reversed, w, NULL));
+    Vec_destroy(&reversed);
 
-    return (int) (a->size - b->size);
+    Vec_destroy(&v);
+    Vec_destroy(&w);
 }
 
-static void test_qsort_struct(void)
+/**
+ * @brief Gets the byte size of the file at the given path
+ */
+static long file_size(char const* path)
 {
-    size_t const count = 5;
-    Vec* v = Vec_new(count, sizeof(Fish));
-    Vec* expected = Vec_new(count, sizeof(Fish));
+    FILE* file = fopen(path, "rb");
 
-    // Add (size-wise) unsorted elements.
-    assert(v != NULL);
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 6
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 1
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 4
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 1
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = BLUE,
-                                  .size = 2
-                              },
-                              sizeof(Fish)));
-    assert(Vec_count(v) == count);
+    assert(file != NULL);
+    assert(0 == fseek(file, 0, SEEK_END));
 
-    // Add (size-wise) sorted elements.
-    assert(expected != NULL);
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 1
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 1
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = BLUE,
-                                  .size = 2
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 4
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 6
-                              },
-                              sizeof(Fish)));
-    assert(Vec_count(expected) == count);
+    long const size = ftell(file);
 
-    // The elements are unsorted.
-    assert(false == Vec_equal(v, expected, fish_size_comparator));
-    assert(true == Vec_qsort(v, fish_size_comparator)); // Sort the elements.
-    // The elements are sorted.
-    assert(true == Vec_equal(v, expected, fish_size_comparator));
+    fclose(file);
 
-    Vec_destroy(&expected);
-    Vec_destroy(&v);
+    return size;
 }
 
-#define UNUSED(x) (void)(x)
-
 /**
- * @brief Increments the given element by one
- * @param element A pointer to an `int64_t`
- * @param element_size For size-based type checking
- * @param state An unused pointer
- * @return 1 if there was an input problem; 0 otherwise
+ * @brief Writes the given bytes to the file at the given path, replacing it
  */
-static int add_one(void* element, size_t const element_size, void* state)
+static void write_file(char const* path, void const* bytes, size_t const size)
 {
-    UNUSED(state);
-    if (element == NULL ||
-        sizeof(int64_t) != element_size) // Explicit size check
+    FILE* file = fopen(path, "wb");
+
+    assert(file != NULL);
+    assert(size == fwrite(bytes, 1, size, file));
+    fclose(file);
+}
+
+static void test_mmap_invalid(void)
+{
+    char const* path = "tests_mmap_invalid.bin";
+
+    remove(path);
+
+    // Null path, or element size 0
+    assert(NULL == Vec_open_mmap(NULL, sizeof(int64_t), VEC_MMAP_CREATE));
+    assert(NULL == Vec_open_mmap(path, 0, VEC_MMAP_CREATE));
+
+    // Conflicting flags
+    assert(NULL == Vec_open_mmap(path,
+                                 sizeof(int64_t),
+                                 VEC_MMAP_READ_ONLY | VEC_MMAP_COPY_ON_WRITE));
+    assert(NULL == Vec_open_mmap(path,
+                                 sizeof(int64_t),
+                                 VEC_MMAP_SEQUENTIAL | VEC_MMAP_RANDOM));
+    assert(NULL == Vec_open_mmap(path,
+                                 sizeof(int64_t),
+                                 VEC_MMAP_CREATE | VEC_MMAP_READ_ONLY));
+
+    // Missing file (without creating it)
+    assert(NULL == Vec_open_mmap(path, sizeof(int64_t), 0));
+    assert(NULL == Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_READ_ONLY));
+
+    // File size not a multiple of the element size
+    write_file(path, "12345", 5);
+    assert(NULL == Vec_open_mmap(path, sizeof(int64_t), 0));
+    assert(NULL == Vec_open_mmap(path,
+                                 sizeof(int64_t),
+                                 VEC_MMAP_COPY_ON_WRITE));
+
+    // Empty file mapped read-only
+    write_file(path, "", 0);
+    assert(NULL == Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_READ_ONLY));
+
+    // Null vector
+    assert(false == Vec_advise_mmap(NULL, VEC_MMAP_ADVICE_SEQUENTIAL));
+    assert(false == Vec_sync_mmap(NULL));
+
+    // Vector that isn't mapped
+    Vec* v = Vec_new(1, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(false == Vec_advise_mmap(v, VEC_MMAP_ADVICE_SEQUENTIAL));
+    assert(false == Vec_sync_mmap(v));
+    Vec_destroy(&v);
+
+    remove(path);
+}
+
+static void test_mmap(void)
+{
+    char const* path = "tests_mmap.bin";
+    int64_t const count = 10000;
+
+    remove(path);
+
+    // Create the file, and grow it by appending.
+    Vec* v = Vec_open_mmap(path,
+                           sizeof(int64_t),
+                           VEC_MMAP_CREATE | VEC_MMAP_SEQUENTIAL);
+
+    assert(v != NULL);
+    assert(0 == Vec_count(v));
+    for (int64_t i = 0; i < count; ++i)
     {
-        return 1; // Input error
+        assert(true == Vec_append(v, &i, sizeof(i)));
     }
+    assert(true == Vec_sync_mmap(v));
+    Vec_destroy(&v);
 
-    int64_t* i = (int64_t*) element;
+    // The file is cut down to the elements (without the spare capacity).
+    assert((long) (count * sizeof(int64_t)) == file_size(path));
 
-    *i += 1;
+    // Reopen it read-write, and the elements are all there.
+    v = Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_RANDOM);
+    assert(v != NULL);
+    assert((size_t) count == Vec_count(v));
+    assert((size_t) count == Vec_capacity(v));
+    for (int64_t i = 0; i < count; ++i)
+    {
+        assert(i == *(int64_t const*) Vec_get(v, (size_t) i));
+    }
 
-    return 0;
-}
+    // Removing elements shrinks the file once the vector's destroyed.
+    assert(true == Vec_advise_mmap(v, VEC_MMAP_ADVICE_WILL_NEED));
+    Vec_remove(v, 0);
+    Vec_remove(v, Vec_count(v) - 1);
+    *(int64_t*) Vec_get(v, 0) = -1;
+    Vec_destroy(&v);
+    assert((long) ((count - 2) * sizeof(int64_t)) == file_size(path));
 
-static void test_apply_invalid(void)
-{
-    Vec* v = Vec_new(5, sizeof(int));
+    // Read-only vectors can be searched, but not grown.
+    v = Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_READ_ONLY);
+    assert(v != NULL);
+    assert((size_t) (count - 2) == Vec_count(v));
+    assert(-1 == *(int64_t const*) Vec_get(v, 0));
+    assert(1 == Vec_where(v, &(int64_t){2}, sizeof(int64_t)));
+    assert(false == Vec_append(v, &(int64_t){0}, sizeof(int64_t)));
+    assert((size_t) (count - 2) == Vec_count(v));
+    assert(true == Vec_advise_mmap(v, VEC_MMAP_ADVICE_SEQUENTIAL));
+    Vec_destroy(&v);
 
+    // Copy-on-write vectors can change (and grow), but the file doesn't.
+    v = Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_COPY_ON_WRITE);
     assert(v != NULL);
+    *(int64_t*) Vec_get(v, 0) = 12345;
+    for (int64_t i = 0; i < 100; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    assert((size_t) (count + 98) == Vec_count(v));
+    assert(12345 == *(int64_t const*) Vec_get(v, 0));
+    assert(2 == *(int64_t const*) Vec_get(v, 1));
+    Vec_destroy(&v);
+    assert((long) ((count - 2) * sizeof(int64_t)) == file_size(path));
 
-    // Null pointers should cause the function to fail...
-    int const failure_flag = 1;
+    v = Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_READ_ONLY);
+    assert(v != NULL);
+    assert(-1 == *(int64_t const*) Vec_get(v, 0));
+    Vec_destroy(&v);
 
-    assert(failure_flag == Vec_apply(v, NULL, NULL));
-    assert(failure_flag == Vec_apply(NULL, add_one, NULL));
-    assert(failure_flag == Vec_apply(NULL, NULL, NULL));
-    // ...regardless of the caller state pointer supplied.
-    assert(failure_flag == Vec_apply(v, NULL, &v));
-    assert(failure_flag == Vec_apply(NULL, add_one, &v));
-    assert(failure_flag == Vec_apply(NULL, NULL, &v));
+    // Popping off the front leaves the rest at the front of the file.
+    v = Vec_open_mmap(path, sizeof(int64_t), 0);
+    assert(v != NULL);
+    assert(true == Vec_pop_front(v, NULL, 0));
+    assert(2 == *(int64_t const*) Vec_get(v, 0));
+    Vec_destroy(&v);
+    assert((long) ((count - 3) * sizeof(int64_t)) == file_size(path));
 
+    v = Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_READ_ONLY);
+    assert(v != NULL);
+    assert(2 == *(int64_t const*) Vec_get(v, 0));
+    assert(count - 2 == *(int64_t const*) Vec_get(v, Vec_count(v) - 1));
     Vec_destroy(&v);
-}
 
-static void test_apply_modify_scalar(void)
-{
-    // Make a vector with some scalar elements.
-    size_t const count = 5;
-    Vec* v = Vec_new(count, sizeof(int64_t));
+    // Hints and syncs cover the whole mapping, even after popping the front.
+    v = Vec_open_mmap(path, sizeof(int64_t), 0);
+    assert(v != NULL);
+    assert(true == Vec_pop_front(v, NULL, 0));
+    assert(true == Vec_advise_mmap(v, VEC_MMAP_ADVICE_SEQUENTIAL));
+    assert(true == Vec_sync_mmap(v));
 
-    /*
-     * Applying something on an empty vector is fine but does nothing, returning
-     * `1`.
-     */
+    // A copy isn't mapped, but can outlive (and grow past) the original.
+    Vec* copy = Vec_clone(v);
+
+    assert(copy != NULL);
+    assert(false == Vec_sync_mmap(copy));
+    Vec_destroy(&v);
+    assert((long) ((count - 4) * sizeof(int64_t)) == file_size(path));
+    for (int64_t i = 0; i < count; ++i)
+    {
+        assert(true == Vec_append(copy, &i, sizeof(i)));
+    }
+    assert((size_t) (2 * count - 4) == Vec_count(copy));
+    assert(3 == *(int64_t const*) Vec_get(copy, 0));
+    Vec_destroy(&copy);
+    assert((long) ((count - 4) * sizeof(int64_t)) == file_size(path));
+
+    // An empty file can be mapped copy-on-write, and grown in memory.
+    write_file(path, "", 0);
+    v = Vec_open_mmap(path, sizeof(int64_t), VEC_MMAP_COPY_ON_WRITE);
     assert(v != NULL);
-    assert(1 == Vec_apply(v, add_one, NULL));
     assert(0 == Vec_count(v));
-
-    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){6}, sizeof(int64_t)));
     assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
     assert(true == Vec_append(v, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){9}, sizeof(int64_t)));
-    assert(count == Vec_count(v));
+    assert(1 == Vec_where(v, &(int64_t){8}, sizeof(int64_t)));
+    Vec_destroy(&v);
+    assert(0 == file_size(path));
 
-    // Increment all elements by one.
-    int const success_flag = 0;
+    remove(path);
+}
 
-    assert(success_flag == Vec_apply(v, add_one, NULL));
+static void test_io_invalid(void)
+{
+    char const* path = "tests_io_invalid.bin";
+    Vec* v = Vec_new(1, sizeof(int64_t));
 
-    // Make a vector with the same scalar elements incremented by one.
-    Vec* expected = Vec_new(count, sizeof(int64_t));
+    assert(v != NULL);
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){6}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){7}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){8}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){10}, sizeof(int64_t)));
-    assert(count == Vec_count(expected));
+    // Null vector, or bad file descriptor
+    assert(false == Vec_write(NULL, 1));
+    assert(false == Vec_write(v, -1));
+    assert(NULL == Vec_read(-1, NULL));
+    assert(NULL == Vec_from_buffer(NULL, 100, NULL));
 
-    // The vectors should match.
-    assert(true == Vec_equal(v, expected, NULL));
+    // Incomplete allocator
+    VecAllocator const allocator = { .allocate = counting_allocate };
 
-    Vec_destroy(&expected);
+    assert(NULL == Vec_read(0, &allocator));
 
-    /*
-     * If we increment by one three more times (regardless of caller state
-     * pointer supplied)...
-     */
-    assert(success_flag == Vec_apply(v, add_one, NULL));
-    assert(success_flag == Vec_apply(v, add_one, &expected));
-    assert(success_flag == Vec_apply(v, add_one, &(int){666}));
+    // Something that isn't a saved vector at all
+    uint8_t junk[VEC_IO_HEADER_SIZE + 8] = {0};
 
-    /*
-     * ...the vector should match one with the original elements incremented by
-     * four.
-     */
-    expected = Vec_new(count, sizeof(int64_t));
+    write_file(path, junk, sizeof(junk));
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected, &(int64_t){9}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){10}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){11}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){12}, sizeof(int64_t)));
-    assert(true == Vec_append(expected, &(int64_t){13}, sizeof(int64_t)));
-    assert(count == Vec_count(expected));
+    FILE* file = fopen(path, "rb");
 
-    assert(true == Vec_equal(v, expected, NULL));
+    assert(file != NULL);
+    assert(NULL == Vec_read(fileno(file), NULL));
+    fclose(file);
+    assert(NULL == Vec_from_buffer(junk, sizeof(junk), NULL));
 
-    Vec_destroy(&expected);
+    // A saved vector that's cut short, or corrupted
+    for (int64_t i = 0; i < 100; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+
+    file = fopen(path, "w+b");
+    assert(file != NULL);
+    assert(true == Vec_write(v, fileno(file)));
+    fclose(file);
+
+    size_t const saved_size = VEC_IO_HEADER_SIZE + 100 * sizeof(int64_t);
+    uint8_t* saved = malloc(saved_size);
+
+    assert(saved != NULL);
+    file = fopen(path, "rb");
+    assert(file != NULL);
+    assert(saved_size == fread(saved, 1, saved_size, file));
+    fclose(file);
+
+    write_file(path, saved, saved_size - 1);
+    file = fopen(path, "rb");
+    assert(file != NULL);
+    assert(NULL == Vec_read(fileno(file), NULL));
+    fclose(file);
+    assert(NULL == Vec_from_buffer(saved, saved_size - 1, NULL));
+    assert(NULL == Vec_from_buffer(saved, VEC_IO_HEADER_SIZE - 1, NULL));
+
+    saved[saved_size - 1] ^= 1;
+    write_file(path, saved, saved_size);
+    file = fopen(path, "rb");
+    assert(file != NULL);
+    assert(NULL == Vec_read(fileno(file), NULL));
+    fclose(file);
+    assert(NULL == Vec_from_buffer(saved, saved_size, NULL));
+
+    // A saved vector of a different format version
+    saved[saved_size - 1] ^= 1;
+    saved[4] += 1;
+    assert(NULL == Vec_from_buffer(saved, saved_size, NULL));
+
+    // The buffers failed to be taken over, so they're still the caller's.
+    free(saved);
     Vec_destroy(&v);
+    remove(path);
 }
 
-/**
- * @brief Increases the size of the given `Fish` if it's a green one
- * @param element A `Fish`
- * @param element_size For size-based type checking
- * @param state An unused pointer
- * @return 1 if there was an input problem; 0 otherwise
- */
-static int grow_green_fish(void* element,
-                           size_t const element_size,
-                           void* state)
+static void test_io(void)
 {
-    UNUSED(state);
-    if (element == NULL ||
-        sizeof(Fish) != element_size) // Explicit size check
+    char const* path = "tests_io.bin";
+    Counts counts = {0};
+    VecAllocator const allocator =
     {
-        return 1; // Input error
-    }
-
-    Fish* fish = (Fish*) element;
-
-    if (fish->color == GREEN)
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    size_t const count = 3000;
+    Vec* records = Vec_new(1, sizeof(Record));
+    Vec* empty = Vec_new(1, sizeof(int16_t));
+
+    assert(records != NULL && empty != NULL);
+    fill_records(records, count, 17);
+
+    // Save two vectors, one after the other.
+    FILE* file = fopen(path, "w+b");
+
+    assert(file != NULL);
+    assert(true == Vec_write(records, fileno(file)));
+    assert(true == Vec_write(empty, fileno(file)));
+    fclose(file);
+    assert((long) (2 * VEC_IO_HEADER_SIZE + count * sizeof(Record)) ==
+           file_size(path));
+
+    // Load them back, in the same order.
+    file = fopen(path, "rb");
+    assert(file != NULL);
+
+    Vec* loaded = Vec_read(fileno(file), &allocator);
+
+    assert(loaded != NULL);
+    assert(2 == counts.allocations); // The vector, and its elements
+    assert(count == Vec_count(loaded));
+    assert(count == Vec_capacity(loaded));
+    assert(true == Vec_equal(records, loaded, NULL));
+
+    Vec* loaded_empty = Vec_read(fileno(file), NULL);
+
+    assert(loaded_empty != NULL);
+    assert(0 == Vec_count(loaded_empty));
+    assert(sizeof(int16_t) == Vec_element_size(loaded_empty));
+
+    // There's nothing left to load.
+    assert(NULL == Vec_read(fileno(file), NULL));
+    fclose(file);
+
+    Vec_destroy(&loaded);
+    Vec_destroy(&loaded_empty);
+    assert(0 == counts.allocations);
+
+    // Take over a buffer holding a saved vector, without copying.
+    size_t const saved_size = VEC_IO_HEADER_SIZE + count * sizeof(Record);
+    uint8_t* saved = counting_allocate(&counts, saved_size);
+
+    assert(saved != NULL);
+    file = fopen(path, "rb");
+    assert(file != NULL);
+    assert(saved_size == fread(saved, 1, saved_size, file));
+    fclose(file);
+
+    loaded = Vec_from_buffer(saved, saved_size, &allocator);
+    assert(loaded != NULL);
+    assert((void*) (saved + VEC_IO_HEADER_SIZE) == Vec_data(loaded));
+    assert(true == Vec_equal(records, loaded, NULL));
+
+    // It works like any other vector, and grows by reallocating the buffer.
+    Record const extra = { .padding = 0xDEADBEEF, .key = 7, .index = count };
+
+    assert(true == Vec_append(loaded, &extra, sizeof(extra)));
+    assert(true == Vec_append(records, &extra, sizeof(extra)));
+    assert(true == Vec_equal(records, loaded, NULL));
+    Vec_remove(loaded, 0);
+    assert(count == Vec_count(loaded));
+    assert(true == Vec_enable_index(loaded, offsetof(Record, index),
+                                    sizeof(uint64_t)));
+    assert(count - 1 == Vec_where_key(loaded, &(uint64_t){count},
+                                      sizeof(uint64_t)));
+    assert(true == Vec_shrink_to_fit(loaded));
+
+    // A copy can outlive (and grow past) the vector that took the buffer over.
+    Vec* copy = Vec_clone(loaded);
+
+    assert(copy != NULL);
+    Vec_destroy(&loaded);
+    assert(0 != counts.allocations);
+    for (size_t i = 0; i < count; ++i)
     {
-        fish->size += 1;
+        assert(true == Vec_append(copy, &extra, sizeof(extra)));
     }
-
-    return 0;
+    assert(2 * count == Vec_count(copy));
+    assert(1 == ((Record const*) Vec_get(copy, 0))->index);
+    Vec_destroy(&copy);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
+
+    // An empty saved vector's buffer is freed right away.
+    saved = malloc(VEC_IO_HEADER_SIZE);
+    assert(saved != NULL);
+    file = fopen(path, "rb");
+    assert(file != NULL);
+    assert(0 == fseek(file, (long) (VEC_IO_HEADER_SIZE +
+                                    count * sizeof(Record)), SEEK_SET));
+    assert(VEC_IO_HEADER_SIZE == fread(saved, 1, VEC_IO_HEADER_SIZE, file));
+    fclose(file);
+    loaded = Vec_from_buffer(saved, VEC_IO_HEADER_SIZE, NULL);
+    assert(loaded != NULL);
+    assert(0 == Vec_count(loaded));
+    assert(true == Vec_append(loaded, &(int16_t){1}, sizeof(int16_t)));
+    Vec_destroy(&loaded);
+
+    Vec_destroy(&records);
+    Vec_destroy(&empty);
+    remove(path);
 }
 
 /**
- * @brief A `Fish` comparator to be used by a vector's equality function that
- * considers all the members of a `Fish`
- * @param fish_a A `Fish`
- * @param fish_b Another `Fish`
- * @return 1 if there was an input problem; 0 if the given `Fish` have the same
- * members; 2 if their members differ
+ * @brief An element appended by a concurrent test's producers, which readers
+ * can tell is completely written
  */
-static int fish_precise_comparator(void const* fish_a, void const* fish_b)
+typedef struct
 {
-    if (fish_a == NULL ||
-        fish_b == NULL)
+    uint64_t id; // The producer's index times the appends per producer, plus j
+    uint64_t check; // The complement of the ID
+} Event;
+
+/**
+ * @brief The context of a concurrent test's tasks
+ */
+typedef struct
+{
+    VecConcurrent* events;
+    size_t producers;
+    size_t per_producer;
+    atomic_size_t reads; // How many elements the reader checked
+} EventJob;
+
+/**
+ * @brief A concurrent test's task: task 0 reads the vector as it grows, and
+ * every other task produces elements
+ */
+static void event_task(void* context,
+                       size_t const task_index,
+                       size_t const worker_index)
+{
+    EventJob* job = (EventJob*) context;
+    size_t const total = job->producers * job->per_producer;
+
+    (void) worker_index;
+    if (task_index == 0)
     {
-        return 1;
-    }
+        // The count only grows, and only ever covers complete elements.
+        size_t seen = 0;
 
-    // We know we're dealing with `Fish`; cast to the known type.
-    Fish const* a = (Fish const*) fish_a;
-    Fish const* b = (Fish const*) fish_b;
+        while (seen < total)
+        {
+            size_t const count = VecConcurrent_count(job->events);
 
-    if ((a->color == b->color) &&
-        (a->size == b->size))
+            assert(count >= seen);
+            for (; seen < count; ++seen)
+            {
+                Event const* e = VecConcurrent_get(job->events, seen);
+
+                assert(e != NULL);
+                assert(e->check == ~e->id);
+            }
+        }
+        atomic_store(&job->reads, seen);
+        return;
+    }
+
+    for (size_t j = 0; j < job->per_producer; ++j)
     {
-        return 0;
+        uint64_t const id = (task_index - 1) * job->per_producer + j;
+        Event const e = { .id = id, .check = ~id };
+
+        assert(true == VecConcurrent_append(job->events, &e, sizeof(e)));
     }
+}
 
-    return 2;
+static void test_concurrent_invalid(void)
+{
+    assert(NULL == VecConcurrent_new(0, sizeof(Event)));
+    assert(NULL == VecConcurrent_new(8, 0));
+    assert(NULL == VecConcurrent_new(SIZE_MAX, sizeof(Event)));
+    VecConcurrent_destroy(NULL);
+
+    VecConcurrent* v = VecConcurrent_new(8, sizeof(Event));
+    Event const e = {0};
+
+    assert(v != NULL);
+    assert(false == VecConcurrent_append(NULL, &e, sizeof(e)));
+    assert(false == VecConcurrent_append(v, NULL, sizeof(e)));
+    assert(false == VecConcurrent_append(v, &e, sizeof(e) - 1));
+    assert(0 == VecConcurrent_count(NULL));
+    assert(0 == VecConcurrent_count(v));
+    assert(NULL == VecConcurrent_get(NULL, 0));
+    assert(NULL == VecConcurrent_get(v, 0)); // Nothing appended yet
+    assert(NULL == VecConcurrent_collect(NULL, NULL));
+
+    assert(true == VecConcurrent_append(v, &e, sizeof(e)));
+    assert(NULL == VecConcurrent_get(v, 1));
+
+    VecConcurrent_destroy(&v);
+    assert(v == NULL);
 }
 
-static void test_apply_modify_struct(void)
+static void test_concurrent(void)
 {
-    // Make a vector of `Fish`.
-    size_t const count = 5;
-    Vec* v = Vec_new(count, sizeof(Fish));
+    // On one thread, it works like a regular vector (that never moves).
+    VecConcurrent* v = VecConcurrent_new(3, sizeof(int64_t));
 
     assert(v != NULL);
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 6
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 3
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = BLUE,
-                                  .size = 4
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 10
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(v,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 41
-                              },
-                              sizeof(Fish)));
-    assert(count == Vec_count(v));
 
-    // Increment the size of all the green `Fish` by one.
-    int const success_flag = 0;
+    int64_t const* first = NULL;
 
-    assert(success_flag == Vec_apply(v, grow_green_fish, NULL));
+    for (int64_t i = 0; i < 1000; ++i)
+    {
+        assert(true == VecConcurrent_append(v, &i, sizeof(i)));
+        assert((size_t) i + 1 == VecConcurrent_count(v));
+        if (i == 0)
+        {
+            first = VecConcurrent_get(v, 0);
+        }
+    }
+    assert(first == VecConcurrent_get(v, 0)); // Growing didn't move it.
+    for (int64_t i = 0; i < 1000; ++i)
+    {
+        assert(i == *(int64_t const*) VecConcurrent_get(v, (size_t) i));
+    }
 
-    /*
-     * Make a vector of the same `Fish`, with the size of the green ones
-     * incremented by one.
-     */
-    Vec* expected = Vec_new(count, sizeof(Fish));
+    Vec* collected = VecConcurrent_collect(v, NULL);
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 7
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 3
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = BLUE,
-                                  .size = 4
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 11
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 42
-                              },
-                              sizeof(Fish)));
-    assert(count == Vec_count(expected));
+    assert(collected != NULL);
+    assert(1000 == Vec_count(collected));
+    for (int64_t i = 0; i < 1000; ++i)
+    {
+        assert(i == *(int64_t const*) Vec_get(collected, (size_t) i));
+    }
+    Vec_destroy(&collected);
+    VecConcurrent_destroy(&v);
+
+    // An empty vector collects into an empty vector.
+    v = VecConcurrent_new(1, sizeof(int64_t));
+    assert(v != NULL);
+    collected = VecConcurrent_collect(v, NULL);
+    assert(collected != NULL);
+    assert(0 == Vec_count(collected));
+    Vec_destroy(&collected);
+    VecConcurrent_destroy(&v);
+
+    // Many producers at once, with a reader watching the whole time
+    VecThreads* pool = VecThreads_new(6);
+    EventJob job =
+    {
+        .events = VecConcurrent_new(16, sizeof(Event)),
+        .producers = 10,
+        .per_producer = 20000
+    };
+    size_t const total = job.producers * job.per_producer;
+
+    assert(pool != NULL);
+    assert(job.events != NULL);
+    atomic_init(&job.reads, 0);
+    assert(true == VecThreads_for(pool, job.producers + 1, event_task, &job));
+    assert(total == atomic_load(&job.reads));
+    assert(total == VecConcurrent_count(job.events));
+
+    // Every element was appended exactly once.
+    collected = VecConcurrent_collect(job.events, NULL);
+    assert(collected != NULL);
+    assert(total == Vec_count(collected));
+    assert(true == Vec_radix_sort(collected, offsetof(Event, id),
+                                  sizeof(uint64_t), false));
+    for (size_t i = 0; i < total; ++i)
+    {
+        Event const* e = Vec_get(collected, i);
 
-    // The vectors should match.
-    assert(true == Vec_equal(v, expected, fish_precise_comparator));
+        assert(e->id == i);
+        assert(e->check == ~e->id);
+    }
 
-    Vec_destroy(&expected);
+    Vec_destroy(&collected);
+    VecConcurrent_destroy(&job.events);
+    VecThreads_destroy(&pool);
+}
 
-    /*
-     * If we increment by one three more times (regardless of caller state
-     * pointer supplied)...
-     */
-    assert(success_flag == Vec_apply(v, grow_green_fish, NULL));
-    assert(success_flag == Vec_apply(v, grow_green_fish, &expected));
-    assert(success_flag == Vec_apply(v, grow_green_fish, &(int){666}));
+/**
+ * @brief A shared vector update that appends the given count of `int64_t`s
+ * (the update's context), continuing the sequence 0, 1, 2... already in it
+ */
+static bool append_sequence(Vec* draft, void* context)
+{
+    size_t const n = *(size_t const*) context;
 
-    /*
-     * ...the vector should match one with the original elements incremented by
-     * four.
-     */
-    expected = Vec_new(count, sizeof(Fish));
+    for (size_t i = 0; i < n; ++i)
+    {
+        int64_t const next = (int64_t) Vec_count(draft);
 
-    assert(expected != NULL);
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 10
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = RED,
-                                  .size = 3
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = BLUE,
-                                  .size = 4
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 14
-                              },
-                              sizeof(Fish)));
-    assert(true == Vec_append(expected,
-                              &(Fish)
-                              {
-                                  .color = GREEN,
-                                  .size = 45
-                              },
-                              sizeof(Fish)));
-    assert(count == Vec_count(expected));
+        assert(true == Vec_append(draft, &next, sizeof(next)));
+    }
 
-    assert(true == Vec_equal(v, expected, fish_precise_comparator));
+    return true;
+}
 
-    Vec_destroy(&expected);
-    Vec_destroy(&v);
+/**
+ * @brief A shared vector update that changes its mind
+ */
+static bool reject_update(Vec* draft, void* context)
+{
+    (void) context;
+    assert(true == Vec_append(draft, &(int64_t){-1}, sizeof(int64_t)));
+
+    return false;
 }
 
 /**
- * @brief Records the largest element seen so far
- * @param element An `int64_t`
- * @param element_size For size-based type checking
- * @param state Used to update the largest element seen so far
- * @return 1 if there was an input problem; 0 otherwise
+ * @brief The context of a shared vector test's tasks
  */
-static int store_max(void* element, size_t const element_size, void* state)
+typedef struct
 {
-    if (element == NULL ||
-        state == NULL ||
-        sizeof(int64_t) != element_size) // Explicit size check
+    VecShared* shared;
+    size_t updates; // How many updates the writer makes
+    size_t per_update; // How many elements each update appends
+} SharedJob;
+
+/**
+ * @brief A shared vector test's task: task 0 writes, and every other task
+ * reads until it sees the writer's last version
+ */
+static void shared_task(void* context,
+                        size_t const task_index,
+                        size_t const worker_index)
+{
+    SharedJob* job = (SharedJob*) context;
+    size_t const total = job->updates * job->per_update;
+
+    (void) worker_index;
+    if (task_index == 0)
     {
-        return 1; // Input error
+        for (size_t i = 0; i < job->updates; ++i)
+        {
+            assert(true == VecShared_update(job->shared,
+                                            append_sequence,
+                                            &job->per_update));
+        }
+        return;
     }
 
-    int64_t const* i = (int64_t const*) element;
-    int64_t* curr_max = (int64_t*) state;
+    VecSharedReader* reader = VecShared_join(job->shared);
+    size_t seen = 0;
 
-    if (*i > *curr_max)
+    assert(reader != NULL);
+    while (seen < total)
     {
-        *curr_max = *i; // Update largest element so far
+        // Every version is a complete sequence, and versions only grow.
+        Vec const* version = VecShared_pin(reader);
+        size_t const count = Vec_count(version);
+        int64_t const* elements = (int64_t const*) Vec_data(version);
+
+        assert(count >= seen);
+        assert(count % job->per_update == 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            assert(elements[i] == (int64_t) i);
+        }
+        seen = count;
+        VecShared_unpin(reader);
     }
+    VecShared_leave(&reader);
+}
 
-    return 0;
+static void test_shared_invalid(void)
+{
+    assert(NULL == VecShared_new(NULL));
+    VecShared_destroy(NULL);
+    assert(NULL == VecShared_join(NULL));
+    VecShared_leave(NULL);
+    assert(NULL == VecShared_pin(NULL));
+    VecShared_unpin(NULL);
+    assert(0 == VecShared_reclaim(NULL));
+
+    VecShared* shared = VecShared_new(Vec_new(1, sizeof(int64_t)));
+
+    assert(shared != NULL);
+    assert(false == VecShared_update(NULL, append_sequence, NULL));
+    assert(false == VecShared_update(shared, NULL, NULL));
+    assert(false == VecShared_publish(NULL, NULL));
+    assert(false == VecShared_publish(shared, NULL));
+    VecShared_destroy(&shared);
+    assert(shared == NULL);
 }
 
-static void test_apply_state_scalar(void)
+static void test_shared(void)
 {
-    // Make a vector with one maximum element.
-    int64_t const max_actual = 43;
-    Vec* v = Vec_new(10, sizeof(int64_t));
+    Counts counts = {0};
+    VecAllocator const allocator =
+    {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecOptions const options = { .allocator = &allocator };
+    VecShared* shared = VecShared_new(Vec_new_with(4,
+                                                   sizeof(int64_t),
+                                                   &options));
+    VecSharedReader* reader = VecShared_join(shared);
+    size_t const three = 3;
+
+    assert(shared != NULL);
+    assert(reader != NULL);
+    assert(2 == counts.allocations); // One version
+
+    // A pinned version stays put, however many versions come after it.
+    Vec const* pinned = VecShared_pin(reader);
+
+    assert(0 == Vec_count(pinned));
+    assert(pinned == VecShared_pin(reader)); // Already pinned
+    assert(true == VecShared_update(shared, append_sequence, (void*) &three));
+    assert(true == VecShared_update(shared, append_sequence, (void*) &three));
+    assert(0 == Vec_count(pinned));
+    assert(6 == counts.allocations); // The old versions wait for the reader.
+    assert(2 == VecShared_reclaim(shared));
+
+    // Once unpinned, the old versions can go.
+    VecShared_unpin(reader);
+    assert(0 == VecShared_reclaim(shared));
+    assert(2 == counts.allocations);
+
+    pinned = VecShared_pin(reader);
+    assert(6 == Vec_count(pinned));
+    assert(5 == Vec_where(pinned, &(int64_t){5}, sizeof(int64_t)));
+    VecShared_unpin(reader);
+
+    // A rejected update publishes nothing.
+    assert(false == VecShared_update(shared, reject_update, NULL));
+    assert(2 == counts.allocations);
+
+    // Versions built from scratch can be published, too.
+    Vec* next = Vec_new_with(1, sizeof(int64_t), &options);
+
+    assert(next != NULL);
+    assert(true == Vec_append(next, &(int64_t){42}, sizeof(int64_t)));
+    assert(true == VecShared_publish(shared, next));
+    assert(2 == counts.allocations); // Nobody was pinned, so it's freed now.
+
+    pinned = VecShared_pin(reader);
+    assert(1 == Vec_count(pinned));
+    assert(42 == *(int64_t const*) Vec_get(pinned, 0));
+
+    // Leaving unpins, and the reader gets reused by the next join.
+    VecShared_leave(&reader);
+    assert(reader == NULL);
+    reader = VecShared_join(shared);
+    assert(reader != NULL);
+    VecSharedReader* other = VecShared_join(shared);
+
+    assert(other != NULL && other != reader);
+    VecShared_leave(&other);
+
+    // Destruction frees everything, pinned or not.
+    (void) VecShared_pin(reader);
+    assert(true == VecShared_update(shared, append_sequence, (void*) &three));
+    VecShared_destroy(&shared);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
+
+    // Copies of a first version mapped from a file outlive it.
+    char const* path = "tests_shared.bin";
+
+    write_file(path, "", 0);
+    shared = VecShared_new(Vec_open_mmap(path, sizeof(int64_t), 0));
+    assert(shared != NULL);
+    reader = VecShared_join(shared);
+    assert(reader != NULL);
+    assert(true == VecShared_update(shared, append_sequence, (void*) &three));
+    assert(0 == VecShared_reclaim(shared)); // The mapped version's gone.
+    assert(true == VecShared_update(shared, append_sequence, (void*) &three));
+    pinned = VecShared_pin(reader);
+    assert(6 == Vec_count(pinned));
+    assert(5 == *(int64_t const*) Vec_get(pinned, 5));
+    VecShared_unpin(reader);
+    VecShared_leave(&reader);
+    VecShared_destroy(&shared);
+    remove(path);
+
+    // A writer publishing while several readers read
+    SharedJob job =
+    {
+        .shared = VecShared_new(Vec_new(1, sizeof(int64_t))),
+        .updates = 200,
+        .per_update = 50
+    };
+    VecThreads* pool = VecThreads_new(4);
+
+    assert(job.shared != NULL);
+    assert(pool != NULL);
+    assert(true == VecThreads_for(pool, 4, shared_task, &job));
+    assert(0 == VecShared_reclaim(job.shared));
+    VecShared_destroy(&job.shared);
+    VecThreads_destroy(&pool);
+}
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &(int64_t){5}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-4}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){42}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &max_actual, sizeof(int64_t))); // Max
-    assert(true == Vec_append(v, &(int64_t){0}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){-777}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){39}, sizeof(int64_t)));
-    assert(true == Vec_append(v, &(int64_t){4}, sizeof(int64_t)));
-    assert(10 == Vec_count(v));
+/**
+ * @brief A record with a few fields, as kept in a structure-of-arrays test
+ */
+typedef struct
+{
+    uint64_t id;
+    double price;
+    char name[48];
+} Item;
 
-    // Find the maximum value in the vector.
-    int64_t min = INT64_MIN;
-    int64_t* max = &min; // Initialize to the smallest value to find max
-    int const success = 0; // Processed all elements
+/**
+ * @brief The fields of an `Item`
+ */
+static VecSoAField const ITEM_FIELDS[3] =
+{
+    { offsetof(Item, id), sizeof(uint64_t) },
+    { offsetof(Item, price), sizeof(double) },
+    { offsetof(Item, name), 48 }
+};
 
-    assert(success == Vec_apply(v, store_max, max));
-    assert(*max == max_actual); // The max value should have been found.
+/**
+ * @brief Makes the `Item` with the given ID (whose other fields follow from it)
+ */
+static Item make_item(uint64_t const id)
+{
+    Item item = { .id = id, .price = (double) id / 4 };
 
-    Vec_destroy(&v);
+    snprintf(item.name,
+             sizeof(item.name),
+             "item %llu",
+             (unsigned long long) id);
+
+    return item;
 }
 
 /**
- * @brief Records the number of green `Fish` seen so far
- * @param element A `Fish`
- * @param element_size For size-based type checking
- * @param state Used to update the number of green `Fish` seen so far
- * @return 1 if there was an input problem; 0 otherwise
+ * @brief Checks whether the given price is (at least) 10
  */
-static int count_green_fish(void* element,
-                            size_t const element_size,
-                            void* state)
+static bool expensive(void const* element, size_t const element_size)
 {
-    if (element == NULL ||
-        state == NULL ||
-        sizeof(Fish) != element_size) // Explicit size check
+    assert(sizeof(double) == element_size);
+
+    return *(double const*) element >= 10;
+}
+
+/**
+ * @brief Doubles the given price
+ */
+static int double_price(void* element, size_t const element_size, void* state)
+{
+    (void) state;
+    assert(sizeof(double) == element_size);
+    *(double*) element *= 2;
+
+    return 0;
+}
+
+/**
+ * @brief An allocation function that just calls `malloc()`
+ */
+static void* malloc_allocate(void* context, size_t size)
+{
+    (void) context;
+
+    return malloc(size);
+}
+
+/**
+ * @brief A deallocation function that just calls `free()`
+ */
+static void free_deallocate(void* context, void* block, size_t size)
+{
+    (void) context;
+    (void) size;
+    free(block);
+}
+
+/**
+ * @brief A reallocation function that fails to give any block more bytes than
+ * its context says, as if out of memory
+ */
+static void* capped_reallocate(void* context,
+                               void* block,
+                               size_t old_size,
+                               size_t new_size)
+{
+    (void) old_size;
+
+    return (new_size <= *(size_t const*) context) ? realloc(block, new_size)
+                                                  : NULL;
+}
+
+static void test_soa_invalid(void)
+{
+    VecSoAField const empty_field[1] = { { 0, 0 } };
+    VecSoAField const past_end[1] = { { 60, 8 } };
+
+    assert(NULL == VecSoA_new(0, sizeof(Item), ITEM_FIELDS, 3, NULL));
+    assert(NULL == VecSoA_new(1, 0, ITEM_FIELDS, 3, NULL));
+    assert(NULL == VecSoA_new(1, sizeof(Item), NULL, 3, NULL));
+    assert(NULL == VecSoA_new(1, sizeof(Item), ITEM_FIELDS, 0, NULL));
+    assert(NULL == VecSoA_new(1, sizeof(Item), empty_field, 1, NULL));
+    assert(NULL == VecSoA_new(1, sizeof(Item), past_end, 1, NULL));
+    VecSoA_destroy(NULL);
+
+    VecSoA* soa = VecSoA_new(1, sizeof(Item), ITEM_FIELDS, 3, NULL);
+    Item item = make_item(1);
+
+    assert(soa != NULL);
+    assert(0 == VecSoA_count(NULL));
+    assert(NULL == VecSoA_column(NULL, 0));
+    assert(NULL == VecSoA_column(soa, 3));
+    assert(false == VecSoA_append(NULL, &item, sizeof(item)));
+    assert(false == VecSoA_append(soa, NULL, sizeof(item)));
+    assert(false == VecSoA_append(soa, &item, sizeof(item) - 1));
+    assert(false == VecSoA_get(soa, 0, &item, sizeof(item))); // Empty
+    assert(false == VecSoA_set(soa, 0, &item, sizeof(item)));
+    VecSoA_remove(soa, 0);
+    VecSoA_remove(NULL, 0);
+    assert(1 == VecSoA_apply(soa, 1, double_price, NULL)); // Empty
+
+    assert(true == VecSoA_append(soa, &item, sizeof(item)));
+    assert(false == VecSoA_get(NULL, 0, &item, sizeof(item)));
+    assert(false == VecSoA_get(soa, 0, NULL, sizeof(item)));
+    assert(false == VecSoA_get(soa, 1, &item, sizeof(item)));
+    assert(false == VecSoA_set(soa, 1, &item, sizeof(item)));
+    assert(1 == VecSoA_where(soa, 3, &item.id, sizeof(item.id)));
+    assert(1 == VecSoA_where(soa, 0, &item.id, sizeof(item.id) - 1));
+    assert(1 == VecSoA_where_if(soa, 3, expensive));
+    assert(1 == VecSoA_apply(soa, 3, double_price, NULL));
+    assert(1 == VecSoA_apply(NULL, 1, double_price, NULL));
+    assert(0 == VecSoA_remove_all_if(soa, 3, expensive));
+    assert(0 == VecSoA_remove_all_if(soa, 1, NULL));
+    assert(0 == VecSoA_remove_all_if(NULL, 1, expensive));
+    assert(1 == VecSoA_count(soa));
+
+    VecSoA_destroy(&soa);
+    assert(soa == NULL);
+
+    // A column failing to grow takes the record back out of the others.
+    size_t cap = 64;
+    VecAllocator const allocator =
     {
-        return 1; // Input error
+        .allocate = malloc_allocate,
+        .reallocate = capped_reallocate,
+        .deallocate = free_deallocate,
+        .context = &cap
+    };
+    VecOptions const options = { .allocator = &allocator };
+
+    soa = VecSoA_new(1, sizeof(Item), ITEM_FIELDS, 3, &options);
+    assert(soa != NULL);
+    assert(true == VecSoA_append(soa, &item, sizeof(item)));
+    assert(false == VecSoA_append(soa, &item, sizeof(item))); // Names too big
+    assert(1 == VecSoA_count(soa));
+    for (size_t i = 0; i < 3; ++i)
+    {
+        assert(1 == Vec_count(VecSoA_column(soa, i)));
     }
+    VecSoA_destroy(&soa);
+}
 
-    Fish const* f = (Fish const*) element;
-    size_t* green_fish_count = (size_t*) state;
+static void test_soa(void)
+{
+    size_t const count = 100;
+    VecSoA* soa = VecSoA_new(8, sizeof(Item), ITEM_FIELDS, 3, NULL);
 
-    if (f->color == GREEN)
+    assert(soa != NULL);
+    for (uint64_t id = 0; id < count; ++id)
     {
-        *green_fish_count += 1;
+        Item const item = make_item(id);
+
+        assert(true == VecSoA_append(soa, &item, sizeof(item)));
+    }
+    assert(count == VecSoA_count(soa));
+
+    // Each column holds one field of every record, in order.
+    Vec const* ids = VecSoA_column(soa, 0);
+    Vec const* prices = VecSoA_column(soa, 1);
+
+    assert(count == Vec_count(ids));
+    assert(sizeof(uint64_t) == Vec_element_size(ids));
+    assert(sizeof(double) == Vec_element_size(prices));
+    assert(42 == *(uint64_t const*) Vec_get(ids, 42));
+    assert(10.5 == *(double const*) Vec_get(prices, 42));
+
+    // Records come back out whole.
+    Item item;
+    Item expected = make_item(42);
+
+    assert(true == VecSoA_get(soa, 42, &item, sizeof(item)));
+    assert(0 == memcmp(&item, &expected, sizeof(item)));
+
+    // Searches look at one column.
+    assert(7 == VecSoA_where(soa, 0, &(uint64_t){7}, sizeof(uint64_t)));
+    assert(count == VecSoA_where(soa, 0, &(uint64_t){count},
+                                 sizeof(uint64_t)));
+    assert(40 == VecSoA_where_if(soa, 1, expensive));
+    expected = make_item(3);
+    assert(3 == VecSoA_where(soa, 2, expected.name, sizeof(expected.name)));
+
+    // Applying to a column changes only that field.
+    assert(0 == VecSoA_apply(soa, 1, double_price, NULL));
+    assert(true == VecSoA_get(soa, 42, &item, sizeof(item)));
+    assert(21 == item.price);
+    assert(42 == item.id);
+    assert(0 == strcmp("item 42", item.name));
+    assert(20 == VecSoA_where_if(soa, 1, expensive));
+
+    // Removing by one field removes whole records, keeping columns in step.
+    assert(count - 20 == VecSoA_remove_all_if(soa, 1, expensive));
+    assert(20 == VecSoA_count(soa));
+    for (size_t i = 0; i < 3; ++i)
+    {
+        assert(20 == Vec_count(VecSoA_column(soa, i)));
+    }
+    assert(0 == VecSoA_remove_all_if(soa, 1, expensive));
+    for (uint64_t id = 0; id < 20; ++id)
+    {
+        assert(true == VecSoA_get(soa, (size_t) id, &item, sizeof(item)));
+        expected = make_item(id);
+        expected.price *= 2;
+        assert(0 == memcmp(&item, &expected, sizeof(item)));
     }
 
-    return 0;
+    // Row-level overwriting and removal
+    expected = make_item(1000);
+    assert(true == VecSoA_set(soa, 5, &expected, sizeof(expected)));
+    assert(5 == VecSoA_where(soa, 0, &(uint64_t){1000}, sizeof(uint64_t)));
+    VecSoA_remove(soa, 5);
+    assert(19 == VecSoA_count(soa));
+    assert(19 == VecSoA_where(soa, 0, &(uint64_t){1000}, sizeof(uint64_t)));
+    assert(5 == VecSoA_where(soa, 0, &(uint64_t){6}, sizeof(uint64_t)));
+    assert(true == VecSoA_get(soa, 5, &item, sizeof(item)));
+    assert(0 == strcmp("item 6", item.name));
+
+    // Bytes outside the fields come back as zeros.
+    VecSoAField const id_only[1] = { { offsetof(Item, id), sizeof(uint64_t) } };
+    VecSoA* partial = VecSoA_new(1, sizeof(Item), id_only, 1, NULL);
+
+    assert(partial != NULL);
+    expected = make_item(9);
+    assert(true == VecSoA_append(partial, &expected, sizeof(expected)));
+    memset(&item, 0xFF, sizeof(item));
+    assert(true == VecSoA_get(partial, 0, &item, sizeof(item)));
+    assert(9 == item.id);
+    assert(0 == item.price);
+    assert('\0' == item.name[0]);
+
+    VecSoA_destroy(&partial);
+    VecSoA_destroy(&soa);
 }
 
-static void test_apply_state_struct(void)
+static void test_seg_invalid(void)
 {
-    // Make a vector with some green `Fish`.
-    size_t greens_added = 0;
-    size_t const total = 100;
-    Vec* v = Vec_new(10, sizeof(Fish)); // Smaller than `total` for resizing
+    VecAllocator const incomplete = { .allocate = malloc_allocate };
 
-    assert(v != NULL);
-    // Just for fun, let's have a random number of green ones.
-    srand(time(NULL));
-    for (size_t i = 0; i < total; ++i)
-    {
-        int const die = rand() % COLOR_NUM;
+    assert(NULL == VecSeg_new(0, sizeof(int64_t), NULL));
+    assert(NULL == VecSeg_new(4, 0, NULL));
+    assert(NULL == VecSeg_new(SIZE_MAX, sizeof(int64_t), NULL));
+    assert(NULL == VecSeg_new(SIZE_MAX / 4, sizeof(int64_t), NULL));
+    assert(NULL == VecSeg_new(4, sizeof(int64_t), &incomplete));
+    VecSeg_destroy(NULL);
 
-        switch(die)
-        {
-            case 0: // Red
-                assert(true == Vec_append(v,
-                                          &(Fish)
-                                          {
-                                              .color = RED,
-                                              .size = 1
-                                          },
-                                          sizeof(Fish)));
-                break;
-            case 1: // Green
-                assert(true == Vec_append(v,
-                                          &(Fish)
-                                          {
-                                              .color = GREEN,
-                                              .size = 1
-                                          },
-                                          sizeof(Fish)));
-                greens_added++; // Note that we added a green.
-                break;
-            default: // Blue
-                assert(true == Vec_append(v,
-                                          &(Fish)
-                                          {
-                                              .color = BLUE,
-                                              .size = 1
-                                          },
-                                          sizeof(Fish)));
-        }
-    }
+    VecSeg* v = VecSeg_new(4, sizeof(int64_t), NULL);
+    size_t chunk_count = 0;
 
-    size_t greens_counted = 0;
-    size_t* greens_counted_ptr = &greens_counted;
-    int const success = 0; // Processed all elements
+    assert(v != NULL);
+    assert(0 == VecSeg_count(NULL));
+    assert(0 == VecSeg_capacity(NULL));
+    assert(0 == VecSeg_chunk_capacity(NULL));
+    assert(false == VecSeg_reserve(NULL, 4));
+    VecSeg_shrink_to_fit(NULL);
+    assert(NULL == VecSeg_get(NULL, 0));
+    assert(NULL == VecSeg_get(v, 0));
+    assert(NULL == VecSeg_chunk(NULL, 0, &chunk_count));
+    assert(NULL == VecSeg_chunk(v, 0, NULL));
+    assert(NULL == VecSeg_chunk(v, 0, &chunk_count));
+    assert(false == VecSeg_append(NULL, &(int64_t){1}, sizeof(int64_t)));
+    assert(false == VecSeg_append(v, NULL, sizeof(int64_t)));
+    assert(false == VecSeg_append(v, &(int32_t){1}, sizeof(int32_t)));
+    assert(false == VecSeg_insert(NULL, 0, &(int64_t){1}, sizeof(int64_t)));
+    assert(false == VecSeg_insert(v, 0, NULL, sizeof(int64_t)));
+    assert(false == VecSeg_insert(v, 0, &(int32_t){1}, sizeof(int32_t)));
+    assert(false == VecSeg_insert(v, 1, &(int64_t){1}, sizeof(int64_t)));
+    assert(0 == VecSeg_remove(NULL, 0));
+    assert(0 == VecSeg_remove(v, 0));
+    assert(0 == VecSeg_remove_all_if(NULL, is_multiple_of_7));
+    assert(0 == VecSeg_remove_all_if(v, NULL));
+    assert(0 == VecSeg_where(NULL, &(int64_t){1}, sizeof(int64_t)));
+    assert(0 == VecSeg_where(v, NULL, sizeof(int64_t)));
+    assert(0 == VecSeg_where(v, &(int32_t){1}, sizeof(int32_t)));
+    assert(0 == VecSeg_where_if(NULL, is_multiple_of_7));
+    assert(0 == VecSeg_where_if(v, NULL));
+    assert(false == VecSeg_has(NULL, &(int64_t){1}, sizeof(int64_t)));
+    assert(1 == VecSeg_apply(NULL, add_one, NULL));
+    assert(1 == VecSeg_apply(v, NULL, NULL));
+    assert(1 == VecSeg_apply(v, add_one, NULL)); // Empty
+    assert(0 == VecSeg_count(v));
+
+    // Failing to allocate the vector itself
+    VecAllocator const failing =
+    {
+        .allocate = failing_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = free_deallocate
+    };
 
-    assert(success == Vec_apply(v, count_green_fish, greens_counted_ptr));
-    assert(*greens_counted_ptr == greens_added); // The count is correct
+    assert(NULL == VecSeg_new(4, sizeof(int64_t), &failing));
 
-    Vec_destroy(&v);
+    VecSeg_destroy(&v);
+    assert(NULL == v);
 }
 
-/**
- * @brief Counts the number of blue `Fish` seen so far, requesting termination
- * when seeing a red or a green `Fish`
- * @param element A `Fish`
- * @param element_size For size-based type checking
- * @param state Used to update the number of blue `Fish` seen so far
- * @return 1 if there was an input problem; 0 if a blue `Fish` was seen and
- * counting should proceed; 2 if a red `Fish` was seen and counting should stop;
- * 3 if a green `Fish` was seen and counting should stop
- */
-static int count_to_red_and_green_fish(void* element,
-                                       size_t const element_size,
-                                       void* state)
-{
-    if (element == NULL ||
-        state == NULL ||
-        sizeof(Fish) != element_size)
+static void test_seg(void)
+{
+    Counts counts = {0};
+    VecAllocator const counting =
     {
-        return 1; // Input error
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counts
+    };
+    VecSeg* v = VecSeg_new(5, sizeof(int64_t), &counting);
+
+    // Chunk capacities round up to powers of 2, and chunks come as needed.
+    assert(v != NULL);
+    assert(8 == VecSeg_chunk_capacity(v));
+    assert(0 == VecSeg_capacity(v));
+    assert(true == VecSeg_reserve(v, 9));
+    assert(16 == VecSeg_capacity(v));
+
+    // Growing never moves elements.
+    size_t const count = 1000;
+    int64_t* first = NULL;
+
+    for (int64_t i = 0; i < (int64_t) count; ++i)
+    {
+        assert(true == VecSeg_append(v, &i, sizeof(i)));
+        if (i == 0)
+        {
+            first = VecSeg_get(v, 0);
+        }
+        assert(first == VecSeg_get(v, 0));
+    }
+    assert(count == VecSeg_count(v));
+    assert(count == VecSeg_capacity(v));
+    for (size_t i = 0; i < count; ++i)
+    {
+        assert((int64_t) i == *(int64_t const*) VecSeg_get(v, i));
     }
+    assert(NULL == VecSeg_get(v, count));
+
+    // Chunks can be scanned directly.
+    size_t chunk_count = 0;
+    int64_t const* chunk = VecSeg_chunk(v, 124, &chunk_count);
+
+    assert(chunk != NULL);
+    assert(8 == chunk_count);
+    assert(992 == chunk[0]);
+    assert(NULL == VecSeg_chunk(v, 125, &chunk_count));
+    assert(true == VecSeg_append(v, &(int64_t){1000}, sizeof(int64_t)));
+    chunk = VecSeg_chunk(v, 125, &chunk_count);
+    assert(1 == chunk_count);
+    assert(1000 == chunk[0]);
+    VecSeg_remove(v, count);
+
+    // Searching
+    assert(500 == VecSeg_where(v, &(int64_t){500}, sizeof(int64_t)));
+    assert(count == VecSeg_where(v, &(int64_t){-1}, sizeof(int64_t)));
+    assert(true == VecSeg_has(v, &(int64_t){999}, sizeof(int64_t)));
+    assert(false == VecSeg_has(v, &(int64_t){1000}, sizeof(int64_t)));
+    assert(0 == VecSeg_where_if(v, is_multiple_of_7));
+    assert(0 == VecSeg_apply(v, add_one, NULL));
+    assert(6 == VecSeg_where_if(v, is_multiple_of_7));
+    assert(1000 == *(int64_t const*) VecSeg_get(v, count - 1));
+
+    // Inserting and removing shift elements across chunks, like a `Vec`.
+    Vec* expected = Vec_new(count, sizeof(int64_t));
 
-    Fish const* f = (Fish const*) element;
-    size_t* non_red_count = (size_t*) state;
+    assert(expected != NULL);
+    for (size_t i = 0; i < count; ++i)
+    {
+        assert(true == Vec_append(expected, VecSeg_get(v, i), sizeof(int64_t)));
+    }
 
-    if (f->color == RED)
+    size_t const spots[] = { 0, 7, 8, 9, 500, 993, 1000 };
+
+    for (size_t i = 0; i < sizeof(spots) / sizeof(spots[0]); ++i)
     {
-        return 2; // Red `Fish` seen; stop the count.
+        int64_t const item = -(int64_t) i;
+        size_t const spot = spots[i];
+
+        assert(true == VecSeg_insert(v, spot, &item, sizeof(item)));
+        assert(true == Vec_insert(expected, spot, &item, sizeof(item)));
     }
-    else if (f->color == GREEN)
+    assert(Vec_count(expected) == VecSeg_count(v));
+    for (size_t i = 0; i < Vec_count(expected); ++i)
     {
-        return 3; // Green `Fish` seen; stop the count.
+        assert(0 == memcmp(Vec_get(expected, i),
+                           VecSeg_get(v, i),
+                           sizeof(int64_t)));
     }
-    else
+    for (size_t i = 0; i < sizeof(spots) / sizeof(spots[0]); ++i)
     {
-        // Non-red `Fish` seen; update the count and proceed.
-        *non_red_count += 1;
+        size_t const spot = spots[i] % VecSeg_count(v);
 
-        return 0;
+        assert(spot == VecSeg_remove(v, spot));
+        Vec_remove(expected, spot);
+    }
+    assert(Vec_count(expected) == VecSeg_count(v));
+    for (size_t i = 0; i < Vec_count(expected); ++i)
+    {
+        assert(0 == memcmp(Vec_get(expected, i),
+                           VecSeg_get(v, i),
+                           sizeof(int64_t)));
     }
-}
 
-static void test_apply_early_return_head(void)
-{
-    // Make a vector with a stop-worthy element at the beginning.
-    Fish const stop = (Fish)
+    // Removing in one pass
+    size_t const removed = Vec_remove_all_if(expected, is_multiple_of_7);
+
+    assert(removed == VecSeg_remove_all_if(v, is_multiple_of_7));
+    assert(Vec_count(expected) == VecSeg_count(v));
+    for (size_t i = 0; i < Vec_count(expected); ++i)
     {
-        .color = RED,
-        .size = 1
-    };
-    Fish const go = (Fish)
+        assert(0 == memcmp(Vec_get(expected, i),
+                           VecSeg_get(v, i),
+                           sizeof(int64_t)));
+    }
+    assert(VecSeg_count(v) == VecSeg_where_if(v, is_multiple_of_7));
+
+    // Emptying the vector, then shrinking it, frees every chunk.
+    while (VecSeg_count(v) > 0)
     {
-        .color = BLUE,
-        .size = 1
-    };
-    int const stop_error = 2;
-    size_t const count = 7;
-    Vec* v = Vec_new(count, sizeof(Fish));
+        VecSeg_remove(v, VecSeg_count(v) - 1);
+    }
+    VecSeg_shrink_to_fit(v);
+    assert(0 == VecSeg_capacity(v));
+    assert(true == VecSeg_append(v, &(int64_t){3}, sizeof(int64_t)));
+    assert(8 == VecSeg_capacity(v));
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(count == Vec_count(v));
+    Vec_destroy(&expected);
+    VecSeg_destroy(&v);
+    assert(0 == counts.allocations);
+    assert(0 == counts.bytes);
+}
 
-    /*
-     * We should iterate the correct number of times before hitting the
-     * stop-worthy element.
-     */
-    size_t const iterations_expected = 0;
-    size_t iterations = 0;
-    size_t* p = &iterations;
+static bool is_odd_ctx(void const* element,
+                       size_t const element_size,
+                       void* context)
+{
+    (void) context;
 
-    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
-    assert(*p == iterations_expected);
+    return element_size == sizeof(int64_t) &&
+           (*(int64_t const*) element) % 2 != 0;
+}
 
-    Vec_destroy(&v);
+static void times_ctx(void const* element,
+                      size_t const element_size,
+                      void* result,
+                      void* context)
+{
+    (void) element_size;
+
+    *(double*) result = (double) (*(int64_t const*) element) *
+                        (*(double const*) context);
 }
 
-static void test_apply_early_return_middle(void)
+static void halve_ctx(void const* element,
+                      size_t const element_size,
+                      void* result,
+                      void* context)
 {
-    // Make a vector with a stop-worthy element at the middle.
-    Fish const stop = (Fish)
-    {
-        .color = RED,
-        .size = 1
-    };
-    Fish const go = (Fish)
-    {
-        .color = BLUE,
-        .size = 1
-    };
-    int const stop_error = 2;
-    size_t const count = 7;
-    Vec* v = Vec_new(count, sizeof(Fish));
+    (void) element_size;
+    (void) context;
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(count == Vec_count(v));
+    *(double*) result = *(double const*) element / 2;
+}
 
-    /*
-     * We should iterate the correct number of times before hitting the
-     * stop-worthy element.
-     */
-    size_t const iterations_expected = 3;
-    size_t iterations = 0;
-    size_t* p = &iterations;
+static bool is_below_ctx(void const* element,
+                         size_t const element_size,
+                         void* context)
+{
+    (void) element_size;
 
-    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
-    assert(*p == iterations_expected);
+    return *(double const*) element < *(double const*) context;
+}
+
+static void test_cursor_invalid(void)
+{
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    int64_t batch[4] = {0};
+
+    assert(v != NULL);
+    assert(NULL == VecCursor_new(NULL));
+    VecCursor_destroy(NULL);
+
+    VecCursor* c = VecCursor_new(v);
+
+    assert(c != NULL);
+    assert(false == VecCursor_filter(NULL, is_odd_ctx, NULL));
+    assert(false == VecCursor_filter(c, NULL, NULL));
+    assert(false == VecCursor_map(NULL, sizeof(double), times_ctx, NULL));
+    assert(false == VecCursor_map(c, 0, times_ctx, NULL));
+    assert(false == VecCursor_map(c, sizeof(double), NULL, NULL));
+    assert(0 == VecCursor_element_size(NULL));
+    assert(0 == VecCursor_position(NULL));
+    assert(true == VecCursor_done(NULL));
+    assert(false == VecCursor_seek(NULL, 0));
+    assert(false == VecCursor_seek(c, 1));
+    assert(0 == VecCursor_next(NULL, batch, 4, sizeof(int64_t)));
+    assert(0 == VecCursor_next(c, NULL, 4, sizeof(int64_t)));
+    assert(NULL == VecCursor_collect(NULL));
+
+    // An empty vector gives nothing, but collects into an empty vector.
+    assert(true == VecCursor_done(c));
+    assert(0 == VecCursor_next(c, batch, 4, sizeof(int64_t)));
+
+    Vec* collected = VecCursor_collect(c);
+
+    assert(collected != NULL);
+    assert(0 == Vec_count(collected));
+    Vec_destroy(&collected);
+
+    // Batches have to be of what the cursor produces.
+    assert(true == Vec_append(v, &(int64_t){1}, sizeof(int64_t)));
+    assert(true == VecCursor_map(c, sizeof(double), times_ctx, &(double){2}));
+    assert(0 == VecCursor_next(c, batch, 4, sizeof(int32_t)));
+    assert(0 == VecCursor_position(c));
 
+    VecCursor_destroy(&c);
+    assert(c == NULL);
     Vec_destroy(&v);
 }
 
-static void test_apply_early_return_tail(void)
+static void test_cursor(void)
 {
-    // Make a vector with a stop-worthy element at the end.
-    Fish const stop = (Fish)
+    size_t const count = 100;
+    Vec* v = Vec_new(count, sizeof(int64_t));
+
+    assert(v != NULL);
+    for (int64_t i = 0; i < (int64_t) count; ++i)
     {
-        .color = RED,
-        .size = 1
-    };
-    Fish const go = (Fish)
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+
+    // Without stages, batches are runs of the vector, resumable at any point.
+    VecCursor* c = VecCursor_new(v);
+    int64_t batch[8] = {0};
+
+    assert(c != NULL);
+    assert(sizeof(int64_t) == VecCursor_element_size(c));
+    assert(8 == VecCursor_next(c, batch, 8, sizeof(int64_t)));
+    assert(0 == batch[0] && 7 == batch[7]);
+    assert(8 == VecCursor_position(c));
+    assert(8 == VecCursor_next(c, batch, 8, sizeof(int64_t)));
+    assert(8 == batch[0] && 15 == batch[7]);
+    assert(true == VecCursor_seek(c, 97));
+    assert(3 == VecCursor_next(c, batch, 8, sizeof(int64_t)));
+    assert(97 == batch[0] && 99 == batch[2]);
+    assert(true == VecCursor_done(c));
+    assert(0 == VecCursor_next(c, batch, 8, sizeof(int64_t)));
+
+    // It picks up elements appended while it's paused.
+    assert(true == Vec_append(v, &(int64_t){100}, sizeof(int64_t)));
+    assert(false == VecCursor_done(c));
+    assert(1 == VecCursor_next(c, batch, 8, sizeof(int64_t)));
+    assert(100 == batch[0]);
+    Vec_remove(v, count);
+
+    // Collecting without stages copies the rest of the vector.
+    assert(true == VecCursor_seek(c, 90));
+
+    Vec* rest = VecCursor_collect(c);
+
+    assert(rest != NULL);
+    assert(10 == Vec_count(rest));
+    assert(90 == *(int64_t const*) Vec_get(rest, 0));
+    assert(true == VecCursor_done(c));
+    Vec_destroy(&rest);
+    VecCursor_destroy(&c);
+
+    // Filters and maps run lazily, element by element, as batches are taken.
+    double rate = 0.5;
+    double limit = 40;
+    double results[8] = {0};
+
+    c = VecCursor_new(v);
+    assert(c != NULL);
+    assert(true == VecCursor_filter(c, is_odd_ctx, NULL));
+    assert(true == VecCursor_map(c, sizeof(double), times_ctx,
+                                 &rate));
+    assert(sizeof(double) == VecCursor_element_size(c));
+    assert(4 == VecCursor_next(c, results, 4, sizeof(double)));
+    assert(0.5 == results[0] && 3.5 == results[3]);
+    assert(8 == VecCursor_position(c));
+
+    // Stages can follow a map, and see its results.
+    assert(true == VecCursor_filter(c, is_below_ctx, &limit));
+    assert(8 == VecCursor_next(c, results, 8, sizeof(double)));
+    assert(4.5 == results[0] && 11.5 == results[7]);
+
+    // Collecting fuses the stages into one pass over the rest.
+    Vec* collected = VecCursor_collect(c);
+
+    assert(collected != NULL);
+    assert(sizeof(double) == Vec_element_size(collected));
+    assert(28 == Vec_count(collected));
+    for (size_t i = 0; i < Vec_count(collected); ++i)
     {
-        .color = BLUE,
-        .size = 1
-    };
-    int const stop_error = 2;
-    size_t const count = 7;
-    Vec* v = Vec_new(count, sizeof(Fish));
+        double const expected = (double) (25 + 2 * i) * rate;
 
-    assert(v != NULL);
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
-    assert(count == Vec_count(v));
+        assert(expected == *(double const*) Vec_get(collected, i));
+    }
+    assert(true == VecCursor_done(c));
+    Vec_destroy(&collected);
+
+    // A map feeding another map goes through the first map's own result.
+    double twice = 2;
+    Vec* doubled = NULL;
+
+    VecCursor_destroy(&c);
+    c = VecCursor_new(v);
+    assert(c != NULL);
+    assert(true == VecCursor_map(c, sizeof(double), times_ctx,
+                                 &twice));
+    assert(true == VecCursor_map(c, sizeof(double), halve_ctx, NULL));
+    doubled = VecCursor_collect(c);
+    assert(doubled != NULL);
+    assert(count == Vec_count(doubled));
+    assert(99 == *(double const*) Vec_get(doubled, count - 1));
+    Vec_destroy(&doubled);
+
+    VecCursor_destroy(&c);
+    Vec_destroy(&v);
+}
 
-    /*
-     * We should iterate the correct number of times before hitting the
-     * stop-worthy element.
-     */
-    size_t const iterations_expected = 6;
-    size_t iterations = 0;
-    size_t* p = &iterations;
+static void test_bits_invalid(void)
+{
+    VecBits* b = VecBits_new(10);
+    VecBits* other = VecBits_new(11);
+    Vec* v = Vec_new(4, sizeof(int64_t));
+    uint64_t mask[1] = {0};
 
-    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
-    assert(*p == iterations_expected);
+    assert(b != NULL);
+    assert(other != NULL);
+    assert(v != NULL);
+    VecBits_destroy(NULL);
+
+    assert(NULL == VecBits_from_if(NULL, is_multiple_of_7));
+    assert(NULL == VecBits_from_if(v, NULL));
+    assert(0 == VecBits_count(NULL));
+    assert(false == VecBits_resize(NULL, 1));
+    assert(NULL == VecBits_words(NULL));
+    assert(false == VecBits_get(NULL, 0));
+    assert(false == VecBits_get(b, 10));
+    assert(false == VecBits_set(NULL, 0, true));
+    assert(false == VecBits_set(b, 10, true));
+    VecBits_fill(NULL, true);
+    assert(0 == VecBits_popcount(NULL));
+    assert(0 == VecBits_first_set(NULL, 0));
+    assert(10 == VecBits_first_set(b, 11));
+    VecBits_not(NULL);
+
+    // Combining needs two bit vectors of the same count.
+    VecBits_fill(other, true);
+    assert(false == VecBits_and(NULL, other));
+    assert(false == VecBits_and(b, NULL));
+    assert(false == VecBits_and(b, other));
+    assert(false == VecBits_or(b, other));
+    assert(0 == VecBits_popcount(b));
+
+    // Masks have to be for the whole vector.
+    assert(true == Vec_append(v, &(int64_t){7}, sizeof(int64_t)));
+    mask[0] = 1;
+    assert(0 == Vec_where_masked(NULL, mask, 1));
+    assert(1 == Vec_where_masked(v, NULL, 1));
+    assert(1 == Vec_where_masked(v, mask, 2));
+    assert(0 == Vec_remove_all_masked(NULL, mask, 1));
+    assert(0 == Vec_remove_all_masked(v, NULL, 1));
+    assert(0 == Vec_remove_all_masked(v, mask, 0));
+    assert(1 == Vec_apply_masked(NULL, mask, 1, add_one, NULL));
+    assert(1 == Vec_apply_masked(v, NULL, 1, add_one, NULL));
+    assert(1 == Vec_apply_masked(v, mask, 2, add_one, NULL));
+    assert(1 == Vec_apply_masked(v, mask, 1, NULL, NULL));
+    assert(1 == Vec_count(v));
+    assert(7 == *(int64_t const*) Vec_get(v, 0));
 
+    VecBits_destroy(&b);
+    assert(b == NULL);
+    VecBits_destroy(&other);
     Vec_destroy(&v);
 }
 
-static void test_apply_early_return_different_error_codes(void)
+static void test_bits(void)
 {
-    // Make a vector with a stop-worthy element somewhere.
-    Fish const stop = (Fish)
-    {
-        .color = RED,
-        .size = 1
-    };
-    Fish const stop_different = (Fish)
+    // Bits start clear, and are set and found one by one.
+    size_t const count = 300;
+    VecBits* b = VecBits_new(count);
+
+    assert(b != NULL);
+    assert(count == VecBits_count(b));
+    assert(0 == VecBits_popcount(b));
+    assert(count == VecBits_first_set(b, 0));
+
+    size_t const spots[] = { 0, 1, 63, 64, 65, 200, 299 };
+    size_t const spot_count = sizeof(spots) / sizeof(spots[0]);
+
+    for (size_t i = 0; i < spot_count; ++i)
     {
-        .color = GREEN,
-        .size = 1
-    };
-    Fish const go = (Fish)
+        assert(true == VecBits_set(b, spots[i], true));
+    }
+    assert(spot_count == VecBits_popcount(b));
+    for (size_t i = 0, at = 0; i < spot_count; ++i, ++at)
     {
-        .color = BLUE,
-        .size = 1
-    };
-    int const stop_error = 2;
-    int const stop_different_error = 3;
-    size_t const count = 7;
-    Vec* v = Vec_new(count, sizeof(Fish));
+        at = VecBits_first_set(b, at);
+        assert(spots[i] == at);
+        assert(true == VecBits_get(b, at));
+    }
+    assert(count == VecBits_first_set(b, 300));
+    assert(false == VecBits_get(b, 2));
+    assert(true == VecBits_set(b, 63, false));
+    assert(64 == VecBits_first_set(b, 2));
+
+    // Flipping never sets the bits past the last one.
+    VecBits_not(b);
+    assert(count - (spot_count - 1) == VecBits_popcount(b));
+    assert(false == VecBits_get(b, 0));
+    assert(true == VecBits_get(b, 63));
+    VecBits_fill(b, true);
+    assert(count == VecBits_popcount(b));
+    VecBits_fill(b, false);
+    assert(0 == VecBits_popcount(b));
+
+    // Resizing keeps the old bits and clears the new ones.
+    VecBits_fill(b, true);
+    assert(true == VecBits_resize(b, 70));
+    assert(70 == VecBits_popcount(b));
+    assert(true == VecBits_resize(b, 1000));
+    assert(70 == VecBits_popcount(b));
+    assert(1000 == VecBits_first_set(b, 70));
+    assert(true == VecBits_resize(b, 0));
+    assert(NULL == VecBits_words(b));
+    assert(0 == VecBits_popcount(b));
+    VecBits_destroy(&b);
+
+    // Masks from predicates, combined
+    size_t const n = 1000;
+    Vec* v = Vec_new(n, sizeof(int64_t));
 
     assert(v != NULL);
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Stop here
-    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Unreachable
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Unreachable
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Unreachable
-    assert(count == Vec_count(v));
+    for (int64_t i = 0; i < (int64_t) n; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
 
-    /*
-     * We should iterate the correct number of times before hitting the
-     * stop-worthy element, and we should get the correct error code (that of
-     * the FIRST kind of stop-worthy element).
-     */
-    size_t iterations_expected = 1;
-    size_t iterations = 0;
-    size_t* p = &iterations;
+    VecBits* sevens = VecBits_from_if(v, is_multiple_of_7);
+    VecBits* odds = VecBits_new(n);
 
-    assert(stop_error == Vec_apply(v, count_to_red_and_green_fish, p));
-    assert(*p == iterations_expected);
+    assert(sevens != NULL);
+    assert(odds != NULL);
+    assert(n == VecBits_count(sevens));
+    assert(143 == VecBits_popcount(sevens));
+    for (size_t i = 1; i < n; i += 2)
+    {
+        assert(true == VecBits_set(odds, i, true));
+    }
+    assert(true == VecBits_or(odds, sevens));
+    assert(500 + 72 == VecBits_popcount(odds));
+    assert(true == VecBits_and(sevens, odds));
+    assert(143 == VecBits_popcount(sevens));
+    VecBits_not(odds);
+    assert(n - 572 == VecBits_popcount(odds));
+    assert(true == VecBits_and(sevens, odds));
+    assert(0 == VecBits_popcount(sevens));
+    VecBits_destroy(&odds);
+    VecBits_destroy(&sevens);
+
+    // Mask-driven searching, applying, and removing match the predicates'.
+    Vec* expected = Vec_clone(v);
+
+    sevens = VecBits_from_if(v, is_multiple_of_7);
+    assert(expected != NULL);
+    assert(sevens != NULL);
+    assert(true == VecBits_set(sevens, 0, false));
+    assert(7 == Vec_where_masked(v, VecBits_words(sevens), n));
+    assert(0 == Vec_apply_masked(v, VecBits_words(sevens), n, add_one, NULL));
+    assert(1 == *(int64_t const*) Vec_get(v, 1));
+    assert(8 == *(int64_t const*) Vec_get(v, 7));
+    assert(995 == *(int64_t const*) Vec_get(v, 994));
+    assert(0 == Vec_apply_masked(v, VecBits_words(sevens), n, add_one, NULL));
+    assert(9 == *(int64_t const*) Vec_get(v, 7));
+    VecBits_destroy(&sevens);
+    Vec_destroy(&v);
 
+    sevens = VecBits_from_if(expected, is_multiple_of_7);
+    v = Vec_clone(expected);
+    assert(sevens != NULL);
+    assert(v != NULL);
+    assert(143 == Vec_remove_all_masked(v, VecBits_words(sevens), n));
+    assert(143 == Vec_remove_all_if(expected, is_multiple_of_7));
+    assert(true == Vec_equal(v, expected, NULL));
+    VecBits_destroy(&sevens);
+
+    // An empty mask removes nothing, and a full one everything.
+    VecBits* none = VecBits_new(Vec_count(v));
+    VecBits* all = VecBits_new(Vec_count(v));
+
+    assert(none != NULL);
+    assert(all != NULL);
+    VecBits_fill(all, true);
+    assert(Vec_count(v) == Vec_where_masked(v, VecBits_words(none),
+                                            Vec_count(v)));
+    assert(0 == Vec_remove_all_masked(v, VecBits_words(none), Vec_count(v)));
+    assert(857 == Vec_remove_all_masked(v, VecBits_words(all), 857));
+    assert(0 == Vec_count(v));
+    VecBits_destroy(&none);
+    VecBits_destroy(&all);
+
+    Vec_destroy(&expected);
     Vec_destroy(&v);
+}
 
-    // Then make a vector with a different stop-worthy element somewhere.
-    v = Vec_new(count, sizeof(Fish));
+#if defined(VEC_STATS)
+/**
+ * @struct
+ * The vectors `visit_stats()` has visited, and whether one was `"squares"`
+ */
+typedef struct
+{
+    size_t visited;
+    bool found;
+} StatsVisit;
+
+static void visit_stats(Vec const* v, VecStats const* stats, void* context)
+{
+    StatsVisit* visit = (StatsVisit*) context;
 
     assert(v != NULL);
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Stop here
-    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Unreachable
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop_different, sizeof(Fish))); // Unreachable
-    assert(true == Vec_append(v, &go, sizeof(Fish)));
-    assert(true == Vec_append(v, &stop, sizeof(Fish))); // Unreachable
-    assert(count == Vec_count(v));
+    visit->visited += 1;
+    if (stats->name != NULL &&
+        strcmp(stats->name, "squares") == 0)
+    {
+        assert(sizeof(int64_t) == stats->element_size);
+        visit->found = true;
+    }
+}
 
-    /*
-     * We should iterate the correct number of times before hitting the
-     * stop-worthy element, and we should get the correct error code (that of
-     * the SECOND kind of stop-worthy element).
-     */
-    iterations_expected = 1;
-    iterations = 0;
-    p = &iterations;
+static void test_stats(void)
+{
+    VecStats stats;
 
-    assert(stop_different_error == Vec_apply(v,
-                                             count_to_red_and_green_fish,
-                                             p));
-    assert(*p == iterations_expected);
+    assert(false == Vec_stats(NULL, &stats));
+    assert(0 == Vec_visit_stats(NULL, NULL));
+
+    // Growing from 1 to 16 elements takes 4 expansions (1, 2, 4, 8, 16).
+    Vec* v = Vec_new(1, sizeof(int64_t));
+
+    assert(v != NULL);
+    assert(true == Vec_stats(v, &stats));
+    assert(NULL == stats.name);
+    assert(sizeof(int64_t) == stats.element_size);
+    assert(0 == stats.resizes);
+    assert(1 == stats.peak_capacity);
+    for (int64_t i = 0; i < 16; ++i)
+    {
+        int64_t const square = i * i;
+
+        assert(true == Vec_append(v, &square, sizeof(square)));
+    }
+    assert(true == Vec_stats(v, &stats));
+    assert(4 == stats.expansions);
+    assert(4 == stats.resizes);
+    assert((2 + 4 + 8 + 16) * sizeof(int64_t) == stats.bytes_reallocated);
+    assert(16 == stats.peak_capacity);
+    assert(0 == stats.bytes_moved);
+
+    // Inserting at the front shifts every element, and removing shifts back.
+    int64_t const item = -1;
+
+    assert(true == Vec_insert(v, 0, &item, sizeof(item)));
+    assert(true == Vec_stats(v, &stats));
+    assert(16 * sizeof(int64_t) == stats.bytes_moved);
+    assert(32 == stats.peak_capacity);
+    assert(0 == Vec_remove(v, 0));
+    assert(true == Vec_stats(v, &stats));
+    assert(32 * sizeof(int64_t) == stats.bytes_moved);
+
+    // Searches count the elements they look at, up to the one found.
+    int64_t const nine = 9;
+    int64_t const missing = 2;
+
+    assert(3 == Vec_where(v, &nine, sizeof(nine)));
+    assert(16 == Vec_where(v, &missing, sizeof(missing)));
+    assert(true == Vec_stats(v, &stats));
+    assert(2 == stats.searches);
+    assert(4 + 16 == stats.elements_searched);
+    assert(0 == stats.predicate_calls);
+    assert(0 == Vec_where_if(v, is_multiple_of_7));
+    assert(3 == Vec_remove_all_if(v, is_multiple_of_7)); // 0, 49, and 196
+    assert(true == Vec_stats(v, &stats));
+    assert(3 == stats.searches);
+    assert(1 + 16 == stats.predicate_calls);
+
+    // An index takes over the searching.
+    assert(true == Vec_enable_index(v, 0, sizeof(int64_t)));
+    assert(2 == Vec_where(v, &nine, sizeof(nine)));
+    assert(true == Vec_stats(v, &stats));
+    assert(3 == stats.searches);
+    assert(1 == stats.indexed_searches);
+
+    // Resetting keeps only the peak capacity, which becomes the capacity.
+    Vec_reset_stats(v);
+    assert(true == Vec_stats(v, &stats));
+    assert(0 == stats.expansions);
+    assert(0 == stats.bytes_moved);
+    assert(0 == stats.searches);
+    assert(0 == stats.indexed_searches);
+    assert(Vec_capacity(v) == stats.peak_capacity);
+
+    // Named vectors can be picked out of the registry.
+    Vec* other = Vec_new(4, sizeof(int64_t));
+    StatsVisit visit = { .visited = 0, .found = false };
+
+    assert(other != NULL);
+    Vec_set_stats_name(v, "squares");
+    for (int64_t i = 0; i < 32; ++i)
+    {
+        assert(true == Vec_append(v, &i, sizeof(i)));
+    }
+    size_t const live = Vec_visit_stats(visit_stats, &visit);
+
+    assert(live >= 2);
+    assert(live == visit.visited);
+    assert(true == visit.found);
 
+    // Destroyed vectors leave the registry.
+    Vec_destroy(&other);
+    visit = (StatsVisit) { .visited = 0, .found = false };
+    assert(live - 1 == Vec_visit_stats(visit_stats, &visit));
     Vec_destroy(&v);
+    visit = (StatsVisit) { .visited = 0, .found = false };
+    assert(live - 2 == Vec_visit_stats(visit_stats, &visit));
+    assert(false == visit.found);
 }
+#endif
 
 int main(void)
 {
@@ -5769,6 +11277,26 @@ int main(void)
 
     test_destroy();
 
+    test_new_with();
+    test_growth();
+    test_reserve();
+    test_shrink_to_fit();
+
+    test_allocator_invalid();
+    test_allocator();
+    test_new_inline_invalid();
+    test_new_inline();
+    test_adopt_invalid();
+    test_adopt();
+    test_release_invalid();
+    test_release();
+    test_clone();
+    test_typed_invalid();
+    test_typed();
+    test_arena();
+    test_pool();
+    test_aligned();
+
     test_where_invalid();
     test_where();
     test_where_inner_pointer();
@@ -5776,6 +11304,11 @@ int main(void)
     test_where_if_invalid();
     test_where_if();
 
+    test_where_if_ctx_invalid();
+    test_where_if_ctx();
+    test_where_bytes();
+    test_where_fixed_width();
+
     test_has_invalid();
     test_has();
     test_has_inner_pointer();
@@ -5788,10 +11321,16 @@ int main(void)
 
     test_get_invalid();
     test_get();
+    test_get_unchecked();
+    test_data();
+    test_span();
 
     test_append_invalid();
     test_append();
     test_append_inner_pointer();
+    test_append_n_invalid();
+    test_append_n();
+    test_extend();
 
     test_insert_invalid();
     test_insert_empty();
@@ -5826,12 +11365,17 @@ int main(void)
     test_insert_full_inner_pointer_tail_before_insertion();
     test_insert_full_inner_pointer_tail_at_insertion();
     test_insert_full_inner_pointer_tail_after_insertion();
+    test_insert_inner_pointer_large_element();
 
     test_remove_invalid();
     test_remove_middle();
     test_remove_tail();
     test_remove_head();
     test_remove_until_empty();
+    test_remove_zeroing();
+    test_push_pop_invalid();
+    test_push_pop();
+    test_bounded();
 
     test_equal_invalid();
     test_equal_unmodified_default_comparator();
@@ -5858,10 +11402,26 @@ int main(void)
     test_remove_all_if_one();
     test_remove_all_if_some();
     test_remove_all_if_all();
+    test_remove_all_if_runs();
 
     test_qsort_invalid();
     test_qsort_scalar();
     test_qsort_struct();
+    test_radix_sort_invalid();
+    test_radix_sort();
+    test_merge_sort_parallel_invalid();
+    test_merge_sort_parallel();
+    test_typed_sort();
+    test_bsearch_invalid();
+    test_bsearch();
+    test_insert_sorted();
+    test_merge_sorted();
+    test_insert_many_invalid();
+    test_insert_many();
+    test_remove_indices_invalid();
+    test_remove_indices();
+    test_unique_invalid();
+    test_unique();
 
     test_apply_invalid();
     test_apply_modify_scalar();
@@ -5872,6 +11432,38 @@ int main(void)
     test_apply_early_return_middle();
     test_apply_early_return_tail();
     test_apply_early_return_different_error_codes();
+    test_apply_const();
+
+    test_threads();
+    test_apply_parallel_invalid();
+    test_apply_parallel();
+
+    test_index_invalid();
+    test_index();
+    test_index_key();
+    test_index_shifts();
+    test_hash_invalid();
+    test_hash();
+
+    test_mmap_invalid();
+    test_mmap();
+    test_io_invalid();
+    test_io();
+    test_concurrent_invalid();
+    test_concurrent();
+    test_shared_invalid();
+    test_shared();
+    test_soa_invalid();
+    test_soa();
+    test_seg_invalid();
+    test_seg();
+    test_cursor_invalid();
+    test_cursor();
+    test_bits_invalid();
+    test_bits();
+#if defined(VEC_STATS)
+    test_stats();
+#endif
 
     return EXIT_SUCCESS;
 }